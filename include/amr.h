@@ -0,0 +1,197 @@
+/*! @file amr.h
+    @brief Block-structured adaptive mesh refinement
+    @author Debojyoti Ghosh
+
+    The solution can be computed on refined patches of the grid, in addition to the
+    simulation grid, with a block-structured adaptive mesh refinement (AMR) in the
+    style of Berger and Colella. It is enabled by the optional input file \b amr.inp:
+
+        begin
+          regrid_iter     <n>
+          tag_threshold   <a>
+          tag_var         <v>
+          buffer          <b>
+          efficiency      <e>
+        end
+
+    + \b regrid_iter: the patches are rebuilt every n time steps (default: 10).
+    + \b tag_threshold: a grid cell is tagged for refinement if, along any dimension,
+      the normalized difference of the v-th solution component,
+      \f$\left|u_{i+1}-u_{i-1}\right| / \left(\left|u_{i+1}\right|+2\left|u_i\right|+\left|u_{i-1}\right|\right)\f$,
+      is larger than a (default: 0.05). This detects shocks, contact discontinuities,
+      and steep gradients (of the density, for the Euler and Navier-Stokes equations).
+    + \b tag_var: the solution component v of the sensor (default: 0).
+    + \b buffer: the tagged region is grown by b cells along each dimension, so that the
+      features remain on the patches until the next regridding (default: 2).
+    + \b efficiency: a patch is split until at least this fraction of its cells is tagged
+      (default: 0.7).
+
+    There is one refined level, with a refinement factor of 2 (#_AMR_RATIO_). Each patch
+    is a simulation object (#SimulationObject), created with the same inputs as the
+    simulation (solver.inp, boundary.inp, physics.inp) on the same MPI ranks: its grid
+    refines a box of the simulation grid, and it is integrated in time by its own time
+    integration object, with 2 time steps for each time step of the simulation. A time
+    step of the simulation proceeds as follows (see AMRPreStep() and AMRStep()):
+    + the simulation grid is advanced by one time step (everywhere, including the cells
+      covered by the patches);
+    + the patches are advanced by 2 time steps; their ghost points at the interfaces
+      with the simulation grid (coarse-fine interfaces) are interpolated from the
+      simulation solution at the beginning and the end of the time step (linearly
+      in time, see AMRPatchBoundaryConditions()), and at the physical boundaries, the
+      boundary conditions are applied;
+    + the simulation solution on the cells covered by a patch is replaced by the
+      average of the patch solution (restriction), and the cells of the simulation
+      grid adjacent to a patch are corrected by the difference between the time
+      integrals of the fluxes at their faces computed on the patch and on the
+      simulation grid (refluxing), so that the solution is conserved.
+
+    The fluxes at the coarse-fine interfaces are accumulated by the time integrators in
+    flux registers (#FluxRegister), like the boundary flux integrals (#HyPar::StageBoundaryIntegral,
+    #HyPar::StepBoundaryIntegral). Patches are boxes that cover the tagged cells (see AMRRegrid());
+    patches that overlap or touch are merged, and a patch that reaches a periodic boundary
+    spans the periodic dimension. The spatial interpolation (see AMRProlong()) is linear with
+    the monotonized central limiter, which is conservative and does not create new extrema
+    at shocks. The solution on the simulation grid (with the patch solutions averaged onto it)
+    is written as usual, and the patch solutions are written to \b op_amr_<p>_<index> (the
+    patches may change between the files).
+
+    The transfers between the simulation grid and the patches at each time step (interpolation
+    to the coarse-fine ghost points, restriction, refluxing) are done by each rank for its local
+    domain, with the blocks of the other grid that it needs (see MPIGetArrayBlocknD()).
+
+    Limitations:
+    + the regridding (tagging, clustering, and the initial solution of the new patches) is done
+      on rank 0, with the simulation solution gathered there every #AMRObject::regrid_iter
+      time steps;
+    + only one simulation domain, explicit Runge-Kutta or forward Euler time integration,
+      and uniform grids (without immersed bodies, local time stepping, or physics-specific
+      input data) are supported; AMR is not available on GPUs;
+    + the parabolic fluxes at the coarse-fine interfaces are not refluxed (the hyperbolic
+      fluxes are).
+*/
+
+#ifndef _AMR_H_
+#define _AMR_H_
+
+#include <basic.h>
+
+/*! Refinement factor of the patches */
+#define _AMR_RATIO_ 2
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \def FluxRegister
+    \brief Structure of a flux register
+*/
+/*! \brief Structure of a flux register
+ *
+ * A flux register records the hyperbolic flux (#HyPar::HyperbolicFunction) at a list of cell
+ * faces (in a global order, the same on all ranks): HyperbolicFunctionDimension() stores the
+ * flux of each stage at the faces owned by this rank in #FluxRegister::stage, and the time
+ * integrator accumulates its time integral in #FluxRegister::step (the same way as
+ * #HyPar::StepBoundaryIntegral). Each face is associated with a cell of the simulation grid
+ * and a weight, from which the refluxing correction of that cell is computed (see AMRStep());
+ * the correction of a face on a physical boundary is applied to #HyPar::StepBoundaryIntegral
+ * of the simulation instead, so that the conservation error (#HyPar::ConservationCheck)
+ * accounts for the fluxes of the patches.
+*/
+typedef struct flux_register {
+
+  int     nfaces; /*!< Number of faces */
+  int     nvars;  /*!< Number of vector components of the flux */
+  int     *dir;   /*!< Dimension normal to each face */
+  int     *side;  /*!< Side of the patch of each face (0: low, 1: high) */
+  int     *index; /*!< 1D index of each face in the array of the interface fluxes along #FluxRegister::dir
+                       on this rank, or -1 if the face is not on this rank */
+  long    *cell;  /*!< 1D index (without ghosts) of the cell of the simulation grid corrected by each face,
+                       or -1 if the face is on a physical boundary */
+  double  *weight;/*!< Weight of each face in the correction of its cell */
+  double  *stage; /*!< Flux at each face at the current stage (nfaces*nvars) */
+  double  *step;  /*!< Time integral of the flux at each face (nfaces*nvars) */
+
+} FluxRegister;
+
+/*! \def AMRPatch
+    \brief Structure of an AMR patch
+*/
+/*! \brief Structure of an AMR patch
+ *
+ * The box of the simulation grid refined by a patch (#HyPar::amr_patch), and the interpolated
+ * values of its ghost points at the coarse-fine interfaces.
+*/
+typedef struct amr_patch {
+
+  int     *lo;      /*!< First global index of the box on the simulation grid along each dimension */
+  int     *hi;      /*!< Last global index of the box plus one along each dimension */
+  int     *cf;      /*!< Is each face (2 per dimension) a coarse-fine interface (not a physical boundary)? */
+
+  int     npoints;  /*!< Number of ghost points at the coarse-fine interfaces on this rank */
+  int     *gindex;  /*!< 1D indices (with ghosts) of these ghost points */
+  double  *u_old;   /*!< Their values interpolated from the simulation solution at the beginning of the time step */
+  double  *u_new;   /*!< Their values interpolated from the simulation solution at the end of the time step */
+  double  t_old;    /*!< Simulation time at the beginning of the time step */
+  double  dt;       /*!< Time step of the simulation */
+
+} AMRPatch;
+
+/*! \def AMRObject
+    \brief Structure of the AMR
+*/
+/*! \brief Structure of the AMR
+ *
+ * The inputs (from \b amr.inp), the patches, and the global arrays of the simulation grid.
+*/
+typedef struct amr_object {
+
+  int     regrid_iter;    /*!< Regrid every this many time steps */
+  double  tag_threshold;  /*!< Threshold of the tagging sensor */
+  int     tag_var;        /*!< Solution component of the tagging sensor */
+  int     buffer;         /*!< Number of cells by which the tagged region is grown */
+  double  efficiency;     /*!< Minimum fraction of tagged cells of a patch */
+
+  void    *sim;           /*!< Simulation object (#SimulationObject) */
+  void    *ts;            /*!< Time integration object (#TimeIntegration) of the simulation */
+
+  int     npatches;       /*!< Number of patches */
+  void    *patches;       /*!< Array of patch simulation objects (#SimulationObject) */
+  void    *ts_patches;    /*!< Time integration object (#TimeIntegration) of the patches */
+
+  double  *ug_old;        /*!< Global simulation solution at the beginning of the time step of the last
+                               regridding (rank 0) */
+  double  **xg;           /*!< Global grid of the simulation along each dimension */
+  double  **dxinvg;       /*!< Global inverse grid spacing of the simulation along each dimension */
+
+} AMRObject;
+
+/*! Read the AMR inputs and create the initial patches */
+int AMRInitialize(void*,int,void*,void**);
+/*! Regrid if required, and save the simulation solution at the beginning of the time step */
+int AMRPreStep(void*);
+/*! Advance the patches, and restrict and reflux their solution onto the simulation grid */
+int AMRStep(void*);
+/*! Write the solutions of the patches to files */
+int AMROutputSolution(void*,double);
+/*! Delete the patches and the AMR object */
+int AMRCleanup(void*);
+
+/*! Rebuild the patches from the tagged cells of the simulation grid */
+int AMRRegrid(void*);
+/*! Interpolate a block of the simulation solution onto a part of the refined grid */
+int AMRProlong(void*,double*,int*,int*,int*,int*,double*);
+/*! Apply the boundary conditions of a patch, and fill its coarse-fine ghost points */
+int AMRPatchBoundaryConditions(void*,void*,double*,double*,double);
+
+/*! Create a flux register */
+int FluxRegisterCreate(FluxRegister*,int,int);
+/*! Delete a flux register */
+int FluxRegisterCleanup(FluxRegister*);
+/*! Delete the data of an AMR patch */
+int AMRPatchCleanup(AMRPatch*);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
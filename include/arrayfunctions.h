@@ -395,6 +395,29 @@
     }\
   }
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*! Allocate a large solver array with NUMA-aware page placement (see ArrayAllocate.c) */
+double* ArrayAllocate                 (size_t,const char*);
+/*! Allocate a large solver array of single precision values (see ArrayAllocate.c) */
+float*  ArrayAllocateSingle           (size_t,const char*);
+/*! Allocate a large solver array laid out on the grid, placed for the threaded grid-line loops (see ArrayAllocate.c) */
+double* ArrayAllocateGrid             (size_t,int,const int*,int,int,int,const char*);
+/*! Allocate a large solver array of single precision values laid out on the grid (see ArrayAllocate.c) */
+float*  ArrayAllocateGridSingle       (size_t,int,const int*,int,int,int,const char*);
+/*! Allocate a set of large interface arrays, placed for the threaded grid-line loops (see ArrayAllocate.c) */
+double* ArrayAllocateInterfaces       (int,const int*,int,int,const char*);
+/*! Allocate a set of large interface arrays of single precision values (see ArrayAllocate.c) */
+float*  ArrayAllocateInterfacesSingle (int,const int*,int,int,const char*);
+/*! Free an array allocated with ArrayAllocate() */
+void    ArrayFree                     (void*);
+/*! Print the sizes and NUMA placement of the arrays allocated with ArrayAllocate() */
+int     ArrayAllocationReport         (void);
+#ifdef __cplusplus
+}
+#endif
+
 #if !defined(INLINE)
 # define INLINE inline
 #endif
@@ -0,0 +1,153 @@
+/*! @file benchmark.h
+    @brief Definitions and function declarations for the kernel micro-benchmarks
+    @author Debojyoti Ghosh
+
+    The micro-benchmarks (built with "make bench", see BenchmarkMain.c) time the spatial
+    discretization kernels (interpolation, finite-difference derivatives, tridiagonal
+    solvers, and upwinding functions of the physical models) on synthetic #HyPar and
+    #MPIVariables objects, without the need of input files or a complete simulation.
+
+    The scaling harness (HyParScalingSetup, also built with "make bench", and the driver
+    script src/Benchmark/scaling.sh, see BenchmarkScalingMain.c) generates the inputs of canned
+    problems for complete simulations at a given number of MPI ranks, to run weak and strong
+    scaling studies.
+*/
+
+#ifndef _BENCHMARK_H_
+#define _BENCHMARK_H_
+
+#include <stdio.h>
+#include <basic.h>
+#include <mpivars.h>
+#include <hypar.h>
+
+/*! Maximum number of entries in the list of grid sizes or number of variables */
+#define _BENCH_MAX_LIST_ 16
+/*! Maximum length of the name of a kernel */
+#define _BENCH_NAME_LEN_ 64
+/*! Number of ghost points of the synthetic grids */
+#define _BENCH_GHOSTS_ 3
+/*! Maximum number of spatial dimensions of the canned problems of the scaling harness */
+#define _BENCH_MAX_DIMS_ 3
+
+/*! \def BenchmarkRecord
+    \brief Structure containing the measurements of one kernel at one problem size
+*/
+/*! \brief Structure containing the measurements of one kernel at one problem size */
+typedef struct benchmark_record {
+  char    kernel[_BENCH_NAME_LEN_]; /*!< Name of the kernel */
+  int     ndims;                    /*!< Number of spatial dimensions */
+  int     size;                     /*!< Grid size along each dimension */
+  int     nvars;                    /*!< Number of variables per grid point */
+  double  time_med;                 /*!< Median (over trials) wall time per call (seconds) */
+  double  time_min;                 /*!< Minimum (over trials) wall time per call (seconds) */
+  double  spread;                   /*!< Interquartile range of the trials, relative to the median */
+  double  npoints;                  /*!< Number of grid points processed per call */
+  double  bytes;                    /*!< Estimated bytes moved to/from memory per call */
+  double  flops;                    /*!< Estimated floating point operations per call */
+} BenchmarkRecord;
+
+/*! \def BenchmarkSettings
+    \brief Structure containing the settings and results of the micro-benchmarks
+*/
+/*! \brief Structure containing the settings and results of the micro-benchmarks */
+typedef struct benchmark_settings {
+  int     rank;                       /*!< MPI rank */
+  int     nproc;                      /*!< Number of MPI ranks (each runs the benchmarks independently) */
+  int     ndims;                      /*!< Number of spatial dimensions for the scheme benchmarks */
+  int     nsizes;                     /*!< Number of grid sizes */
+  int     sizes[_BENCH_MAX_LIST_];    /*!< Grid sizes (along each dimension) */
+  int     nnvars;                     /*!< Number of values of nvars */
+  int     nvars[_BENCH_MAX_LIST_];    /*!< Numbers of variables per grid point */
+  int     ntrials;                    /*!< Number of timed trials per kernel */
+  double  min_time;                   /*!< Minimum wall time (seconds) of each trial */
+  char    filter[_MAX_STRING_SIZE_];  /*!< Benchmark only the kernels whose name contains this string */
+  char    output[_MAX_STRING_SIZE_];  /*!< Filename for the results */
+
+  double  bandwidth;  /*!< Measured memory bandwidth (bytes/second; STREAM triad) */
+  double  flop_rate;  /*!< Measured peak floating point rate (flops/second; independent multiply-adds) */
+
+  BenchmarkRecord *records;   /*!< Measurements */
+  int             nrecords;   /*!< Number of measurements */
+} BenchmarkSettings;
+
+/*! \def BenchmarkProblem
+    \brief Structure containing a synthetic grid and solution
+*/
+/*! \brief Structure containing a synthetic grid and solution
+ *
+ *  The #HyPar and #MPIVariables objects are set up as for a simulation on one MPI rank with
+ *  non-periodic boundaries (every rank owns an independent copy), and contain only what the
+ *  benchmarked kernels need.
+*/
+typedef struct benchmark_problem {
+  HyPar         solver;   /*!< Solver object */
+  MPIVariables  mpi;      /*!< MPI object */
+  int           size;     /*!< Grid size along each dimension */
+
+  double  *x;     /*!< Grid coordinates (with ghosts) */
+  double  *u;     /*!< Cell-centered solution (with ghosts) */
+  double  *f;     /*!< Cell-centered flux (with ghosts) */
+  double  *Df;    /*!< Cell-centered derivative (with ghosts) */
+  double  *fI;    /*!< Interface flux */
+  double  *fL;    /*!< Left-biased interface flux */
+  double  *fR;    /*!< Right-biased interface flux */
+  double  *uL;    /*!< Left-biased interface solution */
+  double  *uR;    /*!< Right-biased interface solution */
+  int     ninterfaces_max; /*!< Maximum (over all dimensions) number of interfaces */
+} BenchmarkProblem;
+
+/*! \def BenchmarkScalingRun
+    \brief Structure describing one simulation of the scaling harness
+*/
+/*! \brief Structure describing one simulation of the scaling harness */
+typedef struct benchmark_scaling_run {
+  char    name[_BENCH_NAME_LEN_];           /*!< Name of the canned problem */
+  int     nranks;                           /*!< Number of MPI ranks */
+  int     ndims;                            /*!< Number of spatial dimensions (set by the problem) */
+  int     dim_global[_BENCH_MAX_DIMS_];     /*!< Global grid size along each dimension */
+  int     iproc[_BENCH_MAX_DIMS_];          /*!< Number of MPI ranks along each dimension */
+  int     n_iter;                           /*!< Number of time steps */
+  int     file_op_iter;                     /*!< Solution output frequency (0: no output) */
+  double  cfl;                              /*!< CFL number used to compute the time step */
+  char    output_mode[_MAX_STRING_SIZE_];   /*!< #HyPar::output_mode */
+} BenchmarkScalingRun;
+
+/*! Kernel or set-up function timed by BenchmarkRun() */
+typedef int (*BenchmarkFunction)(void*);
+
+/* set up and destroy synthetic problems */
+int BenchmarkProblemCreate  (BenchmarkProblem*,int,int,int);
+int BenchmarkProblemDestroy (BenchmarkProblem*);
+/* set a compressible flow state (for the upwinding functions of the Euler/Navier-Stokes models) */
+int BenchmarkProblemSetEulerState (BenchmarkProblem*,double);
+
+/* time a kernel */
+int BenchmarkRun  (BenchmarkSettings*,const char*,BenchmarkProblem*,double,double,
+                   BenchmarkFunction,BenchmarkFunction,void*);
+/* measure the machine limits */
+int BenchmarkMachine (BenchmarkSettings*);
+/* print and write the results */
+int BenchmarkPrintRecord (BenchmarkSettings*,BenchmarkRecord*,FILE*);
+int BenchmarkReport      (BenchmarkSettings*);
+
+/* benchmark suites */
+int BenchmarkInterpolation          (BenchmarkSettings*,BenchmarkProblem*);
+int BenchmarkDerivatives            (BenchmarkSettings*,BenchmarkProblem*);
+int BenchmarkTridiagLU              (BenchmarkSettings*,BenchmarkProblem*);
+int BenchmarkUpwind                 (BenchmarkSettings*,BenchmarkProblem*,const char*,
+                                     int(*)(double*,double*,double*,double*,double*,double*,int,void*,double),
+                                     double);
+int BenchmarkUpwindEuler1D          (BenchmarkSettings*,int);
+int BenchmarkUpwindNavierStokes2D   (BenchmarkSettings*,int);
+int BenchmarkUpwindNavierStokes3D   (BenchmarkSettings*,int);
+
+/* whether a kernel is selected by the filter */
+int BenchmarkSelected (BenchmarkSettings*,const char*);
+
+/* scaling harness: canned problems and processor grid */
+int BenchmarkScalingProblemNdims  (const char*);
+int BenchmarkScalingWriteInputs   (BenchmarkScalingRun*);
+int BenchmarkScalingProcessorGrid (BenchmarkScalingRun*,int,int);
+
+#endif
@@ -81,6 +81,16 @@ typedef struct domain_boundaries {
   int on_this_proc;   /*!< Flag indicating if this BC is applicable on this process  (not an input) */
   int *is, *ie;       /*!< Index range on which to apply this BC on this process (not an input) */
 
+  int npoints;        /*!< Number of ghost points of this BC on this process (not an input) */
+  int *gindex;        /*!< 1D indices (with ghosts) of the ghost points of this BC on this process (not an input) */
+  int *iindex;        /*!< 1D indices (with ghosts) of the interior points from which the ghost points are computed:
+                           the mirror images across the boundary face, or the periodic images for a periodic BC
+                           (not an input) */
+  /*! Number of consecutive zones, starting with this one, that are applied in one sweep over the index lists
+      of this zone by its #DomainBoundary::BCFunctionU (see BCGroupZones()); 0 if this zone is applied with a
+      preceding zone (not an input) */
+  int ngroup;
+
   /*! Pointer to the specific boundary condition function for the solution vector U */
   int (*BCFunctionU) (void*,void*,int,int,int*,int,double*,double);
 
@@ -117,6 +127,8 @@ typedef struct domain_boundaries {
 /* Functions */
 int BCInitialize(void*, int); /*!< Function to initialize the boundary conditions */
 int BCCleanup   (void*, int); /*!< Function to clean up boundary conditions-related variables and arrays */
+int BCIndexLists(void*,void*,int,int*,int); /*!< Function to compute the index lists of the ghost points of a boundary zone */
+int BCGroupZones(void*,int);  /*!< Function to group consecutive boundary zones that can be applied in one sweep */
 
 /* Boundary condition implementations for the solution vector U */
 /*! Periodic boundary conditions for the solution vector U */
@@ -87,6 +87,10 @@ typedef struct main_parameters {
    * (characteristic or component-wise) (input - \b solver.inp ) */
   char    interp_type         [_MAX_STRING_SIZE_];
 
+  /*! storage mode of the interface eigensystem cache shared by the characteristic-based
+   * reconstruction and upwinding: none, left or full (input - \b solver.inp ) */
+  char    eigen_cache_type    [_MAX_STRING_SIZE_];
+
   /*! split the hyperbolic flux into two terms - for implicit-explicit time-integration or
    * for any other purpose (input - \b solver.inp ) */
   char    SplitHyperbolicFlux [_MAX_STRING_SIZE_];
@@ -193,6 +197,38 @@ typedef struct main_parameters {
   /*! plot solutions during simulation? */
   char plot_solution[_MAX_STRING_SIZE_];
 
+  /*! profile the time spent (and the bytes moved) in the main regions of the solver,
+      and write a report at the end of the simulation? ("yes" or "no") (input - \b solver.inp ) */
+  char profile[_MAX_STRING_SIZE_];
+
+  /*! store the WENO weights and the stage right-hand-sides of the explicit Runge-Kutta methods
+      in single precision, while the solution is computed and updated in double precision?
+      ("yes" or "no") (input - \b solver.inp ) */
+  char mixed_precision[_MAX_STRING_SIZE_];
+
+  /*! use high-order metrics (#HyPar::dxinv) and the finite-difference coefficients (#NonUniformGrid)
+      of a non-uniform grid, computed from the grid (#HyPar::x) at initialization? ("yes" or "no")
+      (input - \b solver.inp ) */
+  char nonuniform_grid[_MAX_STRING_SIZE_];
+
+  /*! steady-state mode: if positive, each grid point is advanced with its own (local) time step
+      corresponding to this CFL number, computed by #HyPar::ComputeLocalCFL (input - \b solver.inp ) */
+  double local_dt_cfl;
+  /*! steady-state mode: if positive, stop the time integration when the norm of the change in the
+      solution (#TimeIntegration::norm) has dropped by this factor from its first value
+      (input - \b solver.inp ) */
+  double residual_drop;
+  /*! steady-state mode: number of coarse grids over which the solution is converged first, from the
+      coarsest one, before it is interpolated to the next finer grid (see GridSequencing())
+      (input - \b solver.inp ) */
+  int grid_sequencing;
+  /*! grid sequencing level of this object (0 for the simulation grid, n for the grid coarsened by
+      a factor of 2^n, see GridSequencing()) */
+  int gs_level;
+  /*! local time stepping: ratio of the local time step to the time step at each grid point
+      (computed in TimePreStep()) */
+  double *local_dt;
+
   /*! filename index for files written every few iterations */
   char *filename_index;
   /*! length of filename_index - should be sufficient for the number of files expected to be written */
@@ -252,12 +288,34 @@ typedef struct main_parameters {
                              int(*)(double*,double*,double*,double*,double*,
                                     double*,int,void*,double));
 
+  /*! Pointer to the function to add a multiple of the derivative of the interface fluxes along a
+      dimension to the hyperbolic term: a kernel specialized at compile time for the number of spatial dimensions and
+      solution components (assigned in RHSKernelsInitialize()); if NULL, HyperbolicFunctionAccumulate()
+      uses its generic loop */
+  int (*HyperbolicFluxDifference) (double*,double,double*,double*,double*,int,void*);
+
+  /*! Pointer to the function to add a multiple of the hyperbolic term to a given array, without
+      the blanking of immersed bodies (assigned in InitializeSolvers(); NULL on GPUs) */
+  int (*HyperbolicFunctionAccumulate) (double*,double,double*,void*,void*,double,int,
+                                       int(*)(double*,double*,int,void*,double),
+                                       int(*)(double*,double*,double*,double*,double*,
+                                              double*,int,void*,double));
+
   /*! Pointer to the function to calculate the parabolic term (assigned in InitializeSolvers())*/
   int (*ParabolicFunction)  (double*,double*,void*,void*,double);
 
+  /*! Pointer to the function to add a multiple of the parabolic term to a given array, without
+      the blanking of immersed bodies (assigned in InitializeSolvers(); a physical model that
+      sets #HyPar::ParabolicFunction must set this too, or set it to NULL) */
+  int (*ParabolicFunctionAccumulate) (double*,double,double*,void*,void*,double);
+
   /*! Pointer to the function to calculate the source term (assigned in InitializeSolvers())*/
   int (*SourceFunction)     (double*,double*,void*,void*,double);
 
+  /*! Pointer to the function to add a multiple of the source term to a given array
+      (assigned in InitializeSolvers(); NULL on GPUs) */
+  int (*SourceFunctionAccumulate) (double*,double,double*,void*,void*,double);
+
   /*! name of physical model (defined in the header files in folder physicalmodels)
       (input - \b solver.inp ) */
   char model[_MAX_STRING_SIZE_];
@@ -271,6 +329,10 @@ typedef struct main_parameters {
   /*! Pointer to the function to calculate the diffusion number (assigned in the physical model initialization called from InitializePhysics()) */
   double (*ComputeDiffNumber)  (void*,void*,double,double);
 
+  /*! Pointer to the function to calculate the CFL number at each grid point, needed for local time stepping
+      (assigned in the physical model initialization called from InitializePhysics()) */
+  double (*ComputeLocalCFL)    (void*,void*,double,double,double*);
+
   /*! Pointer to the function to calculate the hyperbolic flux function
    * (assigned in the physical model initialization called from InitializePhysics()) */
   int    (*FFunction)          (double*,double*,int,void*,double);
@@ -362,6 +424,15 @@ typedef struct main_parameters {
   void *interp;
   /*! object containing arrays needed for compact finite-difference methods */
   void *compact;
+  /*! object containing the finite-difference coefficients on a non-uniform grid
+      (#NonUniformGrid), if #HyPar::nonuniform_grid is "yes" */
+  void *nonuniform;
+  /*! object containing the interface eigensystem cache (#EigenCache) */
+  void *eigen_cache;
+  /*! object containing the work arrays for the task-based evaluation of the hyperbolic term (#RHSTasks) */
+  void *rhs_tasks;
+  /*! object containing the in-situ reduced outputs (#InSitu), if \b insitu.inp exists */
+  void *insitu;
   /*! object containing multi-stage time-integration (RK-type) related parameters */
   void *msti;
   /*! object containing parameters for the tridiagonal solver */
@@ -384,6 +455,12 @@ typedef struct main_parameters {
   double *StepBoundaryIntegral;
   /*! Total surface integral of the flux over the global domain boundary */
   double *TotalBoundaryIntegral;
+  /*! Flux register (#FluxRegister) recording the hyperbolic flux at the coarse-fine interfaces
+      of the adaptive mesh refinement (see amr.h), or NULL */
+  void   *flux_register;
+  /*! The box of the simulation grid refined by this simulation object (#AMRPatch), if it is an
+      AMR patch (see amr.h), or NULL */
+  void   *amr_patch;
   /*! Pointer to the function to calculate the volume integral of a given function */
   int    (*VolumeIntegralFunction)    (double*,double*,void*,void*);
   /*! Pointer to the function to calculate the boundary integral of the flux */
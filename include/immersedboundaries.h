@@ -6,11 +6,16 @@
 #ifndef _IB_H_
 #define _IB_H_
 
-/*! Immersed boundaries are implemented only for 3-dimensional simulations. */
+/*! Number of spatial dimensions of immersed bodies defined by triangulated surfaces (#Body3D). */
 #define _IB_NDIMS_ 3
 /*! Number of grid points surrounding a random point in space, i.e., number of
     corners of a cube. */
 #define _IB_NNODES_ 8
+/*! Number of spatial dimensions of immersed bodies defined by closed curves (#Body2D). */
+#define _IB_NDIMS_2D_ 2
+/*! Number of grid points surrounding a random point in a plane, i.e., number of
+    corners of a rectangle. */
+#define _IB_NNODES_2D_ 4
 
 /*! "Pseudo-2D" simulation in the x-y plane */
 #define _IB_XY_ "2d (xy)"
@@ -20,6 +25,8 @@
 #define _IB_YZ_ "2d (yz)"
 /*! 3D simulation */
 #define _IB_3D_ "3d"
+/*! 2D simulation with a 2D immersed body (#Body2D) */
+#define _IB_2D_ "2d"
 
 #include <basic.h>
 
@@ -51,6 +58,26 @@ typedef struct _facet_3d_{
          nz; /*!< z-component of surface normal */
 } Facet3D;
 
+/*! \def Segment2D
+    \brief Structure defining a segment.
+
+    A "segment" is the basic unit of a 2D body surface: It is a straight line
+    segment of a closed curve, defined by its end points and outward normal.
+*/
+/*!\brief Structure defining a segment.
+
+    A "segment" is the basic unit of a 2D body surface: It is a straight line
+    segment of a closed curve, defined by its end points and outward normal.
+*/
+typedef struct _segment_2d_{
+  double x1, /*!< x-coordinate of end point 1 */
+         x2, /*!< x-coordinate of end point 2 */
+         y1, /*!< y-coordinate of end point 1 */
+         y2, /*!< y-coordinate of end point 2 */
+         nx, /*!< x-component of outward normal */
+         ny; /*!< y-component of outward normal */
+} Segment2D;
+
 /*! \def FacetMap
     \brief Structure defining a facet map.
 
@@ -109,6 +136,27 @@ typedef struct _body_3d_{
          zmax; /*!< z-coordinate of higher end of bounding box */
 } Body3D;
 
+/*! \def Body2D
+    \brief Structure defining a 2D body.
+
+    A 2D body whose surface is represented as one or more closed curves,
+    each a collection of segments of type #Segment2D. \sa IBReadBody2D()
+*/
+/*! \brief Structure defining a 2D body.
+
+    A 2D body whose surface is represented as one or more closed curves,
+    each a collection of segments of type #Segment2D. \sa IBReadBody2D()
+*/
+typedef struct _body_2d_{
+  int       nsegments;  /*!< number of surface segments */
+  Segment2D *surface;   /*!< array of surface segments  */
+  /* coordinates of bounding box */
+  double xmin, /*!< x-coordinate of lower end of bounding box */
+         xmax, /*!< x-coordinate of higher end of bounding box */
+         ymin, /*!< y-coordinate of lower end of bounding box */
+         ymax; /*!< y-coordinate of higher end of bounding box */
+} Body2D;
+
 /*! \def IBNode
     \brief Structure defining an immersed boundary node
 
@@ -130,9 +178,11 @@ typedef struct _boundary_node_{
   double  x,      /*!< x-coordinate of the boundary node */
           y,      /*!< y-coordinate of the boundary node */
           z;      /*!< z-coordinate of the boundary node */
-  Facet3D *face;  /*!< the nearest facet of #ImmersedBoundary::body */
+  Facet3D   *face;    /*!< the nearest facet of #ImmersedBoundary::body (3D) */
+  Segment2D *segment; /*!< the nearest segment of #ImmersedBoundary::body2d (2D) */
 
-  int     interp_nodes[_IB_NNODES_];   /*!< indices of interior nodes from which to extrapolate */
+  int     interp_nodes[_IB_NNODES_];   /*!< indices of interior nodes from which to extrapolate
+                                            (only the first #_IB_NNODES_2D_ in 2D) */
   double  interp_coeffs[_IB_NNODES_],  /*!< interpolation coefficients corresponding to #IBNode::interp_nodes */
           interp_node_distance,        /*!< Distance from the immersed body surface to the interior node from which to extrapolate */
           surface_distance;            /*!< Distance from this node to the immersed body surface */
@@ -151,9 +201,13 @@ typedef struct _boundary_node_{
     boundaries.
 */
 typedef struct immersed_boundary{
-  Body3D    *body;      /*!< immersed body */
+  int       ndims;      /*!< number of spatial dimensions (#_IB_NDIMS_ or #_IB_NDIMS_2D_) */
+  Body3D    *body;      /*!< immersed body (3D) */
+  Body2D    *body2d;    /*!< immersed body (2D) */
   IBNode    *boundary;  /*!< immersed boundary nodes */
   FacetMap  *fmap;      /*!< list of "local" facets */
+  int       *facet_owner; /*!< rank that owns each facet of #ImmersedBoundary::body (-1 if the
+                               facet is not local on any rank) \sa IBCreateFacetMapping() */
 
   double  tolerance; /*!< zero tolerance */
   double  delta;     /*!< small number */
@@ -178,6 +232,12 @@ int IBIdentifyMode      (double*,int*,void*);
 int IBNearestFacetNormal(void*,void*,double*,double,int*,int);
 int IBInterpCoeffs      (void*,void*,double*,int*,int,double*);
 
+int IBReadBody2D            (Body2D**,char*,void*,int*);
+int IBComputeBoundingBox2D  (Body2D*);
+int IBIdentifyBody2D        (void*,int*,int,double*,double*);
+int IBNearestSegmentNormal  (void*,void*,double*,double,int*,int);
+int IBInterpCoeffs2D        (void*,void*,double*,int*,int,double*);
+
 int IBAssembleGlobalFacetData(void*,void*,const double* const, double** const,int);
 
 int IBComputeNormalGradient(void*,void*,const double* const, int, double** const);
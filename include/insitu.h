@@ -0,0 +1,139 @@
+/*! @file insitu.h
+    @brief In-situ reduced outputs: probes, slices, averages and spectra
+    @author Debojyoti Ghosh
+
+    Instead of (or in addition to) writing the full solution every #HyPar::file_op_iter
+    time steps, reduced quantities of the solution can be computed in parallel at every
+    few time steps and appended to compact binary time-series files. They are specified
+    in the optional input file \b insitu.inp (\b insitu_<n>.inp for the n-th domain of a
+    multi-domain simulation, if present):
+
+        begin
+          frequency       <n>
+          probe           <x_0> <x_1> ... <x_{ndims-1}>
+          slice           <dim> <x>
+          plane_average   <dim>
+          line_average    <dim>
+          spectrum        <dim>
+        end
+
+    + \b frequency: the outputs are computed every n time steps (default: 1).
+    + \b probe: the solution at the grid point nearest to the given location.
+    + \b slice: the solution on the grid plane normal to dimension \a dim nearest to \a x.
+    + \b plane_average: the solution averaged over all dimensions except \a dim (a
+      profile along \a dim).
+    + \b line_average: the solution averaged along dimension \a dim (a field over the
+      other dimensions).
+    + \b spectrum: the one-sided energy spectrum along dimension \a dim of each
+      variable, averaged over the grid lines along \a dim.
+
+    Any number of outputs can be specified. The k-th output is written to
+    \b insitu_<k>_<type>.bin (\b insitu_<k>_<type>_<n>.bin for a multi-domain simulation).
+    Each file starts with a header in the format of WriteBinary(), without the solution:
+    \n
+        ndims nvars dim[0] ... dim[ndims-1] x0_i (0 <= i < dim[0]) ... x{ndims-1}_i (0 <= i < dim[ndims-1])
+    \n
+    where dim is the size of the output array (1 along the dimensions that are reduced),
+    and x are the grid coordinates of the output array (the coordinate of the probe or the
+    slice, or the mean coordinate, along the dimensions that are reduced, and the integer
+    wavenumbers along \a dim for a spectrum). Each record that follows is the simulation
+    time, followed by the output array in the layout of WriteBinary(). A restarted
+    simulation appends to the existing files.
+
+    Averages are arithmetic means over the grid points. Spectra are computed with a direct
+    (distributed) discrete Fourier transform, and therefore cost O(N) operations per grid
+    point, where N is the number of points along \a dim.
+*/
+
+#ifndef _INSITU_H_
+#define _INSITU_H_
+
+#include <basic.h>
+#ifndef serial
+#include <mpi.h>
+#endif
+
+/*! Point probe */
+#define _INSITU_PROBE_          "probe"
+/*! Grid plane normal to a dimension */
+#define _INSITU_SLICE_          "slice"
+/*! Average over all dimensions except one */
+#define _INSITU_PLANE_AVERAGE_  "plane_average"
+/*! Average along one dimension */
+#define _INSITU_LINE_AVERAGE_   "line_average"
+/*! Energy spectrum along one dimension */
+#define _INSITU_SPECTRUM_       "spectrum"
+
+/*! \def InSituOutput
+    \brief Structure for one in-situ output
+*/
+/*! \brief Structure for one in-situ output
+ *
+ * Each output is computed by a subset of the MPI ranks (the members), reduced or gathered
+ * on one of them (the writer), and appended to its file by the writer.
+*/
+typedef struct insitu_output {
+  char    type[_MAX_STRING_SIZE_];  /*!< Type of output */
+  int     dim;                      /*!< Dimension normal to the slice, along the profile, line, or spectrum */
+  double  *x;                       /*!< Location of the probe (ndims values) or of the slice (1 value) */
+  int     *index;                   /*!< Global index of the probe (ndims values) or of the slice (1 value) */
+
+  int     *size;                    /*!< Size of the output array along each dimension */
+  int     npoints;                  /*!< Number of points of the output array */
+  int     member;                   /*!< Whether this rank computes a part of the output */
+  int     writer;                   /*!< Whether this rank writes the output */
+  FILE    *out;                     /*!< Output file (writer only) */
+
+  int     *bstart;                  /*!< Start of the part of the output array on this rank */
+  int     *bsize;                   /*!< Size of the part of the output array on this rank */
+  int     nblocks;                  /*!< Number of parts gathered by the writer */
+  int     *bstart_all;              /*!< Starts of the parts gathered by the writer */
+  int     *bsize_all;               /*!< Sizes of the parts gathered by the writer */
+  int     *counts;                  /*!< Number of values in each part gathered by the writer */
+  int     *displs;                  /*!< Offsets of the parts gathered by the writer */
+
+  double  *local;                   /*!< Part of the output array computed on this rank */
+  double  *reduced;                 /*!< Part of the output array after the reduction over ranks */
+  double  *gathered;                /*!< Parts of the output array gathered by the writer */
+  double  *global;                  /*!< Output array (writer only) */
+
+  int     nlines;                   /*!< Spectrum: number of local grid lines */
+  int     nlines_global;            /*!< Spectrum: number of grid lines */
+  int     nk;                       /*!< Spectrum: number of wavenumbers */
+  double  *twiddle;                 /*!< Spectrum: cosines and sines of the discrete Fourier transform */
+
+#ifdef serial
+  int       comm_reduce;            /* Dummy variable */
+  int       own_comm_reduce;        /* Dummy variable */
+  int       comm_gather;            /* Dummy variable */
+#else
+  MPI_Comm  comm_reduce;            /*!< Communicator of the reduction (averages and spectra) */
+  int       own_comm_reduce;        /*!< Whether #InSituOutput::comm_reduce was created for this output */
+  MPI_Comm  comm_gather;            /*!< Communicator of the ranks whose parts are gathered on the writer */
+#endif
+} InSituOutput;
+
+/*! \def InSitu
+    \brief Structure for the in-situ reduced outputs
+*/
+/*! \brief Structure for the in-situ reduced outputs
+ *
+ * Contains the outputs specified in \b insitu.inp and the frequency at which they are
+ * computed (see insitu.h).
+*/
+typedef struct insitu {
+  int           ndims;      /*!< Number of spatial dimensions */
+  int           frequency;  /*!< Compute the outputs every this many time steps */
+  int           noutputs;   /*!< Number of outputs */
+  InSituOutput  *output;    /*!< Outputs */
+  double        **xg;       /*!< Global grid coordinates along each dimension */
+} InSitu;
+
+/*! Read the in-situ outputs and set up their reductions */
+int InSituInitialize(void*,void*);
+/*! Compute the in-situ outputs and append them to their files */
+int InSituCompute   (void*,void*,double,int);
+/*! Close the files and free the in-situ outputs */
+int InSituCleanup   (void*);
+
+#endif
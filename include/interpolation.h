@@ -212,6 +212,21 @@ typedef struct parameters_weno {
   double *w1, /*!< Array to save the first WENO weight */
          *w2, /*!< Array to save the second WENO weight */
          *w3;/*!< Array to save the third WENO weight */
+  /* Arrays to save the WENO weights in single precision (#HyPar::mixed_precision) */
+  int   single; /*!< Are the WENO weights saved in single precision (in #WENOParameters::w1s, #WENOParameters::w2s,
+                     #WENOParameters::w3s, instead of #WENOParameters::w1, #WENOParameters::w2, #WENOParameters::w3)? */
+  float *w1s, /*!< Array to save the first WENO weight in single precision */
+        *w2s, /*!< Array to save the second WENO weight in single precision */
+        *w3s; /*!< Array to save the third WENO weight in single precision */
+  /* hybrid scheme: the nonlinear weights are computed only at the interfaces flagged by a
+   * smoothness sensor, and are the optimal weights elsewhere (see WENOHybridSensor()) */
+  int     hybrid;           /*!< Use the hybrid scheme? */
+  double  hybrid_tol;       /*!< Threshold of the smoothness sensor of the hybrid scheme */
+  int     *hybrid_flag;     /*!< Is each interface flagged by the sensor? (same layout as the weights, without the components) */
+  double  *hybrid_count;    /*!< Number of flagged interfaces, and number of interfaces, along each dimension since
+                                 the last report (separate for each dimension, since the dimensions may be
+                                 evaluated concurrently, see rhstasks.h) */
+  double  hybrid_fraction;  /*!< Fraction of flagged interfaces at the last report (negative if not reported) */
   /* size and offset for the WENO weights arrays */
   int *offset /*! Array containing the offset information for the WENO weights */,
       size /*! Size of the WENO weights array */;
@@ -222,6 +237,21 @@ typedef struct parameters_weno {
 int WENOInitialize(void*,void*,char*,char*);
 /*! Clean up the structure containing variables and parameters for WENO-type schemes */
 int WENOCleanup(void*, int);
+/*! Change the precision in which the WENO weights are saved */
+int WENOSetPrecision(void*,void*,int);
+/*! Flag the non-smooth interfaces, and set the optimal weights at the smooth ones (hybrid scheme) */
+int WENOHybridSensor(double*,int,void*,void*);
+/*! Report the fraction of interfaces flagged by the smoothness sensor of the hybrid scheme */
+int WENOHybridPostStep(void*,void*);
+/*! Fraction of interfaces flagged by the smoothness sensor at the last report */
+double WENOHybridFraction(void*);
+
+/*! \def _WENOWeight_
+  The \a i-th WENO weight from the array \a ws of weights saved in single precision if it is
+  not NULL, else from the array \a w of weights saved in double precision (see
+  #WENOParameters::single).
+*/
+#define _WENOWeight_(w,ws,i) ((ws) ? (double)((ws)[i]) : (w)[i])
 
 /* define optimal weights */
 /*! Optimal value for the first fifth-order WENO weight */
@@ -574,4 +604,56 @@ int CompactSchemeInitialize(void*,void*,char*);
 /*! Clean up the structure containing variables and parameters for compact schemes */
 int CompactSchemeCleanup(void*);
 
+/* storage modes for the interface eigensystem cache */
+/*! Do not cache the interface eigensystem (default) */
+#define _EIGEN_CACHE_NONE_ "none"
+/*! Cache the averaged state and the left eigenvectors at each interface; the right
+    eigenvectors are recomputed from the cached averaged state */
+#define _EIGEN_CACHE_LEFT_ "left"
+/*! Cache the averaged state and the left and right eigenvectors at each interface */
+#define _EIGEN_CACHE_FULL_ "full"
+
+/*! \def EigenCache
+    \brief Structure of variables/parameters needed by the interface eigensystem cache
+ * This structure contains the arrays to save the averaged state and the eigenvectors
+ * at the grid interfaces along one dimension.
+*/
+/*! \brief Structure of variables/parameters needed by the interface eigensystem cache
+ *
+ * With characteristic-based reconstruction (#_CHARACTERISTIC_), the averaged state and the left and
+ * right eigenvectors at an interface are needed by the WENO weights calculation, by each of the four
+ * interpolations (left- and right-biased, flux and solution) and by some of the upwinding functions.
+ * This cache computes them once per interface along the dimension being reconstructed in
+ * ReconstructHyperbolic(), and is invalidated once the interface flux along that dimension is
+ * computed, i.e., it is recomputed for every evaluation of the hyperbolic term.
+ * The memory footprint is selected through #HyPar::eigen_cache_type (input - \b solver.inp ):
+ * + #_EIGEN_CACHE_LEFT_: (nvars + nvars^2) doubles per interface
+ * + #_EIGEN_CACHE_FULL_: (nvars + 2 nvars^2) doubles per interface
+ *
+ * Since only one dimension is cached at a time, the arrays are sized for the dimension
+ * with the largest number of interfaces.
+*/
+typedef struct eigen_cache {
+
+  int     full;  /*!< Are the right eigenvectors cached too? (#_EIGEN_CACHE_FULL_) */
+  int     size;  /*!< Maximum number of interfaces (over all dimensions) that can be cached */
+  int     dir;   /*!< Dimension along which the cached data is valid (-1 if invalid) */
+
+  double  *uavg, /*!< Array to save the averaged state at the interfaces */
+          *L,    /*!< Array to save the left eigenvectors at the interfaces */
+          *R;    /*!< Array to save the right eigenvectors at the interfaces (#_EIGEN_CACHE_FULL_ only) */
+
+} EigenCache;
+
+/*! Initialize the interface eigensystem cache */
+int EigenCacheInitialize(void*,void*,char*);
+/*! Compute and save the averaged state and eigenvectors at all interfaces along a dimension */
+int EigenCacheCompute(double*,int,void*);
+/*! Fetch the cached averaged state and eigenvectors at an interface, if available */
+int EigenCacheGet(void*,int,int,double*,double*,double*);
+/*! Invalidate the interface eigensystem cache */
+int EigenCacheInvalidate(void*);
+/*! Clean up the interface eigensystem cache */
+int EigenCacheCleanup(void*);
+
 #endif
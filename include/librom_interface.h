@@ -64,6 +64,8 @@ class libROMInterface
       m_train_wctime = 0;
       m_predict_wctime = 0;
       m_save_ROM = true;
+      m_predict_batch_size = 32;
+      m_U_batch.clear();
     }
 
     /*! Constructor */
@@ -100,6 +102,8 @@ class libROMInterface
     inline double trainWallclockTime() const { return m_train_wctime; }
     /*! return the prediction wall clock time */
     inline double predictWallclockTime() const { return m_predict_wctime; }
+    /*! return the maximum number of times predicted together */
+    inline int predictBatchSize() const { return m_predict_batch_size; }
 
     /*! Take a sample for training */
     void takeSample( void* a_s, const double a_t );
@@ -113,6 +117,12 @@ class libROMInterface
     /*! Predict the solution at a given time */
     void predict(void*  a_s, const double a_t) const;
 
+    /*! Predict the solution at several times */
+    void predict(void*  a_s, const std::vector<double>& a_t);
+
+    /*! Copy the prediction at one of several times to HyPar */
+    void copyPredictionToHyPar(void* a_s, int a_k) const;
+
     /*! Save ROM object to file */
     void saveROM(const std::string& a_fname_root=""/*!< filename root */) const;
 
@@ -159,6 +169,9 @@ class libROMInterface
 
     bool m_save_ROM; /*!< Save ROM objects to file (default: yes) */
 
+    int m_predict_batch_size; /*!< Maximum number of times predicted together */
+    std::vector< std::vector<double> > m_U_batch; /*!< Predictions of each ROM object at several times */
+
   private:
 
 };
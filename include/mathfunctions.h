@@ -11,9 +11,15 @@
 /*! Function to calculate the grid points corresponding to a given interval */
 void FindInterval(double,double,double*,int,int*,int*);
 
+/*! Function to compute the finite-difference weights on an arbitrary set of points */
+void FornbergWeights(double,double*,int,int,double*);
+
 /*! Fill the ghost cells of a global n-dimensional array */
 void fillGhostCells(const int* const, const int, double* const, const int, const int, const int* const);
 
+/*! Function to compute bilinear interpolation coefficients */
+void BilinearInterpCoeffs(double,double,double,double,double,double,double*);
+
 /*! Function to compute trilinear interpolation coefficients */
 void TrilinearInterpCoeffs(double,double,double,double,double,double,double,double,double,double*);
 
@@ -27,4 +33,39 @@ int InterpolateGlobalnDVar( const int* const,
                             const int,
                             const int* const);
 
+/*! Range of source grid indices needed to interpolate a part of the destination grid */
+void InterpolateLocalSourceRange(const int,const int,const int,const int,int* const,int* const);
+
+/*! Block of the source grid needed to interpolate a part of the destination grid */
+int InterpolateLocalSourceBlock(const int,
+                                const int* const,
+                                const int* const,
+                                const int* const,
+                                const int* const,
+                                const int* const,
+                                int* const,
+                                int* const);
+
+/*! Extrapolate a block of the source grid to its points outside the grid */
+void InterpolateLocalExtrapolate( const int,
+                                  const int,
+                                  const int* const,
+                                  const int* const,
+                                  const int* const,
+                                  const int* const,
+                                  double* const);
+
+/*! Interpolate an n-dimensional grid variable from a block of one grid to a part of another */
+int InterpolateLocalnDVar(  const int* const,
+                            const int* const,
+                            const int* const,
+                            double* const,
+                            const int* const,
+                            const int* const,
+                            const int* const,
+                            const double* const,
+                            const int,
+                            const int,
+                            const int);
+
 #endif
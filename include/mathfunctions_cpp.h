@@ -39,4 +39,44 @@ extern "C" int InterpolateGlobalnDVar(const int* const,
                                       const int,
                                       const int* const);
 
+/*! Range of source grid indices needed to interpolate a part of the destination grid */
+extern "C" void InterpolateLocalSourceRange(const int,
+                                            const int,
+                                            const int,
+                                            const int,
+                                            int* const,
+                                            int* const);
+
+/*! Block of the source grid needed to interpolate a part of the destination grid */
+extern "C" int InterpolateLocalSourceBlock( const int,
+                                            const int* const,
+                                            const int* const,
+                                            const int* const,
+                                            const int* const,
+                                            const int* const,
+                                            int* const,
+                                            int* const);
+
+/*! Extrapolate a block of the source grid to its points outside the grid */
+extern "C" void InterpolateLocalExtrapolate(const int,
+                                            const int,
+                                            const int* const,
+                                            const int* const,
+                                            const int* const,
+                                            const int* const,
+                                            double* const);
+
+/*! Interpolate an n-dimensional grid variable from a block of one grid to a part of another */
+extern "C" int InterpolateLocalnDVar( const int* const,
+                                      const int* const,
+                                      const int* const,
+                                      double* const,
+                                      const int* const,
+                                      const int* const,
+                                      const int* const,
+                                      const double* const,
+                                      const int,
+                                      const int,
+                                      const int);
+
 #endif
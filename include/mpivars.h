@@ -52,6 +52,8 @@ int MPIPartitionArraynDwGhosts  (int,void*,double*,double*,int*,int*,int,int);
 /*! Partition a global array into local arrays for an essentially 1D array */
 int MPIPartitionArray1D         (void*,double*,double*,int,int,int,int);
 
+/*! fetch a block of a distributed n-dimensional array on every rank */
+int MPIGetArrayBlocknD      (int,int,int*,int*,int,int*,void*,double*,int*,int*,double*);
 /*! fetch data from an n-dimensional local array on another rank */
 int MPIGetArrayDatanD       (double*,double*,int*,int*,int*,int*,int,int,int,void*);
 
@@ -73,6 +75,33 @@ int MPISum_double           (double*,double*,int,void*);
 /*! Calculate the sum of an array of integers over all ranks */
 int MPISum_integer          (int*,int*,int,void*);
 
+/*! Sum reduction of a diagnostic quantity \sa MPIDiagnosticsPost() */
+#define _MPI_DIAG_SUM_ 0
+/*! Maximum reduction of a diagnostic quantity \sa MPIDiagnosticsPost() */
+#define _MPI_DIAG_MAX_ 1
+/*! Minimum reduction of a diagnostic quantity \sa MPIDiagnosticsPost() */
+#define _MPI_DIAG_MIN_ 2
+
+/*! Start deferring the reductions of diagnostic quantities posted on a communicator */
+int MPIDiagnosticsBegin     (void*);
+/*! Post the reduction of a diagnostic quantity (deferred, or carried out immediately) */
+int MPIDiagnosticsPost      (double*,double*,int,int,void*,int(*)(double*,int,void*),void*);
+/*! Start one packed nonblocking reduction of all the posted diagnostic quantities */
+int MPIDiagnosticsStart     ();
+/*! Complete the reduction of all the posted diagnostic quantities */
+int MPIDiagnosticsComplete  ();
+/*! Complete all the posted reductions and stop deferring them */
+int MPIDiagnosticsEnd       ();
+
+/*! Enable or disable the region profiler */
+void MPIProfilerEnable      (int);
+/*! Begin a profiled region */
+void MPIProfilerBegin       (const char*);
+/*! End a profiled region (with the number of bytes moved) */
+void MPIProfilerEnd         (const char*,double);
+/*! Report the profiled regions (minimum, average, maximum over all ranks) */
+int  MPIProfilerReport      (void*,const char*);
+
 /*! Partition (along a dimension) the domain given global size and number of ranks */
 int MPIPartition1D          (int,int,int);
 
@@ -48,6 +48,8 @@ extern "C" int MPIPartitionArraynDwGhosts (int,void*,double*,double*,int*,int*,i
 /*! Partition a global array into local arrays for an essentially 1D array */
 extern "C" int MPIPartitionArray1D        (void*,double*,double*,int,int,int,int);
 
+/*! fetch a block of a distributed n-dimensional array on every rank */
+extern "C" int MPIGetArrayBlocknD      (int,int,int*,int*,int,int*,void*,double*,int*,int*,double*);
 /*! fetch data from an n-dimensional local array on another rank */
 extern "C" int MPIGetArrayDatanD       (double*,double*,int*,int*,int*,int*,int,int,int,void*);
 
@@ -69,6 +71,30 @@ extern "C" int MPISum_double           (double*,double*,int,void*);
 /*! Calculate the sum of an array of integers over all ranks */
 extern "C" int MPISum_integer          (int*,int*,int,void*);
 
+/*! Enable or disable the region profiler */
+extern "C" void MPIProfilerEnable      (int);
+/*! Begin a profiled region */
+extern "C" void MPIProfilerBegin       (const char*);
+/*! End a profiled region (with the number of bytes moved) */
+extern "C" void MPIProfilerEnd         (const char*,double);
+/*! Report the profiled regions (minimum, average, maximum over all ranks) */
+extern "C" int  MPIProfilerReport      (void*,const char*);
+
+/*! \brief Profiled region for the scope of this object (see MPIProfilerBegin(), MPIProfilerEnd()) */
+class MPIProfilerScope
+{
+  public:
+    /*! Begin the region */
+    MPIProfilerScope(const char* a_name /*!< Name of the region */) : m_name(a_name), m_bytes(0) { MPIProfilerBegin(m_name); }
+    /*! End the region */
+    ~MPIProfilerScope() { MPIProfilerEnd(m_name,m_bytes); }
+    /*! Add to the number of bytes moved in this region */
+    inline void addBytes(double a_bytes /*!< Number of bytes */) { m_bytes += a_bytes; }
+  private:
+    const char* m_name; /*!< Name of the region */
+    double m_bytes;     /*!< Number of bytes moved */
+};
+
 /*! Partition (along a dimension) the domain given global size and number of ranks */
 extern "C" int MPIPartition1D          (int,int,int);
 
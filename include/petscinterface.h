@@ -13,6 +13,8 @@
 /* Copy Functions */
 int TransferVecToPETSc(const double* const,Vec,void*,const int,const int);
 int TransferVecFromPETSc(double* const,const Vec,void*,const int,const int);
+int TransferVecFromPETScAYPX(double* const,const double* const,const double,const Vec,void*,const int,const int);
+int TransferVecToPETScAXPBY(const double* const,const double* const,const double,const double,const Vec,Vec,void*,const int,const int);
 int TransferMatToPETSc(void*,Mat,void*);
 
 int PetscRegisterTIMethods (int);
@@ -44,7 +46,11 @@ PetscErrorCode PetscPostTimeStep    (TS);
 /* preconditioning functions */
 int PetscComputePreconMatIMEX(Mat,Vec,void*);
 int PetscComputePreconMatImpl(Mat,Vec,void*);
+int PetscCreatePreconMat(Mat*,void*);
 int PetscJacobianMatNonzeroEntriesImpl(Mat,int,void*);
+int PetscPreconADICreate(TS,Mat*,int,void*);
+int PetscPreconADISetUp(Vec,void*);
+PetscErrorCode PetscPreconADIApply(PC,Vec,Vec);
 
 /*! Function to compute any error estimates, if available */
 PetscErrorCode PetscTimeError (TS);
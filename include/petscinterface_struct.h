@@ -109,6 +109,20 @@ typedef struct _petsccontext_ {
   /*! Construct or use provided PC matrix */
   std::string precon_matrix_type;
 
+  /*! Number of assemblies of the preconditioning matrix \sa PetscComputePreconMatImpl() */
+  int precon_assembly_count;
+  /*! Total wall time (in seconds) of the assemblies of the preconditioning matrix */
+  double precon_assembly_wctime;
+
+  /*! Block-tridiagonal line systems along each dimension for the ADI preconditioner
+      (one array per simulation domain) \sa PetscPreconADISetUp() */
+  std::vector<double*> adi_blocks;
+  /*! Work arrays for the ADI preconditioner (one array per simulation domain)
+      \sa PetscPreconADIApply() */
+  std::vector<double*> adi_work;
+  /*! Block-tridiagonal solver for the ADI preconditioner (object of type #TridiagLU) */
+  void* adi_lu;
+
   /*! Flag to indicate if the system being solved for implicit time-integration is linear/nonlinear. */
   int flag_is_linear;
 
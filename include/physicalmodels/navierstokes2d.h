@@ -66,6 +66,11 @@
 /*! Rusanov's upwinding scheme */
 #define _RUSANOV_   "rusanov"
 
+/*! adiabatic immersed body wall */
+#define _IB_ADIABATIC_ "adiabatic"
+/*! isothermal immersed body wall */
+#define _IB_ISOTHERMAL_ "isothermal"
+
 /* directions */
 /*! dimension corresponding to the \a x spatial dimension */
 #define _XDIR_ 0
@@ -400,6 +405,15 @@ typedef struct navierstokes2d_parameters {
                                                                     3 - stratified atmosphere with a Brunt-Vaisala frequency) */;
   double N_bv; /*!< the Brunt-Vaisala frequency for #NavierStokes2D::HB = 3 */
 
+  /*! Type of immersed boundary wall: isothermal or adiabatic */
+  char ib_wall_type[_MAX_STRING_SIZE_];
+  /*! Immersed body wall temperature, if isothermal */
+  double T_ib_wall;
+  /*! Isothermal immersed boundary temperature tolerance: if ghost point temperature
+      differs from wall temperature by more than this factor, set it to the wall
+      temperature - sort of a limiting */
+  double ib_T_tol;
+
 #if defined(HAVE_CUDA)
   double *gpu_grav_field_f;
   double *gpu_grav_field_g;
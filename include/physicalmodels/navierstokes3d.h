@@ -44,6 +44,7 @@
 
 */
 
+#include <stdio.h>
 #include <basic.h>
 
 /*! 3D Navier-Stokes equations */
@@ -535,6 +536,21 @@ typedef struct navierstokes3d_parameters {
       temperature - sort of a limiting */
   double ib_T_tol;
 
+  /*! Compute the force and moment coefficients on the immersed body every this many
+      time steps (0 to not compute them), applicable only if #HyPar::flag_ib is 1 */
+  int ib_forces_freq;
+  /*! Reference area for the force and moment coefficients */
+  double ib_ref_area;
+  /*! Reference length for the moment coefficients */
+  double ib_ref_length;
+  /*! Point about which the moments are computed */
+  double ib_moment_center[_MODEL_NDIMS_];
+  /*! Force (x,y,z) and moment (x,y,z) coefficients, with the simulation time
+      they were computed at as the first entry */
+  double ib_forces[7];
+  /*! File to which the force and moment coefficients are written (rank 0 only) */
+  FILE *ib_forces_file;
+
 #if defined(HAVE_CUDA)
   double *gpu_Q;
   double *gpu_QDerivX;
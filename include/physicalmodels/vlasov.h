@@ -2,20 +2,20 @@
     @brief Vlasov Equation
     @author John Loffeld
 
-  1D-1V Vlasov Equation:
+  Vlasov Equation (in d spatial and d velocity dimensions, d = 1,2,3):
   \f{equation}{
       \frac{\partial f}{\partial t}
       +
-      v \frac{\partial f}{\partial x}
+      {\bf v} \cdot \nabla_{\bf x} f
       +
-      E \frac{\partial f}{\partial v}
+      {\bf E} \cdot \nabla_{\bf v} f
       = 0,
   \f}
   where
     + \f$f\f$ is the distribution function
-    + \f$x\f$ is the spatial coordinate
-    + \f$v\f$ is the velocity
-    + \f$E\f$ is the electric field
+    + \f${\bf x}\f$ is the spatial coordinate
+    + \f${\bf v}\f$ is the velocity
+    + \f${\bf E}\f$ is the electric field
 
   Reference:
     + Henon, "Vlasov equation?", Astronomy and Astrophysics, 114, 1982
@@ -39,7 +39,8 @@
 /* define ndims and nvars for this model */
 #undef _MODEL_NDIMS_
 #undef _MODEL_NVARS_
-/*! Number of spatial dimensions */
+/*! Number of spatial dimensions (for the default 1D-1V case; in general,
+    it is #Vlasov::ndims_x + #Vlasov::ndims_v) */
 #define _MODEL_NDIMS_ 2
 /*! Number of variables per grid point */
 #define _MODEL_NVARS_ 1
@@ -116,6 +117,15 @@ typedef struct vlasov_parameters {
   fftw_complex *phys_buffer_phi;
   /*! buffer */
   fftw_complex *fourier_buffer_phi;
+
+#ifndef serial
+  /*! Communicator of the ranks that own the same part of physical space (i.e.,
+      the ranks along velocity space); the charge density is summed over it */
+  MPI_Comm comm_v;
+  /*! Communicator of the ranks that own the same part of velocity space (i.e.,
+      the ranks along physical space); the FFTs are distributed over it */
+  MPI_Comm comm_x;
+#endif
 #endif
 
 } Vlasov;
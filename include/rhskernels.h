@@ -0,0 +1,30 @@
+/*! @file rhskernels.h
+    @brief Compile-time specialized kernels for the right-hand-side evaluation
+    @author Debojyoti Ghosh
+
+    The most frequently called loops of the right-hand-side evaluation
+    (the derivative of the interface fluxes, and the component-wise fifth
+    order WENO interpolation) are implemented as C++ templates on the number
+    of spatial dimensions and the number of solution components. The index
+    arrays are then of fixed size and the loops over the components are fully
+    unrolled by the compiler. The specialization is selected once, in
+    InitializeSolvers(), through RHSKernelsInitialize(); if the (ndims,nvars)
+    combination of a simulation is not one of the instantiated ones, the generic
+    (run-time sized) functions are used.
+*/
+
+#ifndef _RHSKERNELS_H_
+#define _RHSKERNELS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! Select the compile-time specialized right-hand-side kernels for a simulation */
+int RHSKernelsInitialize(void*,void*);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,58 @@
+/*! @file rhstasks.h
+    @brief Task-based, threaded evaluation of the hyperbolic term
+    @author Debojyoti Ghosh
+
+    The evaluation of the hyperbolic term along one spatial dimension (flux function,
+    reconstruction, upwinding, flux difference) does not depend on the other dimensions.
+    When compiled with OpenMP (\--enable-omp) and run with more than one thread per MPI
+    rank, HyperbolicFunctionAccumulate() creates one task per dimension; the tasks run concurrently,
+    each with its own set of work arrays, and the threaded loops inside each task (e.g.,
+    the interpolation kernels) use the threads assigned to that task. The contributions
+    of the dimensions are added to the hyperbolic term in order of the dimensions,
+    so the result is identical to that of the serial evaluation.
+*/
+
+#ifndef _RHSTASKS_H_
+#define _RHSTASKS_H_
+
+/*! \def RHSWork
+    \brief Work arrays for the evaluation of the hyperbolic term along one dimension
+*/
+/*! \brief Work arrays for the evaluation of the hyperbolic term along one dimension
+ *
+ * These are the arrays #HyPar::fluxC, #HyPar::uC, #HyPar::fluxI, #HyPar::uL, #HyPar::uR,
+ * #HyPar::fL, #HyPar::fR, or a separately allocated set of arrays of the same size.
+*/
+typedef struct rhs_work {
+  double *fluxC;  /*!< cell-centered flux */
+  double *uC;     /*!< modified solution for upwinding (see #HyPar::UFunction) */
+  double *fluxI;  /*!< upwind interface flux */
+  double *uL;     /*!< left-biased interface solution */
+  double *uR;     /*!< right-biased interface solution */
+  double *fL;     /*!< left-biased interface flux */
+  double *fR;     /*!< right-biased interface flux */
+} RHSWork;
+
+/*! \def RHSTasks
+    \brief Structure for the task-based evaluation of the hyperbolic term
+*/
+/*! \brief Structure for the task-based evaluation of the hyperbolic term
+ *
+ * Contains the number of concurrent dimension tasks, the number of threads
+ * available to each task, and the work arrays of each dimension. The arrays
+ * of dimension 0 are those of the solver object; those of the other dimensions
+ * are allocated in RHSTasksInitialize().
+*/
+typedef struct rhs_tasks {
+  int     ntasks;         /*!< Number of dimension tasks running concurrently */
+  int     nthreads_inner; /*!< Number of threads used by the threaded loops within a task */
+  RHSWork *work;          /*!< Work arrays for each dimension */
+  double  **hyp;          /*!< Contribution of each dimension (except 0) to the hyperbolic term */
+} RHSTasks;
+
+/*! Set up the task-based evaluation of the hyperbolic term */
+int RHSTasksInitialize(void*,void*);
+/*! Free the work arrays of the task-based evaluation of the hyperbolic term */
+int RHSTasksCleanup   (void*,int);
+
+#endif
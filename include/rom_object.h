@@ -15,6 +15,7 @@
 #define _LIBROM_INP_FNAME_ "librom.inp"
 
 #include <string>
+#include <vector>
 #include <linalg/Vector.h>
 
 /*! \class ROMObject
@@ -42,6 +43,15 @@ class ROMObject
     virtual void train() = 0;
     /*! compute prediction at given time */
     virtual const CAROM::Vector* const predict( const double ) const = 0;
+    /*! compute predictions at several times */
+    virtual void predict( const std::vector<double>& a_t, /*!< times at which to predict solution */
+                          double* const a_U /*!< predicted solutions, one after the other */ ) const
+    {
+      for (int k = 0; k < a_t.size(); k++) {
+        const CAROM::Vector* const u = predict(a_t[k]);
+        for (int i = 0; i < u->dim(); i++) a_U[k*u->dim()+i] = u->item(i);
+      }
+    }
     /*! save ROM object to file */
     virtual void save( const std::string& ) const = 0;
     /*! load ROM object from file */
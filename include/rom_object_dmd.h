@@ -17,6 +17,7 @@
 #include <linalg/Matrix.h>
 #include <algo/DMD.h>
 #include <rom_object.h>
+#include <rom_streaming_dmd.h>
 
 #ifndef serial
 #include <mpi.h>
@@ -52,6 +53,8 @@ class DMDROMObject : public ROMObject
     {
       for (int i = 0; i < m_dmd.size(); i++) delete m_dmd[i];
       m_dmd.clear();
+      for (int i = 0; i < m_sdmd.size(); i++) delete m_sdmd[i];
+      m_sdmd.clear();
       m_intervals.clear();
       m_dmd_is_trained.clear();
     }
@@ -59,6 +62,20 @@ class DMDROMObject : public ROMObject
     /*! Project initial solution for prediction */
     virtual void projectInitialSolution(  CAROM::Vector& a_U /*!< solution vector */ )
     {
+      if (m_streaming) {
+        if (m_sdmd.size() == 0) {
+          if (!m_rank) {
+            printf("ERROR in DMDROMObject::projectInitialSolution() - m_sdmd is a vector of size 0.\n");
+          }
+          return;
+        }
+        m_sdmd[0]->projectInitialCondition( &a_U );
+        for (int i = 1; i < m_sdmd.size(); i++) {
+          m_sdmd[i]->projectInitialCondition( m_sdmd[i-1]->predict(m_intervals[i].first) );
+        }
+        return;
+      }
+
       if (m_dmd.size() == 0) {
         if (!m_rank) {
           printf("ERROR in DMDROMObject::projectInitialSolution() - m_dmd is a vector of size 0.\n");
@@ -83,16 +100,20 @@ class DMDROMObject : public ROMObject
     virtual
     const CAROM::Vector* const predict(const double a_t /*!< time at which to predict solution */ ) const
     {
-      for (int i = 0; i < m_dmd.size(); i++) {
+      for (int i = 0; i < m_intervals.size(); i++) {
         if (   (a_t >= m_intervals[i].first)
             && (  (a_t < m_intervals[i].second) || (m_intervals[i].second < 0)  ) ){
-          return m_dmd[i]->predict(a_t);
+          if (m_streaming) return m_sdmd[i]->predict(a_t);
+          else             return m_dmd[i]->predict(a_t);
         }
       }
       printf("ERROR in DMDROMObject::predict(): m_dmd is of size zero or interval not found!");
       return nullptr;
     }
 
+    /*! compute predictions at several times */
+    virtual void predict(const std::vector<double>&, double* const) const;
+
     /*! save DMD object to file */
     virtual void save(const std::string& a_fname_root /*!< Filename root*/) const;
 
@@ -102,6 +123,7 @@ class DMDROMObject : public ROMObject
   protected:
 
     std::vector<CAROM::DMD*> m_dmd; /*!< Vector of DMD objects */
+    std::vector<StreamingDMD*> m_sdmd; /*!< Vector of streaming DMD objects (if #DMDROMObject::m_streaming) */
     std::vector<bool> m_dmd_is_trained; /*!< Flag to indicate if DMD is trained */
     std::vector<Interval> m_intervals; /*!< Time intervals for each DMD object */
 
@@ -122,6 +144,7 @@ class DMDROMObject : public ROMObject
     int m_var_idx; /*!< component index of this object if component-wise ROMs are being used */
 
     bool m_write_snapshot_mat;  /*!< Write snapshot matrix to file or not */
+    bool m_streaming;           /*!< Train the DMD incrementally (see #StreamingDMD) instead of storing the snapshots */
 
     std::string m_dirname; /*!< Subdirectory where DMD objects are written to or read from */
 
@@ -0,0 +1,105 @@
+#ifdef with_librom
+
+/*! @file rom_streaming_dmd.h
+    @brief Streaming Dynamic Mode Decomposition
+    @author Debojyoti Ghosh
+*/
+
+#ifndef _ROM_STREAMING_DMD_H_
+#define _ROM_STREAMING_DMD_H_
+
+#include <complex>
+#include <string>
+#include <vector>
+#include <linalg/Vector.h>
+
+/*! \class StreamingDMD
+ *  \brief DMD trained incrementally, one sample at a time
+ *
+ *  Streaming DMD (see Hemati, Williams, Rowley, "Dynamic mode decomposition
+ *  for large and streaming datasets", Phys. Fluids, 26, 2014). The snapshots
+ *  are not stored. Instead, each sample updates an orthonormal basis \f${\bf Q}\f$
+ *  (of at most #StreamingDMD::m_rdim columns) of the sampled solutions, and the
+ *  projected correlation matrices of consecutive snapshot pairs (\f${\bf x}_k, {\bf y}_k = {\bf x}_{k+1}\f$):
+ *  \f{equation}{
+ *    {\bf G}_x = \sum_k \tilde{\bf x}_k \tilde{\bf x}_k^T, \quad
+ *    {\bf G}_y = \sum_k \tilde{\bf y}_k \tilde{\bf y}_k^T, \quad
+ *    {\bf A} = \sum_k \tilde{\bf y}_k \tilde{\bf x}_k^T, \quad
+ *    \tilde{\bf x} = {\bf Q}^T{\bf x}.
+ *  \f}
+ *  A new sample that is not in the span of \f${\bf Q}\f$ adds a basis vector (Gram-Schmidt); if the
+ *  basis then has more than #StreamingDMD::m_rdim vectors, it is compressed to the dominant
+ *  eigenvectors of \f${\bf G}_x + {\bf G}_y\f$. Training computes the eigendecomposition of
+ *  the reduced operator \f$\tilde{\bf K} = {\bf A}{\bf G}_x^{+} = {\bf W}\Lambda{\bf W}^{-1}\f$; the
+ *  DMD modes are \f${\bf Q}{\bf W}\f$.
+ *
+ *  The memory is that of the basis (local vector size times #StreamingDMD::m_rdim + 1), and
+ *  the cost of a sample is linear in the vector size; training costs
+ *  \f$O\left(r^3\right)\f$ for the latent space dimension \f$r\f$.
+*/
+class StreamingDMD
+{
+  public:
+
+    /*! Constructor */
+    StreamingDMD(const int, const double, const int);
+
+    /*! Constructor (load from file) */
+    StreamingDMD(const std::string&, const int);
+
+    /*! Destructor */
+    ~StreamingDMD() { delete m_prediction; }
+
+    /*! take a sample */
+    void takeSample(const double* const, const double);
+
+    /*! train */
+    void train();
+
+    /*! project initial condition */
+    void projectInitialCondition(const CAROM::Vector* const);
+
+    /*! compute prediction at given time */
+    const CAROM::Vector* predict(const double) const;
+
+    /*! compute predictions at several times */
+    void predict(const double* const, const int, double* const) const;
+
+    /*! save to file */
+    void save(const std::string&) const;
+
+    /*! number of samples taken */
+    int numSamples() const { return m_nsamples; }
+
+  protected:
+
+    int     m_vec_size; /*!< Local size of the sampled vectors */
+    double  m_dt;       /*!< Time interval between samples */
+    int     m_rdim;     /*!< Maximum latent space dimension */
+    double  m_t_offset; /*!< Time of the first sample */
+    int     m_nsamples; /*!< Number of samples taken */
+
+    int                 m_r;      /*!< Current number of basis vectors */
+    std::vector<double> m_Q;      /*!< Basis (m_vec_size x m_r, column-major) */
+    std::vector<double> m_Gx;     /*!< \f${\bf G}_x\f$ (m_r x m_r, row-major) */
+    std::vector<double> m_Gy;     /*!< \f${\bf G}_y\f$ (m_r x m_r, row-major) */
+    std::vector<double> m_A;      /*!< \f${\bf A}\f$ (m_r x m_r, row-major) */
+    std::vector<double> m_x_prev; /*!< Projection of the previous sample */
+
+    std::vector< std::complex<double> > m_eigs; /*!< DMD eigenvalues */
+    std::vector< std::complex<double> > m_W;    /*!< Eigenvectors of the reduced operator (m_r x m_r, row-major) */
+    std::vector< std::complex<double> > m_b;    /*!< Coefficients of the projected initial condition */
+
+    CAROM::Vector *m_prediction; /*!< Predicted solution */
+
+  private:
+
+    /*! add a basis vector and pad the correlation matrices */
+    void addBasisVector(const double* const, const double);
+    /*! compress the basis to m_rdim vectors */
+    void compress();
+};
+
+#endif
+
+#endif
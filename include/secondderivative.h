@@ -47,7 +47,38 @@
 /* Second derivative functions */
 int SecondDerivativeSecondOrderCentral (double*,double*,int,void*,void*); /*!< Second order approximation to the second derivative (**note**: not divided by square of grid spacing). */
 int SecondDerivativeFourthOrderCentral (double*,double*,int,void*,void*); /*!< Fourth order approximation to the second derivative (**note**: not divided by square of grid spacing). */
+int SecondDerivativeNonUniform         (double*,double*,int,void*,void*); /*!< Approximation to the second derivative on a non-uniform grid (**note**: not divided by square of grid spacing). */
 
 int SecondDerivativeSecondOrderCentralNoGhosts (double*,double*,int,int,int*,int,int,void*); /*!< Second order approximation to the second derivative (**note**: not divided by square of grid spacing). */
 
+/*! \def NonUniformGrid
+    \brief Structure of the finite-difference coefficients on a non-uniform grid
+ * This structure contains the coefficients of the second derivative on a non-uniform grid.
+*/
+/*! \brief Structure of the finite-difference coefficients on a non-uniform grid
+ *
+ * On a non-uniform grid (#HyPar::nonuniform_grid), the grid spacing (#HyPar::dxinv) is a high-order
+ * approximation to the metric of the mapping from the uniform grid of the indices (see
+ * ComputeGridSpacing()), so that the uniform-grid approximations to the first derivative (and the
+ * reconstructions of the hyperbolic term), multiplied by #HyPar::dxinv, retain their order of
+ * accuracy on a smoothly stretched grid. This is not true for the second derivative, since it
+ * depends on the second derivative of the mapping; its coefficients are computed once from the
+ * grid (#HyPar::x) at each interior grid point along each dimension by NonUniformGridInitialize(),
+ * with the same (centered) stencil as the uniform-grid scheme that SecondDerivativeNonUniform()
+ * replaces. They are multiplied by the square of the grid spacing 1/#HyPar::dxinv at that point,
+ * since the second derivative is divided by it by the callers.
+*/
+typedef struct nonuniform_grid {
+
+  int     *offset;  /*!< Offset of each dimension in the array of coefficients */
+  int     width;    /*!< Width of the stencil of the second derivative */
+  double  *coeffs;  /*!< Coefficients of the second derivative (#NonUniformGrid::width per interior grid point) */
+
+} NonUniformGrid;
+
+/*! Compute the finite-difference coefficients on a non-uniform grid */
+int NonUniformGridInitialize(void*,void*);
+/*! Clean up the finite-difference coefficients on a non-uniform grid */
+int NonUniformGridCleanup(void*);
+
 #endif
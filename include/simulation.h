@@ -33,6 +33,7 @@ extern "C" void SimWriteErrors(void*, int, int, double, double);
 int SolvePETSc(void*,int, int, int);  /*!< Solve the PDE using PETSc TS */
 #endif
 int Solve(void*,int, int, int);/*!< Solve the PDE - time-integration */
+int GridSequencing(void*,int,int,int);/*!< Converge the solution on a sequence of coarser grids */
 
 /*! \class Simulation
     \brief Base class for a simulation
@@ -34,6 +34,8 @@ int TimePrintStep       (void*);
 int TimeError           (void*,void*,double*);
 /*! Function to get auxiliary solutions if available (for example, in GLM-GEE methods) */
 int TimeGetAuxSolutions (int*,double**,void*,int,int);
+/*! Check the accuracy of the mixed-precision storage */
+int TimeMixedPrecisionCheck(void*);
 
 /*! Take a step in time using the Forward Euler method */
 int TimeForwardEuler  (void*);
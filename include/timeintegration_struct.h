@@ -39,6 +39,14 @@ typedef struct time_integration_variables {
   double  dt;
   /*! Norm of the change in the solution at a time step */
   double  norm;
+  /*! Global number of points over which #TimeIntegration::norm is computed */
+  double  norm_npoints;
+  /*! First value of #TimeIntegration::norm (negative until it is computed) */
+  double  norm_initial;
+  /*! Time step (1-based) at which #TimeIntegration::norm was computed */
+  int     norm_iter;
+  /*! Whether #TimeIntegration::norm has dropped by #HyPar::residual_drop from its first value */
+  int     converged;
   /*! Maximum CFL at a time step */
   double  max_cfl;
   /*! Maximum diffusion number at a time step */
@@ -79,6 +87,9 @@ typedef struct time_integration_variables {
   double  **U;
   /*! Arrays to store stage right-hand-sides for a multi-stage time-integration method */
   double  **Udot;
+  /*! Arrays to store stage right-hand-sides in single precision for the explicit Runge-Kutta
+      methods, instead of #TimeIntegration::Udot, if #HyPar::mixed_precision is "yes" */
+  float   **Udot_single;
 
   /*! MPI rank of this process */
   int     rank;
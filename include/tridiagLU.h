@@ -111,6 +111,10 @@ typedef struct _tridiagLU_ {
 
 } TridiagLU;
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 int tridiagLU         (double*,double*,double*,double*,int,int,void*,void*);
 int tridiagLUGS       (double*,double*,double*,double*,int,int,void*,void*);
 int tridiagIterJacobi (double*,double*,double*,double*,int,int,void*,void*);
@@ -125,4 +129,8 @@ int blocktridiagIterJacobi (double*,double*,double*,double*,int,int,int,void*,vo
 int tridiagScaLPK     (double*,double*,double*,double*,int,int,void*,void*);
 #endif
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif
@@ -0,0 +1,383 @@
+/*! @file ArrayAllocate.c
+    @author Debojyoti Ghosh
+    @brief Allocation of the large solver arrays with NUMA-aware page placement.
+
+    The large arrays of a simulation (solution, right-hand-side terms, flux and
+    interface arrays, WENO weights, time-integration stages) are allocated through
+    ArrayAllocate() instead of calloc():
+    + The memory is aligned to a cache line, or, for arrays larger than a (transparent)
+      huge page, to the huge page size, and huge pages are requested with madvise().
+    + The memory is zeroed in parallel with the same static partitioning of the
+      threads as the threaded loops that use it, so that, with a first-touch page
+      placement policy, each page is placed on the NUMA node of the thread that
+      will access it (calloc zero-fills from the main thread, which places all
+      the pages on one NUMA node). The threaded kernels loop over the grid lines
+      along a dimension with a static schedule, so the arrays laid out on the grid
+      are zeroed line by line with the same loop (ArrayAllocateGrid(),
+      ArrayAllocateInterfaces()); other arrays are zeroed with a static loop over
+      their elements (ArrayAllocate()).
+
+    The allocated arrays are recorded, and ArrayAllocationReport() prints the
+    NUMA node(s) that their pages reside on. Arrays allocated with ArrayAllocate()
+    are freed with ArrayFree().
+*/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <basic.h>
+#include <math_ops.h>
+#include <arrayfunctions.h>
+
+#ifdef with_omp
+#include <omp.h>
+#endif
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+/*! Alignment (bytes) of the allocated arrays: a cache line */
+#define _ARRAY_ALIGNMENT_           64
+/*! Size (bytes) of a (transparent) huge page */
+#define _ARRAY_HUGEPAGE_SIZE_       (2*1024*1024)
+/*! Maximum number of pages of an array sampled for the placement report */
+#define _ARRAY_REPORT_MAX_PAGES_    1024
+/*! Maximum number of NUMA nodes reported */
+#define _ARRAY_REPORT_MAX_NODES_    64
+
+/*! \brief Record of an array allocated with ArrayAllocate() */
+typedef struct _array_allocation_ {
+  char    name[_MAX_STRING_SIZE_];  /*!< name of the array */
+  void    *ptr;                     /*!< pointer to the array */
+  size_t  bytes;                    /*!< size of the array in bytes */
+} ArrayAllocation;
+
+/*! Arrays allocated with ArrayAllocate() and not yet freed; arrays are allocated
+    and freed by the main thread only, during initialization and clean up */
+static ArrayAllocation  *array_allocations = NULL;
+/*! Number of entries in #array_allocations */
+static int              n_array_allocations = 0;
+
+/*! Allocate \a bytes bytes, aligned (to the huge page size for large arrays), and record
+    the allocation; the memory is not touched. Returns NULL if the allocation fails. */
+static void* ArrayAllocateBytes(size_t     bytes,          /*!< Number of bytes */
+                                size_t     *bytes_aligned, /*!< Number of bytes allocated (rounded up) */
+                                const char *name           /*!< Name of the array (for the placement report) */
+                               )
+{
+  if (!bytes) bytes = sizeof(double);
+  size_t alignment = (bytes >= _ARRAY_HUGEPAGE_SIZE_ ? _ARRAY_HUGEPAGE_SIZE_ : _ARRAY_ALIGNMENT_);
+  /* round up to a multiple of the alignment so that the huge page advice covers the array */
+  *bytes_aligned = ((bytes + alignment - 1) / alignment) * alignment;
+
+  void *ptr = NULL;
+  if (posix_memalign(&ptr, alignment, *bytes_aligned)) {
+    fprintf(stderr,"Error in ArrayAllocate(): unable to allocate %s (%lu bytes).\n",
+            name, (unsigned long) *bytes_aligned);
+    return(NULL);
+  }
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (alignment == _ARRAY_HUGEPAGE_SIZE_) madvise(ptr, *bytes_aligned, MADV_HUGEPAGE);
+#endif
+
+  array_allocations = (ArrayAllocation*) realloc (array_allocations,
+                                                  (n_array_allocations+1)*sizeof(ArrayAllocation));
+  ArrayAllocation *entry = &array_allocations[n_array_allocations];
+  strncpy(entry->name, name, _MAX_STRING_SIZE_-1);
+  entry->name[_MAX_STRING_SIZE_-1] = '\0';
+  entry->ptr   = ptr;
+  entry->bytes = *bytes_aligned;
+  n_array_allocations++;
+
+  return(ptr);
+}
+
+/*! Zero \a bytes bytes with a static loop over the elements (first touch of the arrays
+    that are not laid out on the grid, and of the remainder of those that are) */
+static void ArrayFirstTouchFlat(char   *x,     /*!< Memory to zero */
+                                size_t bytes   /*!< Number of bytes */
+                               )
+{
+  double *xd = (double*) x;
+  long i, n = (long) (bytes / sizeof(double));
+#pragma omp parallel for schedule(static) default(shared) private(i)
+  for (i = 0; i < n; i++) xd[i] = 0.0;
+  memset(x + n*sizeof(double), 0, bytes - n*sizeof(double));
+}
+
+/*! Zero an array laid out on a grid (with \a nvars values of \a elsize bytes at each grid
+    point) with the loop of the threaded kernels along dimension \a dir: a static schedule
+    over the interior grid lines along \a dir (see for example Interp1PrimFifthOrderWENO()).
+    Each iteration zeroes its line, including the ghost points along \a dir, and the ghost
+    lines next to it if it is a boundary line, so that every page is first touched by the
+    thread that computes on it. */
+static void ArrayFirstTouchLines(char       *x,      /*!< Array to zero */
+                                 size_t     elsize,  /*!< Size of each value in bytes */
+                                 int        ndims,   /*!< Number of spatial dimensions */
+                                 const int  *dim,    /*!< Grid size along each dimension (without ghosts) */
+                                 int        ghosts,  /*!< Number of ghost points */
+                                 int        nvars,   /*!< Number of values at each grid point */
+                                 int        dir      /*!< Dimension along which the grid lines lie */
+                                )
+{
+  size_t bytes_point = nvars * elsize;
+  int bounds_outer[ndims];
+  _ArrayCopy1D_(dim,bounds_outer,ndims); bounds_outer[dir] = 1;
+  int N_outer; _ArrayProduct1D_(bounds_outer,ndims,N_outer);
+
+  int i;
+#pragma omp parallel for schedule(static) default(shared) private(i)
+  for (i = 0; i < N_outer; i++) {
+    int index_outer[ndims], index_box[ndims], index[ndims], lo[ndims], nbox[ndims];
+    int k, l, p, nlines = 1;
+    _ArrayIndexnD_(ndims,i,bounds_outer,index_outer,0);
+    /* box of lines zeroed by this iteration: the line itself, and the ghost lines
+       beyond it if it is the first or last interior line along another dimension */
+    for (k = 0; k < ndims; k++) {
+      if (k == dir) {
+        lo[k] = 0;
+        nbox[k] = 1;
+      } else {
+        lo[k]   = (index_outer[k] == 0 ? -ghosts : index_outer[k]);
+        nbox[k] = (index_outer[k] == dim[k]-1 ? dim[k]+ghosts : index_outer[k]+1) - lo[k];
+        nlines *= nbox[k];
+      }
+    }
+    for (l = 0; l < nlines; l++) {
+      _ArrayIndexnD_(ndims,l,nbox,index_box,0);
+      _ArrayAdd1D_(index,index_box,lo,ndims);
+      for (index[dir] = -ghosts; index[dir] < dim[dir]+ghosts; index[dir]++) {
+        _ArrayIndex1D_(ndims,dim,index,ghosts,p);
+        memset(x + p*bytes_point, 0, bytes_point);
+      }
+    }
+  }
+}
+
+/*! Allocate an array of \a n doubles, aligned (to the huge page size for large arrays)
+    and zeroed in parallel with a static loop over its elements (see the description of
+    this file). Arrays laid out on the grid are allocated with ArrayAllocateGrid() or
+    ArrayAllocateInterfaces() instead. Returns NULL if the allocation fails. */
+double* ArrayAllocate(size_t     n,    /*!< Number of doubles */
+                      const char *name /*!< Name of the array (for the placement report) */
+                     )
+{
+  size_t bytes_aligned;
+  char *x = (char*) ArrayAllocateBytes(n*sizeof(double),&bytes_aligned,name);
+  if (!x) return(NULL);
+  ArrayFirstTouchFlat(x,bytes_aligned);
+  return((double*)x);
+}
+
+/*! Allocate an array of \a n floats (for the arrays stored in single precision, see
+    #HyPar::mixed_precision) in the same way as ArrayAllocate(); it is freed with ArrayFree().
+    Returns NULL if the allocation fails. */
+float* ArrayAllocateSingle(size_t     n,    /*!< Number of floats */
+                           const char *name /*!< Name of the array (for the placement report) */
+                          )
+{
+  return((float*) ArrayAllocate((n+1)/2,name));
+}
+
+/*! Allocate \a n values of \a elsize bytes that hold one or more consecutive arrays of
+    grid points (see ArrayAllocateGrid()) */
+static void* ArrayAllocateGridValues(size_t     n,      /*!< Number of values */
+                                     size_t     elsize, /*!< Size of each value in bytes */
+                                     int        ndims,  /*!< Number of spatial dimensions */
+                                     const int  *dim,   /*!< Grid size along each dimension (without ghosts) */
+                                     int        ghosts, /*!< Number of ghost points */
+                                     int        nvars,  /*!< Number of values at each grid point */
+                                     int        dir,    /*!< Dimension of the grid lines of the kernels */
+                                     const char *name   /*!< Name of the array (for the placement report) */
+                                    )
+{
+  size_t bytes_aligned, size = nvars;
+  int d;
+  for (d = 0; d < ndims; d++) size *= (dim[d]+2*ghosts);
+
+  char *x = (char*) ArrayAllocateBytes(n*elsize,&bytes_aligned,name);
+  if (!x) return(NULL);
+
+  size_t c, ncopies = (size ? n/size : 0);
+  for (c = 0; c < ncopies; c++) ArrayFirstTouchLines(x+c*size*elsize,elsize,ndims,dim,ghosts,nvars,dir);
+  ArrayFirstTouchFlat(x+ncopies*size*elsize,bytes_aligned-ncopies*size*elsize);
+  return(x);
+}
+
+/*! Allocate an array of \a n doubles that holds one or more consecutive arrays laid out on
+    a grid with \a nvars values at each point (for example, a solution with ghost points, or
+    the solutions of an ensemble of simulations on the same grid). The grid arrays are zeroed
+    with the loop of the threaded kernels along dimension \a dir (see ArrayFirstTouchLines());
+    the remainder of the array, if any, is zeroed like in ArrayAllocate(). The arrays used by
+    the kernels along every dimension are placed for the first one: for the lines along any
+    dimension but the last, the kernels give each thread the same contiguous slab of the array.
+    Returns NULL if the allocation fails. */
+double* ArrayAllocateGrid(size_t     n,      /*!< Number of doubles */
+                          int        ndims,  /*!< Number of spatial dimensions */
+                          const int  *dim,   /*!< Grid size along each dimension (without ghosts) */
+                          int        ghosts, /*!< Number of ghost points */
+                          int        nvars,  /*!< Number of values at each grid point */
+                          int        dir,    /*!< Dimension of the grid lines of the kernels */
+                          const char *name   /*!< Name of the array (for the placement report) */
+                         )
+{
+  return((double*) ArrayAllocateGridValues(n,sizeof(double),ndims,dim,ghosts,nvars,dir,name));
+}
+
+/*! Allocate an array of \a n floats laid out on a grid in the same way as ArrayAllocateGrid()
+    (for the arrays stored in single precision, see #HyPar::mixed_precision). Returns NULL if
+    the allocation fails. */
+float* ArrayAllocateGridSingle(size_t     n,      /*!< Number of floats */
+                               int        ndims,  /*!< Number of spatial dimensions */
+                               const int  *dim,   /*!< Grid size along each dimension (without ghosts) */
+                               int        ghosts, /*!< Number of ghost points */
+                               int        nvars,  /*!< Number of values at each grid point */
+                               int        dir,    /*!< Dimension of the grid lines of the kernels */
+                               const char *name   /*!< Name of the array (for the placement report) */
+                              )
+{
+  return((float*) ArrayAllocateGridValues(n,sizeof(float),ndims,dim,ghosts,nvars,dir,name));
+}
+
+/*! Allocate \a ncopies copies of a set of interface arrays (see ArrayAllocateInterfaces()) with
+    values of \a elsize bytes */
+static void* ArrayAllocateInterfaceValues(size_t     elsize,  /*!< Size of each value in bytes */
+                                          int        ndims,   /*!< Number of spatial dimensions */
+                                          const int  *dim,    /*!< Grid size along each dimension */
+                                          int        nvars,   /*!< Number of values at each interface */
+                                          int        ncopies, /*!< Number of copies of the set */
+                                          const char *name    /*!< Name of the array (for the placement report) */
+                                         )
+{
+  int c, d, bounds_inter[ndims];
+  size_t bytes_aligned, size_set = 0, offset = 0;
+  for (d = 0; d < ndims; d++) {
+    size_t size = nvars;
+    int k;
+    for (k = 0; k < ndims; k++) size *= (k == d ? dim[k]+1 : dim[k]);
+    size_set += size;
+  }
+
+  char *x = (char*) ArrayAllocateBytes(ncopies*size_set*elsize,&bytes_aligned,name);
+  if (!x) return(NULL);
+
+  for (c = 0; c < ncopies; c++) {
+    for (d = 0; d < ndims; d++) {
+      _ArrayCopy1D_(dim,bounds_inter,ndims); bounds_inter[d] += 1;
+      ArrayFirstTouchLines(x+offset*elsize,elsize,ndims,bounds_inter,0,nvars,d);
+      size_t size; _ArrayProduct1D_(bounds_inter,ndims,size);
+      offset += size*nvars;
+    }
+  }
+  ArrayFirstTouchFlat(x+offset*elsize,bytes_aligned-offset*elsize);
+  return(x);
+}
+
+/*! Allocate \a ncopies copies of a set of interface arrays: for each dimension, in order, an
+    array of the interfaces along that dimension (with \a nvars values at each interface), laid
+    out like the WENO weights (see #WENOParameters::offset). Each array is zeroed with the loop
+    of the threaded kernels over the grid lines along its dimension (see ArrayFirstTouchLines()).
+    Returns NULL if the allocation fails. */
+double* ArrayAllocateInterfaces(int        ndims,   /*!< Number of spatial dimensions */
+                                const int  *dim,    /*!< Grid size along each dimension */
+                                int        nvars,   /*!< Number of values at each interface */
+                                int        ncopies, /*!< Number of copies of the set */
+                                const char *name    /*!< Name of the array (for the placement report) */
+                               )
+{
+  return((double*) ArrayAllocateInterfaceValues(sizeof(double),ndims,dim,nvars,ncopies,name));
+}
+
+/*! Allocate \a ncopies copies of a set of interface arrays of floats in the same way as
+    ArrayAllocateInterfaces() (for the arrays stored in single precision, see
+    #HyPar::mixed_precision). Returns NULL if the allocation fails. */
+float* ArrayAllocateInterfacesSingle(int        ndims,   /*!< Number of spatial dimensions */
+                                     const int  *dim,    /*!< Grid size along each dimension */
+                                     int        nvars,   /*!< Number of values at each interface */
+                                     int        ncopies, /*!< Number of copies of the set */
+                                     const char *name    /*!< Name of the array (for the placement report) */
+                                    )
+{
+  return((float*) ArrayAllocateInterfaceValues(sizeof(float),ndims,dim,nvars,ncopies,name));
+}
+
+/*! Free an array allocated with ArrayAllocate() */
+void ArrayFree(void *ptr /*!< Array to free */)
+{
+  int i;
+  if (!ptr) return;
+  for (i = 0; i < n_array_allocations; i++) {
+    if (array_allocations[i].ptr == ptr) {
+      array_allocations[i] = array_allocations[n_array_allocations-1];
+      n_array_allocations--;
+      break;
+    }
+  }
+  if (!n_array_allocations) {
+    free(array_allocations);
+    array_allocations = NULL;
+  }
+  free(ptr);
+}
+
+/*! Print the size of the arrays allocated with ArrayAllocate() and the distribution of their
+    pages over the NUMA nodes (sampled at up to #_ARRAY_REPORT_MAX_PAGES_ pages per array).
+    The placement is queried with the move_pages system call (Linux only). Only the arrays
+    of the calling process are reported, so this should be called on one rank. */
+int ArrayAllocationReport(void)
+{
+  int i, k;
+  double total = 0;
+  for (i = 0; i < n_array_allocations; i++) total += (double) array_allocations[i].bytes;
+  printf("Solver arrays: %d arrays, %1.2f MB", n_array_allocations, total/(1024.0*1024.0));
+#ifdef with_omp
+  printf(" (first-touch by %d threads)", omp_get_max_threads());
+#endif
+  printf(".\n");
+
+#if defined(__linux__) && defined(SYS_move_pages)
+  long page_size = sysconf(_SC_PAGESIZE);
+  for (i = 0; i < n_array_allocations; i++) {
+
+    ArrayAllocation *entry = &array_allocations[i];
+    long npages_total = (long) ((entry->bytes + page_size - 1) / page_size);
+    long npages = min(npages_total, _ARRAY_REPORT_MAX_PAGES_);
+
+    void  *pages[_ARRAY_REPORT_MAX_PAGES_];
+    int   status[_ARRAY_REPORT_MAX_PAGES_];
+    for (k = 0; k < npages; k++) {
+      long page = (k * npages_total) / npages;
+      pages[k] = (char*) entry->ptr + page * page_size;
+      status[k] = -1;
+    }
+    /* with a NULL list of target nodes, move_pages() returns the node of each page */
+    if (syscall(SYS_move_pages, 0, npages, pages, NULL, status, 0)) {
+      printf("  %-16s %10.2f MB  (NUMA placement not available)\n",
+             entry->name, ((double)entry->bytes)/(1024.0*1024.0));
+      continue;
+    }
+
+    int count[_ARRAY_REPORT_MAX_NODES_], other = 0;
+    _ArraySetValue_(count,_ARRAY_REPORT_MAX_NODES_,0);
+    for (k = 0; k < npages; k++) {
+      if ((status[k] >= 0) && (status[k] < _ARRAY_REPORT_MAX_NODES_)) count[status[k]]++;
+      else other++;
+    }
+    printf("  %-16s %10.2f MB ", entry->name, ((double)entry->bytes)/(1024.0*1024.0));
+    for (k = 0; k < _ARRAY_REPORT_MAX_NODES_; k++) {
+      if (count[k]) printf(" node %d: %5.1f%%", k, 100.0*((double)count[k])/((double)npages));
+    }
+    if (other) printf(" not resident: %5.1f%%", 100.0*((double)other)/((double)npages));
+    printf("\n");
+  }
+#else
+  printf("  NUMA placement of the arrays is not available on this platform.\n");
+#endif
+
+  return(0);
+}
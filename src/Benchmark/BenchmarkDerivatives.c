@@ -0,0 +1,83 @@
+/*! @file BenchmarkDerivatives.c
+    @brief Micro-benchmarks of the finite-difference first and second derivatives
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <firstderivative.h>
+#include <secondderivative.h>
+#include <benchmark.h>
+
+/*! \brief Finite-difference operator to benchmark */
+typedef struct benchmark_deriv_operator {
+  const char *name;   /*!< Name of the kernel */
+  int (*first) (double*,double*,int,int,void*,void*); /*!< First derivative function (or NULL) */
+  int (*second)(double*,double*,int,void*,void*);     /*!< Second derivative function (or NULL) */
+  double     flops;   /*!< Estimated operations per grid point per variable */
+} BenchmarkDerivOperator;
+
+/*! The benchmarked operators */
+static const BenchmarkDerivOperator operators[] = {
+  { "deriv1:1", FirstDerivativeFirstOrder        , NULL                              , 1.0 },
+  { "deriv1:2", FirstDerivativeSecondOrderCentral, NULL                              , 2.0 },
+  { "deriv1:4", FirstDerivativeFourthOrderCentral, NULL                              , 6.0 },
+  { "deriv2:2", NULL                             , SecondDerivativeSecondOrderCentral, 3.0 },
+  { "deriv2:4", NULL                             , SecondDerivativeFourthOrderCentral, 8.0 }
+};
+
+/*! \brief Context of the derivative kernel */
+typedef struct benchmark_deriv_context {
+  BenchmarkProblem              *problem;  /*!< Problem object */
+  const BenchmarkDerivOperator  *op;       /*!< Operator */
+} BenchmarkDerivContext;
+
+/*! Derivative kernel: apply the operator along each dimension */
+static int BenchmarkDerivKernel(void *c)
+{
+  BenchmarkDerivContext *ctxt    = (BenchmarkDerivContext*) c;
+  BenchmarkProblem      *problem = ctxt->problem;
+  HyPar                 *solver  = &(problem->solver);
+  MPIVariables          *mpi     = &(problem->mpi);
+  int d;
+  _DECLARE_IERR_;
+
+  for (d = 0; d < solver->ndims; d++) {
+    if (ctxt->op->first) {
+      IERR ctxt->op->first(problem->Df,problem->f,d,1,solver,mpi); CHECKERR(ierr);
+    } else {
+      IERR ctxt->op->second(problem->Df,problem->f,d,solver,mpi); CHECKERR(ierr);
+    }
+  }
+  return(0);
+}
+
+/*!
+  Benchmark the finite-difference first (FirstDerivative*) and second (SecondDerivative*)
+  derivative operators on a synthetic problem: each kernel call applies the operator along each
+  dimension. The estimated memory traffic is one read of the function and one write of the
+  derivative (with ghost points) per dimension.
+*/
+int BenchmarkDerivatives(
+                          BenchmarkSettings *settings,  /*!< Benchmark settings */
+                          BenchmarkProblem  *problem    /*!< Problem object */
+                        )
+{
+  HyPar *solver = &(problem->solver);
+  int   nops    = sizeof(operators)/sizeof(BenchmarkDerivOperator), n;
+  _DECLARE_IERR_;
+
+  double npoints    = (double) solver->ndims * solver->npoints_local * solver->nvars,
+         npoints_wg = (double) solver->ndims * solver->npoints_local_wghosts * solver->nvars;
+
+  for (n = 0; n < nops; n++) {
+    BenchmarkDerivContext ctxt;
+    ctxt.problem = problem;
+    ctxt.op      = &operators[n];
+    IERR BenchmarkRun(settings,operators[n].name,problem,
+                      8.0*2.0*npoints_wg,operators[n].flops*npoints,
+                      NULL,BenchmarkDerivKernel,&ctxt); CHECKERR(ierr);
+  }
+
+  return(0);
+}
@@ -0,0 +1,170 @@
+/*! @file BenchmarkInterpolation.c
+    @brief Micro-benchmarks of the interpolation schemes
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <arrayfunctions.h>
+#include <interpolation.h>
+#include <tridiagLU.h>
+#include <benchmark.h>
+
+/*! \brief Interpolation scheme to benchmark */
+typedef struct benchmark_interp_scheme {
+  const char *name;       /*!< Name of the kernel */
+  const char *scheme;     /*!< Scheme (#HyPar::spatial_scheme_hyp) */
+  int (*interp)(double*,double*,double*,double*,int,int,void*,void*,int); /*!< Interpolation function */
+  int        weno;        /*!< Type of WENO weights (-1: not a WENO-type scheme, 0: JS, 1: M, 2: Z, 3: YC) */
+  int        muscl;       /*!< Uses #MUSCLParameters? */
+  int        compact;     /*!< Solves tridiagonal systems? */
+  double     flops_interp;  /*!< Estimated operations per interface per variable of each interpolation */
+  double     flops_weights; /*!< Estimated operations per interface per variable of the nonlinear weights */
+} BenchmarkInterpScheme;
+
+/*! The benchmarked schemes; the operation counts are estimated from the formulas of the schemes
+    (the nonlinear weights are computed for the left- and right-biased interpolations of both the
+    flux and the solution, as in the hyperbolic term). */
+static const BenchmarkInterpScheme schemes[] = {
+  { "interp:1"      , _FIRST_ORDER_UPWIND_        , Interp1PrimFirstOrderUpwind       , -1, 0, 0,  0.0,   0.0 },
+  { "interp:2"      , _SECOND_ORDER_CENTRAL_      , Interp1PrimSecondOrderCentral     , -1, 0, 0,  2.0,   0.0 },
+  { "interp:4"      , _FOURTH_ORDER_CENTRAL_      , Interp1PrimFourthOrderCentral     , -1, 0, 0,  7.0,   0.0 },
+  { "interp:upw5"   , _FIFTH_ORDER_UPWIND_        , Interp1PrimFifthOrderUpwind       , -1, 0, 0,  9.0,   0.0 },
+  { "interp:muscl2" , _SECOND_ORDER_MUSCL_        , Interp1PrimSecondOrderMUSCL       , -1, 1, 0, 12.0,   0.0 },
+  { "interp:muscl3" , _THIRD_ORDER_MUSCL_         , Interp1PrimThirdOrderMUSCL        , -1, 1, 0, 16.0,   0.0 },
+  { "interp:cupw5"  , _FIFTH_ORDER_COMPACT_UPWIND_, Interp1PrimFifthOrderCompactUpwind, -1, 0, 1, 17.0,   0.0 },
+  { "interp:weno5-js", _FIFTH_ORDER_WENO_         , Interp1PrimFifthOrderWENO         ,  0, 0, 0, 20.0, 204.0 },
+  { "interp:weno5-m" , _FIFTH_ORDER_WENO_         , Interp1PrimFifthOrderWENO         ,  1, 0, 0, 20.0, 312.0 },
+  { "interp:weno5-z" , _FIFTH_ORDER_WENO_         , Interp1PrimFifthOrderWENO         ,  2, 0, 0, 20.0, 224.0 },
+  { "interp:weno5-yc", _FIFTH_ORDER_WENO_         , Interp1PrimFifthOrderWENO         ,  3, 0, 0, 20.0, 224.0 },
+  { "interp:crweno5", _FIFTH_ORDER_CRWENO_        , Interp1PrimFifthOrderCRWENO       ,  0, 0, 1, 30.0, 204.0 },
+  { "interp:hcweno5", _FIFTH_ORDER_HCWENO_        , Interp1PrimFifthOrderHCWENO       ,  0, 0, 1, 35.0, 204.0 }
+};
+
+/*! \brief Context of the interpolation kernel */
+typedef struct benchmark_interp_context {
+  BenchmarkProblem            *problem; /*!< Problem object */
+  const BenchmarkInterpScheme *scheme;  /*!< Scheme */
+} BenchmarkInterpContext;
+
+/*! Interpolation kernel: along each dimension, compute the nonlinear weights (for WENO-type
+    schemes) and the left- and right-biased interface fluxes. */
+static int BenchmarkInterpKernel(void *c)
+{
+  BenchmarkInterpContext *ctxt    = (BenchmarkInterpContext*) c;
+  BenchmarkProblem       *problem = ctxt->problem;
+  HyPar                  *solver  = &(problem->solver);
+  MPIVariables           *mpi     = &(problem->mpi);
+  int d, offset = 0;
+  _DECLARE_IERR_;
+
+  for (d = 0; d < solver->ndims; d++) {
+    double *x = problem->x + offset;
+    if (ctxt->scheme->weno >= 0) {
+      IERR solver->SetInterpLimiterVar(problem->f,problem->u,x,d,solver,mpi); CHECKERR(ierr);
+    }
+    IERR ctxt->scheme->interp(problem->fL,problem->f,problem->u,x, 1,d,solver,mpi,0); CHECKERR(ierr);
+    IERR ctxt->scheme->interp(problem->fR,problem->f,problem->u,x,-1,d,solver,mpi,0); CHECKERR(ierr);
+    offset += solver->dim_local[d] + 2*solver->ghosts;
+  }
+  return(0);
+}
+
+/*!
+  Benchmark the component-wise interpolation schemes (Interp1Prim*) on a synthetic problem:
+  each kernel call computes, along each dimension, the nonlinear weights (for the WENO-type
+  schemes, see WENOFifthOrderCalculateWeights()) and the left- and right-biased interface
+  values of the flux. The estimated memory traffic counts one pass over the cell-centered
+  arrays and the interface arrays read or written by each function (including the weights
+  and the tridiagonal system arrays of the compact schemes).
+*/
+int BenchmarkInterpolation(
+                            BenchmarkSettings *settings,  /*!< Benchmark settings */
+                            BenchmarkProblem  *problem    /*!< Problem object */
+                          )
+{
+  HyPar         *solver = &(problem->solver);
+  MPIVariables  *mpi    = &(problem->mpi);
+  int           ndims   = solver->ndims,
+                nvars   = solver->nvars,
+                nschemes = sizeof(schemes)/sizeof(BenchmarkInterpScheme),
+                n, d, selected = 0;
+  _DECLARE_IERR_;
+
+  for (n = 0; n < nschemes; n++) selected = (selected || BenchmarkSelected(settings,schemes[n].name));
+  if (!selected) return(0);
+
+  /* WENO, MUSCL, and compact scheme objects */
+  WENOParameters *weno = (WENOParameters*) calloc (1,sizeof(WENOParameters));
+  solver->interp = weno;
+  IERR WENOInitialize(solver,mpi,_FIFTH_ORDER_WENO_,solver->interp_type); CHECKERR(ierr);
+
+  MUSCLParameters *muscl = (MUSCLParameters*) calloc (1,sizeof(MUSCLParameters));
+  solver->interp = muscl;
+  IERR MUSCLInitialize(solver,mpi); CHECKERR(ierr);
+
+  solver->compact = (CompactScheme*) calloc (1,sizeof(CompactScheme));
+  IERR CompactSchemeInitialize(solver,mpi,solver->interp_type); CHECKERR(ierr);
+  solver->lusolver = (TridiagLU*) calloc (1,sizeof(TridiagLU));
+  IERR tridiagLUInit(solver->lusolver,&mpi->world); CHECKERR(ierr);
+
+  /* cell-centered and interface points along each dimension */
+  double npoints_wg = (double) solver->npoints_local_wghosts,
+         ninterfaces = 0;
+  for (d = 0; d < ndims; d++) {
+    ninterfaces += (double) ((solver->npoints_local/solver->dim_local[d])*(solver->dim_local[d]+1));
+  }
+
+  for (n = 0; n < nschemes; n++) {
+    const BenchmarkInterpScheme *scheme = &schemes[n];
+    if (!BenchmarkSelected(settings,scheme->name)) continue;
+
+    strcpy(solver->spatial_scheme_hyp,scheme->scheme);
+    if (scheme->weno >= 0) {
+      solver->interp = weno;
+      weno->mapped = (scheme->weno == 1);
+      weno->borges = (scheme->weno == 2);
+      weno->yc     = (scheme->weno == 3);
+    } else if (scheme->muscl) {
+      solver->interp = muscl;
+    } else {
+      solver->interp = NULL;
+    }
+
+    /* two interpolations (left- and right-biased) per dimension, each reading the
+       cell-centered flux and writing the interface flux */
+    double words = 2.0*nvars*(ndims*npoints_wg + ninterfaces);
+    double flops = 2.0*nvars*ninterfaces*scheme->flops_interp;
+    if (scheme->weno >= 0) {
+      /* weights: read the flux and the solution, write 12 weights per interface and
+         variable; interpolations: read the 3 weights */
+      words += nvars*(2.0*ndims*npoints_wg + 12.0*ninterfaces) + 2.0*3.0*nvars*ninterfaces;
+      flops += nvars*ninterfaces*scheme->flops_weights;
+    }
+    if (scheme->compact) {
+      /* tridiagonal systems: write A, B, C, R; the solver reads all and writes B, C, R */
+      words += 2.0*11.0*nvars*ninterfaces;
+    }
+
+    BenchmarkInterpContext ctxt;
+    ctxt.problem = problem;
+    ctxt.scheme  = scheme;
+    IERR BenchmarkRun(settings,scheme->name,problem,8.0*words,flops,
+                      NULL,BenchmarkInterpKernel,&ctxt); CHECKERR(ierr);
+  }
+
+  /* clean up */
+  IERR WENOCleanup(weno,0); CHECKERR(ierr);
+  free(weno);
+  free(muscl);
+  IERR CompactSchemeCleanup(solver->compact); CHECKERR(ierr);
+  free(solver->compact);
+  free(solver->lusolver);
+  solver->interp   = NULL;
+  solver->compact  = NULL;
+  solver->lusolver = NULL;
+  strcpy(solver->spatial_scheme_hyp,_FIFTH_ORDER_WENO_);
+
+  return(0);
+}
@@ -0,0 +1,108 @@
+/*! @file BenchmarkMachine.c
+    @brief Measure the memory bandwidth and the floating point rate
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <arrayfunctions.h>
+#include <benchmark.h>
+#ifdef with_omp
+#include <omp.h>
+#endif
+
+/*! Size of the arrays for the STREAM triad (large enough to not fit in the caches) */
+#define _BENCH_TRIAD_SIZE_ (1<<23)
+/*! Number of iterations of the floating point rate loop */
+#define _BENCH_FLOP_ITER_ 20000000
+
+/*! Wall clock time in seconds */
+static double BenchmarkMachineWtime()
+{
+  struct timeval tv;
+  gettimeofday(&tv,NULL);
+  return((double)tv.tv_sec + 1e-6*(double)tv.tv_usec);
+}
+
+/*!
+  Measure the two limits of the roofline model used to assess the kernels (see BenchmarkReport()):
+  + the memory bandwidth (#BenchmarkSettings::bandwidth), with the STREAM triad
+    \f$a_i = b_i + s c_i\f$ (counting 24 bytes per element, as STREAM does);
+  + the floating point rate (#BenchmarkSettings::flop_rate), with eight independent chains of
+    multiply-adds per thread (the rate attainable by scalar code as generated by the compiler
+    for this build, not the vector peak of the processor).
+
+  The best of #BenchmarkSettings::ntrials trials is used. All ranks measure at the same time, so
+  that the limits are per rank on a fully loaded node (the lowest value over the ranks is used).
+*/
+int BenchmarkMachine(BenchmarkSettings *settings /*!< Benchmark settings */)
+{
+  long i, n = _BENCH_TRIAD_SIZE_;
+  int  k;
+
+  double *a = ArrayAllocate(n,"triad a");
+  double *b = ArrayAllocate(n,"triad b");
+  double *c = ArrayAllocate(n,"triad c");
+  for (i = 0; i < n; i++) { b[i] = 1.0; c[i] = 2.0; }
+
+  double t_triad = -1, t_flops = -1, checksum = 0;
+  int nthreads = 1;
+#ifdef with_omp
+  nthreads = omp_get_max_threads();
+#endif
+
+  for (k = 0; k < settings->ntrials; k++) {
+    double s = 0.5 + 0.1*k;
+#ifndef serial
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+    double t0 = BenchmarkMachineWtime();
+#pragma omp parallel for schedule(static) default(shared) private(i)
+    for (i = 0; i < n; i++) a[i] = b[i] + s*c[i];
+    double t1 = BenchmarkMachineWtime();
+    if ((t_triad < 0) || (t1-t0 < t_triad)) t_triad = t1-t0;
+    checksum += a[n/2];
+
+#ifndef serial
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+    t0 = BenchmarkMachineWtime();
+    double sum = 0;
+#pragma omp parallel default(shared) private(i) reduction(+:sum)
+    {
+      double x0 = 1.0, x1 = 1.1, x2 = 1.2, x3 = 1.3,
+             x4 = 1.4, x5 = 1.5, x6 = 1.6, x7 = 1.7;
+      double m = 0.999999, p = 1e-7*s;
+      for (i = 0; i < _BENCH_FLOP_ITER_; i++) {
+        x0 = x0*m + p; x1 = x1*m + p; x2 = x2*m + p; x3 = x3*m + p;
+        x4 = x4*m + p; x5 = x5*m + p; x6 = x6*m + p; x7 = x7*m + p;
+      }
+      sum += x0+x1+x2+x3+x4+x5+x6+x7;
+    }
+    t1 = BenchmarkMachineWtime();
+    if ((t_flops < 0) || (t1-t0 < t_flops)) t_flops = t1-t0;
+    checksum += sum;
+  }
+
+  ArrayFree(a);
+  ArrayFree(b);
+  ArrayFree(c);
+
+  double limits[2];
+  limits[0] = 24.0*((double)n) / t_triad;
+  limits[1] = 16.0*((double)_BENCH_FLOP_ITER_)*((double)nthreads) / t_flops;
+#ifndef serial
+  MPI_Allreduce(MPI_IN_PLACE,limits,2,MPI_DOUBLE,MPI_MIN,MPI_COMM_WORLD);
+#endif
+  settings->bandwidth = limits[0];
+  settings->flop_rate = limits[1];
+
+  if (!settings->rank) {
+    printf("Memory bandwidth (STREAM triad, per rank)  : %8.2f GB/s\n",settings->bandwidth*1e-9);
+    printf("Floating point rate (scalar FMA, per rank) : %8.2f GFlop/s\n",settings->flop_rate*1e-9);
+    if (checksum != checksum) printf("(checksum is NaN)\n");
+  }
+
+  return(0);
+}
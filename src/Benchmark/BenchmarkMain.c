@@ -0,0 +1,134 @@
+/*! @file BenchmarkMain.c
+    @brief Driver of the kernel micro-benchmarks
+    @author Debojyoti Ghosh
+
+  Build and run (from the top-level directory, after configuring HyPar):
+
+      make bench
+      mpiexec -n <nranks> src/Benchmark/HyParBench [options]
+
+  Options (all optional):
+  + -ndims <n>            : number of spatial dimensions of the scheme benchmarks (default: 3)
+  + -sizes <n1,n2,...>    : grid sizes along each dimension (default: 16,32,64)
+  + -nvars <n1,n2,...>    : numbers of variables per grid point (default: 1,5)
+  + -trials <n>           : number of timed trials per kernel (default: 9)
+  + -min_time <t>         : minimum wall time of each trial in seconds (default: 0.05)
+  + -filter <string>      : benchmark only the kernels whose name contains this string
+  + -o <filename>         : file to write the results to (default: bench.dat)
+
+  Each MPI rank benchmarks the kernels on its own copy of the problem, at the same time as the
+  other ranks, so that running one rank per core measures the performance of a fully loaded
+  node (the slowest rank is reported). The upwinding functions of the physical models are
+  benchmarked at the same total number of grid points as the schemes (size^ndims), on grids
+  of the dimension of each model.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <benchmark.h>
+
+/*! Parse a comma-separated list of integers */
+static int BenchmarkParseList(const char *str, int *list)
+{
+  char buffer[_MAX_STRING_SIZE_], *token;
+  int  n = 0;
+  strncpy(buffer,str,_MAX_STRING_SIZE_-1);
+  buffer[_MAX_STRING_SIZE_-1] = '\0';
+  token = strtok(buffer,",");
+  while (token && (n < _BENCH_MAX_LIST_)) {
+    list[n++] = atoi(token);
+    token = strtok(NULL,",");
+  }
+  return(n);
+}
+
+/*! Main driver of the micro-benchmarks */
+int main(int argc, char **argv)
+{
+  BenchmarkSettings settings;
+  int               i, n, v;
+  _DECLARE_IERR_;
+
+#ifndef serial
+  MPI_Init(&argc,&argv);
+  MPI_Comm_rank(MPI_COMM_WORLD,&settings.rank);
+  MPI_Comm_size(MPI_COMM_WORLD,&settings.nproc);
+#else
+  settings.rank  = 0;
+  settings.nproc = 1;
+#endif
+
+  /* default settings */
+  settings.ndims    = 3;
+  settings.nsizes   = 3;
+  settings.sizes[0] = 16; settings.sizes[1] = 32; settings.sizes[2] = 64;
+  settings.nnvars   = 2;
+  settings.nvars[0] = 1; settings.nvars[1] = 5;
+  settings.ntrials  = 9;
+  settings.min_time = 0.05;
+  strcpy(settings.filter,"");
+  strcpy(settings.output,"bench.dat");
+  settings.records  = NULL;
+  settings.nrecords = 0;
+
+  for (i = 1; i < argc; i++) {
+    if ((i < argc-1) && !strcmp(argv[i],"-ndims"))         settings.ndims    = atoi(argv[++i]);
+    else if ((i < argc-1) && !strcmp(argv[i],"-sizes"))    settings.nsizes   = BenchmarkParseList(argv[++i],settings.sizes);
+    else if ((i < argc-1) && !strcmp(argv[i],"-nvars"))    settings.nnvars   = BenchmarkParseList(argv[++i],settings.nvars);
+    else if ((i < argc-1) && !strcmp(argv[i],"-trials"))   settings.ntrials  = atoi(argv[++i]);
+    else if ((i < argc-1) && !strcmp(argv[i],"-min_time")) settings.min_time = atof(argv[++i]);
+    else if ((i < argc-1) && !strcmp(argv[i],"-filter"))   strncpy(settings.filter,argv[++i],_MAX_STRING_SIZE_-1);
+    else if ((i < argc-1) && !strcmp(argv[i],"-o"))        strncpy(settings.output,argv[++i],_MAX_STRING_SIZE_-1);
+    else {
+      if (!settings.rank) fprintf(stderr,"Error in HyParBench: unrecognized or incomplete option %s.\n",argv[i]);
+#ifndef serial
+      MPI_Finalize();
+#endif
+      return(1);
+    }
+  }
+  if ((settings.ndims < 1) || (settings.nsizes < 1) || (settings.nnvars < 1) || (settings.ntrials < 1)) {
+    if (!settings.rank) fprintf(stderr,"Error in HyParBench: invalid settings.\n");
+#ifndef serial
+    MPI_Finalize();
+#endif
+    return(1);
+  }
+
+  if (!settings.rank) {
+    printf("HyPar kernel micro-benchmarks: %d MPI rank(s), %d trial(s) of at least %e seconds per kernel.\n",
+           settings.nproc,settings.ntrials,settings.min_time);
+  }
+  IERR BenchmarkMachine(&settings); CHECKERR(ierr);
+  if (!settings.rank) BenchmarkPrintRecord(&settings,NULL,NULL);
+
+  /* schemes */
+  for (n = 0; n < settings.nsizes; n++) {
+    for (v = 0; v < settings.nnvars; v++) {
+      BenchmarkProblem problem;
+      IERR BenchmarkProblemCreate(&problem,settings.ndims,settings.sizes[n],settings.nvars[v]); CHECKERR(ierr);
+      IERR BenchmarkInterpolation(&settings,&problem); CHECKERR(ierr);
+      IERR BenchmarkDerivatives  (&settings,&problem); CHECKERR(ierr);
+      IERR BenchmarkTridiagLU    (&settings,&problem); CHECKERR(ierr);
+      IERR BenchmarkProblemDestroy(&problem); CHECKERR(ierr);
+    }
+  }
+
+  /* upwinding functions of the physical models */
+  for (n = 0; n < settings.nsizes; n++) {
+    int npoints_total = (int) pow((double)settings.sizes[n],(double)settings.ndims);
+    IERR BenchmarkUpwindEuler1D       (&settings,npoints_total); CHECKERR(ierr);
+    IERR BenchmarkUpwindNavierStokes2D(&settings,npoints_total); CHECKERR(ierr);
+    IERR BenchmarkUpwindNavierStokes3D(&settings,npoints_total); CHECKERR(ierr);
+  }
+
+  IERR BenchmarkReport(&settings); CHECKERR(ierr);
+  free(settings.records);
+
+#ifndef serial
+  MPI_Finalize();
+#endif
+  return(0);
+}
@@ -0,0 +1,251 @@
+/*! @file BenchmarkProblem.c
+    @brief Set up the synthetic problems for the micro-benchmarks
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <arrayfunctions.h>
+#include <interpolation.h>
+#include <benchmark.h>
+
+/*!
+  Set up a synthetic problem: a uniform Cartesian grid on the unit hypercube, with \a size
+  points along each of the \a ndims dimensions and #_BENCH_GHOSTS_ ghost points, and
+  \a nvars variables per grid point. The solution and the flux are smooth with a
+  discontinuity at the middle of the domain along the first dimension (so that the nonlinear
+  weights and limiters take their realistic code paths); the interface arrays are
+  initialized with the cell-centered values.
+
+  The #MPIVariables object describes a one-rank domain: the line sub-communicators are
+  duplicates of MPI_COMM_SELF, so that each rank benchmarks the kernels independently, while
+  the world communicator is MPI_COMM_WORLD so that the initialization functions (that read
+  optional input files on rank 0 and broadcast) behave as in a simulation.
+*/
+int BenchmarkProblemCreate(
+                            BenchmarkProblem  *problem, /*!< Problem object */
+                            int               ndims,    /*!< Number of spatial dimensions */
+                            int               size,     /*!< Grid size along each dimension */
+                            int               nvars     /*!< Number of variables per grid point */
+                          )
+{
+  HyPar         *solver = &(problem->solver);
+  MPIVariables  *mpi    = &(problem->mpi);
+  int           ghosts  = _BENCH_GHOSTS_, d, v;
+
+  memset(problem,0,sizeof(BenchmarkProblem));
+  problem->size = size;
+
+  solver->ndims  = ndims;
+  solver->nvars  = nvars;
+  solver->ghosts = ghosts;
+  strcpy(solver->interp_type,_COMPONENTS_);
+  strcpy(solver->spatial_scheme_hyp,_FIFTH_ORDER_WENO_);
+
+  solver->dim_global            = (int*) calloc (ndims,sizeof(int));
+  solver->dim_local             = (int*) calloc (ndims,sizeof(int));
+  solver->stride_with_ghosts    = (int*) calloc (ndims,sizeof(int));
+  solver->stride_without_ghosts = (int*) calloc (ndims,sizeof(int));
+  solver->npoints_global = solver->npoints_local = solver->npoints_local_wghosts = 1;
+  int accu1 = 1, accu2 = 1;
+  for (d = 0; d < ndims; d++) {
+    solver->dim_global[d] = solver->dim_local[d] = size;
+    solver->npoints_global        *= size;
+    solver->npoints_local         *= size;
+    solver->npoints_local_wghosts *= (size+2*ghosts);
+    solver->stride_with_ghosts[d]    = accu1;
+    solver->stride_without_ghosts[d] = accu2;
+    accu1 *= (size+2*ghosts);
+    accu2 *= size;
+  }
+
+  mpi->iproc      = (int*) calloc (ndims,sizeof(int));
+  mpi->ip         = (int*) calloc (ndims,sizeof(int));
+  mpi->is         = (int*) calloc (ndims,sizeof(int));
+  mpi->ie         = (int*) calloc (ndims,sizeof(int));
+  mpi->bcperiodic = (int*) calloc (ndims,sizeof(int));
+  for (d = 0; d < ndims; d++) {
+    mpi->iproc[d] = 1;
+    mpi->ip[d]    = 0;
+    mpi->is[d]    = 0;
+    mpi->ie[d]    = size;
+  }
+  mpi->nproc = 1;
+#ifndef serial
+  mpi->world = MPI_COMM_WORLD;
+  MPI_Comm_rank(mpi->world,&mpi->rank);
+  mpi->comm = (MPI_Comm*) calloc (ndims,sizeof(MPI_Comm));
+  for (d = 0; d < ndims; d++) MPI_Comm_dup(MPI_COMM_SELF,&mpi->comm[d]);
+#else
+  mpi->rank = 0;
+  mpi->comm = NULL;
+#endif
+
+  /* grid */
+  int size_x = 0;
+  for (d = 0; d < ndims; d++) size_x += (size+2*ghosts);
+  problem->x = (double*) calloc (size_x,sizeof(double));
+  solver->dxinv = (double*) calloc (size_x,sizeof(double));
+  int offset = 0;
+  for (d = 0; d < ndims; d++) {
+    int i;
+    for (i = 0; i < size+2*ghosts; i++) {
+      problem->x[offset+i] = ((double)(i-ghosts)+0.5) / ((double)size);
+      solver->dxinv[offset+i] = (double) size;
+    }
+    offset += (size+2*ghosts);
+  }
+  solver->x = problem->x;
+
+  /* cell-centered arrays */
+  int npoints_wg = solver->npoints_local_wghosts;
+  problem->u  = ArrayAllocateGrid(npoints_wg*nvars,ndims,solver->dim_local,ghosts,nvars,0,"bench u");
+  problem->f  = ArrayAllocateGrid(npoints_wg*nvars,ndims,solver->dim_local,ghosts,nvars,0,"bench f");
+  problem->Df = ArrayAllocateGrid(npoints_wg*nvars,ndims,solver->dim_local,ghosts,nvars,0,"bench Df");
+
+  double pi = 4.0*atan(1.0);
+  int bounds[ndims], index[ndims], done = 0;
+  for (d = 0; d < ndims; d++) bounds[d] = size+2*ghosts;
+  _ArraySetValue_(index,ndims,0);
+  while (!done) {
+    int p; _ArrayIndex1D_(ndims,bounds,index,0,p);
+    double xsum = 0;
+    offset = 0;
+    for (d = 0; d < ndims; d++) {
+      xsum += problem->x[offset+index[d]];
+      offset += (size+2*ghosts);
+    }
+    double jump = (problem->x[index[0]] > 0.5 ? 0.5 : 0.0);
+    for (v = 0; v < nvars; v++) {
+      problem->u[p*nvars+v] = 1.0 + 0.2*sin(2.0*pi*xsum + v) + jump;
+      problem->f[p*nvars+v] = 1.0 + 0.3*cos(2.0*pi*xsum + v) + jump;
+    }
+    _ArrayIncrementIndex_(ndims,bounds,index,done);
+  }
+  _ArraySetValue_(problem->Df,npoints_wg*nvars,0.0);
+
+  /* interface arrays */
+  problem->ninterfaces_max = 0;
+  for (d = 0; d < ndims; d++) {
+    int ninterfaces = (solver->npoints_local/size)*(size+1);
+    if (ninterfaces > problem->ninterfaces_max) problem->ninterfaces_max = ninterfaces;
+  }
+  int size_interfaces = problem->ninterfaces_max*nvars;
+  problem->fI = ArrayAllocate(size_interfaces,"bench fI");
+  problem->fL = ArrayAllocate(size_interfaces,"bench fL");
+  problem->fR = ArrayAllocate(size_interfaces,"bench fR");
+  problem->uL = ArrayAllocate(size_interfaces,"bench uL");
+  problem->uR = ArrayAllocate(size_interfaces,"bench uR");
+  int i;
+  for (i = 0; i < size_interfaces; i++) {
+    problem->fI[i] = 0.0;
+    problem->fL[i] = problem->fR[i] = problem->f[i%(npoints_wg*nvars)];
+    problem->uL[i] = problem->uR[i] = problem->u[i%(npoints_wg*nvars)];
+  }
+
+  return(0);
+}
+
+/*! Free the arrays and communicators of a synthetic problem (the interpolation, compact
+    scheme, and physics objects are freed by the benchmark suites that create them). */
+int BenchmarkProblemDestroy(BenchmarkProblem *problem /*!< Problem object */)
+{
+  HyPar         *solver = &(problem->solver);
+  MPIVariables  *mpi    = &(problem->mpi);
+
+#ifndef serial
+  int d;
+  for (d = 0; d < solver->ndims; d++) MPI_Comm_free(&mpi->comm[d]);
+  free(mpi->comm);
+#endif
+  free(mpi->iproc);
+  free(mpi->ip);
+  free(mpi->is);
+  free(mpi->ie);
+  free(mpi->bcperiodic);
+
+  free(solver->dim_global);
+  free(solver->dim_local);
+  free(solver->stride_with_ghosts);
+  free(solver->stride_without_ghosts);
+  free(solver->dxinv);
+  free(problem->x);
+
+  ArrayFree(problem->u);
+  ArrayFree(problem->f);
+  ArrayFree(problem->Df);
+  ArrayFree(problem->fI);
+  ArrayFree(problem->fL);
+  ArrayFree(problem->fR);
+  ArrayFree(problem->uL);
+  ArrayFree(problem->uR);
+
+  return(0);
+}
+
+/*!
+  Set the solution of a synthetic problem to a compressible flow state in conservative
+  variables \f$\left(\rho, \rho{\bf u}, e\right)\f$ (i.e., #HyPar::nvars must be #HyPar::ndims + 2, as
+  for the Euler and Navier-Stokes models), with a smooth density and pressure, a uniform velocity,
+  and a jump in density and pressure at the middle of the domain along the first dimension. The
+  flux and the interface arrays are set to copies of the solution.
+*/
+int BenchmarkProblemSetEulerState(
+                                    BenchmarkProblem  *problem, /*!< Problem object */
+                                    double            gamma     /*!< Ratio of specific heats */
+                                 )
+{
+  HyPar *solver = &(problem->solver);
+  int   ndims   = solver->ndims,
+        nvars   = solver->nvars,
+        ghosts  = solver->ghosts,
+        size    = problem->size, d;
+
+  if (nvars != ndims+2) {
+    fprintf(stderr,"Error in BenchmarkProblemSetEulerState(): nvars (%d) must be ndims+2 (%d).\n",
+            nvars, ndims+2);
+    return(1);
+  }
+
+  double pi = 4.0*atan(1.0);
+  int npoints_wg = solver->npoints_local_wghosts;
+  int bounds[ndims], index[ndims], done = 0;
+  for (d = 0; d < ndims; d++) bounds[d] = size+2*ghosts;
+  _ArraySetValue_(index,ndims,0);
+  while (!done) {
+    int p; _ArrayIndex1D_(ndims,bounds,index,0,p);
+    double xsum = 0;
+    int offset = 0;
+    for (d = 0; d < ndims; d++) {
+      xsum += problem->x[offset+index[d]];
+      offset += (size+2*ghosts);
+    }
+    double factor = (problem->x[index[0]] > 0.5 ? 0.5 : 1.0);
+    double rho = factor * (1.0 + 0.2*sin(2.0*pi*xsum));
+    double pressure = factor * (1.0 + 0.1*cos(2.0*pi*xsum));
+    double ke = 0.0;
+    double *u = problem->u + p*nvars;
+    u[0] = rho;
+    for (d = 0; d < ndims; d++) {
+      double vel = 0.2 + 0.1*d;
+      u[1+d] = rho*vel;
+      ke += 0.5*rho*vel*vel;
+    }
+    u[ndims+1] = pressure/(gamma-1.0) + ke;
+    _ArrayIncrementIndex_(ndims,bounds,index,done);
+  }
+  _ArrayCopy1D_(problem->u,problem->f,npoints_wg*nvars);
+
+  int i;
+  for (i = 0; i < problem->ninterfaces_max; i++) {
+    int p = i % npoints_wg;
+    _ArrayCopy1D_((problem->u+p*nvars),(problem->uL+i*nvars),nvars);
+    _ArrayCopy1D_((problem->u+p*nvars),(problem->uR+i*nvars),nvars);
+    _ArrayCopy1D_((problem->u+p*nvars),(problem->fL+i*nvars),nvars);
+    _ArrayCopy1D_((problem->u+p*nvars),(problem->fR+i*nvars),nvars);
+  }
+
+  return(0);
+}
@@ -0,0 +1,81 @@
+/*! @file BenchmarkReport.c
+    @brief Print and write the results of the micro-benchmarks
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <benchmark.h>
+
+/*!
+  Print one measurement (one line):
+  + Kernel name, number of dimensions, grid size along each dimension, number of variables
+  + Median time per call (seconds) and the interquartile range of the trials (% of the median)
+  + Throughput in million grid points per second
+  + Effective memory bandwidth (GB/s) and floating point rate (GFlop/s), from the estimated
+    bytes and operations of the kernel (these are model estimates of the compulsory traffic
+    and of the arithmetic of the algorithm, not hardware counter measurements)
+  + Arithmetic intensity (flops/byte)
+  + Fraction of the roofline: the time predicted by the roofline model,
+    \f$\max\left(F/P,B/W\right)\f$, where \f$F\f$ and \f$B\f$ are the estimated flops and bytes,
+    and \f$P\f$ and \f$W\f$ are the measured floating point rate and bandwidth (see BenchmarkMachine()),
+    divided by the measured time (this can exceed 100% for the small problem sizes whose
+    arrays fit in the caches, since the bandwidth is that of the main memory).
+
+  If \a out is NULL, the header is printed to stdout instead.
+*/
+int BenchmarkPrintRecord(
+                          BenchmarkSettings *settings,  /*!< Benchmark settings */
+                          BenchmarkRecord   *r,         /*!< Measurement to print (ignored if \a out is NULL) */
+                          FILE              *out        /*!< File to print to */
+                        )
+{
+  if (!out) {
+    printf("%-30s %5s %5s %5s %12s %7s %10s %8s %8s %8s %7s\n",
+           "Kernel", "ndims", "size", "nvars", "Time/call", "IQR(%)",
+           "Mpoints/s", "GB/s", "GFlop/s", "Flop/B", "Roof(%)");
+    return(0);
+  }
+
+  double t = r->time_med;
+  double t_roof = r->flops/settings->flop_rate;
+  if (r->bytes/settings->bandwidth > t_roof) t_roof = r->bytes/settings->bandwidth;
+
+  fprintf(out,"%-30s %5d %5d %5d %12.4e %7.2f %10.3f %8.3f %8.3f %8.3f %7.1f\n",
+          r->kernel, r->ndims, r->size, r->nvars, t, 100.0*r->spread,
+          1e-6*r->npoints/t, 1e-9*r->bytes/t, 1e-9*r->flops/t,
+          r->flops/r->bytes, 100.0*t_roof/t );
+  return(0);
+}
+
+/*!
+  Write all the measurements to the file #BenchmarkSettings::output (on rank 0), in the format
+  printed by BenchmarkPrintRecord(), preceded by comment lines (starting with '#') that contain
+  the measured machine limits and the column headers. The files written by different versions
+  of the code on the same machine can be compared line by line to track the performance of
+  each kernel.
+*/
+int BenchmarkReport(BenchmarkSettings *settings /*!< Benchmark settings */)
+{
+  int n;
+  if (settings->rank) return(0);
+
+  FILE *out = fopen(settings->output,"w");
+  if (!out) {
+    fprintf(stderr,"Error in BenchmarkReport(): unable to open %s for writing.\n",settings->output);
+    return(1);
+  }
+  fprintf(out,"# HyPar kernel micro-benchmarks: %d MPI rank(s), %d trial(s) of at least %e seconds\n",
+          settings->nproc, settings->ntrials, settings->min_time);
+  fprintf(out,"# bandwidth(GB/s) %f flop_rate(GFlop/s) %f\n",
+          settings->bandwidth*1e-9, settings->flop_rate*1e-9);
+  fprintf(out,"# %-28s %5s %5s %5s %12s %7s %10s %8s %8s %8s %7s\n",
+          "kernel", "ndims", "size", "nvars", "time/call", "iqr(%)",
+          "mpoints/s", "GB/s", "GFlop/s", "flop/B", "roof(%)");
+  for (n = 0; n < settings->nrecords; n++) {
+    BenchmarkPrintRecord(settings,&(settings->records[n]),out);
+  }
+  fclose(out);
+
+  printf("Wrote %d measurements to %s.\n",settings->nrecords,settings->output);
+  return(0);
+}
@@ -0,0 +1,133 @@
+/*! @file BenchmarkRun.c
+    @brief Time a kernel
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <benchmark.h>
+
+/*! Wall clock time in seconds */
+static double BenchmarkWtime()
+{
+  struct timeval tv;
+  gettimeofday(&tv,NULL);
+  return((double)tv.tv_sec + 1e-6*(double)tv.tv_usec);
+}
+
+/*! Comparison function for qsort() */
+static int BenchmarkCompare(const void *a, const void *b)
+{
+  double da = *((const double*)a), db = *((const double*)b);
+  return((da > db) - (da < db));
+}
+
+/*! Returns 1 if the kernel is selected by the filter (#BenchmarkSettings::filter), 0 otherwise */
+int BenchmarkSelected(
+                        BenchmarkSettings *settings,  /*!< Benchmark settings */
+                        const char        *kernel     /*!< Name of the kernel */
+                     )
+{
+  if (!strlen(settings->filter)) return(1);
+  return(strstr(kernel,settings->filter) != NULL);
+}
+
+/*!
+  Time a kernel and add its measurements to #BenchmarkSettings::records:
+  + A warm-up run calibrates the number of calls of each trial so that a trial takes at
+    least #BenchmarkSettings::min_time seconds.
+  + Each of the #BenchmarkSettings::ntrials trials times each call individually, excluding
+    the set-up function (if any) that is called before each call (for example, to restore
+    arrays that the kernel overwrites).
+  + The median and the minimum over the trials of the time per call, and the interquartile
+    range relative to the median (a measure of the noise), are recorded. The median is
+    insensitive to the occasional slow trial, and is the quantity to track across versions.
+
+  When run on several MPI ranks, each rank runs the kernel on its own copy of the problem at
+  the same time (so that the measurement includes the contention for the memory bandwidth of
+  a fully loaded node), the trials are synchronized, and the times of the slowest rank are
+  recorded.
+*/
+int BenchmarkRun(
+                  BenchmarkSettings *settings,  /*!< Benchmark settings */
+                  const char        *name,      /*!< Name of the kernel */
+                  BenchmarkProblem  *problem,   /*!< Problem object */
+                  double            bytes,      /*!< Estimated bytes moved per call */
+                  double            flops,      /*!< Estimated floating point operations per call */
+                  BenchmarkFunction setup,      /*!< Set-up function called (untimed) before each call (may be NULL) */
+                  BenchmarkFunction kernel,     /*!< Kernel */
+                  void              *ctxt       /*!< Context passed to the set-up function and the kernel */
+                )
+{
+  int ierr = 0, k, c;
+  if (!BenchmarkSelected(settings,name)) return(0);
+
+  /* warm up and calibrate */
+  double t_warmup = 0;
+  int ncalls = 0;
+  while ((t_warmup < 0.2*settings->min_time) || (ncalls < 2)) {
+    if (setup) { ierr = setup(ctxt); if (ierr) break; }
+    double t0 = BenchmarkWtime();
+    ierr = kernel(ctxt); if (ierr) break;
+    t_warmup += (BenchmarkWtime() - t0);
+    ncalls++;
+  }
+  if (ierr) {
+    fprintf(stderr,"Error in BenchmarkRun(): kernel %s returned %d on rank %d.\n",
+            name, ierr, settings->rank);
+    return(ierr);
+  }
+  int calls_per_trial = (int) (settings->min_time / (t_warmup/ncalls)) + 1;
+#ifndef serial
+  MPI_Allreduce(MPI_IN_PLACE,&calls_per_trial,1,MPI_INT,MPI_MAX,MPI_COMM_WORLD);
+#endif
+
+  /* timed trials */
+  double *trials = (double*) calloc (settings->ntrials,sizeof(double));
+  for (k = 0; k < settings->ntrials; k++) {
+#ifndef serial
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+    double t_trial = 0;
+    for (c = 0; c < calls_per_trial; c++) {
+      if (setup) setup(ctxt);
+      double t0 = BenchmarkWtime();
+      kernel(ctxt);
+      t_trial += (BenchmarkWtime() - t0);
+    }
+    trials[k] = t_trial / calls_per_trial;
+  }
+  qsort(trials,settings->ntrials,sizeof(double),BenchmarkCompare);
+
+  int n = settings->ntrials;
+  double stats[3];
+  stats[0] = (n%2 ? trials[n/2] : 0.5*(trials[n/2-1]+trials[n/2]));
+  stats[1] = trials[0];
+  stats[2] = (trials[(3*(n-1))/4] - trials[(n-1)/4]) / stats[0];
+  free(trials);
+#ifndef serial
+  MPI_Allreduce(MPI_IN_PLACE,stats,3,MPI_DOUBLE,MPI_MAX,MPI_COMM_WORLD);
+#endif
+
+  settings->records = (BenchmarkRecord*) realloc (settings->records,
+                                                  (settings->nrecords+1)*sizeof(BenchmarkRecord));
+  BenchmarkRecord *record = &(settings->records[settings->nrecords]);
+  strncpy(record->kernel,name,_BENCH_NAME_LEN_-1);
+  record->kernel[_BENCH_NAME_LEN_-1] = '\0';
+  record->ndims    = problem->solver.ndims;
+  record->size     = problem->size;
+  record->nvars    = problem->solver.nvars;
+  record->time_med = stats[0];
+  record->time_min = stats[1];
+  record->spread   = stats[2];
+  record->npoints  = (double) problem->solver.npoints_local;
+  record->bytes    = bytes;
+  record->flops    = flops;
+  settings->nrecords++;
+
+  if (!settings->rank) BenchmarkPrintRecord(settings,record,stdout);
+
+  return(0);
+}
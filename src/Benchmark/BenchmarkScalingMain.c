@@ -0,0 +1,82 @@
+/*! @file BenchmarkScalingMain.c
+    @brief Input generator of the scaling harness
+    @author Debojyoti Ghosh
+
+  HyParScalingSetup writes, in the current directory, the input files (solver.inp,
+  boundary.inp, physics.inp, initial.inp) of a simulation of one of the canned problems
+  (see BenchmarkScalingProblems.c) on a given number of MPI ranks, and prints the chosen
+  processor grid and global grid size:
+
+      HyParScalingSetup -problem <name> -nranks <n> (-local <size> | -global <size>) [options]
+
+  + -problem <name>      : vortex2d (Euler2D isentropic vortex), densitysine3d (NavierStokes3D
+                           density sine wave), bubble3d (NavierStokes3D rising thermal bubble),
+                           or twostream (Vlasov two-stream instability; needs HyPar compiled with FFTW)
+  + -nranks <n>          : number of MPI ranks
+  + -local <size>        : weak scaling: local grid size along each dimension
+  + -global <size>       : strong scaling: global grid size along each dimension
+  + -n_iter <n>          : number of time steps (default: 100)
+  + -file_op_iter <n>    : solution output frequency, 0 for no output (default: n_iter/2)
+  + -output_mode <mode>  : #HyPar::output_mode (default: serial)
+  + -cfl <c>             : CFL number for the time step (default: 0.4)
+
+  The driver script src/Benchmark/scaling.sh runs the weak or strong scaling studies of a
+  problem with this program and HyPar, and collects the results.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <benchmark.h>
+
+/*! Main driver of the input generator of the scaling harness */
+int main(int argc, char **argv)
+{
+  BenchmarkScalingRun run;
+  int                 i, d, size = -1, weak = -1;
+
+  strcpy(run.name,"");
+  strcpy(run.output_mode,"serial");
+  run.nranks        = 1;
+  run.n_iter        = 100;
+  run.file_op_iter  = -1;
+  run.cfl           = 0.4;
+
+  for (i = 1; i < argc; i++) {
+    if ((i < argc-1) && !strcmp(argv[i],"-problem"))           strncpy(run.name,argv[++i],_BENCH_NAME_LEN_-1);
+    else if ((i < argc-1) && !strcmp(argv[i],"-nranks"))       run.nranks = atoi(argv[++i]);
+    else if ((i < argc-1) && !strcmp(argv[i],"-local"))        { size = atoi(argv[++i]); weak = 1; }
+    else if ((i < argc-1) && !strcmp(argv[i],"-global"))       { size = atoi(argv[++i]); weak = 0; }
+    else if ((i < argc-1) && !strcmp(argv[i],"-n_iter"))       run.n_iter = atoi(argv[++i]);
+    else if ((i < argc-1) && !strcmp(argv[i],"-file_op_iter")) run.file_op_iter = atoi(argv[++i]);
+    else if ((i < argc-1) && !strcmp(argv[i],"-output_mode"))  strncpy(run.output_mode,argv[++i],_MAX_STRING_SIZE_-1);
+    else if ((i < argc-1) && !strcmp(argv[i],"-cfl"))          run.cfl = atof(argv[++i]);
+    else {
+      fprintf(stderr,"Error in HyParScalingSetup: unrecognized or incomplete option %s.\n",argv[i]);
+      return(1);
+    }
+  }
+  if (weak < 0) {
+    fprintf(stderr,"Error in HyParScalingSetup: one of -local (weak scaling) or -global (strong scaling) must be specified.\n");
+    return(1);
+  }
+  if (run.n_iter < 1) {
+    fprintf(stderr,"Error in HyParScalingSetup: n_iter must be positive.\n");
+    return(1);
+  }
+  if (run.file_op_iter < 0) run.file_op_iter = (run.n_iter > 1 ? run.n_iter/2 : 1);
+
+  run.ndims = BenchmarkScalingProblemNdims(run.name);
+  if (run.ndims < 0) return(1);
+  if (BenchmarkScalingProcessorGrid(&run,size,weak)) return(1);
+  if (BenchmarkScalingWriteInputs(&run)) return(1);
+
+  /* summary, parsed by scaling.sh */
+  printf("problem %s nranks %d size",run.name,run.nranks);
+  for (d = 0; d < run.ndims; d++) printf(" %d",run.dim_global[d]);
+  printf(" iproc");
+  for (d = 0; d < run.ndims; d++) printf(" %d",run.iproc[d]);
+  printf("\n");
+
+  return(0);
+}
@@ -0,0 +1,262 @@
+/*! @file BenchmarkScalingProblems.c
+    @brief Canned problems of the scaling harness
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <benchmark.h>
+
+/*! \brief A canned problem of the scaling harness */
+typedef struct benchmark_scaling_problem {
+  const char  *name;                      /*!< Name of the problem */
+  const char  *model;                     /*!< Physical model (#HyPar::model) */
+  int         ndims;                      /*!< Number of spatial dimensions */
+  int         nvars;                      /*!< Number of variables per grid point */
+  double      xmin[_BENCH_MAX_DIMS_];     /*!< Lower bounds of the domain */
+  double      xmax[_BENCH_MAX_DIMS_];     /*!< Upper bounds of the domain */
+  double      speed[_BENCH_MAX_DIMS_];    /*!< Maximum characteristic speed along each dimension (for the time step) */
+  const char  *bctype;                    /*!< Boundary condition on all the boundaries */
+  const char  *interp_type;               /*!< #HyPar::interp_type */
+  const char  *par_space_type;            /*!< #HyPar::spatial_type_par (NULL if there is no parabolic term) */
+  const char  *physics;                   /*!< Contents of physics.inp (between "begin" and "end") */
+  void        (*solution)(double*,double*); /*!< Initial solution at a point */
+} BenchmarkScalingProblem;
+
+/*! Isentropic vortex convecting in a uniform flow (2D Euler equations) */
+static void BenchmarkScalingVortex(double *x, double *u)
+{
+  double gamma = 1.4, b = 5.0, pi = 4.0*atan(1.0);
+  double dx = x[0]-5.0, dy = x[1]-5.0, r2 = dx*dx + dy*dy;
+  double du = -b/(2.0*pi) * exp(0.5*(1.0-r2)) * dy;
+  double dv =  b/(2.0*pi) * exp(0.5*(1.0-r2)) * dx;
+  double T  = 1.0 - (gamma-1.0)*b*b/(8.0*gamma*pi*pi) * exp(1.0-r2);
+  double rho = pow(T,1.0/(gamma-1.0)), p = pow(rho,gamma);
+  double vx = 0.5 + du, vy = dv;
+  u[0] = rho;
+  u[1] = rho*vx;
+  u[2] = rho*vy;
+  u[3] = p/(gamma-1.0) + 0.5*rho*(vx*vx+vy*vy);
+}
+
+/*! Density sine wave convecting diagonally in a uniform flow (3D Navier-Stokes equations) */
+static void BenchmarkScalingDensitySine(double *x, double *u)
+{
+  double gamma = 1.4, pi = 4.0*atan(1.0);
+  double rho = 1.0 + 0.1*sin(2.0*pi*(x[0]+x[1]+x[2])), p = 1.0/gamma;
+  u[0] = rho;
+  u[1] = u[2] = u[3] = rho;
+  u[4] = p/(gamma-1.0) + 0.5*rho*3.0;
+}
+
+/*! Warm bubble rising in a hydrostatically balanced atmosphere (3D Navier-Stokes equations with
+    gravity, see the physics inputs of this problem) */
+static void BenchmarkScalingBubble(double *x, double *u)
+{
+  double gamma = 1.4, R = 287.058, T_ref = 300.0, p_ref = 100000.0, grav = 9.8,
+         pi = 4.0*atan(1.0), rc = 250.0, tc = 0.5;
+  double cp = gamma*R/(gamma-1.0);
+  double dx = x[0]-500.0, dy = x[1]-350.0, dz = x[2]-500.0;
+  double r = sqrt(dx*dx + dy*dy + dz*dz);
+  double theta = T_ref + (r > rc ? 0.0 : 0.5*tc*(1.0+cos(pi*r/rc)));
+  double exner = 1.0 - grav*x[1]/(cp*T_ref);
+  double rho = (p_ref/(R*theta)) * pow(exner,1.0/(gamma-1.0));
+  u[0] = rho;
+  u[1] = u[2] = u[3] = 0.0;
+  u[4] = rho*R*theta*exner/(gamma-1.0);
+}
+
+/*! Two-stream instability (1D-1V Vlasov equation with a self-consistent electric field) */
+static void BenchmarkScalingTwoStream(double *x, double *u)
+{
+  double pi = 4.0*atan(1.0), v = x[1];
+  u[0] = (1.0/sqrt(2.0*pi)) * v*v * exp(-0.5*v*v) * (1.0 + 0.05*cos(0.5*x[0]));
+}
+
+/*! The canned problems */
+static const BenchmarkScalingProblem problems[] = {
+  { "vortex2d", "euler2d", 2, 4,
+    { 0.0, 0.0, 0.0 }, { 10.0, 10.0, 0.0 }, { 2.5, 2.5, 0.0 },
+    "periodic", "characteristic", NULL,
+    "  gamma     1.4\n  upwinding roe\n",
+    BenchmarkScalingVortex },
+  { "densitysine3d", "navierstokes3d", 3, 5,
+    { 0.0, 0.0, 0.0 }, { 1.0, 1.0, 1.0 }, { 2.0, 2.0, 2.0 },
+    "periodic", "characteristic", "nonconservative-2stage",
+    "  gamma     1.4\n  upwinding roe\n  Pr        0.72\n  Re        100.0\n  Minf      1.0\n",
+    BenchmarkScalingDensitySine },
+  { "bubble3d", "navierstokes3d", 3, 5,
+    { 0.0, 0.0, 0.0 }, { 1000.0, 1000.0, 1000.0 }, { 350.0, 350.0, 350.0 },
+    "slip-wall", "characteristic", NULL,
+    "  gamma     1.4\n  upwinding rusanov\n  gravity   0.0 9.8 0.0\n"
+    "  rho_ref   1.1612055171196529\n  p_ref     100000.0\n  R         287.058\n  HB        2\n",
+    BenchmarkScalingBubble },
+  { "twostream", "vlasov", 2, 1,
+    { 0.0, -6.0, 0.0 }, { 4.0*3.14159265358979323846, 6.0, 0.0 }, { 6.0, 1.0, 0.0 },
+    "periodic", "components", NULL,
+    "  self_consistent_electric_field 1\n  x_ndims 1\n  v_ndims 1\n",
+    BenchmarkScalingTwoStream }
+};
+
+/*! Find a canned problem by name */
+static const BenchmarkScalingProblem* BenchmarkScalingFind(const char *name)
+{
+  int n, nproblems = sizeof(problems)/sizeof(BenchmarkScalingProblem);
+  for (n = 0; n < nproblems; n++) if (!strcmp(problems[n].name,name)) return(&problems[n]);
+  return(NULL);
+}
+
+/*! Number of spatial dimensions of a canned problem (-1 if there is no such problem; the
+    available problems are then printed) */
+int BenchmarkScalingProblemNdims(const char *name /*!< Name of the problem */)
+{
+  const BenchmarkScalingProblem *problem = BenchmarkScalingFind(name);
+  if (!problem) {
+    int n, nproblems = sizeof(problems)/sizeof(BenchmarkScalingProblem);
+    fprintf(stderr,"Error: no canned problem named \"%s\". Available problems:\n",name);
+    for (n = 0; n < nproblems; n++) {
+      fprintf(stderr,"  %-16s (%s, %dD)\n",problems[n].name,problems[n].model,problems[n].ndims);
+    }
+    return(-1);
+  }
+  return(problem->ndims);
+}
+
+/*!
+  Write the input files of a simulation of a canned problem in the current directory:
+  + solver.inp: fifth order WENO with the fourth order Runge-Kutta method, binary input
+    and output, with the profiler enabled (see MPIProfilerReport()), and the time step
+    given by the CFL number #BenchmarkScalingRun::cfl and the maximum characteristic speeds
+    of the problem;
+  + boundary.inp and physics.inp;
+  + initial.inp: the initial solution on the global grid (binary format for the serial
+    input mode, see ReadArraySerial()).
+*/
+int BenchmarkScalingWriteInputs(BenchmarkScalingRun *run /*!< Simulation */)
+{
+  const BenchmarkScalingProblem *problem = BenchmarkScalingFind(run->name);
+  int   ndims, nvars, d, i;
+  FILE  *out;
+
+  if (!problem) return(1);
+  ndims = problem->ndims;
+  nvars = problem->nvars;
+
+  double dx[_BENCH_MAX_DIMS_], rate = 0;
+  for (d = 0; d < ndims; d++) {
+    dx[d] = (problem->xmax[d]-problem->xmin[d]) / ((double) run->dim_global[d]);
+    rate += problem->speed[d]/dx[d];
+  }
+  double dt = run->cfl / rate;
+
+  /* solver.inp */
+  out = fopen("solver.inp","w");
+  if (!out) {
+    fprintf(stderr,"Error in BenchmarkScalingWriteInputs(): unable to open solver.inp for writing.\n");
+    return(1);
+  }
+  fprintf(out,"begin\n");
+  fprintf(out,"  ndims              %d\n",ndims);
+  fprintf(out,"  nvars              %d\n",nvars);
+  fprintf(out,"  size              ");
+  for (d = 0; d < ndims; d++) fprintf(out," %d",run->dim_global[d]);
+  fprintf(out,"\n  iproc             ");
+  for (d = 0; d < ndims; d++) fprintf(out," %d",run->iproc[d]);
+  fprintf(out,"\n");
+  fprintf(out,"  ghost              %d\n",_BENCH_GHOSTS_);
+  fprintf(out,"  n_iter             %d\n",run->n_iter);
+  fprintf(out,"  time_scheme        rk\n");
+  fprintf(out,"  time_scheme_type   44\n");
+  fprintf(out,"  hyp_space_scheme   weno5\n");
+  fprintf(out,"  hyp_interp_type    %s\n",problem->interp_type);
+  if (problem->par_space_type) {
+    fprintf(out,"  par_space_type     %s\n",problem->par_space_type);
+    fprintf(out,"  par_space_scheme   4\n");
+  }
+  fprintf(out,"  dt                 %1.16e\n",dt);
+  fprintf(out,"  screen_op_iter     %d\n",(run->n_iter > 10 ? run->n_iter/10 : 1));
+  if (run->file_op_iter > 0) {
+    fprintf(out,"  file_op_iter       %d\n",run->file_op_iter);
+    fprintf(out,"  op_file_format     binary\n");
+    fprintf(out,"  op_overwrite       yes\n");
+    fprintf(out,"  output_mode        %s\n",run->output_mode);
+  } else {
+    fprintf(out,"  file_op_iter       %d\n",run->n_iter+1);
+    fprintf(out,"  op_file_format     none\n");
+  }
+  fprintf(out,"  ip_file_type       binary\n");
+  fprintf(out,"  input_mode         serial\n");
+  fprintf(out,"  profile            yes\n");
+  fprintf(out,"  model              %s\n",problem->model);
+  fprintf(out,"end\n");
+  fclose(out);
+
+  /* boundary.inp: one boundary on each face */
+  out = fopen("boundary.inp","w");
+  if (!out) {
+    fprintf(stderr,"Error in BenchmarkScalingWriteInputs(): unable to open boundary.inp for writing.\n");
+    return(1);
+  }
+  fprintf(out,"%d\n",2*ndims);
+  for (d = 0; d < ndims; d++) {
+    int face, e;
+    for (face = 1; face >= -1; face -= 2) {
+      fprintf(out,"%-12s %d %2d",problem->bctype,d,face);
+      for (e = 0; e < ndims; e++) {
+        if (e == d) fprintf(out,"  0.0 0.0");
+        else        fprintf(out,"  %1.16e %1.16e",problem->xmin[e],problem->xmax[e]);
+      }
+      if (!strcmp(problem->bctype,"slip-wall")) {
+        for (e = 0; e < ndims; e++) fprintf(out," 0.0");
+      }
+      fprintf(out,"\n");
+    }
+  }
+  fclose(out);
+
+  /* physics.inp */
+  out = fopen("physics.inp","w");
+  if (!out) {
+    fprintf(stderr,"Error in BenchmarkScalingWriteInputs(): unable to open physics.inp for writing.\n");
+    return(1);
+  }
+  fprintf(out,"begin\n%send\n",problem->physics);
+  fclose(out);
+
+  /* initial.inp */
+  out = fopen("initial.inp","wb");
+  if (!out) {
+    fprintf(stderr,"Error in BenchmarkScalingWriteInputs(): unable to open initial.inp for writing.\n");
+    return(1);
+  }
+  for (d = 0; d < ndims; d++) {
+    double *x = (double*) calloc (run->dim_global[d],sizeof(double));
+    for (i = 0; i < run->dim_global[d]; i++) x[i] = problem->xmin[d] + ((double)i+0.5)*dx[d];
+    fwrite(x,sizeof(double),run->dim_global[d],out);
+    free(x);
+  }
+  /* write one line of points (along the first dimension) at a time */
+  int     index[_BENCH_MAX_DIMS_], done = 0, n0 = run->dim_global[0];
+  double  *line = (double*) calloc (n0*nvars,sizeof(double)), xp[_BENCH_MAX_DIMS_];
+  for (d = 0; d < ndims; d++) index[d] = 0;
+  while (!done) {
+    for (d = 1; d < ndims; d++) xp[d] = problem->xmin[d] + ((double)index[d]+0.5)*dx[d];
+    for (i = 0; i < n0; i++) {
+      xp[0] = problem->xmin[0] + ((double)i+0.5)*dx[0];
+      problem->solution(xp,&line[i*nvars]);
+    }
+    fwrite(line,sizeof(double),n0*nvars,out);
+    /* next line */
+    done = 1;
+    for (d = 1; d < ndims; d++) {
+      if (++index[d] < run->dim_global[d]) { done = 0; break; }
+      index[d] = 0;
+    }
+  }
+  free(line);
+  fclose(out);
+
+  return(0);
+}
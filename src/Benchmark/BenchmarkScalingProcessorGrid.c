@@ -0,0 +1,96 @@
+/*! @file BenchmarkScalingProcessorGrid.c
+    @brief Choose the processor grid of the scaling harness
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <benchmark.h>
+
+/*! Cost of a processor grid: for weak scaling, the largest number of ranks along a dimension
+    (so that the global domain is as close to a cube as possible); for strong scaling, the
+    number of points on the faces of the local domain that are exchanged with other ranks
+    (the largest local size is used to break ties). */
+static double BenchmarkScalingCost(int ndims, int *iproc, int size, int weak)
+{
+  int d, e;
+  if (weak) {
+    int max_iproc = 0;
+    for (d = 0; d < ndims; d++) if (iproc[d] > max_iproc) max_iproc = iproc[d];
+    return((double) max_iproc);
+  } else {
+    double surface = 0, max_local = 0;
+    for (d = 0; d < ndims; d++) {
+      double local = (double) ((size+iproc[d]-1)/iproc[d]);
+      if (local > max_local) max_local = local;
+      if (iproc[d] == 1) continue;
+      double face = 1.0;
+      for (e = 0; e < ndims; e++) if (e != d) face *= (double) ((size+iproc[e]-1)/iproc[e]);
+      surface += 2.0*face;
+    }
+    return(surface + max_local*1e-6);
+  }
+}
+
+/*! Recursively enumerate the factorizations of \a n into \a ndims-d factors */
+static void BenchmarkScalingEnumerate(int ndims, int d, int n, int *iproc, int *best,
+                                      double *best_cost, int size, int weak)
+{
+  int f;
+  if (d == ndims-1) {
+    iproc[d] = n;
+    if ((!weak) && (size/iproc[d] < _BENCH_GHOSTS_)) return;
+    double cost = BenchmarkScalingCost(ndims,iproc,size,weak);
+    if ((*best_cost < 0) || (cost < *best_cost)) {
+      *best_cost = cost;
+      for (f = 0; f < ndims; f++) best[f] = iproc[f];
+    }
+    return;
+  }
+  for (f = 1; f <= n; f++) {
+    if (n%f) continue;
+    if ((!weak) && (size/f < _BENCH_GHOSTS_)) continue;
+    iproc[d] = f;
+    BenchmarkScalingEnumerate(ndims,d+1,n/f,iproc,best,best_cost,size,weak);
+  }
+}
+
+/*!
+  Choose the number of MPI ranks along each dimension (#BenchmarkScalingRun::iproc) for
+  #BenchmarkScalingRun::nranks ranks, and set the global grid size (#BenchmarkScalingRun::dim_global):
+  + weak scaling: the local grid size is \a size along each dimension, and the global grid size is
+    \a size times the number of ranks along each dimension; the processor grid is the one
+    closest to a cube.
+  + strong scaling: the global grid size is \a size along each dimension; the processor grid
+    is the one that minimizes the number of points exchanged by each rank, with at least
+    #_BENCH_GHOSTS_ points per rank along each dimension (the grid size need not be a multiple
+    of the number of ranks along a dimension; HyPar then distributes the remaining points).
+
+  Returns a nonzero value if no processor grid is possible.
+*/
+int BenchmarkScalingProcessorGrid(
+                                    BenchmarkScalingRun *run,   /*!< Simulation (ndims and nranks must be set) */
+                                    int                 size,   /*!< Local (weak) or global (strong) grid size */
+                                    int                 weak    /*!< Weak (1) or strong (0) scaling */
+                                 )
+{
+  int     iproc[_BENCH_MAX_DIMS_], d;
+  double  best_cost = -1;
+
+  if ((run->ndims < 1) || (run->ndims > _BENCH_MAX_DIMS_) || (run->nranks < 1) || (size < _BENCH_GHOSTS_)) {
+    fprintf(stderr,"Error in BenchmarkScalingProcessorGrid(): invalid ndims (%d), nranks (%d), or size (%d).\n",
+            run->ndims,run->nranks,size);
+    return(1);
+  }
+
+  BenchmarkScalingEnumerate(run->ndims,0,run->nranks,iproc,run->iproc,&best_cost,size,weak);
+  if (best_cost < 0) {
+    fprintf(stderr,"Error in BenchmarkScalingProcessorGrid(): %d ranks cannot be distributed on a grid of size %d ",
+            run->nranks,size);
+    fprintf(stderr,"with at least %d points per rank along each dimension.\n",_BENCH_GHOSTS_);
+    return(1);
+  }
+
+  for (d = 0; d < run->ndims; d++) run->dim_global[d] = (weak ? size*run->iproc[d] : size);
+  return(0);
+}
@@ -0,0 +1,141 @@
+/*! @file BenchmarkTridiagLU.c
+    @brief Micro-benchmarks of the tridiagonal and block tridiagonal solvers
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <arrayfunctions.h>
+#include <tridiagLU.h>
+#include <benchmark.h>
+
+/*! \brief Context of the tridiagonal solver kernels */
+typedef struct benchmark_tridiag_context {
+  BenchmarkProblem *problem;  /*!< Problem object */
+  TridiagLU        lusolver;  /*!< Solver parameters */
+  int     n,                  /*!< Size of each system */
+          ns,                 /*!< Number of systems */
+          bs;                 /*!< Block size (1 for tridiagLU()) */
+  double  *a, *b, *c, *x;     /*!< Systems solved (overwritten by the solver) */
+  double  *a0, *b0, *c0, *x0; /*!< Copies of the systems */
+} BenchmarkTridiagContext;
+
+/*! Set-up: restore the systems overwritten by the previous solve */
+static int BenchmarkTridiagSetup(void *c)
+{
+  BenchmarkTridiagContext *ctxt = (BenchmarkTridiagContext*) c;
+  int size = ctxt->n*ctxt->ns*ctxt->bs;
+  memcpy(ctxt->a,ctxt->a0,size*ctxt->bs*sizeof(double));
+  memcpy(ctxt->b,ctxt->b0,size*ctxt->bs*sizeof(double));
+  memcpy(ctxt->c,ctxt->c0,size*ctxt->bs*sizeof(double));
+  memcpy(ctxt->x,ctxt->x0,size*sizeof(double));
+  return(0);
+}
+
+/*! Kernel: tridiagLU() */
+static int BenchmarkTridiagKernel(void *c)
+{
+  BenchmarkTridiagContext *ctxt = (BenchmarkTridiagContext*) c;
+  return(tridiagLU(ctxt->a,ctxt->b,ctxt->c,ctxt->x,ctxt->n,ctxt->ns,
+                   &ctxt->lusolver,&ctxt->problem->mpi.comm[0]));
+}
+
+/*! Kernel: blocktridiagLU() */
+static int BenchmarkBlockTridiagKernel(void *c)
+{
+  BenchmarkTridiagContext *ctxt = (BenchmarkTridiagContext*) c;
+  return(blocktridiagLU(ctxt->a,ctxt->b,ctxt->c,ctxt->x,ctxt->n,ctxt->ns,ctxt->bs,
+                        &ctxt->lusolver,&ctxt->problem->mpi.comm[0]));
+}
+
+/*! Allocate and fill diagonally dominant (block) tridiagonal systems */
+static void BenchmarkTridiagCreate(BenchmarkTridiagContext *ctxt)
+{
+  int bs = ctxt->bs, bs2 = bs*bs, nrows = ctxt->n*ctxt->ns, i, j;
+  double *f = ctxt->problem->f;
+  int nf = ctxt->problem->solver.npoints_local_wghosts*ctxt->problem->solver.nvars;
+
+  ctxt->a  = ArrayAllocate(nrows*bs2,"tridiag a");
+  ctxt->b  = ArrayAllocate(nrows*bs2,"tridiag b");
+  ctxt->c  = ArrayAllocate(nrows*bs2,"tridiag c");
+  ctxt->x  = ArrayAllocate(nrows*bs ,"tridiag x");
+  ctxt->a0 = ArrayAllocate(nrows*bs2,"tridiag a0");
+  ctxt->b0 = ArrayAllocate(nrows*bs2,"tridiag b0");
+  ctxt->c0 = ArrayAllocate(nrows*bs2,"tridiag c0");
+  ctxt->x0 = ArrayAllocate(nrows*bs ,"tridiag x0");
+
+  for (i = 0; i < nrows; i++) {
+    int row = i / ctxt->ns;
+    for (j = 0; j < bs2; j++) {
+      int diag = ((j/bs) == (j%bs));
+      double offdiag = (diag ? 0.3 : 0.01) * f[(i*bs2+j)%nf];
+      ctxt->a0[i*bs2+j] = (row == 0          ? 0.0 : offdiag);
+      ctxt->c0[i*bs2+j] = (row == ctxt->n-1  ? 0.0 : offdiag);
+      ctxt->b0[i*bs2+j] = (diag ? 2.0 : 0.02) * f[(i*bs2+j+1)%nf];
+    }
+    for (j = 0; j < bs; j++) ctxt->x0[i*bs+j] = f[(i*bs+j)%nf];
+  }
+}
+
+/*! Free the systems */
+static void BenchmarkTridiagDestroy(BenchmarkTridiagContext *ctxt)
+{
+  ArrayFree(ctxt->a);  ArrayFree(ctxt->b);  ArrayFree(ctxt->c);  ArrayFree(ctxt->x);
+  ArrayFree(ctxt->a0); ArrayFree(ctxt->b0); ArrayFree(ctxt->c0); ArrayFree(ctxt->x0);
+}
+
+/*!
+  Benchmark the tridiagonal solvers on systems of the sizes solved by the compact schemes on
+  a synthetic problem:
+  + tridiagLU(): along the first dimension, one scalar system per grid line and per variable,
+    of size (number of interfaces along the line), as for component-wise compact interpolation;
+  + blocktridiagLU(): along the first dimension, one block system per grid line, of the size of
+    the grid line, and block size #HyPar::nvars, as for characteristic-based compact
+    interpolation and for implicit line solves.
+
+  The systems are restored (untimed) before each solve, since the solvers overwrite them. The
+  estimated operation counts are those of the LU decomposition and the forward and backward
+  substitutions (with the inversion and multiplication of the diagonal blocks for the block
+  solver), and the estimated memory traffic is one read of all the arrays and one write of the
+  overwritten ones in each of the forward and backward sweeps.
+*/
+int BenchmarkTridiagLU(
+                        BenchmarkSettings *settings,  /*!< Benchmark settings */
+                        BenchmarkProblem  *problem    /*!< Problem object */
+                      )
+{
+  HyPar *solver = &(problem->solver);
+  int   size    = solver->dim_local[0];
+  _DECLARE_IERR_;
+
+  BenchmarkTridiagContext ctxt;
+  memset(&ctxt,0,sizeof(BenchmarkTridiagContext));
+  ctxt.problem = problem;
+  IERR tridiagLUInit(&ctxt.lusolver,&problem->mpi.world); CHECKERR(ierr);
+
+  if (BenchmarkSelected(settings,"tridiagLU")) {
+    ctxt.n  = size+1;
+    ctxt.ns = (solver->npoints_local/size)*solver->nvars;
+    ctxt.bs = 1;
+    BenchmarkTridiagCreate(&ctxt);
+    double nrows = (double) ctxt.n*ctxt.ns;
+    IERR BenchmarkRun(settings,"tridiagLU",problem,8.0*9.0*nrows,8.0*nrows,
+                      BenchmarkTridiagSetup,BenchmarkTridiagKernel,&ctxt); CHECKERR(ierr);
+    BenchmarkTridiagDestroy(&ctxt);
+  }
+
+  if (BenchmarkSelected(settings,"blocktridiagLU")) {
+    ctxt.n  = size;
+    ctxt.ns = solver->npoints_local/size;
+    ctxt.bs = solver->nvars;
+    BenchmarkTridiagCreate(&ctxt);
+    double nrows = (double) ctxt.n*ctxt.ns, bs = (double) ctxt.bs;
+    IERR BenchmarkRun(settings,"blocktridiagLU",problem,
+                      8.0*nrows*(6.0*bs*bs+3.0*bs),nrows*(6.0*bs*bs*bs+4.0*bs*bs),
+                      BenchmarkTridiagSetup,BenchmarkBlockTridiagKernel,&ctxt); CHECKERR(ierr);
+    BenchmarkTridiagDestroy(&ctxt);
+  }
+
+  return(0);
+}
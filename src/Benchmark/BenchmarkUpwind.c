@@ -0,0 +1,63 @@
+/*! @file BenchmarkUpwind.c
+    @brief Micro-benchmark of an upwinding function
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <benchmark.h>
+
+/*! \brief Context of the upwinding kernel */
+typedef struct benchmark_upwind_context {
+  BenchmarkProblem  *problem; /*!< Problem object */
+  int (*upwind)(double*,double*,double*,double*,double*,double*,int,void*,double); /*!< Upwinding function */
+} BenchmarkUpwindContext;
+
+/*! Upwinding kernel: compute the upwind interface flux along each dimension */
+static int BenchmarkUpwindKernel(void *c)
+{
+  BenchmarkUpwindContext *ctxt    = (BenchmarkUpwindContext*) c;
+  BenchmarkProblem       *problem = ctxt->problem;
+  HyPar                  *solver  = &(problem->solver);
+  int d;
+  _DECLARE_IERR_;
+
+  for (d = 0; d < solver->ndims; d++) {
+    IERR ctxt->upwind(problem->fI,problem->fL,problem->fR,problem->uL,problem->uR,
+                      problem->u,d,solver,0.0); CHECKERR(ierr);
+  }
+  return(0);
+}
+
+/*!
+  Benchmark an upwinding function (#HyPar::Upwind) of a physical model on a synthetic problem
+  whose physics object has been set up by the caller: each kernel call computes the upwind
+  interface flux along each dimension. The estimated memory traffic is one read of the four
+  reconstructed interface arrays and of the cell-centered solution, and one write of the
+  upwind flux, per dimension.
+*/
+int BenchmarkUpwind(
+                      BenchmarkSettings *settings,  /*!< Benchmark settings */
+                      BenchmarkProblem  *problem,   /*!< Problem object (with #HyPar::physics set) */
+                      const char        *name,      /*!< Name of the kernel */
+                      int (*upwind)(double*,double*,double*,double*,double*,double*,int,void*,double),
+                                                    /*!< Upwinding function */
+                      double            flops       /*!< Estimated operations per interface */
+                   )
+{
+  HyPar *solver = &(problem->solver);
+  int   ndims   = solver->ndims,
+        nvars   = solver->nvars, d;
+
+  double ninterfaces = 0;
+  for (d = 0; d < ndims; d++) {
+    ninterfaces += (double) ((solver->npoints_local/solver->dim_local[d])*(solver->dim_local[d]+1));
+  }
+  double words = nvars*(5.0*ninterfaces + ndims*solver->npoints_local_wghosts);
+
+  BenchmarkUpwindContext ctxt;
+  ctxt.problem = problem;
+  ctxt.upwind  = upwind;
+  return(BenchmarkRun(settings,name,problem,8.0*words,flops*ninterfaces,
+                      NULL,BenchmarkUpwindKernel,&ctxt));
+}
@@ -0,0 +1,66 @@
+/*! @file BenchmarkUpwindEuler1D.c
+    @brief Micro-benchmarks of the upwinding functions of the 1D Euler equations
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <arrayfunctions.h>
+#include <physicalmodels/euler1d.h>
+#include <benchmark.h>
+
+int Euler1DUpwindRoe     (double*,double*,double*,double*,double*,double*,int,void*,double);
+int Euler1DUpwindRF      (double*,double*,double*,double*,double*,double*,int,void*,double);
+int Euler1DUpwindLLF     (double*,double*,double*,double*,double*,double*,int,void*,double);
+int Euler1DUpwindSWFS    (double*,double*,double*,double*,double*,double*,int,void*,double);
+int Euler1DUpwindRusanov (double*,double*,double*,double*,double*,double*,int,void*,double);
+
+/*!
+  Benchmark the upwinding functions of the 1D Euler equations (#Euler1D) on a synthetic problem
+  with (approximately) \a npoints_total grid points, so that the results of the different
+  physical models can be compared at the same number of grid points. The physics object is
+  set up directly (with no gravity), instead of with Euler1DInitialize(), so that no input
+  file is needed. The estimated operations per interface count the Roe average, the
+  eigen-decomposition, and the matrix-vector products of each scheme.
+*/
+int BenchmarkUpwindEuler1D(
+                            BenchmarkSettings *settings,      /*!< Benchmark settings */
+                            int               npoints_total   /*!< Number of grid points */
+                          )
+{
+  BenchmarkProblem problem;
+  int   ndims = _MODEL_NDIMS_, nvars = _MODEL_NVARS_, i;
+  double  nv  = (double) nvars;
+  _DECLARE_IERR_;
+
+  if (!BenchmarkSelected(settings,"upwind:euler1d")) return(0);
+
+  int size = (int) round(pow((double)npoints_total,1.0/((double)ndims)));
+  IERR BenchmarkProblemCreate(&problem,ndims,size,nvars); CHECKERR(ierr);
+
+  Euler1D *physics = (Euler1D*) calloc (1,sizeof(Euler1D));
+  physics->gamma = 1.4;
+  physics->grav  = 0.0;
+  physics->grav_field = (double*) calloc (problem.solver.npoints_local_wghosts,sizeof(double));
+  for (i = 0; i < problem.solver.npoints_local_wghosts; i++) physics->grav_field[i] = 1.0;
+  problem.solver.physics = physics;
+  IERR BenchmarkProblemSetEulerState(&problem,physics->gamma); CHECKERR(ierr);
+
+  IERR BenchmarkUpwind(settings,&problem,"upwind:euler1d-roe",Euler1DUpwindRoe,
+                       25.0+3.0*nv+4.0*nv*nv+2.0*nv*nv*nv); CHECKERR(ierr);
+  IERR BenchmarkUpwind(settings,&problem,"upwind:euler1d-rf",Euler1DUpwindRF,
+                       30.0+12.0*nv*nv); CHECKERR(ierr);
+  IERR BenchmarkUpwind(settings,&problem,"upwind:euler1d-llf",Euler1DUpwindLLF,
+                       30.0+12.0*nv*nv+2.0*nv); CHECKERR(ierr);
+  IERR BenchmarkUpwind(settings,&problem,"upwind:euler1d-swfs",Euler1DUpwindSWFS,
+                       60.0+20.0*nv); CHECKERR(ierr);
+  IERR BenchmarkUpwind(settings,&problem,"upwind:euler1d-rusanov",Euler1DUpwindRusanov,
+                       30.0+4.0*nv); CHECKERR(ierr);
+
+  free(physics->grav_field);
+  free(physics);
+  problem.solver.physics = NULL;
+  IERR BenchmarkProblemDestroy(&problem); CHECKERR(ierr);
+  return(0);
+}
@@ -0,0 +1,70 @@
+/*! @file BenchmarkUpwindNavierStokes2D.c
+    @brief Micro-benchmarks of the upwinding functions of the 2D Navier-Stokes equations
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <arrayfunctions.h>
+#include <physicalmodels/navierstokes2d.h>
+#include <benchmark.h>
+
+int NavierStokes2DUpwindRoe     (double*,double*,double*,double*,double*,double*,int,void*,double);
+int NavierStokes2DUpwindRF      (double*,double*,double*,double*,double*,double*,int,void*,double);
+int NavierStokes2DUpwindLLF     (double*,double*,double*,double*,double*,double*,int,void*,double);
+int NavierStokes2DUpwindSWFS    (double*,double*,double*,double*,double*,double*,int,void*,double);
+int NavierStokes2DUpwindRusanov (double*,double*,double*,double*,double*,double*,int,void*,double);
+
+/*!
+  Benchmark the upwinding functions of the 2D Navier-Stokes equations (#NavierStokes2D) on a synthetic problem
+  with (approximately) \a npoints_total grid points, so that the results of the different
+  physical models can be compared at the same number of grid points. The physics object is
+  set up directly (with no gravity), instead of with NavierStokes2DInitialize(), so that no input
+  file is needed. The estimated operations per interface count the Roe average, the
+  eigen-decomposition, and the matrix-vector products of each scheme.
+*/
+int BenchmarkUpwindNavierStokes2D(
+                            BenchmarkSettings *settings,      /*!< Benchmark settings */
+                            int               npoints_total   /*!< Number of grid points */
+                          )
+{
+  BenchmarkProblem problem;
+  int   ndims = _MODEL_NDIMS_, nvars = _MODEL_NVARS_, i;
+  double  nv  = (double) nvars;
+  _DECLARE_IERR_;
+
+  if (!BenchmarkSelected(settings,"upwind:navierstokes2d")) return(0);
+
+  int size = (int) round(pow((double)npoints_total,1.0/((double)ndims)));
+  IERR BenchmarkProblemCreate(&problem,ndims,size,nvars); CHECKERR(ierr);
+
+  NavierStokes2D *physics = (NavierStokes2D*) calloc (1,sizeof(NavierStokes2D));
+  physics->gamma = 1.4;
+  physics->grav_x = physics->grav_y = 0.0;
+  physics->grav_field_f = (double*) calloc (problem.solver.npoints_local_wghosts,sizeof(double));
+  physics->grav_field_g = (double*) calloc (problem.solver.npoints_local_wghosts,sizeof(double));
+  for (i = 0; i < problem.solver.npoints_local_wghosts; i++) {
+    physics->grav_field_f[i] = physics->grav_field_g[i] = 1.0;
+  }
+  problem.solver.physics = physics;
+  IERR BenchmarkProblemSetEulerState(&problem,physics->gamma); CHECKERR(ierr);
+
+  IERR BenchmarkUpwind(settings,&problem,"upwind:navierstokes2d-roe",NavierStokes2DUpwindRoe,
+                       25.0+3.0*nv+4.0*nv*nv+2.0*nv*nv*nv); CHECKERR(ierr);
+  IERR BenchmarkUpwind(settings,&problem,"upwind:navierstokes2d-rf",NavierStokes2DUpwindRF,
+                       30.0+12.0*nv*nv); CHECKERR(ierr);
+  IERR BenchmarkUpwind(settings,&problem,"upwind:navierstokes2d-llf",NavierStokes2DUpwindLLF,
+                       30.0+12.0*nv*nv+2.0*nv); CHECKERR(ierr);
+  IERR BenchmarkUpwind(settings,&problem,"upwind:navierstokes2d-swfs",NavierStokes2DUpwindSWFS,
+                       60.0+20.0*nv); CHECKERR(ierr);
+  IERR BenchmarkUpwind(settings,&problem,"upwind:navierstokes2d-rusanov",NavierStokes2DUpwindRusanov,
+                       30.0+4.0*nv); CHECKERR(ierr);
+
+  free(physics->grav_field_f);
+  free(physics->grav_field_g);
+  free(physics);
+  problem.solver.physics = NULL;
+  IERR BenchmarkProblemDestroy(&problem); CHECKERR(ierr);
+  return(0);
+}
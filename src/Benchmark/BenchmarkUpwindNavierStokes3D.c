@@ -0,0 +1,67 @@
+/*! @file BenchmarkUpwindNavierStokes3D.c
+    @brief Micro-benchmarks of the upwinding functions of the 3D Navier-Stokes equations
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <arrayfunctions.h>
+#include <physicalmodels/navierstokes3d.h>
+#include <benchmark.h>
+
+int NavierStokes3DUpwindRoe     (double*,double*,double*,double*,double*,double*,int,void*,double);
+int NavierStokes3DUpwindRF      (double*,double*,double*,double*,double*,double*,int,void*,double);
+int NavierStokes3DUpwindLLF     (double*,double*,double*,double*,double*,double*,int,void*,double);
+int NavierStokes3DUpwindRusanov (double*,double*,double*,double*,double*,double*,int,void*,double);
+
+/*!
+  Benchmark the upwinding functions of the 3D Navier-Stokes equations (#NavierStokes3D) on a synthetic problem
+  with (approximately) \a npoints_total grid points, so that the results of the different
+  physical models can be compared at the same number of grid points. The physics object is
+  set up directly (with no gravity), instead of with NavierStokes3DInitialize(), so that no input
+  file is needed. The estimated operations per interface count the Roe average, the
+  eigen-decomposition, and the matrix-vector products of each scheme.
+*/
+int BenchmarkUpwindNavierStokes3D(
+                            BenchmarkSettings *settings,      /*!< Benchmark settings */
+                            int               npoints_total   /*!< Number of grid points */
+                          )
+{
+  BenchmarkProblem problem;
+  int   ndims = _MODEL_NDIMS_, nvars = _MODEL_NVARS_, i;
+  double  nv  = (double) nvars;
+  _DECLARE_IERR_;
+
+  if (!BenchmarkSelected(settings,"upwind:navierstokes3d")) return(0);
+
+  int size = (int) round(pow((double)npoints_total,1.0/((double)ndims)));
+  IERR BenchmarkProblemCreate(&problem,ndims,size,nvars); CHECKERR(ierr);
+
+  NavierStokes3D *physics = (NavierStokes3D*) calloc (1,sizeof(NavierStokes3D));
+  physics->gamma = 1.4;
+  physics->grav_x = physics->grav_y = physics->grav_z = 0.0;
+  physics->grav_field_f = (double*) calloc (problem.solver.npoints_local_wghosts,sizeof(double));
+  physics->grav_field_g = (double*) calloc (problem.solver.npoints_local_wghosts,sizeof(double));
+  for (i = 0; i < problem.solver.npoints_local_wghosts; i++) {
+    physics->grav_field_f[i] = physics->grav_field_g[i] = 1.0;
+  }
+  problem.solver.physics = physics;
+  IERR BenchmarkProblemSetEulerState(&problem,physics->gamma); CHECKERR(ierr);
+
+  IERR BenchmarkUpwind(settings,&problem,"upwind:navierstokes3d-roe",NavierStokes3DUpwindRoe,
+                       25.0+3.0*nv+4.0*nv*nv+2.0*nv*nv*nv); CHECKERR(ierr);
+  IERR BenchmarkUpwind(settings,&problem,"upwind:navierstokes3d-rf",NavierStokes3DUpwindRF,
+                       30.0+12.0*nv*nv); CHECKERR(ierr);
+  IERR BenchmarkUpwind(settings,&problem,"upwind:navierstokes3d-llf",NavierStokes3DUpwindLLF,
+                       30.0+12.0*nv*nv+2.0*nv); CHECKERR(ierr);
+  IERR BenchmarkUpwind(settings,&problem,"upwind:navierstokes3d-rusanov",NavierStokes3DUpwindRusanov,
+                       30.0+4.0*nv); CHECKERR(ierr);
+
+  free(physics->grav_field_f);
+  free(physics->grav_field_g);
+  free(physics);
+  problem.solver.physics = NULL;
+  IERR BenchmarkProblemDestroy(&problem); CHECKERR(ierr);
+  return(0);
+}
@@ -0,0 +1,177 @@
+#!/bin/bash
+#
+# Weak and strong scaling studies of HyPar on canned problems.
+#
+# For each local (weak scaling) or global (strong scaling) grid size, and each number of
+# MPI ranks, this script creates a run directory, writes the input files with
+# HyParScalingSetup (see BenchmarkScalingMain.c), runs HyPar with mpiexec, and collects,
+# from the profiler output (profile.json, see MPIProfilerReport()):
+#   + the wall time per time step (slowest rank),
+#   + the parallel efficiency, relative to the smallest number of ranks for each size,
+#   + the fraction of the solve time spent in halo exchanges and in solution output
+#     (averaged over the ranks).
+#
+# Usage (after "make bench"):
+#   src/Benchmark/scaling.sh -problem <name> -mode <weak|strong> -ranks "1 2 4 8" -sizes "32 64" [options]
+#
+# Options:
+#   -problem <name>       vortex2d, densitysine3d, bubble3d, twostream (default: vortex2d)
+#   -mode <weak|strong>   weak: the sizes are local grid sizes; strong: global grid sizes (default: weak)
+#   -ranks "<n1 n2 ...>"  numbers of MPI ranks (default: "1 2 4")
+#   -sizes "<n1 n2 ...>"  grid sizes along each dimension (default: "32")
+#   -n_iter <n>           number of time steps (default: 100)
+#   -file_op_iter <n>     solution output frequency, 0 for no output (default: n_iter/2)
+#   -output_mode <mode>   output mode of HyPar (default: serial)
+#   -oversubscribe        allow more ranks than cores (Open MPI's --oversubscribe)
+#   -mpiexec "<cmd>"      MPI launcher (default: $MPI_EXEC, or mpiexec)
+#   -hypar <path>         HyPar executable (default: src/HyPar in the build directory)
+#   -setup <path>         HyParScalingSetup executable (default: src/Benchmark/HyParScalingSetup)
+#   -dir <path>           directory for the runs (default: scaling_<problem>_<mode>)
+#   -o <file>             summary file (default: <dir>/scaling.dat)
+
+script_dir=$(cd "$(dirname "$0")" && pwd)
+
+problem="vortex2d"
+mode="weak"
+ranks="1 2 4"
+sizes="32"
+n_iter=100
+file_op_iter=-1
+output_mode="serial"
+oversubscribe=""
+mpi_exec=${MPI_EXEC:-mpiexec}
+hypar_exec="$script_dir/../HyPar"
+setup_exec="$script_dir/HyParScalingSetup"
+run_dir=""
+summary=""
+
+while [ $# -gt 0 ]; do
+  case "$1" in
+    -problem)       problem="$2"; shift 2;;
+    -mode)          mode="$2"; shift 2;;
+    -ranks)         ranks="$2"; shift 2;;
+    -sizes)         sizes="$2"; shift 2;;
+    -n_iter)        n_iter="$2"; shift 2;;
+    -file_op_iter)  file_op_iter="$2"; shift 2;;
+    -output_mode)   output_mode="$2"; shift 2;;
+    -oversubscribe) oversubscribe="--oversubscribe"; shift 1;;
+    -mpiexec)       mpi_exec="$2"; shift 2;;
+    -hypar)         hypar_exec="$2"; shift 2;;
+    -setup)         setup_exec="$2"; shift 2;;
+    -dir)           run_dir="$2"; shift 2;;
+    -o)             summary="$2"; shift 2;;
+    *)
+      echo "Error: unrecognized option $1 (see the comments at the top of $0)."
+      exit 1;;
+  esac
+done
+
+if [ "$mode" == "weak" ]; then
+  size_flag="-local"
+elif [ "$mode" == "strong" ]; then
+  size_flag="-global"
+else
+  echo "Error: -mode must be weak or strong."
+  exit 1
+fi
+for f in "$hypar_exec" "$setup_exec"; do
+  if [ ! -x "$f" ]; then
+    echo "Error: $f not found (build HyPar and run \"make bench\", or use -hypar and -setup)."
+    exit 1
+  fi
+done
+hypar_exec=$(cd "$(dirname "$hypar_exec")" && pwd)/$(basename "$hypar_exec")
+setup_exec=$(cd "$(dirname "$setup_exec")" && pwd)/$(basename "$setup_exec")
+
+if [ -z "$run_dir" ]; then
+  run_dir="scaling_${problem}_${mode}"
+fi
+mkdir -p "$run_dir"
+run_dir=$(cd "$run_dir" && pwd)
+if [ -z "$summary" ]; then
+  summary="$run_dir/scaling.dat"
+fi
+
+# time per step, halo exchange and output fractions (%) from profile.json
+parse_profile() {
+  awk '
+    /"path"/ {
+      match($0, /"path": "[^"]*"/);     path  = substr($0, RSTART+9, RLENGTH-10);
+      match($0, /"calls_avg": [^,]*/);  calls = substr($0, RSTART+13, RLENGTH-13) + 0;
+      match($0, /"time_avg": [^,]*/);   tavg  = substr($0, RSTART+12, RLENGTH-12) + 0;
+      match($0, /"time_max": [^,]*/);   tmax  = substr($0, RSTART+12, RLENGTH-12) + 0;
+      n = split(path, parts, "/");
+      leaf = parts[n];
+      outermost = 1;
+      for (i = 1; i < n; i++) if (parts[i] == leaf) outermost = 0;
+      if (path == "Solve")                                                solve = tavg;
+      if (path == "Solve/TimeStep")                                       { step = tmax; nsteps = calls; }
+      if (parts[1] == "Solve" && outermost && leaf == "HaloExchange")     halo += tavg;
+      if (parts[1] == "Solve" && outermost && leaf == "Output")           io += tavg;
+    }
+    END {
+      if (solve <= 0 || nsteps <= 0) { print "failed"; exit; }
+      printf("%e %.2f %.2f\n", step/nsteps, 100*halo/solve, 100*io/solve);
+    }' "$1"
+}
+
+printf "# %-14s %-6s %6s %6s %-16s %-10s %12s %10s %9s %9s\n" \
+  "problem" "mode" "size" "nranks" "global" "iproc" "time/step" "efficiency" "halo(%)" "output(%)" > "$summary"
+
+for size in $sizes; do
+  t_ref=""
+  n_ref=""
+  for n in $ranks; do
+    dir="$run_dir/size${size}_np${n}"
+    rm -rf "$dir" && mkdir -p "$dir"
+    cd "$dir"
+    echo "$problem ($mode scaling): size $size, $n rank(s) ..."
+
+    setup_args="-problem $problem -nranks $n $size_flag $size -n_iter $n_iter -output_mode $output_mode"
+    if [ "$file_op_iter" -ge 0 ]; then
+      setup_args="$setup_args -file_op_iter $file_op_iter"
+    fi
+    info=$("$setup_exec" $setup_args)
+    if [ $? -ne 0 ]; then
+      echo "  input generation failed; skipping."
+      cd "$run_dir"
+      continue
+    fi
+    # "problem <name> nranks <n> size <n1 ...> iproc <p1 ...>"
+    global=$(echo "$info" | sed -e 's/.* size \(.*\) iproc .*/\1/' | tr ' ' 'x')
+    iproc=$(echo "$info" | sed -e 's/.* iproc \(.*\)/\1/' | tr ' ' 'x')
+
+    $mpi_exec -n $n $oversubscribe "$hypar_exec" > out.log 2>&1
+    if [ $? -ne 0 ] || [ ! -f profile.json ] || grep -q "^Error" out.log; then
+      echo "  HyPar failed (see $dir/out.log); skipping."
+      cd "$run_dir"
+      continue
+    fi
+
+    result=$(parse_profile profile.json)
+    if [ "$result" == "failed" ]; then
+      echo "  no timings in $dir/profile.json; skipping."
+      cd "$run_dir"
+      continue
+    fi
+    read t_step halo io <<< "$result"
+
+    if [ -z "$t_ref" ]; then
+      t_ref=$t_step
+      n_ref=$n
+    fi
+    if [ "$mode" == "weak" ]; then
+      efficiency=$(awk -v t0=$t_ref -v t=$t_step 'BEGIN { printf("%.3f", t0/t) }')
+    else
+      efficiency=$(awk -v t0=$t_ref -v n0=$n_ref -v t=$t_step -v n=$n 'BEGIN { printf("%.3f", (t0*n0)/(t*n)) }')
+    fi
+
+    printf "  %-14s %-6s %6d %6d %-16s %-10s %12.4e %10s %9s %9s\n" \
+      "$problem" "$mode" $size $n "$global" "$iproc" $t_step $efficiency $halo $io >> "$summary"
+    echo "  time/step $t_step s, efficiency $efficiency, halo $halo%, output $io%"
+    cd "$run_dir"
+  done
+done
+
+echo "Summary written to $summary:"
+cat "$summary"
@@ -17,6 +17,8 @@ int BCCleanup(  void *b, /*!< Boundary object of type #DomainBoundary*/
   free(boundary->xmax);
   free(boundary->is);
   free(boundary->ie);
+  if (boundary->gindex) free(boundary->gindex);
+  if (boundary->iindex) free(boundary->iindex);
   if (boundary->DirichletValue) free(boundary->DirichletValue);
   if (boundary->SpongeValue   ) free(boundary->SpongeValue   );
   if (boundary->FlowVelocity  ) free(boundary->FlowVelocity  );
@@ -24,14 +24,10 @@ int BCDirichletU(
   DomainBoundary *boundary = (DomainBoundary*) b;
 
   if (boundary->on_this_proc) {
-    int bounds[ndims], indexb[ndims];
-    _ArraySubtract1D_(bounds,boundary->ie,boundary->is,ndims);
-    _ArraySetValue_(indexb,ndims,0);
-    int done = 0;
-    while (!done) {
-      int p; _ArrayIndex1DWO_(ndims,size  ,indexb,boundary->is,ghosts,p);
+    int k;
+    for (k = 0; k < boundary->npoints; k++) {
+      int p = boundary->gindex[k];
       _ArrayCopy1D_((boundary->DirichletValue),(phi+nvars*p),nvars);
-      _ArrayIncrementIndex_(ndims,bounds,indexb,done);
     }
   }
   return(0);
@@ -23,26 +23,13 @@ int BCExtrapolateU(
 {
   DomainBoundary *boundary = (DomainBoundary*) b;
 
-  int dim   = boundary->dim;
-  int face  = boundary->face;
-
-  if (boundary->on_this_proc) {
-    int bounds[ndims], indexb[ndims], indexi[ndims];
-    _ArraySubtract1D_(bounds,boundary->ie,boundary->is,ndims);
-    _ArraySetValue_(indexb,ndims,0);
-    int done = 0;
-    while (!done) {
-      _ArrayCopy1D_(indexb,indexi,ndims);
-      _ArrayAdd1D_(indexi,indexi,boundary->is,ndims);
-      if (face == 1)        indexi[dim] = ghosts-1-indexb[dim];
-      else if (face == -1)  indexi[dim] = size[dim]-indexb[dim]-1;
-      else                  return(1);
-      int p1,p2;
-      _ArrayIndex1DWO_(ndims,size,indexb,boundary->is,ghosts,p1);
-      _ArrayIndex1D_(ndims,size,indexi,ghosts,p2);
-      _ArrayCopy1D_((phi+nvars*p2),(phi+nvars*p1),nvars);
-      _ArrayIncrementIndex_(ndims,bounds,indexb,done);
-    }
+  /* the index lists may include those of the following zones of the group
+     (see BCGroupZones()), so they are applied even if this zone is not on
+     this process; they are empty otherwise */
+  int k;
+  for (k = 0; k < boundary->npoints; k++) {
+    int p1 = boundary->gindex[k], p2 = boundary->iindex[k];
+    _ArrayCopy1D_((phi+nvars*p2),(phi+nvars*p1),nvars);
   }
   return(0);
 }
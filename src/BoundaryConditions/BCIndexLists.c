@@ -0,0 +1,139 @@
+/*! @file BCIndexLists.c
+    @author Debojyoti Ghosh
+    @brief Pre-computed index lists of the boundary ghost points
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <basic.h>
+#include <arrayfunctions.h>
+#include <mpivars.h>
+#include <boundaryconditions.h>
+
+/*! Compute the lists of the 1D indices (with ghosts) of the ghost points of a boundary zone
+    on this process (#DomainBoundary::gindex), and of the interior points from which they are
+    computed (#DomainBoundary::iindex): the mirror images across the boundary face, or, for a
+    periodic boundary, the periodic images (only if the domain is not partitioned along the
+    periodic dimension; otherwise, the periodic ghost points are filled by MPIExchangeBoundariesnD()
+    and the lists are empty). The lists are computed once, so that the boundary conditions are
+    applied by a single loop over the ghost points instead of recomputing the multi-dimensional
+    indices at every call.
+
+    This function must be called after the index range of the zone on this process
+    (#DomainBoundary::is, #DomainBoundary::ie) has been computed; the arrays are deallocated
+    in BCCleanup().
+*/
+int BCIndexLists( void  *b,     /*!< Boundary object of type #DomainBoundary */
+                  void  *m,     /*!< MPI object of type #MPIVariables */
+                  int   ndims,  /*!< Number of spatial dimensions */
+                  int   *size,  /*!< Integer array with the number of grid points in each spatial dimension */
+                  int   ghosts  /*!< Number of ghost points */
+                )
+{
+  DomainBoundary *boundary = (DomainBoundary*) b;
+  MPIVariables   *mpi      = (MPIVariables*)   m;
+
+  int dim   = boundary->dim;
+  int face  = boundary->face;
+  int periodic = (!strcmp(boundary->bctype,_PERIODIC_));
+
+  boundary->npoints = 0;
+  boundary->gindex  = NULL;
+  boundary->iindex  = NULL;
+
+  if (!boundary->on_this_proc) return(0);
+  if (periodic && (mpi->iproc[dim] != 1)) return(0);
+  if ((face != 1) && (face != -1)) {
+    fprintf(stderr,"Error in BCIndexLists(): invalid face %d for boundary along dimension %d.\n",
+            face, dim);
+    return(1);
+  }
+
+  int bounds[ndims], indexb[ndims], indexi[ndims];
+  _ArraySubtract1D_(bounds,boundary->ie,boundary->is,ndims);
+  _ArrayProduct1D_(bounds,ndims,boundary->npoints);
+  if (boundary->npoints <= 0) {
+    boundary->npoints = 0;
+    return(0);
+  }
+  boundary->gindex = (int*) calloc (boundary->npoints,sizeof(int));
+  boundary->iindex = (int*) calloc (boundary->npoints,sizeof(int));
+
+  int k = 0, done = 0;
+  _ArraySetValue_(indexb,ndims,0);
+  while (!done) {
+    int p1, p2;
+    _ArrayIndex1DWO_(ndims,size,indexb,boundary->is,ghosts,p1);
+    _ArrayCopy1D_(indexb,indexi,ndims);
+    if (periodic) {
+      if (face == 1) indexi[dim] = indexb[dim] + size[dim]-ghosts;
+    } else {
+      _ArrayAdd1D_(indexi,indexi,boundary->is,ndims);
+      if (face == 1)  indexi[dim] = ghosts-1-indexb[dim];
+      else            indexi[dim] = size[dim]-indexb[dim]-1;
+    }
+    _ArrayIndex1D_(ndims,size,indexi,ghosts,p2);
+    boundary->gindex[k] = p1;
+    boundary->iindex[k] = p2;
+    k++;
+    _ArrayIncrementIndex_(ndims,bounds,indexb,done);
+  }
+
+  return(0);
+}
+
+/*! Group consecutive boundary zones that only copy interior values to the ghost points
+    (#_EXTRAPOLATE_ and #_PERIODIC_): the index lists of the zones of a group are concatenated
+    (in the order of the zones) into those of its first zone, so that ApplyBoundaryConditions()
+    applies the group in one sweep. Since these boundary conditions read only interior points,
+    and the zones are applied in the same order, the result is identical to applying the zones
+    one after the other.
+
+    This function must be called after BCIndexLists() and BCInitialize() have been called
+    for each zone.
+*/
+int BCGroupZones( void  *b, /*!< Array of boundary objects of type #DomainBoundary */
+                  int   nb  /*!< Number of boundary zones */
+                )
+{
+  DomainBoundary *boundary = (DomainBoundary*) b;
+
+  int n = 0;
+  while (n < nb) {
+
+    boundary[n].ngroup = 1;
+    int copy = (    (boundary[n].BCFunctionU == BCExtrapolateU)
+                 || (boundary[n].BCFunctionU == BCPeriodicU   ) );
+    if (!copy) { n++; continue; }
+
+    int m = n+1, npoints = boundary[n].npoints;
+    while (     (m < nb)
+            &&  (    (boundary[m].BCFunctionU == BCExtrapolateU)
+                  || (boundary[m].BCFunctionU == BCPeriodicU   ) ) ) {
+      npoints += boundary[m].npoints;
+      m++;
+    }
+    if (m == n+1) { n++; continue; }
+
+    int *gindex = (int*) calloc (npoints,sizeof(int));
+    int *iindex = (int*) calloc (npoints,sizeof(int));
+    int j, k = 0;
+    for (j = n; j < m; j++) {
+      _ArrayCopy1D_(boundary[j].gindex,(gindex+k),boundary[j].npoints);
+      _ArrayCopy1D_(boundary[j].iindex,(iindex+k),boundary[j].npoints);
+      k += boundary[j].npoints;
+      free(boundary[j].gindex); boundary[j].gindex = NULL;
+      free(boundary[j].iindex); boundary[j].iindex = NULL;
+      boundary[j].npoints = 0;
+      boundary[j].ngroup  = 0;
+    }
+    boundary[n].gindex  = gindex;
+    boundary[n].iindex  = iindex;
+    boundary[n].npoints = npoints;
+    boundary[n].ngroup  = m-n;
+
+    n = m;
+  }
+
+  return(0);
+}
@@ -13,6 +13,7 @@ int BCInitialize( void *b, /*!< Boundary object of type #DomainBoundary*/
                   int flag_gpu  /*!< Flag to indicate if GPU is being used */ )
 {
   DomainBoundary *boundary = (DomainBoundary*) b;
+  boundary->ngroup = 1;
 
 #if defined(HAVE_CUDA)
   if (flag_gpu) {
@@ -30,9 +30,6 @@ int BCNoslipWallU(
 {
   DomainBoundary *boundary = (DomainBoundary*) b;
 
-  int dim   = boundary->dim;
-  int face  = boundary->face;
-
   if (ndims == 2) {
 
     /* create a fake physics object */
@@ -41,19 +38,9 @@ int BCNoslipWallU(
     double inv_gamma_m1 = 1.0/(gamma-1.0);
 
     if (boundary->on_this_proc) {
-      int bounds[ndims], indexb[ndims], indexi[ndims];
-      _ArraySubtract1D_(bounds,boundary->ie,boundary->is,ndims);
-      _ArraySetValue_(indexb,ndims,0);
-      int done = 0;
-      while (!done) {
-        int p1, p2;
-        _ArrayCopy1D_(indexb,indexi,ndims);
-        _ArrayAdd1D_(indexi,indexi,boundary->is,ndims);
-        if      (face ==  1) indexi[dim] = ghosts-1-indexb[dim];
-        else if (face == -1) indexi[dim] = size[dim]-indexb[dim]-1;
-        else return(1);
-        _ArrayIndex1DWO_(ndims,size,indexb,boundary->is,ghosts,p1);
-        _ArrayIndex1D_(ndims,size,indexi,ghosts,p2);
+      int k;
+      for (k = 0; k < boundary->npoints; k++) {
+        int p1 = boundary->gindex[k], p2 = boundary->iindex[k];
 
         /* flow variables in the interior */
         double rho, uvel, vvel, energy, pressure;
@@ -71,8 +58,6 @@ int BCNoslipWallU(
         phi[nvars*p1+1] = rho_gpt * uvel_gpt;
         phi[nvars*p1+2] = rho_gpt * vvel_gpt;
         phi[nvars*p1+3] = energy_gpt;
-
-        _ArrayIncrementIndex_(ndims,bounds,indexb,done);
       }
     }
 
@@ -83,19 +68,9 @@ int BCNoslipWallU(
     double inv_gamma_m1 = 1.0/(gamma-1.0);
 
     if (boundary->on_this_proc) {
-      int bounds[ndims], indexb[ndims], indexi[ndims];
-      _ArraySubtract1D_(bounds,boundary->ie,boundary->is,ndims);
-      _ArraySetValue_(indexb,ndims,0);
-      int done = 0;
-      while (!done) {
-        int p1, p2;
-        _ArrayCopy1D_(indexb,indexi,ndims);
-        _ArrayAdd1D_(indexi,indexi,boundary->is,ndims);
-        if      (face ==  1) indexi[dim] = ghosts-1-indexb[dim];
-        else if (face == -1) indexi[dim] = size[dim]-indexb[dim]-1;
-        else return(1);
-        _ArrayIndex1DWO_(ndims,size,indexb,boundary->is,ghosts,p1);
-        _ArrayIndex1D_(ndims,size,indexi,ghosts,p2);
+      int k;
+      for (k = 0; k < boundary->npoints; k++) {
+        int p1 = boundary->gindex[k], p2 = boundary->iindex[k];
 
         /* flow variables in the interior */
         double rho, uvel, vvel, wvel, energy, pressure;
@@ -116,8 +91,6 @@ int BCNoslipWallU(
         phi[nvars*p1+2] = rho_gpt * vvel_gpt;
         phi[nvars*p1+3] = rho_gpt * wvel_gpt;
         phi[nvars*p1+4] = energy_gpt;
-
-        _ArrayIncrementIndex_(ndims,bounds,indexb,done);
       }
     }
 
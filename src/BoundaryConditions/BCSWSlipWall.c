@@ -32,24 +32,13 @@ int BCSWSlipWallU(
   DomainBoundary *boundary = (DomainBoundary*) b;
 
   int dim   = boundary->dim;
-  int face  = boundary->face;
 
   if (ndims == 1) {
 
     if (boundary->on_this_proc) {
-      int bounds[ndims], indexb[ndims], indexi[ndims];
-      _ArraySubtract1D_(bounds,boundary->ie,boundary->is,ndims);
-      _ArraySetValue_(indexb,ndims,0);
-      int done = 0;
-      while (!done) {
-        int p1, p2;
-        _ArrayCopy1D_(indexb,indexi,ndims);
-        _ArrayAdd1D_(indexi,indexi,boundary->is,ndims);
-        if      (face ==  1) indexi[dim] = ghosts-1-indexb[dim];
-        else if (face == -1) indexi[dim] = size[dim]-indexb[dim]-1;
-        else return(1);
-        _ArrayIndex1DWO_(ndims,size,indexb,boundary->is,ghosts,p1);
-        _ArrayIndex1D_(ndims,size,indexi,ghosts,p2);
+      int k;
+      for (k = 0; k < boundary->npoints; k++) {
+        int p1 = boundary->gindex[k], p2 = boundary->iindex[k];
 
         /* flow variables in the interior */
         double h, uvel;
@@ -61,27 +50,15 @@ int BCSWSlipWallU(
 
         phi[nvars*p1+0] = h_gpt;
         phi[nvars*p1+1] = h_gpt * uvel_gpt;
-
-        _ArrayIncrementIndex_(ndims,bounds,indexb,done);
       }
     }
 
   } else if (ndims == 2) {
 
     if (boundary->on_this_proc) {
-      int bounds[ndims], indexb[ndims], indexi[ndims];
-      _ArraySubtract1D_(bounds,boundary->ie,boundary->is,ndims);
-      _ArraySetValue_(indexb,ndims,0);
-      int done = 0;
-      while (!done) {
-        int p1, p2;
-        _ArrayCopy1D_(indexb,indexi,ndims);
-        _ArrayAdd1D_(indexi,indexi,boundary->is,ndims);
-        if      (face ==  1) indexi[dim] = ghosts-1-indexb[dim];
-        else if (face == -1) indexi[dim] = size[dim]-indexb[dim]-1;
-        else return(1);
-        _ArrayIndex1DWO_(ndims,size,indexb,boundary->is,ghosts,p1);
-        _ArrayIndex1D_(ndims,size,indexi,ghosts,p2);
+      int k;
+      for (k = 0; k < boundary->npoints; k++) {
+        int p1 = boundary->gindex[k], p2 = boundary->iindex[k];
 
         /* flow variables in the interior */
         double h, uvel, vvel;
@@ -103,8 +80,6 @@ int BCSWSlipWallU(
         phi[nvars*p1+0] = h_gpt;
         phi[nvars*p1+1] = h_gpt * uvel_gpt;
         phi[nvars*p1+2] = h_gpt * vvel_gpt;
-
-        _ArrayIncrementIndex_(ndims,bounds,indexb,done);
       }
     }
 
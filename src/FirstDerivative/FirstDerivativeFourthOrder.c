@@ -66,7 +66,7 @@ int FirstDerivativeFourthOrderCentral(
   _ArrayCopy1D_(dim,bounds_outer,ndims); bounds_outer[dir] =  1;
   int N_outer; _ArrayProduct1D_(bounds_outer,ndims,N_outer);
 
-#pragma omp parallel for schedule(auto) default(shared) private(i,j,v,index_outer,indexC)
+#pragma omp parallel for schedule(static) default(shared) private(i,j,v,index_outer,indexC)
   for (j=0; j<N_outer; j++) {
     _ArrayIndexnD_(ndims,j,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexC,ndims);
@@ -20,7 +20,9 @@
  * that contains all the boundary information (dimension, extent, face, type, etc).
  * This function iterates through each of the boundary zones
  * (#HyPar::boundary[#HyPar::nBoundaryZones]) and calls the corresponding boundary
- * condition function.
+ * condition function. Consecutive zones that only copy interior values to the ghost
+ * points are grouped (see BCGroupZones()) and applied in one sweep by the first zone
+ * of the group; the other zones of the group (#DomainBoundary::ngroup = 0) are skipped.
  * \n\n
  * The variable \a flag indicates if the array \a x is the solution, or a delta-solution
  * (from implicit time-integration methods).
@@ -49,11 +51,14 @@ int ApplyBoundaryConditions(void    *s,     /*!< Object of type #HyPar containin
 #endif
 
   /* Apply domain boundary conditions to x */
+  MPIProfilerBegin("BoundaryConditions");
   int n;
   for (n = 0; n < nb; n++) {
+    if (!boundary[n].ngroup) continue;
     boundary[n].BCFunctionU(&boundary[n],mpi,solver->ndims,solver->nvars,
                             dim_local,solver->ghosts,x,waqt);
   }
+  MPIProfilerEnd("BoundaryConditions",0);
 
   return(0);
 }
@@ -8,11 +8,22 @@
 #include <mpivars.h>
 #include <hypar.h>
 
+/*! Add the global boundary integral of a step to the total boundary integral */
+static int BoundaryIntegralAdd(double  *global_integral, /*!< Global boundary integral of a step */
+                               int     nvars,            /*!< Number of components */
+                               void    *s                /*!< Solver object of type #HyPar */
+                              )
+{
+  HyPar *solver = (HyPar*) s;
+  _ArrayAXPY_(global_integral,1.0,solver->TotalBoundaryIntegral,nvars);
+  return(0);
+}
+
 /*! Computes the flux integral over the boundary. The local flux integral
     (on this processor) is computed for physical as well as MPI boundaries.
     The global boundary integral is computed by summing the local integrals
     over all the processors, since the contributions from the MPI boundaries
-    cancel out.
+    cancel out; this reduction may be deferred (see MPIDiagnosticsPost()).
 */
 int BoundaryIntegral(
                       void *s, /*!< Solver object of type #HyPar */
@@ -29,7 +40,6 @@ int BoundaryIntegral(
   int d,v,k;
 
   double *local_integral  = (double*) calloc (nvars,sizeof(double));
-  double *global_integral = (double*) calloc (nvars,sizeof(double));
 
   /* calculate the local boundary integral on each process */
   _ArraySetValue_(local_integral,nvars,0.0);
@@ -47,14 +57,12 @@ int BoundaryIntegral(
   }
 
   /* add across process to calculate global boundary integral
-   * (internal (MPI) boundaries must cancel out)
+   * (internal (MPI) boundaries must cancel out), and add it to the
+   * total boundary integral
    */
-  IERR MPISum_double(global_integral,local_integral,nvars,&mpi->world); CHECKERR(ierr);
-
-  /* add to the total boundary integral */
-  _ArrayAXPY_(global_integral,1.0,solver->TotalBoundaryIntegral,nvars);
+  IERR MPIDiagnosticsPost(NULL,local_integral,nvars,_MPI_DIAG_SUM_,&mpi->world,
+                          BoundaryIntegralAdd,solver); CHECKERR(ierr);
 
   free(local_integral);
-  free(global_integral);
   return(0);
 }
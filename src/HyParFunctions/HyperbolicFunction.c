@@ -3,15 +3,26 @@
     @brief Compute the hyperbolic term of the governing equations
 */
 
-#include <time.h>
-
 #include <stdlib.h>
 #include <basic.h>
 #include <arrayfunctions.h>
+#include <interpolation.h>
+#include <rhstasks.h>
 #include <mpivars.h>
 #include <hypar.h>
+#include <amr.h>
+
+#ifdef with_omp
+#include <omp.h>
+#endif
 
-static int ReconstructHyperbolic (double*,double*,double*,double*,int,void*,void*,double,int,
+int HyperbolicFunctionAccumulate(double*,double,double*,void*,void*,double,int,
+                                 int(*)(double*,double*,int,void*,double),
+                                 int(*)(double*,double*,double*,double*,double*,double*,int,void*,double));
+static int HyperbolicFunctionDimension(double*,double,double*,int,int,RHSWork*,void*,void*,double,int,
+                                       int(*)(double*,double*,int,void*,double),
+                                       int(*)(double*,double*,double*,double*,double*,double*,int,void*,double));
+static int ReconstructHyperbolic (double*,double*,double*,int,RHSWork*,void*,void*,double,int,
                                  int(*)(double*,double*,double*,double*,double*,double*,int,void*,double));
 static int DefaultUpwinding      (double*,double*,double*,double*,double*,double*,int,void*,double);
 
@@ -27,6 +38,9 @@ static int DefaultUpwinding      (double*,double*,double*,double*,double*,double
     the discretized quantity, and \f$j\f$ is the grid coordinate along dimension \f$d\f$.
     The approximation to the flux function \f${\bf f}_d\f$ at the interfaces \f$j\pm1/2\f$, denoted by \f$\hat{\bf f}_{d,j\pm 1/2}\f$,
     are computed using the function ReconstructHyperbolic().
+
+    The array \a hyp is set to zero, the hyperbolic term is added to it by HyperbolicFunctionAccumulate(),
+    and it is multiplied by the blanking array if there are immersed bodies.
 */
 int HyperbolicFunction(
                         double  *hyp, /*!< Array to hold the computed hyperbolic term (shares the same layout as u */
@@ -42,63 +56,205 @@ int HyperbolicFunction(
                         /*! Function pointer to the upwinding function for the hyperbolic term */
                         int(*UpwindFunction)(double*,double*,double*,double*,double*,double*,int,void*,double)
                       )
+{
+  HyPar         *solver = (HyPar*)        s;
+  _DECLARE_IERR_;
+
+  int size  = solver->npoints_local_wghosts;
+  int nvars = solver->nvars;
+
+  _ArraySetValue_(hyp,size*nvars,0.0);
+  IERR HyperbolicFunctionAccumulate(hyp,1.0,u,s,m,t,LimFlag,FluxFunction,UpwindFunction);
+  CHECKERR(ierr);
+
+  if (solver->flag_ib) _ArrayBlockMultiply_(hyp,solver->iblank,size,nvars);
+
+  return(0);
+}
+
+/*! Add a multiple of the hyperbolic term (see HyperbolicFunction()) to a given array:
+    \f{equation}{
+      {\bf r} \mathrel{+}= a \hat{\bf F} \left({\bf u}\right).
+    \f}
+    This allows the right-hand-side of the ODE to be assembled in place (see FusedRHSFunction())
+    without a separate array for the hyperbolic term. The array \a rhs is \b not multiplied by the
+    blanking array of immersed bodies; this is left to the caller. The boundary flux integral
+    #HyPar::StageBoundaryIntegral is that of the unscaled hyperbolic term.
+
+    The dimensions are evaluated by HyperbolicFunctionDimension(), either one after the other,
+    or, if #HyPar::rhs_tasks is set up (see rhstasks.h), as concurrent OpenMP tasks with
+    separate work arrays; in the latter case, the contribution of each dimension is added
+    to \a rhs in the order of the dimensions, so that the result is the same.
+*/
+int HyperbolicFunctionAccumulate(
+                                  double  *rhs, /*!< Array to which the scaled hyperbolic term is added
+                                                     (shares the same layout as u) */
+                                  double  a,    /*!< Scaling factor */
+                                  double  *u,   /*!< Solution array */
+                                  void    *s,   /*!< Solver object of type #HyPar */
+                                  void    *m,   /*!< MPI object of type #MPIVariables */
+                                  double  t,    /*!< Current simulation time */
+                                  int     LimFlag,  /*!< Flag to indicate if the nonlinear coefficients for
+                                                         solution-dependent interpolation method should be recomputed */
+                                  /*! Function pointer to the flux function for the hyperbolic term */
+                                  int(*FluxFunction)(double*,double*,int,void*,double),
+                                  /*! Function pointer to the upwinding function for the hyperbolic term */
+                                  int(*UpwindFunction)(double*,double*,double*,double*,double*,double*,int,void*,double)
+                                )
 {
   HyPar         *solver = (HyPar*)        s;
   MPIVariables  *mpi    = (MPIVariables*) m;
-  int           d, v, i, done;
-  double        *FluxI  = solver->fluxI; /* interface flux     */
-  double        *FluxC  = solver->fluxC; /* cell centered flux */
+  RHSTasks      *tasks  = (RHSTasks*)     solver->rhs_tasks;
+  int           d;
   _DECLARE_IERR_;
 
   int     ndims  = solver->ndims;
   int     nvars  = solver->nvars;
   int     ghosts = solver->ghosts;
   int     *dim   = solver->dim_local;
-  int     size   = solver->npoints_local_wghosts;
-  double  *x     = solver->x;
-  double  *dxinv = solver->dxinv;
-  int     index[ndims], index1[ndims], index2[ndims], dim_interface[ndims];
 
   LimFlag = (LimFlag && solver->flag_nonlinearinterp && solver->SetInterpLimiterVar);
 
-  _ArraySetValue_(hyp,size*nvars,0.0);
   _ArraySetValue_(solver->StageBoundaryIntegral,2*ndims*nvars,0.0);
+  if (solver->flux_register) {
+    FluxRegister *reg = (FluxRegister*) solver->flux_register;
+    _ArraySetValue_(reg->stage,reg->nfaces*reg->nvars,0.0);
+  }
   if (!FluxFunction) return(0); /* zero hyperbolic term */
   solver->count_hyp++;
+  MPIProfilerBegin("HyperbolicFunction");
+
+  /* offsets of each dimension in the arrays of grid coordinates */
+  int offset[ndims];
+  offset[0] = 0;
+  for (d = 1; d < ndims; d++) offset[d] = offset[d-1] + dim[d-1] + 2*ghosts;
+
+  if (tasks) {
+
+#ifdef with_omp
+    int     size   = solver->npoints_local_wghosts;
+    int     ierr_d[ndims];
+    double  *hyp_d[ndims];
+    hyp_d[0] = rhs;
+    for (d = 1; d < ndims; d++) hyp_d[d] = tasks->hyp[d];
+
+#pragma omp parallel num_threads(tasks->ntasks) default(shared) private(d)
+#pragma omp single
+    {
+      /* one task per dimension; within a task, the threaded loops use nthreads_inner threads */
+      for (d = 0; d < ndims; d++) {
+#pragma omp task firstprivate(d) depend(out:hyp_d[d])
+        {
+          omp_set_num_threads(tasks->nthreads_inner);
+          if (d) _ArraySetValue_(hyp_d[d],size*nvars,0.0);
+          ierr_d[d] = HyperbolicFunctionDimension(hyp_d[d],a,u,d,offset[d],&tasks->work[d],
+                                                  solver,mpi,t,LimFlag,FluxFunction,
+                                                  UpwindFunction);
+        }
+      }
+      /* add the contributions of the dimensions in order, as each one becomes available */
+      for (d = 1; d < ndims; d++) {
+#pragma omp task firstprivate(d) depend(in:hyp_d[d]) depend(inout:hyp_d[0])
+        _ArrayAXPY_(hyp_d[d],1.0,rhs,size*nvars);
+      }
+    }
 
-#if defined(CPU_STAT)
-  double cpu_time = 0.0;
-  clock_t cpu_start, cpu_end;
+    MPIProfilerEnd("HyperbolicFunction",0);
+    for (d = 0; d < ndims; d++) if (ierr_d[d]) return(ierr_d[d]);
 #endif
 
-  int offset = 0;
-  for (d = 0; d < ndims; d++) {
-    _ArrayCopy1D_(dim,dim_interface,ndims); dim_interface[d]++;
-    int size_cellcenter = 1; for (i = 0; i < ndims; i++) size_cellcenter *= (dim[i] + 2*ghosts);
-    int size_interface = 1; for (i = 0; i < ndims; i++) size_interface *= dim_interface[i];
+  } else {
+
+    RHSWork work;
+    work.fluxC = solver->fluxC;
+    work.uC    = solver->uC;
+    work.fluxI = solver->fluxI;
+    work.uL    = solver->uL;
+    work.uR    = solver->uR;
+    work.fL    = solver->fL;
+    work.fR    = solver->fR;
+
+    for (d = 0; d < ndims; d++) {
+      IERR HyperbolicFunctionDimension(rhs,a,u,d,offset[d],&work,solver,mpi,t,LimFlag,
+                                       FluxFunction,UpwindFunction);
+      CHECKERR(ierr);
+    }
+    MPIProfilerEnd("HyperbolicFunction",0);
 
-    /* evaluate cell-centered flux */
-    IERR FluxFunction(FluxC,u,d,solver,t); CHECKERR(ierr);
-    /* compute interface fluxes */
-    IERR ReconstructHyperbolic(FluxI,FluxC,u,x+offset,d,solver,mpi,t,LimFlag,UpwindFunction);
-    CHECKERR(ierr);
+  }
+
+  return(0);
+}
 
-    /* calculate the first derivative */
+/*! Compute the hyperbolic term along one spatial dimension and add a multiple of it to \a hyp:
+    the cell-centered flux is evaluated, the interface flux is computed by ReconstructHyperbolic(),
+    and its first derivative is computed, scaled by \a a, and added to \a hyp. The fluxes at the physical
+    boundaries of the local domain are accumulated in #HyPar::StageBoundaryIntegral, and those at
+    the faces of the flux register (#HyPar::flux_register), if any, are stored in it.
+    All intermediate arrays are taken from \a work, so that different dimensions can be
+    evaluated concurrently with different work arrays.
+*/
+int HyperbolicFunctionDimension(
+                                  double  *hyp,     /*!< Array to which the hyperbolic term along d is added */
+                                  double  a,        /*!< Scaling factor */
+                                  double  *u,       /*!< Solution array */
+                                  int     d,        /*!< Spatial dimension */
+                                  int     offset,   /*!< Offset of dimension d in the arrays of grid coordinates */
+                                  RHSWork *work,    /*!< Work arrays */
+                                  void    *s,       /*!< Solver object of type #HyPar */
+                                  void    *m,       /*!< MPI object of type #MPIVariables */
+                                  double  t,        /*!< Current simulation time */
+                                  int     LimFlag,  /*!< Flag to indicate if the nonlinear coefficients should be recomputed */
+                                  /*! Function pointer to the flux function for the hyperbolic term */
+                                  int(*FluxFunction)(double*,double*,int,void*,double),
+                                  /*! Function pointer to the upwinding function for the hyperbolic term */
+                                  int(*UpwindFunction)(double*,double*,double*,double*,double*,double*,int,void*,double)
+                                )
+{
+  HyPar         *solver = (HyPar*)        s;
+  MPIVariables  *mpi    = (MPIVariables*) m;
+  int           v, done;
+  double        *FluxI  = work->fluxI; /* interface flux     */
+  double        *FluxC  = work->fluxC; /* cell centered flux */
+  _DECLARE_IERR_;
+
+  int     ndims  = solver->ndims;
+  int     nvars  = solver->nvars;
+  int     ghosts = solver->ghosts;
+  int     *dim   = solver->dim_local;
+  double  *x     = solver->x;
+  double  *dxinv = solver->dxinv;
+  int     index[ndims], index1[ndims], index2[ndims], dim_interface[ndims];
+
+  _ArrayCopy1D_(dim,dim_interface,ndims); dim_interface[d]++;
+
+  /* evaluate cell-centered flux */
+  MPIProfilerBegin("FluxFunction");
+  IERR FluxFunction(FluxC,u,d,solver,t); CHECKERR(ierr);
+  MPIProfilerEnd("FluxFunction",0);
+  /* compute interface fluxes */
+  IERR ReconstructHyperbolic(FluxC,u,x+offset,d,work,solver,mpi,t,LimFlag,UpwindFunction);
+  CHECKERR(ierr);
+
+  /* calculate the first derivative */
+  MPIProfilerBegin("FluxDifference");
+
+  if (solver->HyperbolicFluxDifference) {
+    IERR solver->HyperbolicFluxDifference(hyp,a,FluxI,dxinv+offset+ghosts,
+                                          solver->StageBoundaryIntegral,d,solver);
+    CHECKERR(ierr);
+  } else {
     done = 0; _ArraySetValue_(index,ndims,0);
     int p, p1, p2;
 
-#if defined(CPU_STAT)
-    cpu_start = clock();
-#endif
-
     while (!done) {
       _ArrayCopy1D_(index,index1,ndims);
       _ArrayCopy1D_(index,index2,ndims); index2[d]++;
       _ArrayIndex1D_(ndims,dim          ,index ,ghosts,p);
       _ArrayIndex1D_(ndims,dim_interface,index1,0     ,p1);
       _ArrayIndex1D_(ndims,dim_interface,index2,0     ,p2);
-      for (v=0; v<nvars; v++) hyp[nvars*p+v] += dxinv[offset+ghosts+index[d]]
-                                              * (FluxI[nvars*p2+v]-FluxI[nvars*p1+v]);
+      for (v=0; v<nvars; v++) hyp[nvars*p+v] += a * (dxinv[offset+ghosts+index[d]]
+                                                   * (FluxI[nvars*p2+v]-FluxI[nvars*p1+v]));
       /* boundary flux integral */
       if (index[d] == 0)
         for (v=0; v<nvars; v++) solver->StageBoundaryIntegral[(2*d+0)*nvars+v] -= FluxI[nvars*p1+v];
@@ -107,20 +263,20 @@ int HyperbolicFunction(
 
       _ArrayIncrementIndex_(ndims,dim,index,done);
     }
-
-#if defined(CPU_STAT)
-    cpu_end = clock();
-    cpu_time += (double)(cpu_end - cpu_start) / CLOCKS_PER_SEC;
-#endif
-
-    offset += dim[d] + 2*ghosts;
   }
 
-#if defined(CPU_STAT)
-  printf("HyperbolicFunction CPU time = %8.6lf\n", cpu_time);
-#endif
+  MPIProfilerEnd("FluxDifference",0);
 
-  if (solver->flag_ib) _ArrayBlockMultiply_(hyp,solver->iblank,size,nvars);
+  /* flux at the coarse-fine interfaces of the adaptive mesh refinement (see amr.h) */
+  if (solver->flux_register) {
+    FluxRegister *reg = (FluxRegister*) solver->flux_register;
+    int k;
+    for (k = 0; k < reg->nfaces; k++) {
+      if ((reg->dir[k] == d) && (reg->index[k] >= 0)) {
+        _ArrayCopy1D_((FluxI+nvars*reg->index[k]),(reg->stage+nvars*k),nvars);
+      }
+    }
+  }
 
   return(0);
 }
@@ -165,14 +321,15 @@ int HyperbolicFunction(
     + LimFlag = 0 means reuse the the previously computed coefficients.
 */
 int ReconstructHyperbolic(
-                            double  *fluxI,     /*!< Array to hold the computed interface fluxes. This array does not
-                                                     have ghost points. The dimensions are the same as those of u without
-                                                     ghost points in all dimensions, except along dir, where it is one more */
                             double  *fluxC,     /*!< Array of the flux function computed at the cell centers
                                                      (same layout as u) */
                             double  *u,         /*!< Solution array */
                             double  *x,         /*!< Array of spatial coordinates */
                             int     dir,        /*!< Spatial dimension along which to reconstruct the interface fluxes */
+                            RHSWork *work,      /*!< Work arrays; the computed interface fluxes are returned in
+                                                     work->fluxI. This array does not have ghost points. The dimensions
+                                                     are the same as those of u without ghost points in all dimensions,
+                                                     except along dir, where it is one more */
                             void    *s,         /*!< Solver object of type #HyPar */
                             void    *m,         /*!< MPI object of type #MPIVariables */
                             double  t,          /*!< Current solution time */
@@ -188,35 +345,54 @@ int ReconstructHyperbolic(
   _DECLARE_IERR_;
 
   double *uC     = NULL;
-  double *uL     = solver->uL;
-  double *uR     = solver->uR;
-  double *fluxL  = solver->fL;
-  double *fluxR  = solver->fR;
+  double *fluxI  = work->fluxI;
+  double *uL     = work->uL;
+  double *uR     = work->uR;
+  double *fluxL  = work->fL;
+  double *fluxR  = work->fR;
+
+  /*
+    compute the averaged states and eigenvectors at the interfaces once, if the
+    interface eigensystem cache is enabled; they are then shared by the nonlinear
+    weights, the characteristic-based interpolations and the upwinding below
+  */
+  if (solver->eigen_cache) { IERR EigenCacheCompute(u,dir,solver); CHECKERR(ierr); }
 
   /*
     precalculate the non-linear interpolation coefficients if required
     else reuse the weights previously calculated
   */
 
-  if (LimFlag) IERR solver->SetInterpLimiterVar(fluxC,u,x,dir,solver,mpi);
+  if (LimFlag) {
+    MPIProfilerBegin("NonlinearWeights");
+    IERR solver->SetInterpLimiterVar(fluxC,u,x,dir,solver,mpi);
+    MPIProfilerEnd("NonlinearWeights",0);
+  }
 
   /* if defined, calculate the modified u-function to be used for upwinding
      e.g.: used in well-balanced schemes for Euler/Navier-Stokes with gravity
      otherwise, just copy u to uC */
   if (solver->UFunction) {
-    uC = solver->uC;
+    uC = work->uC;
     IERR solver->UFunction(uC,u,dir,solver,mpi,t); CHECKERR(ierr);
   } else uC = u;
 
   /* Interpolation -> to calculate left and right-biased interface flux and state variable*/
+  MPIProfilerBegin("Interpolation");
   IERR solver->InterpolateInterfacesHyp(uL   ,uC   ,u,x, 1,dir,solver,mpi,1); CHECKERR(ierr);
   IERR solver->InterpolateInterfacesHyp(uR   ,uC   ,u,x,-1,dir,solver,mpi,1); CHECKERR(ierr);
   IERR solver->InterpolateInterfacesHyp(fluxL,fluxC,u,x, 1,dir,solver,mpi,0); CHECKERR(ierr);
   IERR solver->InterpolateInterfacesHyp(fluxR,fluxC,u,x,-1,dir,solver,mpi,0); CHECKERR(ierr);
+  MPIProfilerEnd("Interpolation",0);
 
   /* Upwind -> to calculate the final interface flux */
+  MPIProfilerBegin("Upwinding");
   if (UpwindFunction) { IERR UpwindFunction   (fluxI,fluxL,fluxR,uL  ,uR  ,u   ,dir,solver,t); CHECKERR(ierr); }
   else                { IERR DefaultUpwinding (fluxI,fluxL,fluxR,NULL,NULL,NULL,dir,solver,t); CHECKERR(ierr); }
+  MPIProfilerEnd("Upwinding",0);
+
+  /* the cached interface eigensystem is valid only for this call */
+  if (solver->eigen_cache) { IERR EigenCacheInvalidate(solver->eigen_cache); CHECKERR(ierr); }
 
   return(0);
 }
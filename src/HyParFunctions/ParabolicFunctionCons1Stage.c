@@ -9,6 +9,8 @@
 #include <mpivars.h>
 #include <hypar.h>
 
+int ParabolicFunctionCons1StageAccumulate(double*,double,double*,void*,void*,double);
+
 /*! Evaluate the parabolic term using a conservative finite-difference spatial discretization:
     The parabolic term is assumed to be of the form:
     \f{equation}{
@@ -30,6 +32,8 @@
 
     \b Reference: Liu, Y., Shu, C.-W., Zhang, M., "High order finite difference WENO schemes for nonlinear degenerate parabolic
                   equations", SIAM J. Sci. Comput., 33 (2), 2011, pp. 939-965, http://dx.doi.org/10.1137/100791002
+
+    The parabolic term is computed by ParabolicFunctionCons1StageAccumulate().
 */
 int ParabolicFunctionCons1Stage(
                                   double  *par, /*!< array to hold the computed parabolic term */
@@ -38,6 +42,30 @@ int ParabolicFunctionCons1Stage(
                                   void    *m,   /*!< MPI object of type #MPIVariables */
                                   double  t     /*!< Current simulation time */
                                )
+{
+  HyPar *solver = (HyPar*) s;
+  int   size    = solver->npoints_local_wghosts;
+  _DECLARE_IERR_;
+
+  _ArraySetValue_(par,size*solver->nvars,0.0);
+  IERR ParabolicFunctionCons1StageAccumulate(par,1.0,u,s,m,t); CHECKERR(ierr);
+  if (solver->flag_ib) _ArrayBlockMultiply_(par,solver->iblank,size,solver->nvars);
+
+  return(0);
+}
+
+/*! Add a multiple of the parabolic term, evaluated as described in ParabolicFunctionCons1Stage(),
+    to a given array. The array is \b not multiplied by the blanking array of immersed bodies;
+    this is left to the caller (see FusedRHSFunction()).
+*/
+int ParabolicFunctionCons1StageAccumulate(
+                                            double  *par, /*!< array to which the scaled parabolic term is added */
+                                            double  a,    /*!< scaling factor */
+                                            double  *u,   /*!< solution */
+                                            void    *s,   /*!< Solver object of type #HyPar */
+                                            void    *m,   /*!< MPI object of type #MPIVariables */
+                                            double  t     /*!< Current simulation time */
+                                         )
 {
   HyPar         *solver = (HyPar*)        s;
   MPIVariables  *mpi    = (MPIVariables*) m;
@@ -51,11 +79,9 @@ int ParabolicFunctionCons1Stage(
   int     ghosts = solver->ghosts;
   int     *dim   = solver->dim_local;
   double  *dxinv = solver->dxinv;
-  int     size   = solver->npoints_local_wghosts;
 
   int index[ndims], index1[ndims], index2[ndims], dim_interface[ndims];
 
-  _ArraySetValue_(par,size*nvars,0.0);
   if (!solver->GFunction) return(0); /* zero parabolic term */
   solver->count_par++;
 
@@ -80,14 +106,13 @@ int ParabolicFunctionCons1Stage(
       _ArrayIndex1D_(ndims,dim_interface,index1,0     ,p1);
       _ArrayIndex1D_(ndims,dim_interface,index2,0     ,p2);
       for (v=0; v<nvars; v++)
-        par[nvars*p+v] +=  ((dxinv[offset+ghosts+index[d]] * dxinv[offset+ghosts+index[d]])
-                          * (FluxI[nvars*p2+v] - FluxI[nvars*p1+v]));
+        par[nvars*p+v] +=  a * ((dxinv[offset+ghosts+index[d]] * dxinv[offset+ghosts+index[d]])
+                              * (FluxI[nvars*p2+v] - FluxI[nvars*p1+v]));
       _ArrayIncrementIndex_(ndims,dim,index,done);
     }
 
     offset += dim[d] + 2*ghosts;
   }
 
-  if (solver->flag_ib) _ArrayBlockMultiply_(par,solver->iblank,size,nvars);
   return(0);
 }
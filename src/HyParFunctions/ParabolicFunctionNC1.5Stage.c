@@ -9,6 +9,8 @@
 #include <mpivars.h>
 #include <hypar.h>
 
+int ParabolicFunctionNC1_5StageAccumulate(double*,double,double*,void*,void*,double);
+
 /*! Evaluate the parabolic term using a "1.5"-stage finite-difference spatial discretization:
     The parabolic term is assumed to be of the form:
     \f{equation}{
@@ -31,6 +33,8 @@
     + the physical model must specify \f${\bf h}_{d1,d2}\left({\bf u}\right)\f$ through #HyPar::HFunction.
 
     \sa ParabolicFunctionNC2Stage()
+
+    The parabolic term is computed by ParabolicFunctionNC1_5StageAccumulate().
 */
 int ParabolicFunctionNC1_5Stage(
                                   double  *par, /*!< array to hold the computed parabolic term */
@@ -39,6 +43,30 @@ int ParabolicFunctionNC1_5Stage(
                                   void    *m,   /*!< MPI object of type #MPIVariables */
                                   double  t     /*!< Current simulation time */
                                )
+{
+  HyPar *solver = (HyPar*) s;
+  int   size    = solver->npoints_local_wghosts;
+  _DECLARE_IERR_;
+
+  _ArraySetValue_(par,size*solver->nvars,0.0);
+  IERR ParabolicFunctionNC1_5StageAccumulate(par,1.0,u,s,m,t); CHECKERR(ierr);
+  if (solver->flag_ib) _ArrayBlockMultiply_(par,solver->iblank,size,solver->nvars);
+
+  return(0);
+}
+
+/*! Add a multiple of the parabolic term, evaluated as described in ParabolicFunctionNC1_5Stage(),
+    to a given array. The array is \b not multiplied by the blanking array of immersed bodies;
+    this is left to the caller (see FusedRHSFunction()).
+*/
+int ParabolicFunctionNC1_5StageAccumulate(
+                                            double  *par, /*!< array to which the scaled parabolic term is added */
+                                            double  a,    /*!< scaling factor */
+                                            double  *u,   /*!< solution */
+                                            void    *s,   /*!< Solver object of type #HyPar */
+                                            void    *m,   /*!< MPI object of type #MPIVariables */
+                                            double  t     /*!< Current simulation time */
+                                         )
 {
   HyPar         *solver = (HyPar*)        s;
   MPIVariables  *mpi    = (MPIVariables*) m;
@@ -54,13 +82,11 @@ int ParabolicFunctionNC1_5Stage(
   int     ghosts  = solver->ghosts;
   int     *dim    = solver->dim_local;
   double  *dxinv  = solver->dxinv;
-  int     size   = solver->npoints_local_wghosts;
 
   if (!solver->HFunction) return(0); /* zero parabolic terms */
   solver->count_par++;
 
   int index[ndims];
-  _ArraySetValue_(par,size*nvars,0.0);
 
   for (d1 = 0; d1 < ndims; d1++) {
     for (d2 = 0; d2 < ndims; d2++) {
@@ -83,13 +109,12 @@ int ParabolicFunctionNC1_5Stage(
         _ArrayIndex1D_(ndims,dim,index,ghosts,p);
         _GetCoordinate_(d1,index[d1],dim,ghosts,dxinv,dxinv1);
         _GetCoordinate_(d2,index[d2],dim,ghosts,dxinv,dxinv2);
-        for (v=0; v<nvars; v++) par[nvars*p+v] += (dxinv1*dxinv2 * Deriv2[nvars*p+v]);
+        for (v=0; v<nvars; v++) par[nvars*p+v] += a * (dxinv1*dxinv2 * Deriv2[nvars*p+v]);
         _ArrayIncrementIndex_(ndims,dim,index,done);
       }
 
     }
   }
 
-  if (solver->flag_ib) _ArrayBlockMultiply_(par,solver->iblank,size,nvars);
   return(0);
 }
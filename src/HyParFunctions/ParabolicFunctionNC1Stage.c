@@ -9,6 +9,8 @@
 #include <mpivars.h>
 #include <hypar.h>
 
+int ParabolicFunctionNC1StageAccumulate(double*,double,double*,void*,void*,double);
+
 /*! Evaluate the parabolic term using a conservative finite-difference spatial discretization:
     The parabolic term is assumed to be of the form:
     \f{equation}{
@@ -27,6 +29,8 @@
     To use this form of the parabolic term:
     + specify \b "par_space_type" in solver.inp as \b "nonconservative-1stage" (#HyPar::spatial_type_par).
     + the physical model must specify \f${\bf g}_d\left({\bf u}\right)\f$ through #HyPar::GFunction.
+
+    The parabolic term is computed by ParabolicFunctionNC1StageAccumulate().
 */
 int ParabolicFunctionNC1Stage(
                                 double  *par, /*!< array to hold the computed parabolic term */
@@ -35,6 +39,30 @@ int ParabolicFunctionNC1Stage(
                                 void    *m,   /*!< MPI object of type #MPIVariables */
                                 double  t     /*!< Current simulation time */
                              )
+{
+  HyPar *solver = (HyPar*) s;
+  int   size    = solver->npoints_local_wghosts;
+  _DECLARE_IERR_;
+
+  _ArraySetValue_(par,size*solver->nvars,0.0);
+  IERR ParabolicFunctionNC1StageAccumulate(par,1.0,u,s,m,t); CHECKERR(ierr);
+  if (solver->flag_ib) _ArrayBlockMultiply_(par,solver->iblank,size,solver->nvars);
+
+  return(0);
+}
+
+/*! Add a multiple of the parabolic term, evaluated as described in ParabolicFunctionNC1Stage(),
+    to a given array. The array is \b not multiplied by the blanking array of immersed bodies;
+    this is left to the caller (see FusedRHSFunction()).
+*/
+int ParabolicFunctionNC1StageAccumulate(
+                                          double  *par, /*!< array to which the scaled parabolic term is added */
+                                          double  a,    /*!< scaling factor */
+                                          double  *u,   /*!< solution */
+                                          void    *s,   /*!< Solver object of type #HyPar */
+                                          void    *m,   /*!< MPI object of type #MPIVariables */
+                                          double  t     /*!< Current simulation time */
+                                       )
 {
   HyPar         *solver = (HyPar*)        s;
   MPIVariables  *mpi    = (MPIVariables*) m;
@@ -48,13 +76,11 @@ int ParabolicFunctionNC1Stage(
   int     ghosts = solver->ghosts;
   int     *dim   = solver->dim_local;
   double  *dxinv = solver->dxinv;
-  int     size   = solver->npoints_local_wghosts;
 
   if (!solver->GFunction) return(0); /* zero parabolic terms */
   solver->count_par++;
 
   int index[ndims];
-  _ArraySetValue_(par,size*nvars,0.0);
 
   int offset = 0;
   for (d = 0; d < ndims; d++) {
@@ -70,14 +96,13 @@ int ParabolicFunctionNC1Stage(
     while (!done) {
       _ArrayIndex1D_(ndims,dim,index,ghosts,p);
       for (v=0; v<nvars; v++)
-        par[nvars*p+v] += (   dxinv[offset+ghosts+index[d]]*dxinv[offset+ghosts+index[d]]
-                            * Deriv2[nvars*p+v] );
+        par[nvars*p+v] += a * (   dxinv[offset+ghosts+index[d]]*dxinv[offset+ghosts+index[d]]
+                                * Deriv2[nvars*p+v] );
       _ArrayIncrementIndex_(ndims,dim,index,done);
     }
 
     offset += dim[d] + 2*ghosts;
   }
 
-  if (solver->flag_ib) _ArrayBlockMultiply_(par,solver->iblank,size,nvars);
   return(0);
 }
@@ -9,6 +9,8 @@
 #include <mpivars.h>
 #include <hypar.h>
 
+int ParabolicFunctionNC2StageAccumulate(double*,double,double*,void*,void*,double);
+
 /*! Evaluate the parabolic term using a "1.5"-stage finite-difference spatial discretization:
     The parabolic term is assumed to be of the form:
     \f{equation}{
@@ -35,7 +37,14 @@
     + specify \b "par_space_type" in solver.inp as \b "nonconservative-2stage" (#HyPar::spatial_type_par).
     + the physical model must specify \f${\bf h}_{d1,d2}\left({\bf u}\right)\f$ through #HyPar::HFunction.
 
+    On a non-uniform grid (#HyPar::nonuniform), the first derivative \f$\mathcal{D}_{d1}\left[ {\bf h}_{d1,d2} \right]\f$
+    is divided by the grid spacing at each point before the second derivative with respect to the
+    same dimension (\f$d2 = d1\f$) is computed. Note that, with the one-sided first-order first derivatives
+    (FirstDerivativeFirstOrder()), the result is then only first-order accurate on a stretched grid.
+
     \sa ParabolicFunctionNC1_5Stage()
+
+    The parabolic term is computed by ParabolicFunctionNC2StageAccumulate().
 */
 int ParabolicFunctionNC2Stage(
                                 double  *par, /*!< array to hold the computed parabolic term */
@@ -44,6 +53,30 @@ int ParabolicFunctionNC2Stage(
                                 void    *m,   /*!< MPI object of type #MPIVariables */
                                 double  t     /*!< Current simulation time */
                              )
+{
+  HyPar *solver = (HyPar*) s;
+  int   size    = solver->npoints_local_wghosts;
+  _DECLARE_IERR_;
+
+  _ArraySetValue_(par,size*solver->nvars,0.0);
+  IERR ParabolicFunctionNC2StageAccumulate(par,1.0,u,s,m,t); CHECKERR(ierr);
+  if (solver->flag_ib) _ArrayBlockMultiply_(par,solver->iblank,size,solver->nvars);
+
+  return(0);
+}
+
+/*! Add a multiple of the parabolic term, evaluated as described in ParabolicFunctionNC2Stage(),
+    to a given array. The array is \b not multiplied by the blanking array of immersed bodies;
+    this is left to the caller (see FusedRHSFunction()).
+*/
+int ParabolicFunctionNC2StageAccumulate(
+                                          double  *par, /*!< array to which the scaled parabolic term is added */
+                                          double  a,    /*!< scaling factor */
+                                          double  *u,   /*!< solution */
+                                          void    *s,   /*!< Solver object of type #HyPar */
+                                          void    *m,   /*!< MPI object of type #MPIVariables */
+                                          double  t     /*!< Current simulation time */
+                                       )
 {
   HyPar         *solver = (HyPar*)        s;
   MPIVariables  *mpi    = (MPIVariables*) m;
@@ -59,7 +92,6 @@ int ParabolicFunctionNC2Stage(
   int     ghosts = solver->ghosts;
   int     *dim   = solver->dim_local;
   double  *dxinv = solver->dxinv;
-  int     size   = solver->npoints_local_wghosts;
 
   printf("HFunction is defined? = %p\n", solver->HFunction);
 
@@ -67,7 +99,6 @@ int ParabolicFunctionNC2Stage(
   solver->count_par++;
 
   int index[ndims];
-  _ArraySetValue_(par,size*nvars,0.0);
 
   for (d1 = 0; d1 < ndims; d1++) {
     for (d2 = 0; d2 < ndims; d2++) {
@@ -76,6 +107,19 @@ int ParabolicFunctionNC2Stage(
       IERR solver->HFunction(Func,u,d1,d2,solver,t);                    CHECKERR(ierr);
       IERR solver->FirstDerivativePar(Deriv1,Func  ,d1, 1,solver,mpi);  CHECKERR(ierr);
       IERR MPIExchangeBoundariesnD(ndims,nvars,dim,ghosts,mpi,Deriv1);  CHECKERR(ierr);
+      if (solver->nonuniform && (d1 == d2)) {
+        /* on a non-uniform grid, the inner derivative is divided by the grid spacing at
+           each point (including the ghost points) before it is differentiated again */
+        int bounds[ndims], indexg[ndims], q;
+        _ArrayAddCopy1D_(dim,(2*ghosts),bounds,ndims);
+        done = 0; _ArraySetValue_(indexg,ndims,0);
+        while (!done) {
+          _ArrayIndex1D_(ndims,bounds,indexg,0,q);
+          _GetCoordinate_(d1,(indexg[d1]-ghosts),dim,ghosts,dxinv,dxinv1);
+          _ArrayScale1D_((Deriv1+q*nvars),dxinv1,nvars);
+          _ArrayIncrementIndex_(ndims,bounds,indexg,done);
+        }
+      }
       IERR solver->FirstDerivativePar(Deriv2,Deriv1,d2,-1,solver,mpi);  CHECKERR(ierr);
 
       /* calculate the final term - second derivative of the diffusion function */
@@ -84,13 +128,13 @@ int ParabolicFunctionNC2Stage(
         _ArrayIndex1D_(ndims,dim,index,ghosts,p);
         _GetCoordinate_(d1,index[d1],dim,ghosts,dxinv,dxinv1);
         _GetCoordinate_(d2,index[d2],dim,ghosts,dxinv,dxinv2);
-        for (v=0; v<nvars; v++) par[nvars*p+v] += (dxinv1*dxinv2 * Deriv2[nvars*p+v]);
+        if (solver->nonuniform && (d1 == d2)) dxinv1 = 1.0;
+        for (v=0; v<nvars; v++) par[nvars*p+v] += a * (dxinv1*dxinv2 * Deriv2[nvars*p+v]);
         _ArrayIncrementIndex_(ndims,dim,index,done);
       }
 
     }
   }
 
-  if (solver->flag_ib) _ArrayBlockMultiply_(par,solver->iblank,size,nvars);
   return(0);
 }
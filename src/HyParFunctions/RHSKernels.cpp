@@ -0,0 +1,228 @@
+/*! @file RHSKernels.cpp
+    @author Debojyoti Ghosh
+    @brief Compile-time specialized kernels for the right-hand-side evaluation
+*/
+
+#include <stdio.h>
+#include <basic.h>
+#include <arrayfunctions.h>
+#include <interpolation.h>
+#include <rhskernels.h>
+#include <mpivars.h>
+#include <hypar.h>
+
+/*! Add a multiple of the derivative of the interface fluxes along a given dimension to the
+    hyperbolic term (see HyperbolicFunctionAccumulate()):
+    \f{equation}{
+      {\bf F}_j \mathrel{+}= \frac{a}{\Delta x_j} \left[ \hat{\bf f}_{j+1/2} - \hat{\bf f}_{j-1/2} \right],
+    \f}
+    and accumulate the fluxes at the physical boundaries of the local domain into
+    the boundary flux integral.
+
+    The number of spatial dimensions and the number of solution components are the template
+    parameters \a NDIMS and \a NVARS. The domain is traversed one 1D line along \a dir at a time;
+    the lines are ordered exactly as the points of the generic loop, so the boundary flux
+    integral is accumulated in the same order and the result is identical to that of the
+    generic implementation.
+*/
+template <int NDIMS, int NVARS>
+static int HyperbolicFluxDifferenceKernel(
+                                            double  *hyp,   /*!< Hyperbolic term (with ghost points) */
+                                            double  a,      /*!< Scaling factor */
+                                            double  *fluxI, /*!< Interface fluxes along dir */
+                                            double  *dxinv, /*!< 1/dx along dir, starting at the first interior point */
+                                            double  *bint,  /*!< Boundary flux integral */
+                                            int     dir,    /*!< Spatial dimension */
+                                            void    *s      /*!< Solver object of type #HyPar */
+                                         )
+{
+  HyPar *solver = (HyPar*) s;
+  int   ghosts  = solver->ghosts;
+  int   *dim    = solver->dim_local;
+  int   k, v;
+
+  int bounds_outer[NDIMS], bounds_inter[NDIMS];
+  _ArrayCopy1D_(dim,bounds_outer,NDIMS); bounds_outer[dir] =  1;
+  _ArrayCopy1D_(dim,bounds_inter,NDIMS); bounds_inter[dir] += 1;
+  int N_outer; _ArrayProduct1D_(bounds_outer,NDIMS,N_outer);
+
+  /* strides along dir for the cell-centered (with ghosts) and the interface arrays */
+  int stride_c = NVARS * solver->stride_with_ghosts[dir];
+  int stride_i = NVARS; for (k = 0; k < dir; k++) stride_i *= bounds_inter[k];
+  int n = dim[dir];
+
+  double *bint_L = bint + (2*dir+0)*NVARS;
+  double *bint_R = bint + (2*dir+1)*NVARS;
+
+  int i, j;
+  for (i = 0; i < N_outer; i++) {
+    int index[NDIMS], p, p1;
+    _ArrayIndexnD_(NDIMS,i,bounds_outer,index,0);
+    _ArrayIndex1D_(NDIMS,dim         ,index,ghosts,p );
+    _ArrayIndex1D_(NDIMS,bounds_inter,index,0     ,p1);
+
+    double *h  = hyp   + NVARS*p;
+    double *fI = fluxI + NVARS*p1;
+
+    /* boundary flux integral */
+    for (v = 0; v < NVARS; v++) bint_L[v] -= fI[v];
+
+    for (j = 0; j < n; j++) {
+      for (v = 0; v < NVARS; v++) h[v] += a * (dxinv[j] * (fI[stride_i+v]-fI[v]));
+      h  += stride_c;
+      fI += stride_i;
+    }
+
+    /* boundary flux integral */
+    for (v = 0; v < NVARS; v++) bint_R[v] += fI[v];
+  }
+
+  return(0);
+}
+
+/*! Component-wise fifth order WENO interpolation of the first primitive at the cell
+    interfaces along \a dir with the given WENO weights \a ww1, \a ww2, \a ww3 (offset to
+    the interpolation direction and bias), for \a NDIMS spatial dimensions and \a NVARS
+    components. The weights are saved in double or single precision (the template parameter
+    \a W, see #WENOParameters::single); the arithmetic is in double precision.
+*/
+template <int NDIMS, int NVARS, typename W>
+static void Interp1PrimFifthOrderWENOLines(double *fI, double *fC, const W *ww1, const W *ww2,
+                                           const W *ww3, int upw, int dir, HyPar *solver)
+{
+  int ghosts = solver->ghosts;
+  int *dim   = solver->dim_local;
+  int *stride= solver->stride_with_ghosts;
+  int k;
+
+  /* define some constants */
+  static const double one_sixth          = 1.0/6.0;
+
+  int bounds_outer[NDIMS], bounds_inter[NDIMS];
+  _ArrayCopy1D_(dim,bounds_outer,NDIMS); bounds_outer[dir] =  1;
+  _ArrayCopy1D_(dim,bounds_inter,NDIMS); bounds_inter[dir] += 1;
+  int N_outer; _ArrayProduct1D_(bounds_outer,NDIMS,N_outer);
+
+  /* strides along dir: sq steps from the upwind-most stencil point towards
+     the interface, stride_i from one interface to the next */
+  int stride_c = NVARS * stride[dir];
+  int sq       = (upw > 0 ? stride_c : -stride_c);
+  int stride_i = NVARS; for (k = 0; k < dir; k++) stride_i *= bounds_inter[k];
+  int n        = dim[dir]+1;
+
+  int i;
+#pragma omp parallel for schedule(static) default(shared) private(i)
+  for (i=0; i<N_outer; i++) {
+    int index[NDIMS], qm1, p, j, v;
+    _ArrayIndexnD_(NDIMS,i,bounds_outer,index,0);
+    _ArrayIndex1D_(NDIMS,bounds_inter,index,0,p);
+    index[dir] = (upw > 0 ? -1 : 0);
+    _ArrayIndex1D_(NDIMS,dim,index,ghosts,qm1);
+
+    double  *fm1 = fC + qm1*NVARS;
+    double  *f   = fI + p*NVARS;
+    const W *w1  = ww1 + p*NVARS;
+    const W *w2  = ww2 + p*NVARS;
+    const W *w3  = ww3 + p*NVARS;
+
+    for (j = 0; j < n; j++) {
+      /* Defining stencil points */
+      double *fm3 = fm1 - 2*sq;
+      double *fm2 = fm1 -   sq;
+      double *fp1 = fm1 +   sq;
+      double *fp2 = fm1 + 2*sq;
+
+      for (v = 0; v < NVARS; v++) {
+        /* Candidate stencils */
+        double f1 = (2*one_sixth)*fm3[v] + (-7*one_sixth)*fm2[v] + (11*one_sixth)*fm1[v];
+        double f2 = (-one_sixth) *fm2[v] + (5*one_sixth) *fm1[v] + (2*one_sixth) *fp1[v];
+        double f3 = (2*one_sixth)*fm1[v] + (5*one_sixth) *fp1[v] + (-one_sixth)  *fp2[v];
+        /* weighted combination */
+        f[v] = (double)w1[v]*f1 + (double)w2[v]*f2 + (double)w3[v]*f3;
+      }
+
+      fm1 += stride_c;
+      f   += stride_i;
+      w1  += stride_i;
+      w2  += stride_i;
+      w3  += stride_i;
+    }
+  }
+}
+
+/*! Component-wise fifth order WENO interpolation of the first primitive at the cell
+    interfaces (see Interp1PrimFifthOrderWENO() for a description of the scheme and the
+    arguments), for \a NDIMS spatial dimensions and \a NVARS components. The arithmetic is
+    carried out in the same order as in Interp1PrimFifthOrderWENO(), so the results are
+    identical.
+*/
+template <int NDIMS, int NVARS>
+static int Interp1PrimFifthOrderWENOKernel(double *fI, double *fC, double *u, double *x,
+                                           int upw, int dir, void *s, void *m, int uflag)
+{
+  HyPar           *solver = (HyPar*)          s;
+  WENOParameters  *weno   = (WENOParameters*) solver->interp;
+
+  long offset = (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+  if (weno->single) {
+    Interp1PrimFifthOrderWENOLines<NDIMS,NVARS,float>(fI,fC,weno->w1s+offset,weno->w2s+offset,
+                                                      weno->w3s+offset,upw,dir,solver);
+  } else {
+    Interp1PrimFifthOrderWENOLines<NDIMS,NVARS,double>(fI,fC,weno->w1+offset,weno->w2+offset,
+                                                       weno->w3+offset,upw,dir,solver);
+  }
+
+  return(0);
+}
+
+/*! Set the kernel pointers for a given (NDIMS,NVARS) */
+#define _RHSKernelsSelect_(solver,NDIMS,NVARS) \
+  { \
+    solver->HyperbolicFluxDifference = HyperbolicFluxDifferenceKernel<NDIMS,NVARS>; \
+    if (solver->InterpolateInterfacesHyp == Interp1PrimFifthOrderWENO) \
+      solver->InterpolateInterfacesHyp = Interp1PrimFifthOrderWENOKernel<NDIMS,NVARS>; \
+  }
+
+/*! Select the compile-time specialized right-hand-side kernels for this simulation,
+    if the number of spatial dimensions and the number of solution components is one of
+    the instantiated combinations:
+    + (1,3): 1D Euler
+    + (2,4): 2D Euler/Navier-Stokes
+    + (3,5): 3D Navier-Stokes
+    + (2,3): 2D shallow water
+    + (1,1), (2,1), (3,1): scalar equations (linear advection-diffusion-reaction, Burgers, Vlasov, etc)
+
+    For any other combination, #HyPar::HyperbolicFluxDifference is left as NULL and the generic
+    loop in HyperbolicFunctionAccumulate() is used, and #HyPar::InterpolateInterfacesHyp is not changed.
+    This function must be called after the spatial discretization is chosen in InitializeSolvers().
+*/
+int RHSKernelsInitialize(void *s, /*!< Solver object of type #HyPar */
+                         void *m  /*!< MPI object of type #MPIVariables */
+                        )
+{
+  HyPar         *solver = (HyPar*) s;
+  MPIVariables  *mpi    = (MPIVariables*) m;
+
+  int ndims = solver->ndims;
+  int nvars = solver->nvars;
+
+  solver->HyperbolicFluxDifference = NULL;
+
+  if      ((ndims == 1) && (nvars == 3)) _RHSKernelsSelect_(solver,1,3)
+  else if ((ndims == 2) && (nvars == 4)) _RHSKernelsSelect_(solver,2,4)
+  else if ((ndims == 3) && (nvars == 5)) _RHSKernelsSelect_(solver,3,5)
+  else if ((ndims == 2) && (nvars == 3)) _RHSKernelsSelect_(solver,2,3)
+  else if ((ndims == 1) && (nvars == 1)) _RHSKernelsSelect_(solver,1,1)
+  else if ((ndims == 2) && (nvars == 1)) _RHSKernelsSelect_(solver,2,1)
+  else if ((ndims == 3) && (nvars == 1)) _RHSKernelsSelect_(solver,3,1)
+
+  if (!mpi->rank) {
+    if (solver->HyperbolicFluxDifference) {
+      printf("Using compile-time specialized right-hand-side kernels for ndims=%d, nvars=%d.\n",ndims,nvars);
+    } else {
+      printf("Using generic right-hand-side kernels for ndims=%d, nvars=%d.\n",ndims,nvars);
+    }
+  }
+
+  return(0);
+}
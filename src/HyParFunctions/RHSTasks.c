@@ -0,0 +1,128 @@
+/*! @file RHSTasks.c
+    @author Debojyoti Ghosh
+    @brief Set up and clean up the task-based evaluation of the hyperbolic term
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <basic.h>
+#include <math_ops.h>
+#include <arrayfunctions.h>
+#include <rhstasks.h>
+#include <mpivars.h>
+#include <hypar.h>
+
+#ifdef with_omp
+#include <omp.h>
+#endif
+
+/*! Set up the task-based evaluation of the hyperbolic term (see rhstasks.h): if the code
+    is compiled with OpenMP, more than one thread is available, and the problem is
+    multidimensional, allocate a separate set of work arrays for each dimension (except
+    the first, which uses the arrays of the solver object) and distribute the threads
+    among the dimension tasks.
+
+    The dimensions are evaluated one after the other (#HyPar::rhs_tasks is NULL) if:
+    + the spatial discretization is a compact scheme, since the interpolation then
+      involves MPI communications (tridiagonal solves) and shared work arrays;
+    + the interface eigensystem cache is enabled, since it holds one dimension at a time.
+
+    Must be called after the spatial discretization is chosen in InitializeSolvers().
+*/
+int RHSTasksInitialize(void *s, /*!< Solver object of type #HyPar */
+                       void *m  /*!< MPI object of type #MPIVariables */
+                      )
+{
+  HyPar         *solver = (HyPar*) s;
+
+  solver->rhs_tasks = NULL;
+
+#ifdef with_omp
+
+  MPIVariables  *mpi    = (MPIVariables*) m;
+  int ndims    = solver->ndims;
+  int nthreads = omp_get_max_threads();
+  int d;
+
+  if ((nthreads < 2) || (ndims < 2)) return(0);
+
+  if (solver->compact || solver->eigen_cache) {
+    if (!mpi->rank) {
+      printf("Hyperbolic term: dimensions are evaluated one at a time (%s).\n",
+             (solver->compact ? "compact scheme" : "eigen_cache is enabled"));
+    }
+    return(0);
+  }
+
+  RHSTasks *tasks = (RHSTasks*) calloc (1,sizeof(RHSTasks));
+  tasks->ntasks         = min(ndims,nthreads);
+  tasks->nthreads_inner = max(nthreads/tasks->ntasks,1);
+
+  int size_c = solver->nvars;
+  for (d = 0; d < ndims; d++) size_c *= (solver->dim_local[d]+2*solver->ghosts);
+  int size_i = solver->ndof_nodes;
+
+  tasks->work = (RHSWork*) calloc (ndims,sizeof(RHSWork));
+  tasks->hyp  = (double**) calloc (ndims,sizeof(double*));
+
+  tasks->work[0].fluxC = solver->fluxC;
+  tasks->work[0].uC    = solver->uC;
+  tasks->work[0].fluxI = solver->fluxI;
+  tasks->work[0].uL    = solver->uL;
+  tasks->work[0].uR    = solver->uR;
+  tasks->work[0].fL    = solver->fL;
+  tasks->work[0].fR    = solver->fR;
+  tasks->hyp[0]        = NULL;
+
+  /* the work arrays of a dimension are used only by the kernels along it */
+  int *dim = solver->dim_local, ghosts = solver->ghosts, nvars = solver->nvars;
+  for (d = 1; d < ndims; d++) {
+    int bounds_inter[ndims];
+    _ArrayCopy1D_(dim,bounds_inter,ndims); bounds_inter[d] += 1;
+    tasks->work[d].fluxC = ArrayAllocateGrid(size_c,ndims,dim,ghosts,nvars,d,"task fluxC");
+    tasks->work[d].uC    = ArrayAllocateGrid(size_c,ndims,dim,ghosts,nvars,d,"task uC");
+    tasks->work[d].fluxI = ArrayAllocateGrid(size_i,ndims,bounds_inter,0,nvars,d,"task fluxI");
+    tasks->work[d].uL    = ArrayAllocateGrid(size_i,ndims,bounds_inter,0,nvars,d,"task uL");
+    tasks->work[d].uR    = ArrayAllocateGrid(size_i,ndims,bounds_inter,0,nvars,d,"task uR");
+    tasks->work[d].fL    = ArrayAllocateGrid(size_i,ndims,bounds_inter,0,nvars,d,"task fL");
+    tasks->work[d].fR    = ArrayAllocateGrid(size_i,ndims,bounds_inter,0,nvars,d,"task fR");
+    tasks->hyp[d]        = ArrayAllocateGrid(size_c,ndims,dim,ghosts,nvars,d,"task hyp");
+  }
+
+  solver->rhs_tasks = tasks;
+
+  if (!mpi->rank) {
+    double mbytes = ((double)(ndims-1)) * (3.0*size_c+5.0*size_i) * sizeof(double) / (1024.0*1024.0);
+    printf("Hyperbolic term: %d concurrent dimension tasks with %d thread(s) each ",
+           tasks->ntasks, tasks->nthreads_inner);
+    printf("(additional work arrays on rank 0: %1.1f MB).\n", mbytes);
+  }
+
+#endif
+
+  return(0);
+}
+
+/*! Free the work arrays allocated in RHSTasksInitialize(). */
+int RHSTasksCleanup(void  *t,    /*!< Object of type #RHSTasks */
+                    int   ndims  /*!< Number of spatial dimensions */
+                   )
+{
+  RHSTasks *tasks = (RHSTasks*) t;
+  int d;
+
+  for (d = 1; d < ndims; d++) {
+    ArrayFree(tasks->work[d].fluxC);
+    ArrayFree(tasks->work[d].uC);
+    ArrayFree(tasks->work[d].fluxI);
+    ArrayFree(tasks->work[d].uL);
+    ArrayFree(tasks->work[d].uR);
+    ArrayFree(tasks->work[d].fL);
+    ArrayFree(tasks->work[d].fR);
+    ArrayFree(tasks->hyp[d]);
+  }
+  free(tasks->work);
+  free(tasks->hyp);
+
+  return(0);
+}
@@ -80,3 +80,33 @@ int SourceFunction(
 
   return(0);
 }
+
+/*! Add a multiple of the source term (see SourceFunction()) to a given array. If the physical
+    model does not specify a source term and there are no sponge boundaries, the source term is
+    zero and nothing is done; otherwise, it is computed in #HyPar::source (since the source
+    functions of the physical models overwrite their output array) and added to \a rhs.
+*/
+int SourceFunctionAccumulate(
+                              double  *rhs, /*!< array to which the scaled source term is added */
+                              double  a,    /*!< scaling factor */
+                              double  *u,   /*!< solution */
+                              void    *s,   /*!< solver object of type #HyPar */
+                              void    *m,   /*!< MPI object of type #MPIVariables */
+                              double  t     /*!< Current simulation time */
+                            )
+{
+  HyPar           *solver   = (HyPar*)          s;
+  DomainBoundary  *boundary = (DomainBoundary*) solver->boundary;
+  int             n, flag_sponge = 0;
+  _DECLARE_IERR_;
+
+  for (n = 0; n < solver->nBoundaryZones; n++) {
+    if (!strcmp(boundary[n].bctype,_SPONGE_)) flag_sponge = 1;
+  }
+  if ((!solver->SFunction) && (!flag_sponge)) return(0); /* zero source term */
+
+  IERR SourceFunction(solver->source,u,s,m,t); CHECKERR(ierr);
+  _ArrayAXPY_(solver->source,a,rhs,solver->ndof_cells_wghosts);
+
+  return(0);
+}
@@ -41,7 +41,8 @@ int VolumeIntegral(
     _ArrayIncrementIndex_(ndims,dim,index,done);
   }
   /* sum over all processors to get global integral of the solution */
-  IERR MPISum_double(VolumeIntegral,local_integral,nvars,&mpi->world); CHECKERR(ierr);
+  IERR MPIDiagnosticsPost(VolumeIntegral,local_integral,nvars,_MPI_DIAG_SUM_,
+                          &mpi->world,NULL,NULL); CHECKERR(ierr);
   free(local_integral);
 
   return(0);
@@ -0,0 +1,47 @@
+/*! @file InSituCleanup.c
+    @author Debojyoti Ghosh
+    @brief Close the files and free the in-situ reduced outputs
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <basic.h>
+#include <insitu.h>
+
+/*! Close the files of the in-situ reduced outputs, free the sub-communicators created
+    in InSituInitialize(), and free the arrays. */
+int InSituCleanup(void *is /*!< In-situ object of type #InSitu */)
+{
+  InSitu *insitu = (InSitu*) is;
+  int    n;
+
+  for (n = 0; n < insitu->noutputs; n++) {
+    InSituOutput *op = &insitu->output[n];
+    if (op->out) fclose(op->out);
+#ifndef serial
+    if (op->own_comm_reduce)              MPI_Comm_free(&op->comm_reduce);
+    if (op->comm_gather != MPI_COMM_NULL) MPI_Comm_free(&op->comm_gather);
+#endif
+    free(op->x);
+    free(op->index);
+    free(op->size);
+    free(op->bstart);
+    free(op->bsize);
+    free(op->bstart_all);
+    free(op->bsize_all);
+    free(op->counts);
+    free(op->displs);
+    free(op->local);
+    free(op->reduced);
+    free(op->gathered);
+    free(op->global);
+    free(op->twiddle);
+  }
+  free(insitu->output);
+  if (insitu->xg) {
+    for (n = 0; n < insitu->ndims; n++) free(insitu->xg[n]);
+    free(insitu->xg);
+  }
+
+  return(0);
+}
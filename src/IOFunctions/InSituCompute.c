@@ -0,0 +1,210 @@
+/*! @file InSituCompute.c
+    @author Debojyoti Ghosh
+    @brief Compute the in-situ reduced outputs and append them to their files
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <basic.h>
+#include <arrayfunctions.h>
+#include <mpivars.h>
+#include <insitu.h>
+#include <hypar.h>
+
+/*! Sum \a n values of \a x over the ranks of \a comm into \a y on its first rank */
+#ifndef serial
+static void InSituReduce(double *x, double *y, int n, MPI_Comm comm)
+{
+  MPI_Reduce(x,y,n,MPI_DOUBLE,MPI_SUM,0,comm);
+}
+#else
+static void InSituReduce(double *x, double *y, int n, int comm)
+{
+  _ArrayCopy1D_(x,y,n);
+}
+#endif
+
+/*! Gather the parts of the output array from the members on the writer, and copy them
+    to their location in the output array (#InSituOutput::global). */
+static void InSituGather(InSituOutput *op,    /*!< In-situ output */
+                         int          ndims,  /*!< Number of spatial dimensions */
+                         int          nvars,  /*!< Number of variables per grid point */
+                         double       *part   /*!< Part of the output array on this rank */
+                        )
+{
+  int nblock, b, v;
+  _ArrayProduct1D_(op->bsize,ndims,nblock);
+#ifndef serial
+  MPI_Gatherv(part,nblock*nvars,MPI_DOUBLE,op->gathered,op->counts,op->displs,MPI_DOUBLE,0,op->comm_gather);
+#else
+  _ArrayCopy1D_(part,op->gathered,nblock*nvars);
+#endif
+  if (!op->writer) return;
+
+  for (b = 0; b < op->nblocks; b++) {
+    int *bstart = op->bstart_all + b*ndims;
+    int *bsize  = op->bsize_all  + b*ndims;
+    int i[ndims], g[ndims], d, p, q, done = 0;
+    _ArraySetValue_(i,ndims,0);
+    while (!done) {
+      for (d = 0; d < ndims; d++) g[d] = bstart[d] + i[d];
+      _ArrayIndex1D_(ndims,op->size,g,0,p);
+      _ArrayIndex1D_(ndims,bsize,i,0,q);
+      for (v = 0; v < nvars; v++) op->global[nvars*p+v] = op->gathered[op->displs[b]+nvars*q+v];
+      _ArrayIncrementIndex_(ndims,bsize,i,done);
+    }
+  }
+}
+
+/*! Compute an in-situ output: the members compute their parts of the output array, which
+    are reduced or gathered on the writer (see InSituInitialize()). */
+static int InSituComputeOutput(InSituOutput  *op,     /*!< In-situ output */
+                               HyPar         *solver, /*!< Solver object */
+                               MPIVariables  *mpi     /*!< MPI object */
+                              )
+{
+  int     ndims       = solver->ndims;
+  int     nvars       = solver->nvars;
+  int     ghosts      = solver->ghosts;
+  int     *dim_local  = solver->dim_local;
+  int     dim         = op->dim;
+  double  *u          = solver->u;
+  int     i[ndims], d, p, q, v, n, done;
+
+  if (!strcmp(op->type,_INSITU_PROBE_)) {
+
+    if (op->writer) {
+      for (d = 0; d < ndims; d++) i[d] = op->index[d] - mpi->is[d];
+      _ArrayIndex1D_(ndims,dim_local,i,ghosts,p);
+      _ArrayCopy1D_((u+nvars*p),op->global,nvars);
+    }
+
+  } else if (!strcmp(op->type,_INSITU_SLICE_)) {
+
+    if (op->member) {
+      int is_dim = op->index[0] - mpi->is[dim];
+      done = 0; _ArraySetValue_(i,ndims,0);
+      while (!done) {
+        i[dim] = is_dim;
+        _ArrayIndex1D_(ndims,dim_local,i,ghosts,p);
+        i[dim] = 0;
+        _ArrayIndex1D_(ndims,op->bsize,i,0,q);
+        _ArrayCopy1D_((u+nvars*p),(op->local+nvars*q),nvars);
+        _ArrayIncrementIndex_(ndims,op->bsize,i,done);
+      }
+      InSituGather(op,ndims,nvars,op->local);
+    }
+
+  } else if (    (!strcmp(op->type,_INSITU_LINE_AVERAGE_))
+              || (!strcmp(op->type,_INSITU_PLANE_AVERAGE_)) ) {
+
+    int nblock, line = (!strcmp(op->type,_INSITU_LINE_AVERAGE_));
+    _ArrayProduct1D_(op->bsize,ndims,nblock);
+    _ArraySetValue_(op->local,nblock*nvars,0.0);
+    done = 0; _ArraySetValue_(i,ndims,0);
+    while (!done) {
+      _ArrayIndex1D_(ndims,dim_local,i,ghosts,p);
+      if (line) {
+        int id = i[dim];
+        i[dim] = 0;
+        _ArrayIndex1D_(ndims,op->bsize,i,0,q);
+        i[dim] = id;
+      } else q = i[dim];
+      for (v = 0; v < nvars; v++) op->local[nvars*q+v] += u[nvars*p+v];
+      _ArrayIncrementIndex_(ndims,dim_local,i,done);
+    }
+    InSituReduce(op->local,op->reduced,nblock*nvars,op->comm_reduce);
+    if (op->member) {
+      double npoints_avg = (line ? (double) solver->dim_global[dim]
+                                 : ((double) solver->npoints_global) / ((double) solver->dim_global[dim]));
+      _ArrayScale1D_(op->reduced,(1.0/npoints_avg),(nblock*nvars));
+      InSituGather(op,ndims,nvars,op->reduced);
+    }
+
+  } else if (!strcmp(op->type,_INSITU_SPECTRUM_)) {
+
+    int N = solver->dim_global[dim], nk = op->nk, nc = 2*op->nlines*nk*nvars, k;
+    int lsize[ndims];
+
+    /* partial discrete Fourier transforms of the local parts of the grid lines along dim */
+    _ArrayCopy1D_(dim_local,lsize,ndims); lsize[dim] = 1;
+    _ArraySetValue_(op->local,nc,0.0);
+    done = 0; _ArraySetValue_(i,ndims,0);
+    while (!done) {
+      int id = i[dim], j = mpi->is[dim] + i[dim], l;
+      _ArrayIndex1D_(ndims,dim_local,i,ghosts,p);
+      i[dim] = 0;
+      _ArrayIndex1D_(ndims,lsize,i,0,l);
+      i[dim] = id;
+      double *c = op->local + 2*l*nk*nvars;
+      for (k = 0; k < nk; k++) {
+        int    m  = (k*j) % N;
+        double cr = op->twiddle[2*m], ci = op->twiddle[2*m+1];
+        for (v = 0; v < nvars; v++) {
+          c[2*(k*nvars+v)  ] += cr * u[nvars*p+v];
+          c[2*(k*nvars+v)+1] -= ci * u[nvars*p+v];
+        }
+      }
+      _ArrayIncrementIndex_(ndims,dim_local,i,done);
+    }
+    InSituReduce(op->local,op->reduced,nc,op->comm_reduce);
+
+    /* energy of each wavenumber summed over the grid lines of the members (in the first
+       nk*nvars entries of the local array), summed over the members on the writer */
+    if (op->member) {
+      double *e = op->local;
+      _ArraySetValue_(e,nk*nvars,0.0);
+      for (n = 0; n < op->nlines; n++) {
+        double *c = op->reduced + 2*n*nk*nvars;
+        for (k = 0; k < nk; k++) {
+          double factor = ((k > 0) && (2*k < N) ? 2.0 : 1.0) / ((double)N * (double)N);
+          for (v = 0; v < nvars; v++) {
+            double cr = c[2*(k*nvars+v)], ci = c[2*(k*nvars+v)+1];
+            e[k*nvars+v] += factor * (cr*cr + ci*ci);
+          }
+        }
+      }
+      InSituReduce(e,op->global,nk*nvars,op->comm_gather);
+      if (op->writer) _ArrayScale1D_(op->global,(1.0/((double)op->nlines_global)),(nk*nvars));
+    }
+
+  }
+
+  return(0);
+}
+
+/*! Compute the in-situ reduced outputs (see insitu.h) of this time step, if it is one of
+    the time steps at which they are computed, and append them to their files. Called from
+    TimePostStep() after the solution is updated to the time \a t. */
+int InSituCompute(void    *s,   /*!< Solver object of type #HyPar */
+                  void    *m,   /*!< MPI object of type #MPIVariables */
+                  double  t,    /*!< Current simulation time */
+                  int     iter  /*!< Current time step (the outputs are computed if (iter+1) is
+                                     a multiple of #InSitu::frequency) */
+                 )
+{
+  HyPar         *solver = (HyPar*) s;
+  MPIVariables  *mpi    = (MPIVariables*) m;
+  InSitu        *insitu = (InSitu*) solver->insitu;
+  int           nvars   = solver->nvars, n;
+  double        bytes   = 0;
+  _DECLARE_IERR_;
+
+  if (!insitu) return(0);
+  if ((iter+1)%insitu->frequency) return(0);
+
+  MPIProfilerBegin("InSitu");
+  for (n = 0; n < insitu->noutputs; n++) {
+    InSituOutput *op = &insitu->output[n];
+    IERR InSituComputeOutput(op,solver,mpi); CHECKERR(ierr);
+    if (op->writer) {
+      fwrite(&t,sizeof(double),1,op->out);
+      fwrite(op->global,sizeof(double),op->npoints*nvars,op->out);
+      bytes += (double) (sizeof(double)*(1+op->npoints*nvars));
+    }
+  }
+  MPIProfilerEnd("InSitu",bytes);
+
+  return(0);
+}
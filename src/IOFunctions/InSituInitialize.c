@@ -0,0 +1,442 @@
+/*! @file InSituInitialize.c
+    @author Debojyoti Ghosh
+    @brief Read the in-situ reduced outputs and set up their reductions
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <basic.h>
+#include <common.h>
+#include <arrayfunctions.h>
+#include <mpivars.h>
+#include <insitu.h>
+#include <hypar.h>
+
+/*! Index of the grid point nearest to \a x among the \a n coordinates \a xg */
+static int InSituNearest(int n, double *xg, double x)
+{
+  int i, inear = 0;
+  for (i = 1; i < n; i++) if (fabs(xg[i]-x) < fabs(xg[inear]-x)) inear = i;
+  return(inear);
+}
+
+/*! Read the in-situ outputs from \b insitu.inp on rank 0 (see insitu.h), and broadcast
+    them to all the ranks. Returns a nonzero value if the file has an illegal format; if
+    it does not exist, #InSitu::noutputs is 0. */
+static int InSituReadInputs(InSitu        *insitu,  /*!< In-situ object */
+                            HyPar         *solver,  /*!< Solver object */
+                            MPIVariables  *mpi      /*!< MPI object */
+                           )
+{
+  int ndims = solver->ndims, status = 0, n;
+  _DECLARE_IERR_;
+
+  insitu->frequency = 1;
+  insitu->noutputs  = 0;
+  insitu->output    = NULL;
+
+  if (!mpi->rank) {
+
+    char filename[_MAX_STRING_SIZE_] = "insitu";
+    char filename_backup[_MAX_STRING_SIZE_] = "insitu.inp";
+    if (solver->nsims > 1) {
+      char index[_MAX_STRING_SIZE_];
+      GetStringFromInteger(solver->my_idx, index, (int)log10(solver->nsims)+1);
+      strcat(filename, "_");
+      strcat(filename, index);
+    }
+    strcat(filename, ".inp");
+
+    FILE *in = fopen(filename,"r");
+    if ((!in) && (solver->nsims > 1)) {
+      strcpy(filename, filename_backup);
+      in = fopen(filename,"r");
+    }
+
+    if (in) {
+      char word[_MAX_STRING_SIZE_];
+      int  ferr;
+      if (solver->nsims > 1) printf("Domain %d: ", solver->my_idx);
+      printf("Reading in-situ outputs from %s.\n", filename);
+      ferr = fscanf(in,"%s",word);
+      if ((ferr != 1) || strcmp(word,"begin")) {
+        fprintf(stderr,"Error: Illegal format in file \"%s\".\n",filename);
+        status = 1;
+      }
+      while (!status) {
+        ferr = fscanf(in,"%s",word);
+        if (ferr != 1) {
+          fprintf(stderr,"Error: Illegal format in file \"%s\" (missing \"end\").\n",filename);
+          status = 1;
+        } else if (!strcmp(word,"end")) {
+          break;
+        } else if (!strcmp(word,"frequency")) {
+          ferr = fscanf(in,"%d",&insitu->frequency);
+          if (ferr != 1) {
+            fprintf(stderr,"Error: missing value of \"frequency\" in file \"%s\".\n",filename);
+            status = 1;
+          }
+        } else if (    (!strcmp(word,_INSITU_PROBE_))
+                    || (!strcmp(word,_INSITU_SLICE_))
+                    || (!strcmp(word,_INSITU_PLANE_AVERAGE_))
+                    || (!strcmp(word,_INSITU_LINE_AVERAGE_))
+                    || (!strcmp(word,_INSITU_SPECTRUM_)) ) {
+          int d;
+          insitu->output = (InSituOutput*) realloc (insitu->output,(insitu->noutputs+1)*sizeof(InSituOutput));
+          InSituOutput *op = &insitu->output[insitu->noutputs];
+          memset(op,0,sizeof(InSituOutput));
+          strcpy(op->type,word);
+          op->x = (double*) calloc (ndims,sizeof(double));
+          if (!strcmp(word,_INSITU_PROBE_)) {
+            for (d = 0; d < ndims; d++) {
+              ferr = fscanf(in,"%lf",&op->x[d]); if (ferr != 1) status = 1;
+            }
+          } else {
+            ferr = fscanf(in,"%d",&op->dim); if (ferr != 1) status = 1;
+            if (!strcmp(word,_INSITU_SLICE_)) {
+              ferr = fscanf(in,"%lf",&op->x[0]); if (ferr != 1) status = 1;
+            }
+          }
+          insitu->noutputs++;
+          if (status) fprintf(stderr,"Error: incomplete entry \"%s\" in file \"%s\".\n",word,filename);
+        } else {
+          char useless[_MAX_STRING_SIZE_];
+          ferr = fscanf(in,"%s",useless);
+          printf("Warning: keyword %s in file \"%s\" with value %s not ",word,filename,useless);
+          printf("recognized or extraneous. Ignoring.\n");
+        }
+      }
+      fclose(in);
+    }
+  }
+
+  IERR MPIBroadcast_integer(&status,1,0,&mpi->world); CHECKERR(ierr);
+  if (status) return(1);
+  IERR MPIBroadcast_integer(&insitu->frequency,1,0,&mpi->world); CHECKERR(ierr);
+  IERR MPIBroadcast_integer(&insitu->noutputs ,1,0,&mpi->world); CHECKERR(ierr);
+  if (mpi->rank && insitu->noutputs) {
+    insitu->output = (InSituOutput*) calloc (insitu->noutputs,sizeof(InSituOutput));
+    for (n = 0; n < insitu->noutputs; n++) {
+      insitu->output[n].x = (double*) calloc (ndims,sizeof(double));
+    }
+  }
+  for (n = 0; n < insitu->noutputs; n++) {
+    InSituOutput *op = &insitu->output[n];
+    IERR MPIBroadcast_character(op->type,_MAX_STRING_SIZE_,0,&mpi->world); CHECKERR(ierr);
+    IERR MPIBroadcast_integer  (&op->dim,1,0,&mpi->world);                  CHECKERR(ierr);
+    IERR MPIBroadcast_double   (op->x,ndims,0,&mpi->world);                 CHECKERR(ierr);
+  }
+
+  return(0);
+}
+
+/*! Set up the reduction (or gather) of an in-situ output on its writer: find the members,
+    create the sub-communicators, and allocate the arrays. */
+static int InSituSetup(InSituOutput  *op,     /*!< In-situ output */
+                       InSitu        *insitu, /*!< In-situ object */
+                       HyPar         *solver, /*!< Solver object */
+                       MPIVariables  *mpi     /*!< MPI object */
+                      )
+{
+  int ndims       = solver->ndims;
+  int nvars       = solver->nvars;
+  int *dim_global = solver->dim_global;
+  int *dim_local  = solver->dim_local;
+  int *is         = mpi->is;
+  int dim         = op->dim;
+  int gather      = 0, d, nblock, nlocal = 0, nreduced = 0;
+
+  op->index  = (int*) calloc (ndims,sizeof(int));
+  op->size   = (int*) calloc (ndims,sizeof(int));
+  op->bstart = (int*) calloc (ndims,sizeof(int));
+  op->bsize  = (int*) calloc (ndims,sizeof(int));
+  _ArraySetValue_(op->size ,ndims,1);
+  _ArraySetValue_(op->bsize,ndims,1);
+#ifndef serial
+  op->comm_reduce     = MPI_COMM_NULL;
+  op->own_comm_reduce = 0;
+  op->comm_gather     = MPI_COMM_NULL;
+#endif
+
+  if (!strcmp(op->type,_INSITU_PROBE_)) {
+
+    /* the rank that owns the nearest grid point writes the solution there */
+    op->member = 1;
+    for (d = 0; d < ndims; d++) {
+      op->index[d] = InSituNearest(dim_global[d],insitu->xg[d],op->x[d]);
+      if ((op->index[d] < is[d]) || (op->index[d] >= is[d]+dim_local[d])) op->member = 0;
+    }
+    op->writer = op->member;
+
+  } else {
+
+    /* a plane normal to dim, or a profile along dim */
+    int plane = strcmp(op->type,_INSITU_PLANE_AVERAGE_) && strcmp(op->type,_INSITU_SPECTRUM_);
+    for (d = 0; d < ndims; d++) {
+      if ((d == dim) == plane) continue;
+      op->size[d]   = dim_global[d];
+      op->bstart[d] = is[d];
+      op->bsize[d]  = dim_local[d];
+    }
+    _ArrayProduct1D_(op->bsize,ndims,nblock);
+
+    if (!strcmp(op->type,_INSITU_SLICE_)) {
+
+      /* the ranks that own a part of the plane gather it on one of them */
+      op->index[0] = InSituNearest(dim_global[dim],insitu->xg[dim],op->x[0]);
+      op->member   = ((op->index[0] >= is[dim]) && (op->index[0] < is[dim]+dim_local[dim]));
+      nlocal       = nblock*nvars;
+      gather       = 1;
+
+    } else if (!strcmp(op->type,_INSITU_LINE_AVERAGE_)) {
+
+      /* the sums along dim are reduced along the grid lines of ranks (#MPIVariables::comm),
+         and the averages gathered from the first rank of each line */
+#ifndef serial
+      op->comm_reduce = mpi->comm[dim];
+#endif
+      op->member = (mpi->ip[dim] == 0);
+      nlocal     = nreduced = nblock*nvars;
+      gather     = 1;
+
+    } else if (!strcmp(op->type,_INSITU_PLANE_AVERAGE_)) {
+
+      /* the sums over the other dimensions are reduced over the ranks that own the same
+         part of the profile, and gathered from the first rank of each of them */
+#ifndef serial
+      int rank_reduce;
+      MPI_Comm_split(mpi->world,mpi->ip[dim],mpi->rank,&op->comm_reduce);
+      MPI_Comm_rank(op->comm_reduce,&rank_reduce);
+      op->own_comm_reduce = 1;
+      op->member = (rank_reduce == 0);
+#else
+      op->member = 1;
+#endif
+      nlocal = nreduced = nblock*nvars;
+      gather = 1;
+
+    } else if (!strcmp(op->type,_INSITU_SPECTRUM_)) {
+
+      /* the partial discrete Fourier transforms of the local parts of the grid lines along dim
+         are reduced along the grid lines of ranks (#MPIVariables::comm); the first rank of
+         each line computes the energy of its lines, and the energies are summed on the writer */
+      int N = dim_global[dim], m;
+      op->nk            = N/2 + 1;
+      op->size[dim]     = op->bsize[dim] = op->nk;
+      op->bstart[dim]   = 0;
+      op->nlines        = solver->npoints_local / dim_local[dim];
+      op->nlines_global = solver->npoints_global / dim_global[dim];
+      op->twiddle       = (double*) calloc (2*N,sizeof(double));
+      for (m = 0; m < N; m++) {
+        op->twiddle[2*m  ] = cos(2.0*(4.0*atan(1.0))*((double)m)/((double)N));
+        op->twiddle[2*m+1] = sin(2.0*(4.0*atan(1.0))*((double)m)/((double)N));
+      }
+#ifndef serial
+      op->comm_reduce = mpi->comm[dim];
+#endif
+      op->member = (mpi->ip[dim] == 0);
+      nlocal     = nreduced = 2*op->nlines*op->nk*nvars;
+
+    }
+
+#ifndef serial
+    int rank_gather;
+    MPI_Comm_split(mpi->world,(op->member ? 0 : MPI_UNDEFINED),mpi->rank,&op->comm_gather);
+    if (op->member) {
+      MPI_Comm_rank(op->comm_gather,&rank_gather);
+      op->writer = (rank_gather == 0);
+    } else op->writer = 0;
+#else
+    op->writer = op->member;
+#endif
+  }
+
+  _ArrayProduct1D_(op->size,ndims,op->npoints);
+  if (nlocal)                   op->local   = (double*) calloc (nlocal  ,sizeof(double));
+  if (nreduced && op->member)   op->reduced = (double*) calloc (nreduced,sizeof(double));
+  if (op->writer)               op->global  = (double*) calloc (op->npoints*nvars,sizeof(double));
+
+  if (gather && op->member) {
+    /* the writer needs the location of the part of the output array on each member */
+#ifndef serial
+    MPI_Comm_size(op->comm_gather,&op->nblocks);
+#else
+    op->nblocks = 1;
+#endif
+    if (op->writer) {
+      op->bstart_all = (int*) calloc (op->nblocks*ndims,sizeof(int));
+      op->bsize_all  = (int*) calloc (op->nblocks*ndims,sizeof(int));
+      op->counts     = (int*) calloc (op->nblocks,sizeof(int));
+      op->displs     = (int*) calloc (op->nblocks,sizeof(int));
+      op->gathered   = (double*) calloc (op->npoints*nvars,sizeof(double));
+    }
+#ifndef serial
+    MPI_Gather(op->bstart,ndims,MPI_INT,op->bstart_all,ndims,MPI_INT,0,op->comm_gather);
+    MPI_Gather(op->bsize ,ndims,MPI_INT,op->bsize_all ,ndims,MPI_INT,0,op->comm_gather);
+#else
+    _ArrayCopy1D_(op->bstart,op->bstart_all,ndims);
+    _ArrayCopy1D_(op->bsize ,op->bsize_all ,ndims);
+#endif
+    if (op->writer) {
+      int b;
+      for (b = 0; b < op->nblocks; b++) {
+        _ArrayProduct1D_((op->bsize_all+b*ndims),ndims,op->counts[b]);
+        op->counts[b] *= nvars;
+        op->displs[b]  = (b ? op->displs[b-1] + op->counts[b-1] : 0);
+      }
+    }
+  }
+
+  return(0);
+}
+
+/*! Open the file of an in-situ output on its writer, and write the header (see insitu.h),
+    unless a restarted simulation appends to an existing file. */
+static int InSituOpenFile(InSituOutput  *op,      /*!< In-situ output */
+                          int           k,        /*!< Index of the output */
+                          InSitu        *insitu,  /*!< In-situ object */
+                          HyPar         *solver,  /*!< Solver object */
+                          char          *filename /*!< Filename */
+                         )
+{
+  int ndims = solver->ndims, nvars = solver->nvars, d, i;
+
+  char index[_MAX_STRING_SIZE_] = "";
+  if (solver->nsims > 1) {
+    index[0] = '_';
+    GetStringFromInteger(solver->my_idx, index+1, (int)log10(solver->nsims)+1);
+  }
+  if (snprintf(filename,_MAX_STRING_SIZE_,"insitu_%d_%s%s.bin",k,op->type,index) >= _MAX_STRING_SIZE_) {
+    fprintf(stderr,"Error in InSituInitialize(): filename of in-situ output %d (%s) is too long.\n",
+            k,op->type);
+    return(1);
+  }
+  if (!op->writer) return(0);
+
+  if (solver->restart_iter > 0) {
+    op->out = fopen(filename,"rb");
+    if (op->out) {
+      fclose(op->out);
+      op->out = fopen(filename,"ab");
+      if (!op->out) {
+        fprintf(stderr,"Error in InSituInitialize(): could not open %s for appending.\n",filename);
+        return(1);
+      }
+      return(0);
+    }
+  }
+
+  op->out = fopen(filename,"wb");
+  if (!op->out) {
+    fprintf(stderr,"Error in InSituInitialize(): could not open %s for writing.\n",filename);
+    return(1);
+  }
+  fwrite(&ndims,sizeof(int),1,op->out);
+  fwrite(&nvars,sizeof(int),1,op->out);
+  fwrite(op->size,sizeof(int),ndims,op->out);
+  for (d = 0; d < ndims; d++) {
+    double *xg = insitu->xg[d];
+    if ((!strcmp(op->type,_INSITU_SPECTRUM_)) && (d == op->dim)) {
+      for (i = 0; i < op->nk; i++) {
+        double kwave = (double) i;
+        fwrite(&kwave,sizeof(double),1,op->out);
+      }
+    } else if (!strcmp(op->type,_INSITU_PROBE_)) {
+      fwrite(&xg[op->index[d]],sizeof(double),1,op->out);
+    } else if ((!strcmp(op->type,_INSITU_SLICE_)) && (d == op->dim)) {
+      fwrite(&xg[op->index[0]],sizeof(double),1,op->out);
+    } else if (op->size[d] == solver->dim_global[d]) {
+      fwrite(xg,sizeof(double),op->size[d],op->out);
+    } else {
+      double xmean = 0;
+      for (i = 0; i < solver->dim_global[d]; i++) xmean += xg[i];
+      xmean /= (double) solver->dim_global[d];
+      fwrite(&xmean,sizeof(double),1,op->out);
+    }
+  }
+  return(0);
+}
+
+/*! Read the in-situ reduced outputs from \b insitu.inp (see insitu.h), if it exists, and
+    set them up: find the ranks that compute and write each output, create the
+    sub-communicators of their reductions, and open the output files. #HyPar::insitu
+    is NULL if there are no in-situ outputs.
+
+    Must be called after the grid is set (InitialSolution()) and the sub-communicators
+    along the grid lines are created (MPICreateCommunicators()).
+*/
+int InSituInitialize(void *s, /*!< Solver object of type #HyPar */
+                     void *m  /*!< MPI object of type #MPIVariables */
+                    )
+{
+  HyPar         *solver = (HyPar*) s;
+  MPIVariables  *mpi    = (MPIVariables*) m;
+  int           ndims   = solver->ndims, ghosts = solver->ghosts;
+  int           d, i, n, offset;
+  _DECLARE_IERR_;
+
+  solver->insitu = NULL;
+
+  InSitu *insitu = (InSitu*) calloc (1,sizeof(InSitu));
+  IERR InSituReadInputs(insitu,solver,mpi); CHECKERR(ierr);
+  if (!insitu->noutputs) {
+    free(insitu);
+    return(0);
+  }
+  if (insitu->frequency < 1) {
+    if (!mpi->rank) fprintf(stderr,"Error in InSituInitialize(): frequency must be positive.\n");
+    return(1);
+  }
+  for (n = 0; n < insitu->noutputs; n++) {
+    InSituOutput *op = &insitu->output[n];
+    if (strcmp(op->type,_INSITU_PROBE_) && ((op->dim < 0) || (op->dim >= ndims))) {
+      if (!mpi->rank) {
+        fprintf(stderr,"Error in InSituInitialize(): invalid dimension %d for in-situ output %d (%s).\n",
+                op->dim,n,op->type);
+      }
+      return(1);
+    }
+  }
+  solver->insitu = insitu;
+
+  /* global grid coordinates along each dimension: the local coordinates are summed along
+     the grid lines of ranks */
+  insitu->ndims = ndims;
+  insitu->xg    = (double**) calloc (ndims,sizeof(double*));
+  offset = 0;
+  for (d = 0; d < ndims; d++) {
+    double *xl = (double*) calloc (solver->dim_global[d],sizeof(double));
+    for (i = 0; i < solver->dim_local[d]; i++) xl[mpi->is[d]+i] = solver->x[offset+ghosts+i];
+    insitu->xg[d] = (double*) calloc (solver->dim_global[d],sizeof(double));
+#ifndef serial
+    MPI_Allreduce(xl,insitu->xg[d],solver->dim_global[d],MPI_DOUBLE,MPI_SUM,mpi->comm[d]);
+#else
+    _ArrayCopy1D_(xl,insitu->xg[d],solver->dim_global[d]);
+#endif
+    free(xl);
+    offset += solver->dim_local[d] + 2*ghosts;
+  }
+
+  for (n = 0; n < insitu->noutputs; n++) {
+    InSituOutput *op = &insitu->output[n];
+    char filename[_MAX_STRING_SIZE_];
+    IERR InSituSetup(op,insitu,solver,mpi); CHECKERR(ierr);
+    IERR InSituOpenFile(op,n,insitu,solver,filename); CHECKERR(ierr);
+    if (!mpi->rank) {
+      printf("In-situ output %d: %s",n,op->type);
+      if (!strcmp(op->type,_INSITU_PROBE_)) {
+        printf(" at");
+        for (d = 0; d < ndims; d++) printf(" %1.6e",insitu->xg[d][op->index[d]]);
+      } else if (!strcmp(op->type,_INSITU_SLICE_)) {
+        printf(" normal to dimension %d at %1.6e",op->dim,insitu->xg[op->dim][op->index[0]]);
+      } else {
+        printf(" along dimension %d",op->dim);
+      }
+      printf(", written to %s every %d time step(s).\n",filename,insitu->frequency);
+    }
+  }
+
+  return(0);
+}
@@ -12,7 +12,8 @@
 #include <mpivars.h>
 #include <hypar.h>
 
-static int ReadArraywInterpSerial(int,int,int*,int*,int*,int,void*,void*,double*,double*,char*,int*);
+static int ReadArraywInterpSerial     (int,int,int*,int*,int*,int,void*,void*,double*,double*,char*,int*);
+static int ReadArraywInterpDistributed(int,int,int*,int*,int*,int,void*,void*,double*,char*,int*);
 
 /*! Read in a vector field from file: This version allows reading data with different
     dimensions than the array being read in. The data is read in and stored in a new global
@@ -20,10 +21,11 @@ static int ReadArraywInterpSerial(int,int,int*,int*,int*,int,void*,void*,double*
     Currently, the dimensions of the array to be read and the those of the actual data
     can only differ by factors that are integer powers of 2.
 
-    This is a wrapper function that calls
-    the appropriate function depending on input mode (#HyPar::input_mode).\n\n
-    The mode and type of input are specified through #HyPar::input_mode and
-    #HyPar::ip_file_type. A vector field is read from file and stored in an array.
+    This is a wrapper function that calls the appropriate function depending on the type
+    of input (#HyPar::ip_file_type): binary files are read and interpolated by all the ranks
+    (ReadArraywInterpDistributed()), while ASCII files (and grids) are read and interpolated
+    on rank 0 (ReadArraywInterpSerial()). A vector field is read from file and stored in
+    an array.
 */
 int ReadArraywInterp( int     ndims,          /*!< Number of spatial dimensions */
                       int     nvars,          /*!< Number of variables per grid point */
@@ -43,18 +45,34 @@ int ReadArraywInterp( int     ndims,          /*!< Number of spatial dimensions
   MPIVariables  *mpi    = (MPIVariables*) m;
   _DECLARE_IERR_;
 
-  int retval = ReadArraywInterpSerial(  ndims,
-                                        nvars,
-                                        dim_global,
-                                        dim_local,
-                                        dim_global_src,
-                                        ghosts,
-                                        s,
-                                        m,
-                                        x,
-                                        u,
-                                        fname_root,
-                                        read_flag );
+  int retval;
+  if (    ((!strcmp(solver->ip_file_type,"bin")) || (!strcmp(solver->ip_file_type,"binary")))
+      &&  (!x) ) {
+    retval = ReadArraywInterpDistributed( ndims,
+                                          nvars,
+                                          dim_global,
+                                          dim_local,
+                                          dim_global_src,
+                                          ghosts,
+                                          s,
+                                          m,
+                                          u,
+                                          fname_root,
+                                          read_flag );
+  } else {
+    retval = ReadArraywInterpSerial(  ndims,
+                                      nvars,
+                                      dim_global,
+                                      dim_local,
+                                      dim_global_src,
+                                      ghosts,
+                                      s,
+                                      m,
+                                      x,
+                                      u,
+                                      fname_root,
+                                      read_flag );
+  }
   if (retval) return retval;
 
   if (x) {
@@ -358,3 +376,181 @@ int ReadArraywInterpSerial( int     ndims,          /*!< Number of spatial dimen
   return(0);
 }
 
+
+/*! Read a contiguous run of \a n grid points (\a nvars values each) from a binary file,
+    starting at the offset (in number of double values) \a offset. */
+#ifndef serial
+static int ReadArraywInterpReadRun(MPI_File *in, long offset, int n, int nvars, double *buffer)
+{
+  MPI_Status status;
+  int        count;
+  MPI_File_read_at(*in,(MPI_Offset)(offset*sizeof(double)),buffer,n*nvars,MPI_DOUBLE,&status);
+  MPI_Get_count(&status,MPI_DOUBLE,&count);
+  return(count != n*nvars);
+}
+#else
+static int ReadArraywInterpReadRun(FILE *in, long offset, int n, int nvars, double *buffer)
+{
+  if (fseek(in,offset*(long)sizeof(double),SEEK_SET)) return(1);
+  return((int)fread(buffer,sizeof(double),n*nvars,in) != n*nvars);
+}
+#endif
+
+/*! Read an array in a distributed fashion: This version allows reading data with different
+    dimensions than the array being read in, like ReadArraywInterpSerial(), but no rank holds
+    a global array:
+    + Each rank computes the block of the source grid (the data in the file) that the
+      interpolation operators need to compute its part of the destination grid, i.e. its
+      local domain and a stencil halo (see InterpolateLocalSourceRange()).
+    + Each rank reads the points of this block directly from the file (with MPI-IO, or with
+      standard I/O in a serial build); along periodic dimensions, the halo is read from the
+      other side of the domain.
+    + Along non-periodic dimensions, the points of the halo outside the source grid are
+      extrapolated by the same 4th order polynomial as fillGhostCells().
+    + Each rank interpolates its block to its local domain (InterpolateLocalnDVar()) with the
+      same operators as InterpolateGlobalnDVar().
+
+    The result is thus the same as that of ReadArraywInterpSerial() (to round-off), while the
+    memory and the work on each rank are proportional to the size of its local domain.
+    Only binary files are supported (see ReadArraywInterpSerial() for the format); the grid
+    in the file is not read.
+    \n\n
+    The name of the file being read is <fname_root>.inp
+*/
+int ReadArraywInterpDistributed(int     ndims,          /*!< Number of spatial dimensions */
+                                int     nvars,          /*!< Number of variables per grid point */
+                                int     *dim_global,    /*!< Integer array of size ndims with global size in each dimension */
+                                int     *dim_local,     /*!< Integer array of size ndims with local size in each dimension */
+                                int     *dim_global_src,/*!< Integer array of size ndims with global size of the data in each dimension */
+                                int     ghosts,         /*!< Number of ghost points */
+                                void    *s,             /*!< Solver object of type #HyPar */
+                                void    *m,             /*!< MPI object of type #MPIVariables */
+                                double  *u,             /*!< Array to hold the vector field being read */
+                                char    *fname_root,    /*!< Filename root */
+                                int     *read_flag      /*!< Flag to indicate if the file was read */
+                              )
+{
+  HyPar         *solver   = (HyPar*)        s;
+  MPIVariables  *mpi      = (MPIVariables*) m;
+  int           *periodic = solver->isPeriodic;
+  int           d, done, status = 0;
+  int           is_src[ndims], dim_src[ndims], index[ndims], bounds[ndims];
+  long          size, offset_u;
+  _DECLARE_IERR_;
+
+  char filename[_MAX_STRING_SIZE_];
+  strcpy(filename,fname_root);
+  strcat(filename,".inp");
+
+  *read_flag = 0;
+  if (!mpi->rank) {
+    FILE *in; in = fopen(filename,"rb");
+    if (in) {
+      *read_flag = 1;
+      fclose(in);
+      printf("Reading array from binary file %s (Distributed mode).\n",filename);
+    }
+  }
+  IERR MPIBroadcast_integer(read_flag,1,0,&mpi->world); CHECKERR(ierr);
+  if (!(*read_flag)) return(0);
+
+  /* block of the source grid needed on this rank */
+  if (InterpolateLocalSourceBlock(ndims,dim_global,dim_global_src,mpi->is,mpi->ie,periodic,is_src,dim_src)) {
+    fprintf(stderr,"Error in ReadArraywInterpDistributed(): InterpolateLocalSourceBlock() returned with error!\n");
+    return(1);
+  }
+  size = nvars;
+  for (d = 0; d < ndims; d++) size *= dim_src[d];
+  double *u_src = (double*) calloc (size,sizeof(double));
+
+  /* read the points of the block that are inside the source grid (or the periodic images
+     of the points outside it), one contiguous run along dimension 0 at a time */
+#ifndef serial
+  MPI_File in;
+  if (MPI_File_open(mpi->world,filename,MPI_MODE_RDONLY,MPI_INFO_NULL,&in)) {
+    fprintf(stderr,"Error in ReadArraywInterpDistributed(): unable to open %s on rank %d.\n",
+            filename,mpi->rank);
+    free(u_src);
+    return(1);
+  }
+#else
+  FILE *in = fopen(filename,"rb");
+#endif
+  offset_u = 0;
+  for (d = 0; d < ndims; d++) offset_u += dim_global_src[d];
+
+  _ArrayCopy1D_(dim_src,bounds,ndims); bounds[0] = 1;
+  done = 0; _ArraySetValue_(index,ndims,0);
+  while (!done) {
+    int g[ndims], inside = 1;
+    for (d = 1; d < ndims; d++) {
+      g[d] = is_src[d] + index[d];
+      if (periodic[d]) g[d] = (g[d] + dim_global_src[d]) % dim_global_src[d];
+      else if ((g[d] < 0) || (g[d] >= dim_global_src[d])) inside = 0;
+    }
+    if (inside) {
+      int j = 0;
+      while (j < dim_src[0]) {
+        int g0 = is_src[0] + j;
+        if (periodic[0]) g0 = (g0 + dim_global_src[0]) % dim_global_src[0];
+        else if ((g0 < 0) || (g0 >= dim_global_src[0])) { j++; continue; }
+        /* extend the run while the points are contiguous in the file */
+        int n = 1;
+        while ((j+n < dim_src[0]) && (g0+n < dim_global_src[0])) {
+          int g1 = is_src[0] + j + n;
+          if (periodic[0]) g1 = (g1 + dim_global_src[0]) % dim_global_src[0];
+          if (g1 != g0+n) break;
+          n++;
+        }
+        long p; g[0] = g0;
+        _ArrayIndex1D_(ndims,dim_global_src,g,0,p);
+        int q; index[0] = j;
+        _ArrayIndex1D_(ndims,dim_src,index,0,q);
+        index[0] = 0;
+#ifndef serial
+        status += ReadArraywInterpReadRun(&in,offset_u+p*nvars,n,nvars,(u_src+q*nvars));
+#else
+        status += ReadArraywInterpReadRun(in,offset_u+p*nvars,n,nvars,(u_src+q*nvars));
+#endif
+        j += n;
+      }
+    }
+    _ArrayIncrementIndex_(ndims,bounds,index,done);
+  }
+#ifndef serial
+  MPI_File_close(&in);
+#else
+  fclose(in);
+#endif
+  if (status) {
+    fprintf(stderr,"Error in ReadArraywInterpDistributed(): unable to read data from %s on rank %d.\n",
+            filename,mpi->rank);
+    free(u_src);
+    return(1);
+  }
+
+  /* extrapolate to the points of the block outside the source grid along the non-periodic
+     dimensions (as in fillGhostCells()) */
+  InterpolateLocalExtrapolate(ndims,nvars,dim_global_src,periodic,is_src,dim_src,u_src);
+
+  /* interpolate the block to the local domain */
+  int retval = InterpolateLocalnDVar(  dim_local,
+                                      mpi->is,
+                                      dim_global,
+                                      u,
+                                      dim_src,
+                                      is_src,
+                                      dim_global_src,
+                                      u_src,
+                                      nvars,
+                                      ghosts,
+                                      ndims );
+  free(u_src);
+  if (retval) {
+    fprintf(stderr, "Error in ReadArraywInterpDistributed()\n");
+    fprintf(stderr, "  InterpolateLocalnDVar() returned with error!\n");
+    return retval;
+  }
+
+  return(0);
+}
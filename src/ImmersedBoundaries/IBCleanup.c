@@ -13,11 +13,18 @@ int IBCleanup(void *s /*!< Object of type #ImmersedBoundary */)
   ImmersedBoundary *ib = (ImmersedBoundary*) s;
   if (!ib) return(0);
 
-  free(ib->body->surface);
-  free(ib->body);
+  if (ib->body) {
+    free(ib->body->surface);
+    free(ib->body);
+  }
+  if (ib->body2d) {
+    free(ib->body2d->surface);
+    free(ib->body2d);
+  }
 
   if (ib->n_boundary_nodes > 0) free(ib->boundary);
   if (ib->nfacets_local > 0) free(ib->fmap);
+  free(ib->facet_owner);
 
   return(0);
 }
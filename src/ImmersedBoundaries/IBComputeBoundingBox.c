@@ -1,6 +1,6 @@
 /*! @file IBComputeBoundingBox.c
     @author Debojyoti Ghosh
-    @brief Compute bounding box for an immersed body
+    @brief Compute bounding boxes for immersed bodies
 */
 
 #include <immersedboundaries.h>
@@ -40,3 +40,26 @@ int IBComputeBoundingBox(Body3D *b /*!< The body */)
   }
   return(0);
 }
+
+/*! Compute the bounding box for a given 2D body. */
+int IBComputeBoundingBox2D(Body2D *b /*!< The body */)
+{
+  b->xmin = b->xmax = b->surface[0].x1;
+  b->ymin = b->ymax = b->surface[0].y1;
+
+  int n;
+  for (n = 0; n < b->nsegments; n++) {
+    if (b->surface[n].x1 < b->xmin) b->xmin = b->surface[n].x1;
+    if (b->surface[n].x2 < b->xmin) b->xmin = b->surface[n].x2;
+
+    if (b->surface[n].y1 < b->ymin) b->ymin = b->surface[n].y1;
+    if (b->surface[n].y2 < b->ymin) b->ymin = b->surface[n].y2;
+
+    if (b->surface[n].x1 > b->xmax) b->xmax = b->surface[n].x1;
+    if (b->surface[n].x2 > b->xmax) b->xmax = b->surface[n].x2;
+
+    if (b->surface[n].y1 > b->ymax) b->ymax = b->surface[n].y1;
+    if (b->surface[n].y2 > b->ymax) b->ymax = b->surface[n].y2;
+  }
+  return(0);
+}
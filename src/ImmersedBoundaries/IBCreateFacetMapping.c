@@ -137,6 +137,10 @@ static int interpNodesCoeffs(
     ("near" in terms of the local grid spacing) along the outward surface normal (i.e.,
     outside the body), and finds and stores the indices of the grid points that
     surround it, as well as the trilinear interpolation coefficients.
+  + Assigns each facet to one "owner" rank (#ImmersedBoundary::facet_owner), the lowest
+    rank on which it is a local facet. A facet whose centroid lies on the boundary between
+    subdomains is a local facet on more than one rank; quantities summed over the surface
+    (e.g., forces) or written per facet use only the local facets owned by this rank.
 
 Note: each MPI rank has a copy of the entire immersed body, i.e., all the facets.
 */
@@ -290,5 +294,16 @@ int IBCreateFacetMapping(
 
   }
 
+  /* owner of each facet: the lowest rank on which it is local */
+  int *owner = (int*) calloc (max(nfacets,1), sizeof(int));
+  _ArraySetValue_(owner,nfacets,mpi->nproc);
+  for (n = 0; n < IB->nfacets_local; n++) owner[IB->fmap[n].index] = mpi->rank;
+  IB->facet_owner = (int*) calloc (max(nfacets,1), sizeof(int));
+  MPIMin_integer(IB->facet_owner,owner,nfacets,&mpi->world);
+  for (n = 0; n < nfacets; n++) {
+    if (IB->facet_owner[n] == mpi->nproc) IB->facet_owner[n] = -1;
+  }
+  free(owner);
+
   return(0);
 }
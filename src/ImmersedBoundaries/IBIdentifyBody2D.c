@@ -0,0 +1,81 @@
+/*! @file IBIdentifyBody2D.c
+    @author Debojyoti Ghosh
+    @brief Identify grid points inside a 2D immersed body
+*/
+
+#include <stdlib.h>
+#include <basic.h>
+#include <arrayfunctions.h>
+#include <immersedboundaries.h>
+
+/*! Comparison function for sorting crossing points with qsort() */
+static int IBCompareCrossings(const void *a, const void *b)
+{
+  double xa = *((const double*) a),
+         xb = *((const double*) b);
+  return((xa > xb) - (xa < xb));
+}
+
+/*!
+  Identify the grid points of the local grid that are inside a given 2D body whose
+  surface is defined by closed curves (#Body2D). For each grid line along x, the points
+  where it crosses the body surface are computed and sorted; a grid point is inside the
+  body if an odd number of crossings lie to its left (the even-odd rule). Unlike
+  IBIdentifyBody(), this function works on the local grid only, and does not need the
+  global grid.
+*/
+int IBIdentifyBody2D(
+                      void   *ib,     /*!< Immersed boundary object of type #ImmersedBoundary */
+                      int    *dim_l,  /*!< local dimensions */
+                      int    ghosts,  /*!< number of ghost points */
+                      double *X,      /*!< Array of local spatial coordinates (with ghost points) */
+                      double *blank   /*!< Blanking array: for grid points within the
+                                           body, this value will be set to 0 */
+                    )
+{
+  ImmersedBoundary  *IB      = (ImmersedBoundary*) ib;
+  Body2D            *body    = IB->body2d;
+  Segment2D         *surface = body->surface;
+  int               ns       = body->nsegments,
+                    count    = 0, i, j, n;
+
+  double *xcross = (double*) calloc (ns,sizeof(double));
+
+  for (j = 0; j < dim_l[1]; j++) {
+    double y;
+    _GetCoordinate_(1,j,dim_l,ghosts,X,y);
+    if ((y < body->ymin) || (y > body->ymax)) continue;
+
+    /* find the crossings of this grid line with the body surface; a segment is
+       crossed if its end points are on either side of the line (the upper end point
+       is excluded so that a vertex on the line is counted once) */
+    int ncross = 0;
+    for (n = 0; n < ns; n++) {
+      double y1 = surface[n].y1, y2 = surface[n].y2;
+      if ((y1 <= y) != (y2 <= y)) {
+        xcross[ncross] = surface[n].x1 + (y-y1) * (surface[n].x2-surface[n].x1) / (y2-y1);
+        ncross++;
+      }
+    }
+    if (!ncross) continue;
+    qsort(xcross,ncross,sizeof(double),IBCompareCrossings);
+
+    int c = 0;
+    for (i = 0; i < dim_l[0]; i++) {
+      double x;
+      _GetCoordinate_(0,i,dim_l,ghosts,X,x);
+      while ((c < ncross) && (xcross[c] < x)) c++;
+      if (c%2) {
+        int index[_IB_NDIMS_2D_], p;
+        index[0] = i;
+        index[1] = j;
+        _ArrayIndex1D_(_IB_NDIMS_2D_,dim_l,index,ghosts,p);
+        blank[p] = 0;
+        count++;
+      }
+    }
+  }
+
+  free(xcross);
+  return(count);
+}
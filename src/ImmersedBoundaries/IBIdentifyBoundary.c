@@ -8,79 +8,66 @@
 #include <mpivars.h>
 #include <immersedboundaries.h>
 
+/*! Check if a grid point inside the immersed body is within stencil-width-distance
+    of a grid point outside the body along any dimension.
+*/
+static int IsBoundaryPoint(
+                            int     ndims,  /*!< Number of spatial dimensions */
+                            int     *dim,   /*!< Local grid size in each dimension */
+                            int     *indexC,/*!< Index of the grid point */
+                            int     ghosts, /*!< Number of ghost points */
+                            double  *blank  /*!< blanking array where entries are zero
+                                                 for grid points inside, and one for
+                                                 grid points outside. */
+                          )
+{
+  int indexN[ndims], d, g, q, flag = 0;
+  for (g = 1; g <= ghosts; g++){
+    for (d = 0; d < ndims; d++) {
+
+      _ArrayCopy1D_(indexC,indexN,ndims); indexN[d] += g;
+      _ArrayIndex1D_(ndims,dim,indexN,ghosts,q);
+      if (blank[q])  flag = 1;
+
+      _ArrayCopy1D_(indexC,indexN,ndims); indexN[d] -= g;
+      _ArrayIndex1D_(ndims,dim,indexN,ghosts,q);
+      if (blank[q])  flag = 1;
+
+    }
+  }
+  return(flag);
+}
+
 /*! Count the number of immersed boundary points: boundary points are those
     grid points inside the immersed body that are within stencil-width-distance of
     a grid point outside the body.
 */
 static int CountBoundaryPoints(
-                                int     imax,   /*!< Number of grid points in x */
-                                int     jmax,   /*!< Number of grid points in y */
-                                int     kmax,   /*!< Number of grid points in z */
+                                int     ndims,  /*!< Number of spatial dimensions */
+                                int     *dim,   /*!< Local grid size in each dimension */
                                 int     ghosts, /*!< Number of ghost points */
                                 double  *blank  /*!< blanking array where entries are zero
                                                      for grid points inside, and one for
                                                      grid points outside. */
                               )
 {
-  static int dim[_IB_NDIMS_], indexC[_IB_NDIMS_], indexN[_IB_NDIMS_],
-             i, j, k, p, q, count;
-  dim[0] = imax;
-  dim[1] = jmax;
-  dim[2] = kmax;
-
-  count = 0;
-  for (i = 0; i < imax; i++) {
-    for (j = 0; j < jmax; j++) {
-      for (k = 0; k < kmax; k++) {
-        indexC[0] = i;
-        indexC[1] = j;
-        indexC[2] = k;
-        _ArrayIndex1D_(_IB_NDIMS_,dim,indexC,ghosts,p);
-        /* if this point is inside the body (0), find out if any */
-        /* of the neighboring points are outside (1)              */
-        if (!blank[p]){
-
-          int g, flag = 0;
-          for (g = 1; g <= ghosts; g++){
-
-            _ArrayCopy1D_(indexC,indexN,_IB_NDIMS_); indexN[0] += g;
-            _ArrayIndex1D_(_IB_NDIMS_,dim,indexN,ghosts,q);
-            if (blank[q])  flag = 1;
-
-            _ArrayCopy1D_(indexC,indexN,_IB_NDIMS_); indexN[0] -= g;
-            _ArrayIndex1D_(_IB_NDIMS_,dim,indexN,ghosts,q);
-            if (blank[q])  flag = 1;
-
-            _ArrayCopy1D_(indexC,indexN,_IB_NDIMS_); indexN[1] += g;
-            _ArrayIndex1D_(_IB_NDIMS_,dim,indexN,ghosts,q);
-            if (blank[q])  flag = 1;
-
-            _ArrayCopy1D_(indexC,indexN,_IB_NDIMS_); indexN[1] -= g;
-            _ArrayIndex1D_(_IB_NDIMS_,dim,indexN,ghosts,q);
-            if (blank[q])  flag = 1;
-
-            _ArrayCopy1D_(indexC,indexN,_IB_NDIMS_); indexN[2] += g;
-            _ArrayIndex1D_(_IB_NDIMS_,dim,indexN,ghosts,q);
-            if (blank[q])  flag = 1;
-
-            _ArrayCopy1D_(indexC,indexN,_IB_NDIMS_); indexN[2] -= g;
-            _ArrayIndex1D_(_IB_NDIMS_,dim,indexN,ghosts,q);
-            if (blank[q])  flag = 1;
-
-          }
-          if (flag)   count++;
-        }
-      }
-    }
+  int indexC[ndims], p, count = 0, done = 0;
+
+  _ArraySetValue_(indexC,ndims,0);
+  while (!done) {
+    _ArrayIndex1D_(ndims,dim,indexC,ghosts,p);
+    /* if this point is inside the body (0), find out if any */
+    /* of the neighboring points are outside (1)              */
+    if ((!blank[p]) && IsBoundaryPoint(ndims,dim,indexC,ghosts,blank)) count++;
+    _ArrayIncrementIndex_(ndims,dim,indexC,done);
   }
   return(count);
 }
 
 /*! Set the indices of the immersed boundary points.*/
 static int SetBoundaryPoints(
-                                int     imax,     /*!< Number of grid points in x */
-                                int     jmax,     /*!< Number of grid points in y */
-                                int     kmax,     /*!< Number of grid points in z */
+                                int     ndims,    /*!< Number of spatial dimensions */
+                                int     *dim,     /*!< Local grid size in each dimension */
                                 int     ghosts,   /*!< Number of ghost points */
                                 double  *blank,   /*!< blanking array where entries are zero
                                                      for grid points inside, and one for
@@ -89,69 +76,29 @@ static int SetBoundaryPoints(
                             )
 {
   IBNode *boundary = (IBNode*) b;
-  static int dim[_IB_NDIMS_], indexC[_IB_NDIMS_], indexN[_IB_NDIMS_],
-             i, j, k, p, q, count;
-  dim[0] = imax;
-  dim[1] = jmax;
-  dim[2] = kmax;
-
-  count = 0;
-  for (i = 0; i < imax; i++) {
-    for (j = 0; j < jmax; j++) {
-      for (k = 0; k < kmax; k++) {
-        indexC[0] = i;
-        indexC[1] = j;
-        indexC[2] = k;
-        _ArrayIndex1D_(_IB_NDIMS_,dim,indexC,ghosts,p);
-        /* if this point is inside the body (0), find out if any */
-        /* of the neighboring points are outside (1)              */
-        if (!blank[p]){
-
-          int g, flag = 0;
-          for (g = 1; g <= ghosts; g++){
-
-            _ArrayCopy1D_(indexC,indexN,_IB_NDIMS_); indexN[0] += g;
-            _ArrayIndex1D_(_IB_NDIMS_,dim,indexN,ghosts,q);
-            if (blank[q])  flag = 1;
-
-            _ArrayCopy1D_(indexC,indexN,_IB_NDIMS_); indexN[0] -= g;
-            _ArrayIndex1D_(_IB_NDIMS_,dim,indexN,ghosts,q);
-            if (blank[q])  flag = 1;
-
-            _ArrayCopy1D_(indexC,indexN,_IB_NDIMS_); indexN[1] += g;
-            _ArrayIndex1D_(_IB_NDIMS_,dim,indexN,ghosts,q);
-            if (blank[q])  flag = 1;
-
-            _ArrayCopy1D_(indexC,indexN,_IB_NDIMS_); indexN[1] -= g;
-            _ArrayIndex1D_(_IB_NDIMS_,dim,indexN,ghosts,q);
-            if (blank[q])  flag = 1;
-
-            _ArrayCopy1D_(indexC,indexN,_IB_NDIMS_); indexN[2] += g;
-            _ArrayIndex1D_(_IB_NDIMS_,dim,indexN,ghosts,q);
-            if (blank[q])  flag = 1;
-
-            _ArrayCopy1D_(indexC,indexN,_IB_NDIMS_); indexN[2] -= g;
-            _ArrayIndex1D_(_IB_NDIMS_,dim,indexN,ghosts,q);
-            if (blank[q])  flag = 1;
-
-          }
-          if (flag) {
-            boundary[count].i = i;
-            boundary[count].j = j;
-            boundary[count].k = k;
-            boundary[count].p = p;
-            count++;
-          }
-        }
-      }
+  int indexC[ndims], p, count = 0, done = 0;
+
+  _ArraySetValue_(indexC,ndims,0);
+  while (!done) {
+    _ArrayIndex1D_(ndims,dim,indexC,ghosts,p);
+    /* if this point is inside the body (0), find out if any */
+    /* of the neighboring points are outside (1)              */
+    if ((!blank[p]) && IsBoundaryPoint(ndims,dim,indexC,ghosts,blank)) {
+      boundary[count].i = indexC[0];
+      boundary[count].j = indexC[1];
+      boundary[count].k = (ndims > 2 ? indexC[2] : 0);
+      boundary[count].p = p;
+      count++;
     }
+    _ArrayIncrementIndex_(ndims,dim,indexC,done);
   }
   return(count);
 }
 
 /*! Identify the immersed boundary points: an immersed boundary point is any grid point
     inside the immersed body that is within stencil-width-distance of a grid point outside
-    the immersed body. This function does the following:
+    the immersed body. This function works for both 2D and 3D immersed bodies
+    (#ImmersedBoundary::ndims), and does the following:
     + count the number of immersed boundary points.
     + allocate the array of immersed boundary points and set their indices.
 */
@@ -166,18 +113,14 @@ int IBIdentifyBoundary(
 {
   ImmersedBoundary  *IB     = (ImmersedBoundary*) ib;
   MPIVariables      *mpi    = (MPIVariables*) m;
-  Body3D            *body   = IB->body;
-
-  int imax = dim_l[0],
-      jmax = dim_l[1],
-      kmax = dim_l[2];
+  int               ndims   = IB->ndims;
 
-  int n_boundary_nodes = CountBoundaryPoints(imax,jmax,kmax,ghosts,blank);
+  int n_boundary_nodes = CountBoundaryPoints(ndims,dim_l,ghosts,blank);
   IB->n_boundary_nodes = n_boundary_nodes;
   if (n_boundary_nodes == 0) IB->boundary = NULL;
   else {
     IB->boundary = (IBNode*) calloc (n_boundary_nodes, sizeof(IBNode));
-    int check = SetBoundaryPoints(imax,jmax,kmax,ghosts,blank,IB->boundary);
+    int check = SetBoundaryPoints(ndims,dim_l,ghosts,blank,IB->boundary);
     if (check != n_boundary_nodes) {
       fprintf(stderr,"Error in IBIdentifyBoundary(): Inconsistency encountered when setting boundary indices. ");
       fprintf(stderr,"on rank %d.\n",mpi->rank);
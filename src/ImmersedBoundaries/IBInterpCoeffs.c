@@ -45,7 +45,7 @@ int IBInterpCoeffs(
       js = mpi->is[1],
       ks = mpi->is[2];
 
-  static int index[_IB_NDIMS_];
+  int        index[_IB_NDIMS_];
 
   int dg;
   for (dg = 0; dg < n_boundary; dg++) {
@@ -0,0 +1,181 @@
+/*! @file IBInterpCoeffs2D.c
+    @brief Compute interpolation nodes and coefficients for immersed boundary points of a 2D body.
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <basic.h>
+#include <arrayfunctions.h>
+#include <mathfunctions.h>
+#include <mpivars.h>
+#include <immersedboundaries.h>
+
+/*!
+  Compute the interpolation nodes and coefficients for immersed boundary points of a 2D
+  body. This is the 2D analog of IBInterpCoeffs(): For each immersed boundary point, do the
+  following:
+  + From the immersed boundary point, extend a probe in the direction defined by the outward
+    normal of the "nearest" segment (computed in IBNearestSegmentNormal()), till the probe tip
+    reaches a point in space such that all surrounding (#_IB_NNODES_2D_) grid points are
+    "interior" points, i.e., outside the immersed body.
+  + Store the indices of the surrounding grid points, as well as the bilinear interpolation
+    coefficients to interpolate a variable from the surrounding points to the probe tip, in
+    the first #_IB_NNODES_2D_ entries of #IBNode::interp_nodes and #IBNode::interp_coeffs.
+*/
+int IBInterpCoeffs2D(
+                      void    *ib,    /*!< Immersed boundary object of type #ImmersedBoundary */
+                      void    *m,     /*!< MPI object of type #MPIVariables */
+                      double  *X,     /*!< Array of (local) spatial coordinates */
+                      int     *dim_l, /*!< Integer array of local grid size in each spatial dimension */
+                      int     ghosts, /*!< Number of ghost points */
+                      double  *blank  /*!< Blanking array: for grid points within the
+                                           body, this value will be set to 0 */
+                    )
+{
+  ImmersedBoundary  *IB       = (ImmersedBoundary*) ib;
+  MPIVariables      *mpi      = (MPIVariables*) m;
+  IBNode            *boundary = IB->boundary;
+
+  double  eps         = IB->tolerance;
+  int     maxiter     = IB->itr_max,
+          n_boundary  = IB->n_boundary_nodes;
+
+  int imax        = dim_l[0],
+      jmax        = dim_l[1];
+
+  int        index[_IB_NDIMS_2D_];
+
+  int dg;
+  for (dg = 0; dg < n_boundary; dg++) {
+    int    i, j;
+    double xb, yb;
+    double nx, ny;
+    double xx, yy;
+    double dx, dy;
+    double ds, dist;
+    double xtip, ytip;
+
+    i = boundary[dg].i;
+    j = boundary[dg].j;
+
+    xb = boundary[dg].x;
+    yb = boundary[dg].y;
+
+    nx = boundary[dg].segment->nx;
+    ny = boundary[dg].segment->ny;
+    xx = boundary[dg].segment->x1;
+    yy = boundary[dg].segment->y1;
+
+    dist = nx*(xx-xb) + ny*(yy-yb);
+
+    double x1, x2, y1, y2;
+    _GetCoordinate_(0,(i+1),dim_l,ghosts,X,x1);
+    _GetCoordinate_(0,(i-1),dim_l,ghosts,X,x2);
+    _GetCoordinate_(1,(j+1),dim_l,ghosts,X,y1);
+    _GetCoordinate_(1,(j-1),dim_l,ghosts,X,y2);
+    dx = 0.5 * (x1 - x2);
+    dy = 0.5 * (y1 - y2);
+    ds = min(dx, dy);
+
+    xtip = xb + dist*nx;
+    ytip = yb + dist*ny;
+
+    int is_it_in = 0;
+    int iter = 0;
+    int itip, jtip;
+    while(!is_it_in && (iter < maxiter)) {
+      iter++;
+      itip = i;
+      jtip = j;
+
+      if (xtip > xb)  {
+        double xx;
+        _GetCoordinate_(0,itip,dim_l,ghosts,X,xx);
+        while ((xx < xtip) && (itip < imax+ghosts-1)) {
+          itip++;
+          _GetCoordinate_(0,itip,dim_l,ghosts,X,xx);
+        }
+      }  else {
+        double xx;
+        _GetCoordinate_(0,(itip-1),dim_l,ghosts,X,xx);
+        while ((xx > xtip) && (itip > -ghosts)) {
+          itip--;
+          _GetCoordinate_(0,(itip-1),dim_l,ghosts,X,xx);
+        }
+      }
+
+      if (ytip > yb) {
+        double yy;
+        _GetCoordinate_(1,jtip,dim_l,ghosts,X,yy);
+        while ((yy < ytip) && (jtip < jmax+ghosts-1)) {
+          jtip++;
+          _GetCoordinate_(1,jtip,dim_l,ghosts,X,yy);
+        }
+      } else {
+        double yy;
+        _GetCoordinate_(1,(jtip-1),dim_l,ghosts,X,yy);
+        while ((yy > ytip) && (jtip > -ghosts)) {
+          jtip--;
+          _GetCoordinate_(1,(jtip-1),dim_l,ghosts,X,yy);
+        }
+      }
+
+      int ptip[_IB_NNODES_2D_];
+      index[0] = itip  ; index[1] = jtip  ; _ArrayIndex1D_(_IB_NDIMS_2D_,dim_l,index,ghosts,ptip[0]);
+      index[0] = itip-1; index[1] = jtip  ; _ArrayIndex1D_(_IB_NDIMS_2D_,dim_l,index,ghosts,ptip[1]);
+      index[0] = itip  ; index[1] = jtip-1; _ArrayIndex1D_(_IB_NDIMS_2D_,dim_l,index,ghosts,ptip[2]);
+      index[0] = itip-1; index[1] = jtip-1; _ArrayIndex1D_(_IB_NDIMS_2D_,dim_l,index,ghosts,ptip[3]);
+
+      int nflow = 0;
+      nflow += blank[ptip[0]];
+      nflow += blank[ptip[1]];
+      nflow += blank[ptip[2]];
+      nflow += blank[ptip[3]];
+      if (nflow == _IB_NNODES_2D_) {
+        is_it_in = 1;
+      } else if (nflow < _IB_NNODES_2D_) {
+        is_it_in = 0;
+        xtip += nx*absolute(ds);
+        ytip += ny*absolute(ds);
+      } else {
+        fprintf(stderr,"Error in IBInterpCoeffs2D() (Bug in code) - counting interior points surrounding probe tip \n");
+        fprintf(stderr,"on rank %d.\n", mpi->rank);
+        fprintf(stderr,"Value of nflow is %d but can only be positive and <= %d.\n",nflow,_IB_NNODES_2D_);
+        return(1);
+      }
+    }
+
+    if (!is_it_in) {
+      fprintf(stderr,"Error in IBInterpCoeffs2D() on rank %d - interior point not found for immersed boundary point (%d,%d)!\n",
+              mpi->rank, i, j);
+      return(1);
+    }
+
+    double tlx[2],tly[2];
+    _GetCoordinate_(0,(itip-1),dim_l,ghosts,X,tlx[0]);
+    _GetCoordinate_(0,(itip  ),dim_l,ghosts,X,tlx[1]);
+    _GetCoordinate_(1,(jtip-1),dim_l,ghosts,X,tly[0]);
+    _GetCoordinate_(1,(jtip  ),dim_l,ghosts,X,tly[1]);
+
+    int ptip[_IB_NNODES_2D_];
+    index[0]=itip-1; index[1]=jtip-1; _ArrayIndex1D_(_IB_NDIMS_2D_,dim_l,index,ghosts,ptip[0]);
+    index[0]=itip  ; index[1]=jtip-1; _ArrayIndex1D_(_IB_NDIMS_2D_,dim_l,index,ghosts,ptip[1]);
+    index[0]=itip-1; index[1]=jtip  ; _ArrayIndex1D_(_IB_NDIMS_2D_,dim_l,index,ghosts,ptip[2]);
+    index[0]=itip  ; index[1]=jtip  ; _ArrayIndex1D_(_IB_NDIMS_2D_,dim_l,index,ghosts,ptip[3]);
+    _ArrayCopy1D_(ptip,boundary[dg].interp_nodes,_IB_NNODES_2D_);
+
+    double coeffs[_IB_NNODES_2D_];
+    BilinearInterpCoeffs(tlx[0],tlx[1],tly[0],tly[1],xtip,ytip,&coeffs[0]);
+    _ArrayCopy1D_(coeffs,boundary[dg].interp_coeffs,_IB_NNODES_2D_);
+
+    double tipdist = absolute(nx*(xx-xtip) + ny*(yy-ytip));
+    boundary[dg].interp_node_distance = tipdist;
+    boundary[dg].surface_distance = absolute(dist);
+    if (tipdist < eps) {
+      fprintf(stderr,"Warning in IBInterpCoeffs2D() on rank %d - how can probe tip be on surface? Tipdist = %e\n",
+              mpi->rank,tipdist);
+    }
+
+  }
+  return(0);
+}
@@ -0,0 +1,96 @@
+/*! @file IBNearestSegmentNormal.c
+    @brief Find the nearest segment of a 2D body for immersed boundary points.
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <basic.h>
+#include <mathfunctions.h>
+#include <mpivars.h>
+#include <immersedboundaries.h>
+
+/*! For each immersed boundary point, find the nearest segment (#Segment2D) of the 2D
+    immersed body (#ImmersedBoundary::body2d). This is the 2D analog of
+    IBNearestFacetNormal(): the "nearest" segment is the one which is closest to the
+    boundary point in terms of the distance along the normal defined for that segment.
+    + The function will first try to find the nearest segment for which a line starting
+      from the boundary point along the direction defined by the segment normal passes
+      through that segment.
+    + Failing the above criterion, the function will find the nearest segment.
+
+    The boundary points are inside the body, and the segment normals computed in
+    IBReadBody2D() point outward, so only segments with a non-positive normal distance
+    are considered.
+*/
+int IBNearestSegmentNormal(
+                            void    *ib, /*!< Immersed boundary object of type #ImmersedBoundary */
+                            void    *m,  /*!< MPI object of type #MPIVariables */
+                            double  *X,  /*!< Array of (local) spatial coordinates */
+                            double  large_distance, /*!< A large distance */
+                            int     *dim_l, /*!< Integer array of local grid size in each spatial dimension */
+                            int     ghosts /*!< Number of ghost points */
+                          )
+{
+  ImmersedBoundary  *IB       = (ImmersedBoundary*) ib;
+  MPIVariables      *mpi      = (MPIVariables*) m;
+  Body2D            *body     = IB->body2d;
+  Segment2D         *surface  = body->surface;
+  IBNode            *boundary = IB->boundary;
+
+  double  eps = IB->tolerance;
+  int     nb  = IB->n_boundary_nodes,
+          ns  = body->nsegments;
+
+  int i, j, dg, n;
+  for (dg = 0; dg < nb; dg++) {
+    i = boundary[dg].i;
+    j = boundary[dg].j;
+
+    double xp, yp;
+    _GetCoordinate_(0,i,dim_l,ghosts,X,xp);
+    _GetCoordinate_(1,j,dim_l,ghosts,X,yp);
+    boundary[dg].x = xp;
+    boundary[dg].y = yp;
+    boundary[dg].z = 0;
+
+    double  dist_min = large_distance;
+    int     n_min    = -1;
+
+    for (n = 0; n < ns; n++) {
+      double dist =   surface[n].nx*(xp-surface[n].x1)
+                    + surface[n].ny*(yp-surface[n].y1);
+      if (dist > 0)  continue;
+      if (absolute(dist) < dist_min) {
+        /* parameter of the foot of the normal on the segment */
+        double dx = surface[n].x2 - surface[n].x1,
+               dy = surface[n].y2 - surface[n].y1;
+        double t  = ((xp-surface[n].x1)*dx + (yp-surface[n].y1)*dy) / (dx*dx + dy*dy);
+        if ((t > -eps) && (t < 1+eps)) {
+          dist_min = absolute(dist);
+          n_min = n;
+        }
+      }
+    }
+    if (n_min == -1) {
+      for (n = 0; n < ns; n++) {
+        double dist =   surface[n].nx*(xp-surface[n].x1)
+                      + surface[n].ny*(yp-surface[n].y1);
+        if (dist > eps)  continue;
+        else {
+          if (absolute(dist) < dist_min) {
+            dist_min = absolute(dist);
+            n_min = n;
+          }
+        }
+      }
+    }
+
+    if (n_min == -1)  {
+      fprintf(stderr,"Error in IBNearestSegmentNormal(): no nearest normal found for boundary node (%d,%d) ",i,j);
+      fprintf(stderr,"on rank %d.\n",mpi->rank);
+      return(1);
+    } else boundary[dg].segment = &surface[n_min];
+  }
+
+  return(0);
+}
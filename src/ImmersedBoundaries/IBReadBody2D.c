@@ -0,0 +1,174 @@
+/*! @file IBReadBody2D.c
+    @author Debojyoti Ghosh
+    @brief Reads a 2D body surface from a file of closed curves
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <basic.h>
+#include <mpivars.h>
+#include <immersedboundaries.h>
+
+/*! Function to read a 2D body, defined by one or more closed curves, from an ASCII
+    file. The format of the file is:\n
+    \n
+        ncurves
+        npoints (of curve 1)
+        x_1 y_1
+        x_2 y_2
+        ...
+        npoints (of curve 2)
+        ...
+    \n
+    Each curve is a closed polyline through its points (the last point is joined to the
+    first; it should not be repeated), and each of its segments becomes a #Segment2D.
+    \b Notes:
+    + The curves must be simple (not self-intersecting) and disjoint, and no curve may
+      lie inside another one, i.e., each curve is the boundary of a separate solid.
+    + The points may be listed in either direction; each curve is oriented counter-clockwise
+      so that the outward normal of a segment from (x1,y1) to (x2,y2) is (y2-y1,x1-x2)
+      normalized.
+    + The body read from this file is distributed to all MPI ranks.
+*/
+int IBReadBody2D(
+                  Body2D **body,    /*!< 2D body to be allocated and read from file */
+                  char   *filename, /*!< Filename */
+                  void   *m,        /*!< MPI object of type #MPIVariables */
+                  int    *stat      /*!< Status (0: success; non-0: failure) */
+                )
+{
+  MPIVariables  *mpi = (MPIVariables*) m;
+  int n;
+  *stat = 0;
+
+  if ((*body) != NULL) {
+    if (!mpi->rank) {
+      fprintf(stderr,"Error in IBReadBody2D(): pointer to immersed body not NULL.\n");
+    }
+    *stat = -1;
+    return(0);
+  }
+
+  /* Rank 0 reads in file */
+  if (!mpi->rank) {
+
+    FILE *in;
+    in = fopen(filename,"r");
+    if (!in) {
+      fprintf(stderr,"Error in IBReadBody2D(): file %s not found or cannot be opened.\n",
+              filename);
+      *stat = 1;
+    } else {
+
+      int ncurves = 0, c, nsegments = 0, nalloc = 0;
+      Segment2D *surface = NULL;
+
+      if ((fscanf(in,"%d",&ncurves) != 1) || (ncurves <= 0)) {
+        fprintf(stderr,"Error in IBReadBody2D(): invalid number of curves in %s.\n",filename);
+        *stat = 1;
+      }
+      for (c = 0; (c < ncurves) && (!(*stat)); c++) {
+        int npoints = 0;
+        if ((fscanf(in,"%d",&npoints) != 1) || (npoints < 3)) {
+          fprintf(stderr,"Error in IBReadBody2D(): curve %d in %s must have at least 3 points.\n",
+                  c,filename);
+          *stat = 1;
+          break;
+        }
+        double *xc = (double*) calloc (npoints,sizeof(double));
+        double *yc = (double*) calloc (npoints,sizeof(double));
+        for (n = 0; n < npoints; n++) {
+          if (fscanf(in,"%lf %lf",&xc[n],&yc[n]) != 2) {
+            fprintf(stderr,"Error in IBReadBody2D(): unable to read point %d of curve %d in %s.\n",
+                    n,c,filename);
+            *stat = 1;
+            break;
+          }
+        }
+
+        if (!(*stat)) {
+          /* orient the curve counter-clockwise (positive signed area) */
+          double area = 0;
+          for (n = 0; n < npoints; n++) {
+            int n2 = (n+1)%npoints;
+            area += (xc[n]*yc[n2] - xc[n2]*yc[n]);
+          }
+          int reverse = (area < 0);
+
+          if (nsegments+npoints > nalloc) {
+            nalloc  = nsegments+npoints;
+            surface = (Segment2D*) realloc (surface,nalloc*sizeof(Segment2D));
+          }
+          for (n = 0; n < npoints; n++) {
+            int n1 = (reverse ? npoints-1-n : n);
+            int n2 = (reverse ? (2*npoints-2-n)%npoints : (n+1)%npoints);
+            Segment2D *seg = &surface[nsegments];
+            seg->x1 = xc[n1]; seg->y1 = yc[n1];
+            seg->x2 = xc[n2]; seg->y2 = yc[n2];
+            double len = sqrt((seg->x2-seg->x1)*(seg->x2-seg->x1) + (seg->y2-seg->y1)*(seg->y2-seg->y1));
+            if (len == 0) continue; /* skip repeated points */
+            seg->nx =  (seg->y2-seg->y1) / len;
+            seg->ny = -(seg->x2-seg->x1) / len;
+            nsegments++;
+          }
+        }
+        free(xc);
+        free(yc);
+      }
+      fclose(in);
+
+      if ((!(*stat)) && (nsegments < 3)) {
+        fprintf(stderr,"Error in IBReadBody2D(): nsegments = %d!!\n",nsegments);
+        *stat = 1;
+      }
+      if (!(*stat)) {
+        (*body) = (Body2D*) calloc (1,sizeof(Body2D));
+        (*body)->nsegments = nsegments;
+        (*body)->surface   = surface;
+      } else free(surface);
+
+    }
+  }
+  MPIBroadcast_integer(stat,1,0,&mpi->world);
+
+  if ((*stat)) return(0);
+
+  /* Distribute the body to all MPI ranks */
+  int nsegments;
+  if (!mpi->rank) nsegments = (*body)->nsegments;
+  MPIBroadcast_integer(&nsegments,1,0,&mpi->world);
+
+  if (mpi->rank) {
+    (*body) = (Body2D*) calloc (1,sizeof(Body2D));
+    (*body)->nsegments = nsegments;
+    (*body)->surface   = (Segment2D*) calloc (nsegments,sizeof(Segment2D));
+  }
+
+  int bufdim = 6;
+  double *buffer = (double*) calloc (bufdim*nsegments,sizeof(double));
+  if (!mpi->rank) {
+    for (n=0; n<nsegments; n++) {
+      buffer[n*bufdim+0] = (*body)->surface[n].x1;
+      buffer[n*bufdim+1] = (*body)->surface[n].x2;
+      buffer[n*bufdim+2] = (*body)->surface[n].y1;
+      buffer[n*bufdim+3] = (*body)->surface[n].y2;
+      buffer[n*bufdim+4] = (*body)->surface[n].nx;
+      buffer[n*bufdim+5] = (*body)->surface[n].ny;
+    }
+  }
+  MPIBroadcast_double(buffer,(nsegments*bufdim),0,&mpi->world);
+  if (mpi->rank) {
+    for (n=0; n<nsegments; n++) {
+      (*body)->surface[n].x1 = buffer[n*bufdim+0];
+      (*body)->surface[n].x2 = buffer[n*bufdim+1];
+      (*body)->surface[n].y1 = buffer[n*bufdim+2];
+      (*body)->surface[n].y2 = buffer[n*bufdim+3];
+      (*body)->surface[n].nx = buffer[n*bufdim+4];
+      (*body)->surface[n].ny = buffer[n*bufdim+5];
+    }
+  }
+  free(buffer);
+
+  return(0);
+}
@@ -0,0 +1,123 @@
+/*! @file EigenCache.c
+    @brief Compute, query and invalidate the interface eigensystem cache
+    @author Debojyoti Ghosh
+*/
+
+#include <stdlib.h>
+#include <basic.h>
+#include <arrayfunctions.h>
+#include <interpolation.h>
+#include <mpivars.h>
+#include <hypar.h>
+
+/*!
+  Computes the averaged state and the left (and, if #EigenCache::full, the right)
+  eigenvectors at all the interfaces along a given dimension and marks the cache
+  valid for this dimension. The average at interface \f$j+1/2\f$ is computed from
+  the cell-centered solution at \f$j\f$ and \f$j+1\f$, i.e., exactly as in the
+  characteristic-based interpolation functions.
+*/
+int EigenCacheCompute(
+                        double  *u,   /*!< Array of cell-centered solution (with ghost points) */
+                        int     dir,  /*!< Spatial dimension */
+                        void    *s    /*!< Solver object of type #HyPar */
+                     )
+{
+  HyPar      *solver = (HyPar*) s;
+  EigenCache *cache  = (EigenCache*) solver->eigen_cache;
+  int        i;
+  _DECLARE_IERR_;
+
+  if (!cache) return(0);
+
+  int ghosts = solver->ghosts;
+  int ndims  = solver->ndims;
+  int nvars  = solver->nvars;
+  int *dim   = solver->dim_local;
+
+  /* create index and bounds for the outer loop, i.e., to loop over all 1D lines along
+     dimension "dir" */
+  int indexC[ndims], indexI[ndims], index_outer[ndims], bounds_outer[ndims], bounds_inter[ndims];
+  _ArrayCopy1D_(dim,bounds_outer,ndims); bounds_outer[dir] =  1;
+  _ArrayCopy1D_(dim,bounds_inter,ndims); bounds_inter[dir] =  dim[dir] + 1;
+  int N_outer; _ArrayProduct1D_(bounds_outer,ndims,N_outer);
+
+#pragma omp parallel for schedule(static) default(shared) private(i,index_outer,indexC,indexI)
+  for (i=0; i<N_outer; i++) {
+    _ArrayIndexnD_(ndims,i,bounds_outer,index_outer,0);
+    _ArrayCopy1D_(index_outer,indexC,ndims);
+    _ArrayCopy1D_(index_outer,indexI,ndims);
+    for (indexI[dir] = 0; indexI[dir] < dim[dir]+1; indexI[dir]++) {
+      int p, pL, pR;
+      _ArrayIndex1D_(ndims,bounds_inter,indexI,0,p);
+      indexC[dir] = indexI[dir]-1; _ArrayIndex1D_(ndims,dim,indexC,ghosts,pL);
+      indexC[dir] = indexI[dir]  ; _ArrayIndex1D_(ndims,dim,indexC,ghosts,pR);
+      double *uavg = cache->uavg + nvars*p;
+      IERR solver->AveragingFunction(uavg,&u[nvars*pL],&u[nvars*pR],solver->physics); CHECKERR(ierr);
+      IERR solver->GetLeftEigenvectors(uavg,cache->L+nvars*nvars*p,solver->physics,dir); CHECKERR(ierr);
+      if (cache->full) {
+        IERR solver->GetRightEigenvectors(uavg,cache->R+nvars*nvars*p,solver->physics,dir); CHECKERR(ierr);
+      }
+    }
+  }
+
+  cache->dir = dir;
+  return(0);
+}
+
+/*!
+  Fetches the averaged state and the eigenvectors at an interface from the cache.
+  If the cache stores only the left eigenvectors, the right eigenvectors are computed
+  from the cached average. Any of the output arrays may be NULL, if not needed.
+
+  Returns 1 if the cache is valid for the given dimension and the output arrays have
+  been filled in, and 0 otherwise (in which case the caller must compute them itself).
+  If the right eigenvectors cannot be computed from the cached average, 0 is returned,
+  so that the error is reported by the caller's own evaluation of the eigensystem.
+*/
+int EigenCacheGet(
+                    void    *s,     /*!< Solver object of type #HyPar */
+                    int     dir,    /*!< Spatial dimension */
+                    int     p,      /*!< Interface index (interface array layout) */
+                    double  *uavg,  /*!< Averaged state at the interface */
+                    double  *L,     /*!< Left eigenvectors at the interface */
+                    double  *R      /*!< Right eigenvectors at the interface */
+                 )
+{
+  HyPar      *solver = (HyPar*) s;
+  EigenCache *cache  = (EigenCache*) solver->eigen_cache;
+
+  if ((!cache) || (cache->dir != dir)) return(0);
+
+  int nvars = solver->nvars;
+  double *cavg = cache->uavg + nvars*p;
+
+  if (uavg) {
+    _ArrayCopy1D_(cavg,uavg,nvars);
+  }
+  if (L) {
+    _ArrayCopy1D_((cache->L+nvars*nvars*p),L,(nvars*nvars));
+  }
+  if (R) {
+    if (cache->full) {
+      _ArrayCopy1D_((cache->R+nvars*nvars*p),R,(nvars*nvars));
+    } else {
+      if (solver->GetRightEigenvectors(cavg,R,solver->physics,dir)) return(0);
+    }
+  }
+
+  return(1);
+}
+
+/*!
+  Marks the interface eigensystem cache as invalid. This is called once the interface
+  flux along a dimension has been computed, so that any other call to the interpolation
+  functions (for example, from the source term functions) computes the eigensystem
+  from its own arguments.
+*/
+int EigenCacheInvalidate(void *c /*!< Cache object of type #EigenCache */)
+{
+  EigenCache *cache = (EigenCache*) c;
+  if (cache) cache->dir = -1;
+  return(0);
+}
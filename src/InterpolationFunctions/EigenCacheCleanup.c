@@ -0,0 +1,21 @@
+/*! @file EigenCacheCleanup.c
+    @brief Cleans up allocations of the interface eigensystem cache
+    @author Debojyoti Ghosh
+*/
+
+#include <stdlib.h>
+#include <interpolation.h>
+
+/*!
+    Cleans up all allocations related to the interface eigensystem cache.
+*/
+int EigenCacheCleanup(void *c /*!< Cache object of type #EigenCache */ )
+{
+  EigenCache *cache = (EigenCache*) c;
+
+  if (cache->uavg) free(cache->uavg);
+  if (cache->L)    free(cache->L);
+  if (cache->R)    free(cache->R);
+
+  return(0);
+}
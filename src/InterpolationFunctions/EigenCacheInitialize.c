@@ -0,0 +1,59 @@
+/*! @file EigenCacheInitialize.c
+    @brief Initializes the interface eigensystem cache
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <interpolation.h>
+#include <mpivars.h>
+#include <hypar.h>
+
+/*!
+  Initializes the cache of averaged states and eigenvectors at the grid interfaces
+  (#EigenCache): allocates the arrays for the largest number of interfaces along
+  any one dimension, since the cache holds data for one dimension at a time.
+*/
+int EigenCacheInitialize(
+                          void *s,    /*!< Solver object of type #HyPar */
+                          void *m,    /*!< MPI object of type #MPIVariables */
+                          char *type  /*!< Type of cache (#_EIGEN_CACHE_LEFT_ or #_EIGEN_CACHE_FULL_) */
+                        )
+{
+  HyPar         *solver = (HyPar*) s;
+  MPIVariables  *mpi    = (MPIVariables*) m;
+  EigenCache    *cache  = (EigenCache*) solver->eigen_cache;
+
+  int nvars = solver->nvars;
+  int ndims = solver->ndims;
+  int d, dir;
+
+  if      (!strcmp(type,_EIGEN_CACHE_LEFT_)) cache->full = 0;
+  else if (!strcmp(type,_EIGEN_CACHE_FULL_)) cache->full = 1;
+  else {
+    if (!mpi->rank) fprintf(stderr,"Error in EigenCacheInitialize(): %s is not a valid cache type.\n",type);
+    return(1);
+  }
+
+  cache->size = 0;
+  for (dir=0; dir<ndims; dir++) {
+    int size = 1;
+    for (d=0; d<ndims; d++) size *= (d == dir ? solver->dim_local[d]+1 : solver->dim_local[d]);
+    if (size > cache->size) cache->size = size;
+  }
+
+  cache->dir  = -1;
+  cache->uavg = (double*) calloc (cache->size*nvars      , sizeof(double));
+  cache->L    = (double*) calloc (cache->size*nvars*nvars, sizeof(double));
+  if (cache->full) cache->R = (double*) calloc (cache->size*nvars*nvars, sizeof(double));
+  else             cache->R = NULL;
+
+  if (!mpi->rank) {
+    printf("Interface eigensystem cache: %d interfaces, %s eigenvectors (%1.2e MB per rank).\n",
+           cache->size, (cache->full ? "left and right" : "left"),
+           ((double)cache->size*(nvars+(cache->full+1)*nvars*nvars)*sizeof(double))/(1024.0*1024.0));
+  }
+
+  return(0);
+}
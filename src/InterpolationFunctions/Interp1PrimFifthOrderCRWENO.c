@@ -105,10 +105,17 @@ int Interp1PrimFifthOrderCRWENO(
   static const double one_third          = 1.0/3.0;
   static const double one_sixth          = 1.0/6.0;
 
-  double *ww1, *ww2, *ww3;
-  ww1 = weno->w1 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
-  ww2 = weno->w2 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
-  ww3 = weno->w3 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+  double *ww1 = NULL, *ww2 = NULL, *ww3 = NULL;
+  float  *sww1 = NULL, *sww2 = NULL, *sww3 = NULL;
+  if (weno->single) {
+    sww1 = weno->w1s + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+    sww2 = weno->w2s + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+    sww3 = weno->w3s + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+  } else {
+    ww1 = weno->w1 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+    ww2 = weno->w2 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+    ww3 = weno->w3 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+  }
 
   /* create index and bounds for the outer loop, i.e., to loop over all 1D lines along
      dimension "dir"                                                                    */
@@ -126,7 +133,7 @@ int Interp1PrimFifthOrderCRWENO(
   double *C = compact->C;
   double *R = compact->R;
 
-#pragma omp parallel for schedule(auto) default(shared) private(sys,d,index_outer,indexC,indexI)
+#pragma omp parallel for schedule(static) default(shared) private(sys,d,index_outer,indexC,indexI)
   for (sys=0; sys < N_outer; sys++) {
     _ArrayIndexnD_(ndims,sys,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexC,ndims);
@@ -173,9 +180,16 @@ int Interp1PrimFifthOrderCRWENO(
 
       /* retrieve the WENO weights */
       double *w1, *w2, *w3;
-      w1 = (ww1+p*nvars);
-      w2 = (ww2+p*nvars);
-      w3 = (ww3+p*nvars);
+      double sw1[nvars], sw2[nvars], sw3[nvars];
+      if (weno->single) {
+        _ArrayCopy1D_((sww1+p*nvars),sw1,nvars); w1 = sw1;
+        _ArrayCopy1D_((sww2+p*nvars),sw2,nvars); w2 = sw2;
+        _ArrayCopy1D_((sww3+p*nvars),sw3,nvars); w3 = sw3;
+      } else {
+        w1 = (ww1+p*nvars);
+        w2 = (ww2+p*nvars);
+        w3 = (ww3+p*nvars);
+      }
 
       if (   ((mpi->ip[dir] == 0                ) && (indexI[dir] == 0       ))
           || ((mpi->ip[dir] == mpi->iproc[dir]-1) && (indexI[dir] == dim[dir])) ) {
@@ -223,7 +237,7 @@ int Interp1PrimFifthOrderCRWENO(
 #endif
 
   /* save the solution to fI */
-#pragma omp parallel for schedule(auto) default(shared) private(sys,d,index_outer,indexC,indexI)
+#pragma omp parallel for schedule(static) default(shared) private(sys,d,index_outer,indexC,indexI)
   for (sys=0; sys < N_outer; sys++) {
     _ArrayIndexnD_(ndims,sys,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexI,ndims);
@@ -122,7 +122,7 @@ int Interp1PrimFifthOrderCompactUpwind(
   double *C = compact->C;
   double *R = compact->R;
 
-#pragma omp parallel for schedule(auto) default(shared) private(sys,d,index_outer,indexC,indexI)
+#pragma omp parallel for schedule(static) default(shared) private(sys,d,index_outer,indexC,indexI)
   for (sys=0; sys < N_outer; sys++) {
     _ArrayIndexnD_(ndims,sys,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexC,ndims);
@@ -214,7 +214,7 @@ int Interp1PrimFifthOrderCompactUpwind(
 #endif
 
   /* save the solution to fI */
-#pragma omp parallel for schedule(auto) default(shared) private(sys,d,index_outer,indexC,indexI)
+#pragma omp parallel for schedule(static) default(shared) private(sys,d,index_outer,indexC,indexI)
   for (sys=0; sys < N_outer; sys++) {
     _ArrayIndexnD_(ndims,sys,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexI,ndims);
@@ -141,7 +141,7 @@ int Interp1PrimFifthOrderCompactUpwindChar(
   double *C = compact->C;
   double *F = compact->R;
 
-#pragma omp parallel for schedule(auto) default(shared) private(sys,d,v,k,R,L,uavg,index_outer,indexC,indexI)
+#pragma omp parallel for schedule(static) default(shared) private(sys,d,v,k,R,L,uavg,index_outer,indexC,indexI)
   for (sys=0; sys<Nsys; sys++) {
     _ArrayIndexnD_(ndims,sys,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexC,ndims);
@@ -165,12 +165,13 @@ int Interp1PrimFifthOrderCompactUpwindChar(
       int p; /* 1D index of the interface */
       _ArrayIndex1D_(ndims,bounds_inter,indexI,0,p);
 
-      /* find averaged state at this interface */
-      IERR solver->AveragingFunction(uavg,&u[nvars*qm1],&u[nvars*qp1],solver->physics); CHECKERR(ierr);
-
-      /* Get the left and right eigenvectors */
-      IERR solver->GetLeftEigenvectors  (uavg,L,solver->physics,dir); CHECKERR(ierr);
-      IERR solver->GetRightEigenvectors (uavg,R,solver->physics,dir); CHECKERR(ierr);
+      /* find averaged state and the left and right eigenvectors at this interface
+         (fetch them from the interface eigensystem cache, if available)        */
+      if (!EigenCacheGet(solver,dir,p,uavg,L,R)) {
+        IERR solver->AveragingFunction(uavg,&u[nvars*qm1],&u[nvars*qp1],solver->physics); CHECKERR(ierr);
+        IERR solver->GetLeftEigenvectors  (uavg,L,solver->physics,dir); CHECKERR(ierr);
+        IERR solver->GetRightEigenvectors (uavg,R,solver->physics,dir); CHECKERR(ierr);
+      }
 
       for (v=0; v<nvars; v++)  {
 
@@ -250,7 +251,7 @@ int Interp1PrimFifthOrderCompactUpwindChar(
 #endif
 
   /* save the solution to fI */
-#pragma omp parallel for schedule(auto) default(shared) private(sys,d,v,k,R,L,uavg,index_outer,indexC,indexI)
+#pragma omp parallel for schedule(static) default(shared) private(sys,d,v,k,R,L,uavg,index_outer,indexC,indexI)
   for (sys=0; sys<Nsys; sys++) {
     _ArrayIndexnD_(ndims,sys,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexI,ndims);
@@ -106,10 +106,17 @@ int Interp1PrimFifthOrderHCWENOChar(
   static const double one_third          = 1.0/3.0;
   static const double one_sixth          = 1.0/6.0;
 
-  double *ww1, *ww2, *ww3;
-  ww1 = weno->w1 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
-  ww2 = weno->w2 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
-  ww3 = weno->w3 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+  double *ww1 = NULL, *ww2 = NULL, *ww3 = NULL;
+  float  *sww1 = NULL, *sww2 = NULL, *sww3 = NULL;
+  if (weno->single) {
+    sww1 = weno->w1s + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+    sww2 = weno->w2s + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+    sww3 = weno->w3s + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+  } else {
+    ww1 = weno->w1 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+    ww2 = weno->w2 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+    ww3 = weno->w3 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+  }
 
   /* create index and bounds for the outer loop, i.e., to loop over all 1D lines along
      dimension "dir"                                                                    */
@@ -129,7 +136,7 @@ int Interp1PrimFifthOrderHCWENOChar(
   double *C = compact->C;
   double *F = compact->R;
 
-#pragma omp parallel for schedule(auto) default(shared) private(sys,d,v,k,R,L,uavg,index_outer,indexC,indexI)
+#pragma omp parallel for schedule(static) default(shared) private(sys,d,v,k,R,L,uavg,index_outer,indexC,indexI)
   for (sys=0; sys<Nsys; sys++) {
     _ArrayIndexnD_(ndims,sys,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexC,ndims);
@@ -153,12 +160,13 @@ int Interp1PrimFifthOrderHCWENOChar(
       int p; /* 1D index of the interface */
       _ArrayIndex1D_(ndims,bounds_inter,indexI,0,p);
 
-      /* find averaged state at this interface */
-      IERR solver->AveragingFunction(uavg,&u[nvars*qm1],&u[nvars*qp1],solver->physics); CHECKERR(ierr);
-
-      /* Get the left and right eigenvectors */
-      IERR solver->GetLeftEigenvectors  (uavg,L,solver->physics,dir); CHECKERR(ierr);
-      IERR solver->GetRightEigenvectors (uavg,R,solver->physics,dir); CHECKERR(ierr);
+      /* find averaged state and the left and right eigenvectors at this interface
+         (fetch them from the interface eigensystem cache, if available)        */
+      if (!EigenCacheGet(solver,dir,p,uavg,L,R)) {
+        IERR solver->AveragingFunction(uavg,&u[nvars*qm1],&u[nvars*qp1],solver->physics); CHECKERR(ierr);
+        IERR solver->GetLeftEigenvectors  (uavg,L,solver->physics,dir); CHECKERR(ierr);
+        IERR solver->GetRightEigenvectors (uavg,R,solver->physics,dir); CHECKERR(ierr);
+      }
 
       for (v=0; v<nvars; v++)  {
 
@@ -190,9 +198,9 @@ int Interp1PrimFifthOrderHCWENOChar(
 
         /* calculate WENO weights */
         double w1,w2,w3;
-        w1 = *(ww1+p*nvars+v);
-        w2 = *(ww2+p*nvars+v);
-        w3 = *(ww3+p*nvars+v);
+        w1 = _WENOWeight_(ww1,sww1,(p*nvars+v));
+        w2 = _WENOWeight_(ww2,sww2,(p*nvars+v));
+        w3 = _WENOWeight_(ww3,sww3,(p*nvars+v));
 
         /* calculate the hybridization parameter */
         double sigma;
@@ -262,7 +270,7 @@ int Interp1PrimFifthOrderHCWENOChar(
 #endif
 
   /* save the solution to fI */
-#pragma omp parallel for schedule(auto) default(shared) private(sys,d,v,k,R,L,uavg,index_outer,indexC,indexI)
+#pragma omp parallel for schedule(static) default(shared) private(sys,d,v,k,R,L,uavg,index_outer,indexC,indexI)
   for (sys=0; sys<Nsys; sys++) {
     _ArrayIndexnD_(ndims,sys,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexI,ndims);
@@ -4,7 +4,6 @@
 */
 
 #include <stdlib.h>
-#include <time.h>
 
 #include <basic.h>
 #include <arrayfunctions.h>
@@ -95,10 +94,17 @@ int Interp1PrimFifthOrderWENO(
   /* define some constants */
   static const double one_sixth          = 1.0/6.0;
 
-  double *ww1, *ww2, *ww3;
-  ww1 = weno->w1 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
-  ww2 = weno->w2 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
-  ww3 = weno->w3 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+  double *ww1 = NULL, *ww2 = NULL, *ww3 = NULL;
+  float  *sww1 = NULL, *sww2 = NULL, *sww3 = NULL;
+  if (weno->single) {
+    sww1 = weno->w1s + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+    sww2 = weno->w2s + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+    sww3 = weno->w3s + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+  } else {
+    ww1 = weno->w1 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+    ww2 = weno->w2 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+    ww3 = weno->w3 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+  }
 
   /* create index and bounds for the outer loop, i.e., to loop over all 1D lines along
      dimension "dir"                                                                    */
@@ -107,13 +113,8 @@ int Interp1PrimFifthOrderWENO(
   _ArrayCopy1D_(dim,bounds_inter,ndims); bounds_inter[dir] += 1;
   int N_outer; _ArrayProduct1D_(bounds_outer,ndims,N_outer);
 
-#if defined(CPU_STAT)
-  clock_t cpu_start, cpu_end;
-  cpu_start = clock();
-#endif
-
   int i;
-#pragma omp parallel for schedule(auto) default(shared) private(i,index_outer,indexC,indexI)
+#pragma omp parallel for schedule(static) default(shared) private(i,index_outer,indexC,indexI)
   for (i=0; i<N_outer; i++) {
     _ArrayIndexnD_(ndims,i,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexC,ndims);
@@ -151,18 +152,20 @@ int Interp1PrimFifthOrderWENO(
 
       /* calculate WENO weights */
       double *w1,*w2,*w3;
-      w1 = (ww1+p*nvars);
-      w2 = (ww2+p*nvars);
-      w3 = (ww3+p*nvars);
+      double sw1[nvars], sw2[nvars], sw3[nvars];
+      if (weno->single) {
+        _ArrayCopy1D_((sww1+p*nvars),sw1,nvars); w1 = sw1;
+        _ArrayCopy1D_((sww2+p*nvars),sw2,nvars); w2 = sw2;
+        _ArrayCopy1D_((sww3+p*nvars),sw3,nvars); w3 = sw3;
+      } else {
+        w1 = (ww1+p*nvars);
+        w2 = (ww2+p*nvars);
+        w3 = (ww3+p*nvars);
+      }
 
       _ArrayMultiply3Add1D_((fI+p*nvars),w1,f1,w2,f2,w3,f3,nvars);
     }
   }
 
-#if defined(CPU_STAT)
-  cpu_end = clock();
-  printf("Interp1PrimFifthOrderWENO CPU time = %8.6lf dir = %d\n", (double)(cpu_end - cpu_start) / CLOCKS_PER_SEC, dir);
-#endif
-
   return(0);
 }
@@ -59,6 +59,9 @@
       - #HyPar::AveragingFunction()
 
       If these functions are not provided by the physical model, then a characteristic-based interpolation cannot be used.
+    + With the hybrid scheme (#WENOParameters::hybrid), the interfaces where the solution is smooth (see
+      WENOHybridSensor()) are interpolated component-wise: the weights are the optimal weights there, and
+      the linear interpolation of the characteristic quantities is the same as that of the components.
     + The function computes the interpolant for the entire grid in one call. It loops over all the grid lines along the interpolation direction
       and carries out the 1D interpolation along these grid lines.
     + Location of cell-centers and cell interfaces along the spatial dimension of the interpolation is shown in the following figure:
@@ -108,10 +111,17 @@ int Interp1PrimFifthOrderWENOChar(
   /* define some constants */
   static const double one_sixth          = 1.0/6.0;
 
-  double *ww1, *ww2, *ww3;
-  ww1 = weno->w1 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
-  ww2 = weno->w2 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
-  ww3 = weno->w3 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+  double *ww1 = NULL, *ww2 = NULL, *ww3 = NULL;
+  float  *sww1 = NULL, *sww2 = NULL, *sww3 = NULL;
+  if (weno->single) {
+    sww1 = weno->w1s + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+    sww2 = weno->w2s + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+    sww3 = weno->w3s + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+  } else {
+    ww1 = weno->w1 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+    ww2 = weno->w2 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+    ww3 = weno->w3 + (upw < 0 ? 2*weno->size : 0) + (uflag ? weno->size : 0) + weno->offset[dir];
+  }
 
   /* create index and bounds for the outer loop, i.e., to loop over all 1D lines along
      dimension "dir"                                                                    */
@@ -120,10 +130,13 @@ int Interp1PrimFifthOrderWENOChar(
   _ArrayCopy1D_(dim,bounds_inter,ndims); bounds_inter[dir] += 1;
   int N_outer; _ArrayProduct1D_(bounds_outer,ndims,N_outer);
 
+  /* flags of the smoothness sensor of the hybrid scheme (see WENOHybridSensor()) */
+  int *hybrid_flag = (weno->hybrid ? weno->hybrid_flag + weno->offset[dir]/nvars : NULL);
+
   /* allocate arrays for the averaged state, eigenvectors and characteristic interpolated f */
   double R[nvars*nvars], L[nvars*nvars], uavg[nvars], fchar[nvars];
 
-#pragma omp parallel for schedule(auto) default(shared) private(i,k,v,R,L,uavg,fchar,index_outer,indexC,indexI)
+#pragma omp parallel for schedule(static) default(shared) private(i,k,v,R,L,uavg,fchar,index_outer,indexC,indexI)
   for (i=0; i<N_outer; i++) {
     _ArrayIndexnD_(ndims,i,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexC,ndims);
@@ -150,12 +163,28 @@ int Interp1PrimFifthOrderWENOChar(
       int p; /* 1D index of the interface */
       _ArrayIndex1D_(ndims,bounds_inter,indexI,0,p);
 
-      /* find averaged state at this interface */
-      IERR solver->AveragingFunction(uavg,&u[nvars*qm1],&u[nvars*qp1],solver->physics); CHECKERR(ierr);
+      /* smooth interface (hybrid scheme): the weights are the optimal weights, so that the
+         interpolation is linear, and the characteristic decomposition is not needed */
+      if (hybrid_flag && (!hybrid_flag[p])) {
+        for (v = 0; v < nvars; v++) {
+          double f1, f2, f3;
+          f1 = (2*one_sixth)*fC[qm3*nvars+v] - (7.0*one_sixth)*fC[qm2*nvars+v] + (11.0*one_sixth)*fC[qm1*nvars+v];
+          f2 = (-one_sixth)*fC[qm2*nvars+v] + (5.0*one_sixth)*fC[qm1*nvars+v] + (2*one_sixth)*fC[qp1*nvars+v];
+          f3 = (2*one_sixth)*fC[qm1*nvars+v] + (5*one_sixth)*fC[qp1*nvars+v] - (one_sixth)*fC[qp2*nvars+v];
+          fI[nvars*p+v] =   _WENOWeight_(ww1,sww1,(p*nvars+v))*f1
+                          + _WENOWeight_(ww2,sww2,(p*nvars+v))*f2
+                          + _WENOWeight_(ww3,sww3,(p*nvars+v))*f3;
+        }
+        continue;
+      }
 
-      /* Get the left and right eigenvectors */
-      IERR solver->GetLeftEigenvectors  (uavg,L,solver->physics,dir); CHECKERR(ierr);
-      IERR solver->GetRightEigenvectors (uavg,R,solver->physics,dir); CHECKERR(ierr);
+      /* find averaged state and the left and right eigenvectors at this interface
+         (fetch them from the interface eigensystem cache, if available)        */
+      if (!EigenCacheGet(solver,dir,p,uavg,L,R)) {
+        IERR solver->AveragingFunction(uavg,&u[nvars*qm1],&u[nvars*qp1],solver->physics); CHECKERR(ierr);
+        IERR solver->GetLeftEigenvectors  (uavg,L,solver->physics,dir); CHECKERR(ierr);
+        IERR solver->GetRightEigenvectors (uavg,R,solver->physics,dir); CHECKERR(ierr);
+      }
 
       /* For each characteristic field */
       for (v = 0; v < nvars; v++) {
@@ -179,9 +208,9 @@ int Interp1PrimFifthOrderWENOChar(
 
         /* calculate WENO weights */
         double w1,w2,w3;
-        w1 = *(ww1+p*nvars+v);
-        w2 = *(ww2+p*nvars+v);
-        w3 = *(ww3+p*nvars+v);
+        w1 = _WENOWeight_(ww1,sww1,(p*nvars+v));
+        w2 = _WENOWeight_(ww2,sww2,(p*nvars+v));
+        w3 = _WENOWeight_(ww3,sww3,(p*nvars+v));
 
         /* fifth order WENO approximation of the characteristic flux */
         fchar[v] = w1*f1 + w2*f2 + w3*f3;
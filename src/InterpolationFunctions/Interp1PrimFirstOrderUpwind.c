@@ -85,7 +85,7 @@ int Interp1PrimFirstOrderUpwind(
   int N_outer; _ArrayProduct1D_(bounds_outer,ndims,N_outer);
 
   int i;
-#pragma omp parallel for schedule(auto) default(shared) private(i,index_outer,indexC,indexI)
+#pragma omp parallel for schedule(static) default(shared) private(i,index_outer,indexC,indexI)
   for (i=0; i<N_outer; i++) {
     _ArrayIndexnD_(ndims,i,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexC,ndims);
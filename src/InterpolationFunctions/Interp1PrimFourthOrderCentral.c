@@ -97,7 +97,7 @@ int Interp1PrimFourthOrderCentral(
   static const double c2 = -1.0 / 12.0;
 
   int i;
-#pragma omp parallel for schedule(auto) default(shared) private(i,index_outer,indexL,indexR,indexI)
+#pragma omp parallel for schedule(static) default(shared) private(i,index_outer,indexL,indexR,indexI)
   for (i=0; i<N_outer; i++) {
     _ArrayIndexnD_(ndims,i,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexL,ndims);
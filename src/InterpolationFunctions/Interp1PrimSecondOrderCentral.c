@@ -86,7 +86,7 @@ int Interp1PrimSecondOrderCentral(
   int N_outer; _ArrayProduct1D_(bounds_outer,ndims,N_outer);
 
   int i;
-#pragma omp parallel for schedule(auto) default(shared) private(i,index_outer,indexL,indexR,indexI)
+#pragma omp parallel for schedule(static) default(shared) private(i,index_outer,indexL,indexR,indexI)
   for (i=0; i<N_outer; i++) {
     _ArrayIndexnD_(ndims,i,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexL,ndims);
@@ -126,7 +126,7 @@ int Interp1PrimSecondOrderMUSCLChar (
   double R[nvars*nvars], L[nvars*nvars], uavg[nvars], fchar[nvars];
 
   if (upw > 0) {
-#pragma omp parallel for schedule(auto) default(shared) private(i,k,v,R,L,uavg,fchar,index_outer,indexC,indexI)
+#pragma omp parallel for schedule(static) default(shared) private(i,k,v,R,L,uavg,fchar,index_outer,indexC,indexI)
     for (i=0; i<N_outer; i++) {
       _ArrayIndexnD_(ndims,i,bounds_outer,index_outer,0);
       _ArrayCopy1D_(index_outer,indexC,ndims);
@@ -143,13 +143,13 @@ int Interp1PrimSecondOrderMUSCLChar (
         int p; /* 1D index of the interface */
         _ArrayIndex1D_(ndims,bounds_inter,indexI,0,p);
 
-        /* find averaged state at this interface */
-        IERR solver->AveragingFunction(uavg,&u[nvars*qm1],&u[nvars*qp1],solver->physics);
-        CHECKERR(ierr);
-
-        /* Get the left and right eigenvectors */
-        IERR solver->GetLeftEigenvectors  (uavg,L,solver->physics,dir); CHECKERR(ierr);
-        IERR solver->GetRightEigenvectors (uavg,R,solver->physics,dir); CHECKERR(ierr);
+        /* find averaged state and the left and right eigenvectors at this interface
+           (fetch them from the interface eigensystem cache, if available)        */
+        if (!EigenCacheGet(solver,dir,p,uavg,L,R)) {
+          IERR solver->AveragingFunction(uavg,&u[nvars*qm1],&u[nvars*qp1],solver->physics); CHECKERR(ierr);
+          IERR solver->GetLeftEigenvectors  (uavg,L,solver->physics,dir); CHECKERR(ierr);
+          IERR solver->GetRightEigenvectors (uavg,R,solver->physics,dir); CHECKERR(ierr);
+        }
 
         /* For each characteristic field */
         for (v = 0; v < nvars; v++) {
@@ -172,7 +172,7 @@ int Interp1PrimSecondOrderMUSCLChar (
       }
     }
   } else {
-#pragma omp parallel for schedule(auto) default(shared) private(i,k,v,R,L,uavg,fchar,index_outer,indexC,indexI)
+#pragma omp parallel for schedule(static) default(shared) private(i,k,v,R,L,uavg,fchar,index_outer,indexC,indexI)
     for (i=0; i<N_outer; i++) {
       _ArrayIndexnD_(ndims,i,bounds_outer,index_outer,0);
       _ArrayCopy1D_(index_outer,indexC,ndims);
@@ -189,13 +189,13 @@ int Interp1PrimSecondOrderMUSCLChar (
         int p; /* 1D index of the interface */
         _ArrayIndex1D_(ndims,bounds_inter,indexI,0,p);
 
-        /* find averaged state at this interface */
-        IERR solver->AveragingFunction(uavg,&u[nvars*qm1],&u[nvars*qp1],solver->physics);
-        CHECKERR(ierr);
-
-        /* Get the left and right eigenvectors */
-        IERR solver->GetLeftEigenvectors  (uavg,L,solver->physics,dir); CHECKERR(ierr);
-        IERR solver->GetRightEigenvectors (uavg,R,solver->physics,dir); CHECKERR(ierr);
+        /* find averaged state and the left and right eigenvectors at this interface
+           (fetch them from the interface eigensystem cache, if available)        */
+        if (!EigenCacheGet(solver,dir,p,uavg,L,R)) {
+          IERR solver->AveragingFunction(uavg,&u[nvars*qm1],&u[nvars*qp1],solver->physics); CHECKERR(ierr);
+          IERR solver->GetLeftEigenvectors  (uavg,L,solver->physics,dir); CHECKERR(ierr);
+          IERR solver->GetRightEigenvectors (uavg,R,solver->physics,dir); CHECKERR(ierr);
+        }
 
         /* For each characteristic field */
         for (v = 0; v < nvars; v++) {
@@ -105,7 +105,7 @@ int Interp1PrimThirdOrderMUSCL(
 
   int i;
   if (upw > 0) {
-#pragma omp parallel for schedule(auto) default(shared) private(i,index_outer,indexC,indexI)
+#pragma omp parallel for schedule(static) default(shared) private(i,index_outer,indexC,indexI)
     for (i=0; i<N_outer; i++) {
       _ArrayIndexnD_(ndims,i,bounds_outer,index_outer,0);
       _ArrayCopy1D_(index_outer,indexC,ndims);
@@ -133,7 +133,7 @@ int Interp1PrimThirdOrderMUSCL(
       }
     }
   } else {
-#pragma omp parallel for schedule(auto) default(shared) private(i,index_outer,indexC,indexI)
+#pragma omp parallel for schedule(static) default(shared) private(i,index_outer,indexC,indexI)
     for (i=0; i<N_outer; i++) {
       _ArrayIndexnD_(ndims,i,bounds_outer,index_outer,0);
       _ArrayCopy1D_(index_outer,indexC,ndims);
@@ -4,6 +4,7 @@
 */
 
 #include <stdlib.h>
+#include <arrayfunctions.h>
 #if defined(HAVE_CUDA)
 #include <arrayfunctions_gpu.h>
 #endif
@@ -20,6 +21,8 @@ int WENOCleanup(void *s, /*!< WENO object of type #WENOParameters */
   WENOParameters  *weno   = (WENOParameters*) s;
 
   if (weno->offset) free(weno->offset);
+  if (weno->hybrid_flag) free(weno->hybrid_flag);
+  if (weno->hybrid_count) free(weno->hybrid_count);
 #if defined(HAVE_CUDA)
   if (flag_gpu) {
     if (weno->w1) gpuFree(weno->w1);
@@ -27,9 +30,12 @@ int WENOCleanup(void *s, /*!< WENO object of type #WENOParameters */
     if (weno->w3) gpuFree(weno->w3);
   } else {
 #endif
-    if (weno->w1) free(weno->w1);
-    if (weno->w2) free(weno->w2);
-    if (weno->w3) free(weno->w3);
+    if (weno->w1) ArrayFree(weno->w1);
+    if (weno->w2) ArrayFree(weno->w2);
+    if (weno->w3) ArrayFree(weno->w3);
+    if (weno->w1s) ArrayFree(weno->w1s);
+    if (weno->w2s) ArrayFree(weno->w2s);
+    if (weno->w3s) ArrayFree(weno->w3s);
 #if defined(HAVE_CUDA)
   }
 #endif
@@ -5,7 +5,6 @@
 
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 
 #include <basic.h>
 #include <arrayfunctions.h>
@@ -35,7 +34,9 @@ static int WENOFifthOrderCalculateWeightsCharZ (double*,double*,double*,int,void
 static int WENOFifthOrderCalculateWeightsCharYC(double*,double*,double*,int,void*,void*);
 
 /*! Compute the nonlinear weights for 5th order WENO-type schemes. This function is a wrapper that
-    calls the appropriate function, depending on the type of WENO weights.
+    calls the appropriate function, depending on the type of WENO weights. With the hybrid scheme
+    (#WENOParameters::hybrid), the smoothness sensor is computed first (see WENOHybridSensor()), and
+    the nonlinear weights are computed only at the interfaces it flags.
 */
 int WENOFifthOrderCalculateWeights(
                                     double  *fC, /*!< Array of cell-centered values of the function \f${\bf f}\left({\bf u}\right)\f$ */
@@ -52,6 +53,11 @@ int WENOFifthOrderCalculateWeights(
 
   int ret;
 
+  if (weno->hybrid) {
+    ret = WENOHybridSensor(uC,dir,solver,mpi);
+    if (ret) return ret;
+  }
+
   if (weno->yc)           ret = WENOFifthOrderCalculateWeightsYC (fC,uC,x,dir,solver,mpi);
   else if (weno->borges)  ret = WENOFifthOrderCalculateWeightsZ  (fC,uC,x,dir,solver,mpi);
   else if (weno->mapped)  ret = WENOFifthOrderCalculateWeightsM  (fC,uC,x,dir,solver,mpi);
@@ -61,7 +67,10 @@ int WENOFifthOrderCalculateWeights(
 }
 
 /*! Compute the nonlinear weights for 5th order WENO-type schemes. This function is a wrapper that
-    calls the appropriate function, depending on the type of WENO weights.
+    calls the appropriate function, depending on the type of WENO weights. With the hybrid scheme
+    (#WENOParameters::hybrid), the smoothness sensor is computed first (see WENOHybridSensor()), and
+    the characteristic decomposition and the nonlinear weights are computed only at the interfaces
+    it flags.
 */
 int WENOFifthOrderCalculateWeightsChar(
                                         double  *fC, /*!< Array of cell-centered values of the function \f${\bf f}\left({\bf u}\right)\f$ */
@@ -76,6 +85,11 @@ int WENOFifthOrderCalculateWeightsChar(
   WENOParameters  *weno   = (WENOParameters*) solver->interp;
   MPIVariables    *mpi    = (MPIVariables*)   m;
 
+  if (weno->hybrid) {
+    int ret = WENOHybridSensor(uC,dir,solver,mpi);
+    if (ret) return ret;
+  }
+
   if (weno->yc)           return(WENOFifthOrderCalculateWeightsCharYC (fC,uC,x,dir,solver,mpi));
   else if (weno->borges)  return(WENOFifthOrderCalculateWeightsCharZ  (fC,uC,x,dir,solver,mpi));
   else if (weno->mapped)  return(WENOFifthOrderCalculateWeightsCharM  (fC,uC,x,dir,solver,mpi));
@@ -121,8 +135,8 @@ int WENOFifthOrderCalculateWeightsJS(
   WENOParameters  *weno   = (WENOParameters*) solver->interp;
   MPIVariables    *mpi    = (MPIVariables*)   m;
   int             i;
-  double          *ww1LF, *ww2LF, *ww3LF, *ww1RF, *ww2RF, *ww3RF;
-  double          *ww1LU, *ww2LU, *ww3LU, *ww1RU, *ww2RU, *ww3RU;
+  double          *ww1 = weno->w1,  *ww2 = weno->w2,  *ww3 = weno->w3;
+  float           *sw1 = weno->w1s, *sw2 = weno->w2s, *sw3 = weno->w3s;
 
   int ghosts = solver->ghosts;
   int ndims  = solver->ndims;
@@ -136,6 +150,8 @@ int WENOFifthOrderCalculateWeightsJS(
 
   /* calculate dimension offset */
   int offset = weno->offset[dir];
+  /* flags of the smoothness sensor of the hybrid scheme */
+  int *hybrid_flag = (weno->hybrid ? weno->hybrid_flag + offset/nvars : NULL);
 
   /* create index and bounds for the outer loop, i.e., to loop over all 1D lines along
      dimension "dir"                                                                    */
@@ -144,19 +160,10 @@ int WENOFifthOrderCalculateWeightsJS(
   _ArrayCopy1D_(dim,bounds_inter,ndims); bounds_inter[dir] += 1;
   int N_outer; _ArrayProduct1D_(bounds_outer,ndims,N_outer);
 
-  ww1LF = weno->w1 + offset;
-  ww2LF = weno->w2 + offset;
-  ww3LF = weno->w3 + offset;
-  ww1RF = weno->w1 + 2*weno->size + offset;
-  ww2RF = weno->w2 + 2*weno->size + offset;
-  ww3RF = weno->w3 + 2*weno->size + offset;
-  ww1LU = weno->w1 + weno->size + offset;
-  ww2LU = weno->w2 + weno->size + offset;
-  ww3LU = weno->w3 + weno->size + offset;
-  ww1RU = weno->w1 + 2*weno->size + weno->size + offset;
-  ww2RU = weno->w2 + 2*weno->size + weno->size + offset;
-  ww3RU = weno->w3 + 2*weno->size + weno->size + offset;
-#pragma omp parallel for schedule(auto) default(shared) private(i,index_outer,indexC,indexI)
+  /* offsets of the weights of the left- and right-biased interpolations of the flux (F)
+     and of the solution (U) */
+  int oLF = offset, oLU = weno->size + offset, oRF = 2*weno->size + offset, oRU = 3*weno->size + offset;
+#pragma omp parallel for schedule(static) default(shared) private(i,index_outer,indexC,indexI)
   for (i=0; i<N_outer; i++) {
     _ArrayIndexnD_(ndims,i,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexC,ndims);
@@ -164,6 +171,8 @@ int WENOFifthOrderCalculateWeightsJS(
     for (indexI[dir] = 0; indexI[dir] < dim[dir]+1; indexI[dir]++) {
       int qm1L,qm2L,qm3L,qp1L,qp2L,p,qm1R,qm2R,qm3R,qp1R,qp2R;
       _ArrayIndex1D_(ndims,bounds_inter,indexI,0,p);
+      /* smooth interface (hybrid scheme): the optimal weights are set by WENOHybridSensor() */
+      if (hybrid_flag && (!hybrid_flag[p])) continue;
       indexC[dir] = indexI[dir]-1; _ArrayIndex1D_(ndims,dim,indexC,ghosts,qm1L);
       qm3L = qm1L - 2*stride[dir];
       qm2L = qm1L -   stride[dir];
@@ -225,10 +234,17 @@ int WENOFifthOrderCalculateWeightsJS(
       }
 
       /* calculate WENO weights */
-      _WENOWeights_v_JS_((ww1LF+p*nvars),(ww2LF+p*nvars),(ww3LF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
-      _WENOWeights_v_JS_((ww1RF+p*nvars),(ww2RF+p*nvars),(ww3RF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
-      _WENOWeights_v_JS_((ww1LU+p*nvars),(ww2LU+p*nvars),(ww3LU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
-      _WENOWeights_v_JS_((ww1RU+p*nvars),(ww2RU+p*nvars),(ww3RU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      if (weno->single) {
+        _WENOWeights_v_JS_((sw1+oLF+p*nvars),(sw2+oLF+p*nvars),(sw3+oLF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
+        _WENOWeights_v_JS_((sw1+oRF+p*nvars),(sw2+oRF+p*nvars),(sw3+oRF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
+        _WENOWeights_v_JS_((sw1+oLU+p*nvars),(sw2+oLU+p*nvars),(sw3+oLU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
+        _WENOWeights_v_JS_((sw1+oRU+p*nvars),(sw2+oRU+p*nvars),(sw3+oRU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      } else {
+        _WENOWeights_v_JS_((ww1+oLF+p*nvars),(ww2+oLF+p*nvars),(ww3+oLF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
+        _WENOWeights_v_JS_((ww1+oRF+p*nvars),(ww2+oRF+p*nvars),(ww3+oRF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
+        _WENOWeights_v_JS_((ww1+oLU+p*nvars),(ww2+oLU+p*nvars),(ww3+oLU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
+        _WENOWeights_v_JS_((ww1+oRU+p*nvars),(ww2+oRU+p*nvars),(ww3+oRU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      }
     }
   }
 
@@ -275,8 +291,8 @@ int WENOFifthOrderCalculateWeightsM(
   WENOParameters  *weno   = (WENOParameters*) solver->interp;
   MPIVariables    *mpi    = (MPIVariables*)   m;
   int             i;
-  double          *ww1LF, *ww2LF, *ww3LF, *ww1RF, *ww2RF, *ww3RF;
-  double          *ww1LU, *ww2LU, *ww3LU, *ww1RU, *ww2RU, *ww3RU;
+  double          *ww1 = weno->w1,  *ww2 = weno->w2,  *ww3 = weno->w3;
+  float           *sw1 = weno->w1s, *sw2 = weno->w2s, *sw3 = weno->w3s;
 
   int ghosts = solver->ghosts;
   int ndims  = solver->ndims;
@@ -290,6 +306,8 @@ int WENOFifthOrderCalculateWeightsM(
 
   /* calculate dimension offset */
   int offset = weno->offset[dir];
+  /* flags of the smoothness sensor of the hybrid scheme */
+  int *hybrid_flag = (weno->hybrid ? weno->hybrid_flag + offset/nvars : NULL);
 
   /* create index and bounds for the outer loop, i.e., to loop over all 1D lines along
      dimension "dir"                                                                    */
@@ -298,26 +316,11 @@ int WENOFifthOrderCalculateWeightsM(
   _ArrayCopy1D_(dim,bounds_inter,ndims); bounds_inter[dir] += 1;
   int N_outer; _ArrayProduct1D_(bounds_outer,ndims,N_outer);
 
-  ww1LF = weno->w1 + offset;
-  ww2LF = weno->w2 + offset;
-  ww3LF = weno->w3 + offset;
-  ww1RF = weno->w1 + 2*weno->size + offset;
-  ww2RF = weno->w2 + 2*weno->size + offset;
-  ww3RF = weno->w3 + 2*weno->size + offset;
-  ww1LU = weno->w1 + weno->size + offset;
-  ww2LU = weno->w2 + weno->size + offset;
-  ww3LU = weno->w3 + weno->size + offset;
-  ww1RU = weno->w1 + 2*weno->size + weno->size + offset;
-  ww2RU = weno->w2 + 2*weno->size + weno->size + offset;
-  ww3RU = weno->w3 + 2*weno->size + weno->size + offset;
-
-#if defined(CPU_STAT)
-  clock_t startTime, endTime;
-  double copyTime = 0.0;
-  startTime = clock();
-#endif
-
-#pragma omp parallel for schedule(auto) default(shared) private(i,index_outer,indexC,indexI)
+  /* offsets of the weights of the left- and right-biased interpolations of the flux (F)
+     and of the solution (U) */
+  int oLF = offset, oLU = weno->size + offset, oRF = 2*weno->size + offset, oRU = 3*weno->size + offset;
+
+#pragma omp parallel for schedule(static) default(shared) private(i,index_outer,indexC,indexI)
   for (i=0; i<N_outer; i++) {
     _ArrayIndexnD_(ndims,i,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexC,ndims);
@@ -325,6 +328,8 @@ int WENOFifthOrderCalculateWeightsM(
     for (indexI[dir] = 0; indexI[dir] < dim[dir]+1; indexI[dir]++) {
       int qm1L,qm2L,qm3L,qp1L,qp2L,p,qm1R,qm2R,qm3R,qp1R,qp2R;
       _ArrayIndex1D_(ndims,bounds_inter,indexI,0,p);
+      /* smooth interface (hybrid scheme): the optimal weights are set by WENOHybridSensor() */
+      if (hybrid_flag && (!hybrid_flag[p])) continue;
       indexC[dir] = indexI[dir]-1; _ArrayIndex1D_(ndims,dim,indexC,ghosts,qm1L);
       qm3L = qm1L - 2*stride[dir];
       qm2L = qm1L -   stride[dir];
@@ -386,19 +391,20 @@ int WENOFifthOrderCalculateWeightsM(
       }
 
       /* calculate WENO weights */
-      _WENOWeights_v_M_((ww1LF+p*nvars),(ww2LF+p*nvars),(ww3LF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
-      _WENOWeights_v_M_((ww1RF+p*nvars),(ww2RF+p*nvars),(ww3RF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
-      _WENOWeights_v_M_((ww1LU+p*nvars),(ww2LU+p*nvars),(ww3LU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
-      _WENOWeights_v_M_((ww1RU+p*nvars),(ww2RU+p*nvars),(ww3RU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      if (weno->single) {
+        _WENOWeights_v_M_((sw1+oLF+p*nvars),(sw2+oLF+p*nvars),(sw3+oLF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
+        _WENOWeights_v_M_((sw1+oRF+p*nvars),(sw2+oRF+p*nvars),(sw3+oRF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
+        _WENOWeights_v_M_((sw1+oLU+p*nvars),(sw2+oLU+p*nvars),(sw3+oLU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
+        _WENOWeights_v_M_((sw1+oRU+p*nvars),(sw2+oRU+p*nvars),(sw3+oRU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      } else {
+        _WENOWeights_v_M_((ww1+oLF+p*nvars),(ww2+oLF+p*nvars),(ww3+oLF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
+        _WENOWeights_v_M_((ww1+oRF+p*nvars),(ww2+oRF+p*nvars),(ww3+oRF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
+        _WENOWeights_v_M_((ww1+oLU+p*nvars),(ww2+oLU+p*nvars),(ww3+oLU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
+        _WENOWeights_v_M_((ww1+oRU+p*nvars),(ww2+oRU+p*nvars),(ww3+oRU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      }
     }
   }
 
-#if defined(CPU_STAT)
-  endTime = clock();
-  printf("WENOFifthOrderCalculateWeightsM CPU time = %8.6f dir = %d\n",
-         (double)(endTime - startTime) / CLOCKS_PER_SEC, dir);
-#endif
-
   return(0);
 }
 
@@ -444,8 +450,8 @@ int WENOFifthOrderCalculateWeightsZ(
   WENOParameters  *weno   = (WENOParameters*) solver->interp;
   MPIVariables    *mpi    = (MPIVariables*)   m;
   int             i;
-  double          *ww1LF, *ww2LF, *ww3LF, *ww1RF, *ww2RF, *ww3RF;
-  double          *ww1LU, *ww2LU, *ww3LU, *ww1RU, *ww2RU, *ww3RU;
+  double          *ww1 = weno->w1,  *ww2 = weno->w2,  *ww3 = weno->w3;
+  float           *sw1 = weno->w1s, *sw2 = weno->w2s, *sw3 = weno->w3s;
 
   int ghosts = solver->ghosts;
   int ndims  = solver->ndims;
@@ -459,6 +465,8 @@ int WENOFifthOrderCalculateWeightsZ(
 
   /* calculate dimension offset */
   int offset = weno->offset[dir];
+  /* flags of the smoothness sensor of the hybrid scheme */
+  int *hybrid_flag = (weno->hybrid ? weno->hybrid_flag + offset/nvars : NULL);
 
   /* create index and bounds for the outer loop, i.e., to loop over all 1D lines along
      dimension "dir"                                                                    */
@@ -467,19 +475,10 @@ int WENOFifthOrderCalculateWeightsZ(
   _ArrayCopy1D_(dim,bounds_inter,ndims); bounds_inter[dir] += 1;
   int N_outer; _ArrayProduct1D_(bounds_outer,ndims,N_outer);
 
-  ww1LF = weno->w1 + offset;
-  ww2LF = weno->w2 + offset;
-  ww3LF = weno->w3 + offset;
-  ww1RF = weno->w1 + 2*weno->size + offset;
-  ww2RF = weno->w2 + 2*weno->size + offset;
-  ww3RF = weno->w3 + 2*weno->size + offset;
-  ww1LU = weno->w1 + weno->size + offset;
-  ww2LU = weno->w2 + weno->size + offset;
-  ww3LU = weno->w3 + weno->size + offset;
-  ww1RU = weno->w1 + 2*weno->size + weno->size + offset;
-  ww2RU = weno->w2 + 2*weno->size + weno->size + offset;
-  ww3RU = weno->w3 + 2*weno->size + weno->size + offset;
-#pragma omp parallel for schedule(auto) default(shared) private(i,index_outer,indexC,indexI)
+  /* offsets of the weights of the left- and right-biased interpolations of the flux (F)
+     and of the solution (U) */
+  int oLF = offset, oLU = weno->size + offset, oRF = 2*weno->size + offset, oRU = 3*weno->size + offset;
+#pragma omp parallel for schedule(static) default(shared) private(i,index_outer,indexC,indexI)
   for (i=0; i<N_outer; i++) {
     _ArrayIndexnD_(ndims,i,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexC,ndims);
@@ -487,6 +486,8 @@ int WENOFifthOrderCalculateWeightsZ(
     for (indexI[dir] = 0; indexI[dir] < dim[dir]+1; indexI[dir]++) {
       int qm1L,qm2L,qm3L,qp1L,qp2L,p,qm1R,qm2R,qm3R,qp1R,qp2R;
       _ArrayIndex1D_(ndims,bounds_inter,indexI,0,p);
+      /* smooth interface (hybrid scheme): the optimal weights are set by WENOHybridSensor() */
+      if (hybrid_flag && (!hybrid_flag[p])) continue;
       indexC[dir] = indexI[dir]-1; _ArrayIndex1D_(ndims,dim,indexC,ghosts,qm1L);
       qm3L = qm1L - 2*stride[dir];
       qm2L = qm1L -   stride[dir];
@@ -548,10 +549,17 @@ int WENOFifthOrderCalculateWeightsZ(
       }
 
       /* calculate WENO weights */
-      _WENOWeights_v_Z_((ww1LF+p*nvars),(ww2LF+p*nvars),(ww3LF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
-      _WENOWeights_v_Z_((ww1RF+p*nvars),(ww2RF+p*nvars),(ww3RF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
-      _WENOWeights_v_Z_((ww1LU+p*nvars),(ww2LU+p*nvars),(ww3LU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
-      _WENOWeights_v_Z_((ww1RU+p*nvars),(ww2RU+p*nvars),(ww3RU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      if (weno->single) {
+        _WENOWeights_v_Z_((sw1+oLF+p*nvars),(sw2+oLF+p*nvars),(sw3+oLF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
+        _WENOWeights_v_Z_((sw1+oRF+p*nvars),(sw2+oRF+p*nvars),(sw3+oRF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
+        _WENOWeights_v_Z_((sw1+oLU+p*nvars),(sw2+oLU+p*nvars),(sw3+oLU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
+        _WENOWeights_v_Z_((sw1+oRU+p*nvars),(sw2+oRU+p*nvars),(sw3+oRU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      } else {
+        _WENOWeights_v_Z_((ww1+oLF+p*nvars),(ww2+oLF+p*nvars),(ww3+oLF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
+        _WENOWeights_v_Z_((ww1+oRF+p*nvars),(ww2+oRF+p*nvars),(ww3+oRF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
+        _WENOWeights_v_Z_((ww1+oLU+p*nvars),(ww2+oLU+p*nvars),(ww3+oLU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
+        _WENOWeights_v_Z_((ww1+oRU+p*nvars),(ww2+oRU+p*nvars),(ww3+oRU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      }
     }
   }
 
@@ -600,8 +608,8 @@ int WENOFifthOrderCalculateWeightsYC(
   WENOParameters  *weno   = (WENOParameters*) solver->interp;
   MPIVariables    *mpi    = (MPIVariables*)   m;
   int             i;
-  double          *ww1LF, *ww2LF, *ww3LF, *ww1RF, *ww2RF, *ww3RF;
-  double          *ww1LU, *ww2LU, *ww3LU, *ww1RU, *ww2RU, *ww3RU;
+  double          *ww1 = weno->w1,  *ww2 = weno->w2,  *ww3 = weno->w3;
+  float           *sw1 = weno->w1s, *sw2 = weno->w2s, *sw3 = weno->w3s;
 
   int ghosts = solver->ghosts;
   int ndims  = solver->ndims;
@@ -615,6 +623,8 @@ int WENOFifthOrderCalculateWeightsYC(
 
   /* calculate dimension offset */
   int offset = weno->offset[dir];
+  /* flags of the smoothness sensor of the hybrid scheme */
+  int *hybrid_flag = (weno->hybrid ? weno->hybrid_flag + offset/nvars : NULL);
 
   /* create index and bounds for the outer loop, i.e., to loop over all 1D lines along
      dimension "dir"                                                                    */
@@ -623,25 +633,11 @@ int WENOFifthOrderCalculateWeightsYC(
   _ArrayCopy1D_(dim,bounds_inter,ndims); bounds_inter[dir] += 1;
   int N_outer; _ArrayProduct1D_(bounds_outer,ndims,N_outer);
 
-  ww1LF = weno->w1 + offset;
-  ww2LF = weno->w2 + offset;
-  ww3LF = weno->w3 + offset;
-  ww1RF = weno->w1 + 2*weno->size + offset;
-  ww2RF = weno->w2 + 2*weno->size + offset;
-  ww3RF = weno->w3 + 2*weno->size + offset;
-  ww1LU = weno->w1 + weno->size + offset;
-  ww2LU = weno->w2 + weno->size + offset;
-  ww3LU = weno->w3 + weno->size + offset;
-  ww1RU = weno->w1 + 2*weno->size + weno->size + offset;
-  ww2RU = weno->w2 + 2*weno->size + weno->size + offset;
-  ww3RU = weno->w3 + 2*weno->size + weno->size + offset;
-
-#if defined(CPU_STAT)
-  clock_t cpu_start, cpu_end;
-  cpu_start = clock();
-#endif
-
-#pragma omp parallel for schedule(auto) default(shared) private(i,index_outer,indexC,indexI)
+  /* offsets of the weights of the left- and right-biased interpolations of the flux (F)
+     and of the solution (U) */
+  int oLF = offset, oLU = weno->size + offset, oRF = 2*weno->size + offset, oRU = 3*weno->size + offset;
+
+#pragma omp parallel for schedule(static) default(shared) private(i,index_outer,indexC,indexI)
   for (i=0; i<N_outer; i++) {
     _ArrayIndexnD_(ndims,i,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexC,ndims);
@@ -649,6 +645,8 @@ int WENOFifthOrderCalculateWeightsYC(
     for (indexI[dir] = 0; indexI[dir] < dim[dir]+1; indexI[dir]++) {
       int qm1L,qm2L,qm3L,qp1L,qp2L,p,qm1R,qm2R,qm3R,qp1R,qp2R;
       _ArrayIndex1D_(ndims,bounds_inter,indexI,0,p);
+      /* smooth interface (hybrid scheme): the optimal weights are set by WENOHybridSensor() */
+      if (hybrid_flag && (!hybrid_flag[p])) continue;
       indexC[dir] = indexI[dir]-1; _ArrayIndex1D_(ndims,dim,indexC,ghosts,qm1L);
       qm3L = qm1L - 2*stride[dir];
       qm2L = qm1L -   stride[dir];
@@ -710,19 +708,20 @@ int WENOFifthOrderCalculateWeightsYC(
       }
 
       /* calculate WENO weights */
-      _WENOWeights_v_YC_((ww1LF+p*nvars),(ww2LF+p*nvars),(ww3LF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
-      _WENOWeights_v_YC_((ww1RF+p*nvars),(ww2RF+p*nvars),(ww3RF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
-      _WENOWeights_v_YC_((ww1LU+p*nvars),(ww2LU+p*nvars),(ww3LU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
-      _WENOWeights_v_YC_((ww1RU+p*nvars),(ww2RU+p*nvars),(ww3RU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      if (weno->single) {
+        _WENOWeights_v_YC_((sw1+oLF+p*nvars),(sw2+oLF+p*nvars),(sw3+oLF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
+        _WENOWeights_v_YC_((sw1+oRF+p*nvars),(sw2+oRF+p*nvars),(sw3+oRF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
+        _WENOWeights_v_YC_((sw1+oLU+p*nvars),(sw2+oLU+p*nvars),(sw3+oLU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
+        _WENOWeights_v_YC_((sw1+oRU+p*nvars),(sw2+oRU+p*nvars),(sw3+oRU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      } else {
+        _WENOWeights_v_YC_((ww1+oLF+p*nvars),(ww2+oLF+p*nvars),(ww3+oLF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
+        _WENOWeights_v_YC_((ww1+oRF+p*nvars),(ww2+oRF+p*nvars),(ww3+oRF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
+        _WENOWeights_v_YC_((ww1+oLU+p*nvars),(ww2+oLU+p*nvars),(ww3+oLU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
+        _WENOWeights_v_YC_((ww1+oRU+p*nvars),(ww2+oRU+p*nvars),(ww3+oRU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      }
     }
   }
 
-#if defined(CPU_STAT)
-  cpu_end = clock();
-  printf("WENOFifthOrderCalculateWeightsYC:\n");
-  printf("  CPU time = %8.6lf dir = %d\n", (double)(cpu_end - cpu_start) / CLOCKS_PER_SEC, dir);
-#endif
-
   return(0);
 }
 
@@ -770,8 +769,8 @@ int WENOFifthOrderCalculateWeightsCharJS(
   WENOParameters  *weno   = (WENOParameters*) solver->interp;
   MPIVariables    *mpi    = (MPIVariables*)   m;
   int             i;
-  double          *ww1LF, *ww2LF, *ww3LF, *ww1RF, *ww2RF, *ww3RF;
-  double          *ww1LU, *ww2LU, *ww3LU, *ww1RU, *ww2RU, *ww3RU;
+  double          *ww1 = weno->w1,  *ww2 = weno->w2,  *ww3 = weno->w3;
+  float           *sw1 = weno->w1s, *sw2 = weno->w2s, *sw3 = weno->w3s;
 
   int ghosts = solver->ghosts;
   int ndims  = solver->ndims;
@@ -785,6 +784,8 @@ int WENOFifthOrderCalculateWeightsCharJS(
 
   /* calculate dimension offset */
   int offset = weno->offset[dir];
+  /* flags of the smoothness sensor of the hybrid scheme */
+  int *hybrid_flag = (weno->hybrid ? weno->hybrid_flag + offset/nvars : NULL);
 
   /* create index and bounds for the outer loop, i.e., to loop over all 1D lines along
      dimension "dir"                                                                    */
@@ -796,19 +797,10 @@ int WENOFifthOrderCalculateWeightsCharJS(
   /* allocate arrays for the averaged state, eigenvectors and characteristic interpolated f */
   double L[nvars*nvars], uavg[nvars];
 
-  ww1LF = weno->w1 + offset;
-  ww2LF = weno->w2 + offset;
-  ww3LF = weno->w3 + offset;
-  ww1RF = weno->w1 + 2*weno->size + offset;
-  ww2RF = weno->w2 + 2*weno->size + offset;
-  ww3RF = weno->w3 + 2*weno->size + offset;
-  ww1LU = weno->w1 + weno->size + offset;
-  ww2LU = weno->w2 + weno->size + offset;
-  ww3LU = weno->w3 + weno->size + offset;
-  ww1RU = weno->w1 + 2*weno->size + weno->size + offset;
-  ww2RU = weno->w2 + 2*weno->size + weno->size + offset;
-  ww3RU = weno->w3 + 2*weno->size + weno->size + offset;
-#pragma omp parallel for schedule(auto) default(shared) private(i,index_outer,indexC,indexI)
+  /* offsets of the weights of the left- and right-biased interpolations of the flux (F)
+     and of the solution (U) */
+  int oLF = offset, oLU = weno->size + offset, oRF = 2*weno->size + offset, oRU = 3*weno->size + offset;
+#pragma omp parallel for schedule(static) default(shared) private(i,L,uavg,index_outer,indexC,indexI)
   for (i=0; i<N_outer; i++) {
     _ArrayIndexnD_(ndims,i,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexC,ndims);
@@ -816,6 +808,8 @@ int WENOFifthOrderCalculateWeightsCharJS(
     for (indexI[dir] = 0; indexI[dir] < dim[dir]+1; indexI[dir]++) {
       int qm1L,qm2L,qm3L,qp1L,qp2L,p,qm1R,qm2R,qm3R,qp1R,qp2R;
       _ArrayIndex1D_(ndims,bounds_inter,indexI,0,p);
+      /* smooth interface (hybrid scheme): the optimal weights are set by WENOHybridSensor() */
+      if (hybrid_flag && (!hybrid_flag[p])) continue;
       indexC[dir] = indexI[dir]-1; _ArrayIndex1D_(ndims,dim,indexC,ghosts,qm1L);
       qm3L = qm1L - 2*stride[dir];
       qm2L = qm1L -   stride[dir];
@@ -828,9 +822,12 @@ int WENOFifthOrderCalculateWeightsCharJS(
       qp1R = qm1R -   stride[dir];
       qp2R = qm1R - 2*stride[dir];
 
-      /* find averaged state and left eigenvectors at this interface */
-      IERR solver->AveragingFunction(uavg,(uC+nvars*qm1L),(uC+nvars*qp1L),solver->physics); CHECKERR(ierr);
-      IERR solver->GetLeftEigenvectors(uavg,L,solver->physics,dir); CHECKERR(ierr);
+      /* find averaged state and left eigenvectors at this interface
+         (fetch them from the interface eigensystem cache, if available) */
+      if (!EigenCacheGet(solver,dir,p,uavg,L,NULL)) {
+        IERR solver->AveragingFunction(uavg,(uC+nvars*qm1L),(uC+nvars*qp1L),solver->physics); CHECKERR(ierr);
+        IERR solver->GetLeftEigenvectors(uavg,L,solver->physics,dir); CHECKERR(ierr);
+      }
 
       /* Defining stencil points */
       double m3LF[nvars], m2LF[nvars], m1LF[nvars], p1LF[nvars], p2LF[nvars];
@@ -885,10 +882,17 @@ int WENOFifthOrderCalculateWeightsCharJS(
       }
 
       /* calculate WENO weights */
-      _WENOWeights_v_JS_((ww1LF+p*nvars),(ww2LF+p*nvars),(ww3LF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
-      _WENOWeights_v_JS_((ww1RF+p*nvars),(ww2RF+p*nvars),(ww3RF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
-      _WENOWeights_v_JS_((ww1LU+p*nvars),(ww2LU+p*nvars),(ww3LU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
-      _WENOWeights_v_JS_((ww1RU+p*nvars),(ww2RU+p*nvars),(ww3RU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      if (weno->single) {
+        _WENOWeights_v_JS_((sw1+oLF+p*nvars),(sw2+oLF+p*nvars),(sw3+oLF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
+        _WENOWeights_v_JS_((sw1+oRF+p*nvars),(sw2+oRF+p*nvars),(sw3+oRF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
+        _WENOWeights_v_JS_((sw1+oLU+p*nvars),(sw2+oLU+p*nvars),(sw3+oLU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
+        _WENOWeights_v_JS_((sw1+oRU+p*nvars),(sw2+oRU+p*nvars),(sw3+oRU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      } else {
+        _WENOWeights_v_JS_((ww1+oLF+p*nvars),(ww2+oLF+p*nvars),(ww3+oLF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
+        _WENOWeights_v_JS_((ww1+oRF+p*nvars),(ww2+oRF+p*nvars),(ww3+oRF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
+        _WENOWeights_v_JS_((ww1+oLU+p*nvars),(ww2+oLU+p*nvars),(ww3+oLU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
+        _WENOWeights_v_JS_((ww1+oRU+p*nvars),(ww2+oRU+p*nvars),(ww3+oRU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      }
     }
   }
 
@@ -940,8 +944,8 @@ int WENOFifthOrderCalculateWeightsCharM(
   WENOParameters  *weno   = (WENOParameters*) solver->interp;
   MPIVariables    *mpi    = (MPIVariables*)   m;
   int             i;
-  double          *ww1LF, *ww2LF, *ww3LF, *ww1RF, *ww2RF, *ww3RF;
-  double          *ww1LU, *ww2LU, *ww3LU, *ww1RU, *ww2RU, *ww3RU;
+  double          *ww1 = weno->w1,  *ww2 = weno->w2,  *ww3 = weno->w3;
+  float           *sw1 = weno->w1s, *sw2 = weno->w2s, *sw3 = weno->w3s;
 
   int ghosts = solver->ghosts;
   int ndims  = solver->ndims;
@@ -955,6 +959,8 @@ int WENOFifthOrderCalculateWeightsCharM(
 
   /* calculate dimension offset */
   int offset = weno->offset[dir];
+  /* flags of the smoothness sensor of the hybrid scheme */
+  int *hybrid_flag = (weno->hybrid ? weno->hybrid_flag + offset/nvars : NULL);
 
   /* create index and bounds for the outer loop, i.e., to loop over all 1D lines along
      dimension "dir"                                                                    */
@@ -966,19 +972,10 @@ int WENOFifthOrderCalculateWeightsCharM(
   /* allocate arrays for the averaged state, eigenvectors and characteristic interpolated f */
   double L[nvars*nvars], uavg[nvars];
 
-  ww1LF = weno->w1 + offset;
-  ww2LF = weno->w2 + offset;
-  ww3LF = weno->w3 + offset;
-  ww1RF = weno->w1 + 2*weno->size + offset;
-  ww2RF = weno->w2 + 2*weno->size + offset;
-  ww3RF = weno->w3 + 2*weno->size + offset;
-  ww1LU = weno->w1 + weno->size + offset;
-  ww2LU = weno->w2 + weno->size + offset;
-  ww3LU = weno->w3 + weno->size + offset;
-  ww1RU = weno->w1 + 2*weno->size + weno->size + offset;
-  ww2RU = weno->w2 + 2*weno->size + weno->size + offset;
-  ww3RU = weno->w3 + 2*weno->size + weno->size + offset;
-#pragma omp parallel for schedule(auto) default(shared) private(i,index_outer,indexC,indexI)
+  /* offsets of the weights of the left- and right-biased interpolations of the flux (F)
+     and of the solution (U) */
+  int oLF = offset, oLU = weno->size + offset, oRF = 2*weno->size + offset, oRU = 3*weno->size + offset;
+#pragma omp parallel for schedule(static) default(shared) private(i,L,uavg,index_outer,indexC,indexI)
   for (i=0; i<N_outer; i++) {
     _ArrayIndexnD_(ndims,i,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexC,ndims);
@@ -986,6 +983,8 @@ int WENOFifthOrderCalculateWeightsCharM(
     for (indexI[dir] = 0; indexI[dir] < dim[dir]+1; indexI[dir]++) {
       int qm1L,qm2L,qm3L,qp1L,qp2L,p,qm1R,qm2R,qm3R,qp1R,qp2R;
       _ArrayIndex1D_(ndims,bounds_inter,indexI,0,p);
+      /* smooth interface (hybrid scheme): the optimal weights are set by WENOHybridSensor() */
+      if (hybrid_flag && (!hybrid_flag[p])) continue;
       indexC[dir] = indexI[dir]-1; _ArrayIndex1D_(ndims,dim,indexC,ghosts,qm1L);
       qm3L = qm1L - 2*stride[dir];
       qm2L = qm1L -   stride[dir];
@@ -998,9 +997,12 @@ int WENOFifthOrderCalculateWeightsCharM(
       qp1R = qm1R -   stride[dir];
       qp2R = qm1R - 2*stride[dir];
 
-      /* find averaged state and left eigenvectors at this interface */
-      IERR solver->AveragingFunction(uavg,(uC+nvars*qm1L),(uC+nvars*qp1L),solver->physics); CHECKERR(ierr);
-      IERR solver->GetLeftEigenvectors(uavg,L,solver->physics,dir); CHECKERR(ierr);
+      /* find averaged state and left eigenvectors at this interface
+         (fetch them from the interface eigensystem cache, if available) */
+      if (!EigenCacheGet(solver,dir,p,uavg,L,NULL)) {
+        IERR solver->AveragingFunction(uavg,(uC+nvars*qm1L),(uC+nvars*qp1L),solver->physics); CHECKERR(ierr);
+        IERR solver->GetLeftEigenvectors(uavg,L,solver->physics,dir); CHECKERR(ierr);
+      }
 
       /* Defining stencil points */
       double m3LF[nvars], m2LF[nvars], m1LF[nvars], p1LF[nvars], p2LF[nvars];
@@ -1055,10 +1057,17 @@ int WENOFifthOrderCalculateWeightsCharM(
       }
 
       /* calculate WENO weights */
-      _WENOWeights_v_M_((ww1LF+p*nvars),(ww2LF+p*nvars),(ww3LF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
-      _WENOWeights_v_M_((ww1RF+p*nvars),(ww2RF+p*nvars),(ww3RF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
-      _WENOWeights_v_M_((ww1LU+p*nvars),(ww2LU+p*nvars),(ww3LU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
-      _WENOWeights_v_M_((ww1RU+p*nvars),(ww2RU+p*nvars),(ww3RU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      if (weno->single) {
+        _WENOWeights_v_M_((sw1+oLF+p*nvars),(sw2+oLF+p*nvars),(sw3+oLF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
+        _WENOWeights_v_M_((sw1+oRF+p*nvars),(sw2+oRF+p*nvars),(sw3+oRF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
+        _WENOWeights_v_M_((sw1+oLU+p*nvars),(sw2+oLU+p*nvars),(sw3+oLU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
+        _WENOWeights_v_M_((sw1+oRU+p*nvars),(sw2+oRU+p*nvars),(sw3+oRU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      } else {
+        _WENOWeights_v_M_((ww1+oLF+p*nvars),(ww2+oLF+p*nvars),(ww3+oLF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
+        _WENOWeights_v_M_((ww1+oRF+p*nvars),(ww2+oRF+p*nvars),(ww3+oRF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
+        _WENOWeights_v_M_((ww1+oLU+p*nvars),(ww2+oLU+p*nvars),(ww3+oLU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
+        _WENOWeights_v_M_((ww1+oRU+p*nvars),(ww2+oRU+p*nvars),(ww3+oRU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      }
     }
   }
 
@@ -1111,8 +1120,8 @@ int WENOFifthOrderCalculateWeightsCharZ(
   WENOParameters  *weno   = (WENOParameters*) solver->interp;
   MPIVariables    *mpi    = (MPIVariables*)   m;
   int             i;
-  double          *ww1LF, *ww2LF, *ww3LF, *ww1RF, *ww2RF, *ww3RF;
-  double          *ww1LU, *ww2LU, *ww3LU, *ww1RU, *ww2RU, *ww3RU;
+  double          *ww1 = weno->w1,  *ww2 = weno->w2,  *ww3 = weno->w3;
+  float           *sw1 = weno->w1s, *sw2 = weno->w2s, *sw3 = weno->w3s;
 
   int ghosts = solver->ghosts;
   int ndims  = solver->ndims;
@@ -1126,6 +1135,8 @@ int WENOFifthOrderCalculateWeightsCharZ(
 
   /* calculate dimension offset */
   int offset = weno->offset[dir];
+  /* flags of the smoothness sensor of the hybrid scheme */
+  int *hybrid_flag = (weno->hybrid ? weno->hybrid_flag + offset/nvars : NULL);
 
   /* create index and bounds for the outer loop, i.e., to loop over all 1D lines along
      dimension "dir"                                                                    */
@@ -1137,19 +1148,10 @@ int WENOFifthOrderCalculateWeightsCharZ(
   /* allocate arrays for the averaged state, eigenvectors and characteristic interpolated f */
   double L[nvars*nvars], uavg[nvars];
 
-  ww1LF = weno->w1 + offset;
-  ww2LF = weno->w2 + offset;
-  ww3LF = weno->w3 + offset;
-  ww1RF = weno->w1 + 2*weno->size + offset;
-  ww2RF = weno->w2 + 2*weno->size + offset;
-  ww3RF = weno->w3 + 2*weno->size + offset;
-  ww1LU = weno->w1 + weno->size + offset;
-  ww2LU = weno->w2 + weno->size + offset;
-  ww3LU = weno->w3 + weno->size + offset;
-  ww1RU = weno->w1 + 2*weno->size + weno->size + offset;
-  ww2RU = weno->w2 + 2*weno->size + weno->size + offset;
-  ww3RU = weno->w3 + 2*weno->size + weno->size + offset;
-#pragma omp parallel for schedule(auto) default(shared) private(i,index_outer,indexC,indexI)
+  /* offsets of the weights of the left- and right-biased interpolations of the flux (F)
+     and of the solution (U) */
+  int oLF = offset, oLU = weno->size + offset, oRF = 2*weno->size + offset, oRU = 3*weno->size + offset;
+#pragma omp parallel for schedule(static) default(shared) private(i,L,uavg,index_outer,indexC,indexI)
   for (i=0; i<N_outer; i++) {
     _ArrayIndexnD_(ndims,i,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexC,ndims);
@@ -1157,6 +1159,8 @@ int WENOFifthOrderCalculateWeightsCharZ(
     for (indexI[dir] = 0; indexI[dir] < dim[dir]+1; indexI[dir]++) {
       int qm1L,qm2L,qm3L,qp1L,qp2L,p,qm1R,qm2R,qm3R,qp1R,qp2R;
       _ArrayIndex1D_(ndims,bounds_inter,indexI,0,p);
+      /* smooth interface (hybrid scheme): the optimal weights are set by WENOHybridSensor() */
+      if (hybrid_flag && (!hybrid_flag[p])) continue;
       indexC[dir] = indexI[dir]-1; _ArrayIndex1D_(ndims,dim,indexC,ghosts,qm1L);
       qm3L = qm1L - 2*stride[dir];
       qm2L = qm1L -   stride[dir];
@@ -1169,9 +1173,12 @@ int WENOFifthOrderCalculateWeightsCharZ(
       qp1R = qm1R -   stride[dir];
       qp2R = qm1R - 2*stride[dir];
 
-      /* find averaged state and left eigenvectors at this interface */
-      IERR solver->AveragingFunction(uavg,(uC+nvars*qm1L),(uC+nvars*qp1L),solver->physics); CHECKERR(ierr);
-      IERR solver->GetLeftEigenvectors(uavg,L,solver->physics,dir); CHECKERR(ierr);
+      /* find averaged state and left eigenvectors at this interface
+         (fetch them from the interface eigensystem cache, if available) */
+      if (!EigenCacheGet(solver,dir,p,uavg,L,NULL)) {
+        IERR solver->AveragingFunction(uavg,(uC+nvars*qm1L),(uC+nvars*qp1L),solver->physics); CHECKERR(ierr);
+        IERR solver->GetLeftEigenvectors(uavg,L,solver->physics,dir); CHECKERR(ierr);
+      }
 
       /* Defining stencil points */
       double m3LF[nvars], m2LF[nvars], m1LF[nvars], p1LF[nvars], p2LF[nvars];
@@ -1226,10 +1233,17 @@ int WENOFifthOrderCalculateWeightsCharZ(
       }
 
       /* calculate WENO weights */
-      _WENOWeights_v_Z_((ww1LF+p*nvars),(ww2LF+p*nvars),(ww3LF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
-      _WENOWeights_v_Z_((ww1RF+p*nvars),(ww2RF+p*nvars),(ww3RF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
-      _WENOWeights_v_Z_((ww1LU+p*nvars),(ww2LU+p*nvars),(ww3LU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
-      _WENOWeights_v_Z_((ww1RU+p*nvars),(ww2RU+p*nvars),(ww3RU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      if (weno->single) {
+        _WENOWeights_v_Z_((sw1+oLF+p*nvars),(sw2+oLF+p*nvars),(sw3+oLF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
+        _WENOWeights_v_Z_((sw1+oRF+p*nvars),(sw2+oRF+p*nvars),(sw3+oRF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
+        _WENOWeights_v_Z_((sw1+oLU+p*nvars),(sw2+oLU+p*nvars),(sw3+oLU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
+        _WENOWeights_v_Z_((sw1+oRU+p*nvars),(sw2+oRU+p*nvars),(sw3+oRU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      } else {
+        _WENOWeights_v_Z_((ww1+oLF+p*nvars),(ww2+oLF+p*nvars),(ww3+oLF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
+        _WENOWeights_v_Z_((ww1+oRF+p*nvars),(ww2+oRF+p*nvars),(ww3+oRF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
+        _WENOWeights_v_Z_((ww1+oLU+p*nvars),(ww2+oLU+p*nvars),(ww3+oLU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
+        _WENOWeights_v_Z_((ww1+oRU+p*nvars),(ww2+oRU+p*nvars),(ww3+oRU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      }
     }
   }
 
@@ -1282,8 +1296,8 @@ int WENOFifthOrderCalculateWeightsCharYC(
   WENOParameters  *weno   = (WENOParameters*) solver->interp;
   MPIVariables    *mpi    = (MPIVariables*)   m;
   int             i;
-  double          *ww1LF, *ww2LF, *ww3LF, *ww1RF, *ww2RF, *ww3RF;
-  double          *ww1LU, *ww2LU, *ww3LU, *ww1RU, *ww2RU, *ww3RU;
+  double          *ww1 = weno->w1,  *ww2 = weno->w2,  *ww3 = weno->w3;
+  float           *sw1 = weno->w1s, *sw2 = weno->w2s, *sw3 = weno->w3s;
 
   int ghosts = solver->ghosts;
   int ndims  = solver->ndims;
@@ -1297,6 +1311,8 @@ int WENOFifthOrderCalculateWeightsCharYC(
 
   /* calculate dimension offset */
   int offset = weno->offset[dir];
+  /* flags of the smoothness sensor of the hybrid scheme */
+  int *hybrid_flag = (weno->hybrid ? weno->hybrid_flag + offset/nvars : NULL);
 
   /* create index and bounds for the outer loop, i.e., to loop over all 1D lines along
      dimension "dir"                                                                    */
@@ -1308,19 +1324,10 @@ int WENOFifthOrderCalculateWeightsCharYC(
   /* allocate arrays for the averaged state, eigenvectors and characteristic interpolated f */
   double L[nvars*nvars], uavg[nvars];
 
-  ww1LF = weno->w1 + offset;
-  ww2LF = weno->w2 + offset;
-  ww3LF = weno->w3 + offset;
-  ww1RF = weno->w1 + 2*weno->size + offset;
-  ww2RF = weno->w2 + 2*weno->size + offset;
-  ww3RF = weno->w3 + 2*weno->size + offset;
-  ww1LU = weno->w1 + weno->size + offset;
-  ww2LU = weno->w2 + weno->size + offset;
-  ww3LU = weno->w3 + weno->size + offset;
-  ww1RU = weno->w1 + 2*weno->size + weno->size + offset;
-  ww2RU = weno->w2 + 2*weno->size + weno->size + offset;
-  ww3RU = weno->w3 + 2*weno->size + weno->size + offset;
-#pragma omp parallel for schedule(auto) default(shared) private(i,index_outer,indexC,indexI)
+  /* offsets of the weights of the left- and right-biased interpolations of the flux (F)
+     and of the solution (U) */
+  int oLF = offset, oLU = weno->size + offset, oRF = 2*weno->size + offset, oRU = 3*weno->size + offset;
+#pragma omp parallel for schedule(static) default(shared) private(i,L,uavg,index_outer,indexC,indexI)
   for (i=0; i<N_outer; i++) {
     _ArrayIndexnD_(ndims,i,bounds_outer,index_outer,0);
     _ArrayCopy1D_(index_outer,indexC,ndims);
@@ -1328,6 +1335,8 @@ int WENOFifthOrderCalculateWeightsCharYC(
     for (indexI[dir] = 0; indexI[dir] < dim[dir]+1; indexI[dir]++) {
       int qm1L,qm2L,qm3L,qp1L,qp2L,p,qm1R,qm2R,qm3R,qp1R,qp2R;
       _ArrayIndex1D_(ndims,bounds_inter,indexI,0,p);
+      /* smooth interface (hybrid scheme): the optimal weights are set by WENOHybridSensor() */
+      if (hybrid_flag && (!hybrid_flag[p])) continue;
       indexC[dir] = indexI[dir]-1; _ArrayIndex1D_(ndims,dim,indexC,ghosts,qm1L);
       qm3L = qm1L - 2*stride[dir];
       qm2L = qm1L -   stride[dir];
@@ -1340,9 +1349,12 @@ int WENOFifthOrderCalculateWeightsCharYC(
       qp1R = qm1R -   stride[dir];
       qp2R = qm1R - 2*stride[dir];
 
-      /* find averaged state and left eigenvectors at this interface */
-      IERR solver->AveragingFunction(uavg,(uC+nvars*qm1L),(uC+nvars*qp1L),solver->physics); CHECKERR(ierr);
-      IERR solver->GetLeftEigenvectors(uavg,L,solver->physics,dir); CHECKERR(ierr);
+      /* find averaged state and left eigenvectors at this interface
+         (fetch them from the interface eigensystem cache, if available) */
+      if (!EigenCacheGet(solver,dir,p,uavg,L,NULL)) {
+        IERR solver->AveragingFunction(uavg,(uC+nvars*qm1L),(uC+nvars*qp1L),solver->physics); CHECKERR(ierr);
+        IERR solver->GetLeftEigenvectors(uavg,L,solver->physics,dir); CHECKERR(ierr);
+      }
 
       /* Defining stencil points */
       double m3LF[nvars], m2LF[nvars], m1LF[nvars], p1LF[nvars], p2LF[nvars];
@@ -1397,10 +1409,17 @@ int WENOFifthOrderCalculateWeightsCharYC(
       }
 
       /* calculate WENO weights */
-      _WENOWeights_v_YC_((ww1LF+p*nvars),(ww2LF+p*nvars),(ww3LF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
-      _WENOWeights_v_YC_((ww1RF+p*nvars),(ww2RF+p*nvars),(ww3RF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
-      _WENOWeights_v_YC_((ww1LU+p*nvars),(ww2LU+p*nvars),(ww3LU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
-      _WENOWeights_v_YC_((ww1RU+p*nvars),(ww2RU+p*nvars),(ww3RU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      if (weno->single) {
+        _WENOWeights_v_YC_((sw1+oLF+p*nvars),(sw2+oLF+p*nvars),(sw3+oLF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
+        _WENOWeights_v_YC_((sw1+oRF+p*nvars),(sw2+oRF+p*nvars),(sw3+oRF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
+        _WENOWeights_v_YC_((sw1+oLU+p*nvars),(sw2+oLU+p*nvars),(sw3+oLU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
+        _WENOWeights_v_YC_((sw1+oRU+p*nvars),(sw2+oRU+p*nvars),(sw3+oRU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      } else {
+        _WENOWeights_v_YC_((ww1+oLF+p*nvars),(ww2+oLF+p*nvars),(ww3+oLF+p*nvars),c1,c2,c3,m3LF,m2LF,m1LF,p1LF,p2LF,weno->eps,nvars);
+        _WENOWeights_v_YC_((ww1+oRF+p*nvars),(ww2+oRF+p*nvars),(ww3+oRF+p*nvars),c1,c2,c3,m3RF,m2RF,m1RF,p1RF,p2RF,weno->eps,nvars);
+        _WENOWeights_v_YC_((ww1+oLU+p*nvars),(ww2+oLU+p*nvars),(ww3+oLU+p*nvars),c1,c2,c3,m3LU,m2LU,m1LU,p1LU,p2LU,weno->eps,nvars);
+        _WENOWeights_v_YC_((ww1+oRU+p*nvars),(ww2+oRU+p*nvars),(ww3+oRU+p*nvars),c1,c2,c3,m3RU,m2RU,m1RU,p1RU,p2RU,weno->eps,nvars);
+      }
     }
   }
 
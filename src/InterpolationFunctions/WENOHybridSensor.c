@@ -0,0 +1,227 @@
+/*! @file WENOHybridSensor.c
+    @brief Smoothness sensor of the hybrid WENO-type schemes
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <basic.h>
+#include <arrayfunctions.h>
+#include <interpolation.h>
+#include <mpivars.h>
+#include <hypar.h>
+
+/*!
+  Compute the smoothness sensor of the hybrid WENO-type schemes (#WENOParameters::hybrid) along
+  a spatial dimension, and set the weights of the smooth interfaces to their optimal values.
+
+  A cell \f$j\f$ is non-smooth if, for any solution component \f$u\f$,
+  \f{equation}{
+    \left|u_{j+1}-2u_j+u_{j-1}\right| > 4 \tau \max\left(U_j,\tau U_{{\rm all},j},\epsilon\right),
+    \quad U_j = \max\left(\left|u_{j-1}\right|,\left|u_j\right|,\left|u_{j+1}\right|\right),
+  \f}
+  where \f$\tau\f$ is #WENOParameters::hybrid_tol (\b hybrid_tol in "weno.inp", default 0.01),
+  \f$U_{{\rm all},j}\f$ is the largest \f$U_j\f$ of all the components, and \f$\epsilon\f$ is
+  #_MACHINE_ZERO_: the normalized second difference is of the order of the square of the grid spacing
+  where the solution is smooth and resolved, and of the order of the relative jump at a discontinuity.
+  (It is normalized by the magnitude of the component over the stencil of the second difference rather
+  than at the cell, so that components that change sign, such as the momentum, are not flagged where
+  they cross zero; the floor \f$\tau U_{{\rm all},j}\f$ keeps the round-off errors of components that
+  are zero up to round-off, such as the momentum ahead of a shock, from being flagged, and the absolute
+  floor \f$\epsilon\f$ does the same where all the components are.) The threshold depends only on the
+  solution in the stencil of the cell, and not on how the domain is decomposed, so the ranks that
+  share an interface flag it in the same way (a scale over the grid line would be local to each rank
+  and break conservation at the interfaces between ranks). The interface
+  \f$j+1/2\f$ is flagged (#WENOParameters::hybrid_flag) if any of the cells \f$j-1,\dots,j+2\f$ is
+  non-smooth, i.e., if the sensor detects a discontinuity in the stencils of the left- and
+  right-biased interpolations (cells \f$j-2,\dots,j+3\f$).
+
+  The nonlinear weights are then computed only at the flagged interfaces (see
+  WENOFifthOrderCalculateWeights() and WENOFifthOrderCalculateWeightsChar()); at the smooth
+  interfaces, the weights are set here to the optimal weights, so that the interpolation is the
+  linear 5th order one (and the characteristic decomposition is skipped by
+  Interp1PrimFifthOrderWENOChar(), since the linear interpolation of the characteristic and of the
+  conserved variables are the same). The sensor is computed along each grid line first, with a loop
+  over the cells without branches.
+
+  The numbers of flagged interfaces and of interfaces along \a dir are accumulated in
+  #WENOParameters::hybrid_count (see WENOHybridPostStep()).
+*/
+int WENOHybridSensor(
+                      double  *uC,  /*!< Array of cell-centered values of the solution \f${\bf u}\f$ */
+                      int     dir,  /*!< Spatial dimension along which to interpolation */
+                      void    *s,   /*!< Object of type #HyPar containing solver-related variables */
+                      void    *m    /*!< Object of type #MPIVariables containing MPI-related variables */
+                    )
+{
+  HyPar           *solver = (HyPar*)          s;
+  WENOParameters  *weno   = (WENOParameters*) solver->interp;
+  MPIVariables    *mpi    = (MPIVariables*)   m;
+  int             i;
+
+  int ghosts = solver->ghosts;
+  int ndims  = solver->ndims;
+  int nvars  = solver->nvars;
+  int *dim   = solver->dim_local;
+  int *stride= solver->stride_with_ghosts;
+  double tol = weno->hybrid_tol;
+
+  int offset = weno->offset[dir];
+  int *flag  = weno->hybrid_flag + offset/nvars;
+  int crweno = (!strcmp(solver->spatial_scheme_hyp,_FIFTH_ORDER_CRWENO_));
+
+  /* create index and bounds for the outer loop, i.e., to loop over all 1D lines along
+     dimension "dir"                                                                    */
+  int indexC[ndims], indexI[ndims], index_outer[ndims], bounds_outer[ndims], bounds_inter[ndims];
+  _ArrayCopy1D_(dim,bounds_outer,ndims); bounds_outer[dir] =  1;
+  _ArrayCopy1D_(dim,bounds_inter,ndims); bounds_inter[dir] =  dim[dir] + 1;
+  int N_outer; _ArrayProduct1D_(bounds_outer,ndims,N_outer);
+
+  double nflagged = 0;
+#pragma omp parallel for schedule(static) default(shared) private(i,index_outer,indexC,indexI) reduction(+:nflagged)
+  for (i=0; i<N_outer; i++) {
+    _ArrayIndexnD_(ndims,i,bounds_outer,index_outer,0);
+    _ArrayCopy1D_(index_outer,indexC,ndims);
+    _ArrayCopy1D_(index_outer,indexI,ndims);
+
+    /* sensor of the cells -2,...,dim+1 of this line */
+    int n = dim[dir]+4, j, v, q0;
+    int sensor[n];
+    indexC[dir] = -2; _ArrayIndex1D_(ndims,dim,indexC,ghosts,q0);
+    int    sv = nvars*stride[dir];
+    double scale_all[n];
+    for (j = 0; j < n; j++) {
+      sensor[j] = 0;
+      scale_all[j] = 0;
+    }
+    for (v = 0; v < nvars; v++) {
+      double *u = uC + nvars*q0 + v;
+      for (j = 0; j < n; j++) {
+        double scale = fmax(fabs(u[(j-1)*sv]),fmax(fabs(u[j*sv]),fabs(u[(j+1)*sv])));
+        scale_all[j] = fmax(scale_all[j],scale);
+      }
+    }
+    for (v = 0; v < nvars; v++) {
+      double *u = uC + nvars*q0 + v;
+      for (j = 0; j < n; j++) {
+        double um1 = u[(j-1)*sv], u0 = u[j*sv], up1 = u[(j+1)*sv];
+        double scale = fmax(fabs(um1),fmax(fabs(u0),fabs(up1)));
+        double threshold = 4*tol*fmax(scale,fmax(tol*scale_all[j],_MACHINE_ZERO_));
+        sensor[j] |= (fabs(up1-2*u0+um1) > threshold);
+      }
+    }
+
+    /* flag the interfaces, and set the optimal weights at the smooth ones */
+    for (indexI[dir] = 0; indexI[dir] < dim[dir]+1; indexI[dir]++) {
+      int p, k;
+      _ArrayIndex1D_(ndims,bounds_inter,indexI,0,p);
+      j = indexI[dir];
+      flag[p] = (sensor[j] | sensor[j+1] | sensor[j+2] | sensor[j+3]);
+      nflagged += flag[p];
+      if (flag[p]) continue;
+
+      /* optimal weights */
+      double c1, c2, c3;
+      if (    crweno
+          && (!(   ((mpi->ip[dir] == 0                ) && (indexI[dir] == 0       ))
+                || ((mpi->ip[dir] == mpi->iproc[dir]-1) && (indexI[dir] == dim[dir])) )) ) {
+        /* CRWENO5 at the interior points */
+        c1 = _CRWENO_OPTIMAL_WEIGHT_1_;
+        c2 = _CRWENO_OPTIMAL_WEIGHT_2_;
+        c3 = _CRWENO_OPTIMAL_WEIGHT_3_;
+      } else {
+        /* WENO5 and HCWENO5, and CRWENO5 at the physical boundaries */
+        c1 = _WENO_OPTIMAL_WEIGHT_1_;
+        c2 = _WENO_OPTIMAL_WEIGHT_2_;
+        c3 = _WENO_OPTIMAL_WEIGHT_3_;
+      }
+
+      /* left- and right-biased, for the flux and the solution */
+      for (k = 0; k < 4; k++) {
+        long idx = k*((long)weno->size) + offset + p*nvars;
+        if (weno->single) {
+          for (v = 0; v < nvars; v++) {
+            weno->w1s[idx+v] = (float) c1;
+            weno->w2s[idx+v] = (float) c2;
+            weno->w3s[idx+v] = (float) c3;
+          }
+        } else {
+          for (v = 0; v < nvars; v++) {
+            weno->w1[idx+v] = c1;
+            weno->w2[idx+v] = c2;
+            weno->w3[idx+v] = c3;
+          }
+        }
+      }
+    }
+  }
+
+  weno->hybrid_count[2*dir+0] += nflagged;
+  weno->hybrid_count[2*dir+1] += ((double) N_outer) * ((double) (dim[dir]+1));
+
+  return(0);
+}
+
+/*! Is the hybrid scheme used by a solver object? */
+static int WENOHybridActive(HyPar *solver /*!< Object of type #HyPar */)
+{
+  if (!solver->interp) return(0);
+  if (   strcmp(solver->spatial_scheme_hyp,_FIFTH_ORDER_WENO_  )
+      && strcmp(solver->spatial_scheme_hyp,_FIFTH_ORDER_CRWENO_)
+      && strcmp(solver->spatial_scheme_hyp,_FIFTH_ORDER_HCWENO_) ) return(0);
+  return(((WENOParameters*)solver->interp)->hybrid);
+}
+
+/*! Compute the fraction of flagged interfaces once the counts posted in WENOHybridPostStep()
+    are reduced. */
+static int WENOHybridFractionReduced( double  *global,  /*!< Global numbers of flagged interfaces, and of interfaces */
+                                      int     n,        /*!< Number of values (2) */
+                                      void    *w        /*!< Object of type #WENOParameters */
+                                    )
+{
+  WENOParameters *weno = (WENOParameters*) w;
+  weno->hybrid_fraction = (global[1] > 0 ? global[0]/global[1] : 0.0);
+  return(0);
+}
+
+/*!
+  Post the reduction over all the ranks of the numbers of interfaces flagged by the smoothness
+  sensor of the hybrid scheme, and of interfaces, since the last call (over all the stages of the
+  time steps, and all the dimensions), and reset them. The fraction of flagged interfaces, i.e.,
+  of the interfaces where the nonlinear weights are computed, is then #WENOParameters::hybrid_fraction
+  (see WENOHybridFraction()); it is printed with the other diagnostics of the time step (see
+  TimePrintStep()).
+
+  Nothing is done if the hybrid scheme is not used.
+*/
+int WENOHybridPostStep( void *s, /*!< Object of type #HyPar containing solver-related variables */
+                        void *m  /*!< Object of type #MPIVariables containing MPI-related variables */
+                      )
+{
+  HyPar         *solver = (HyPar*)        s;
+  MPIVariables  *mpi    = (MPIVariables*) m;
+  if (!WENOHybridActive(solver)) return(0);
+
+  WENOParameters *weno = (WENOParameters*) solver->interp;
+  double local[2] = {0,0};
+  int    d;
+  for (d = 0; d < solver->ndims; d++) {
+    local[0] += weno->hybrid_count[2*d+0];
+    local[1] += weno->hybrid_count[2*d+1];
+  }
+  _ArraySetValue_(weno->hybrid_count,2*solver->ndims,0);
+
+  return(MPIDiagnosticsPost(NULL,local,2,_MPI_DIAG_SUM_,&mpi->world,WENOHybridFractionReduced,weno));
+}
+
+/*! Return the fraction of interfaces flagged by the smoothness sensor of the hybrid scheme at the
+    last report (see WENOHybridPostStep()), or a negative value if the hybrid scheme is not used or
+    the fraction has not been reported yet. */
+double WENOHybridFraction(void *s /*!< Object of type #HyPar containing solver-related variables */)
+{
+  HyPar *solver = (HyPar*) s;
+  if (!WENOHybridActive(solver)) return(-1);
+  return(((WENOParameters*)solver->interp)->hybrid_fraction);
+}
@@ -28,8 +28,11 @@ int gpuWENOFifthOrderCalculateWeights   (double*,double*,double*,int,void*,void*
   This function initializes the WENO-type methods.
   + Sets the parameters to default values.
   + Reads in the parameters from optional input file "weno.inp", if available.
+  + Allocates the flags of the smoothness sensor of the hybrid scheme (if \b hybrid is 1 in
+    "weno.inp", see WENOHybridSensor()).
   + Allocates memory for and initializes the nonlinear weights used by WENO-type
-    schemes.
+    schemes (in single precision if #HyPar::mixed_precision is "yes", see
+    WENOSetPrecision()).
 */
 int WENOInitialize(
                     void *s,      /*!< Solver object of type #HyPar */
@@ -59,6 +62,9 @@ int WENOInitialize(
   weno->xi          = 0.001;
   weno->tol         = 1e-16;
 
+  weno->hybrid      = 0;
+  weno->hybrid_tol  = 0.01;
+
   if (!mpi->rank) {
     FILE *in;
     int ferr;
@@ -80,6 +86,8 @@ int WENOInitialize(
           else if (!strcmp(word,"rc"         )) { ferr = fscanf(in,"%lf",&weno->rc         ); if (ferr != 1) return(1); }
           else if (!strcmp(word,"xi"         )) { ferr = fscanf(in,"%lf",&weno->xi         ); if (ferr != 1) return(1); }
           else if (!strcmp(word,"tol"        )) { ferr = fscanf(in,"%lf",&weno->tol        ); if (ferr != 1) return(1); }
+          else if (!strcmp(word,"hybrid"     )) { ferr = fscanf(in,"%d" ,&weno->hybrid     ); if (ferr != 1) return(1); }
+          else if (!strcmp(word,"hybrid_tol" )) { ferr = fscanf(in,"%lf",&weno->hybrid_tol ); if (ferr != 1) return(1); }
           else if (strcmp(word,"end")) {
             char useless[_MAX_STRING_SIZE_];
             ferr = fscanf(in,"%s",useless); if (ferr != 1) return(ferr);
@@ -95,31 +103,35 @@ int WENOInitialize(
     }
   }
 
-  int     integer_data[4];
-  double  real_data[5];
+  int     integer_data[5];
+  double  real_data[6];
   if (!mpi->rank) {
     integer_data[0] = weno->mapped;
     integer_data[1] = weno->borges;
     integer_data[2] = weno->yc;
     integer_data[3] = weno->no_limiting;
+    integer_data[4] = weno->hybrid;
     real_data[0]    = weno->eps;
     real_data[1]    = weno->p;
     real_data[2]    = weno->rc;
     real_data[3]    = weno->xi;
     real_data[4]    = weno->tol;
+    real_data[5]    = weno->hybrid_tol;
   }
-  MPIBroadcast_integer(integer_data,4,0,&mpi->world);
-  MPIBroadcast_double (real_data   ,5,0,&mpi->world);
+  MPIBroadcast_integer(integer_data,5,0,&mpi->world);
+  MPIBroadcast_double (real_data   ,6,0,&mpi->world);
 
   weno->mapped      = integer_data[0];
   weno->borges      = integer_data[1];
   weno->yc          = integer_data[2];
   weno->no_limiting = integer_data[3];
+  weno->hybrid      = integer_data[4];
   weno->eps         = real_data   [0];
   weno->p           = real_data   [1];
   weno->rc          = real_data   [2];
   weno->xi          = real_data   [3];
   weno->tol         = real_data   [4];
+  weno->hybrid_tol  = real_data   [5];
 
   /* WENO weight calculation is hard-coded for p=2, so return error if p != 2 in
    * user input file, so that there's no confusion */
@@ -127,6 +139,15 @@ int WENOInitialize(
     if (!mpi->rank && !count) printf("Warning from WENOInitialize(): \"p\" parameter is 2.0. Any other value will be ignored!\n");
   }
 
+  /* the hybrid scheme is not needed without limiting, and is not implemented on GPUs */
+  if (weno->hybrid && weno->no_limiting) weno->hybrid = 0;
+#if defined(HAVE_CUDA)
+  if (weno->hybrid && solver->use_gpu) {
+    if (!mpi->rank && !count) printf("Warning from WENOInitialize(): \"hybrid\" is not available on GPUs. Ignoring.\n");
+    weno->hybrid = 0;
+  }
+#endif
+
   weno->offset = NULL;
   weno->w1 = NULL;
   weno->w2 = NULL;
@@ -153,6 +174,15 @@ int WENOInitialize(
   }
   weno->size = total_size;
 
+  weno->hybrid_flag     = NULL;
+  weno->hybrid_count    = NULL;
+  weno->hybrid_fraction = -1;
+  if (weno->hybrid) {
+    weno->hybrid_flag = (int*) calloc (total_size/nvars,sizeof(int));
+    _ArraySetValue_(weno->hybrid_flag,total_size/nvars,1);
+    weno->hybrid_count = (double*) calloc (2*ndims,sizeof(double));
+  }
+
   if ((!strcmp(type,_CHARACTERISTIC_)) && (nvars > 1))
     solver->SetInterpLimiterVar = WENOFifthOrderCalculateWeightsChar;
   else {
@@ -193,9 +223,9 @@ int WENOInitialize(
     gpuMemcpy(weno->w3, tmp_w3, 4*total_size*sizeof(double), gpuMemcpyHostToDevice);
   } else {
 #endif
-    weno->w1 = (double*) calloc (4*total_size,sizeof(double));
-    weno->w2 = (double*) calloc (4*total_size,sizeof(double));
-    weno->w3 = (double*) calloc (4*total_size,sizeof(double));
+    weno->w1 = ArrayAllocateInterfaces(ndims,solver->dim_local,nvars,4,"WENO w1");
+    weno->w2 = ArrayAllocateInterfaces(ndims,solver->dim_local,nvars,4,"WENO w2");
+    weno->w3 = ArrayAllocateInterfaces(ndims,solver->dim_local,nvars,4,"WENO w3");
 
     _ArrayCopy1D_(tmp_w1, weno->w1, 4*total_size);
     _ArrayCopy1D_(tmp_w2, weno->w2, 4*total_size);
@@ -208,5 +238,11 @@ int WENOInitialize(
   free(tmp_w2);
   free(tmp_w3);
 
+  weno->single = 0;
+  weno->w1s = weno->w2s = weno->w3s = NULL;
+  if (!strcmp(solver->mixed_precision,"yes")) {
+    if (WENOSetPrecision(weno,solver,1)) return(1);
+  }
+
   return 0;
 }
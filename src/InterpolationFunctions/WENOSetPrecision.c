@@ -0,0 +1,72 @@
+/*! @file WENOSetPrecision.c
+    @brief Change the precision in which the WENO weights are saved
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <arrayfunctions.h>
+#include <interpolation.h>
+#include <hypar.h>
+
+/*!
+  Save the nonlinear weights of the WENO-type schemes in single precision (#WENOParameters::w1s,
+  #WENOParameters::w2s, #WENOParameters::w3s) or in double precision (#WENOParameters::w1,
+  #WENOParameters::w2, #WENOParameters::w3): the arrays in the requested precision are allocated,
+  the current weights are copied to them, and the arrays in the other precision are freed.
+
+  The weights are computed in double precision and rounded when they are saved in single precision
+  (this is #HyPar::mixed_precision); they are 3 arrays of 4 values (left- and right-biased, for the
+  flux and the solution) per component per interface along each dimension, and thus, after the
+  solution, usually the largest arrays of a simulation (they are allocated with
+  ArrayAllocateInterfaces(), like in WENOInitialize()). Since the weights are between 0 and 1, and
+  they multiply the candidate interpolants, the relative error of the interpolated values is of
+  the order of the unit roundoff of single precision (about 6e-8).
+
+  Not available on GPUs.
+*/
+int WENOSetPrecision(void *w,     /*!< WENO object of type #WENOParameters */
+                     void *s,     /*!< Solver object of type #HyPar */
+                     int  single  /*!< Save the weights in single (1) or double (0) precision */
+                    )
+{
+  WENOParameters *weno   = (WENOParameters*) w;
+  HyPar          *solver = (HyPar*) s;
+  long           i, n = 4 * (long) weno->size;
+  int            ndims = solver->ndims, nvars = solver->nvars, *dim = solver->dim_local;
+
+  if ((single != 0) == (weno->single != 0)) return(0);
+
+  if (single) {
+    weno->w1s = ArrayAllocateInterfacesSingle(ndims,dim,nvars,4,"WENO w1 (single)");
+    weno->w2s = ArrayAllocateInterfacesSingle(ndims,dim,nvars,4,"WENO w2 (single)");
+    weno->w3s = ArrayAllocateInterfacesSingle(ndims,dim,nvars,4,"WENO w3 (single)");
+    if ((!weno->w1s) || (!weno->w2s) || (!weno->w3s)) return(1);
+#pragma omp parallel for schedule(static) default(shared) private(i)
+    for (i = 0; i < n; i++) {
+      weno->w1s[i] = (float) weno->w1[i];
+      weno->w2s[i] = (float) weno->w2[i];
+      weno->w3s[i] = (float) weno->w3[i];
+    }
+    ArrayFree(weno->w1); weno->w1 = NULL;
+    ArrayFree(weno->w2); weno->w2 = NULL;
+    ArrayFree(weno->w3); weno->w3 = NULL;
+  } else {
+    weno->w1 = ArrayAllocateInterfaces(ndims,dim,nvars,4,"WENO w1");
+    weno->w2 = ArrayAllocateInterfaces(ndims,dim,nvars,4,"WENO w2");
+    weno->w3 = ArrayAllocateInterfaces(ndims,dim,nvars,4,"WENO w3");
+    if ((!weno->w1) || (!weno->w2) || (!weno->w3)) return(1);
+#pragma omp parallel for schedule(static) default(shared) private(i)
+    for (i = 0; i < n; i++) {
+      weno->w1[i] = (double) weno->w1s[i];
+      weno->w2[i] = (double) weno->w2s[i];
+      weno->w3[i] = (double) weno->w3s[i];
+    }
+    ArrayFree(weno->w1s); weno->w1s = NULL;
+    ArrayFree(weno->w2s); weno->w2s = NULL;
+    ArrayFree(weno->w3s); weno->w3s = NULL;
+  }
+  weno->single = (single != 0);
+
+  return(0);
+}
@@ -0,0 +1,288 @@
+/*! @file MPIDiagnostics.c
+    @brief Deferred, aggregated reductions of diagnostic quantities
+    @author Debojyoti Ghosh
+
+    Diagnostic quantities computed at every time step (CFL and diffusion numbers,
+    norm of the change in the solution, volume and boundary integrals for the
+    conservation check, physics-specific integrals) each need a reduction over
+    all ranks of only a few values. Instead of a blocking MPI_Allreduce for each,
+    they are posted with MPIDiagnosticsPost() to a registry; MPIDiagnosticsStart()
+    packs everything posted into one buffer and starts a single nonblocking
+    reduction (MPI_Iallreduce), and MPIDiagnosticsComplete() waits for it and
+    writes the results. The reduction is completed lazily, i.e., only when the
+    results are needed (e.g., to print them), or when the next one is started,
+    so that it overlaps with the computations of the next time step.
+
+    Each posted quantity carries its own reduction operation (sum, maximum, or
+    minimum), so quantities with different operations are reduced together: every
+    value is packed with its operation code, and a user-defined MPI operation
+    applies the right operation to each value.
+
+    Reductions are deferred only between MPIDiagnosticsBegin() and MPIDiagnosticsEnd(),
+    and only on the communicator passed to MPIDiagnosticsBegin(); otherwise,
+    MPIDiagnosticsPost() carries out the reduction immediately. All ranks must
+    post the same sequence of quantities. The pairs MPIDiagnosticsBegin() and
+    MPIDiagnosticsEnd() can be nested (e.g., the time integration of the AMR patches,
+    see amr.h, within that of the simulation); only the outermost pair is effective.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <basic.h>
+#include <math_ops.h>
+#include <mpivars.h>
+
+/*! \brief A quantity posted to the diagnostics registry */
+typedef struct _mpi_diagnostic_item_ {
+  double  *global;                        /*!< where the reduced values are written (may be NULL) */
+  int     offset;                         /*!< offset of the values in the packed buffer */
+  int     n;                              /*!< number of values */
+  int     (*callback)(double*,int,void*); /*!< function called with the reduced values (may be NULL) */
+  void    *ctxt;                          /*!< context passed to the callback */
+} MPIDiagnosticItem;
+
+/*! \brief A batch of posted quantities that are reduced together */
+typedef struct _mpi_diagnostic_batch_ {
+  MPIDiagnosticItem *items;     /*!< posted quantities */
+  int               nitems;     /*!< number of posted quantities */
+  int               maxitems;   /*!< allocated size of items */
+  double            *sendbuf;   /*!< packed (value, operation) pairs */
+  double            *recvbuf;   /*!< reduced (value, operation) pairs */
+  int               nvals;      /*!< number of packed values */
+  int               maxvals;    /*!< allocated number of pairs in the buffers */
+  int               in_flight;  /*!< whether the reduction of this batch has been started */
+#ifndef serial
+  MPI_Request       request;    /*!< request of the nonblocking reduction */
+#endif
+} MPIDiagnosticBatch;
+
+/*! Whether posted reductions are deferred */
+static int                diag_active = 0;
+/*! Nesting depth of MPIDiagnosticsBegin() within the outermost one */
+static int                diag_depth = 0;
+/*! Two batches: one collects the posted quantities while the other one is being reduced */
+static MPIDiagnosticBatch diag_batch[2];
+/*! Index of the batch collecting the posted quantities */
+static int                diag_posting = 0;
+/*! Number of quantities and of packed reductions (for the summary printed by MPIDiagnosticsEnd()) */
+static long               diag_nposted = 0, diag_nreductions = 0;
+#ifndef serial
+/*! Communicator on which the reductions are deferred */
+static MPI_Comm           diag_comm;
+/*! Datatype of a (value, operation) pair */
+static MPI_Datatype       diag_type;
+/*! User-defined operation on (value, operation) pairs */
+static MPI_Op             diag_op;
+
+/*! Reduce (value, operation) pairs, each with its own operation */
+static void MPIDiagnosticsOp(void *in, void *inout, int *len, MPI_Datatype *type)
+{
+  double *a = (double*) in;
+  double *b = (double*) inout;
+  int i;
+  for (i = 0; i < *len; i++) {
+    int op = (int) a[2*i+1];
+    if      (op == _MPI_DIAG_SUM_) b[2*i] += a[2*i];
+    else if (op == _MPI_DIAG_MAX_) b[2*i]  = max(a[2*i],b[2*i]);
+    else if (op == _MPI_DIAG_MIN_) b[2*i]  = min(a[2*i],b[2*i]);
+  }
+}
+#endif
+
+/*! Write the reduced values of a batch and call the callbacks, in the order of posting */
+static int MPIDiagnosticsFinish(MPIDiagnosticBatch *batch)
+{
+  int i, k;
+  double *reduced = (double*) calloc (max(batch->nvals,1), sizeof(double));
+  for (k = 0; k < batch->nvals; k++) reduced[k] = batch->recvbuf[2*k];
+  /* reset the batch before calling the callbacks, which may post new quantities */
+  int               nitems = batch->nitems;
+  MPIDiagnosticItem *items = (MPIDiagnosticItem*) calloc (max(nitems,1), sizeof(MPIDiagnosticItem));
+  memcpy(items, batch->items, nitems*sizeof(MPIDiagnosticItem));
+  batch->nitems     = 0;
+  batch->nvals      = 0;
+  batch->in_flight  = 0;
+
+  for (i = 0; i < nitems; i++) {
+    MPIDiagnosticItem *item = &items[i];
+    if (item->global) for (k = 0; k < item->n; k++) item->global[k] = reduced[item->offset+k];
+    if (item->callback) item->callback(reduced+item->offset,item->n,item->ctxt);
+  }
+  free(items);
+  free(reduced);
+  return(0);
+}
+
+/*! Wait for the reduction of a batch, if it has been started, and finish it */
+static int MPIDiagnosticsWait(MPIDiagnosticBatch *batch)
+{
+  if (!batch->in_flight) return(0);
+#ifndef serial
+  MPIProfilerBegin("Reductions");
+  MPI_Wait(&batch->request,MPI_STATUS_IGNORE);
+  MPIProfilerEnd("Reductions",(double)batch->nvals*2*sizeof(double));
+#endif
+  return(MPIDiagnosticsFinish(batch));
+}
+
+/*! Start deferring the diagnostic reductions posted on a given communicator (see the
+    description of this file). Called by TimeInitialize(). If the reductions are already
+    deferred, only the nesting depth is incremented. */
+int MPIDiagnosticsBegin(void *comm /*!< MPI communicator */)
+{
+  if (diag_active) {
+    diag_depth++;
+    return(0);
+  }
+  memset(diag_batch, 0, 2*sizeof(MPIDiagnosticBatch));
+  diag_posting      = 0;
+  diag_nposted      = 0;
+  diag_nreductions  = 0;
+#ifndef serial
+  diag_comm = *((MPI_Comm*)comm);
+  MPI_Type_contiguous(2,MPI_DOUBLE,&diag_type);
+  MPI_Type_commit(&diag_type);
+  MPI_Op_create(MPIDiagnosticsOp,1,&diag_op);
+#endif
+  diag_active = 1;
+  return(0);
+}
+
+/*!
+  Post a reduction of \a n values over all the ranks of a communicator with the operation
+  \a op (#_MPI_DIAG_SUM_, #_MPI_DIAG_MAX_, or #_MPI_DIAG_MIN_). The reduced values are
+  written to \a global (if not NULL), and then \a callback is called with them (if not NULL).
+  A callback with \a n = 0 can be posted to carry out some computation after all the previously
+  posted quantities are reduced.
+  + If the reductions are deferred on this communicator (see MPIDiagnosticsBegin()), \a local is
+    copied, and \a global and \a ctxt must remain valid until MPIDiagnosticsComplete() is called.
+  + Otherwise, the reduction is carried out immediately.
+*/
+int MPIDiagnosticsPost(
+                        double  *global,  /*!< array to contain the reduced values (may be NULL) */
+                        double  *local,   /*!< the local values */
+                        int     n,        /*!< number of values */
+                        int     op,       /*!< reduction operation */
+                        void    *comm,    /*!< MPI communicator */
+                        int     (*callback)(double*,int,void*), /*!< function to call with the reduced values */
+                        void    *ctxt     /*!< context passed to the callback */
+                      )
+{
+  int k;
+#ifndef serial
+  int deferred = (diag_active && (*((MPI_Comm*)comm) == diag_comm));
+#else
+  int deferred = diag_active;
+#endif
+
+  if (!deferred) {
+    double *reduced = (double*) calloc (max(n,1), sizeof(double));
+    if (n > 0) {
+      if      (op == _MPI_DIAG_MAX_) MPIMax_double(reduced,local,n,comm);
+      else if (op == _MPI_DIAG_MIN_) MPIMin_double(reduced,local,n,comm);
+      else                           MPISum_double(reduced,local,n,comm);
+    }
+    if (global) for (k = 0; k < n; k++) global[k] = reduced[k];
+    if (callback) callback(reduced,n,ctxt);
+    free(reduced);
+    return(0);
+  }
+
+  MPIDiagnosticBatch *batch = &diag_batch[diag_posting];
+  if (batch->nitems == batch->maxitems) {
+    batch->maxitems = max(2*batch->maxitems,16);
+    batch->items = (MPIDiagnosticItem*) realloc (batch->items, batch->maxitems*sizeof(MPIDiagnosticItem));
+  }
+  if (batch->nvals + n > batch->maxvals) {
+    batch->maxvals = max(2*batch->maxvals,batch->nvals+n);
+    batch->sendbuf = (double*) realloc (batch->sendbuf, 2*batch->maxvals*sizeof(double));
+    batch->recvbuf = (double*) realloc (batch->recvbuf, 2*batch->maxvals*sizeof(double));
+  }
+
+  MPIDiagnosticItem *item = &batch->items[batch->nitems];
+  item->global   = global;
+  item->offset   = batch->nvals;
+  item->n        = n;
+  item->callback = callback;
+  item->ctxt     = ctxt;
+  for (k = 0; k < n; k++) {
+    batch->sendbuf[2*(batch->nvals+k)+0] = local[k];
+    batch->sendbuf[2*(batch->nvals+k)+1] = (double) op;
+  }
+  batch->nvals += n;
+  batch->nitems++;
+  diag_nposted++;
+
+  return(0);
+}
+
+/*! Start the reduction of all the posted quantities, packed into one nonblocking reduction.
+    If the previous reduction is still in flight, it is completed first. Called at the end of
+    each time step by TimePostStep(). */
+int MPIDiagnosticsStart()
+{
+  if (!diag_active) return(0);
+  MPIDiagnosticBatch *batch = &diag_batch[diag_posting];
+  if (!batch->nitems) return(0);
+
+  MPIDiagnosticsWait(&diag_batch[1-diag_posting]);
+
+  if (batch->nvals) {
+#ifndef serial
+    MPI_Iallreduce(batch->sendbuf,batch->recvbuf,batch->nvals,diag_type,diag_op,diag_comm,&batch->request);
+#else
+    memcpy(batch->recvbuf,batch->sendbuf,2*batch->nvals*sizeof(double));
+#endif
+    diag_nreductions++;
+    batch->in_flight = 1;
+    diag_posting = 1 - diag_posting;
+  } else {
+    /* only callbacks were posted */
+    MPIDiagnosticsFinish(batch);
+  }
+  return(0);
+}
+
+/*! Complete the reduction of all the posted quantities: the reduction in flight, if any, is
+    waited for, and the quantities posted since are reduced. On return, the reduced values
+    have been written and the callbacks called. */
+int MPIDiagnosticsComplete()
+{
+  if (!diag_active) return(0);
+  MPIDiagnosticsStart();
+  MPIDiagnosticsWait(&diag_batch[0]);
+  MPIDiagnosticsWait(&diag_batch[1]);
+  return(0);
+}
+
+/*! Complete all the posted reductions and stop deferring them; print a summary of the
+    aggregated reductions on rank 0 of the communicator. Called by TimeCleanup(). For a
+    nested call (see MPIDiagnosticsBegin()), only the nesting depth is decremented. */
+int MPIDiagnosticsEnd()
+{
+  int i, rank = 0;
+  if (!diag_active) return(0);
+  if (diag_depth) {
+    diag_depth--;
+    return(0);
+  }
+  MPIDiagnosticsComplete();
+#ifndef serial
+  MPI_Comm_rank(diag_comm,&rank);
+  MPI_Op_free(&diag_op);
+  MPI_Type_free(&diag_type);
+#endif
+  if ((!rank) && diag_nreductions) {
+    printf("Diagnostics: %ld quantities reduced in %ld packed reductions.\n",
+           diag_nposted, diag_nreductions);
+  }
+  for (i = 0; i < 2; i++) {
+    free(diag_batch[i].items);
+    free(diag_batch[i].sendbuf);
+    free(diag_batch[i].recvbuf);
+  }
+  memset(diag_batch, 0, 2*sizeof(MPIDiagnosticBatch));
+  diag_active = 0;
+  return(0);
+}
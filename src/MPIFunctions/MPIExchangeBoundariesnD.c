@@ -60,6 +60,8 @@ int MPIExchangeBoundariesnD(
   MPI_Request rcvreq[2*ndims], sndreq[2*ndims];
   for (d=0; d<2*ndims; d++) rcvreq[d] = sndreq[d] = MPI_REQUEST_NULL;
 
+  MPIProfilerBegin("HaloExchange");
+
   /* each process has 2*ndims neighbors (except at non-periodic physical boundaries)  */
   /* calculate the rank of these neighbors (-1 -> none)                               */
   for (d = 0; d < ndims; d++) {
@@ -168,6 +170,13 @@ int MPIExchangeBoundariesnD(
   /* Wait till send requests are complete before freeing memory */
   MPI_Waitall(2*ndims,sndreq,status_arr);
 
+  /* bytes sent and received */
+  double bytes = 0;
+  for (d = 0; d < 2*ndims; d++) {
+    if (neighbor_rank[d] != -1) bytes += 2.0*bufdim[d/2]*nvars*sizeof(double);
+  }
+  MPIProfilerEnd("HaloExchange",bytes);
+
 #endif
   return(0);
 }
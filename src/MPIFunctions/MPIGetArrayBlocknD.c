@@ -0,0 +1,224 @@
+/*! @file MPIGetArrayBlocknD.c
+    @brief Fetch a block of a distributed n-dimensional array on every MPI rank
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <basic.h>
+#include <math_ops.h>
+#include <arrayfunctions.h>
+#include <mpivars.h>
+
+/*! Compute the segments of a block [s,e) of global indices along one dimension that lie
+    in the local domain [a,b) of a rank: along a periodic dimension, the block point g is
+    the grid point g mod n; along a non-periodic dimension, the points outside [0,n) are not
+    in any local domain. Each segment is stored as 3 integers: its offset in the block, its
+    offset in the local domain, and its length. Returns the number of segments. */
+static int MPIGetArrayBlockSegments(int s,        /*!< First global index of the block */
+                                    int e,        /*!< Last global index of the block plus one */
+                                    int a,        /*!< First global index of the local domain */
+                                    int b,        /*!< Last global index of the local domain plus one */
+                                    int n,        /*!< Global grid size */
+                                    int periodic, /*!< Is this dimension periodic? */
+                                    int *seg      /*!< Array to hold the segments */
+                                   )
+{
+  int k, kmin = 0, kmax = 0, nseg = 0;
+  if (periodic) {
+    kmin = (s >= 0 ? s/n : -((n-1-s)/n));
+    kmax = (e-1 >= 0 ? (e-1)/n : -((n-e)/n));
+  }
+  for (k = kmin; k <= kmax; k++) {
+    int lo = max(s,a+k*n);
+    int hi = min(e,b+k*n);
+    if (lo < hi) {
+      seg[3*nseg+0] = lo - s;
+      seg[3*nseg+1] = lo - k*n - a;
+      seg[3*nseg+2] = hi - lo;
+      nseg++;
+    }
+  }
+  return(nseg);
+}
+
+/*! Compute the segments (see MPIGetArrayBlockSegments()) of a block along each dimension
+    that lie in the local domain of a rank; the arrays of segments are (re)allocated. */
+static void MPIGetArrayBlockPieces( int ndims,      /*!< Number of spatial dimensions */
+                                    int *blk,       /*!< Block: [start, end) along each dimension */
+                                    int *lo,        /*!< First global index of the local domain along each dimension */
+                                    int *hi,        /*!< Last global index of the local domain plus one along each dimension */
+                                    int *dim_global,/*!< Global grid size */
+                                    int *periodic,  /*!< Periodicity along each dimension */
+                                    int *nseg,      /*!< Number of segments along each dimension */
+                                    int **seg       /*!< Segments along each dimension */
+                                  )
+{
+  int d;
+  for (d = 0; d < ndims; d++) {
+    int s = blk[2*d], e = blk[2*d+1];
+    if (seg[d]) free(seg[d]);
+    seg[d]  = (int*) calloc (3*((e-s)/dim_global[d]+2),sizeof(int));
+    nseg[d] = MPIGetArrayBlockSegments(s,e,lo[d],hi[d],dim_global[d],periodic[d],seg[d]);
+  }
+}
+
+/*! Walk over the pieces of a block that lie in the local domain of a rank (the cartesian
+    product of the segments along each dimension, see MPIGetArrayBlockSegments()), and
+    copy each point from the local array to the buffer (if \a xblk is NULL), from the buffer
+    to the block (if \a x is NULL), or from the local array to the block (if \a buf is NULL);
+    nothing is copied if both \a x and \a xblk are NULL. Returns the number of points of the pieces. */
+static long MPIGetArrayBlockCopy( int     ndims,      /*!< Number of spatial dimensions */
+                                  int     nvars,      /*!< Number of variables per grid point */
+                                  int     *dim_local, /*!< Local size of the array */
+                                  int     ghosts,     /*!< Number of ghost points of the local array */
+                                  int     *dim_blk,   /*!< Size of the block */
+                                  int     *nseg,      /*!< Number of segments along each dimension */
+                                  int     **seg,      /*!< Segments along each dimension */
+                                  double  *x,         /*!< Local array (may be NULL) */
+                                  double  *xblk,      /*!< Block (may be NULL) */
+                                  double  *buf        /*!< Buffer (may be NULL) */
+                                )
+{
+  int  d, sel[ndims], index[ndims], bounds[ndims], offset_l[ndims], offset_b[ndims], done;
+  long count = 0;
+
+  for (d = 0; d < ndims; d++) if (!nseg[d]) return(0);
+
+  _ArraySetValue_(sel,ndims,0);
+  done = 0;
+  while (!done) {
+    for (d = 0; d < ndims; d++) {
+      offset_b[d] = seg[d][3*sel[d]+0];
+      offset_l[d] = seg[d][3*sel[d]+1];
+      bounds[d]   = seg[d][3*sel[d]+2];
+    }
+    if ((!x) && (!xblk)) {
+      long size; _ArrayProduct1D_(bounds,ndims,size);
+      count += size;
+    } else {
+      int done2 = 0; _ArraySetValue_(index,ndims,0);
+      while (!done2) {
+        int p; _ArrayIndex1DWO_(ndims,dim_local,index,offset_l,ghosts,p);
+        int q; _ArrayIndex1DWO_(ndims,dim_blk  ,index,offset_b,0     ,q);
+        if      (!xblk) _ArrayCopy1D_((x+nvars*p),(buf+nvars*count),nvars)
+        else if (!x)    _ArrayCopy1D_((buf+nvars*count),(xblk+nvars*q),nvars)
+        else            _ArrayCopy1D_((x+nvars*p),(xblk+nvars*q),nvars)
+        count++;
+        _ArrayIncrementIndex_(ndims,bounds,index,done2);
+      }
+    }
+    _ArrayIncrementIndex_(ndims,nseg,sel,done);
+  }
+  return(count);
+}
+
+/*!
+  This function lets every rank get a logically rectangular block of a distributed n-dimensional
+  array (stored as described in the documentation of MPIExchangeBoundariesnD()), of any size and
+  at any position: the block on this rank covers the global indices [\a is_blk[d],
+  \a is_blk[d]+\a dim_blk[d]) along each dimension d, and is an array without ghost points.
+  + Along periodic dimensions, the block may extend beyond the domain; its points outside the
+    domain are the periodic images of the points inside it.
+  + Along non-periodic dimensions, the points of the block outside the domain are not set.
+
+  This is a collective call on the communicator of \a m (each rank may request a different block,
+  or an empty one). The blocks requested by all the ranks are gathered on every rank, and each rank
+  sends the parts of its local domain that lie in each block directly to the rank that requested it;
+  therefore, the data moved is proportional to the size of the blocks, and no rank holds a global array.
+*/
+int MPIGetArrayBlocknD(
+                        int     ndims,      /*!< Number of spatial dimensions */
+                        int     nvars,      /*!< Number of variables (vector components) */
+                        int     *dim_global,/*!< Integer array whose elements are the global size in each spatial dimension */
+                        int     *dim_local, /*!< Integer array whose elements are the local size of x in each spatial dimension */
+                        int     ghosts,     /*!< Number of ghost points of x */
+                        int     *periodic,  /*!< Integer array whose elements are 1 if the dimension is periodic, 0 otherwise */
+                        void    *m,         /*!< MPI object of type #MPIVariables */
+                        double  *x,         /*!< Local array */
+                        int     *is_blk,    /*!< Integer array whose elements are the global index of the first point
+                                                 of the block on this rank in each spatial dimension */
+                        int     *dim_blk,   /*!< Integer array whose elements are the size of the block on this rank
+                                                 in each spatial dimension */
+                        double  *xblk       /*!< Preallocated array to hold the block */
+                     )
+{
+  MPIVariables *mpi = (MPIVariables*) m;
+  int          d, nproc = mpi->nproc;
+  _DECLARE_IERR_;
+
+  /* blocks requested by all the ranks */
+  int *req   = (int*) calloc (2*ndims*nproc,sizeof(int));
+  int *myreq = req + 2*ndims*mpi->rank;
+  for (d = 0; d < ndims; d++) {
+    myreq[2*d+0] = is_blk[d];
+    myreq[2*d+1] = is_blk[d] + dim_blk[d];
+  }
+#ifndef serial
+  MPI_Allgather(MPI_IN_PLACE,2*ndims,MPI_INT,req,2*ndims,MPI_INT,mpi->world);
+#endif
+
+  /* local domain of this rank */
+  int is[ndims], ie[ndims];
+  IERR MPILocalDomainLimits(ndims,mpi->rank,mpi,dim_global,is,ie); CHECKERR(ierr);
+
+  int nseg[ndims], *seg[ndims];
+  for (d = 0; d < ndims; d++) seg[d] = NULL;
+
+#ifndef serial
+  double      **sendbuf = (double**)     calloc (nproc,sizeof(double*));
+  double      **recvbuf = (double**)     calloc (nproc,sizeof(double*));
+  MPI_Request *requests = (MPI_Request*) calloc (2*nproc,sizeof(MPI_Request));
+  int         nreq = 0;
+
+  /* post the receives of the parts of this block on the other ranks */
+  for (int r = 0; r < nproc; r++) {
+    if (r == mpi->rank) continue;
+    int is_r[ndims], ie_r[ndims];
+    IERR MPILocalDomainLimits(ndims,r,mpi,dim_global,is_r,ie_r); CHECKERR(ierr);
+    MPIGetArrayBlockPieces(ndims,myreq,is_r,ie_r,dim_global,periodic,nseg,seg);
+    long count = MPIGetArrayBlockCopy(ndims,nvars,dim_local,ghosts,dim_blk,nseg,seg,NULL,NULL,NULL);
+    if (count) {
+      recvbuf[r] = (double*) calloc (count*nvars,sizeof(double));
+      MPI_Irecv(recvbuf[r],count*nvars,MPI_DOUBLE,r,2213,mpi->world,&requests[nreq++]);
+    }
+  }
+
+  /* send the parts of the local domain in the blocks of the other ranks */
+  for (int r = 0; r < nproc; r++) {
+    if (r == mpi->rank) continue;
+    MPIGetArrayBlockPieces(ndims,(req+2*ndims*r),is,ie,dim_global,periodic,nseg,seg);
+    long count = MPIGetArrayBlockCopy(ndims,nvars,dim_local,ghosts,dim_blk,nseg,seg,NULL,NULL,NULL);
+    if (count) {
+      sendbuf[r] = (double*) calloc (count*nvars,sizeof(double));
+      MPIGetArrayBlockCopy(ndims,nvars,dim_local,ghosts,dim_blk,nseg,seg,x,NULL,sendbuf[r]);
+      MPI_Isend(sendbuf[r],count*nvars,MPI_DOUBLE,r,2213,mpi->world,&requests[nreq++]);
+    }
+  }
+#endif
+
+  /* the part of the local domain in this block */
+  MPIGetArrayBlockPieces(ndims,myreq,is,ie,dim_global,periodic,nseg,seg);
+  MPIGetArrayBlockCopy(ndims,nvars,dim_local,ghosts,dim_blk,nseg,seg,x,xblk,NULL);
+
+#ifndef serial
+  MPI_Waitall(nreq,requests,MPI_STATUSES_IGNORE);
+  for (int r = 0; r < nproc; r++) {
+    if (recvbuf[r]) {
+      int is_r[ndims], ie_r[ndims];
+      IERR MPILocalDomainLimits(ndims,r,mpi,dim_global,is_r,ie_r); CHECKERR(ierr);
+      MPIGetArrayBlockPieces(ndims,myreq,is_r,ie_r,dim_global,periodic,nseg,seg);
+      MPIGetArrayBlockCopy(ndims,nvars,dim_local,ghosts,dim_blk,nseg,seg,NULL,xblk,recvbuf[r]);
+      free(recvbuf[r]);
+    }
+    if (sendbuf[r]) free(sendbuf[r]);
+  }
+  free(sendbuf);
+  free(recvbuf);
+  free(requests);
+#endif
+
+  for (d = 0; d < ndims; d++) if (seg[d]) free(seg[d]);
+  free(req);
+  return(0);
+}
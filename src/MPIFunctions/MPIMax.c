@@ -46,7 +46,9 @@ int MPIMax_double(
   int i;
   for (i = 0; i < size; i++)  global[i] = var[i];
 #else
+  MPIProfilerBegin("Reductions");
   MPI_Allreduce((var==global?MPI_IN_PLACE:var),global,size,MPI_DOUBLE,MPI_MAX,*((MPI_Comm*)comm));
+  MPIProfilerEnd("Reductions",(double)size*sizeof(double));
 #endif
   return(0);
 }
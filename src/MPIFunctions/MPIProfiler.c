@@ -0,0 +1,316 @@
+/*! @file MPIProfiler.c
+    @brief Lightweight hierarchical region profiler
+    @author Debojyoti Ghosh
+
+    Regions of the code (components of the right-hand-side, interpolation, upwinding,
+    halo exchange, boundary conditions, I/O, reductions, ...) are enclosed between
+    MPIProfilerBegin() and MPIProfilerEnd() (or, in C++, in the scope of an object of
+    type #MPIProfilerScope). Each rank records, for each region, the wall time, the number
+    of calls, and the number of bytes moved (communicated or written; zero for computational
+    kernels). Regions are hierarchical: a region begun inside another one is its child, so
+    that the same region (eg, "HaloExchange") called from different places is recorded
+    separately for each place.
+
+    At the end of a simulation, MPIProfilerReport() gathers the records of all the ranks,
+    and prints the minimum, average, and maximum (over all ranks) of the wall time of each
+    region, and writes them to a JSON file.
+
+    The profiler is disabled by default (see MPIProfilerEnable()); then, MPIProfilerBegin()
+    and MPIProfilerEnd() return immediately. Regions begun inside an OpenMP parallel region are
+    ignored (their time is included in that of the enclosing region).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <basic.h>
+#include <mathfunctions.h>
+#include <mpivars.h>
+#ifdef serial
+#include <sys/time.h>
+#endif
+#ifdef with_omp
+#include <omp.h>
+#endif
+
+/*! Maximum length of the name of a region */
+#define _MPI_PROF_NAME_LEN_ 64
+/*! Maximum depth of nested regions */
+#define _MPI_PROF_MAX_DEPTH_ 32
+
+/*! \brief A profiled region */
+typedef struct _mpi_profiler_region_ {
+  char    name[_MPI_PROF_NAME_LEN_];  /*!< name of the region */
+  int     parent;                     /*!< index of the parent region (-1 if none) */
+  int     first_child;                /*!< index of the first child region (-1 if none) */
+  int     next_sibling;               /*!< index of the next region with the same parent (-1 if none) */
+  double  time;                       /*!< total wall time */
+  double  bytes;                      /*!< total number of bytes moved */
+  long    count;                      /*!< number of calls */
+  double  t_start;                    /*!< wall time at the beginning of the current call */
+} MPIProfilerRegion;
+
+/*! Whether the profiler is enabled */
+static int                prof_enabled = 0;
+/*! Recorded regions */
+static MPIProfilerRegion  *prof_regions = NULL;
+/*! Number of recorded regions and allocated size of #prof_regions */
+static int                prof_nregions = 0, prof_maxregions = 0;
+/*! First region without a parent */
+static int                prof_first_root = -1;
+/*! Stack of the regions currently begun */
+static int                prof_stack[_MPI_PROF_MAX_DEPTH_];
+/*! Number of regions currently begun (the stack may be deeper than #_MPI_PROF_MAX_DEPTH_;
+    regions beyond that depth are not recorded) */
+static int                prof_depth = 0;
+
+/*! Wall time in seconds */
+static double MPIProfilerWtime()
+{
+#ifndef serial
+  return(MPI_Wtime());
+#else
+  struct timeval tv;
+  gettimeofday(&tv,NULL);
+  return((double)tv.tv_sec + 1e-6*(double)tv.tv_usec);
+#endif
+}
+
+/*! Whether profiler calls must be ignored here */
+static int MPIProfilerIgnore()
+{
+  if (!prof_enabled) return(1);
+#ifdef with_omp
+  if (omp_in_parallel()) return(1);
+#endif
+  return(0);
+}
+
+/*! Find the child region of a given name of a region, or add it */
+static int MPIProfilerFindOrAdd(int parent, const char *name)
+{
+  int r = (parent < 0 ? prof_first_root : prof_regions[parent].first_child), last = -1;
+  while (r >= 0) {
+    if (!strcmp(prof_regions[r].name,name)) return(r);
+    last = r;
+    r = prof_regions[r].next_sibling;
+  }
+
+  if (prof_nregions == prof_maxregions) {
+    prof_maxregions = max(2*prof_maxregions,64);
+    prof_regions = (MPIProfilerRegion*) realloc (prof_regions,prof_maxregions*sizeof(MPIProfilerRegion));
+  }
+  r = prof_nregions++;
+  MPIProfilerRegion *region = &prof_regions[r];
+  memset(region,0,sizeof(MPIProfilerRegion));
+  strncpy(region->name,name,_MPI_PROF_NAME_LEN_-1);
+  region->parent       = parent;
+  region->first_child  = -1;
+  region->next_sibling = -1;
+  if (last >= 0)        prof_regions[last].next_sibling = r;
+  else if (parent >= 0) prof_regions[parent].first_child = r;
+  else                  prof_first_root = r;
+  return(r);
+}
+
+/*! Enable or disable the profiler. When it is enabled, the records of a previous run are discarded. */
+void MPIProfilerEnable(int flag /*!< 1 to enable, 0 to disable */)
+{
+  if (flag && !prof_enabled) {
+    prof_nregions   = 0;
+    prof_first_root = -1;
+    prof_depth      = 0;
+  }
+  prof_enabled = flag;
+}
+
+/*! Begin a region: it is a child of the innermost region currently begun (if any). */
+void MPIProfilerBegin(const char *name /*!< Name of the region */)
+{
+  if (MPIProfilerIgnore()) return;
+  if (prof_depth < _MPI_PROF_MAX_DEPTH_) {
+    int parent = (prof_depth ? prof_stack[prof_depth-1] : -1);
+    int r = MPIProfilerFindOrAdd(parent,name);
+    prof_stack[prof_depth] = r;
+    prof_regions[r].t_start = MPIProfilerWtime();
+  }
+  prof_depth++;
+}
+
+/*! End a region: it must be the innermost region currently begun. */
+void MPIProfilerEnd(const char  *name,  /*!< Name of the region */
+                    double      bytes   /*!< Number of bytes moved in this call */ )
+{
+  if (MPIProfilerIgnore()) return;
+  if (!prof_depth) return;
+  prof_depth--;
+  if (prof_depth < _MPI_PROF_MAX_DEPTH_) {
+    MPIProfilerRegion *region = &prof_regions[prof_stack[prof_depth]];
+    if (strcmp(region->name,name)) {
+      fprintf(stderr,"Error in MPIProfilerEnd(): region \"%s\" ended inside region \"%s\"; ",name,region->name);
+      fprintf(stderr,"disabling the profiler.\n");
+      prof_enabled = 0;
+      return;
+    }
+    region->time  += (MPIProfilerWtime() - region->t_start);
+    region->bytes += bytes;
+    region->count++;
+  }
+}
+
+/*! Path of a region ("parent/child") */
+static void MPIProfilerPath(int r, char *path, int len)
+{
+  if (prof_regions[r].parent >= 0) {
+    MPIProfilerPath(prof_regions[r].parent,path,len);
+    strncat(path,"/",len-strlen(path)-1);
+  } else path[0] = '\0';
+  strncat(path,prof_regions[r].name,len-strlen(path)-1);
+}
+
+/*! Depth-first order of the regions */
+static void MPIProfilerOrder(int r, int *order, int *n)
+{
+  while (r >= 0) {
+    order[(*n)++] = r;
+    MPIProfilerOrder(prof_regions[r].first_child,order,n);
+    r = prof_regions[r].next_sibling;
+  }
+}
+
+/*!
+  Report the profiled regions: the records of all the ranks of a communicator are gathered
+  on its rank 0, which prints, for each region, the number of calls, the minimum, average, and
+  maximum over all ranks of the wall time, and the average number of bytes moved, and writes
+  them to a JSON file. A rank on which a region was never called counts as zero.
+
+  The regions are listed depth-first in the order they were first called on rank 0; regions
+  that were never called on rank 0 are listed at the end.
+
+  This is a collective operation on the communicator. Does nothing if the profiler is disabled.
+*/
+int MPIProfilerReport(void        *comm,  /*!< MPI communicator */
+                      const char  *fname  /*!< Name of the JSON file to write (NULL for none) */ )
+{
+  int i, j, rank = 0, nproc = 1;
+  if (!prof_enabled) return(0);
+
+#ifndef serial
+  MPI_Comm_rank(*((MPI_Comm*)comm),&rank);
+  MPI_Comm_size(*((MPI_Comm*)comm),&nproc);
+#endif
+
+  /* pack the records of this rank: path, and time, count, bytes */
+  const int plen = 4*_MPI_PROF_NAME_LEN_;
+  int n = 0;
+  int *order = (int*) calloc (max(prof_nregions,1),sizeof(int));
+  MPIProfilerOrder(prof_first_root,order,&n);
+  char   *paths = (char*)   calloc (max(n,1)*plen,sizeof(char));
+  double *vals  = (double*) calloc (max(n,1)*3   ,sizeof(double));
+  for (i = 0; i < n; i++) {
+    MPIProfilerRegion *region = &prof_regions[order[i]];
+    MPIProfilerPath(order[i],paths+i*plen,plen);
+    vals[3*i+0] = region->time;
+    vals[3*i+1] = (double) region->count;
+    vals[3*i+2] = region->bytes;
+  }
+  free(order);
+
+  /* gather them on rank 0 */
+  int *counts = NULL, *displs = NULL, ntotal = n;
+  char *all_paths = paths;
+  double *all_vals = vals;
+#ifndef serial
+  MPI_Comm mpi_comm = *((MPI_Comm*)comm);
+  counts = (int*) calloc (nproc,sizeof(int));
+  displs = (int*) calloc (nproc,sizeof(int));
+  MPI_Gather(&n,1,MPI_INT,counts,1,MPI_INT,0,mpi_comm);
+  if (!rank) {
+    ntotal = 0;
+    for (i = 0; i < nproc; i++) ntotal += counts[i];
+    all_paths = (char*)   calloc (max(ntotal,1)*plen,sizeof(char));
+    all_vals  = (double*) calloc (max(ntotal,1)*3   ,sizeof(double));
+  }
+  for (i = 0; i < nproc; i++) counts[i] *= plen;
+  for (i = 1; i < nproc; i++) displs[i] = displs[i-1] + counts[i-1];
+  MPI_Gatherv(paths,n*plen,MPI_CHAR,all_paths,counts,displs,MPI_CHAR,0,mpi_comm);
+  for (i = 0; i < nproc; i++) counts[i] = (counts[i]/plen)*3;
+  for (i = 1; i < nproc; i++) displs[i] = displs[i-1] + counts[i-1];
+  MPI_Gatherv(vals,n*3,MPI_DOUBLE,all_vals,counts,displs,MPI_DOUBLE,0,mpi_comm);
+#endif
+
+  if (!rank) {
+
+    /* merge the records by path */
+    int nunique = 0;
+    int    *owner = (int*)    calloc (max(ntotal,1),sizeof(int));    /* index of the record of each unique path */
+    double *tmin  = (double*) calloc (max(ntotal,1),sizeof(double));
+    double *tsum  = (double*) calloc (max(ntotal,1),sizeof(double));
+    double *tmax  = (double*) calloc (max(ntotal,1),sizeof(double));
+    double *csum  = (double*) calloc (max(ntotal,1),sizeof(double));
+    double *bsum  = (double*) calloc (max(ntotal,1),sizeof(double));
+    int    *nrank = (int*)    calloc (max(ntotal,1),sizeof(int));
+    for (i = 0; i < ntotal; i++) {
+      for (j = 0; j < nunique; j++) if (!strcmp(all_paths+owner[j]*plen,all_paths+i*plen)) break;
+      double t = all_vals[3*i+0];
+      if (j == nunique) {
+        owner[nunique] = i;
+        tmin[nunique] = tmax[nunique] = t;
+        nunique++;
+      }
+      tmin[j]  = min(tmin[j],t);
+      tmax[j]  = max(tmax[j],t);
+      tsum[j] += t;
+      csum[j] += all_vals[3*i+1];
+      bsum[j] += all_vals[3*i+2];
+      nrank[j]++;
+    }
+    for (j = 0; j < nunique; j++) if (nrank[j] < nproc) tmin[j] = 0.0;
+
+    printf("Profile (wall time in seconds over %d rank(s)):\n",nproc);
+    printf("  %-44s %12s %12s %12s %12s %14s\n","Region","Calls/rank","Min","Avg","Max","Bytes/rank");
+    for (j = 0; j < nunique; j++) {
+      const char *path = all_paths+owner[j]*plen;
+      int depth = 0;
+      const char *c, *name = path;
+      for (c = path; *c; c++) if (*c == '/') { depth++; name = c+1; }
+      char label[_MAX_STRING_SIZE_];
+      snprintf(label,_MAX_STRING_SIZE_,"%*s%s",2*depth,"",name);
+      printf("  %-44s %12.1f %12.4e %12.4e %12.4e %14.4e\n",label,csum[j]/nproc,
+             tmin[j],tsum[j]/nproc,tmax[j],bsum[j]/nproc);
+    }
+
+    if (fname) {
+      FILE *out = fopen(fname,"w");
+      if (!out) {
+        fprintf(stderr,"Error in MPIProfilerReport(): unable to open %s for writing.\n",fname);
+      } else {
+        fprintf(out,"{\n  \"nranks\": %d,\n  \"regions\": [\n",nproc);
+        for (j = 0; j < nunique; j++) {
+          fprintf(out,"    {\"path\": \"%s\", \"ranks\": %d, \"calls_avg\": %1.16e, ",
+                  all_paths+owner[j]*plen,nrank[j],csum[j]/nproc);
+          fprintf(out,"\"time_min\": %1.16e, \"time_avg\": %1.16e, \"time_max\": %1.16e, ",
+                  tmin[j],tsum[j]/nproc,tmax[j]);
+          fprintf(out,"\"bytes_avg\": %1.16e}%s\n",bsum[j]/nproc,(j < nunique-1 ? "," : ""));
+        }
+        fprintf(out,"  ]\n}\n");
+        fclose(out);
+        printf("Profile written to %s.\n",fname);
+      }
+    }
+
+    free(owner); free(tmin); free(tsum); free(tmax); free(csum); free(bsum); free(nrank);
+  }
+
+#ifndef serial
+  if (!rank) {
+    free(all_paths);
+    free(all_vals);
+  }
+  free(counts);
+  free(displs);
+#endif
+  free(paths);
+  free(vals);
+  return(0);
+}
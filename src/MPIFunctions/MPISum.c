@@ -2,9 +2,7 @@
     @brief Functions to compute the sum across MPI ranks
     @author Debojyoti Ghosh
 */
-#ifndef serial
-#include <mpi.h>
-#endif
+#include <mpivars.h>
 
 /*!
   Compute the global sum over all MPI ranks in a given communicator for
@@ -47,7 +45,9 @@ int MPISum_double(
   int i;
   for (i = 0; i < size; i++)  global[i] = var[i];
 #else
+  MPIProfilerBegin("Reductions");
   MPI_Allreduce((var==global?MPI_IN_PLACE:var),global,size,MPI_DOUBLE,MPI_SUM,*((MPI_Comm*)comm));
+  MPIProfilerEnd("Reductions",(double)size*sizeof(double));
 #endif
   return(0);
 }
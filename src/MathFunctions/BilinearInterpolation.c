@@ -0,0 +1,40 @@
+/*! @file BilinearInterpolation.c
+    @brief Compute coefficients for bilinear interpolation
+    @author Debojyoti Ghosh
+*/
+
+#include <mathfunctions.h>
+
+/*!
+  This function computes the coefficients for a bilinear interpolation at a given
+  point (x,y) inside a rectangle defined by [xmin,xmax] X [ymin,ymax].
+  The coefficients are stored in an array of size 4 with each element corresponding
+  to a corner of the rectangle in the following order:\n
+  coeffs[0] => xmin,ymin\n
+  coeffs[1] => xmax,ymin\n
+  coeffs[2] => xmin,ymax\n
+  coeffs[3] => xmax,ymax
+*/
+void BilinearInterpCoeffs(
+                            double xmin,  /*!< x-coordinate of the lower-end */
+                            double xmax,  /*!< x-coordinate of the higher-end */
+                            double ymin,  /*!< y-coordinate of the lower-end */
+                            double ymax,  /*!< y-coordinate of the higher-end */
+                            double x,     /*!< x-coordinate of the point to interpolate at */
+                            double y,     /*!< y-coordinate of the point to interpolate at */
+                            double *coeffs/*!< array of size 4 (pre-allocated) to store the coefficients in */
+                         )
+{
+  double area_inv = 1 / ((xmax-xmin)*(ymax-ymin));
+  double tldx1 = x - xmin;
+  double tldx2 = xmax - x;
+  double tldy1 = y - ymin;
+  double tldy2 = ymax - y;
+
+  coeffs[0] = tldy2 * tldx2 * area_inv;
+  coeffs[1] = tldy2 * tldx1 * area_inv;
+  coeffs[2] = tldy1 * tldx2 * area_inv;
+  coeffs[3] = tldy1 * tldx1 * area_inv;
+
+  return;
+}
@@ -112,7 +112,8 @@ void fillGhostCells( const int* const a_dim,      /*!< grid dimensions of soluti
           index_int[d]++;
           _ArrayIndex1D_(a_ndims, a_dim, index_int, a_ngpt, p_int_3);
 
-          double alpha = - (double) (a_ngpt - index[d]);
+          /* the interior points 0,1,2,3 are at alpha = -1,0,1,2 */
+          double alpha = - (double) (a_ngpt - index[d]) - 1.0;
           double c0 = -((-2.0 + alpha)*(-1.0 + alpha)*alpha)/6.0;
           double c1 = ((-2.0 + alpha)*(-1.0 + alpha)*(1.0 + alpha))/2.0;
           double c2 = (alpha*(2.0 + alpha - alpha*alpha))/2.0;
@@ -147,15 +148,16 @@ void fillGhostCells( const int* const a_dim,      /*!< grid dimensions of soluti
           _ArrayCopy1D_(index, index_int, a_ndims);
 
           index_int[d] = a_dim[d]-1;
-          _ArrayIndex1D_(a_ndims, a_dim, index, a_ngpt, p_int_0);
+          _ArrayIndex1D_(a_ndims, a_dim, index_int, a_ngpt, p_int_0);
           index_int[d]--;
-          _ArrayIndex1D_(a_ndims, a_dim, index, a_ngpt, p_int_1);
+          _ArrayIndex1D_(a_ndims, a_dim, index_int, a_ngpt, p_int_1);
           index_int[d]--;
-          _ArrayIndex1D_(a_ndims, a_dim, index, a_ngpt, p_int_2);
+          _ArrayIndex1D_(a_ndims, a_dim, index_int, a_ngpt, p_int_2);
           index_int[d]--;
-          _ArrayIndex1D_(a_ndims, a_dim, index, a_ngpt, p_int_3);
+          _ArrayIndex1D_(a_ndims, a_dim, index_int, a_ngpt, p_int_3);
 
-          double alpha = - (double) (index[d]+1);
+          /* the interior points N-1,N-2,N-3,N-4 are at alpha = -1,0,1,2 */
+          double alpha = - (double) (index[d]+1) - 1.0;
           double c0 = -((-2.0 + alpha)*(-1.0 + alpha)*alpha)/6.0;
           double c1 = ((-2.0 + alpha)*(-1.0 + alpha)*(1.0 + alpha))/2.0;
           double c2 = (alpha*(2.0 + alpha - alpha*alpha))/2.0;
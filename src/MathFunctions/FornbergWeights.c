@@ -0,0 +1,50 @@
+/*! @file FornbergWeights.c
+    @author Debojyoti Ghosh
+    @brief Finite-difference weights on an arbitrary set of points
+*/
+
+#include <mathfunctions.h>
+
+/*! Compute the weights of the finite-difference approximations to the derivatives of
+    order 0 (interpolation) to \a m at a point \a z, using the values at \a n arbitrarily
+    spaced (distinct) points \a x, with Fornberg's recursive algorithm:
+    \f{equation}{
+      \left.\frac{d^k f}{dx^k}\right|_{z} \approx \sum_{j=0}^{n-1} c_{k,j} f\left(x_j\right),\ k = 0,\ldots,m,
+    \f}
+    where the weight \f$c_{k,j}\f$ is returned in c[k*n+j]. The approximation to the
+    \f$k\f$-th derivative is exact for polynomials of degree up to \f$n-1\f$.
+
+    Reference:
+    + Fornberg, B., Calculation of Weights in Finite Difference Formulas, SIAM Review,
+      40 (3), 1998, pp. 685-691, http://dx.doi.org/10.1137/S0036144596322507
+*/
+void FornbergWeights(
+                      double  z,  /*!< Point at which the derivatives are approximated */
+                      double  *x, /*!< Array of the n points */
+                      int     n,  /*!< Number of points */
+                      int     m,  /*!< Highest order of the derivative */
+                      double  *c  /*!< Array of size (m+1)*n to hold the weights */
+                    )
+{
+  int i, j, k;
+  for (i = 0; i < (m+1)*n; i++) c[i] = 0.0;
+
+  double c1 = 1.0, c4 = x[0] - z;
+  c[0] = 1.0;
+  for (i = 1; i < n; i++) {
+    int    mn = (i < m ? i : m);
+    double c2 = 1.0, c5 = c4;
+    c4 = x[i] - z;
+    for (j = 0; j < i; j++) {
+      double c3 = x[i] - x[j];
+      c2 *= c3;
+      if (j == i-1) {
+        for (k = mn; k > 0; k--) c[k*n+i] = c1 * (k*c[(k-1)*n+i-1] - c5*c[k*n+i-1]) / c2;
+        c[i] = -c1 * c5 * c[i-1] / c2;
+      }
+      for (k = mn; k > 0; k--) c[k*n+j] = (c4*c[k*n+j] - k*c[(k-1)*n+j]) / c3;
+      c[j] = c4 * c[j] / c3;
+    }
+    c1 = c2;
+  }
+}
@@ -36,7 +36,11 @@ static int coarsen1D( const int* const    a_dim_src, /*!< Grid size of source da
                       const int           a_dir,     /*!< Dimension along which to coarsen */
                       const int           a_nvars,   /*!< Number of vector components of the solution */
                       const int           a_ngpt,    /*!< Number of ghost points */
-                      const int           a_ndims    /*!< Number of spatial dimensions */
+                      const int           a_ndims,   /*!< Number of spatial dimensions */
+                      const int           a_n_src,   /*!< Global grid size of source data along a_dir */
+                      const int           a_n_dst,   /*!< Global grid size of destination data along a_dir */
+                      const int           a_is_src,  /*!< Global index along a_dir of the first point of a_u_src */
+                      const int           a_is_dst   /*!< Global index along a_dir of the first point of a_u_dst */
                    )
 {
   for (int d = 0; d < a_ndims; d++) {
@@ -47,8 +51,8 @@ static int coarsen1D( const int* const    a_dim_src, /*!< Grid size of source da
     }
   }
 
-  int n_src = a_dim_src[a_dir];
-  int n_dst = a_dim_dst[a_dir];
+  int n_src = a_n_src;
+  int n_dst = a_n_dst;
   if (n_dst > n_src) {
     fprintf(stderr, "Error in coarsen1D() -\n");
     fprintf(stderr, " destination grid is finer than source grid along a_dir!\n");
@@ -96,9 +100,10 @@ static int coarsen1D( const int* const    a_dim_src, /*!< Grid size of source da
     _ArrayCopy1D_(index_transverse, index_dst, a_ndims);
     _ArrayCopy1D_(index_transverse, index_src, a_ndims);
 
-    for (int i_dst = 0; i_dst < n_dst; i_dst++) {
+    for (int j_dst = 0; j_dst < a_dim_dst[a_dir]; j_dst++) {
 
-      int i_m1 = i_dst*stride + (stride/2-1);
+      int i_dst = a_is_dst + j_dst;
+      int i_m1 = i_dst*stride + (stride/2-1) - a_is_src;
       int i_m3 = i_m1 - 2;
       int i_m2 = i_m1 - 1;
       int i_p1 = i_m1 + 1;
@@ -106,7 +111,7 @@ static int coarsen1D( const int* const    a_dim_src, /*!< Grid size of source da
       int i_p3 = i_m1 + 3;
 
       int p;
-      index_dst[a_dir] = i_dst;
+      index_dst[a_dir] = j_dst;
       _ArrayIndex1D_(a_ndims, a_dim_dst, index_dst, a_ngpt, p);
 
       int p_m3;
@@ -167,7 +172,11 @@ static int refine1D(const int* const     a_dim_src, /*!< Grid size of source dat
                     const int            a_dir,     /*!< Dimension along which to coarsen */
                     const int            a_nvars,   /*!< Number of vector components of the solution */
                     const int            a_ngpt,    /*!< Number of ghost points */
-                    const int            a_ndims    /*!< Number of spatial dimensions */
+                    const int            a_ndims,   /*!< Number of spatial dimensions */
+                    const int            a_n_src,   /*!< Global grid size of source data along a_dir */
+                    const int            a_n_dst,   /*!< Global grid size of destination data along a_dir */
+                    const int            a_is_src,  /*!< Global index along a_dir of the first point of a_u_src */
+                    const int            a_is_dst   /*!< Global index along a_dir of the first point of a_u_dst */
                   )
 {
   for (int d = 0; d < a_ndims; d++) {
@@ -178,8 +187,8 @@ static int refine1D(const int* const     a_dim_src, /*!< Grid size of source dat
     }
   }
 
-  int n_src = a_dim_src[a_dir];
-  int n_dst = a_dim_dst[a_dir];
+  int n_src = a_n_src;
+  int n_dst = a_n_dst;
   if (n_dst < n_src) {
     fprintf(stderr, "Error in refine1D() -\n");
     fprintf(stderr, "  destination grid is coarser than source grid along a_dir!\n");
@@ -219,20 +228,21 @@ static int refine1D(const int* const     a_dim_src, /*!< Grid size of source dat
     _ArrayCopy1D_(index_transverse, index_src4, a_ndims);
     _ArrayCopy1D_(index_transverse, index_src5, a_ndims);
 
-    for (int i_dst = 0; i_dst < n_dst; i_dst++) {
+    for (int j_dst = 0; j_dst < a_dim_dst[a_dir]; j_dst++) {
 
+      int i_dst = a_is_dst + j_dst;
       double xi_dst = ((double) i_dst + 0.5) / ((double) stride) - 0.5;
 
-      int i_src_2  = floor(xi_dst);
-      int i_src_3  = ceil(xi_dst);
+      int i_src_2  = (int) floor(xi_dst) - a_is_src;
+      int i_src_3  = (int) ceil(xi_dst) - a_is_src;
       int i_src_0 = i_src_2 - 2;
       int i_src_1 = i_src_2 - 1;
       int i_src_4 = i_src_3 + 1;
       int i_src_5 = i_src_3 + 2;
 
-      double alpha = (xi_dst - (double)i_src_2) / ((double)i_src_3 - (double)i_src_2);
+      double alpha = (xi_dst - floor(xi_dst)) / (ceil(xi_dst) - floor(xi_dst));
 
-      index_dst[a_dir] = i_dst;
+      index_dst[a_dir] = j_dst;
       int p; _ArrayIndex1D_(a_ndims, a_dim_dst, index_dst, a_ngpt, p);
 
       index_src0[a_dir] = i_src_0;
@@ -389,7 +399,11 @@ int InterpolateGlobalnDVar( const int* const  a_dim_dst, /*!< grid dimensions to
                               dir,
                               a_nvars,
                               a_ghosts,
-                              a_ndims );
+                              a_ndims,
+                              dim_from[dir],
+                              dim_to[dir],
+                              0,
+                              0 );
       if (retval) return retval;
     } else {
       int retval = refine1D(  dim_from,
@@ -399,7 +413,11 @@ int InterpolateGlobalnDVar( const int* const  a_dim_dst, /*!< grid dimensions to
                               dir,
                               a_nvars,
                               a_ghosts,
-                              a_ndims );
+                              a_ndims,
+                              dim_from[dir],
+                              dim_to[dir],
+                              0,
+                              0 );
       if (retval) return retval;
     }
 
@@ -420,3 +438,222 @@ int InterpolateGlobalnDVar( const int* const  a_dim_dst, /*!< grid dimensions to
 
   return 0;
 }
+
+/*! Compute the range of source grid indices along one dimension that the interpolation
+    operators (coarsen1D(), refine1D()) need to compute the destination grid points with
+    global indices a_is_dst, ..., a_ie_dst-1 along this dimension. The range
+    [*a_is_src, *a_ie_src) includes the stencil halo, and may therefore extend beyond the
+    source grid (0, ..., a_n_src-1) near the domain boundaries.
+
+    If the source and destination grids have the same size along this dimension, the
+    range is the destination range.
+*/
+void InterpolateLocalSourceRange( const int  a_n_dst,  /*!< Global grid size of destination data */
+                                  const int  a_n_src,  /*!< Global grid size of source data */
+                                  const int  a_is_dst, /*!< First global destination index */
+                                  const int  a_ie_dst, /*!< Last global destination index plus one */
+                                  int* const a_is_src, /*!< First global source index needed */
+                                  int* const a_ie_src  /*!< Last global source index needed plus one */
+                                )
+{
+  if (a_n_dst == a_n_src) {
+    *a_is_src = a_is_dst;
+    *a_ie_src = a_ie_dst;
+  } else if (a_n_dst < a_n_src) {
+    /* coarsen1D(): points i*stride+stride/2-3, ..., i*stride+stride/2+2 */
+    int stride = a_n_src / a_n_dst;
+    *a_is_src = a_is_dst*stride + stride/2 - 3;
+    *a_ie_src = (a_ie_dst-1)*stride + stride/2 + 3;
+  } else {
+    /* refine1D(): points floor(xi)-2, ..., ceil(xi)+2 */
+    int stride = a_n_dst / a_n_src;
+    double xi_s = ((double) a_is_dst + 0.5) / ((double) stride) - 0.5;
+    double xi_e = ((double) (a_ie_dst-1) + 0.5) / ((double) stride) - 0.5;
+    *a_is_src = (int) floor(xi_s) - 2;
+    *a_ie_src = (int) ceil(xi_e) + 3;
+  }
+}
+
+/*! Compute the block of the source grid that the interpolation operators need to compute
+    the part [a_is_dst[d], a_ie_dst[d]) of the destination grid along each dimension d (see
+    InterpolateLocalSourceRange()). Along non-periodic dimensions, the block is extended, if
+    it extends beyond the source grid, to include the 4 source points nearest to the boundary
+    that InterpolateLocalExtrapolate() needs; an error is returned if the source grid has
+    fewer points.
+*/
+int InterpolateLocalSourceBlock(const int         a_ndims,          /*!< Number of spatial dimensions */
+                                const int* const  a_dim_global_dst, /*!< Global grid size of destination data */
+                                const int* const  a_dim_global_src, /*!< Global grid size of source data */
+                                const int* const  a_is_dst,         /*!< First global destination index along each dimension */
+                                const int* const  a_ie_dst,         /*!< Last global destination index plus one along each dimension */
+                                const int* const  a_periodic,       /*!< Periodicity along each dimension */
+                                int* const        a_is_src,         /*!< First global source index of the block along each dimension */
+                                int* const        a_dim_src         /*!< Size of the block along each dimension */
+                              )
+{
+  for (int d = 0; d < a_ndims; d++) {
+    int is_src, ie_src, n_src = a_dim_global_src[d];
+    InterpolateLocalSourceRange(a_dim_global_dst[d], n_src, a_is_dst[d], a_ie_dst[d], &is_src, &ie_src);
+    if (!a_periodic[d]) {
+      /* the extrapolation needs the 4 points nearest to the boundary */
+      if (is_src < 0)      ie_src = (ie_src > 4 ? ie_src : 4);
+      if (ie_src > n_src)  is_src = (is_src < n_src-4 ? is_src : n_src-4);
+      if (((is_src < 0) || (ie_src > n_src)) && (n_src < 4)) {
+        fprintf(stderr,"Error in InterpolateLocalSourceBlock() - \n");
+        fprintf(stderr,"  source grid size along dimension %d (%d) is too small to extrapolate ", d, n_src);
+        fprintf(stderr,"to the interpolation stencil!\n");
+        return 1;
+      }
+    }
+    a_is_src[d]  = is_src;
+    a_dim_src[d] = ie_src - is_src;
+  }
+  return 0;
+}
+
+/*! Fill the points of a block of the source grid (see InterpolateLocalSourceBlock()) that are
+    outside the source grid along the non-periodic dimensions, by extrapolating the 4 points
+    nearest to the boundary with the same 4th order polynomial as fillGhostCells(). The points
+    inside the source grid, and outside it along the periodic dimensions, must be set.
+*/
+void InterpolateLocalExtrapolate( const int         a_ndims,          /*!< Number of spatial dimensions */
+                                  const int         a_nvars,          /*!< Number of vector components */
+                                  const int* const  a_dim_global_src, /*!< Global grid size of source data */
+                                  const int* const  a_periodic,       /*!< Periodicity along each dimension */
+                                  const int* const  a_is_src,         /*!< First global source index of the block along each dimension */
+                                  const int* const  a_dim_src,        /*!< Size of the block along each dimension */
+                                  double* const     a_u_src           /*!< Block of source data (without ghost points) */
+                                )
+{
+  int index[a_ndims], index_int[a_ndims];
+
+  for (int d = 0; d < a_ndims; d++) {
+    if (a_periodic[d]) continue;
+    int M = a_dim_global_src[d];
+    if ((a_is_src[d] >= 0) && (a_is_src[d]+a_dim_src[d] <= M)) continue;
+    int done = 0; _ArraySetValue_(index,a_ndims,0);
+    while (!done) {
+      int g = a_is_src[d] + index[d];
+      if ((g < 0) || (g >= M)) {
+        int    p, q[4];
+        double alpha = (g < 0 ? (double) g : - (double) (g-M+1)) - 1.0;
+        double c[4];
+        c[0] = -((-2.0 + alpha)*(-1.0 + alpha)*alpha)/6.0;
+        c[1] = ((-2.0 + alpha)*(-1.0 + alpha)*(1.0 + alpha))/2.0;
+        c[2] = (alpha*(2.0 + alpha - alpha*alpha))/2.0;
+        c[3] = (alpha*(-1.0 + alpha*alpha))/6.0;
+        _ArrayIndex1D_(a_ndims,a_dim_src,index,0,p);
+        _ArrayCopy1D_(index,index_int,a_ndims);
+        for (int k = 0; k < 4; k++) {
+          index_int[d] = (g < 0 ? k : M-1-k) - a_is_src[d];
+          _ArrayIndex1D_(a_ndims,a_dim_src,index_int,0,q[k]);
+        }
+        for (int v = 0; v < a_nvars; v++) {
+          a_u_src[p*a_nvars+v] =    c[0] * a_u_src[q[0]*a_nvars+v]
+                                  + c[1] * a_u_src[q[1]*a_nvars+v]
+                                  + c[2] * a_u_src[q[2]*a_nvars+v]
+                                  + c[3] * a_u_src[q[3]*a_nvars+v];
+        }
+      }
+      _ArrayIncrementIndex_(a_ndims,a_dim_src,index,done);
+    }
+  }
+}
+
+/*! Interpolate n-dimensional data from one grid to another of a desired resolution,
+    on a part of the destination grid: this is the local (on each MPI rank) counterpart
+    of InterpolateGlobalnDVar(), with the same interpolation operators applied along
+    one dimension at a time.
+
+    The source data is a block of the source grid, with no ghost points, that covers
+    the global indices [a_is_src[d], a_is_src[d]+a_dim_src[d]) along each dimension d; it
+    must contain the range given by InterpolateLocalSourceRange() for the destination
+    part, including the points outside the source grid (filled by periodicity or
+    extrapolation). The destination part covers the global indices [a_is_dst[d],
+    a_is_dst[d]+a_dim_dst[d]) and is an array with a_ghosts ghost points (the ghost
+    points are not set).
+*/
+int InterpolateLocalnDVar(  const int* const    a_dim_dst,        /*!< Local grid size of destination data */
+                            const int* const    a_is_dst,         /*!< Global index of the first destination point along each dimension */
+                            const int* const    a_dim_global_dst, /*!< Global grid size of destination data */
+                            double* const       a_u_dst,          /*!< Destination data (with ghost points) */
+                            const int* const    a_dim_src,        /*!< Size of the block of source data */
+                            const int* const    a_is_src,         /*!< Global index of the first point of the block along each dimension */
+                            const int* const    a_dim_global_src, /*!< Global grid size of source data */
+                            const double* const a_u_src,          /*!< Block of source data (without ghost points) */
+                            const int           a_nvars,          /*!< Number of vector components of the solution */
+                            const int           a_ghosts,         /*!< Number of ghost points of the destination data */
+                            const int           a_ndims           /*!< Number of spatial dimensions */
+                         )
+{
+  int dim_to[a_ndims], dim_from[a_ndims], is_to[a_ndims], is_from[a_ndims], index[a_ndims];
+
+  const double *u_from = NULL;
+  double       *u_to   = NULL, *u_prev = NULL;
+
+  _ArrayCopy1D_(a_dim_src, dim_to, a_ndims);
+  _ArrayCopy1D_(a_is_src, is_to, a_ndims);
+  u_from = a_u_src;
+
+  for (int dir = 0; dir < a_ndims; dir++) {
+
+    _ArrayCopy1D_(dim_to, dim_from, a_ndims);
+    _ArrayCopy1D_(is_to, is_from, a_ndims);
+
+    if (a_dim_global_dst[dir] == a_dim_global_src[dir]) {
+      if ((dim_from[dir] != a_dim_dst[dir]) || (is_from[dir] != a_is_dst[dir])) {
+        fprintf(stderr,"Error in InterpolateLocalnDVar() - \n");
+        fprintf(stderr,"  source block does not match the destination along dimension %d!\n", dir);
+        return 1;
+      }
+      continue;
+    }
+
+    double fac = (a_dim_global_dst[dir] > a_dim_global_src[dir] ?
+                      (double)a_dim_global_dst[dir]/(double)a_dim_global_src[dir]
+                    : (double)a_dim_global_src[dir]/(double)a_dim_global_dst[dir] );
+    if (!isPowerOfTwo((int)fac)) {
+      fprintf(stderr,"Error in InterpolateLocalnDVar() - \n");
+      fprintf(stderr,"  refinement/coarsening factor not a power of 2!\n");
+      return 1;
+    }
+
+    dim_to[dir] = a_dim_dst[dir];
+    is_to[dir]  = a_is_dst[dir];
+    {
+      long size = (long) a_nvars;
+      for (int d = 0; d < a_ndims; d++) size *= (long) dim_to[d];
+      u_to = (double*) calloc (size, sizeof(double));
+    }
+
+    int retval;
+    if (a_dim_global_dst[dir] < a_dim_global_src[dir]) {
+      retval = coarsen1D( dim_from, dim_to, u_from, u_to, dir, a_nvars, 0, a_ndims,
+                          a_dim_global_src[dir], a_dim_global_dst[dir], is_from[dir], is_to[dir] );
+    } else {
+      retval = refine1D(  dim_from, dim_to, u_from, u_to, dir, a_nvars, 0, a_ndims,
+                          a_dim_global_src[dir], a_dim_global_dst[dir], is_from[dir], is_to[dir] );
+    }
+    if (u_prev) free(u_prev);
+    if (retval) {
+      free(u_to);
+      return retval;
+    }
+    u_from = u_prev = u_to;
+
+  }
+
+  for (int d = 0; d < a_ndims; d++) {
+    if ((dim_to[d] != a_dim_dst[d]) || (is_to[d] != a_is_dst[d])) {
+      fprintf(stderr,"Error in InterpolateLocalnDVar() - \n");
+      fprintf(stderr,"  source block does not match the destination along dimension %d!\n", d);
+      if (u_prev) free(u_prev);
+      return 1;
+    }
+  }
+
+  ArrayCopynD(a_ndims, u_from, a_u_dst, (int*) a_dim_dst, 0, a_ghosts, index, a_nvars);
+  if (u_prev) free(u_prev);
+
+  return 0;
+}
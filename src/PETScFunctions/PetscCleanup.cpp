@@ -21,6 +21,13 @@ int PetscCleanup(void *obj /*!< Object of type #PETScContext */)
   }
   ctxt->points.clear();
   if (ctxt->offsets) free(ctxt->offsets);
+  for (int i = 0; i < ctxt->adi_blocks.size(); i++) {
+    free(ctxt->adi_blocks[i]);
+    free(ctxt->adi_work[i]);
+  }
+  ctxt->adi_blocks.clear();
+  ctxt->adi_work.clear();
+  if (ctxt->adi_lu) free(ctxt->adi_lu);
   return(0);
 }
 
@@ -6,6 +6,8 @@
 #ifdef with_petsc
 
 #include <stdio.h>
+#include <sys/time.h>
+#include <vector>
 #include <arrayfunctions.h>
 #include <simulation_object.h>
 #include <mpivars_cpp.h>
@@ -51,6 +53,12 @@
 
   Currently, this function doesn't include the source term.
 
+  The matrix is created by PetscCreatePreconMat() with its nonzero pattern preallocated exactly
+  and a local-to-global block mapping; each block row (the diagonal block, which includes the
+  shift, and the blocks of the left and right neighbors along each dimension) is computed in a
+  contiguous buffer and inserted with one call to MatSetValuesBlockedLocal(). The wall time of
+  the assembly is accumulated in #PETScContext::precon_assembly_wctime.
+
   + See https://petsc.org/release/docs/manualpages/PC/index.html for more information on PETSc preconditioners.
   + All functions and variables whose names start with Vec, Mat, PC, KSP, SNES, and TS are defined by PETSc. Refer to
     the PETSc documentation (https://petsc.org/release/docs/). Usually, googling with the function
@@ -60,15 +68,20 @@ int PetscComputePreconMatImpl(  Mat Pmat,   /*!< Preconditioning matrix to const
                                 Vec Y,      /*!< Solution vector */
                                 void *ctxt  /*!< Application context */ )
 {
-  PetscErrorCode ierr;
   PETScContext* context = (PETScContext*) ctxt;
   SimulationObject* sim = (SimulationObject*) context->simobj;
   int nsims = context->nsims;
+  struct timeval assembly_start, assembly_end;
 
   PetscFunctionBegin;
-  /* initialize preconditioning matrix to zero */
+  gettimeofday(&assembly_start,NULL);
+
+  /* initialize preconditioning matrix to zero (the nonzero pattern is retained) */
   MatZeroEntries(Pmat);
 
+  /* local block index offset of each simulation domain (see PetscCreatePreconMat()) */
+  int offset = 0;
+
   /* copy solution from PETSc vector */
   for (int ns = 0; ns < nsims; ns++) {
 
@@ -83,17 +96,19 @@ int PetscComputePreconMatImpl(  Mat Pmat,   /*!< Preconditioning matrix to const
 
     int ndims = solver->ndims,
         nvars = solver->nvars,
+        bs2 = nvars*nvars,
         npoints = solver->npoints_local,
         ghosts = solver->ghosts,
         *dim = solver->dim_local,
-        *isPeriodic = solver->isPeriodic,
         *points = context->points[ns],
-        index[ndims],indexL[ndims],indexR[ndims],
-        rows[nvars],cols[nvars];
+        indexL[ndims],indexR[ndims];
 
-    double *u = solver->u,
-           *iblank = solver->iblank,
-           dxinv, values[nvars*nvars];
+    double *u = solver->u, dxinv, values[bs2];
+
+    /* block row: local block column indices, the blocks, and the row-major buffer */
+    int ncols_max = 2*ndims+1;
+    std::vector<PetscInt> cols(ncols_max);
+    std::vector<double> blocks(ncols_max*bs2), rowvals(ncols_max*bs2);
 
     /* apply boundary conditions and exchange data over MPI interfaces */
     solver->ApplyBoundaryConditions(solver,mpi,u,NULL,context->waqt);
@@ -107,98 +122,96 @@ int PetscComputePreconMatImpl(  Mat Pmat,   /*!< Preconditioning matrix to const
 
       double iblank = solver->iblank[p];
 
-      /* compute the contributions from the hyperbolic flux derivatives along each dimension */
-      if (solver->JFunction) {
-        for (int dir = 0; dir < ndims; dir++) {
+      /* diagonal block, including the shift */
+      int ncols = 1;
+      cols[0] = offset + p;
+      double *diag = blocks.data();
+      _ArraySetValue_(diag,bs2,0.0);
+      for (int v=0; v<nvars; v++) diag[v*nvars+v] = context->shift;
 
-          /* compute indices and global 1D indices for left and right neighbors */
-          _ArrayCopy1D_(index,indexL,ndims); indexL[dir]--;
-          int pL;  _ArrayIndex1D_(ndims,dim,indexL,ghosts,pL);
+      for (int dir = 0; dir < ndims; dir++) {
 
-          _ArrayCopy1D_(index,indexR,ndims); indexR[dir]++;
-          int pR;  _ArrayIndex1D_(ndims,dim,indexR,ghosts,pR);
+        /* compute indices and global 1D indices for left and right neighbors */
+        _ArrayCopy1D_(index,indexL,ndims); indexL[dir]--;
+        int pL;  _ArrayIndex1D_(ndims,dim,indexL,ghosts,pL);
 
-          int pg, pgL, pgR;
-          pg  = (int) context->globalDOF[ns][p];
-          pgL = (int) context->globalDOF[ns][pL];
-          pgR = (int) context->globalDOF[ns][pR];
+        _ArrayCopy1D_(index,indexR,ndims); indexR[dir]++;
+        int pR;  _ArrayIndex1D_(ndims,dim,indexR,ghosts,pR);
 
-          /* Retrieve 1/delta-x at this grid point */
-          _GetCoordinate_(dir,index[dir],dim,ghosts,solver->dxinv,dxinv);
+        int pgL, pgR;
+        pgL = (int) context->globalDOF[ns][pL];
+        pgR = (int) context->globalDOF[ns][pR];
 
-          /* diagonal element */
-          for (int v=0; v<nvars; v++) { rows[v] = nvars*pg + v; cols[v] = nvars*pg + v; }
-          solver->JFunction(values,(u+nvars*p),solver->physics,dir,nvars,0);
-          _ArrayScale1D_(values,(dxinv*iblank),(nvars*nvars));
-          MatSetValues(Pmat,nvars,rows,nvars,cols,values,ADD_VALUES);
+        /* Retrieve 1/delta-x at this grid point */
+        _GetCoordinate_(dir,index[dir],dim,ghosts,solver->dxinv,dxinv);
+
+        /* blocks of the left and right neighbors, if they are computational points */
+        double *left = NULL, *right = NULL;
+        if (pgL >= 0) {
+          cols[ncols] = offset + pL;
+          left = blocks.data() + (ncols++)*bs2;
+          _ArraySetValue_(left,bs2,0.0);
+        }
+        if (pgR >= 0) {
+          cols[ncols] = offset + pR;
+          right = blocks.data() + (ncols++)*bs2;
+          _ArraySetValue_(right,bs2,0.0);
+        }
 
-          /* left neighbor */
-          if (pgL >= 0) {
-            for (int v=0; v<nvars; v++) { rows[v] = nvars*pg + v; cols[v] = nvars*pgL + v; }
+        /* contributions from the hyperbolic flux derivatives */
+        if (solver->JFunction) {
+          solver->JFunction(values,(u+nvars*p),solver->physics,dir,nvars,0);
+          _ArrayAXPY_(values,(dxinv*iblank),diag,bs2);
+          if (left) {
             solver->JFunction(values,(u+nvars*pL),solver->physics,dir,nvars,1);
-            _ArrayScale1D_(values,(-dxinv*iblank),(nvars*nvars));
-            MatSetValues(Pmat,nvars,rows,nvars,cols,values,ADD_VALUES);
+            _ArrayAXPY_(values,(-dxinv*iblank),left,bs2);
           }
-
-          /* right neighbor */
-          if (pgR >= 0) {
-            for (int v=0; v<nvars; v++) { rows[v] = nvars*pg + v; cols[v] = nvars*pgR + v; }
+          if (right) {
             solver->JFunction(values,(u+nvars*pR),solver->physics,dir,nvars,-1);
-            _ArrayScale1D_(values,(-dxinv*iblank),(nvars*nvars));
-            MatSetValues(Pmat,nvars,rows,nvars,cols,values,ADD_VALUES);
+            _ArrayAXPY_(values,(-dxinv*iblank),right,bs2);
           }
         }
-      }
-
-      /* compute the contributions from the parabolic term derivatives along each dimension */
-      if (solver->KFunction) {
-        for (int dir = 0; dir < ndims; dir++) {
 
-          /* compute indices and global 1D indices for left and right neighbors */
-          _ArrayCopy1D_(index,indexL,ndims); indexL[dir]--;
-          int pL;  _ArrayIndex1D_(ndims,dim,indexL,ghosts,pL);
-
-          _ArrayCopy1D_(index,indexR,ndims); indexR[dir]++;
-          int pR;  _ArrayIndex1D_(ndims,dim,indexR,ghosts,pR);
-
-          int pg, pgL, pgR;
-          pg  = (int) context->globalDOF[ns][p];
-          pgL = (int) context->globalDOF[ns][pL];
-          pgR = (int) context->globalDOF[ns][pR];
-
-          /* Retrieve 1/delta-x at this grid point */
-          _GetCoordinate_(dir,index[dir],dim,ghosts,solver->dxinv,dxinv);
-
-          /* diagonal element */
-          for (int v=0; v<nvars; v++) { rows[v] = nvars*pg + v; cols[v] = nvars*pg + v; }
+        /* contributions from the parabolic term derivatives */
+        if (solver->KFunction) {
           solver->KFunction(values,(u+nvars*p),solver->physics,dir,nvars);
-          _ArrayScale1D_(values,(-2*dxinv*dxinv*iblank),(nvars*nvars));
-          MatSetValues(Pmat,nvars,rows,nvars,cols,values,ADD_VALUES);
-
-          /* left neighbor */
-          if (pgL >= 0) {
-            for (int v=0; v<nvars; v++) { rows[v] = nvars*pg + v; cols[v] = nvars*pgL + v; }
+          _ArrayAXPY_(values,(-2*dxinv*dxinv*iblank),diag,bs2);
+          if (left) {
             solver->KFunction(values,(u+nvars*pL),solver->physics,dir,nvars);
-            _ArrayScale1D_(values,(dxinv*dxinv*iblank),(nvars*nvars));
-            MatSetValues(Pmat,nvars,rows,nvars,cols,values,ADD_VALUES);
+            _ArrayAXPY_(values,(dxinv*dxinv*iblank),left,bs2);
           }
-
-          /* right neighbor */
-          if (pgR >= 0) {
-            for (int v=0; v<nvars; v++) { rows[v] = nvars*pg + v; cols[v] = nvars*pgR + v; }
+          if (right) {
             solver->KFunction(values,(u+nvars*pR),solver->physics,dir,nvars);
-            _ArrayScale1D_(values,(dxinv*dxinv*iblank),(nvars*nvars));
-            MatSetValues(Pmat,nvars,rows,nvars,cols,values,ADD_VALUES);
+            _ArrayAXPY_(values,(dxinv*dxinv*iblank),right,bs2);
           }
         }
       }
+
+      /* insert the block row: the values are a (nvars) x (ncols*nvars) row-major array */
+      for (int k = 0; k < ncols; k++) {
+        for (int i = 0; i < nvars; i++) {
+          for (int j = 0; j < nvars; j++) {
+            rowvals[i*ncols*nvars + k*nvars + j] = blocks[k*bs2 + i*nvars + j];
+          }
+        }
+      }
+      PetscInt row = offset + p;
+      MatSetValuesBlockedLocal(Pmat,1,&row,ncols,cols.data(),rowvals.data(),ADD_VALUES);
     }
+
+    offset += solver->npoints_local_wghosts;
   }
 
   MatAssemblyBegin(Pmat,MAT_FINAL_ASSEMBLY);
   MatAssemblyEnd  (Pmat,MAT_FINAL_ASSEMBLY);
 
-  MatShift(Pmat,context->shift);
+  gettimeofday(&assembly_end,NULL);
+  long long walltime;
+  walltime = (  (assembly_end.tv_sec * 1000000 + assembly_end.tv_usec)
+              - (assembly_start.tv_sec * 1000000 + assembly_start.tv_usec));
+  context->precon_assembly_wctime += (double) walltime / 1000000.0;
+  context->precon_assembly_count++;
+
   PetscFunctionReturn(0);
 }
 
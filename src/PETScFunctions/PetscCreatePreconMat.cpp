@@ -0,0 +1,113 @@
+/*! @file PetscCreatePreconMat.cpp
+    @brief Create the block-structured preconditioning matrix
+    @author Debojyoti Ghosh
+*/
+
+#ifdef with_petsc
+
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+#include <basic.h>
+#include <arrayfunctions.h>
+#include <simulation_object.h>
+#include <petscinterface.h>
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscCreatePreconMat"
+/*!
+  Create the preconditioning matrix assembled by PetscComputePreconMatImpl(): the matrix
+  is stored in the block compressed row format (MATBAIJ) with the block size #HyPar::nvars,
+  and is preallocated exactly for the first order stencil, i.e., each block row has a
+  diagonal block and one block for each left and right neighbor (along each dimension)
+  that is a computational point, counted separately in the diagonal (local) and off-diagonal
+  (other ranks) parts.
+
+  A local-to-global block mapping is attached to the matrix: the local block index of a grid
+  point is its index in the array #HyPar::u (with ghost points), offset by the sizes of the
+  arrays of the preceding simulation domains, and it is mapped to its global DOF index
+  (#PETScContext::globalDOF); ghost points at physical boundaries are mapped to -1. Thus,
+  PetscComputePreconMatImpl() inserts each block row with one call to MatSetValuesBlockedLocal().
+
+  Since the nonzero pattern is fixed, inserting a new nonzero location is an error, and it
+  is retained by MatZeroEntries() between successive assemblies.
+
+  Must be called after PetscCreatePointList() and PetscGlobalDOF().
+*/
+int PetscCreatePreconMat( Mat *B,     /*!< Preconditioning matrix to create */
+                          void *ctxt  /*!< Application context */ )
+{
+  PETScContext* context = (PETScContext*) ctxt;
+  SimulationObject* sim = (SimulationObject*) context->simobj;
+  int nsims = context->nsims;
+  int bs = sim[0].solver.nvars;
+
+  PetscFunctionBegin;
+
+  /* number of nonzero blocks in each local block row */
+  std::vector<PetscInt> d_nnz(context->npoints,0), o_nnz(context->npoints,0);
+  int rstart = (int) context->globalDOF[0][context->points[0][sim[0].solver.ndims]];
+  int rend   = rstart + context->npoints;
+
+  /* local-to-global block mapping */
+  int nlocal = 0;
+  for (int ns = 0; ns < nsims; ns++) nlocal += sim[ns].solver.npoints_local_wghosts;
+  std::vector<PetscInt> l2g(nlocal,-1);
+
+  int row = 0, offset = 0;
+  for (int ns = 0; ns < nsims; ns++) {
+
+    HyPar* solver( &(sim[ns].solver) );
+    int ndims = solver->ndims,
+        npoints = solver->npoints_local,
+        ghosts = solver->ghosts,
+        *dim = solver->dim_local,
+        *points = context->points[ns];
+    double *globalDOF = context->globalDOF[ns];
+
+    for (int p = 0; p < solver->npoints_local_wghosts; p++) {
+      l2g[offset+p] = (PetscInt) globalDOF[p];
+    }
+
+    for (int n = 0; n < npoints; n++) {
+      int *this_point = points + n*(ndims+1);
+      int p = this_point[ndims];
+      int index[ndims]; _ArrayCopy1D_(this_point,index,ndims);
+
+      std::vector<int> cols(1,(int)globalDOF[p]);
+      for (int dir = 0; dir < ndims; dir++) {
+        int indexL[ndims]; _ArrayCopy1D_(index,indexL,ndims); indexL[dir]--;
+        int indexR[ndims]; _ArrayCopy1D_(index,indexR,ndims); indexR[dir]++;
+        int pL; _ArrayIndex1D_(ndims,dim,indexL,ghosts,pL);
+        int pR; _ArrayIndex1D_(ndims,dim,indexR,ghosts,pR);
+        int pgL = (int) globalDOF[pL], pgR = (int) globalDOF[pR];
+        if ((pgL >= 0) && (std::find(cols.begin(),cols.end(),pgL) == cols.end())) cols.push_back(pgL);
+        if ((pgR >= 0) && (std::find(cols.begin(),cols.end(),pgR) == cols.end())) cols.push_back(pgR);
+      }
+      for (int k = 0; k < (int) cols.size(); k++) {
+        if ((cols[k] >= rstart) && (cols[k] < rend)) d_nnz[row]++;
+        else                                         o_nnz[row]++;
+      }
+      row++;
+    }
+
+    offset += solver->npoints_local_wghosts;
+  }
+
+  MatCreate(MPI_COMM_WORLD,B);
+  MatSetSizes(*B,context->ndofs,context->ndofs,PETSC_DETERMINE,PETSC_DETERMINE);
+  MatSetType(*B,MATBAIJ);
+  MatSeqBAIJSetPreallocation(*B,bs,0,d_nnz.data());
+  MatMPIBAIJSetPreallocation(*B,bs,0,d_nnz.data(),0,o_nnz.data());
+  MatSetOption(*B,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_TRUE);
+  MatSetOption(*B,MAT_NO_OFF_PROC_ENTRIES,PETSC_TRUE);
+
+  ISLocalToGlobalMapping map;
+  ISLocalToGlobalMappingCreate(MPI_COMM_WORLD,bs,nlocal,l2g.data(),PETSC_COPY_VALUES,&map);
+  MatSetLocalToGlobalMapping(*B,map,map);
+  ISLocalToGlobalMappingDestroy(&map);
+
+  PetscFunctionReturn(0);
+}
+
+#endif
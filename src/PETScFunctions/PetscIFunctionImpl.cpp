@@ -12,6 +12,8 @@
 #include <simulation_object.h>
 #include <petscinterface.h>
 
+extern "C" int FusedRHSFunction(double*,double*,void*,void*,double,int);
+
 #undef __FUNCT__
 #define __FUNCT__ "PetscIFunctionImpl"
 
@@ -44,6 +46,7 @@ PetscErrorCode PetscIFunctionImpl(  TS        ts,   /*!< Time integration object
   PETScContext* context = (PETScContext*) ctxt;
   SimulationObject* sim = (SimulationObject*) context->simobj;
   int nsims = context->nsims;
+  _DECLARE_IERR_;
 
   PetscFunctionBegin;
   for (int ns = 0; ns < nsims; ns++) {
@@ -68,15 +71,8 @@ PetscErrorCode PetscIFunctionImpl(  TS        ts,   /*!< Time integration object
                               mpi,
                               u );
 
-    /* Evaluate hyperbolic, parabolic and source terms  and the RHS */
-    solver->HyperbolicFunction(solver->hyp,u,solver,mpi,t,1,solver->FFunction,solver->Upwind);
-    solver->ParabolicFunction (solver->par,u,solver,mpi,t);
-    solver->SourceFunction    (solver->source,u,solver,mpi,t);
-
-    _ArraySetValue_(rhs,size*solver->nvars,0.0);
-    _ArrayAXPY_(solver->hyp   ,-1.0,rhs,size*solver->nvars);
-    _ArrayAXPY_(solver->par   , 1.0,rhs,size*solver->nvars);
-    _ArrayAXPY_(solver->source, 1.0,rhs,size*solver->nvars);
+    /* Evaluate hyperbolic, parabolic and source terms and add them to the RHS in place */
+    IERR FusedRHSFunction(rhs,u,solver,mpi,t,1); CHECKERR(ierr);
 
     /* save a copy of the solution and RHS for use in IJacobian */
     _ArrayCopy1D_(u  ,solver->uref  ,(size*solver->nvars));
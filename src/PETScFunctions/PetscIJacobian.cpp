@@ -12,6 +12,8 @@
 #include <simulation_object.h>
 #include <petscinterface.h>
 
+extern "C" int FusedRHSFunction(double*,double*,void*,void*,double,int);
+
 #undef __FUNCT__
 #define __FUNCT__ "PetscIJacobian"
 /*!
@@ -36,7 +38,8 @@
     + Saves the #PETScContext::shift (\f$\alpha\f$) and #PETScContext::waqt (current simulation time)
       to the application context (so that PetscJacobianFunction_JFNK() or PetscJacobianFunction_Linear()
       can access these values).
-    + If a preconditioner is being used, calls the function to compute the preconditioning matrix.
+    + If a preconditioner is being used, calls the function to compute the preconditioning matrix
+      (or, with "-pc_matrix_type adi", to set up the line-implicit preconditioner, see PetscPreconADISetUp()).
 
     \b Notes:
     + The Jacobian is defined as the PETSc type MatShell
@@ -67,7 +70,10 @@ PetscErrorCode PetscIJacobian( TS ts,        /*!< Time stepping object (see PETS
   context->shift = a;
   context->waqt  = t;
   /* Construct preconditioning matrix */
-  if (context->flag_use_precon) PetscComputePreconMatImpl(B,Y,context);
+  if (context->flag_use_precon) {
+    if (context->precon_matrix_type == "adi") PetscPreconADISetUp(Y,context);
+    else PetscComputePreconMatImpl(B,Y,context);
+  }
 
   PetscFunctionReturn(0);
 }
@@ -114,6 +120,7 @@ PetscErrorCode PetscJacobianFunction_JFNK( Mat Jacobian, /*!< Jacobian matrix */
                                                               (Jacobian times input vector) */ )
 {
   PETScContext* context(nullptr);
+  _DECLARE_IERR_;
 
   PetscFunctionBegin;
 
@@ -142,16 +149,13 @@ PetscErrorCode PetscJacobianFunction_JFNK( Mat Jacobian, /*!< Jacobian matrix */
       MPIVariables* mpi = &(sim[ns].mpi);
       solver->count_IJacFunction++;
 
-      int size = solver->npoints_local_wghosts;
-
       double *u       = solver->u;
       double *uref    = solver->uref;
       double *rhsref  = solver->rhsref;
       double *rhs     = solver->rhs;
 
-      /* copy solution from PETSc vector */
-      TransferVecFromPETSc(u,Y,context,ns,context->offsets[ns]);
-      _ArrayAYPX_(uref,epsilon,u,size*solver->nvars);
+      /* U0 + epsilon*Y, copied from PETSc vector */
+      TransferVecFromPETScAYPX(u,uref,epsilon,Y,context,ns,context->offsets[ns]);
       /* apply boundary conditions and exchange data over MPI interfaces */
       solver->ApplyBoundaryConditions(solver,mpi,u,NULL,t);
       MPIExchangeBoundariesnD(  solver->ndims,
@@ -161,23 +165,12 @@ PetscErrorCode PetscJacobianFunction_JFNK( Mat Jacobian, /*!< Jacobian matrix */
                                 mpi,
                                 u );
 
-      /* Evaluate hyperbolic, parabolic and source terms  and the RHS for U+dU */
-      _ArraySetValue_(rhs,size*solver->nvars,0.0);
-      solver->HyperbolicFunction( solver->hyp,u,solver,mpi,t,0,
-                                  solver->FFunction,solver->Upwind);
-      _ArrayAXPY_(solver->hyp,-1.0,rhs,size*solver->nvars);
-      solver->ParabolicFunction (solver->par,u,solver,mpi,t);
-      _ArrayAXPY_(solver->par, 1.0,rhs,size*solver->nvars);
-      solver->SourceFunction (solver->source,u,solver,mpi,t);
-      _ArrayAXPY_(solver->source, 1.0,rhs,size*solver->nvars);
-
-      _ArrayAXPY_(rhsref,-1.0,rhs,size*solver->nvars);
-      /* Transfer RHS to PETSc vector */
-      TransferVecToPETSc(rhs,F,context,ns,context->offsets[ns]);
-    }
+      /* Evaluate hyperbolic, parabolic and source terms and the RHS for U+dU in place */
+      IERR FusedRHSFunction(rhs,u,solver,mpi,t,0); CHECKERR(ierr);
 
-    /* [J]Y = aY - F(Y) */
-    VecAXPBY(F,context->shift,(-1.0/epsilon),Y);
+      /* [J]Y = aY - F(Y): computed while transferring RHS to PETSc vector */
+      TransferVecToPETScAXPBY(rhs,rhsref,context->shift,(-1.0/epsilon),Y,F,context,ns,context->offsets[ns]);
+    }
 
   }
 
@@ -239,6 +232,7 @@ PetscErrorCode PetscJacobianFunction_Linear( Mat Jacobian, /*!< Jacobian matrix
                                                                 (Jacobian times input vector */)
 {
   PETScContext* context(nullptr);
+  _DECLARE_IERR_;
 
   PetscFunctionBegin;
 
@@ -266,16 +260,13 @@ PetscErrorCode PetscJacobianFunction_Linear( Mat Jacobian, /*!< Jacobian matrix
       MPIVariables* mpi = &(sim[ns].mpi);
       solver->count_IJacFunction++;
 
-      int size = solver->npoints_local_wghosts;
-
       double *u       = solver->u;
       double *uref    = solver->uref;
       double *rhsref  = solver->rhsref;
       double *rhs     = solver->rhs;
 
-      /* copy solution from PETSc vector */
-      TransferVecFromPETSc(u,Y,context,ns,context->offsets[ns]);
-      _ArrayAYPX_(uref,1.0,u,size*solver->nvars);
+      /* U0 + Y, copied from PETSc vector */
+      TransferVecFromPETScAYPX(u,uref,1.0,Y,context,ns,context->offsets[ns]);
       /* apply boundary conditions and exchange data over MPI interfaces */
       solver->ApplyBoundaryConditions(solver,mpi,u,NULL,t);
       MPIExchangeBoundariesnD(  solver->ndims,
@@ -285,23 +276,12 @@ PetscErrorCode PetscJacobianFunction_Linear( Mat Jacobian, /*!< Jacobian matrix
                                 mpi,
                                 u );
 
-      /* Evaluate hyperbolic, parabolic and source terms  and the RHS for U+dU */
-      _ArraySetValue_(rhs,size*solver->nvars,0.0);
-      solver->HyperbolicFunction( solver->hyp,u,solver,mpi,t,0,
-                                  solver->FFunction,solver->Upwind);
-      _ArrayAXPY_(solver->hyp,-1.0,rhs,size*solver->nvars);
-      solver->ParabolicFunction (solver->par,u,solver,mpi,t);
-      _ArrayAXPY_(solver->par, 1.0,rhs,size*solver->nvars);
-      solver->SourceFunction (solver->source,u,solver,mpi,t);
-      _ArrayAXPY_(solver->source, 1.0,rhs,size*solver->nvars);
-
-      _ArrayAXPY_(rhsref,-1.0,rhs,size*solver->nvars);
-      /* Transfer RHS to PETSc vector */
-      TransferVecToPETSc(rhs,F,context,ns,context->offsets[ns]);
-    }
+      /* Evaluate hyperbolic, parabolic and source terms and the RHS for U+dU in place */
+      IERR FusedRHSFunction(rhs,u,solver,mpi,t,0); CHECKERR(ierr);
 
-    /* [J]Y = aY - F(Y) */
-    VecAXPBY(F,context->shift,-1.0,Y);
+      /* [J]Y = aY - F(Y): computed while transferring RHS to PETSc vector */
+      TransferVecToPETScAXPBY(rhs,rhsref,context->shift,-1.0,Y,F,context,ns,context->offsets[ns]);
+    }
 
   }
 
@@ -41,7 +41,8 @@
     + Saves the #PETScContext::shift (\f$\alpha\f$) and #PETScContext::waqt (current simulation time)
       to the application context (so that PetscJacobianFunctionIMEX_JFNK() or PetscJacobianFunctionIMEX_Linear()
       can access these values).
-    + If a preconditioner is being used, calls the function to compute the preconditioning matrix.
+    + If a preconditioner is being used, calls the function to compute the preconditioning matrix
+      (or, with "-pc_matrix_type adi", to set up the line-implicit preconditioner, see PetscPreconADISetUp()).
 
     \sa PetscIFunctionIMEX()
 
@@ -76,7 +77,10 @@ PetscErrorCode PetscIJacobianIMEX(TS ts,        /*!< Time stepping object (see P
   context->shift = a;
   context->waqt  = t;
   /* Construct preconditioning matrix */
-  if (context->flag_use_precon) PetscComputePreconMatIMEX(B,Y,context);
+  if (context->flag_use_precon) {
+    if (context->precon_matrix_type == "adi") PetscPreconADISetUp(Y,context);
+    else PetscComputePreconMatIMEX(B,Y,context);
+  }
 
   PetscFunctionReturn(0);
 }
@@ -165,9 +169,8 @@ PetscErrorCode PetscJacobianFunctionIMEX_JFNK(Mat Jacobian, /*!< Jacobian matrix
       double *rhsref  = solver->rhsref;
       double *rhs     = solver->rhs;
 
-      /* copy solution from PETSc vector */
-      TransferVecFromPETSc(u,Y,context,ns,context->offsets[ns]);
-      _ArrayAYPX_(uref,epsilon,u,size*solver->nvars);
+      /* U0 + epsilon*Y, copied from PETSc vector */
+      TransferVecFromPETScAYPX(u,uref,epsilon,Y,context,ns,context->offsets[ns]);
       /* apply boundary conditions and exchange data over MPI interfaces */
       solver->ApplyBoundaryConditions(solver,mpi,u,NULL,t);
       MPIExchangeBoundariesnD(  solver->ndims,
@@ -220,14 +223,10 @@ PetscErrorCode PetscJacobianFunctionIMEX_JFNK(Mat Jacobian, /*!< Jacobian matrix
         _ArrayAXPY_(solver->source, 1.0,rhs,size*solver->nvars);
       }
 
-      _ArrayAXPY_(rhsref,-1.0,rhs,size*solver->nvars);
-      /* Transfer RHS to PETSc vector */
-      TransferVecToPETSc(rhs,F,context,ns,context->offsets[ns]);
+      /* [J]Y = aY - F(Y): computed while transferring RHS to PETSc vector */
+      TransferVecToPETScAXPBY(rhs,rhsref,context->shift,(-1.0/epsilon),Y,F,context,ns,context->offsets[ns]);
     }
 
-    /* [J]Y = aY - F(Y) */
-    VecAXPBY(F,context->shift,(-1.0/epsilon),Y);
-
   }
 
   PetscFunctionReturn(0);
@@ -327,9 +326,8 @@ PetscErrorCode PetscJacobianFunctionIMEX_Linear(Mat Jacobian, /*!< Jacobian matr
       double *rhsref  = solver->rhsref;
       double *rhs     = solver->rhs;
 
-      /* copy solution from PETSc vector */
-      TransferVecFromPETSc(u,Y,context,ns,context->offsets[ns]);
-      _ArrayAYPX_(uref,1.0,u,size*solver->nvars);
+      /* U0 + Y, copied from PETSc vector */
+      TransferVecFromPETScAYPX(u,uref,1.0,Y,context,ns,context->offsets[ns]);
       /* apply boundary conditions and exchange data over MPI interfaces */
       solver->ApplyBoundaryConditions(solver,mpi,u,NULL,t);
       MPIExchangeBoundariesnD(  solver->ndims,
@@ -382,14 +380,10 @@ PetscErrorCode PetscJacobianFunctionIMEX_Linear(Mat Jacobian, /*!< Jacobian matr
         _ArrayAXPY_(solver->source, 1.0,rhs,size*solver->nvars);
       }
 
-      _ArrayAXPY_(rhsref,-1.0,rhs,size*solver->nvars);
-      /* Transfer RHS to PETSc vector */
-      TransferVecToPETSc(rhs,F,context,ns,context->offsets[ns]);
+      /* [J]Y = aY - F(Y): computed while transferring RHS to PETSc vector */
+      TransferVecToPETScAXPBY(rhs,rhsref,context->shift,-1.0,Y,F,context,ns,context->offsets[ns]);
     }
 
-    /* [J]Y = aY - F(Y) */
-    VecAXPBY(F,context->shift,-1.0,Y);
-
   }
 
   PetscFunctionReturn(0);
@@ -0,0 +1,342 @@
+/*! @file PetscPreconADI.cpp
+    @brief Line-implicit (ADI) preconditioner for implicit and IMEX time integration
+    @author Debojyoti Ghosh
+*/
+
+#ifdef with_petsc
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <basic.h>
+#include <arrayfunctions.h>
+#include <tridiagLU.h>
+#include <simulation_object.h>
+#include <mpivars_cpp.h>
+#include <petscinterface.h>
+
+/*! Line index and row of a grid point for the line systems along a given dimension:
+    the lines along \a dir are numbered as the points of the grid with dim[dir] = 1,
+    and the row is the index of the point along \a dir. */
+static void PetscPreconADILineIndex(int ndims,    /*!< Number of spatial dimensions */
+                                    int *dim,     /*!< Local grid size */
+                                    int *index,   /*!< Index of the grid point */
+                                    int dir,      /*!< Dimension of the lines */
+                                    int *line,    /*!< Line index */
+                                    int *row      /*!< Row index */ )
+{
+  int bounds_outer[ndims], index_outer[ndims];
+  _ArrayCopy1D_(dim,bounds_outer,ndims); bounds_outer[dir] = 1;
+  _ArrayCopy1D_(index,index_outer,ndims); index_outer[dir] = 0;
+  _ArrayIndex1D_(ndims,bounds_outer,index_outer,0,(*line));
+  *row = index[dir];
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscPreconADICreate"
+/*!
+  Set up the time integration object for the line-implicit (ADI) preconditioner
+  ("-pc_matrix_type adi"): create the matrix-free representation of the Jacobian \a A
+  (the action of the Jacobian is computed by PetscJacobianFunctionIMEX_Linear() or
+  PetscJacobianFunctionIMEX_JFNK() for IMEX time integration, and by PetscJacobianFunction_Linear()
+  or PetscJacobianFunction_JFNK() for implicit time integration), set the IJacobian function of
+  the time integration object, and set its preconditioner to a PETSc PCShell that applies
+  PetscPreconADIApply(). The preconditioning matrix is never assembled; its line systems are
+  computed by PetscPreconADISetUp(), called from the IJacobian function.
+
+  Returns a nonzero value if the physical model defines neither of the point-wise Jacobians
+  (#HyPar::JFunction, #HyPar::KFunction).
+
+  Called by SolvePETSc().
+*/
+int PetscPreconADICreate( TS    ts,   /*!< Time integration object */
+                          Mat   *A,   /*!< Matrix-free Jacobian to create */
+                          int   imex, /*!< IMEX (1) or implicit (0) time integration */
+                          void  *ctxt /*!< Application context */ )
+{
+  PETScContext* context = (PETScContext*) ctxt;
+  SimulationObject* sim = (SimulationObject*) context->simobj;
+  int nsims = context->nsims;
+
+  SNES          snes;
+  KSP           ksp;
+  PC            pc;
+  SNESType      snestype;
+  TSProblemType ptype;
+
+  PetscFunctionBegin;
+
+  TSGetSNES(ts,&snes);
+  SNESGetType(snes,&snestype);
+  TSGetProblemType(ts,&ptype);
+
+  /* Matrix-free representation of the Jacobian */
+  MatCreateShell( MPI_COMM_WORLD,
+                  context->ndofs,
+                  context->ndofs,
+                  PETSC_DETERMINE,
+                  PETSC_DETERMINE,
+                  context,
+                  A);
+  if ((!strcmp(snestype,SNESKSPONLY)) || (ptype == TS_LINEAR)) {
+    /* linear problem */
+    context->flag_is_linear = 1;
+    MatShellSetOperation(*A,MATOP_MULT,(imex ? (void (*)(void))PetscJacobianFunctionIMEX_Linear
+                                             : (void (*)(void))PetscJacobianFunction_Linear));
+    SNESSetType(snes,SNESKSPONLY);
+  } else {
+    /* nonlinear problem */
+    context->flag_is_linear = 0;
+    context->jfnk_eps = 1e-7;
+    PetscOptionsGetReal(NULL,NULL,"-jfnk_epsilon",&context->jfnk_eps,NULL);
+    MatShellSetOperation(*A,MATOP_MULT,(imex ? (void (*)(void))PetscJacobianFunctionIMEX_JFNK
+                                             : (void (*)(void))PetscJacobianFunction_JFNK));
+  }
+  MatSetUp(*A);
+
+  /* check if Jacobian of the physical model is defined */
+  for (int ns = 0; ns < nsims; ns++) {
+    if ((!sim[ns].solver.JFunction) && (!sim[ns].solver.KFunction)) {
+      if (!context->rank) {
+        fprintf(stderr,"Error in SolvePETSc(): solver->JFunction  or solver->KFunction ");
+        fprintf(stderr,"(point-wise Jacobians for hyperbolic or parabolic terms) must ");
+        fprintf(stderr,"be defined for preconditioning.\n");
+      }
+      PetscFunctionReturn(1);
+    }
+  }
+
+  /* Set the IJacobian function for TS; the preconditioner is matrix-free */
+  TSSetIJacobian(ts,*A,*A,(imex ? PetscIJacobianIMEX : PetscIJacobian),context);
+
+  /* Set PC (preconditioner) to the line-implicit (ADI) preconditioner */
+  SNESGetKSP(snes,&ksp);
+  KSPGetPC(ksp,&pc);
+  PCSetType(pc,PCSHELL);
+  PCShellSetContext(pc,context);
+  PCShellSetApply(pc,PetscPreconADIApply);
+  PCShellSetName(pc,"line-implicit (ADI)");
+  if (!context->rank) printf("PETSc:    Using line-implicit (ADI) preconditioner.\n");
+
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscPreconADISetUp"
+/*!
+  Set up the line-implicit (alternating direction implicit, ADI) preconditioner for the
+  implicit or IMEX time integration of the governing equations. This is the approximate
+  factorization of the first-order preconditioning matrix assembled by PetscComputePreconMatImpl():
+  \f{equation}{
+    {\bf J}_p = \alpha{\bf I} + \sum_{d} {\bf M}_d
+    \approx \frac{1}{\alpha^{D-1}} \prod_{d} \left(\alpha{\bf I} + {\bf M}_d\right),
+  \f}
+  where \f${\bf M}_d\f$ is the contribution of the first order discretization of the hyperbolic
+  (#HyPar::JFunction) and parabolic (#HyPar::KFunction) terms along dimension \f$d\f$, \f$D\f$ is
+  the number of spatial dimensions, and \f$\alpha\f$ is the shift (#PETScContext::shift). Each factor
+  is block tridiagonal along the grid lines of its dimension; this function computes the
+  blocks of these line systems at the solution \a Y and stores them (#PETScContext::adi_blocks), so
+  that the global preconditioning matrix is never assembled. PetscPreconADIApply() solves them.
+
+  The lines are not coupled across periodic boundaries, i.e., the preconditioner does not
+  include the periodic wrap-around blocks.
+
+  Called by PetscIJacobian() or PetscIJacobianIMEX() if "-pc_matrix_type adi" is specified.
+*/
+int PetscPreconADISetUp(Vec Y,      /*!< Solution vector */
+                        void *ctxt  /*!< Application context */ )
+{
+  PETScContext* context = (PETScContext*) ctxt;
+  SimulationObject* sim = (SimulationObject*) context->simobj;
+  int nsims = context->nsims;
+
+  PetscFunctionBegin;
+
+  if (!context->adi_lu) {
+    context->adi_lu = calloc (1,sizeof(TridiagLU));
+    tridiagLUInit(context->adi_lu,&(sim[0].mpi.world));
+  }
+
+  for (int ns = 0; ns < nsims; ns++) {
+
+    HyPar* solver( &(sim[ns].solver) );
+    MPIVariables* mpi( &(sim[ns].mpi) );
+
+    int ndims   = solver->ndims,
+        nvars   = solver->nvars,
+        bs2     = nvars*nvars,
+        npoints = solver->npoints_local,
+        ghosts  = solver->ghosts,
+        *dim    = solver->dim_local,
+        *points = context->points[ns];
+
+    if ((int) context->adi_blocks.size() <= ns) {
+      context->adi_blocks.push_back((double*) calloc (3*ndims*npoints*bs2,sizeof(double)));
+      context->adi_work.push_back((double*) calloc (  solver->npoints_local_wghosts*nvars
+                                                    + 3*npoints*bs2 + npoints*nvars,
+                                                    sizeof(double)));
+    }
+
+    TransferVecFromPETSc(solver->u,Y,context,ns,context->offsets[ns]);
+    double *u = solver->u;
+
+    /* apply boundary conditions and exchange data over MPI interfaces */
+    solver->ApplyBoundaryConditions(solver,mpi,u,NULL,context->waqt);
+    MPIExchangeBoundariesnD(ndims,nvars,dim,ghosts,mpi,u);
+
+    double values[bs2], identity[bs2];
+    _ArraySetValue_(identity,bs2,0.0);
+    for (int v = 0; v < nvars; v++) identity[v*nvars+v] = context->shift;
+
+    for (int dir = 0; dir < ndims; dir++) {
+
+      /* sub-diagonal, diagonal, and super-diagonal blocks of the lines along dir,
+         in the layout expected by blocktridiagLU() */
+      double *A = context->adi_blocks[ns] + (3*dir+0)*npoints*bs2;
+      double *B = context->adi_blocks[ns] + (3*dir+1)*npoints*bs2;
+      double *C = context->adi_blocks[ns] + (3*dir+2)*npoints*bs2;
+      int nlines = npoints / dim[dir];
+
+      for (int n = 0; n < npoints; n++) {
+        int *this_point = points + n*(ndims+1);
+        int p = this_point[ndims];
+        int index[ndims]; _ArrayCopy1D_(this_point,index,ndims);
+        int indexL[ndims]; _ArrayCopy1D_(index,indexL,ndims); indexL[dir]--;
+        int indexR[ndims]; _ArrayCopy1D_(index,indexR,ndims); indexR[dir]++;
+        int pL;  _ArrayIndex1D_(ndims,dim,indexL,ghosts,pL);
+        int pR;  _ArrayIndex1D_(ndims,dim,indexR,ghosts,pR);
+
+        int line, row;
+        PetscPreconADILineIndex(ndims,dim,index,dir,&line,&row);
+        double *a = A + (row*nlines+line)*bs2;
+        double *b = B + (row*nlines+line)*bs2;
+        double *c = C + (row*nlines+line)*bs2;
+
+        double iblank = solver->iblank[p], dxinv;
+        _GetCoordinate_(dir,index[dir],dim,ghosts,solver->dxinv,dxinv);
+
+        _ArrayCopy1D_(identity,b,bs2);
+        _ArraySetValue_(a,bs2,0.0);
+        _ArraySetValue_(c,bs2,0.0);
+
+        if (solver->JFunction) {
+          solver->JFunction(values,(u+nvars*p),solver->physics,dir,nvars,0);
+          _ArrayAXPY_(values,(dxinv*iblank),b,bs2);
+          solver->JFunction(values,(u+nvars*pL),solver->physics,dir,nvars,1);
+          _ArrayAXPY_(values,(-dxinv*iblank),a,bs2);
+          solver->JFunction(values,(u+nvars*pR),solver->physics,dir,nvars,-1);
+          _ArrayAXPY_(values,(-dxinv*iblank),c,bs2);
+        }
+        if (solver->KFunction) {
+          solver->KFunction(values,(u+nvars*p),solver->physics,dir,nvars);
+          _ArrayAXPY_(values,(-2*dxinv*dxinv*iblank),b,bs2);
+          solver->KFunction(values,(u+nvars*pL),solver->physics,dir,nvars);
+          _ArrayAXPY_(values,(dxinv*dxinv*iblank),a,bs2);
+          solver->KFunction(values,(u+nvars*pR),solver->physics,dir,nvars);
+          _ArrayAXPY_(values,(dxinv*dxinv*iblank),c,bs2);
+        }
+
+        /* no coupling across the physical (or periodic) boundaries */
+        if ((mpi->ip[dir] == 0) && (index[dir] == 0)) {
+          _ArraySetValue_(a,bs2,0.0);
+        }
+        if ((mpi->ip[dir] == mpi->iproc[dir]-1) && (index[dir] == dim[dir]-1)) {
+          _ArraySetValue_(c,bs2,0.0);
+        }
+      }
+    }
+  }
+
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscPreconADIApply"
+/*!
+  Apply the line-implicit (ADI) preconditioner (see PetscPreconADISetUp()):
+  \f{equation}{
+    {\bf z} = \alpha^{D-1} \prod_{d} \left(\alpha{\bf I} + {\bf M}_d\right)^{-1} {\bf r},
+  \f}
+  i.e., one set of block tridiagonal line solves (blocktridiagLU()) along each dimension,
+  one after the other. The line systems are distributed across the MPI ranks along that
+  dimension and solved in parallel on the sub-communicator of the dimension.
+
+  This is the apply function of a PETSc PCShell
+  (https://petsc.org/release/docs/manualpages/PC/PCSHELL.html).
+*/
+PetscErrorCode PetscPreconADIApply(PC  pc, /*!< The preconditioner */
+                                   Vec R,  /*!< Input vector */
+                                   Vec Z   /*!< Output vector (preconditioner applied to input vector) */ )
+{
+  PETScContext* context(nullptr);
+
+  PetscFunctionBegin;
+
+  PCShellGetContext(pc,&context);
+  SimulationObject* sim = (SimulationObject*) context->simobj;
+  int nsims = context->nsims;
+
+  for (int ns = 0; ns < nsims; ns++) {
+
+    HyPar* solver( &(sim[ns].solver) );
+    MPIVariables* mpi( &(sim[ns].mpi) );
+
+    int ndims   = solver->ndims,
+        nvars   = solver->nvars,
+        bs2     = nvars*nvars,
+        npoints = solver->npoints_local,
+        ghosts  = solver->ghosts,
+        *dim    = solver->dim_local;
+
+    double *w = context->adi_work[ns];
+    double *a = w + solver->npoints_local_wghosts*nvars;
+    double *b = a + npoints*bs2;
+    double *c = b + npoints*bs2;
+    double *x = c + npoints*bs2;
+
+    TransferVecFromPETSc(w,R,context,ns,context->offsets[ns]);
+
+    for (int dir = 0; dir < ndims; dir++) {
+
+      int nlines = npoints / dim[dir];
+
+      /* the line solve destroys the blocks, so solve with a copy */
+      _ArrayCopy1D_((context->adi_blocks[ns]+(3*dir+0)*npoints*bs2),a,(npoints*bs2));
+      _ArrayCopy1D_((context->adi_blocks[ns]+(3*dir+1)*npoints*bs2),b,(npoints*bs2));
+      _ArrayCopy1D_((context->adi_blocks[ns]+(3*dir+2)*npoints*bs2),c,(npoints*bs2));
+
+      /* gather the right-hand-sides of the lines; scale by the shift to
+         account for the factor 1/alpha of each additional dimension */
+      double scale = (dir ? context->shift : 1.0);
+      int index[ndims], done = 0; _ArraySetValue_(index,ndims,0);
+      while (!done) {
+        int p; _ArrayIndex1D_(ndims,dim,index,ghosts,p);
+        int line, row; PetscPreconADILineIndex(ndims,dim,index,dir,&line,&row);
+        for (int v = 0; v < nvars; v++) x[(row*nlines+line)*nvars+v] = scale * w[p*nvars+v];
+        _ArrayIncrementIndex_(ndims,dim,index,done);
+      }
+
+      int ierr = blocktridiagLU(a,b,c,x,dim[dir],nlines,nvars,context->adi_lu,&mpi->comm[dir]);
+      if (ierr) {
+        fprintf(stderr,"Error in PetscPreconADIApply(): blocktridiagLU() returned %d ",ierr);
+        fprintf(stderr,"for the lines along dimension %d on rank %d.\n",dir,mpi->rank);
+        PetscFunctionReturn(ierr);
+      }
+
+      /* scatter the solutions of the lines */
+      done = 0; _ArraySetValue_(index,ndims,0);
+      while (!done) {
+        int p; _ArrayIndex1D_(ndims,dim,index,ghosts,p);
+        int line, row; PetscPreconADILineIndex(ndims,dim,index,dir,&line,&row);
+        for (int v = 0; v < nvars; v++) w[p*nvars+v] = x[(row*nlines+line)*nvars+v];
+        _ArrayIncrementIndex_(ndims,dim,index,done);
+      }
+    }
+
+    TransferVecToPETSc(w,Z,context,ns,context->offsets[ns]);
+  }
+
+  PetscFunctionReturn(0);
+}
+
+#endif
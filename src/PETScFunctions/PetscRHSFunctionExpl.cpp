@@ -12,6 +12,8 @@
 #include <simulation_object.h>
 #include <petscinterface.h>
 
+extern "C" int FusedRHSFunction(double*,double*,void*,void*,double,int);
+
 #undef __FUNCT__
 #define __FUNCT__ "PetscRHSFunctionExpl"
 
@@ -42,6 +44,7 @@ PetscErrorCode PetscRHSFunctionExpl(  TS        ts,   /*!< Time integration obje
   PETScContext* context = (PETScContext*) ctxt;
   SimulationObject* sim = (SimulationObject*) context->simobj;
   int nsims = context->nsims;
+  _DECLARE_IERR_;
 
   PetscFunctionBegin;
 
@@ -52,7 +55,6 @@ PetscErrorCode PetscRHSFunctionExpl(  TS        ts,   /*!< Time integration obje
 
     solver->count_RHSFunction++;
 
-    int size = solver->npoints_local_wghosts;
     double* u = solver->u;
     double* rhs = solver->rhs;
 
@@ -67,16 +69,8 @@ PetscErrorCode PetscRHSFunctionExpl(  TS        ts,   /*!< Time integration obje
                               mpi,
                               u );
 
-    /* Evaluate hyperbolic, parabolic and source terms  and the RHS */
-    solver->HyperbolicFunction(solver->hyp,u,solver,mpi,t,1,solver->FFunction,solver->Upwind);
-
-    solver->ParabolicFunction (solver->par,u,solver,mpi,t);
-    solver->SourceFunction    (solver->source,u,solver,mpi,t);
-
-    _ArraySetValue_(rhs,size*solver->nvars,0.0);
-    _ArrayAXPY_(solver->hyp   ,-1.0,rhs,size*solver->nvars);
-    _ArrayAXPY_(solver->par   , 1.0,rhs,size*solver->nvars);
-    _ArrayAXPY_(solver->source, 1.0,rhs,size*solver->nvars);
+    /* Evaluate hyperbolic, parabolic and source terms and add them to the RHS in place */
+    IERR FusedRHSFunction(rhs,u,solver,mpi,t,1); CHECKERR(ierr);
 
     /* Transfer RHS to PETSc vector */
     TransferVecToPETSc(rhs,F,context,ns,context->offsets[ns]);
@@ -46,4 +46,43 @@ int TransferVecFromPETSc( double* const u, /*!< HyPar::u type array (with ghost
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "TransferVecFromPETScAYPX"
+
+/*! Compute \f${\bf u} = {\bf u}_{\rm ref} + a{\bf Y}\f$ at the computational points, where
+    \f${\bf Y}\f$ is a PETSc vector (with no ghost points) and \f${\bf u}\f$, \f${\bf u}_{\rm ref}\f$
+    are HyPar::u type arrays (with ghost points). This is TransferVecFromPETSc() followed by
+    _ArrayAYPX_() in one pass over the data; the ghost points of \a u are not set (they
+    are filled by the boundary conditions and the MPI exchange that follow).
+
+    \sa TransferVecFromPETSc(), TransferVecToPETScAXPBY()
+*/
+int TransferVecFromPETScAYPX( double* const u, /*!< HyPar::u type array (with ghost points) */
+                              const double* const uref, /*!< HyPar::u type array (with ghost points) */
+                              const double a, /*!< Scaling factor */
+                              const Vec Y, /*!< PETSc vector */
+                              void* ctxt, /*!< Object of type #PETScContext */
+                              const int sim_idx,/*!< Simulation object index */
+                              const int offset  /*!< Offset */ )
+{
+  PETScContext* context = (PETScContext*) ctxt;
+  SimulationObject* sim = (SimulationObject*) context->simobj;
+  const double* Yarr;
+
+  PetscFunctionBegin;
+  VecGetArrayRead(Y,&Yarr);
+  int ndims   = sim[sim_idx].solver.ndims;
+  int nvars   = sim[sim_idx].solver.nvars;
+  int npoints = sim[sim_idx].solver.npoints_local;
+  const int* points = context->points[sim_idx];
+  const double* y = Yarr + offset;
+  for (int n = 0; n < npoints; n++) {
+    int p = points[n*(ndims+1)+ndims];
+    for (int v = 0; v < nvars; v++) u[p*nvars+v] = uref[p*nvars+v] + a*y[n*nvars+v];
+  }
+  VecRestoreArrayRead(Y,&Yarr);
+
+  PetscFunctionReturn(0);
+}
+
 #endif
@@ -47,6 +47,53 @@ int TransferVecToPETSc( const double* const u, /*!< HyPar::u type array (with gh
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "TransferVecToPETScAXPBY"
+
+/*! Compute \f${\bf F} = a{\bf Y} + b\left({\bf f} - {\bf f}_{\rm ref}\right)\f$, where
+    \f${\bf Y}\f$ and \f${\bf F}\f$ are PETSc vectors (with no ghost points), and \f${\bf f}\f$,
+    \f${\bf f}_{\rm ref}\f$ are HyPar::u type arrays (with ghost points). This is _ArrayAXPY_(),
+    TransferVecToPETSc(), and VecAXPBY() in one pass over the data, for the part of the
+    vectors that belongs to one simulation domain.
+
+    \sa TransferVecToPETSc(), TransferVecFromPETScAYPX()
+*/
+int TransferVecToPETScAXPBY(const double* const f, /*!< HyPar::u type array (with ghost points) */
+                            const double* const fref, /*!< HyPar::u type array (with ghost points) */
+                            const double a, /*!< Scaling factor for Y */
+                            const double b, /*!< Scaling factor for f-fref */
+                            const Vec Y, /*!< PETSc vector */
+                            Vec F, /*!< PETSc vector */
+                            void* ctxt, /*!< Object of type #PETScContext */
+                            const int sim_idx,/*!< Simulation object index */
+                            const int offset  /*!< Offset */ )
+{
+  PETScContext* context = (PETScContext*) ctxt;
+  SimulationObject* sim = (SimulationObject*) context->simobj;
+  const double* Yarr;
+  double* Farr;
+
+  PetscFunctionBegin;
+  VecGetArrayRead(Y,&Yarr);
+  VecGetArray(F,&Farr);
+  int ndims   = sim[sim_idx].solver.ndims;
+  int nvars   = sim[sim_idx].solver.nvars;
+  int npoints = sim[sim_idx].solver.npoints_local;
+  const int* points = context->points[sim_idx];
+  const double* y = Yarr + offset;
+  double* z = Farr + offset;
+  for (int n = 0; n < npoints; n++) {
+    int p = points[n*(ndims+1)+ndims];
+    for (int v = 0; v < nvars; v++) {
+      z[n*nvars+v] = a*y[n*nvars+v] + b*(f[p*nvars+v]-fref[p*nvars+v]);
+    }
+  }
+  VecRestoreArray(F,&Farr);
+  VecRestoreArrayRead(Y,&Yarr);
+
+  PetscFunctionReturn(0);
+}
+
 /*!
   Copy a matrix of type #BandedMatrix to a PETSc matrix.
 */
@@ -45,3 +45,42 @@ double Euler1DComputeCFL(
 
   return(max_cfl);
 }
+
+/*! Computes the CFL number at each grid point of the local domain, for the local time
+    stepping of the steady-state mode (see #HyPar::local_dt_cfl). Returns the maximum
+    over the local domain.
+*/
+double Euler1DComputeLocalCFL(
+                              void    *s,   /*!< Solver object of type #HyPar */
+                              void    *m,   /*!< MPI object of type #MPIVariables */
+                              double  dt,   /*!< Time step size for which to compute the CFL */
+                              double  t,    /*!< Time */
+                              double  *cfl  /*!< Array to hold the CFL number at each grid point (same layout as #HyPar::u, without the variables) */
+                            )
+{
+  HyPar             *solver = (HyPar*)   s;
+  Euler1D           *param  = (Euler1D*) solver->physics;
+
+  int *dim    = solver->dim_local;
+  int ghosts  = solver->ghosts;
+  int ndims   = solver->ndims;
+  int index[ndims];
+  double *u   = solver->u;
+
+  double max_cfl = 0;
+  int done = 0; _ArraySetValue_(index,ndims,0);
+  while (!done) {
+    int p; _ArrayIndex1D_(ndims,dim,index,ghosts,p);
+    double rho, v, e, P, c, dxinv;
+    _Euler1DGetFlowVar_((u+_MODEL_NVARS_*p),rho,v,e,P,param);
+
+    _GetCoordinate_(0,index[0],dim,ghosts,solver->dxinv,dxinv); /* 1/dx */
+    c       = sqrt(param->gamma*P/rho); /* speed of sound */
+    cfl[p]  = (absolute(v)+c)*dt*dxinv; /* local cfl for this grid point */
+    if (cfl[p] > max_cfl) max_cfl = cfl[p];
+
+    _ArrayIncrementIndex_(ndims,dim,index,done);
+  }
+
+  return(max_cfl);
+}
@@ -13,6 +13,7 @@
 #include <hypar.h>
 
 double Euler1DComputeCFL (void*,void*,double,double);
+double Euler1DComputeLocalCFL (void*,void*,double,double,double*);
 int    Euler1DFlux       (double*,double*,int,void*,double);
 int    Euler1DStiffFlux  (double*,double*,int,void*,double);
 int    Euler1DSource     (double*,double*,void*,void*,double);
@@ -152,6 +153,7 @@ int Euler1DInitialize(
   /* initializing physical model-specific functions */
   solver->PreStep            = Euler1DPreStep;
   solver->ComputeCFL         = Euler1DComputeCFL;
+  solver->ComputeLocalCFL    = Euler1DComputeLocalCFL;
   solver->FFunction          = Euler1DFlux;
   solver->SFunction          = Euler1DSource;
   solver->UFunction          = Euler1DModifiedSolution;
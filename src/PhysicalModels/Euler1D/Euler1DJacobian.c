@@ -21,7 +21,7 @@ int Euler1DJacobian(double  *Jac, /*!< Jacobian matrix: 1D array of size nvar^2
                                       -1 -> send back Jacobian of left(-)-moving flux */ )
 {
   Euler1D       *param = (Euler1D*) p;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
                 L[_MODEL_NVARS_*_MODEL_NVARS_], DL[_MODEL_NVARS_*_MODEL_NVARS_];
 
   /* get the eigenvalues and left,right eigenvectors */
@@ -55,7 +55,7 @@ int Euler1DStiffJacobian( double  *Jac, /*!< Jacobian matrix: 1D array of size n
                                             -1 -> send back Jacobian of left(-)-moving flux */ )
 {
   Euler1D       *param = (Euler1D*) p;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
                 L[_MODEL_NVARS_*_MODEL_NVARS_], DL[_MODEL_NVARS_*_MODEL_NVARS_];
 
   /* get the eigenvalues and left,right eigenvectors */
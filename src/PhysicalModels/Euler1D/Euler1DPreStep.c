@@ -26,7 +26,7 @@ int Euler1DPreStep(
   int               ghosts  = solver->ghosts;
   static const int  ndims   = _MODEL_NDIMS_;
   static const int  JacSize = _MODEL_NVARS_*_MODEL_NVARS_;
-  static int        index[_MODEL_NDIMS_], bounds[_MODEL_NDIMS_], offset[_MODEL_NDIMS_];
+  int               index[_MODEL_NDIMS_], bounds[_MODEL_NDIMS_], offset[_MODEL_NDIMS_];
 
   /* set bounds for array index to include ghost points */
   _ArrayAddCopy1D_(dim,(2*ghosts),bounds,ndims);
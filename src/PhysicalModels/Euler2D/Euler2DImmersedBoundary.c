@@ -0,0 +1,71 @@
+/*! @file Euler2DImmersedBoundary.c
+    @brief Immersed boundary treatment for 2D Euler equations
+    @author Debojyoti Ghosh
+*/
+
+#include <basic.h>
+#include <arrayfunctions.h>
+#include <immersedboundaries.h>
+#include <physicalmodels/euler2d.h>
+#include <mpivars.h>
+#include <hypar.h>
+
+/*! Apply slip (inviscid) wall boundary conditions on the immersed boundary points
+    (grid points inside a 2D immersed body within stencil-width distance of the flow):
+    the density, pressure and tangential velocity at an immersed boundary point are
+    those at the tip of its probe (interpolated from the flow), and the normal
+    velocity is mirrored across the body surface. */
+int Euler2DIBSlipWall(void    *s, /*!< Solver object of type #HyPar */
+                      void    *m, /*!< MPI object of type #MPIVariables */
+                      double  *u, /*!< Array with the solution vector */
+                      double  t   /*!< Current simulation time */
+                     )
+{
+  HyPar             *solver   = (HyPar*)   s;
+  MPIVariables      *mpi      = (MPIVariables*) m;
+  ImmersedBoundary  *IB       = (ImmersedBoundary*) solver->ib;
+  IBNode            *boundary = IB->boundary;
+  Euler2D           *param    = (Euler2D*) solver->physics;
+  double            v[_MODEL_NVARS_];
+  int               n, j, k, nb = IB->n_boundary_nodes;
+
+  if (!solver->flag_ib) return(0);
+
+  /* this function is called (through ApplyIBConditions()) before the
+     ghost points are exchanged, and the probe tips may be in them */
+  MPIExchangeBoundariesnD(_MODEL_NDIMS_,_MODEL_NVARS_,solver->dim_local,solver->ghosts,mpi,u);
+
+  double inv_gamma_m1 = 1.0 / (param->gamma - 1.0);
+
+  for (n=0; n<nb; n++) {
+
+    int     node_index = boundary[n].p;
+    double  *alpha = &(boundary[n].interp_coeffs[0]);
+    int     *nodes = &(boundary[n].interp_nodes[0]);
+    double  factor = boundary[n].surface_distance / boundary[n].interp_node_distance;
+    double  nx     = boundary[n].segment->nx,
+            ny     = boundary[n].segment->ny;
+
+    _ArraySetValue_(v,_MODEL_NVARS_,0.0);
+    for (j=0; j<_IB_NNODES_2D_; j++) {
+      for (k=0; k<_MODEL_NVARS_; k++) {
+        v[k] += ( alpha[j] * u[_MODEL_NVARS_*nodes[j]+k] );
+      }
+    }
+
+    double rho, uvel, vvel, energy, pressure;
+    _Euler2DGetFlowVar_(v,rho,uvel,vvel,energy,pressure,param);
+
+    double vn = uvel*nx + vvel*ny;
+    double uvel_ib = uvel - (1.0+factor) * vn * nx;
+    double vvel_ib = vvel - (1.0+factor) * vn * ny;
+    double energy_ib = inv_gamma_m1*pressure + 0.5*rho*(uvel_ib*uvel_ib+vvel_ib*vvel_ib);
+
+    u[_MODEL_NVARS_*node_index+0] = rho;
+    u[_MODEL_NVARS_*node_index+1] = rho * uvel_ib;
+    u[_MODEL_NVARS_*node_index+2] = rho * vvel_ib;
+    u[_MODEL_NVARS_*node_index+3] = energy_ib;
+  }
+
+  return(0);
+}
@@ -9,6 +9,7 @@
 #include <hypar.h>
 
 double Euler2DComputeCFL        (void*,void*,double,double);
+double Euler2DComputeLocalCFL   (void*,void*,double,double,double*);
 int    Euler2DFlux              (double*,double*,int,void*,double);
 int    Euler2DUpwindRoe         (double*,double*,double*,double*,double*,double*,int,void*,double);
 int    Euler2DUpwindRF          (double*,double*,double*,double*,double*,double*,int,void*,double);
@@ -17,6 +18,7 @@ int    Euler2DUpwindSWFS        (double*,double*,double*,double*,double*,double*
 int    Euler2DRoeAverage        (double*,double*,double*,void*);
 int    Euler2DLeftEigenvectors  (double*,double*,void*,int);
 int    Euler2DRightEigenvectors (double*,double*,void*,int);
+int    Euler2DIBSlipWall        (void*,void*,double*,double);
 
 int Euler2DInitialize(void *s,void *m)
 {
@@ -86,6 +88,7 @@ int Euler2DInitialize(void *s,void *m)
 
   /* initializing physical model-specific functions */
   solver->ComputeCFL  = Euler2DComputeCFL;
+  solver->ComputeLocalCFL = Euler2DComputeLocalCFL;
   solver->FFunction   = Euler2DFlux;
   if      (!strcmp(physics->upw_choice,_ROE_ )) solver->Upwind = Euler2DUpwindRoe;
   else if (!strcmp(physics->upw_choice,_RF_  )) solver->Upwind = Euler2DUpwindRF;
@@ -99,6 +102,7 @@ int Euler2DInitialize(void *s,void *m)
   solver->AveragingFunction     = Euler2DRoeAverage;
   solver->GetLeftEigenvectors   = Euler2DLeftEigenvectors;
   solver->GetRightEigenvectors  = Euler2DRightEigenvectors;
+  if (solver->flag_ib) solver->IBFunction = Euler2DIBSlipWall;
 
   /* set the value of gamma in all the boundary objects */
   int n;
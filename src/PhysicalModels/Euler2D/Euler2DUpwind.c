@@ -18,9 +18,9 @@ int Euler2DUpwindRoe(double *fI,double *fL,double *fR,double *uL,double *uR,doub
   int bounds_outer[2], bounds_inter[2];
   bounds_outer[0] = dim[0]; bounds_outer[1] = dim[1]; bounds_outer[dir] = 1;
   bounds_inter[0] = dim[0]; bounds_inter[1] = dim[1]; bounds_inter[dir]++;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_], DL[_MODEL_NVARS_*_MODEL_NVARS_],
-                modA[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, DL[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                modA[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; int index_outer[2] = {0,0}; int index_inter[2];
   while (!done) {
@@ -76,8 +76,8 @@ int Euler2DUpwindRF(double *fI,double *fL,double *fR,double *uL,double *uR,doubl
   int bounds_outer[2], bounds_inter[2];
   bounds_outer[0] = dim[0]; bounds_outer[1] = dim[1]; bounds_outer[dir] = 1;
   bounds_inter[0] = dim[0]; bounds_inter[1] = dim[1]; bounds_inter[dir]++;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; int index_outer[2] = {0,0}, index_inter[2];
   while (!done) {
@@ -147,8 +147,8 @@ int Euler2DUpwindLLF(double *fI,double *fL,double *fR,double *uL,double *uR,doub
   int bounds_outer[2], bounds_inter[2];
   bounds_outer[0] = dim[0]; bounds_outer[1] = dim[1]; bounds_outer[dir] = 1;
   bounds_inter[0] = dim[0]; bounds_inter[1] = dim[1]; bounds_inter[dir]++;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; int index_outer[2] = {0,0}, index_inter[2];
   while (!done) {
@@ -221,7 +221,7 @@ int Euler2DUpwindSWFS(double *fI,double *fL,double *fR,double *uL,double *uR,dou
   int index_outer[ndims], index_inter[ndims], bounds_outer[ndims], bounds_inter[ndims];
   _ArrayCopy1D_(dim,bounds_outer,ndims); bounds_outer[dir] =  1;
   _ArrayCopy1D_(dim,bounds_inter,ndims); bounds_inter[dir] += 1;
-  static double fp[_MODEL_NVARS_], fm[_MODEL_NVARS_],uavg[_MODEL_NVARS_];
+  double        fp[_MODEL_NVARS_], fm[_MODEL_NVARS_],uavg[_MODEL_NVARS_];
 
   done = 0; _ArraySetValue_(index_outer,ndims,0);
   while (!done) {
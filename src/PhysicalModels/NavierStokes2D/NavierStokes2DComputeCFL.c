@@ -51,3 +51,44 @@ double NavierStokes2DComputeCFL(
 
   return(max_cfl);
 }
+
+/*! Computes the CFL number at each grid point of the local domain, for the local time
+    stepping of the steady-state mode (see #HyPar::local_dt_cfl). The CFL numbers along
+    the spatial dimensions are added, so that the forward Euler step is stable for a
+    CFL number of 1. Returns the maximum over the local domain.
+*/
+double NavierStokes2DComputeLocalCFL(
+                                     void    *s,   /*!< Solver object of type #HyPar */
+                                     void    *m,   /*!< MPI object of type #MPIVariables */
+                                     double  dt,   /*!< Time step size for which to compute the CFL */
+                                     double  t,    /*!< Time */
+                                     double  *cfl  /*!< Array to hold the CFL number at each grid point (same layout as #HyPar::u, without the variables) */
+                                   )
+{
+  HyPar             *solver = (HyPar*)   s;
+  NavierStokes2D    *param  = (NavierStokes2D*) solver->physics;
+
+  int *dim    = solver->dim_local;
+  int ghosts  = solver->ghosts;
+  int ndims   = solver->ndims;
+  int index[ndims];
+  double *u   = solver->u;
+
+  double max_cfl = 0;
+  int done = 0; _ArraySetValue_(index,ndims,0);
+  while (!done) {
+    int p; _ArrayIndex1D_(ndims,dim,index,ghosts,p);
+    double rho,vx,vy,e,P,c,dxinv,dyinv;
+    _NavierStokes2DGetFlowVar_((u+_MODEL_NVARS_*p),rho,vx,vy,e,P,param->gamma);
+
+    c = sqrt(param->gamma*P/rho); /* speed of sound */
+    _GetCoordinate_(_XDIR_,index[_XDIR_],dim,ghosts,solver->dxinv,dxinv); /* 1/dx */
+    _GetCoordinate_(_YDIR_,index[_YDIR_],dim,ghosts,solver->dxinv,dyinv); /* 1/dy */
+    cfl[p] = ((absolute(vx)+c)*dxinv + (absolute(vy)+c)*dyinv) * dt;
+    if (cfl[p] > max_cfl) max_cfl = cfl[p];
+
+    _ArrayIncrementIndex_(ndims,dim,index,done);
+  }
+
+  return(max_cfl);
+}
@@ -30,7 +30,7 @@ int NavierStokes2DFlux(
   NavierStokes2D  *param  = (NavierStokes2D*) solver->physics;
   int             *dim    = solver->dim_local;
   int             ghosts  = solver->ghosts;
-  static int      index[_MODEL_NDIMS_], bounds[_MODEL_NDIMS_], offset[_MODEL_NDIMS_];
+  int             index[_MODEL_NDIMS_], bounds[_MODEL_NDIMS_], offset[_MODEL_NDIMS_];
 
   /* set bounds for array index to include ghost points */
   _ArrayAddCopy1D_(dim,(2*ghosts),bounds,_MODEL_NDIMS_);
@@ -73,7 +73,7 @@ int NavierStokes2DStiffFlux(
   int               *dim    = solver->dim_local;
   int               ghosts  = solver->ghosts;
   static const int  JacSize = _MODEL_NVARS_*_MODEL_NVARS_;
-  static int        index[_MODEL_NDIMS_], bounds[_MODEL_NDIMS_], offset[_MODEL_NDIMS_];
+  int               index[_MODEL_NDIMS_], bounds[_MODEL_NDIMS_], offset[_MODEL_NDIMS_];
 
   /* set bounds for array index to include ghost points */
   _ArrayAddCopy1D_(dim,(2*ghosts),bounds,_MODEL_NDIMS_);
@@ -114,8 +114,8 @@ int NavierStokes2DNonStiffFlux(
   int               *dim    = solver->dim_local;
   int               ghosts  = solver->ghosts;
   static const int  JacSize = _MODEL_NVARS_*_MODEL_NVARS_;
-  static int        index[_MODEL_NDIMS_], bounds[_MODEL_NDIMS_], offset[_MODEL_NDIMS_];
-  static double     ftot[_MODEL_NVARS_], fstiff[_MODEL_NVARS_];
+  int               index[_MODEL_NDIMS_], bounds[_MODEL_NDIMS_], offset[_MODEL_NDIMS_];
+  double            ftot[_MODEL_NVARS_], fstiff[_MODEL_NVARS_];
 
   /* set bounds for array index to include ghost points */
   _ArrayAddCopy1D_(dim,(2*ghosts),bounds,_MODEL_NDIMS_);
@@ -2,6 +2,7 @@
     @author Debojyoti Ghosh
     @brief Initialization of the physics-related variables and function pointers for the 2D Navier-Stokes system
 */
+#include <float.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -13,11 +14,13 @@
 #include <hypar.h>
 
 double NavierStokes2DComputeCFL        (void*,void*,double,double);
+double NavierStokes2DComputeLocalCFL   (void*,void*,double,double,double*);
 int    NavierStokes2DFlux              (double*,double*,int,void*,double);
 int    NavierStokes2DStiffFlux         (double*,double*,int,void*,double);
 int    NavierStokes2DNonStiffFlux      (double*,double*,int,void*,double);
 int    NavierStokes2DRoeAverage        (double*,double*,double*,void*);
 int    NavierStokes2DParabolicFunction (double*,double*,void*,void*,double);
+int    NavierStokes2DParabolicFunctionAccumulate (double*,double,double*,void*,void*,double);
 int    NavierStokes2DSource            (double*,double*,void*,void*,double);
 
 int    NavierStokes2DJacobian          (double*,double*,void*,int,int,int);
@@ -50,6 +53,9 @@ int    NavierStokes2DGravityField      (void*,void*);
 int    NavierStokes2DModifiedSolution  (double*,double*,int,void*,void*,double);
 int    NavierStokes2DPreStep           (double*,void*,void*,double);
 
+int    NavierStokes2DIBAdiabatic       (void*,void*,double*,double);
+int    NavierStokes2DIBIsothermal      (void*,void*,double*,double);
+
 #if defined(HAVE_CUDA) && defined(CUDA_VAR_ORDERDING_AOS)
 int gpuNavierStokes2DInitialize               (void*,void*);
 int gpuNavierStokes2DFlux                     (double*,double*,int,void*,double);
@@ -88,6 +94,8 @@ int gpuNavierStokes2DParabolicFunction        (double*,double*,void*,void*,doubl
     HB                 | int          | #NavierStokes2D::HB                             | 1
     R                  | double       | #NavierStokes2D::R                              | 1.0
     upwinding          | char[]       | #NavierStokes2D::upw_choice                     | "roe" (#_ROE_)
+    ib_wall_type       | char[]       | #NavierStokes2D::ib_wall_type                   | "adiabatic" (#_IB_ADIABATIC_)
+    ib_T_tolerance     | double       | #NavierStokes2D::ib_T_tol                       | 5.0
 
     + If "HB" (#NavierStokes2D::HB) is specified as 3, it should be followed by the the
       Brunt-Vaisala frequency (#NavierStokes2D::N_bv), i.e.
@@ -98,6 +106,18 @@ int gpuNavierStokes2DParabolicFunction        (double*,double*,void*,void*,doubl
             ...
         end
 
+    + if "ib_wall_type" (#NavierStokes2D::ib_wall_type) is specified as "isothermal",
+      it should be followed by the wall temperature (#NavierStokes2D::T_ib_wall), i.e,
+
+        begin
+            ...
+            ib_wall_type  isothermal 1.0
+            ...
+        end
+
+      The immersed body walls are no-slip walls, and the "ib_*" keywords are relevant only
+      if an immersed body is present (#HyPar::flag_ib).
+
     \b Note: "physics.inp" is \b optional; if absent, default values will be used.
 */
 int NavierStokes2DInitialize(
@@ -135,7 +155,10 @@ int NavierStokes2DInitialize(
   physics->HB     = 1;
   physics->R      = 1.0;
   physics->N_bv   = 0.0;
+  physics->T_ib_wall = -DBL_MAX;
+  physics->ib_T_tol  = 5;
   strcpy(physics->upw_choice,"roe");
+  strcpy(physics->ib_wall_type,_IB_ADIABATIC_);
 
   /* reading physical model specific inputs - all processes */
   if (!mpi->rank) {
@@ -173,6 +196,21 @@ int NavierStokes2DInitialize(
             }
           } else if (!strcmp(word,"R")) {
             ferr = fscanf(in,"%lf",&physics->R);        if (ferr != 1) return(1);
+          } else if (!strcmp(word,"ib_wall_type")) {
+            ferr = fscanf(in,"%s",physics->ib_wall_type); if (ferr != 1) return(1);
+            if (!strcmp(physics->ib_wall_type,_IB_ISOTHERMAL_)) {
+              ferr = fscanf(in,"%lf",&physics->T_ib_wall); if (ferr != 1) return(1);
+            }
+            if (!solver->flag_ib) {
+              printf("Warning: in NavierStokes2DInitialize().\n");
+              printf("Warning: no immersed body present; specification of ib_wall_type unnecessary.\n");
+            }
+          } else if (!strcmp(word,"ib_T_tolerance")) {
+            ferr = fscanf(in,"%lf",&physics->ib_T_tol); if (ferr != 1) return(1);
+            if (!solver->flag_ib) {
+              printf("Warning: in NavierStokes2DInitialize().\n");
+              printf("Warning: no immersed body present; specification of ib_T_tolerance unnecessary.\n");
+            }
           } else if (strcmp(word,"end")) {
             char useless[_MAX_STRING_SIZE_];
             ferr = fscanf(in,"%s",useless); if (ferr != 1) return(ferr);
@@ -200,6 +238,9 @@ int NavierStokes2DInitialize(
   IERR MPIBroadcast_double    (&physics->R        ,1                ,0,&mpi->world); CHECKERR(ierr);
   IERR MPIBroadcast_double    (&physics->N_bv     ,1                ,0,&mpi->world); CHECKERR(ierr);
   IERR MPIBroadcast_integer   (&physics->HB       ,1                ,0,&mpi->world); CHECKERR(ierr);
+  IERR MPIBroadcast_character (physics->ib_wall_type,_MAX_STRING_SIZE_,0,&mpi->world); CHECKERR(ierr);
+  IERR MPIBroadcast_double    (&physics->T_ib_wall,1                ,0,&mpi->world); CHECKERR(ierr);
+  IERR MPIBroadcast_double    (&physics->ib_T_tol ,1                ,0,&mpi->world); CHECKERR(ierr);
 
   /* Scaling the Reynolds number with the M_inf */
   physics->Re /= physics->Minf;
@@ -232,6 +273,7 @@ int NavierStokes2DInitialize(
 #endif
     solver->PreStep               = NavierStokes2DPreStep;
     solver->ComputeCFL            = NavierStokes2DComputeCFL;
+    solver->ComputeLocalCFL       = NavierStokes2DComputeLocalCFL;
     solver->FFunction             = NavierStokes2DFlux;
     solver->SFunction             = NavierStokes2DSource;
     solver->UFunction             = NavierStokes2DModifiedSolution;
@@ -312,6 +354,27 @@ int NavierStokes2DInitialize(
   }
 #endif
 
+  if (solver->flag_ib) {
+    if (!strcmp(physics->ib_wall_type,_IB_ADIABATIC_)) {
+      solver->IBFunction = NavierStokes2DIBAdiabatic;
+    } else if (!strcmp(physics->ib_wall_type,_IB_ISOTHERMAL_)) {
+      if (physics->T_ib_wall <= 0) {
+        if (!mpi->rank) {
+          fprintf(stderr,"Error in NavierStokes2DInitialize(): invalid wall temperature (%lf) ",physics->T_ib_wall);
+          fprintf(stderr,"for isothermal immersed body wall.\n");
+        }
+        return(1);
+      }
+      solver->IBFunction = NavierStokes2DIBIsothermal;
+    } else {
+      if (!mpi->rank) {
+        fprintf(stderr,"Error in NavierStokes2DInitialize(): invalid value for IB wall type (%s).\n",
+                physics->ib_wall_type);
+      }
+      return(1);
+    }
+  }
+
   /* set the value of gamma in all the boundary objects */
   int n;
   DomainBoundary  *boundary = (DomainBoundary*) solver->boundary;
@@ -323,9 +386,11 @@ int NavierStokes2DInitialize(
 #if defined(HAVE_CUDA) && defined(CUDA_VAR_ORDERDING_AOS)
   if (solver->use_gpu) {
     solver->ParabolicFunction = gpuNavierStokes2DParabolicFunction;
+    solver->ParabolicFunctionAccumulate = NULL;
   } else {
 #endif
     solver->ParabolicFunction = NavierStokes2DParabolicFunction;
+    solver->ParabolicFunctionAccumulate = NavierStokes2DParabolicFunctionAccumulate;
 #if defined(HAVE_CUDA) && defined(CUDA_VAR_ORDERDING_AOS)
   }
 #endif
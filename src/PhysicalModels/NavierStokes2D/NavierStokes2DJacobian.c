@@ -23,8 +23,8 @@ int NavierStokes2DJacobian(
                    )
 {
   NavierStokes2D *param = (NavierStokes2D*) p;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_], DL[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, DL[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   /* get the eigenvalues and left,right eigenvectors */
   _NavierStokes2DEigenvalues_      (u,D,param->gamma,dir);
@@ -60,8 +60,8 @@ int NavierStokes2DStiffJacobian(
                    )
 {
   NavierStokes2D *param = (NavierStokes2D*) p;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_], DL[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, DL[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   /* get the eigenvalues and left,right eigenvectors */
   _NavierStokes2DEigenvalues_      (u,D,param->gamma,dir);
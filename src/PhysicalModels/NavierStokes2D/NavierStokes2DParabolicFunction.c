@@ -10,6 +10,8 @@
 #include <mpivars.h>
 #include <hypar.h>
 
+int NavierStokes2DParabolicFunctionAccumulate(double*,double,double*,void*,void*,double);
+
 /*!
     Compute the viscous terms in the 2D Navier Stokes equations: this function computes
     the following:
@@ -28,7 +30,8 @@
     \f}
     and the temperature is \f$T = \gamma p/\rho\f$. \f$Re\f$ and \f$Pr\f$ are the Reynolds and Prandtl numbers, respectively. Note that this function
     computes the entire parabolic term, and thus bypasses HyPar's parabolic function calculation interfaces. NavierStokes2DInitialize() assigns this
-    function to #HyPar::ParabolicFunction.
+    function to #HyPar::ParabolicFunction, and NavierStokes2DParabolicFunctionAccumulate() to
+    #HyPar::ParabolicFunctionAccumulate.
     \n\n
     Reference:
     + Tannehill, Anderson and Pletcher, Computational Fluid Mechanics and Heat Transfer,
@@ -42,6 +45,26 @@ int NavierStokes2DParabolicFunction(
                                       void    *m,   /*!< MPI object of type #MPIVariables */
                                       double  t     /*!< Current simulation time */
                                    )
+{
+  HyPar *solver = (HyPar*) s;
+  _DECLARE_IERR_;
+
+  _ArraySetValue_(par,solver->npoints_local_wghosts*solver->nvars,0.0);
+  IERR NavierStokes2DParabolicFunctionAccumulate(par,1.0,u,s,m,t); CHECKERR(ierr);
+  if (solver->flag_ib) _ArrayBlockMultiply_(par,solver->iblank,solver->npoints_local_wghosts,_MODEL_NVARS_);
+
+  return(0);
+}
+
+/*! Add a multiple of the viscous terms, computed as described in NavierStokes2DParabolicFunction(), to a given array. */
+int NavierStokes2DParabolicFunctionAccumulate(
+                                                double  *par, /*!< Array to which the scaled viscous terms are added */
+                                                double  a,    /*!< Scaling factor */
+                                                double  *u,   /*!< Solution vector array */
+                                                void    *s,   /*!< Solver object of type #HyPar */
+                                                void    *m,   /*!< MPI object of type #MPIVariables */
+                                                double  t     /*!< Current simulation time */
+                                             )
 {
   HyPar           *solver   = (HyPar*) s;
   MPIVariables    *mpi      = (MPIVariables*) m;
@@ -57,7 +80,6 @@ int NavierStokes2DParabolicFunction(
   int ndims  = solver->ndims;
   int size   = (imax+2*ghosts)*(jmax+2*ghosts)*nvars;
 
-  _ArraySetValue_(par,size,0.0);
   if (physics->Re <= 0) return(0); /* inviscid flow */
   solver->count_par++;
 
@@ -142,7 +164,7 @@ int NavierStokes2DParabolicFunction(
       double dxinv;
       _ArrayIndex1D_(ndims,dim,index,ghosts,p); p *= nvars;
       _GetCoordinate_(_XDIR_,index[_XDIR_],dim,ghosts,solver->dxinv,dxinv);
-      for (v=0; v<nvars; v++) (par+p)[v] += (dxinv * (FDeriv+p)[v] );
+      for (v=0; v<nvars; v++) (par+p)[v] += a * (dxinv * (FDeriv+p)[v] );
     }
   }
 
@@ -183,7 +205,7 @@ int NavierStokes2DParabolicFunction(
       double dyinv;
       _ArrayIndex1D_(ndims,dim,index,ghosts,p); p *= nvars;
       _GetCoordinate_(_YDIR_,index[_YDIR_],dim,ghosts,solver->dxinv,dyinv);
-      for (v=0; v<nvars; v++) (par+p)[v] += (dyinv * (FDeriv+p)[v] );
+      for (v=0; v<nvars; v++) (par+p)[v] += a * (dyinv * (FDeriv+p)[v] );
     }
   }
 
@@ -44,8 +44,8 @@ int NavierStokes2DPreStep(
   double            *A;
   static const int  ndims   = _MODEL_NDIMS_;
   static const int  JacSize = _MODEL_NVARS_*_MODEL_NVARS_;
-  static int        index[_MODEL_NDIMS_], bounds[_MODEL_NDIMS_], offset[_MODEL_NDIMS_];
-  static double     D[_MODEL_NVARS_*_MODEL_NVARS_],L[_MODEL_NVARS_*_MODEL_NVARS_],
+  int               index[_MODEL_NDIMS_], bounds[_MODEL_NDIMS_], offset[_MODEL_NDIMS_];
+  double            D[_MODEL_NVARS_*_MODEL_NVARS_],L[_MODEL_NVARS_*_MODEL_NVARS_],
                     R[_MODEL_NVARS_*_MODEL_NVARS_],DL[_MODEL_NVARS_*_MODEL_NVARS_];
 
   /* set bounds for array index to include ghost points */
@@ -9,6 +9,7 @@
 #include <physicalmodels/navierstokes2d.h>
 #include <mathfunctions.h>
 #include <matmult_native.h>
+#include <interpolation.h>
 #include <hypar.h>
 
 /*! Roe's upwinding scheme.
@@ -52,9 +53,9 @@ int NavierStokes2DUpwindRoe(
   int bounds_outer[2], bounds_inter[2];
   bounds_outer[0] = dim[0]; bounds_outer[1] = dim[1]; bounds_outer[dir] = 1;
   bounds_inter[0] = dim[0]; bounds_inter[1] = dim[1]; bounds_inter[dir]++;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_], DL[_MODEL_NVARS_*_MODEL_NVARS_],
-                modA[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, DL[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                modA[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; int index_outer[2] = {0,0}; int index_inter[2];
   while (!done) {
@@ -74,10 +75,12 @@ int NavierStokes2DUpwindRoe(
       udiff[2] = 0.5 * (uR[_MODEL_NVARS_*p+2] - uL[_MODEL_NVARS_*p+2]);
       udiff[3] = 0.5 * (uR[_MODEL_NVARS_*p+3] - uL[_MODEL_NVARS_*p+3]);
 
-      _NavierStokes2DRoeAverage_        (uavg,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
+      if (!EigenCacheGet(solver,dir,p,uavg,L,R)) {
+        _NavierStokes2DRoeAverage_        (uavg,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
+        _NavierStokes2DLeftEigenvectors_  (uavg,L,param->gamma,dir);
+        _NavierStokes2DRightEigenvectors_ (uavg,R,param->gamma,dir);
+      }
       _NavierStokes2DEigenvalues_       (uavg,D,param->gamma,dir);
-      _NavierStokes2DLeftEigenvectors_  (uavg,L,param->gamma,dir);
-      _NavierStokes2DRightEigenvectors_ (uavg,R,param->gamma,dir);
 
        /* Harten's Entropy Fix - Page 362 of Leveque */
       int k;
@@ -138,8 +141,8 @@ int NavierStokes2DUpwindRF(
   int bounds_outer[2], bounds_inter[2];
   bounds_outer[0] = dim[0]; bounds_outer[1] = dim[1]; bounds_outer[dir] = 1;
   bounds_inter[0] = dim[0]; bounds_inter[1] = dim[1]; bounds_inter[dir]++;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; int index_outer[2] = {0,0}, index_inter[2];
   while (!done) {
@@ -241,8 +244,8 @@ int NavierStokes2DUpwindLLF(
   int bounds_outer[2], bounds_inter[2];
   bounds_outer[0] = dim[0]; bounds_outer[1] = dim[1]; bounds_outer[dir] = 1;
   bounds_inter[0] = dim[0]; bounds_inter[1] = dim[1]; bounds_inter[dir]++;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; int index_outer[2] = {0,0}, index_inter[2];
   while (!done) {
@@ -259,10 +262,12 @@ int NavierStokes2DUpwindLLF(
 
       /* Local Lax-Friedrich upwinding scheme */
 
-      _NavierStokes2DRoeAverage_        (uavg,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
+      if (!EigenCacheGet(solver,dir,p,uavg,L,R)) {
+        _NavierStokes2DRoeAverage_        (uavg,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
+        _NavierStokes2DLeftEigenvectors_  (uavg,L,param->gamma,dir);
+        _NavierStokes2DRightEigenvectors_ (uavg,R,param->gamma,dir);
+      }
       _NavierStokes2DEigenvalues_       (uavg,D,param->gamma,dir);
-      _NavierStokes2DLeftEigenvectors_  (uavg,L,param->gamma,dir);
-      _NavierStokes2DRightEigenvectors_ (uavg,R,param->gamma,dir);
 
       /* calculate characteristic fluxes and variables */
       MatVecMult4(_MODEL_NVARS_,ucL,L,(uL+_MODEL_NVARS_*p));
@@ -336,7 +341,7 @@ int NavierStokes2DUpwindSWFS(
   int index_outer[ndims], index_inter[ndims], bounds_outer[ndims], bounds_inter[ndims];
   _ArrayCopy1D_(dim,bounds_outer,ndims); bounds_outer[dir] =  1;
   _ArrayCopy1D_(dim,bounds_inter,ndims); bounds_inter[dir] += 1;
-  static double fp[_MODEL_NVARS_], fm[_MODEL_NVARS_],uavg[_MODEL_NVARS_];
+  double        fp[_MODEL_NVARS_], fm[_MODEL_NVARS_],uavg[_MODEL_NVARS_];
 
   done = 0; _ArraySetValue_(index_outer,ndims,0);
   while (!done) {
@@ -463,7 +468,9 @@ int NavierStokes2DUpwindRusanov(
       udiff[2] = 0.5 * (uR[_MODEL_NVARS_*p+2] - uL[_MODEL_NVARS_*p+2]);
       udiff[3] = 0.5 * (uR[_MODEL_NVARS_*p+3] - uL[_MODEL_NVARS_*p+3]);
 
-      _NavierStokes2DRoeAverage_ (uavg,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
+      if (!EigenCacheGet(solver,dir,p,uavg,NULL,NULL)) {
+        _NavierStokes2DRoeAverage_ (uavg,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
+      }
 
       double c, vel[_MODEL_NDIMS_], rho,E,P;
       _NavierStokes2DGetFlowVar_((u+_MODEL_NVARS_*pL),rho,vel[0],vel[1],E,P,param->gamma);
@@ -517,9 +524,9 @@ int NavierStokes2DUpwindRusanovModified(
   int bounds_outer[2], bounds_inter[2];
   bounds_outer[0] = dim[0]; bounds_outer[1] = dim[1]; bounds_outer[dir] = 1;
   bounds_inter[0] = dim[0]; bounds_inter[1] = dim[1]; bounds_inter[dir]++;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_], DL[_MODEL_NVARS_*_MODEL_NVARS_],
-                modA[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, DL[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                modA[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; int index_outer[2] = {0,0}; int index_inter[2];
   while (!done) {
@@ -539,9 +546,11 @@ int NavierStokes2DUpwindRusanovModified(
       udiff[2] = 0.5 * (uR[_MODEL_NVARS_*p+2] - uL[_MODEL_NVARS_*p+2]);
       udiff[3] = 0.5 * (uR[_MODEL_NVARS_*p+3] - uL[_MODEL_NVARS_*p+3]);
 
-      _NavierStokes2DRoeAverage_        (uavg,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
-      _NavierStokes2DLeftEigenvectors_  (uavg,L,param->gamma,dir);
-      _NavierStokes2DRightEigenvectors_ (uavg,R,param->gamma,dir);
+      if (!EigenCacheGet(solver,dir,p,uavg,L,R)) {
+        _NavierStokes2DRoeAverage_        (uavg,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
+        _NavierStokes2DLeftEigenvectors_  (uavg,L,param->gamma,dir);
+        _NavierStokes2DRightEigenvectors_ (uavg,R,param->gamma,dir);
+      }
 
       double c, vel[_MODEL_NDIMS_], rho,E,P;
       _NavierStokes2DGetFlowVar_((u+_MODEL_NVARS_*pL),rho,vel[0],vel[1],E,P,param->gamma);
@@ -608,9 +617,9 @@ int NavierStokes2DUpwinddFRoe(
   int bounds_outer[2], bounds_inter[2];
   bounds_outer[0] = dim[0]; bounds_outer[1] = dim[1]; bounds_outer[dir] = 1;
   bounds_inter[0] = dim[0]; bounds_inter[1] = dim[1]; bounds_inter[dir]++;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_], DL[_MODEL_NVARS_*_MODEL_NVARS_],
-                modA[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, DL[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                modA[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; int index_outer[2] = {0,0}; int index_inter[2];
   while (!done) {
@@ -689,8 +698,8 @@ int NavierStokes2DUpwinddFRF(
   int bounds_outer[2], bounds_inter[2];
   bounds_outer[0] = dim[0]; bounds_outer[1] = dim[1]; bounds_outer[dir] = 1;
   bounds_inter[0] = dim[0]; bounds_inter[1] = dim[1]; bounds_inter[dir]++;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; int index_outer[2] = {0,0}, index_inter[2];
   while (!done) {
@@ -783,8 +792,8 @@ int NavierStokes2DUpwinddFLLF(
   int bounds_outer[2], bounds_inter[2];
   bounds_outer[0] = dim[0]; bounds_outer[1] = dim[1]; bounds_outer[dir] = 1;
   bounds_inter[0] = dim[0]; bounds_inter[1] = dim[1]; bounds_inter[dir]++;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; int index_outer[2] = {0,0}, index_inter[2];
   while (!done) {
@@ -878,9 +887,9 @@ int NavierStokes2DUpwinddFRusanovModified(
   int bounds_outer[2], bounds_inter[2];
   bounds_outer[0] = dim[0]; bounds_outer[1] = dim[1]; bounds_outer[dir] = 1;
   bounds_inter[0] = dim[0]; bounds_inter[1] = dim[1]; bounds_inter[dir]++;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_], DL[_MODEL_NVARS_*_MODEL_NVARS_],
-                modA[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, DL[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                modA[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; int index_outer[2] = {0,0}; int index_inter[2];
   while (!done) {
@@ -969,9 +978,9 @@ int NavierStokes2DUpwindFdFRoe(
   int bounds_outer[2], bounds_inter[2];
   bounds_outer[0] = dim[0]; bounds_outer[1] = dim[1]; bounds_outer[dir] = 1;
   bounds_inter[0] = dim[0]; bounds_inter[1] = dim[1]; bounds_inter[dir]++;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_], DL[_MODEL_NVARS_*_MODEL_NVARS_],
-                modA[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, DL[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                modA[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; int index_outer[2] = {0,0}; int index_inter[2];
   while (!done) {
@@ -996,10 +1005,12 @@ int NavierStokes2DUpwindFdFRoe(
       udiff[3] = 0.5 * (uR[_MODEL_NVARS_*p+3] - uL[_MODEL_NVARS_*p+3]);
 
       /* Compute total dissipation */
-      _NavierStokes2DRoeAverage_        (uavg,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
+      if (!EigenCacheGet(solver,dir,p,uavg,L,R)) {
+        _NavierStokes2DRoeAverage_        (uavg,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
+        _NavierStokes2DLeftEigenvectors_  (uavg,L,param->gamma,dir);
+        _NavierStokes2DRightEigenvectors_ (uavg,R,param->gamma,dir);
+      }
       _NavierStokes2DEigenvalues_       (uavg,D,param->gamma,dir);
-      _NavierStokes2DLeftEigenvectors_  (uavg,L,param->gamma,dir);
-      _NavierStokes2DRightEigenvectors_ (uavg,R,param->gamma,dir);
       k=0;  D[k] = kappa * (absolute(D[k]) < delta ? (D[k]*D[k]+delta2)/(2*delta) : absolute(D[k]) );
       k=5;  D[k] = kappa * (absolute(D[k]) < delta ? (D[k]*D[k]+delta2)/(2*delta) : absolute(D[k]) );
       k=10; D[k] = kappa * (absolute(D[k]) < delta ? (D[k]*D[k]+delta2)/(2*delta) : absolute(D[k]) );
@@ -1065,8 +1076,8 @@ int NavierStokes2DUpwindFdFRF(
   int bounds_outer[2], bounds_inter[2];
   bounds_outer[0] = dim[0]; bounds_outer[1] = dim[1]; bounds_outer[dir] = 1;
   bounds_inter[0] = dim[0]; bounds_inter[1] = dim[1]; bounds_inter[dir]++;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; int index_outer[2] = {0,0}, index_inter[2];
   while (!done) {
@@ -1159,8 +1170,8 @@ int NavierStokes2DUpwindFdFLLF(
   int bounds_outer[2], bounds_inter[2];
   bounds_outer[0] = dim[0]; bounds_outer[1] = dim[1]; bounds_outer[dir] = 1;
   bounds_inter[0] = dim[0]; bounds_inter[1] = dim[1]; bounds_inter[dir]++;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; int index_outer[2] = {0,0}, index_inter[2];
   while (!done) {
@@ -1254,9 +1265,9 @@ int NavierStokes2DUpwindFdFRusanovModified(
   int bounds_outer[2], bounds_inter[2];
   bounds_outer[0] = dim[0]; bounds_outer[1] = dim[1]; bounds_outer[dir] = 1;
   bounds_inter[0] = dim[0]; bounds_inter[1] = dim[1]; bounds_inter[dir]++;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_], DL[_MODEL_NVARS_*_MODEL_NVARS_],
-                modA[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, DL[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                modA[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; int index_outer[2] = {0,0}; int index_inter[2];
   while (!done) {
@@ -1282,9 +1293,11 @@ int NavierStokes2DUpwindFdFRusanovModified(
       udiff[3] = 0.5 * (uR[_MODEL_NVARS_*p+3] - uL[_MODEL_NVARS_*p+3]);
 
       /* Compute total dissipation */
-      _NavierStokes2DRoeAverage_        (uavg,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
-      _NavierStokes2DLeftEigenvectors_  (uavg,L,param->gamma,dir);
-      _NavierStokes2DRightEigenvectors_ (uavg,R,param->gamma,dir);
+      if (!EigenCacheGet(solver,dir,p,uavg,L,R)) {
+        _NavierStokes2DRoeAverage_        (uavg,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
+        _NavierStokes2DLeftEigenvectors_  (uavg,L,param->gamma,dir);
+        _NavierStokes2DRightEigenvectors_ (uavg,R,param->gamma,dir);
+      }
       _NavierStokes2DGetFlowVar_((u+_MODEL_NVARS_*pL),rho,vel[0],vel[1],E,P,param->gamma);
       c = sqrt(param->gamma*P/rho);
       alphaL = c + absolute(vel[dir]);
@@ -16,5 +16,6 @@ int NavierStokes3DCleanup(void *s /*!< Object of type #NavierStokes3D*/)
   free(param->grav_field_g);
   free(param->fast_jac);
   free(param->solution);
+  if (param->ib_forces_file) fclose(param->ib_forces_file);
   return(0);
 }
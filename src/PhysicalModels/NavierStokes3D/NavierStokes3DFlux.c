@@ -80,7 +80,7 @@ int NavierStokes3DStiffFlux(
   int               *dim    = solver->dim_local;
   int               ghosts  = solver->ghosts;
   static const int  JacSize = _MODEL_NVARS_*_MODEL_NVARS_;
-  static int        index[_MODEL_NDIMS_], bounds[_MODEL_NDIMS_], offset[_MODEL_NDIMS_];
+  int               index[_MODEL_NDIMS_], bounds[_MODEL_NDIMS_], offset[_MODEL_NDIMS_];
 
   /* set bounds for array index to include ghost points */
   _ArrayAddCopy1D_(dim,(2*ghosts),bounds,_MODEL_NDIMS_);
@@ -121,8 +121,8 @@ int NavierStokes3DNonStiffFlux(
   int               *dim    = solver->dim_local;
   int               ghosts  = solver->ghosts;
   static const int  JacSize = _MODEL_NVARS_*_MODEL_NVARS_;
-  static int        index[_MODEL_NDIMS_], bounds[_MODEL_NDIMS_], offset[_MODEL_NDIMS_];
-  static double     ftot[_MODEL_NVARS_], fstiff[_MODEL_NVARS_];
+  int               index[_MODEL_NDIMS_], bounds[_MODEL_NDIMS_], offset[_MODEL_NDIMS_];
+  double            ftot[_MODEL_NVARS_], fstiff[_MODEL_NVARS_];
 
   /* set bounds for array index to include ghost points */
   _ArrayAddCopy1D_(dim,(2*ghosts),bounds,_MODEL_NDIMS_);
@@ -55,7 +55,7 @@ static int ComputeShear(void *s,              /*!< Solver object of type #HyPar
 
   int           nfacets_local = IB->nfacets_local;
   FacetMap      *fmap = IB->fmap;
-  static double v[_MODEL_NVARS_];
+  double        v[_MODEL_NVARS_];
 
   int nv = 4;
 
@@ -134,7 +134,42 @@ static int ComputeShear(void *s,              /*!< Solver object of type #HyPar
   return 0;
 }
 
-/*! Write the surface data on the immersed body to a ASCII Tecplot file. */
+/*! Number of values on each line of the surface data file */
+#define _IB_SURFACE_NVALS_ 11
+/*! Width of a value on a line of the surface data file */
+#define _IB_SURFACE_WIDTH_ 16
+/*! Length of a line (a facet vertex) of the surface data file */
+#define _IB_SURFACE_LINE_ (_IB_SURFACE_NVALS_*(_IB_SURFACE_WIDTH_+1))
+/*! Length of a line (a facet) of the connectivity in the surface data file */
+#define _IB_SURFACE_CONN_ 33
+
+/*! Write a line of the surface data file: the coordinates of a facet vertex and the surface
+    data of the facet, each value written with the fixed width #_IB_SURFACE_WIDTH_, so that
+    the line has the fixed length #_IB_SURFACE_LINE_. \a buffer must have one more character
+    for the terminating null character. */
+static void SurfaceDataLine(char          *buffer,  /*!< Buffer to write the line to */
+                            double        x,        /*!< x-coordinate of the vertex */
+                            double        y,        /*!< y-coordinate of the vertex */
+                            double        z,        /*!< z-coordinate of the vertex */
+                            const double  *data     /*!< Surface data of the facet (#_IB_SURFACE_NVALS_-3 values) */
+                           )
+{
+  double v[_IB_SURFACE_NVALS_];
+  int k;
+  v[0] = x; v[1] = y; v[2] = z;
+  for (k = 3; k < _IB_SURFACE_NVALS_; k++) v[k] = data[k-3];
+  for (k = 0; k < _IB_SURFACE_NVALS_; k++) {
+    sprintf(buffer+k*(_IB_SURFACE_WIDTH_+1),"%+16.8E%c",v[k],(k == _IB_SURFACE_NVALS_-1 ? '\n' : ' '));
+  }
+}
+
+/*! Write the surface data on the immersed body to a ASCII Tecplot file.
+
+    The file is written in parallel: the header, the lines of each facet (one per vertex),
+    and the connectivity have fixed lengths, so that every rank computes the location in the
+    file of the lines of the local facets it owns (see IBCreateFacetMapping()) and writes them
+    there, with one collective MPI-IO write. Rank 0 writes the header and the connectivity.
+*/
 static int WriteSurfaceData(  void*               m,              /*!< MPI object of type #MPIVariables */
                               void*               ib,             /*!< Immersed body object of type #ImmersedBoundary */
                               const double* const p_surface,      /*!< array with local surface pressure data */
@@ -147,116 +182,268 @@ static int WriteSurfaceData(  void*               m,              /*!< MPI objec
 {
   MPIVariables *mpi = (MPIVariables*) m;
   ImmersedBoundary *IB  = (ImmersedBoundary*) ib;
-  int ierr;
 
-#ifndef serial
-  MPI_Status status;
-#endif
+  int nfacets_global = IB->body->nfacets;
+  int nfacets_local = IB->nfacets_local;
+  const Facet3D* const facets = IB->body->surface;
+  FacetMap *fmap = IB->fmap;
+  int n;
+
+  /* every facet must be written by some rank */
+  for (n = 0; n < nfacets_global; n++) {
+    if (IB->facet_owner[n] < 0) {
+      if (!mpi->rank) {
+        fprintf(stderr, "Error in WriteSurfaceData()\n");
+        fprintf(stderr, "  Facet %d does not lie in the computational domain.\n", n);
+      }
+      return 1;
+    }
+  }
 
-  /* collect the surface data into global arrays */
-  double* p_surface_g = NULL;
-  ierr = IBAssembleGlobalFacetData(mpi, IB, p_surface, &p_surface_g, 1);
-  if (ierr) {
-    fprintf(stderr,"IBAssembleGlobalFacetData() returned with an error.\n");
-    return 1;
+  /* header (identical on all ranks) */
+  char header[4*_MAX_STRING_SIZE_];
+  sprintf(header, "TITLE = \"Surface data created by HyPar.\"\n"
+                  "VARIABLES = \"X\", \"Y\", \"Z\", "
+                  "\"Surface_Pressure\", "
+                  "\"Surface_Temperature\", "
+                  "\"Normal_Grad_Surface_Pressure\", "
+                  "\"Normal_Grad_Surface_Temperature\", "
+                  "\"Shear_x\", "
+                  "\"Shear_y\", "
+                  "\"Shear_z\", "
+                  "\"Shear_magn\"\n"
+                  "ZONE N = %d, E = %d, DATAPACKING = POINT, ZONETYPE = FETRIANGLE\n",
+                  3*nfacets_global, nfacets_global );
+  long header_size  = (long) strlen(header);
+  long facet_size   = 3 * _IB_SURFACE_LINE_;
+  long conn_offset  = header_size + nfacets_global*facet_size;
+  long file_size    = conn_offset + nfacets_global*_IB_SURFACE_CONN_;
+
+  /* blocks of the file written by this rank: the header and the connectivity on rank 0,
+     and the owned local facets */
+  int nowned = 0;
+  for (n = 0; n < nfacets_local; n++) {
+    if (IB->facet_owner[fmap[n].index] == mpi->rank) nowned++;
   }
-  double* T_surface_g = NULL;
-  ierr = IBAssembleGlobalFacetData(mpi, IB, T_surface, &T_surface_g, 1);
-  if (ierr) {
-    fprintf(stderr,"IBAssembleGlobalFacetData() returned with an error.\n");
-    return 1;
+  int  nblocks = nowned + (mpi->rank ? 0 : 2);
+  long *offsets = (long*) calloc (max(nblocks,1), sizeof(long));
+  int  *sizes   = (int*)  calloc (max(nblocks,1), sizeof(int));
+  long nbytes   = nowned*facet_size + (mpi->rank ? 0 : header_size + nfacets_global*_IB_SURFACE_CONN_);
+  char *buffer  = (char*) calloc (nbytes+1, sizeof(char));
+
+  int  b = 0;
+  long pos = 0;
+  if (!mpi->rank) {
+    offsets[b] = 0;
+    sizes[b] = (int) header_size;
+    strcpy(buffer, header);
+    pos += header_size;
+    b++;
   }
-  double* ngrad_p_surface_g = NULL;
-  ierr = IBAssembleGlobalFacetData(mpi, IB, ngrad_p_surface, &ngrad_p_surface_g, 1);
-  if (ierr) {
-    fprintf(stderr,"IBAssembleGlobalFacetData() returned with an error.\n");
+  for (n = 0; n < nfacets_local; n++) {
+    int nf = fmap[n].index;
+    if (IB->facet_owner[nf] != mpi->rank) continue;
+    double data[_IB_SURFACE_NVALS_-3];
+    data[0] = p_surface[n];
+    data[1] = T_surface[n];
+    data[2] = ngrad_p_surface[n];
+    data[3] = ngrad_T_surface[n];
+    data[4] = shear[4*n+_XDIR_];
+    data[5] = shear[4*n+_YDIR_];
+    data[6] = shear[4*n+_ZDIR_];
+    data[7] = shear[4*n+_ZDIR_+1];
+    SurfaceDataLine(buffer+pos                    , facets[nf].x1, facets[nf].y1, facets[nf].z1, data);
+    SurfaceDataLine(buffer+pos+  _IB_SURFACE_LINE_, facets[nf].x2, facets[nf].y2, facets[nf].z2, data);
+    SurfaceDataLine(buffer+pos+2*_IB_SURFACE_LINE_, facets[nf].x3, facets[nf].y3, facets[nf].z3, data);
+    offsets[b] = header_size + nf*facet_size;
+    sizes[b] = (int) facet_size;
+    pos += facet_size;
+    b++;
+  }
+  if (!mpi->rank) {
+    offsets[b] = conn_offset;
+    sizes[b] = nfacets_global*_IB_SURFACE_CONN_;
+    for (n = 0; n < nfacets_global; n++) {
+      sprintf(buffer+pos,"%10d %10d %10d\n",3*n+1,3*n+2,3*n+3);
+      pos += _IB_SURFACE_CONN_;
+    }
+    b++;
+  }
+
+#ifdef serial
+
+  FILE *out = fopen(filename,"w");
+  if (!out) {
+    fprintf(stderr,"Error in WriteSurfaceData(): Unable to open %s for writing.\n",filename);
     return 1;
   }
-  double* ngrad_T_surface_g = NULL;
-  ierr = IBAssembleGlobalFacetData(mpi, IB, ngrad_T_surface, &ngrad_T_surface_g, 1);
-  if (ierr) {
-    fprintf(stderr,"IBAssembleGlobalFacetData() returned with an error.\n");
+  for (b = 0, pos = 0; b < nblocks; b++) {
+    fseek(out,offsets[b],SEEK_SET);
+    fwrite(buffer+pos,sizeof(char),sizes[b],out);
+    pos += sizes[b];
+  }
+  fclose(out);
+
+#else
+
+  /* the blocks are in increasing order of their offsets, as required for a file view */
+  MPI_Datatype filetype = MPI_CHAR;
+  if (nblocks > 0) {
+    MPI_Aint *displs = (MPI_Aint*) calloc (nblocks, sizeof(MPI_Aint));
+    for (b = 0; b < nblocks; b++) displs[b] = (MPI_Aint) offsets[b];
+    MPI_Type_create_hindexed(nblocks,sizes,displs,MPI_CHAR,&filetype);
+    MPI_Type_commit(&filetype);
+    free(displs);
+  }
+
+  MPI_File    out;
+  MPI_Status  status;
+  int         error;
+  error = MPI_File_open(mpi->world,filename,MPI_MODE_CREATE|MPI_MODE_WRONLY,MPI_INFO_NULL,&out);
+  if (error != MPI_SUCCESS) {
+    if (!mpi->rank) fprintf(stderr,"Error in WriteSurfaceData(): Unable to open %s for writing.\n",filename);
+    if (nblocks > 0) MPI_Type_free(&filetype);
+    free(offsets); free(sizes); free(buffer);
     return 1;
   }
-  double* shear_g = NULL;
-  ierr = IBAssembleGlobalFacetData(mpi, IB, shear, &shear_g, 4);
+  MPI_File_set_size(out,(MPI_Offset)file_size);
+  MPI_File_set_view(out,0,MPI_CHAR,filetype,"native",MPI_INFO_NULL);
+  MPI_File_write_all(out,buffer,(int)nbytes,MPI_CHAR,&status);
+  MPI_File_close(&out);
+  if (nblocks > 0) MPI_Type_free(&filetype);
+
+#endif
+
+  free(offsets);
+  free(sizes);
+  free(buffer);
+
+  return 0;
+}
+
+/*! Write the force and moment coefficients on the immersed body, once they are reduced over
+    all the ranks, to the file #NavierStokes3D::ib_forces_file (rank 0 only).
+    \sa NavierStokes3DIBForcesPostStep() */
+static int WriteForces( double  *f,   /*!< Simulation time and the reduced coefficients */
+                        int     n,    /*!< Number of values */
+                        void    *ctxt /*!< Object of type #NavierStokes3D */
+                      )
+{
+  NavierStokes3D *physics = (NavierStokes3D*) ctxt;
+  _ArrayCopy1D_(f,physics->ib_forces,n);
+  if (physics->ib_forces_file) {
+    int k;
+    for (k = 0; k < n; k++) fprintf(physics->ib_forces_file,"%1.16E ",f[k]);
+    fprintf(physics->ib_forces_file,"\n");
+    fflush(physics->ib_forces_file);
+  }
+  return(0);
+}
+
+/*! Compute the force and moment coefficients on the immersed body, every
+    #NavierStokes3D::ib_forces_freq time steps, and write them to file (see
+    NavierStokes3DInitialize()). The force on the body is
+    \f{equation}{
+      {\bf F} = \int_S \left( -p\hat{\bf n} + \tau\cdot\hat{\bf n} \right) dA,
+    \f}
+    and the moment about the point \f${\bf x}_{\rm ref}\f$ (#NavierStokes3D::ib_moment_center) is
+    \f{equation}{
+      {\bf M} = \int_S \left({\bf x}-{\bf x}_{\rm ref}\right) \times \left( -p\hat{\bf n} + \tau\cdot\hat{\bf n} \right) dA,
+    \f}
+    where \f$\hat{\bf n}\f$ is the outward normal of the body surface \f$S\f$. The integrals are
+    computed as sums over the facets, with the pressure and shear at the facet centroid. Each
+    rank sums over the local facets it owns (see IBCreateFacetMapping()), and the sums are reduced
+    over all the ranks with the other diagnostics of this time step (see MPIDiagnosticsPost()).
+    The coefficients are the force divided by \f$\frac{1}{2}M_\infty^2 A_{\rm ref}\f$, and the
+    moment divided by \f$\frac{1}{2}M_\infty^2 A_{\rm ref} L_{\rm ref}\f$ (the density and the
+    speed of sound of the freestream are 1).
+
+    This function is called after every time step (#HyPar::PostStep).
+*/
+int NavierStokes3DIBForcesPostStep( double  *u,   /*!< Solution */
+                                    void    *s,   /*!< Solver object of type #HyPar */
+                                    void    *m,   /*!< MPI object of type #MPIVariables */
+                                    double  t,    /*!< Current simulation time */
+                                    int     iter  /*!< Current time step */
+                                  )
+{
+  HyPar             *solver  = (HyPar*)          s;
+  MPIVariables      *mpi     = (MPIVariables*)   m;
+  NavierStokes3D    *physics = (NavierStokes3D*) solver->physics;
+  ImmersedBoundary  *IB      = (ImmersedBoundary*) solver->ib;
+  int ierr;
+
+  if (!solver->flag_ib) return(0);
+  if ((iter+1)%physics->ib_forces_freq) return(0);
+
+  double *shear = NULL;
+  ierr = ComputeShear(solver, mpi, u, &shear);
   if (ierr) {
-    fprintf(stderr,"IBAssembleGlobalFacetData() returned with an error.\n");
+    fprintf(stderr,"Error in NavierStokes3DIBForcesPostStep()\n");
+    fprintf(stderr,"  ComputeShear() returned with error.\n");
     return 1;
   }
 
-  /* Rank 0 writes the file */
-  if (!mpi->rank) {
+  int       nfacets_local = IB->nfacets_local;
+  FacetMap  *fmap = IB->fmap;
+  double    *xref = physics->ib_moment_center;
+  double    local[7], v[_MODEL_NVARS_];
+  int       n, j, k;
+
+  /* the simulation time is carried through the reduction by rank 0 */
+  _ArraySetValue_(local,7,0.0);
+  local[0] = (mpi->rank ? 0.0 : t);
 
-    int nfacets_global = IB->body->nfacets;
-    const Facet3D* const facets = IB->body->surface;
-
-    FILE *out;
-    out = fopen(filename,"w");
-    fprintf(out,"TITLE = \"Surface data created by HyPar.\"\n");
-    fprintf(out,"VARIABLES = \"X\", \"Y\", \"Z\", ");
-    fprintf(out,"\"Surface_Pressure\", ");
-    fprintf(out,"\"Surface_Temperature\", ");
-    fprintf(out,"\"Normal_Grad_Surface_Pressure\", ");
-    fprintf(out,"\"Normal_Grad_Surface_Temperature\", ");
-    fprintf(out,"\"Shear_x\", ");
-    fprintf(out,"\"Shear_y\", ");
-    fprintf(out,"\"Shear_z\", ");
-    fprintf(out,"\"Shear_magn\"");
-    fprintf(out,"\n");
-    fprintf(out,"ZONE N = %d, E = %d, DATAPACKING = POINT, ZONETYPE = FETRIANGLE\n",3*nfacets_global,nfacets_global);
-
-    for (int n = 0; n < nfacets_global; n++) {
-      fprintf(  out, "%lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf\n",
-                facets[n].x1,
-                facets[n].y1,
-                facets[n].z1,
-                p_surface_g[n],
-                T_surface_g[n],
-                ngrad_p_surface_g[n],
-                ngrad_T_surface_g[n],
-                shear_g[4*n+_XDIR_],
-                shear_g[4*n+_YDIR_],
-                shear_g[4*n+_ZDIR_],
-                shear_g[4*n+_ZDIR_+1] );
-      fprintf(  out, "%lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf\n",
-                facets[n].x2,
-                facets[n].y2,
-                facets[n].z2,
-                p_surface_g[n],
-                T_surface_g[n],
-                ngrad_p_surface_g[n],
-                ngrad_T_surface_g[n],
-                shear_g[4*n+_XDIR_],
-                shear_g[4*n+_YDIR_],
-                shear_g[4*n+_ZDIR_],
-                shear_g[4*n+_ZDIR_+1] );
-      fprintf(  out, "%lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf\n",
-                facets[n].x3,
-                facets[n].y3,
-                facets[n].z3,
-                p_surface_g[n],
-                T_surface_g[n],
-                ngrad_p_surface_g[n],
-                ngrad_T_surface_g[n],
-                shear_g[4*n+_XDIR_],
-                shear_g[4*n+_YDIR_],
-                shear_g[4*n+_ZDIR_],
-                shear_g[4*n+_ZDIR_+1] );
+  for (n = 0; n < nfacets_local; n++) {
+
+    if (IB->facet_owner[fmap[n].index] != mpi->rank) continue;
+    const Facet3D *facet = fmap[n].facet;
+
+    double *alpha = &(fmap[n].interp_coeffs[0]);
+    int    *nodes = &(fmap[n].interp_nodes[0]);
+    _ArraySetValue_(v,_MODEL_NVARS_,0.0);
+    for (j=0; j<_IB_NNODES_; j++) {
+      for (k=0; k<_MODEL_NVARS_; k++) {
+        v[k] += ( alpha[j] * u[_MODEL_NVARS_*nodes[j]+k] );
+      }
     }
-    for (int n = 0; n < nfacets_global; n++) fprintf(out,"%d %d %d\n",3*n+1,3*n+2,3*n+3);
-    fclose(out);
+    double rho, uvel, vvel, wvel, energy, pressure;
+    _NavierStokes3DGetFlowVar_(v,_NavierStokes3D_stride_,rho,uvel,vvel,wvel,energy,pressure,physics->gamma);
+
+    /* facet area */
+    double ax = facet->x2 - facet->x1, ay = facet->y2 - facet->y1, az = facet->z2 - facet->z1;
+    double bx = facet->x3 - facet->x1, by = facet->y3 - facet->y1, bz = facet->z3 - facet->z1;
+    double cx = ay*bz - az*by, cy = az*bx - ax*bz, cz = ax*by - ay*bx;
+    double area = 0.5 * sqrt(cx*cx + cy*cy + cz*cz);
+
+    double fx = (-pressure*facet->nx + shear[4*n+_XDIR_]) * area;
+    double fy = (-pressure*facet->ny + shear[4*n+_YDIR_]) * area;
+    double fz = (-pressure*facet->nz + shear[4*n+_ZDIR_]) * area;
+
+    double rx = fmap[n].xc - xref[_XDIR_];
+    double ry = fmap[n].yc - xref[_YDIR_];
+    double rz = fmap[n].zc - xref[_ZDIR_];
+
+    local[1] += fx;
+    local[2] += fy;
+    local[3] += fz;
+    local[4] += (ry*fz - rz*fy);
+    local[5] += (rz*fx - rx*fz);
+    local[6] += (rx*fy - ry*fx);
   }
+  if (shear) free(shear);
 
-  if (p_surface_g) free(p_surface_g);
-  if (T_surface_g) free(T_surface_g);
-  if (ngrad_p_surface_g) free(ngrad_p_surface_g);
-  if (ngrad_T_surface_g) free(ngrad_T_surface_g);
-  if (shear_g) free(shear_g);
+  double q_inf = 0.5 * physics->Minf * physics->Minf;
+  double f_ref = q_inf * physics->ib_ref_area;
+  double m_ref = f_ref * physics->ib_ref_length;
+  for (k = 1; k <= 3; k++) local[k] /= f_ref;
+  for (k = 4; k <= 6; k++) local[k] /= m_ref;
 
-  return 0;
-}
+  ierr = MPIDiagnosticsPost(NULL,local,7,_MPI_DIAG_SUM_,&mpi->world,WriteForces,physics);
+  if (ierr) return(ierr);
 
+  return(0);
+}
 
 /*! Calculate the aerodynamic forces on the immersed body surface and write them
     to file
@@ -27,7 +27,7 @@ int NavierStokes3DIBAdiabatic(void    *s, /*!< Solver object of type #HyPar */
   ImmersedBoundary  *IB       = (ImmersedBoundary*) solver->ib;
   IBNode            *boundary = IB->boundary;
   NavierStokes3D    *param    = (NavierStokes3D*) solver->physics;
-  static double     v[_MODEL_NVARS_];
+  double            v[_MODEL_NVARS_];
   int               n, j, k, nb = IB->n_boundary_nodes;
 
   if (!solver->flag_ib) return(0);
@@ -127,7 +127,7 @@ int NavierStokes3DIBIsothermal( void    *s, /*!< Solver object of type #HyPar */
   ImmersedBoundary  *IB       = (ImmersedBoundary*) solver->ib;
   IBNode            *boundary = IB->boundary;
   NavierStokes3D    *param    = (NavierStokes3D*) solver->physics;
-  static double     v[_MODEL_NVARS_];
+  double            v[_MODEL_NVARS_];
   int               n, j, k, nb = IB->n_boundary_nodes;
 
   if (!solver->flag_ib) return(0);
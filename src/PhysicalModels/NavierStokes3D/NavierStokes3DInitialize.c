@@ -3,10 +3,12 @@
     @brief Initialization of the physics-related variables and function pointers for the 3D Navier-Stokes system
 */
 #include <float.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <basic.h>
+#include <common.h>
 #include <arrayfunctions.h>
 #include <boundaryconditions.h>
 #include <physicalmodels/navierstokes3d.h>
@@ -14,12 +16,14 @@
 #include <hypar.h>
 
 double NavierStokes3DComputeCFL        (void*,void*,double,double);
+double NavierStokes3DComputeLocalCFL   (void*,void*,double,double,double*);
 
 int NavierStokes3DFlux              (double*,double*,int,void*,double);
 int NavierStokes3DStiffFlux         (double*,double*,int,void*,double);
 int NavierStokes3DNonStiffFlux      (double*,double*,int,void*,double);
 int NavierStokes3DRoeAverage        (double*,double*,double*,void*);
 int NavierStokes3DParabolicFunction (double*,double*,void*,void*,double);
+int NavierStokes3DParabolicFunctionAccumulate (double*,double,double*,void*,void*,double);
 int NavierStokes3DSource            (double*,double*,void*,void*,double);
 
 int NavierStokes3DJacobian          (double*,double*,void*,int,int,int);
@@ -48,6 +52,7 @@ int NavierStokes3DIBIsothermal (void*,void*,double*,double);
 
 int NavierStokes3DPreStep           (double*,void*,void*,double);
 int NavierStokes3DIBForces          (void*,void*,double);
+int NavierStokes3DIBForcesPostStep  (double*,void*,void*,double,int);
 
 #if defined(HAVE_CUDA)
 int gpuNavierStokes3DInitialize          (void*,void*);
@@ -92,6 +97,11 @@ int gpuNavierStokes3DPreStep             (double*,void*,void*,double);
     ib_ramp_time       | double               | #NavierStokes3D::t_ib_ramp                                              | -1
     ib_ramp_width      | double               | #NavierStokes3D::t_ib_width                                             | 0.05
     ib_ramp_type       | char[]               | #NavierStokes3D::ib_ramp_type                                           | "linear" (#_IB_RAMP_LINEAR_)
+    ib_surface_data    | char[]               | #NavierStokes3D::ib_write_surface_data                                  | "yes"
+    ib_forces_freq     | int                  | #NavierStokes3D::ib_forces_freq                                         | 0
+    ib_ref_area        | double               | #NavierStokes3D::ib_ref_area                                            | 1.0
+    ib_ref_length      | double               | #NavierStokes3D::ib_ref_length                                          | 1.0
+    ib_moment_center   | double,double,double | #NavierStokes3D::ib_moment_center                                       | 0.0,0.0,0.0
 
     + if "ib_wall_type" (#NavierStokes3D::ib_wall_type) is specified as "isothermal",
       it should be followed by the wall temperature (##NavierStokes3D::T_ib_wall), i.e,
@@ -111,6 +121,13 @@ int gpuNavierStokes3DPreStep             (double*,void*,void*,double);
             ...
         end
 
+    + If "ib_forces_freq" (#NavierStokes3D::ib_forces_freq) is positive, the force and moment
+      coefficients on the immersed body are computed every "ib_forces_freq" time steps (see
+      NavierStokes3DIBForcesPostStep()) and written to "ib_forces.dat" ("ib_forces_<n>.dat"
+      for the n-th domain of a multi-domain simulation). They are nondimensionalized by the
+      freestream dynamic pressure \f$\frac{1}{2}M_\infty^2\f$, the reference area
+      "ib_ref_area", and, for the moments, the reference length "ib_ref_length".
+
     \b Note: "physics.inp" is \b optional; if absent, default values will be used.
 */
 int NavierStokes3DInitialize( void *s, /*!< Solver object of type #HyPar */
@@ -152,6 +169,12 @@ int NavierStokes3DInitialize( void *s, /*!< Solver object of type #HyPar */
   physics->t_ib_ramp = -1.0;
   physics->t_ib_width= 0.05;
   physics->ib_T_tol  = 5;
+  physics->ib_forces_freq = 0;
+  physics->ib_ref_area    = 1.0;
+  physics->ib_ref_length  = 1.0;
+  _ArraySetValue_(physics->ib_moment_center,_MODEL_NDIMS_,0.0);
+  _ArraySetValue_(physics->ib_forces,7,0.0);
+  physics->ib_forces_file = NULL;
   strcpy(physics->upw_choice,"roe");
   strcpy(physics->ib_write_surface_data,"yes");
   strcpy(physics->ib_wall_type,"adiabatic");
@@ -317,6 +340,37 @@ int NavierStokes3DInitialize( void *s, /*!< Solver object of type #HyPar */
               printf("Warning: in NavierStokes3DInitialize().\n");
               printf("Warning: no immersed body present; specification of ib_T_tolerance unnecessary.\n");
             }
+          } else if (!strcmp(word,"ib_forces_freq")) {
+            ferr = fscanf(in,"%d",&physics->ib_forces_freq);
+            if (ferr != 1) {
+              fprintf(stderr, "Read error while reading physics.inp in NavierStokes3DInitialize().\n");
+              return 1;
+            }
+            if (!solver->flag_ib) {
+              printf("Warning: in NavierStokes3DInitialize().\n");
+              printf("Warning: no immersed body present; specification of ib_forces_freq unnecessary.\n");
+            }
+          } else if (!strcmp(word,"ib_ref_area")) {
+            ferr = fscanf(in,"%lf",&physics->ib_ref_area);
+            if (ferr != 1) {
+              fprintf(stderr, "Read error while reading physics.inp in NavierStokes3DInitialize().\n");
+              return 1;
+            }
+          } else if (!strcmp(word,"ib_ref_length")) {
+            ferr = fscanf(in,"%lf",&physics->ib_ref_length);
+            if (ferr != 1) {
+              fprintf(stderr, "Read error while reading physics.inp in NavierStokes3DInitialize().\n");
+              return 1;
+            }
+          } else if (!strcmp(word,"ib_moment_center")) {
+            int d;
+            for (d = 0; d < _MODEL_NDIMS_; d++) {
+              ferr = fscanf(in,"%lf",&physics->ib_moment_center[d]);
+              if (ferr != 1) {
+                fprintf(stderr, "Read error while reading physics.inp in NavierStokes3DInitialize().\n");
+                return 1;
+              }
+            }
           } else if (strcmp(word,"end")) {
             char useless[_MAX_STRING_SIZE_];
             ferr = fscanf(in,"%s",useless); if (ferr != 1) return(ferr);
@@ -351,7 +405,11 @@ int NavierStokes3DInitialize( void *s, /*!< Solver object of type #HyPar */
   IERR MPIBroadcast_double    (&physics->t_ib_ramp            ,1                ,0,&mpi->world); CHECKERR(ierr);
   IERR MPIBroadcast_double    (&physics->t_ib_width           ,1                ,0,&mpi->world); CHECKERR(ierr);
   IERR MPIBroadcast_double    (&physics->ib_T_tol             ,1                ,0,&mpi->world); CHECKERR(ierr);
+  IERR MPIBroadcast_double    (&physics->ib_ref_area          ,1                ,0,&mpi->world); CHECKERR(ierr);
+  IERR MPIBroadcast_double    (&physics->ib_ref_length        ,1                ,0,&mpi->world); CHECKERR(ierr);
+  IERR MPIBroadcast_double    (physics->ib_moment_center      ,_MODEL_NDIMS_    ,0,&mpi->world); CHECKERR(ierr);
   IERR MPIBroadcast_integer   (&physics->HB                   ,1                ,0,&mpi->world); CHECKERR(ierr);
+  IERR MPIBroadcast_integer   (&physics->ib_forces_freq       ,1                ,0,&mpi->world); CHECKERR(ierr);
 
   /* if file output is disabled in HyPar, respect that */
   if (!strcmp(solver->op_file_format,"none")) {
@@ -395,6 +453,7 @@ int NavierStokes3DInitialize( void *s, /*!< Solver object of type #HyPar */
 #endif
     solver->PreStep               = NavierStokes3DPreStep;
     solver->ComputeCFL            = NavierStokes3DComputeCFL;
+    solver->ComputeLocalCFL       = NavierStokes3DComputeLocalCFL;
     solver->FFunction             = NavierStokes3DFlux;
     solver->SFunction             = NavierStokes3DSource;
     solver->UFunction             = NavierStokes3DModifiedSolution;
@@ -418,6 +477,45 @@ int NavierStokes3DInitialize( void *s, /*!< Solver object of type #HyPar */
     if (!strcmp(physics->ib_write_surface_data,"yes")) {
       solver->PhysicsOutput = NavierStokes3DIBForces;
     }
+    /* force and moment coefficients, not on the coarse grids of the grid sequencing */
+#if defined(HAVE_CUDA)
+    if (!solver->use_gpu) {
+#endif
+      if ((physics->ib_forces_freq > 0) && (!solver->gs_level)) {
+        solver->PostStep = NavierStokes3DIBForcesPostStep;
+        int status = 0;
+        if (!mpi->rank) {
+          char filename[_MAX_STRING_SIZE_] = "ib_forces";
+          if (solver->nsims > 1) {
+            char index[_MAX_STRING_SIZE_];
+            GetStringFromInteger(solver->my_idx, index, (int)log10(solver->nsims)+1);
+            strcat(filename, "_");
+            strcat(filename, index);
+          }
+          strcat(filename, ".dat");
+          /* a restarted simulation appends to the existing file */
+          if (solver->restart_iter > 0) {
+            physics->ib_forces_file = fopen(filename,"a");
+          } else {
+            physics->ib_forces_file = fopen(filename,"w");
+            if (physics->ib_forces_file) {
+              fprintf(physics->ib_forces_file,"# time CFx CFy CFz CMx CMy CMz\n");
+            }
+          }
+          if (!physics->ib_forces_file) {
+            fprintf(stderr,"Error in NavierStokes3DInitialize(): unable to open %s for writing.\n",filename);
+            status = 1;
+          } else {
+            printf("Writing immersed body force and moment coefficients to %s every %d time steps.\n",
+                   filename, physics->ib_forces_freq);
+          }
+        }
+        IERR MPIBroadcast_integer(&status,1,0,&mpi->world); CHECKERR(ierr);
+        if (status) return(1);
+      }
+#if defined(HAVE_CUDA)
+    }
+#endif
   }
 
 #if defined(HAVE_CUDA)
@@ -499,9 +597,11 @@ int NavierStokes3DInitialize( void *s, /*!< Solver object of type #HyPar */
 #if defined(HAVE_CUDA)
   if (solver->use_gpu) {
     solver->ParabolicFunction = gpuNavierStokes3DParabolicFunction;
+    solver->ParabolicFunctionAccumulate = NULL;
   } else {
 #endif
     solver->ParabolicFunction = NavierStokes3DParabolicFunction;
+    solver->ParabolicFunctionAccumulate = NavierStokes3DParabolicFunctionAccumulate;
 #if defined(HAVE_CUDA)
   }
 #endif
@@ -24,8 +24,8 @@ int NavierStokes3DJacobian(
                    )
 {
   NavierStokes3D *param = (NavierStokes3D*) p;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_], DL[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, DL[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   /* get the eigenvalues and left,right eigenvectors */
   _NavierStokes3DEigenvalues_      (u,_NavierStokes3D_stride_,D,param->gamma,dir);
@@ -62,8 +62,8 @@ int NavierStokes3DStiffJacobian(
                    )
 {
   NavierStokes3D *param = (NavierStokes3D*) p;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_], DL[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, DL[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   /* get the eigenvalues and left,right eigenvectors */
   _NavierStokes3DEigenvalues_      (u,_NavierStokes3D_stride_,D,param->gamma,dir);
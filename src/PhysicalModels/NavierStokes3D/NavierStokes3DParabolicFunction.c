@@ -11,9 +11,7 @@
 #include <mpivars.h>
 #include <hypar.h>
 
-#if defined(CPU_STAT)
-#include <time.h>
-#endif
+int NavierStokes3DParabolicFunctionAccumulate(double*,double,double*,void*,void*,double);
 
 /*!
     Compute the viscous terms in the 3D Navier Stokes equations: this function computes
@@ -40,7 +38,8 @@
     \f}
     and the temperature is \f$T = \gamma p/\rho\f$. \f$Re\f$ and \f$Pr\f$ are the Reynolds and Prandtl numbers, respectively. Note that this function
     computes the entire parabolic term, and thus bypasses HyPar's parabolic function calculation interfaces. NavierStokes3DInitialize() assigns this
-    function to #HyPar::ParabolicFunction.
+    function to #HyPar::ParabolicFunction, and NavierStokes3DParabolicFunctionAccumulate() to
+    #HyPar::ParabolicFunctionAccumulate.
     \n\n
     Reference:
     + Tannehill, Anderson and Pletcher, Computational Fluid Mechanics and Heat Transfer,
@@ -54,6 +53,26 @@ int NavierStokes3DParabolicFunction(
                                       void    *m,   /*!< MPI object of type #MPIVariables */
                                       double  t     /*!< Current simulation time */
                                    )
+{
+  HyPar *solver = (HyPar*) s;
+  _DECLARE_IERR_;
+
+  _ArraySetValue_(par,solver->npoints_local_wghosts*_MODEL_NVARS_,0.0);
+  IERR NavierStokes3DParabolicFunctionAccumulate(par,1.0,u,s,m,t); CHECKERR(ierr);
+  if (solver->flag_ib) _ArrayBlockMultiply_(par,solver->iblank,solver->npoints_local_wghosts,_MODEL_NVARS_);
+
+  return(0);
+}
+
+/*! Add a multiple of the viscous terms, computed as described in NavierStokes3DParabolicFunction(), to a given array. */
+int NavierStokes3DParabolicFunctionAccumulate(
+                                                double  *par, /*!< Array to which the scaled viscous terms are added */
+                                                double  a,    /*!< Scaling factor */
+                                                double  *u,   /*!< Solution vector array */
+                                                void    *s,   /*!< Solver object of type #HyPar */
+                                                void    *m,   /*!< MPI object of type #MPIVariables */
+                                                double  t     /*!< Current simulation time */
+                                             )
 {
   HyPar           *solver   = (HyPar*) s;
   MPIVariables    *mpi      = (MPIVariables*) m;
@@ -68,7 +87,6 @@ int NavierStokes3DParabolicFunction(
   int *dim   = solver->dim_local;
   int size   = solver->npoints_local_wghosts;
 
-  _ArraySetValue_(par,size*_MODEL_NVARS_,0.0);
   if (physics->Re <= 0) return(0); /* inviscid flow */
   solver->count_par++;
 
@@ -77,17 +95,9 @@ int NavierStokes3DParabolicFunction(
   double        inv_Re       = 1.0 / physics->Re;
   double        inv_Pr       = 1.0 / physics->Pr;
 
-#if defined(CPU_STAT)
-  clock_t startEvent, stopEvent;
-#endif
-
   double *Q; /* primitive variables */
   Q = (double*) calloc (size*_MODEL_NVARS_,sizeof(double));
 
-#if defined(CPU_STAT)
-  startEvent = clock();
-#endif
-
   for (i=-ghosts; i<(imax+ghosts); i++) {
     for (j=-ghosts; j<(jmax+ghosts); j++) {
       for (k=-ghosts; k<(kmax+ghosts); k++) {
@@ -108,12 +118,6 @@ int NavierStokes3DParabolicFunction(
     }
   }
 
-#if defined(CPU_STAT)
-  stopEvent = clock();
-  printf("%-50s CPU time (secs) = %.6f\n",
-         "NaverStokes3DParabolicFunction_Q",(double)(stopEvent-startEvent)/CLOCKS_PER_SEC);
-#endif
-
   double *QDerivX = (double*) calloc (size*_MODEL_NVARS_,sizeof(double));
   double *QDerivY = (double*) calloc (size*_MODEL_NVARS_,sizeof(double));
   double *QDerivZ = (double*) calloc (size*_MODEL_NVARS_,sizeof(double));
@@ -202,7 +206,7 @@ int NavierStokes3DParabolicFunction(
         double dxinv;
         _ArrayIndex1D_(_MODEL_NDIMS_,dim,index,ghosts,p); p *= _MODEL_NVARS_;
         _GetCoordinate_(_XDIR_,index[_XDIR_],dim,ghosts,solver->dxinv,dxinv);
-        for (v=0; v<_MODEL_NVARS_; v++) (par+p)[v] += (dxinv * (FDeriv+p)[v] );
+        for (v=0; v<_MODEL_NVARS_; v++) (par+p)[v] += a * (dxinv * (FDeriv+p)[v] );
       }
     }
   }
@@ -255,7 +259,7 @@ int NavierStokes3DParabolicFunction(
         double dyinv;
         _ArrayIndex1D_(_MODEL_NDIMS_,dim,index,ghosts,p); p *= _MODEL_NVARS_;
         _GetCoordinate_(_YDIR_,index[_YDIR_],dim,ghosts,solver->dxinv,dyinv);
-        for (v=0; v<_MODEL_NVARS_; v++) (par+p)[v] += (dyinv * (FDeriv+p)[v] );
+        for (v=0; v<_MODEL_NVARS_; v++) (par+p)[v] += a * (dyinv * (FDeriv+p)[v] );
       }
     }
   }
@@ -308,7 +312,7 @@ int NavierStokes3DParabolicFunction(
         double dzinv;
         _ArrayIndex1D_(_MODEL_NDIMS_,dim,index,ghosts,p); p *= _MODEL_NVARS_;
         _GetCoordinate_(_ZDIR_,index[_ZDIR_],dim,ghosts,solver->dxinv,dzinv);
-        for (v=0; v<_MODEL_NVARS_; v++) (par+p)[v] += (dzinv * (FDeriv+p)[v] );
+        for (v=0; v<_MODEL_NVARS_; v++) (par+p)[v] += a * (dzinv * (FDeriv+p)[v] );
       }
     }
   }
@@ -320,6 +324,5 @@ int NavierStokes3DParabolicFunction(
   free(FViscous);
   free(FDeriv);
 
-  if (solver->flag_ib) _ArrayBlockMultiply_(par,solver->iblank,size,_MODEL_NVARS_);
   return(0);
 }
@@ -61,8 +61,8 @@ int NavierStokes3DSource(
   double  *x      = solver->x;
   double  *dxinv  = solver->dxinv;
   double  RT      =  param->p0 / param->rho0;
-  static int index[_MODEL_NDIMS_],index1[_MODEL_NDIMS_],index2[_MODEL_NDIMS_],dim_interface[_MODEL_NDIMS_];
-  static double grav[_MODEL_NDIMS_];
+  int        index[_MODEL_NDIMS_],index1[_MODEL_NDIMS_],index2[_MODEL_NDIMS_],dim_interface[_MODEL_NDIMS_];
+  double        grav[_MODEL_NDIMS_];
 
   grav[_XDIR_] = param->grav_x;
   grav[_YDIR_] = param->grav_y;
@@ -136,7 +136,7 @@ int NavierStokes3DSourceFunction(
 
   int ghosts  = solver->ghosts;
   int *dim    = solver->dim_local;
-  static int index[_MODEL_NDIMS_], bounds[_MODEL_NDIMS_], offset[_MODEL_NDIMS_];
+  int        index[_MODEL_NDIMS_], bounds[_MODEL_NDIMS_], offset[_MODEL_NDIMS_];
 
   /* set bounds for array index to include ghost points */
   _ArrayCopy1D_(dim,bounds,_MODEL_NDIMS_);
@@ -186,7 +186,7 @@ int NavierStokes3DSourceUpwind(
   _DECLARE_IERR_;
 
 
-  static int index_outer[_MODEL_NDIMS_], index_inter[_MODEL_NDIMS_],
+  int        index_outer[_MODEL_NDIMS_], index_inter[_MODEL_NDIMS_],
              bounds_outer[_MODEL_NDIMS_], bounds_inter[_MODEL_NDIMS_];
   _ArrayCopy1D_(dim,bounds_outer,_MODEL_NDIMS_); bounds_outer[dir] =  1;
   _ArrayCopy1D_(dim,bounds_inter,_MODEL_NDIMS_); bounds_inter[dir] += 1;
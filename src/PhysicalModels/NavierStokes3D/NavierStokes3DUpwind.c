@@ -9,12 +9,9 @@
 #include <mathfunctions.h>
 #include <matmult_native.h>
 #include <physicalmodels/navierstokes3d.h>
+#include <interpolation.h>
 #include <hypar.h>
 
-#if defined(CPU_STAT)
-#include <time.h>
-#endif
-
 static const int dummy = 1;
 
 /*! Roe's upwinding scheme.
@@ -58,17 +55,12 @@ int NavierStokes3DUpwindRoe(
   int bounds_outer[_MODEL_NDIMS_], bounds_inter[_MODEL_NDIMS_];
   _ArrayCopy1D3_(dim,bounds_outer,_MODEL_NDIMS_); bounds_outer[dir] =  1;
   _ArrayCopy1D3_(dim,bounds_inter,_MODEL_NDIMS_); bounds_inter[dir] += 1;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_], DL[_MODEL_NVARS_*_MODEL_NVARS_],
-                modA[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, DL[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                modA[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; int index_outer[3] = {0,0,0}, index_inter[3];
 
-#if defined(CPU_STAT)
-  clock_t startEvent, stopEvent;
-  startEvent = clock();
-#endif
-
   while (!done) {
     _ArrayCopy1D3_(index_outer,index_inter,_MODEL_NDIMS_);
     for (index_inter[dir] = 0; index_inter[dir] < bounds_inter[dir]; index_inter[dir]++) {
@@ -87,10 +79,12 @@ int NavierStokes3DUpwindRoe(
       udiff[3] = 0.5 * (uR[_MODEL_NVARS_*p+3] - uL[_MODEL_NVARS_*p+3]);
       udiff[4] = 0.5 * (uR[_MODEL_NVARS_*p+4] - uL[_MODEL_NVARS_*p+4]);
 
-      _NavierStokes3DRoeAverage_        (uavg,_NavierStokes3D_stride_,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
+      if (!EigenCacheGet(solver,dir,p,uavg,L,R)) {
+        _NavierStokes3DRoeAverage_        (uavg,_NavierStokes3D_stride_,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
+        _NavierStokes3DLeftEigenvectors_  (uavg,dummy,L,param->gamma,dir);
+        _NavierStokes3DRightEigenvectors_ (uavg,dummy,R,param->gamma,dir);
+      }
       _NavierStokes3DEigenvalues_       (uavg,dummy,D,param->gamma,dir);
-      _NavierStokes3DLeftEigenvectors_  (uavg,dummy,L,param->gamma,dir);
-      _NavierStokes3DRightEigenvectors_ (uavg,dummy,R,param->gamma,dir);
 
       /* Harten's Entropy Fix - Page 362 of Leveque */
       int k;
@@ -114,12 +108,6 @@ int NavierStokes3DUpwindRoe(
     _ArrayIncrementIndex_(_MODEL_NDIMS_,bounds_outer,index_outer,done);
   }
 
-#if defined(CPU_STAT)
-  stopEvent = clock();
-  printf("%-50s CPU time (secs) = %.6f dir = %d\n",
-          "NavierStokes3DUpwindRoe", (double)(stopEvent-startEvent)/CLOCKS_PER_SEC, dir);
-#endif
-
   return(0);
 }
 
@@ -158,7 +146,7 @@ int NavierStokes3DUpwindRF(
   int bounds_outer[_MODEL_NDIMS_], bounds_inter[_MODEL_NDIMS_];
   _ArrayCopy1D3_(dim,bounds_outer,_MODEL_NDIMS_); bounds_outer[dir] =  1;
   _ArrayCopy1D3_(dim,bounds_inter,_MODEL_NDIMS_); bounds_inter[dir] += 1;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_], L[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, L[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; int index_outer[3] = {0,0,0}, index_inter[3];
   while (!done) {
@@ -262,7 +250,7 @@ int NavierStokes3DUpwindLLF(
   int bounds_outer[_MODEL_NDIMS_], bounds_inter[_MODEL_NDIMS_];
   _ArrayCopy1D3_(dim,bounds_outer,_MODEL_NDIMS_); bounds_outer[dir] =  1;
   _ArrayCopy1D3_(dim,bounds_inter,_MODEL_NDIMS_); bounds_inter[dir] += 1;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_], L[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, L[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; int index_outer[3] = {0,0,0}, index_inter[3];
   while (!done) {
@@ -366,9 +354,9 @@ int NavierStokes3DUpwindRusanov(
   bounds_outer[0] = dim[0]; bounds_outer[1] = dim[1]; bounds_outer[2] = dim[2]; bounds_outer[dir] = 1;
   bounds_inter[0] = dim[0]; bounds_inter[1] = dim[1]; bounds_inter[2] = dim[2]; bounds_inter[dir]++;
 
-  static double udiff[_MODEL_NVARS_],uavg[_MODEL_NVARS_];
+  double        udiff[_MODEL_NVARS_],uavg[_MODEL_NVARS_];
 
-  static int index_outer[_MODEL_NDIMS_], index_inter[_MODEL_NDIMS_],
+  int        index_outer[_MODEL_NDIMS_], index_inter[_MODEL_NDIMS_],
              indexL[_MODEL_NDIMS_], indexR[_MODEL_NDIMS_];
 
   done = 0; _ArraySetValue_(index_outer,_MODEL_NDIMS_,0);
@@ -391,7 +379,9 @@ int NavierStokes3DUpwindRusanov(
       udiff[3] = 0.5 * (uR[q+3] - uL[q+3]);
       udiff[4] = 0.5 * (uR[q+4] - uL[q+4]);
 
-      _NavierStokes3DRoeAverage_(uavg,_NavierStokes3D_stride_,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
+      if (!EigenCacheGet(solver,dir,p,uavg,NULL,NULL)) {
+        _NavierStokes3DRoeAverage_(uavg,_NavierStokes3D_stride_,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
+      }
 
       double c, vel[_MODEL_NDIMS_], rho,E,P;
       _NavierStokes3DGetFlowVar_((u+_MODEL_NVARS_*pL),_NavierStokes3D_stride_,rho,vel[0],vel[1],vel[2],E,P,param->gamma);
@@ -449,9 +439,9 @@ int NavierStokes3DUpwinddFRoe(
   int bounds_outer[_MODEL_NDIMS_], bounds_inter[_MODEL_NDIMS_];
   _ArrayCopy1D3_(dim,bounds_outer,_MODEL_NDIMS_); bounds_outer[dir] =  1;
   _ArrayCopy1D3_(dim,bounds_inter,_MODEL_NDIMS_); bounds_inter[dir] += 1;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_], DL[_MODEL_NVARS_*_MODEL_NVARS_],
-                modA[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, DL[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                modA[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; int index_outer[3] = {0,0,0}, index_inter[3];
   while (!done) {
@@ -546,9 +536,9 @@ int NavierStokes3DUpwindFdFRoe(
   int bounds_outer[_MODEL_NDIMS_], bounds_inter[_MODEL_NDIMS_];
   _ArrayCopy1D3_(dim,bounds_outer,_MODEL_NDIMS_); bounds_outer[dir] =  1;
   _ArrayCopy1D3_(dim,bounds_inter,_MODEL_NDIMS_); bounds_inter[dir] += 1;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_], DL[_MODEL_NVARS_*_MODEL_NVARS_],
-                modA[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, DL[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                modA[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; int index_outer[3] = {0,0,0}, index_inter[3];
   while (!done) {
@@ -573,10 +563,12 @@ int NavierStokes3DUpwindFdFRoe(
       udiff[4] = 0.5 * (uR[_MODEL_NVARS_*p+4] - uL[_MODEL_NVARS_*p+4]);
 
       /* Compute total dissipation */
-      _NavierStokes3DRoeAverage_        (uavg,_NavierStokes3D_stride_,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
+      if (!EigenCacheGet(solver,dir,p,uavg,L,R)) {
+        _NavierStokes3DRoeAverage_        (uavg,_NavierStokes3D_stride_,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
+        _NavierStokes3DLeftEigenvectors_  (uavg,dummy,L,param->gamma,dir);
+        _NavierStokes3DRightEigenvectors_ (uavg,dummy,R,param->gamma,dir);
+      }
       _NavierStokes3DEigenvalues_       (uavg,dummy,D,param->gamma,dir);
-      _NavierStokes3DLeftEigenvectors_  (uavg,dummy,L,param->gamma,dir);
-      _NavierStokes3DRightEigenvectors_ (uavg,dummy,R,param->gamma,dir);
       k=0;  D[k] = (absolute(D[k]) < delta ? (D[k]*D[k]+delta2)/(2*delta) : absolute(D[k]) );
       k=6;  D[k] = (absolute(D[k]) < delta ? (D[k]*D[k]+delta2)/(2*delta) : absolute(D[k]) );
       k=12; D[k] = (absolute(D[k]) < delta ? (D[k]*D[k]+delta2)/(2*delta) : absolute(D[k]) );
@@ -651,18 +643,18 @@ int NavierStokes3DUpwindRusanovModified(
   NavierStokes3D  *param  = (NavierStokes3D*) solver->physics;
   int             *dim    = solver->dim_local, done;
 
-  static int bounds_outer[_MODEL_NDIMS_], bounds_inter[_MODEL_NDIMS_];
+  int        bounds_outer[_MODEL_NDIMS_], bounds_inter[_MODEL_NDIMS_];
   bounds_outer[0] = dim[0]; bounds_outer[1] = dim[1]; bounds_outer[2] = dim[2]; bounds_outer[dir] = 1;
   bounds_inter[0] = dim[0]; bounds_inter[1] = dim[1]; bounds_inter[2] = dim[2]; bounds_inter[dir]++;
 
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_], DL[_MODEL_NVARS_*_MODEL_NVARS_],
-                modA[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, DL[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                modA[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
-  static int indexL[_MODEL_NDIMS_], indexR[_MODEL_NDIMS_],
+  int        indexL[_MODEL_NDIMS_], indexR[_MODEL_NDIMS_],
              index_outer[_MODEL_NDIMS_], index_inter[_MODEL_NDIMS_];
 
-  static double udiff[_MODEL_NVARS_],uavg[_MODEL_NVARS_],udiss[_MODEL_NVARS_];
+  double        udiff[_MODEL_NVARS_],uavg[_MODEL_NVARS_],udiss[_MODEL_NVARS_];
 
   done = 0; _ArraySetValue_(index_outer,_MODEL_NDIMS_,0);
   while (!done) {
@@ -684,9 +676,11 @@ int NavierStokes3DUpwindRusanovModified(
       udiff[3] = 0.5 * (uR[q+3] - uL[q+3]);
       udiff[4] = 0.5 * (uR[q+4] - uL[q+4]);
 
-      _NavierStokes3DRoeAverage_        (uavg,_NavierStokes3D_stride_,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
-      _NavierStokes3DLeftEigenvectors_  (uavg,dummy,L,param->gamma,dir);
-      _NavierStokes3DRightEigenvectors_ (uavg,dummy,R,param->gamma,dir);
+      if (!EigenCacheGet(solver,dir,p,uavg,L,R)) {
+        _NavierStokes3DRoeAverage_        (uavg,_NavierStokes3D_stride_,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
+        _NavierStokes3DLeftEigenvectors_  (uavg,dummy,L,param->gamma,dir);
+        _NavierStokes3DRightEigenvectors_ (uavg,dummy,R,param->gamma,dir);
+      }
 
       double c, vel[_MODEL_NDIMS_], rho,E,P;
 
@@ -770,18 +764,18 @@ int NavierStokes3DUpwinddFRusanovModified(
   int             *dim    = solver->dim_local, done;
   double          *uref   = param->solution;
 
-  static int bounds_outer[_MODEL_NDIMS_], bounds_inter[_MODEL_NDIMS_];
+  int        bounds_outer[_MODEL_NDIMS_], bounds_inter[_MODEL_NDIMS_];
   bounds_outer[0] = dim[0]; bounds_outer[1] = dim[1]; bounds_outer[2] = dim[2]; bounds_outer[dir] = 1;
   bounds_inter[0] = dim[0]; bounds_inter[1] = dim[1]; bounds_inter[2] = dim[2]; bounds_inter[dir]++;
 
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_], DL[_MODEL_NVARS_*_MODEL_NVARS_],
-                modA[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, DL[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                modA[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
-  static int indexL[_MODEL_NDIMS_], indexR[_MODEL_NDIMS_],
+  int        indexL[_MODEL_NDIMS_], indexR[_MODEL_NDIMS_],
              index_outer[_MODEL_NDIMS_], index_inter[_MODEL_NDIMS_];
 
-  static double udiff[_MODEL_NVARS_],uavg[_MODEL_NVARS_],udiss[_MODEL_NVARS_];
+  double        udiff[_MODEL_NVARS_],uavg[_MODEL_NVARS_],udiss[_MODEL_NVARS_];
 
   done = 0; _ArraySetValue_(index_outer,_MODEL_NDIMS_,0);
   while (!done) {
@@ -876,18 +870,18 @@ int NavierStokes3DUpwindFdFRusanovModified(
   int             *dim    = solver->dim_local, done;
   double          *uref   = param->solution;
 
-  static int bounds_outer[_MODEL_NDIMS_], bounds_inter[_MODEL_NDIMS_];
+  int        bounds_outer[_MODEL_NDIMS_], bounds_inter[_MODEL_NDIMS_];
   bounds_outer[0] = dim[0]; bounds_outer[1] = dim[1]; bounds_outer[2] = dim[2]; bounds_outer[dir] = 1;
   bounds_inter[0] = dim[0]; bounds_inter[1] = dim[1]; bounds_inter[2] = dim[2]; bounds_inter[dir]++;
 
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                L[_MODEL_NVARS_*_MODEL_NVARS_], DL[_MODEL_NVARS_*_MODEL_NVARS_],
-                modA[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                L[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, DL[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                modA[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
-  static int indexL[_MODEL_NDIMS_], indexR[_MODEL_NDIMS_],
+  int        indexL[_MODEL_NDIMS_], indexR[_MODEL_NDIMS_],
              index_outer[_MODEL_NDIMS_], index_inter[_MODEL_NDIMS_];
 
-  static double udiff[_MODEL_NVARS_],uavg[_MODEL_NVARS_],udiss[_MODEL_NVARS_];
+  double        udiff[_MODEL_NVARS_],uavg[_MODEL_NVARS_],udiss[_MODEL_NVARS_];
 
   done = 0; _ArraySetValue_(index_outer,_MODEL_NDIMS_,0);
   while (!done) {
@@ -916,9 +910,11 @@ int NavierStokes3DUpwindFdFRusanovModified(
       udiff[4] = 0.5 * (uR[q+4] - uL[q+4]);
 
       /* Compute total dissipation */
-      _NavierStokes3DRoeAverage_        (uavg,_NavierStokes3D_stride_,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
-      _NavierStokes3DLeftEigenvectors_  (uavg,dummy,L,param->gamma,dir);
-      _NavierStokes3DRightEigenvectors_ (uavg,dummy,R,param->gamma,dir);
+      if (!EigenCacheGet(solver,dir,p,uavg,L,R)) {
+        _NavierStokes3DRoeAverage_        (uavg,_NavierStokes3D_stride_,(u+_MODEL_NVARS_*pL),(u+_MODEL_NVARS_*pR),param->gamma);
+        _NavierStokes3DLeftEigenvectors_  (uavg,dummy,L,param->gamma,dir);
+        _NavierStokes3DRightEigenvectors_ (uavg,dummy,R,param->gamma,dir);
+      }
 
       _NavierStokes3DGetFlowVar_((u+_MODEL_NVARS_*pL),_NavierStokes3D_stride_,rho,vel[0],vel[1],vel[2],E,P,param->gamma);
       c = sqrt(param->gamma*P/rho);
@@ -15,6 +15,7 @@ int    Numa2DFlux               (double*,double*,int,void*,double);
 int    Numa2DStiffFlux          (double*,double*,int,void*,double);
 int    Numa2DSource             (double*,double*,void*,void*,double);
 int    Numa2DParabolicFunction  (double*,double*,void*,void*,double);
+int    Numa2DParabolicFunctionAccumulate (double*,double,double*,void*,void*,double);
 
 int    Numa2DRusanovFlux      (double*,double*,double*,double*,double*,double*,int,void*,double);
 int    Numa2DRusanovLinearFlux(double*,double*,double*,double*,double*,double*,int,void*,double);
@@ -147,6 +148,7 @@ int Numa2DInitialize(void *s,void *m)
    * to this model's own function, since it's difficult to express
    * the dissipation terms in the general form                      */
   solver->ParabolicFunction = Numa2DParabolicFunction;
+  solver->ParabolicFunctionAccumulate = Numa2DParabolicFunctionAccumulate;
 
   /* check that solver has the correct choice of diffusion formulation */
   if (strcmp(solver->spatial_type_par,_NC_2STAGE_)) {
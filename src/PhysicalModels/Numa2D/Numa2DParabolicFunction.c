@@ -14,7 +14,21 @@
                Journal of Computational Physics, 227 (2008), pp. 3849--3877
 */
 
+int Numa2DParabolicFunctionAccumulate(double*,double,double*,void*,void*,double);
+
 int Numa2DParabolicFunction(double *par,double *u,void *s,void *m,double t)
+{
+  HyPar *solver = (HyPar*) s;
+  _DECLARE_IERR_;
+
+  _ArraySetValue_(par,solver->npoints_local_wghosts*_MODEL_NVARS_,0.0);
+  IERR Numa2DParabolicFunctionAccumulate(par,1.0,u,s,m,t); CHECKERR(ierr);
+
+  return(0);
+}
+
+/* par += a * (viscous terms) */
+int Numa2DParabolicFunctionAccumulate(double *par,double a,double *u,void *s,void *m,double t)
 {
   HyPar           *solver   = (HyPar*) s;
   MPIVariables    *mpi      = (MPIVariables*) m;
@@ -29,7 +43,6 @@ int Numa2DParabolicFunction(double *par,double *u,void *s,void *m,double t)
   int *dim   = solver->dim_local;
   int size   = (imax+2*ghosts)*(jmax+2*ghosts)*_MODEL_NVARS_;
 
-  _ArraySetValue_(par,size,0.0);
   if (physics->mu <= 0) return(0); /* inviscid flow */
   solver->count_par++;
 
@@ -93,7 +106,7 @@ int Numa2DParabolicFunction(double *par,double *u,void *s,void *m,double t)
   while (!done) {
     int p; _ArrayIndex1D_(_MODEL_NDIMS_,dim,index,ghosts,p); p *= _MODEL_NVARS_;
     _GetCoordinate_(_XDIR_,index[_XDIR_],dim,ghosts,solver->dxinv,dxinv);
-    for (v=0; v<_MODEL_NVARS_; v++) (par+p)[v] += (dxinv * (FDeriv+p)[v] );
+    for (v=0; v<_MODEL_NVARS_; v++) (par+p)[v] += a * (dxinv * (FDeriv+p)[v] );
     _ArrayIncrementIndex_(_MODEL_NDIMS_,dim,index,done);
   }
 
@@ -125,7 +138,7 @@ int Numa2DParabolicFunction(double *par,double *u,void *s,void *m,double t)
   while (!done) {
     int p; _ArrayIndex1D_(_MODEL_NDIMS_,dim,index,ghosts,p); p *= _MODEL_NVARS_;
     _GetCoordinate_(_YDIR_,index[_YDIR_],dim,ghosts,solver->dxinv,dyinv);
-    for (v=0; v<_MODEL_NVARS_; v++) (par+p)[v] += (dyinv * (FDeriv+p)[v] );
+    for (v=0; v<_MODEL_NVARS_; v++) (par+p)[v] += a * (dyinv * (FDeriv+p)[v] );
     _ArrayIncrementIndex_(_MODEL_NDIMS_,dim,index,done);
   }
 
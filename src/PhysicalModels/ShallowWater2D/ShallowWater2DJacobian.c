@@ -23,8 +23,8 @@ int ShallowWater2DJacobian(
                    )
 {
   ShallowWater2D  *param = (ShallowWater2D*) p;
-  static double   R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_],
-                  L[_MODEL_NVARS_*_MODEL_NVARS_], DL[_MODEL_NVARS_*_MODEL_NVARS_];
+  double          R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                  L[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, DL[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   /* get the eigenvalues and left,right eigenvectors */
   _ShallowWater2DEigenvalues_      (u,D,param,dir);
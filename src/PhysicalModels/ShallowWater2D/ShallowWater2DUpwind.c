@@ -51,8 +51,8 @@ int ShallowWater2DUpwindRoe(
   int index_outer[ndims], index_inter[ndims], bounds_outer[ndims], bounds_inter[ndims];
   _ArrayCopy1D_(dim,bounds_outer,ndims); bounds_outer[dir] =  1;
   _ArrayCopy1D_(dim,bounds_inter,ndims); bounds_inter[dir] += 1;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_], L[_MODEL_NVARS_*_MODEL_NVARS_],
-                DL[_MODEL_NVARS_*_MODEL_NVARS_], modA[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, L[_MODEL_NVARS_*_MODEL_NVARS_] = {0},
+                DL[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, modA[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; _ArraySetValue_(index_outer,ndims,0);
   while (!done) {
@@ -138,7 +138,7 @@ int ShallowWater2DUpwindLLF(
   int index_outer[ndims], index_inter[ndims], bounds_outer[ndims], bounds_inter[ndims];
   _ArrayCopy1D_(dim,bounds_outer,ndims); bounds_outer[dir] =  1;
   _ArrayCopy1D_(dim,bounds_inter,ndims); bounds_inter[dir] += 1;
-  static double R[_MODEL_NVARS_*_MODEL_NVARS_], D[_MODEL_NVARS_*_MODEL_NVARS_], L[_MODEL_NVARS_*_MODEL_NVARS_];
+  double        R[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, D[_MODEL_NVARS_*_MODEL_NVARS_] = {0}, L[_MODEL_NVARS_*_MODEL_NVARS_] = {0};
 
   done = 0; _ArraySetValue_(index_outer,ndims,0);
   while (!done) {
@@ -29,6 +29,11 @@ int VlasovCleanup(void *s /*!< Solver object of type #HyPar */)
 
     fftw_free(physics->phys_buffer_phi);
     fftw_free(physics->fourier_buffer_phi);
+
+#ifndef serial
+    MPI_Comm_free(&physics->comm_v);
+    MPI_Comm_free(&physics->comm_x);
+#endif
   }
 #endif
 
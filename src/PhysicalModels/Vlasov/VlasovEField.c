@@ -88,7 +88,15 @@ static int SetEFieldPrescribed( double* u,/*!< Conserved solution */
 }
 
 /*! Compute the self-consistent electric field over the local domain: The field
- * is solved from the solution values using a Poisson solve in Fourier space. */
+ * is solved from the solution values using a Poisson solve in Fourier space.
+ *
+ * The distribution function is integrated over velocity space locally and then
+ * summed over the ranks along velocity space (#Vlasov::comm_v) with a single
+ * reduction. The Poisson equation for the potential is solved with FFTs
+ * distributed over the ranks along physical space (#Vlasov::comm_x), and the
+ * components of the electric field are obtained as
+ * \f$\hat{E}_d = -\hat{\left(\partial \phi/\partial x_d\right)} = -i k_d \hat{\phi}\f$.
+ * The spatial domain is assumed to be \f$2\pi\f$-periodic along each dimension. */
 static int SetEFieldSelfConsistent(double* u,/*!< Conserved solution */
                                    void*   s,/*!< Solver object of type #HyPar */
                                    double  t /*!< Current time */
@@ -98,24 +106,20 @@ static int SetEFieldSelfConsistent(double* u,/*!< Conserved solution */
   Vlasov *param  = (Vlasov*) solver->physics;
   MPIVariables *mpi = (MPIVariables *) param->m;
 
-  if (param->ndims_x > 1) {
-    fprintf(stderr,"Error in SetEFieldSelfConsistent():\n");
-    fprintf(stderr,"  Implemented for 1 spatial dimension only.\n");
-    return 1;
-  }
-
-#ifndef fftw
+#if !defined(fftw) || defined(serial)
 
   fprintf(stderr,"Error in SetEFieldSelfConsistent():\n");
-  fprintf(stderr,"  Using a self-consistent electric field requires FFTW.\n");
+  fprintf(stderr,"  Using a self-consistent electric field requires FFTW (with MPI).\n");
   exit(1);
 
 #else
 
-  int *dim    = solver->dim_local;
-  int  N      = solver->dim_global[0];
-  int  ghosts = solver->ghosts;
-  int  ndims  = solver->ndims;
+  int *dim        = solver->dim_local;
+  int *dim_global = solver->dim_global;
+  int  ghosts     = solver->ghosts;
+  int  ndims      = solver->ndims;
+  int  ndims_x    = param->ndims_x;
+  long N          = param->npts_global_x;
 
   double       *sum_buffer       = param->sum_buffer;
   double       *field            = param->e_field;
@@ -123,130 +127,134 @@ static int SetEFieldSelfConsistent(double* u,/*!< Conserved solution */
   fftw_complex *fourier_buffer_e = param->fourier_buffer_e;
   fftw_plan     plan_forward_e   = param->plan_forward_e;
   fftw_plan     plan_backward_e  = param->plan_backward_e;
-  ptrdiff_t     local_ni         = param->local_ni;
-  ptrdiff_t     local_i_start    = param->local_i_start;
   ptrdiff_t     local_no         = param->local_no;
   ptrdiff_t     local_o_start    = param->local_o_start;
 
   fftw_complex *phys_buffer_phi    = param->phys_buffer_phi;
   fftw_complex *fourier_buffer_phi = param->fourier_buffer_phi;
-  fftw_plan     plan_forward_phi   = param->plan_forward_phi;
   fftw_plan     plan_backward_phi  = param->plan_backward_phi;
 
-  int index[ndims], bounds[ndims], bounds_noghost[ndims], offset[ndims];
-
-  // set bounds for array index to include ghost points
-  _ArrayCopy1D_(dim,bounds,ndims);
-  for (int i = 0; i < ndims; i++) bounds[i] += 2*ghosts;
+  int index[ndims], bounds_noghost[ndims];
+  int dim_x[ndims_x], index_x[ndims_x];
+  _ArrayCopy1D_(dim,dim_x,ndims_x);
 
   // set bounds for array index to NOT include ghost points
   _ArrayCopy1D_(dim,bounds_noghost,ndims);
 
-  // set offset such that index is compatible with ghost point arrangement
-  _ArraySetValue_(offset,ndims,-ghosts);
-
   // First, integrate the particle distribution over velocity.
   // Since the array dimension we want is not unit stride,
   // first manually add up the local part of the array.
   int done = 0; _ArraySetValue_(index,ndims,0);
-  _ArraySetValue_(sum_buffer,dim[0],0);
+  _ArraySetValue_(sum_buffer,param->npts_local_x,0);
   while (!done) {
-    //int p; _ArrayIndex1DWO_(ndims,dim,index,offset,ghosts,p);
     int p; _ArrayIndex1D_(ndims,dim,index,ghosts,p);
+    int q; _ArrayIndex1D_(ndims_x,dim_x,index,0,q);
 
     // accumulate f at this spatial location
-    double dvinv; _GetCoordinate_(1,index[1],dim,ghosts,solver->dxinv,dvinv);
-    double x; _GetCoordinate_(0,index[0],dim,ghosts,solver->x,x);
-    double v; _GetCoordinate_(1,index[1],dim,ghosts,solver->x,v);
+    double dv = 1.0;
+    for (int d = ndims_x; d < ndims; d++) {
+      double dvinv; _GetCoordinate_(d,index[d],dim,ghosts,solver->dxinv,dvinv);
+      dv /= dvinv;
+    }
 
-    sum_buffer[index[0]] += u[p] / dvinv;
+    sum_buffer[q] += u[p] * dv;
 
     _ArrayIncrementIndex_(ndims,bounds_noghost,index,done);
   }
 
-  // Now we can add up globally using MPI reduction
-  for (int i = 0; i < dim[0]; i++) {
-    MPISum_double(&sum_buffer[i], &sum_buffer[i], 1, &mpi->comm[1]);
-  }
+  // Now we can add up globally using a single MPI reduction over velocity space
+  MPISum_double(sum_buffer, sum_buffer, param->npts_local_x, &param->comm_v);
 
   // Find the average density over all x
   double average_velocity = 0.0;
-  for (int i = 0; i < dim[0]; i++) {
+  for (int i = 0; i < param->npts_local_x; i++) {
     average_velocity += sum_buffer[i];
   }
-  MPISum_double(&average_velocity, &average_velocity, 1, &mpi->comm[0]);
+  MPISum_double(&average_velocity, &average_velocity, 1, &param->comm_x);
   average_velocity /= (double) N;
 
   // Copy velocity-integrated values into complex-valued FFTW buffer
-  for (int i = 0; i < dim[0]; i++) {
+  // (the FFTW and HyPar layouts of the local spatial domain are the same)
+  for (int i = 0; i < param->npts_local_x; i++) {
     phys_buffer_e[i][0] = sum_buffer[i] - average_velocity;
     phys_buffer_e[i][1] = 0.0;
   }
 
   // Execute the FFT
-  MPI_Barrier(mpi->comm[0]);
   fftw_execute(plan_forward_e);
-  MPI_Barrier(mpi->comm[0]);
-
-  // Simultaneously do a Poisson solve and take derivative in frequency space
-  int freq_start = 0;
-  if (local_o_start == 0) {
-    freq_start = 1;
-    fourier_buffer_e[0][0] = 0.0;
-    fourier_buffer_e[0][1] = 0.0;
-  }
 
-  // Simultaneously do a Poisson solve in frequency space
-  int freq_start_phi = 0;
-  if (local_o_start == 0) {
-    freq_start_phi = 1;
-    fourier_buffer_phi[0][0] = 0.0;
-    fourier_buffer_phi[0][1] = 0.0;
-  }
+  // The local part of the Fourier space: the whole domain along all but the last
+  // spatial dimension, and [local_o_start,local_o_start+local_no) along the last one
+  int bounds_k[ndims_x];
+  _ArrayCopy1D_(dim_global,bounds_k,ndims_x);
+  bounds_k[ndims_x-1] = local_no;
 
-  for (int i = freq_start_phi; i < local_no; i++) {
-    double freq_num = FFTFreqNum(i + local_o_start, N);
-    double thek = freq_num;
-    // Swapping values is due to multiplication by i
-    fourier_buffer_phi[i][0] = fourier_buffer_e[i][0] / (thek*thek);
-    fourier_buffer_phi[i][1] = fourier_buffer_e[i][1]/ (thek*thek);
+  // Do a Poisson solve in frequency space
+  done = (local_no == 0); _ArraySetValue_(index_x,ndims_x,0);
+  while (!done) {
+    int q; _ArrayIndex1D_(ndims_x,bounds_k,index_x,0,q);
+    double kk = 0.0;
+    for (int d = 0; d < ndims_x; d++) {
+      int bin = index_x[d] + (d == ndims_x-1 ? local_o_start : 0);
+      double thek = FFTFreqNum(bin, dim_global[d]);
+      kk += thek*thek;
+    }
+    if (kk == 0.0) {
+      fourier_buffer_phi[q][0] = 0.0;
+      fourier_buffer_phi[q][1] = 0.0;
+    } else {
+      fourier_buffer_phi[q][0] = fourier_buffer_e[q][0] / kk;
+      fourier_buffer_phi[q][1] = fourier_buffer_e[q][1] / kk;
+    }
+    _ArrayIncrementIndex_(ndims_x,bounds_k,index_x,done);
   }
 
+  // For each component, take the derivative in frequency space and do an inverse
+  // Fourier transform to get back physical solved values
+  for (int dir = 0; dir < ndims_x; dir++) {
+
+    done = (local_no == 0); _ArraySetValue_(index_x,ndims_x,0);
+    while (!done) {
+      int q; _ArrayIndex1D_(ndims_x,bounds_k,index_x,0,q);
+      int bin = index_x[dir] + (dir == ndims_x-1 ? local_o_start : 0);
+      double thek = FFTFreqNum(bin, dim_global[dir]);
+      // Swapping values is due to multiplication by i
+      fourier_buffer_e[q][0] = - fourier_buffer_phi[q][1] * thek;
+      fourier_buffer_e[q][1] =   fourier_buffer_phi[q][0] * thek;
+      _ArrayIncrementIndex_(ndims_x,bounds_k,index_x,done);
+    }
 
-  for (int i = freq_start; i < local_no; i++) {
-    double freq_num = FFTFreqNum(i + local_o_start, N);
-    double thek = freq_num;
-    double temp = fourier_buffer_e[i][0];
-    // Swapping values is due to multiplication by i
-    fourier_buffer_e[i][0] = - fourier_buffer_e[i][1] / thek;
-    fourier_buffer_e[i][1] = temp / thek;
-  }
+    fftw_execute(plan_backward_e);
 
-  // Do an inverse Fourier transform to get back physical solved values
-  MPI_Barrier(mpi->comm[0]);
-  fftw_execute(plan_backward_e);
-  MPI_Barrier(mpi->comm[0]);
+    // copy the solved electric field into the e buffer
+    done = 0; _ArraySetValue_(index_x,ndims_x,0);
+    while (!done) {
+      int p; _ArrayIndex1D_(ndims_x,dim_x,index_x,ghosts,p);
+      int q; _ArrayIndex1D_(ndims_x,dim_x,index_x,0,q);
+      field[ndims_x*p+dir] = - phys_buffer_e[q][0] / (double) N;
+      _ArrayIncrementIndex_(ndims_x,dim_x,index_x,done);
+    }
+  }
 
   // Do an inverse Fourier transform to get back physical solved values
-  MPI_Barrier(mpi->comm[0]);
+  // (last, since it may overwrite the Fourier-space potential)
   fftw_execute(plan_backward_phi);
-  MPI_Barrier(mpi->comm[0]);
-
-  // copy the solved electric field into the e buffer
-  for (int i = 0; i < dim[0]; i++) {
-    param->e_field[i + ghosts] = - phys_buffer_e[i][0] / (double) N;
-  }
 
   // copy the solved potential field into the potential buffer
-  for (int i = 0; i < dim[0]; i++) {
-    param->potential[i + ghosts] = phys_buffer_phi[i][0] / (double) N;
+  done = 0; _ArraySetValue_(index_x,ndims_x,0);
+  while (!done) {
+    int p; _ArrayIndex1D_(ndims_x,dim_x,index_x,ghosts,p);
+    int q; _ArrayIndex1D_(ndims_x,dim_x,index_x,0,q);
+    param->potential[p] = phys_buffer_phi[q][0] / (double) N;
+    _ArrayIncrementIndex_(ndims_x,dim_x,index_x,done);
   }
 
-  // Do halo exchange on the e
-  MPIExchangeBoundaries1D(mpi, param->e_field, dim[0], ghosts, 0, ndims);
-
-  // Do halo exchange on the potential
-  MPIExchangeBoundaries1D(mpi, param->potential, dim[0], ghosts, 0, ndims);
+  // Do halo exchange on the e and the potential over the ranks along physical
+  // space (with the same part of velocity space)
+  MPIVariables mpi_x = *mpi;
+  mpi_x.world = param->comm_x;
+  MPIExchangeBoundariesnD(ndims_x, ndims_x, dim_x, ghosts, &mpi_x, field);
+  MPIExchangeBoundariesnD(ndims_x, 1, dim_x, ghosts, &mpi_x, param->potential);
 
 #endif
 
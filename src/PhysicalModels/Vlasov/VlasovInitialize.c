@@ -59,12 +59,6 @@ int VlasovInitialize(void *s, /*!< Solver object of type #HyPar */
     }
     return(1);
   }
-  if (solver->ndims != _MODEL_NDIMS_) {
-    if (!mpi->rank) {
-      fprintf(stderr,"Error in VlasovInitialize(): ndims has to be %d.\n",_MODEL_NDIMS_);
-    }
-    return(1);
-  }
 
   /* default is prescribed electric field */
   physics->self_consistent_electric_field = 0;
@@ -115,6 +109,16 @@ int VlasovInitialize(void *s, /*!< Solver object of type #HyPar */
     fclose(in);
   }
 
+#ifndef serial
+  /* Broadcast parsed problem data */
+  MPIBroadcast_integer(&physics->ndims_x,1,0,&mpi->world);
+  MPIBroadcast_integer(&physics->ndims_v,1,0,&mpi->world);
+  MPIBroadcast_integer((int *) &physics->self_consistent_electric_field,
+                       1,0,&mpi->world);
+  MPIBroadcast_integer((int *) &physics->use_log_form,
+                       1,0,&mpi->world);
+#endif
+
   if (physics->use_log_form) {
     if (!mpi->rank) {
       printf("Vlasov: using the log form of the Vlasov equation.\n");
@@ -128,6 +132,13 @@ int VlasovInitialize(void *s, /*!< Solver object of type #HyPar */
     }
     return(1);
   }
+  if (physics->ndims_x != physics->ndims_v) {
+    if (!mpi->rank) {
+      fprintf(stderr,"Error in VlasovInitialize:\n");
+      fprintf(stderr, "  number of space and vel dims must be equal!\n");
+    }
+    return(1);
+  }
 
   if (!strcmp(solver->SplitHyperbolicFlux,"yes")) {
     if (!mpi->rank) {
@@ -137,16 +148,6 @@ int VlasovInitialize(void *s, /*!< Solver object of type #HyPar */
     return(1);
   }
 
-#ifndef serial
-  /* Broadcast parsed problem data */
-  MPIBroadcast_integer(&physics->ndims_x,1,0,&mpi->world);
-  MPIBroadcast_integer(&physics->ndims_v,1,0,&mpi->world);
-  MPIBroadcast_integer((int *) &physics->self_consistent_electric_field,
-                       1,0,&mpi->world);
-  MPIBroadcast_integer((int *) &physics->use_log_form,
-                       1,0,&mpi->world);
-#endif
-
   /* compute local number of x-space points with ghosts */
   physics->npts_local_x_wghosts = 1;
   physics->npts_local_x = 1;
@@ -182,62 +183,128 @@ int VlasovInitialize(void *s, /*!< Solver object of type #HyPar */
     return(1);
 #else
 
-    if (physics->ndims_x > 1) {
-      fprintf(stderr,"Error in VlasovInitialize():\n");
-      fprintf(stderr,"  Self-consistent electric field is implemented for only 1 space dimension.\n");
-      return 1;
+    int ndims_x = physics->ndims_x;
+    int d;
+
+    /* Create the communicators along velocity space (to sum the distribution function
+       over velocity) and along physical space (to compute the FFTs) */
+    {
+      int color_v, color_x, key_v, key_x;
+      int *ip = mpi->ip, *iproc = mpi->iproc;
+      _ArrayIndex1D_(ndims_x,iproc,ip,0,color_v);
+      _ArrayIndex1D_(physics->ndims_v,(iproc+ndims_x),(ip+ndims_x),0,color_x);
+      key_v = color_x;
+      key_x = color_v;
+      MPI_Comm_split(mpi->world,color_v,key_v,&physics->comm_v);
+      MPI_Comm_split(mpi->world,color_x,key_x,&physics->comm_x);
     }
 
-    /* Create a scratch buffer for moving between real and complex values */
-    physics->sum_buffer = (double*) calloc(dim_local[0], sizeof(double));
+    /* Create a scratch buffer for the velocity-integrated distribution function */
+    physics->sum_buffer = (double*) calloc(physics->npts_local_x, sizeof(double));
 
     /* Initialize FFTW and set up data buffers used for the transforms */
     fftw_mpi_init();
-    physics->alloc_local = fftw_mpi_local_size_1d(dim_global[0], mpi->comm[0],
-                                                  FFTW_FORWARD, 0,
-                                                  &physics->local_ni,
-                                                  &physics->local_i_start,
-                                                  &physics->local_no,
-                                                  &physics->local_o_start);
-    if (dim_local[0] != physics->local_ni) {
+    if (ndims_x == 1) {
+      physics->alloc_local = fftw_mpi_local_size_1d(dim_global[0], physics->comm_x,
+                                                    FFTW_FORWARD, 0,
+                                                    &physics->local_ni,
+                                                    &physics->local_i_start,
+                                                    &physics->local_no,
+                                                    &physics->local_o_start);
+    } else {
+      /* FFTW stores arrays in row-major order, so its dimensions are the spatial
+         dimensions in reverse order, and the data is distributed in slabs along the
+         last spatial dimension; the output has the same distribution as the input */
+      ptrdiff_t n[ndims_x];
+      for (d=0; d<ndims_x; d++) n[d] = dim_global[ndims_x-1-d];
+      physics->alloc_local = fftw_mpi_local_size(ndims_x, n, physics->comm_x,
+                                                 &physics->local_ni,
+                                                 &physics->local_i_start);
+      physics->local_no      = physics->local_ni;
+      physics->local_o_start = physics->local_i_start;
+    }
+    int compatible = (   (dim_local[ndims_x-1]  == physics->local_ni)
+                      && (mpi->is[ndims_x-1]    == physics->local_i_start) );
+    for (d=0; d<ndims_x-1; d++) compatible = (compatible && (dim_local[d] == dim_global[d]));
+    if (!compatible) {
       fprintf(stderr,"Error in VlasovInitialize(): The FFTW data distribution is incompatible with the HyPar one.\n");
-      fprintf(stderr,"Decompose the spatial dimension so that the degrees of freedom are evenly divided.\n");
+      if (ndims_x == 1) {
+        fprintf(stderr,"Decompose the spatial dimension so that the degrees of freedom are evenly divided.\n");
+      } else {
+        fprintf(stderr,"Decompose only the last spatial dimension, so that the degrees of freedom are evenly divided.\n");
+      }
       return(1);
     }
 
     physics->phys_buffer_e = fftw_alloc_complex(physics->alloc_local);
     physics->fourier_buffer_e = fftw_alloc_complex(physics->alloc_local);
+    physics->phys_buffer_phi = fftw_alloc_complex(physics->alloc_local);
+    physics->fourier_buffer_phi = fftw_alloc_complex(physics->alloc_local);
 
-    physics->plan_forward_e = fftw_mpi_plan_dft_1d(dim_global[0],
-                                                 physics->phys_buffer_e,
-                                                 physics->fourier_buffer_e,
-                                                 mpi->comm[0],
-                                                 FFTW_FORWARD,
-                                                 FFTW_ESTIMATE);
+    if (ndims_x == 1) {
 
-    physics->plan_backward_e = fftw_mpi_plan_dft_1d(dim_global[0],
-                                                  physics->fourier_buffer_e,
+      physics->plan_forward_e = fftw_mpi_plan_dft_1d(dim_global[0],
+                                                   physics->phys_buffer_e,
+                                                   physics->fourier_buffer_e,
+                                                   physics->comm_x,
+                                                   FFTW_FORWARD,
+                                                   FFTW_ESTIMATE);
+
+      physics->plan_backward_e = fftw_mpi_plan_dft_1d(dim_global[0],
+                                                    physics->fourier_buffer_e,
+                                                    physics->phys_buffer_e,
+                                                    physics->comm_x,
+                                                    FFTW_BACKWARD,
+                                                    FFTW_ESTIMATE);
+
+      physics->plan_forward_phi = fftw_mpi_plan_dft_1d(dim_global[0],
+                                                   physics->phys_buffer_phi,
+                                                   physics->fourier_buffer_phi,
+                                                   physics->comm_x,
+                                                   FFTW_FORWARD,
+                                                   FFTW_ESTIMATE);
+
+      physics->plan_backward_phi = fftw_mpi_plan_dft_1d(dim_global[0],
+                                                    physics->fourier_buffer_phi,
+                                                    physics->phys_buffer_phi,
+                                                    physics->comm_x,
+                                                    FFTW_BACKWARD,
+                                                    FFTW_ESTIMATE);
+
+    } else {
+
+      ptrdiff_t n[ndims_x];
+      for (d=0; d<ndims_x; d++) n[d] = dim_global[ndims_x-1-d];
+
+      physics->plan_forward_e = fftw_mpi_plan_dft(ndims_x, n,
                                                   physics->phys_buffer_e,
-                                                  mpi->comm[0],
-                                                  FFTW_BACKWARD,
+                                                  physics->fourier_buffer_e,
+                                                  physics->comm_x,
+                                                  FFTW_FORWARD,
                                                   FFTW_ESTIMATE);
 
-    physics->phys_buffer_phi = fftw_alloc_complex(physics->alloc_local);
-    physics->fourier_buffer_phi = fftw_alloc_complex(physics->alloc_local);
+      physics->plan_backward_e = fftw_mpi_plan_dft(ndims_x, n,
+                                                   physics->fourier_buffer_e,
+                                                   physics->phys_buffer_e,
+                                                   physics->comm_x,
+                                                   FFTW_BACKWARD,
+                                                   FFTW_ESTIMATE);
 
-    physics->plan_forward_phi = fftw_mpi_plan_dft_1d(dim_global[0],
-                                                 physics->phys_buffer_phi,
-                                                 physics->fourier_buffer_phi,
-                                                 mpi->comm[0],
-                                                 FFTW_FORWARD,
-                                                 FFTW_ESTIMATE);
-
-    physics->plan_backward_phi = fftw_mpi_plan_dft_1d(dim_global[0],
-                                                  physics->fourier_buffer_phi,
-                                                  physics->phys_buffer_phi,
-                                                  mpi->comm[0],
-                                                  FFTW_BACKWARD,
-                                                  FFTW_ESTIMATE);
+      physics->plan_forward_phi = fftw_mpi_plan_dft(ndims_x, n,
+                                                    physics->phys_buffer_phi,
+                                                    physics->fourier_buffer_phi,
+                                                    physics->comm_x,
+                                                    FFTW_FORWARD,
+                                                    FFTW_ESTIMATE);
+
+      physics->plan_backward_phi = fftw_mpi_plan_dft(ndims_x, n,
+                                                     physics->fourier_buffer_phi,
+                                                     physics->phys_buffer_phi,
+                                                     physics->comm_x,
+                                                     FFTW_BACKWARD,
+                                                     FFTW_ESTIMATE);
+
+    }
 #endif
 #else
   fprintf(stderr,"Error in VlasovInitialize():\n");
@@ -28,6 +28,13 @@
     dmd_num_win_samples    | int          | #DMDROMObject::m_num_window_samples           | INT_MAX
     dmd_dirname            | string       | #DMDROMObject::m_dirname                      | "DMD"
     dmd_write_snapshot_mat | bool         | #DMDROMObject::m_write_snapshot_mat           | false
+    dmd_streaming          | bool         | #DMDROMObject::m_streaming                    | false
+
+    If \b dmd_streaming is true, each DMD is trained incrementally as the samples are taken
+    (see #StreamingDMD), so that the snapshots are not stored: the memory needed is that of
+    a basis of size #DMDROMObject::m_rdim (instead of #DMDROMObject::m_num_window_samples
+    snapshots), and training at the end of a time window does not cost more than a sample.
+    The snapshot matrix is not available, and \b dmd_write_snapshot_mat is ignored.
 
     Note: other keywords in this file may be read by other functions.
 
@@ -44,6 +51,7 @@ DMDROMObject::DMDROMObject( const int     a_vec_size, /*!< vector size */
   m_nproc = a_nproc;
 
   m_dmd.clear();
+  m_sdmd.clear();
   m_dmd_is_trained.clear();
   m_intervals.clear();
   m_vec_size = a_vec_size;
@@ -58,6 +66,7 @@ DMDROMObject::DMDROMObject( const int     a_vec_size, /*!< vector size */
 
   char dirname_c_str[_MAX_STRING_SIZE_] = "DMD";
   char write_snapshot_mat[_MAX_STRING_SIZE_] = "false";
+  char streaming[_MAX_STRING_SIZE_] = "false";
 
   if (!m_rank) {
 
@@ -79,6 +88,8 @@ DMDROMObject::DMDROMObject( const int     a_vec_size, /*!< vector size */
             ferr = fscanf(in,"%s", dirname_c_str); if (ferr != 1) return;
           } else if (std::string(word) == "dmd_write_snapshot_mat") {
             ferr = fscanf(in,"%s", write_snapshot_mat); if (ferr != 1) return;
+          } else if (std::string(word) == "dmd_streaming") {
+            ferr = fscanf(in,"%s", streaming); if (ferr != 1) return;
           }
           if (ferr != 1) return;
         }
@@ -97,6 +108,7 @@ DMDROMObject::DMDROMObject( const int     a_vec_size, /*!< vector size */
     printf("  number of samples per window:   %d\n", m_num_window_samples);
     printf("  directory name for DMD onjects: %s\n", dirname_c_str);
     printf("  write snapshot matrix to file:  %s\n", write_snapshot_mat);
+    printf("  streaming (incremental) DMD:    %s\n", streaming);
     if (m_sim_idx >= 0) {
       printf("  simulation domain:  %d\n", m_sim_idx);
     }
@@ -109,10 +121,13 @@ DMDROMObject::DMDROMObject( const int     a_vec_size, /*!< vector size */
   MPI_Bcast(&m_num_window_samples,1,MPI_INT,0,MPI_COMM_WORLD);
   MPI_Bcast(dirname_c_str,_MAX_STRING_SIZE_,MPI_CHAR,0,MPI_COMM_WORLD);
   MPI_Bcast(write_snapshot_mat,_MAX_STRING_SIZE_,MPI_CHAR,0,MPI_COMM_WORLD);
+  MPI_Bcast(streaming,_MAX_STRING_SIZE_,MPI_CHAR,0,MPI_COMM_WORLD);
 #endif
 
   m_dirname = std::string( dirname_c_str );
   m_write_snapshot_mat = (std::string(write_snapshot_mat) == "true");
+  m_streaming = (std::string(streaming) == "true");
+  if (m_streaming) m_write_snapshot_mat = false;
 
   if (m_num_window_samples <= m_rdim) {
     printf("ERROR:DMDROMObject::DMDROMObject() - m_num_window_samples <= m_rdim!!");
@@ -128,47 +143,57 @@ void DMDROMObject::takeSample(  const CAROM::Vector& a_U, /*!< solution vector *
 {
   if (m_tic == 0) {
 
-    m_dmd.push_back( new CAROM::DMD(m_vec_size, m_dt) );
+    if (m_streaming) m_sdmd.push_back( new StreamingDMD(m_vec_size, m_dt, m_rdim) );
+    else             m_dmd.push_back( new CAROM::DMD(m_vec_size, m_dt) );
     m_dmd_is_trained.push_back(false);
     m_intervals.push_back( Interval(a_time, m_t_final) );
 
     if (!m_rank) {
       printf( "DMDROMObject::takeSample() - creating new DMD object for sim. domain %d, var %d, t=%f (total: %d).\n",
-              m_sim_idx, m_var_idx, m_intervals[m_curr_win].first, m_dmd.size());
+              m_sim_idx, m_var_idx, m_intervals[m_curr_win].first, (int)m_intervals.size());
     }
-    m_dmd[m_curr_win]->takeSample( a_U.getData(), a_time );
+    if (m_streaming) m_sdmd[m_curr_win]->takeSample( a_U.getData(), a_time );
+    else             m_dmd[m_curr_win]->takeSample( a_U.getData(), a_time );
 
   } else {
 
-    m_dmd[m_curr_win]->takeSample( a_U.getData(), a_time );
+    if (m_streaming) m_sdmd[m_curr_win]->takeSample( a_U.getData(), a_time );
+    else             m_dmd[m_curr_win]->takeSample( a_U.getData(), a_time );
 
     if (m_tic%m_num_window_samples == 0) {
 
       m_intervals[m_curr_win].second = a_time;
-      int ncol = m_dmd[m_curr_win]->getSnapshotMatrix()->numColumns();
+      int ncol = ( m_streaming ? m_sdmd[m_curr_win]->numSamples()
+                               : m_dmd[m_curr_win]->getSnapshotMatrix()->numColumns() );
       if (!m_rank) {
         printf( "DMDROMObject::train() - training DMD object %d for sim. domain %d, var %d with %d samples.\n",
                 m_curr_win, m_sim_idx, m_var_idx, ncol );
       }
 
-      if (m_write_snapshot_mat) {
-        char idx_string[_MAX_STRING_SIZE_];
-        sprintf(idx_string, "%04d", m_curr_win);
-        std::string fname_root(m_dirname + "/snapshot_mat_"+std::string(idx_string));
-        m_dmd[m_curr_win]->getSnapshotMatrix()->write(fname_root);
+      if (m_streaming) {
+        m_sdmd[m_curr_win]->train();
+      } else {
+        if (m_write_snapshot_mat) {
+          char idx_string[_MAX_STRING_SIZE_];
+          sprintf(idx_string, "%04d", m_curr_win);
+          std::string fname_root(m_dirname + "/snapshot_mat_"+std::string(idx_string));
+          m_dmd[m_curr_win]->getSnapshotMatrix()->write(fname_root);
+        }
+        m_dmd[m_curr_win]->train(m_rdim);
       }
-      m_dmd[m_curr_win]->train(m_rdim);
       m_dmd_is_trained[m_curr_win] = true;
 
       m_curr_win++;
 
-      m_dmd.push_back( new CAROM::DMD(m_vec_size, m_dt) );
+      if (m_streaming) m_sdmd.push_back( new StreamingDMD(m_vec_size, m_dt, m_rdim) );
+      else             m_dmd.push_back( new CAROM::DMD(m_vec_size, m_dt) );
       m_dmd_is_trained.push_back(false);
       m_intervals.push_back( Interval(a_time, m_t_final) );
-      m_dmd[m_curr_win]->takeSample( a_U.getData(), a_time );
+      if (m_streaming) m_sdmd[m_curr_win]->takeSample( a_U.getData(), a_time );
+      else             m_dmd[m_curr_win]->takeSample( a_U.getData(), a_time );
       if (!m_rank) {
         printf("DMDROMObject::takeSample() - creating new DMD object for sim. domain %d, var %d, t=%f (total: %d).\n",
-               m_sim_idx, m_var_idx, m_intervals[m_curr_win].first, m_dmd.size());
+               m_sim_idx, m_var_idx, m_intervals[m_curr_win].first, (int)m_intervals.size());
       }
     }
 
@@ -183,10 +208,17 @@ void DMDROMObject::train()
 {
   /* make sure the number of columns for the last DMD isn't less than m_rdim */
   {
-    int last_win = m_dmd.size() - 1;
-    int num_columns( m_dmd[last_win]->getSnapshotMatrix()->numColumns() );
+    int last_win = m_intervals.size() - 1;
+    int num_columns( m_streaming ? m_sdmd[last_win]->numSamples()
+                                 : m_dmd[last_win]->getSnapshotMatrix()->numColumns() );
     if (num_columns <= m_rdim) {
-      m_dmd.pop_back();
+      if (m_streaming) {
+        delete m_sdmd[last_win];
+        m_sdmd.pop_back();
+      } else {
+        m_dmd.pop_back();
+      }
+      m_dmd_is_trained.pop_back();
       m_intervals.pop_back();
       m_intervals[m_intervals.size()-1].second = m_t_final;
       if (!m_rank) {
@@ -194,12 +226,23 @@ void DMDROMObject::train()
                m_sim_idx,
                m_var_idx,
                num_columns );
-        printf("(total: %d).\n", m_dmd.size());
+        printf("(total: %d).\n", (int)m_intervals.size());
       }
     }
   }
 
-  if (m_dmd.size() > 0) {
+  if (m_streaming && (m_sdmd.size() > 0)) {
+    for (int i = 0; i < m_sdmd.size(); i++) {
+      if (!m_dmd_is_trained[i]) {
+        if (!m_rank) {
+          printf( "DMDROMObject::train() - training DMD object %d for sim. domain %d, var %d with %d samples.\n",
+                  i, m_sim_idx, m_var_idx, m_sdmd[i]->numSamples() );
+        }
+        m_sdmd[i]->train();
+        m_dmd_is_trained[i] = true;
+      }
+    }
+  } else if (m_dmd.size() > 0) {
     for (int i = 0; i < m_dmd.size(); i++) {
       if (!m_dmd_is_trained[i]) {
         int ncol = m_dmd[i]->getSnapshotMatrix()->numColumns();
@@ -223,6 +266,58 @@ void DMDROMObject::train()
   return;
 }
 
+/*! Compute predictions at several times: the times are grouped by the time window (DMD
+ *  object) they lie in, and the predictions in each window are computed together. For
+ *  streaming DMD objects, this is done by StreamingDMD::predict(const double* const, const int,
+ *  double* const), i.e., with one reconstruction from the basis for all the times; otherwise, the
+ *  DMD object is queried at each time.
+*/
+void DMDROMObject::predict( const std::vector<double>&  a_t,  /*!< times at which to predict solution */
+                            double* const               a_U   /*!< predicted solutions, one after the other */
+                          ) const
+{
+  int k = 0;
+  while (k < a_t.size()) {
+
+    int win = -1;
+    for (int i = 0; i < m_intervals.size(); i++) {
+      if (   (a_t[k] >= m_intervals[i].first)
+          && (  (a_t[k] < m_intervals[i].second) || (m_intervals[i].second < 0)  ) ){
+        win = i;
+        break;
+      }
+    }
+    if (win < 0) {
+      printf("ERROR in DMDROMObject::predict(): m_dmd is of size zero or interval not found!");
+      return;
+    }
+
+    /* consecutive times in the same window */
+    int nt = 1;
+    while (   (k+nt < a_t.size())
+           && (a_t[k+nt] >= m_intervals[win].first)
+           && (  (a_t[k+nt] < m_intervals[win].second) || (m_intervals[win].second < 0)  ) ) {
+      nt++;
+    }
+
+    if (m_streaming) {
+      m_sdmd[win]->predict( a_t.data()+k, nt, a_U+k*m_vec_size );
+    } else {
+      for (int l = k; l < k+nt; l++) {
+        CAROM::Vector* u = m_dmd[win]->predict(a_t[l]);
+        const double* u_data = u->getData();
+        double* U = a_U + l*m_vec_size;
+        for (int i = 0; i < m_vec_size; i++) U[i] = u_data[i];
+        delete u;
+      }
+    }
+
+    k += nt;
+  }
+
+  return;
+}
+
 /*! Save DMD objects to file: the DMD object files will be saved in the subdirectory
  *  with the name #DMDROMObject::m_dirname. They are in a format that libROM can read
  *  from.
@@ -231,6 +326,9 @@ void DMDROMObject::train()
  *  objects will not be written (even though the screen output will claim they were
  *  written)!. The code may not report any error, or one may see HDF5 file writing
  *  errors.
+ *
+ *  Streaming DMD objects (see #StreamingDMD) are written by StreamingDMD::save(), one
+ *  file per MPI rank; they must be loaded on the same number of ranks.
 */
 void DMDROMObject::save(const std::string& a_fname_root /*!< Filename root */) const
 {
@@ -250,17 +348,22 @@ void DMDROMObject::save(const std::string& a_fname_root /*!< Filename root */) c
   if (!m_rank) {
     FILE* out;
     out = fopen(header_fname.c_str(), "w");
-    fprintf(out, "%d\n", m_dmd.size());
-    for (int i = 0; i < m_dmd.size(); i++) {
+    fprintf(out, "%d\n", (int)m_intervals.size());
+    for (int i = 0; i < m_intervals.size(); i++) {
       fprintf(out, "%1.16e %1.16e\n", m_intervals[i].first, m_intervals[i].second);
     }
     fclose(out);
   }
 
-  for (int i = 0; i < m_dmd.size(); i++) {
+  for (int i = 0; i < m_intervals.size(); i++) {
     char idx_string[_MAX_STRING_SIZE_];
     sprintf(idx_string, "%04d", i);
     std::string fname = fname_root + std::string(idx_string);
+    if (m_streaming) {
+      if (!m_rank) printf( "  Saving streaming DMD object (%s).\n", fname.c_str() );
+      m_sdmd[i]->save(fname);
+      continue;
+    }
     std::string summary_fname = summary_fname_root + std::string(idx_string);
     if (!m_rank) {
       printf( "  Saving DMD object and summary (%s, %s).\n",
@@ -326,7 +429,9 @@ void DMDROMObject::load(const std::string& a_fname_root /*!< Filename root */)
               fname.c_str(),
               m_intervals[i].first, m_intervals[i].second );
     }
-    m_dmd.push_back( new CAROM::DMD(fname) );
+    if (m_streaming) m_sdmd.push_back( new StreamingDMD(fname, m_rdim) );
+    else             m_dmd.push_back( new CAROM::DMD(fname) );
+    m_dmd_is_trained.push_back(true);
   }
 
   return;
@@ -0,0 +1,422 @@
+#ifdef with_librom
+
+/*! @file StreamingDMD.cpp
+ *  @brief Member functions of the class #StreamingDMD
+ *  @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include <linalg/Matrix.h>
+#include <rom_streaming_dmd.h>
+
+#ifndef serial
+#include <mpi.h>
+#endif
+
+/*! Relative norm below which a sample is considered to be in the span of the basis */
+#define _STREAMING_DMD_TOL_ 1e-10
+
+/*! Sum an array over all ranks */
+static void StreamingDMDSum(double* const a_x, const int a_n)
+{
+#ifndef serial
+  MPI_Allreduce(MPI_IN_PLACE,a_x,a_n,MPI_DOUBLE,MPI_SUM,MPI_COMM_WORLD);
+#endif
+}
+
+/*! Dominant eigenvectors of a symmetric matrix (row-major, n x n): returns the
+    eigenvectors (n x k, row-major) of the k largest eigenvalues, and the eigenvalues */
+static void StreamingDMDSymmetricEig( const std::vector<double>& a_G,
+                                      const int a_n,
+                                      const int a_k,
+                                      std::vector<double>& a_V,
+                                      std::vector<double>& a_s )
+{
+  CAROM::Matrix G(a_n, a_n, false);
+  for (int i = 0; i < a_n; i++) {
+    for (int j = 0; j < a_n; j++) G.item(i,j) = a_G[i*a_n+j];
+  }
+  CAROM::EigenPair eig = CAROM::SymmetricRightEigenSolve(&G);
+
+  std::vector<int> order(a_n);
+  for (int i = 0; i < a_n; i++) order[i] = i;
+  std::sort(order.begin(), order.end(),
+            [&eig](int a, int b) { return eig.eigs[a] > eig.eigs[b]; });
+
+  a_V.assign(a_n*a_k, 0.0);
+  a_s.assign(a_k, 0.0);
+  for (int j = 0; j < a_k; j++) {
+    a_s[j] = eig.eigs[order[j]];
+    for (int i = 0; i < a_n; i++) a_V[i*a_k+j] = eig.ev->item(i,order[j]);
+  }
+  delete eig.ev;
+}
+
+/*! Solve a complex linear system (row-major, n x n) by Gaussian elimination with
+    partial pivoting; the matrix and right-hand side are overwritten */
+static void StreamingDMDComplexSolve( std::vector< std::complex<double> >& a_M,
+                                      std::vector< std::complex<double> >& a_x,
+                                      const int a_n )
+{
+  for (int k = 0; k < a_n; k++) {
+    int piv = k;
+    for (int i = k+1; i < a_n; i++) {
+      if (std::abs(a_M[i*a_n+k]) > std::abs(a_M[piv*a_n+k])) piv = i;
+    }
+    if (piv != k) {
+      for (int j = 0; j < a_n; j++) std::swap(a_M[k*a_n+j], a_M[piv*a_n+j]);
+      std::swap(a_x[k], a_x[piv]);
+    }
+    if (std::abs(a_M[k*a_n+k]) == 0.0) continue;
+    for (int i = k+1; i < a_n; i++) {
+      std::complex<double> f = a_M[i*a_n+k] / a_M[k*a_n+k];
+      for (int j = k; j < a_n; j++) a_M[i*a_n+j] -= f * a_M[k*a_n+j];
+      a_x[i] -= f * a_x[k];
+    }
+  }
+  for (int k = a_n-1; k >= 0; k--) {
+    for (int j = k+1; j < a_n; j++) a_x[k] -= a_M[k*a_n+j] * a_x[j];
+    if (std::abs(a_M[k*a_n+k]) > 0.0) a_x[k] /= a_M[k*a_n+k];
+  }
+}
+
+/*! Constructor */
+StreamingDMD::StreamingDMD( const int     a_vec_size, /*!< Local vector size */
+                            const double  a_dt,       /*!< Time interval between samples */
+                            const int     a_rdim      /*!< Maximum latent space dimension */ )
+{
+  m_vec_size = a_vec_size;
+  m_dt = a_dt;
+  m_rdim = a_rdim;
+  m_t_offset = 0.0;
+  m_nsamples = 0;
+  m_r = 0;
+  m_prediction = new CAROM::Vector(m_vec_size, true);
+}
+
+/*! Take a sample: update the basis and the projected correlation matrices (see the
+    description of the class #StreamingDMD) */
+void StreamingDMD::takeSample(  const double* const a_u,  /*!< Sampled solution */
+                                const double        a_t   /*!< Sample time */ )
+{
+  int n = m_vec_size;
+
+  if (m_nsamples == 0) {
+    m_t_offset = a_t;
+    double norm = 0;
+    for (int i = 0; i < n; i++) norm += a_u[i]*a_u[i];
+    StreamingDMDSum(&norm,1);
+    norm = sqrt(norm);
+    addBasisVector(a_u, norm);
+    m_x_prev.assign(1, norm);
+    m_nsamples++;
+    return;
+  }
+
+  /* project the sample onto the basis (classical Gram-Schmidt, applied twice) */
+  std::vector<double> e(a_u, a_u+n);
+  std::vector<double> y(m_r+1, 0.0);
+  double norm_u = 0;
+  for (int i = 0; i < n; i++) norm_u += a_u[i]*a_u[i];
+  for (int pass = 0; pass < 2; pass++) {
+    std::vector<double> c(m_r+1, 0.0);
+    for (int j = 0; j < m_r; j++) {
+      const double *q = m_Q.data() + j*n;
+      for (int i = 0; i < n; i++) c[j] += q[i]*e[i];
+    }
+    if (pass == 0) c[m_r] = norm_u;
+    StreamingDMDSum(c.data(),m_r+1);
+    if (pass == 0) norm_u = sqrt(c[m_r]);
+    for (int j = 0; j < m_r; j++) {
+      const double *q = m_Q.data() + j*n;
+      for (int i = 0; i < n; i++) e[i] -= c[j]*q[i];
+      y[j] += c[j];
+    }
+  }
+  double norm_e = 0;
+  for (int i = 0; i < n; i++) norm_e += e[i]*e[i];
+  StreamingDMDSum(&norm_e,1);
+  norm_e = sqrt(norm_e);
+
+  /* new direction */
+  if (norm_e > _STREAMING_DMD_TOL_*norm_u) {
+    addBasisVector(e.data(), norm_e);
+    y[m_r-1] = norm_e;
+    m_x_prev.push_back(0.0);
+  }
+  y.resize(m_r);
+
+  /* update the correlation matrices with the pair (previous sample, this sample) */
+  for (int i = 0; i < m_r; i++) {
+    for (int j = 0; j < m_r; j++) {
+      m_Gx[i*m_r+j] += m_x_prev[i]*m_x_prev[j];
+      m_Gy[i*m_r+j] += y[i]*y[j];
+      m_A [i*m_r+j] += y[i]*m_x_prev[j];
+    }
+  }
+  m_x_prev = y;
+
+  if (m_r > m_rdim) compress();
+
+  m_nsamples++;
+  return;
+}
+
+/*! Append a (not normalized) vector to the basis and pad the correlation matrices with zeros */
+void StreamingDMD::addBasisVector(  const double* const a_v,    /*!< Vector */
+                                    const double        a_norm  /*!< Norm of the vector */ )
+{
+  int n = m_vec_size, r = m_r+1;
+  m_Q.resize(n*r);
+  double *q = m_Q.data() + (r-1)*n;
+  for (int i = 0; i < n; i++) q[i] = (a_norm > 0 ? a_v[i]/a_norm : 0.0);
+
+  std::vector<double> Gx(r*r,0.0), Gy(r*r,0.0), A(r*r,0.0);
+  for (int i = 0; i < m_r; i++) {
+    for (int j = 0; j < m_r; j++) {
+      Gx[i*r+j] = m_Gx[i*m_r+j];
+      Gy[i*r+j] = m_Gy[i*m_r+j];
+      A [i*r+j] = m_A [i*m_r+j];
+    }
+  }
+  m_Gx = Gx; m_Gy = Gy; m_A = A;
+  m_r = r;
+}
+
+/*! Compress the basis to the #StreamingDMD::m_rdim dominant eigenvectors \f${\bf V}\f$ of
+    \f${\bf G}_x+{\bf G}_y\f$: \f${\bf Q} \leftarrow {\bf Q}{\bf V}\f$, and the correlation matrices
+    and the projection of the previous sample are transformed accordingly */
+void StreamingDMD::compress()
+{
+  int n = m_vec_size, r = m_r, k = m_rdim;
+
+  std::vector<double> G(r*r), V, s;
+  for (int i = 0; i < r*r; i++) G[i] = m_Gx[i] + m_Gy[i];
+  StreamingDMDSymmetricEig(G, r, k, V, s);
+
+  /* Q <- Q V */
+  std::vector<double> Q(n*k, 0.0), row(r);
+  for (int i = 0; i < n; i++) {
+    for (int l = 0; l < r; l++) row[l] = m_Q[l*n+i];
+    for (int j = 0; j < k; j++) {
+      double sum = 0;
+      for (int l = 0; l < r; l++) sum += row[l]*V[l*k+j];
+      Q[j*n+i] = sum;
+    }
+  }
+  m_Q = Q;
+
+  /* M <- V^T M V */
+  std::vector<double> *mats[3] = {&m_Gx, &m_Gy, &m_A};
+  for (int m = 0; m < 3; m++) {
+    std::vector<double>& M = *mats[m];
+    std::vector<double> MV(r*k, 0.0), VtMV(k*k, 0.0);
+    for (int i = 0; i < r; i++) {
+      for (int j = 0; j < k; j++) {
+        for (int l = 0; l < r; l++) MV[i*k+j] += M[i*r+l]*V[l*k+j];
+      }
+    }
+    for (int i = 0; i < k; i++) {
+      for (int j = 0; j < k; j++) {
+        for (int l = 0; l < r; l++) VtMV[i*k+j] += V[l*k+i]*MV[l*k+j];
+      }
+    }
+    M = VtMV;
+  }
+
+  std::vector<double> x(k, 0.0);
+  for (int j = 0; j < k; j++) {
+    for (int l = 0; l < r; l++) x[j] += V[l*k+j]*m_x_prev[l];
+  }
+  m_x_prev = x;
+
+  m_r = k;
+}
+
+/*! Train: compute the eigendecomposition of the reduced operator
+    \f$\tilde{\bf K} = {\bf A}{\bf G}_x^{+}\f$ (see the description of the class #StreamingDMD).
+    The cost does not depend on the vector size or on the number of samples. */
+void StreamingDMD::train()
+{
+  int r = m_r;
+
+  /* pseudo-inverse of Gx */
+  std::vector<double> V, s;
+  StreamingDMDSymmetricEig(m_Gx, r, r, V, s);
+  std::vector<double> Gx_inv(r*r, 0.0);
+  double s_max = (r > 0 ? s[0] : 0.0);
+  for (int l = 0; l < r; l++) {
+    if (s[l] <= _STREAMING_DMD_TOL_*s_max) continue;
+    for (int i = 0; i < r; i++) {
+      for (int j = 0; j < r; j++) Gx_inv[i*r+j] += V[i*r+l]*V[j*r+l]/s[l];
+    }
+  }
+
+  CAROM::Matrix K(r, r, false);
+  for (int i = 0; i < r; i++) {
+    for (int j = 0; j < r; j++) {
+      double sum = 0;
+      for (int l = 0; l < r; l++) sum += m_A[i*r+l]*Gx_inv[l*r+j];
+      K.item(i,j) = sum;
+    }
+  }
+
+  CAROM::ComplexEigenPair eig = CAROM::NonSymmetricRightEigenSolve(&K);
+  m_eigs = eig.eigs;
+  m_W.resize(r*r);
+  for (int i = 0; i < r; i++) {
+    for (int j = 0; j < r; j++) {
+      m_W[i*r+j] = std::complex<double>(eig.ev_real->item(i,j), eig.ev_imaginary->item(i,j));
+    }
+  }
+  delete eig.ev_real;
+  delete eig.ev_imaginary;
+
+  /* the correlation matrices are not needed anymore */
+  m_Gx.clear(); m_Gy.clear(); m_A.clear(); m_x_prev.clear();
+  return;
+}
+
+/*! Project an initial condition onto the DMD modes: since the modes are \f${\bf Q}{\bf W}\f$
+    with an orthonormal \f${\bf Q}\f$, the coefficients are \f${\bf b} = {\bf W}^{-1}{\bf Q}^T{\bf u}_0\f$. */
+void StreamingDMD::projectInitialCondition(const CAROM::Vector* const a_U /*!< Initial condition */)
+{
+  int n = m_vec_size, r = m_r;
+  const double *u = a_U->getData();
+
+  std::vector<double> c(r, 0.0);
+  for (int j = 0; j < r; j++) {
+    const double *q = m_Q.data() + j*n;
+    for (int i = 0; i < n; i++) c[j] += q[i]*u[i];
+  }
+  StreamingDMDSum(c.data(),r);
+
+  std::vector< std::complex<double> > W(m_W);
+  m_b.resize(r);
+  for (int j = 0; j < r; j++) m_b[j] = c[j];
+  StreamingDMDComplexSolve(W, m_b, r);
+  return;
+}
+
+/*! Compute the prediction at a given time:
+    \f${\bf u}(t) = {\rm Re}\left[{\bf Q}{\bf W}\Lambda^{(t-t_0)/\Delta t}{\bf b}\right]\f$;
+    the returned vector is owned by this object and is overwritten by the next prediction. */
+const CAROM::Vector* StreamingDMD::predict(const double a_t /*!< Time */) const
+{
+  predict(&a_t, 1, m_prediction->getData());
+  return m_prediction;
+}
+
+/*! Compute the predictions at several times (see StreamingDMD::predict(const double)):
+    the reduced solutions at all the times are computed first, and the full-order solutions
+    are then reconstructed together, i.e., as the product of the basis with the matrix of
+    reduced solutions. This product is blocked along the rows of the basis, so that the basis
+    is read from memory once for all the times. */
+void StreamingDMD::predict( const double* const a_t,  /*!< Times */
+                            const int           a_nt, /*!< Number of times */
+                            double* const       a_U   /*!< Predicted solutions (one after the other) */
+                          ) const
+{
+  int n = m_vec_size, r = m_r;
+
+  /* reduced solutions */
+  std::vector<double> z(a_nt*r, 0.0);
+  std::vector< std::complex<double> > c(r);
+  for (int t = 0; t < a_nt; t++) {
+    double k = (a_t[t] - m_t_offset) / m_dt;
+    for (int j = 0; j < r; j++) c[j] = m_b[j] * std::exp(std::log(m_eigs[j]) * k);
+    for (int i = 0; i < r; i++) {
+      std::complex<double> sum = 0.0;
+      for (int j = 0; j < r; j++) sum += m_W[i*r+j] * c[j];
+      z[t*r+i] = sum.real();
+    }
+  }
+
+  /* full-order solutions */
+  const int block = 512;
+  for (int i0 = 0; i0 < n; i0 += block) {
+    int i1 = std::min(i0+block, n);
+    for (int t = 0; t < a_nt; t++) {
+      double *u = a_U + t*n;
+      for (int i = i0; i < i1; i++) u[i] = 0.0;
+      for (int j = 0; j < r; j++) {
+        const double *q = m_Q.data() + j*n;
+        double zj = z[t*r+j];
+        for (int i = i0; i < i1; i++) u[i] += zj*q[i];
+      }
+    }
+  }
+  return;
+}
+
+/*! Save to file: each rank writes its part of the basis, along with the reduced
+    eigendecomposition, to the binary file <filename root>_<rank>. */
+void StreamingDMD::save(const std::string& a_fname_root /*!< Filename root */) const
+{
+  int rank = 0;
+#ifndef serial
+  MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+#endif
+  char fname[1000];
+  sprintf(fname, "%s_%05d", a_fname_root.c_str(), rank);
+  FILE *out = fopen(fname, "wb");
+  if (!out) {
+    fprintf(stderr,"Error in StreamingDMD::save(): unable to open %s for writing.\n", fname);
+    return;
+  }
+  int sizes[2] = {m_vec_size, m_r};
+  double params[2] = {m_dt, m_t_offset};
+  fwrite(sizes, sizeof(int), 2, out);
+  fwrite(params, sizeof(double), 2, out);
+  fwrite(m_eigs.data(), sizeof(std::complex<double>), m_r, out);
+  fwrite(m_W.data(), sizeof(std::complex<double>), m_r*m_r, out);
+  fwrite(m_Q.data(), sizeof(double), m_vec_size*m_r, out);
+  fclose(out);
+}
+
+/*! Constructor (load from file written by StreamingDMD::save()) */
+StreamingDMD::StreamingDMD( const std::string&  a_fname_root, /*!< Filename root */
+                            const int           a_rdim        /*!< Maximum latent space dimension */ )
+{
+  int rank = 0;
+#ifndef serial
+  MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+#endif
+  m_vec_size = 0;
+  m_dt = 1.0;
+  m_rdim = a_rdim;
+  m_t_offset = 0.0;
+  m_nsamples = 0;
+  m_r = 0;
+
+  char fname[1000];
+  sprintf(fname, "%s_%05d", a_fname_root.c_str(), rank);
+  FILE *in = fopen(fname, "rb");
+  if (!in) {
+    fprintf(stderr,"Error in StreamingDMD::StreamingDMD(): unable to open %s for reading.\n", fname);
+  } else {
+    int sizes[2];
+    double params[2];
+    size_t nread = fread(sizes, sizeof(int), 2, in);
+    nread += fread(params, sizeof(double), 2, in);
+    m_vec_size = sizes[0];
+    m_r = sizes[1];
+    m_dt = params[0];
+    m_t_offset = params[1];
+    m_eigs.resize(m_r);
+    m_W.resize(m_r*m_r);
+    m_Q.resize(m_vec_size*m_r);
+    nread += fread(m_eigs.data(), sizeof(std::complex<double>), m_r, in);
+    nread += fread(m_W.data(), sizeof(std::complex<double>), m_r*m_r, in);
+    nread += fread(m_Q.data(), sizeof(double), m_vec_size*m_r, in);
+    if (nread != (size_t)(4 + m_r + m_r*m_r + m_vec_size*m_r)) {
+      fprintf(stderr,"Error in StreamingDMD::StreamingDMD(): %s is incomplete.\n", fname);
+    }
+    fclose(in);
+  }
+  m_prediction = new CAROM::Vector(m_vec_size, true);
+}
+
+#endif
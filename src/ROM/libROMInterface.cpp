@@ -33,6 +33,7 @@
     component_mode     | string       | #libROMInterface::m_comp_mode                 | "monolithic"
     type               | string       | #libROMInterface::m_rom_type                  | "DMD"
     save_to_file       | string       | #libROMInterface::m_save_ROM                  | "true"
+    predict_batch_size | int          | #libROMInterface::m_predict_batch_size        | 32
 
     Note: other keywords in this file may be read by other functions. The default value for \a rdim is invalid, so it \b must be specified.
 
@@ -68,6 +69,7 @@ void libROMInterface::define( void*   a_s, /*!< Array of simulation objects of t
 
       m_rdim = -1;
       m_sampling_freq = 1;
+      m_predict_batch_size = 32;
 
     } else {
 
@@ -75,6 +77,7 @@ void libROMInterface::define( void*   a_s, /*!< Array of simulation objects of t
       strcpy( comp_mode_c_str, _ROM_COMP_MODE_MONOLITHIC_ );
       strcpy( type_c_str,_ROM_TYPE_DMD_ );
       strcpy( save_c_str, "true" );
+      m_predict_batch_size = 32;
 
       int ferr;
       char word[_MAX_STRING_SIZE_];
@@ -95,6 +98,8 @@ void libROMInterface::define( void*   a_s, /*!< Array of simulation objects of t
             ferr = fscanf(in,"%s", type_c_str); if (ferr != 1) return;
           } else if (std::string(word) == "save_to_file") {
             ferr = fscanf(in,"%s", save_c_str); if (ferr != 1) return;
+          } else if (std::string(word) == "predict_batch_size") {
+            ferr = fscanf(in,"%d", &m_predict_batch_size); if (ferr != 1) return;
           }
           if (ferr != 1) return;
         }
@@ -117,6 +122,7 @@ void libROMInterface::define( void*   a_s, /*!< Array of simulation objects of t
       printf("  component mode: %s\n", comp_mode_c_str);
       printf("  type: %s\n", type_c_str);
       printf("  save to file: %s\n", save_c_str);
+      printf("  prediction batch size: %d\n", m_predict_batch_size);
     }
   }
 
@@ -127,7 +133,9 @@ void libROMInterface::define( void*   a_s, /*!< Array of simulation objects of t
   MPI_Bcast(comp_mode_c_str,_MAX_STRING_SIZE_,MPI_CHAR,0,MPI_COMM_WORLD);
   MPI_Bcast(type_c_str,_MAX_STRING_SIZE_,MPI_CHAR,0,MPI_COMM_WORLD);
   MPI_Bcast(save_c_str,_MAX_STRING_SIZE_,MPI_CHAR,0,MPI_COMM_WORLD);
+  MPI_Bcast(&m_predict_batch_size,1,MPI_INT,0,MPI_COMM_WORLD);
 #endif
+  if (m_predict_batch_size < 1) m_predict_batch_size = 1;
 
   m_mode = std::string( mode_c_str );
   m_comp_mode = std::string( comp_mode_c_str );
@@ -314,6 +322,98 @@ void libROMInterface::predict(void*  a_s, /*!< Array of simulation objects of ty
 #endif
 }
 
+/*! Predict the solution at several times: the predictions of each ROM object at all the
+    times are computed with one call to ROMObject::predict(const std::vector<double>&, double* const)
+    and stored (#libROMInterface::m_U_batch); they are copied to HyPar, one time at a time,
+    by libROMInterface::copyPredictionToHyPar(). The number of times should not exceed
+    #libROMInterface::m_predict_batch_size, which bounds the memory needed for the predictions. */
+void libROMInterface::predict(void*  a_s, /*!< Array of simulation objects of type #SimulationObject */
+                              const std::vector<double>& a_t  /*!< times at which to predict solution */)
+{
+  m_predict_wctime = 0.0;
+
+  if (m_U_batch.size() != m_rom.size()) m_U_batch.resize(m_rom.size());
+
+  gettimeofday(&m_predict_start, NULL);
+  int count(0);
+  for (int ns = 0; ns < m_nsims; ns++) {
+    int nrom = (m_comp_mode == _ROM_COMP_MODE_COMPONENTWISE_ ? m_ncomps[ns] : 1);
+    for (int v = 0; v < nrom; v++) {
+      if (m_U_batch[count].size() < a_t.size()*m_vec_size[ns]) {
+        m_U_batch[count].resize(a_t.size()*m_vec_size[ns]);
+      }
+      m_rom[count]->predict( a_t, m_U_batch[count].data() );
+      count++;
+    }
+  }
+  gettimeofday(&m_predict_end, NULL);
+
+  long long walltime;
+  walltime = (  (m_predict_end.tv_sec*1000000 + m_predict_end.tv_usec)
+              - (m_predict_start.tv_sec*1000000 + m_predict_start.tv_usec) );
+  m_predict_wctime += (double) walltime / 1000000.0;
+
+#ifndef serial
+  MPI_Allreduce(  MPI_IN_PLACE,
+                  &m_predict_wctime,
+                  1,
+                  MPI_DOUBLE,
+                  MPI_MAX,
+                  MPI_COMM_WORLD );
+#endif
+}
+
+/*! Copy the prediction at one of the times of the last call to libROMInterface::predict(void*,
+    const std::vector<double>&) to HyPar (see libROMInterface::copyToHyPar() for the destination).
+    For component-wise ROMs, all the components are copied in one pass over the grid. */
+void libROMInterface::copyPredictionToHyPar(void* a_s,  /*!< Array of simulation objects of
+                                                             type #SimulationObject */
+                                            int   a_k   /*!< Index of the time */ ) const
+{
+  SimulationObject* sim = (SimulationObject*) a_s;
+
+  int count(0);
+  for (int ns = 0; ns < m_nsims; ns++) {
+
+    HyPar* solver = &(sim[ns].solver);
+    double* u = (m_mode == _ROM_MODE_TRAIN_ ? solver->u_rom_predicted : solver->u);
+    std::vector<int> index(solver->ndims);
+
+    if (m_comp_mode == _ROM_COMP_MODE_MONOLITHIC_) {
+
+      ArrayCopynD(  solver->ndims,
+                    m_U_batch[count].data() + a_k*m_vec_size[ns],
+                    u,
+                    solver->dim_local,
+                    0,
+                    solver->ghosts,
+                    index.data(),
+                    solver->nvars );
+      count++;
+
+    } else if (m_comp_mode == _ROM_COMP_MODE_COMPONENTWISE_) {
+
+      int nvars = solver->nvars;
+      std::vector<const double*> vec(nvars);
+      for (int v = 0; v < nvars; v++) {
+        vec[v] = m_U_batch[count+v].data() + a_k*m_vec_size[ns];
+      }
+
+      int done = 0; _ArraySetValue_(index.data(),solver->ndims,0);
+      while (!done) {
+        int p1; _ArrayIndex1D_(solver->ndims,solver->dim_local,index.data(),0,p1);
+        int p2; _ArrayIndex1D_(solver->ndims,solver->dim_local,index.data(),solver->ghosts,p2);
+        for (int v = 0; v < nvars; v++) u[p2*nvars+v] = vec[v][p1];
+        _ArrayIncrementIndex_(solver->ndims,solver->dim_local,index.data(),done);
+      }
+      count += nvars;
+
+    }
+  }
+
+  return;
+}
+
 /*! Save ROM object to file */
 void libROMInterface::saveROM(const std::string& a_fname_root /*!< filename root */) const
 {
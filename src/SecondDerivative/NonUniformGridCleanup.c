@@ -0,0 +1,20 @@
+/*! @file NonUniformGridCleanup.c
+    @brief Cleans up the finite-difference coefficients on a non-uniform grid
+    @author Debojyoti Ghosh
+*/
+
+#include <stdlib.h>
+#include <secondderivative.h>
+
+/*!
+    Cleans up all allocations of the finite-difference coefficients on a non-uniform grid.
+*/
+int NonUniformGridCleanup(void *s /*!< Object of type #NonUniformGrid */ )
+{
+  NonUniformGrid *nu = (NonUniformGrid*) s;
+
+  if (nu->offset) free(nu->offset);
+  if (nu->coeffs) free(nu->coeffs);
+
+  return(0);
+}
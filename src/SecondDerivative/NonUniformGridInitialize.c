@@ -0,0 +1,89 @@
+/*! @file NonUniformGridInitialize.c
+    @brief Compute the finite-difference coefficients on a non-uniform grid
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <basic.h>
+#include <mathfunctions.h>
+#include <secondderivative.h>
+#include <mpivars.h>
+#include <hypar.h>
+
+/*!
+  Compute the coefficients of the finite-difference approximation to the second derivative
+  (#HyPar::SecondDerivativePar, which must have been set) on a non-uniform grid (#NonUniformGrid)
+  from the grid (#HyPar::x) and the grid spacing (#HyPar::dxinv), including their ghost values.
+  At each interior grid point, the coefficients are the weights of the approximation to the second
+  derivative on the points of the stencil of the uniform-grid scheme (computed by FornbergWeights()),
+  multiplied by the square of the grid spacing at that point. With the 3-point stencil
+  (#_SECOND_ORDER_CENTRAL_), the approximation is second-order accurate on a smoothly stretched grid;
+  with the 5-point stencil (#_FOURTH_ORDER_CENTRAL_), it is third-order accurate on any grid and
+  fourth-order accurate on a smoothly stretched grid.
+
+  The conservative parabolic discretization (#HyPar::InterpolateInterfacesPar) is not available
+  on a non-uniform grid.
+*/
+int NonUniformGridInitialize(
+                              void *s, /*!< Solver object of type #HyPar */
+                              void *m  /*!< MPI object of type #MPIVariables */
+                            )
+{
+  HyPar           *solver = (HyPar*)          s;
+  NonUniformGrid  *nu     = (NonUniformGrid*) solver->nonuniform;
+
+  int ndims  = solver->ndims;
+  int ghosts = solver->ghosts;
+  int *dim   = solver->dim_local;
+  int d, i, j;
+
+  if (solver->InterpolateInterfacesPar) {
+    fprintf(stderr,"Error in NonUniformGridInitialize(): parabolic discretization type %s is not available on a non-uniform grid.\n",
+            solver->spatial_type_par);
+    return(1);
+  }
+
+  nu->offset = (int*) calloc (ndims,sizeof(int));
+  nu->width  = 0;
+  nu->coeffs = NULL;
+
+  int size = 0;
+  for (d = 0; d < ndims; d++) {
+    nu->offset[d] = size;
+    size += dim[d];
+  }
+
+  if (solver->SecondDerivativePar == SecondDerivativeSecondOrderCentral) {
+    nu->width = 3;
+  } else if (solver->SecondDerivativePar == SecondDerivativeFourthOrderCentral) {
+    nu->width = 5;
+  } else {
+    return(0);
+  }
+  if (ghosts < nu->width/2) {
+    fprintf(stderr,"Error in NonUniformGridInitialize(): the second derivative needs at least %d ghost points.\n",
+            nu->width/2);
+    return(1);
+  }
+
+  int    width = nu->width;
+  double xs[width], weights[3*width];
+  nu->coeffs = (double*) calloc (size*width,sizeof(double));
+
+  int offset = 0;
+  for (d = 0; d < ndims; d++) {
+    double *x     = solver->x     + offset + ghosts;
+    double *dxinv = solver->dxinv + offset + ghosts;
+    for (i = 0; i < dim[d]; i++) {
+      double h = 1.0 / dxinv[i];
+      for (j = 0; j < width; j++) xs[j] = x[i-width/2+j] - x[i];
+      FornbergWeights(0.0,xs,width,2,weights);
+      for (j = 0; j < width; j++) nu->coeffs[(nu->offset[d]+i)*width+j] = weights[2*width+j] * h * h;
+    }
+    offset += (dim[d] + 2*ghosts);
+  }
+
+  return(0);
+}
@@ -0,0 +1,86 @@
+/*! @file SecondDerivativeNonUniform.c
+    @brief Discretization of the second derivative on a non-uniform grid.
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <basic.h>
+#include <arrayfunctions.h>
+#include <secondderivative.h>
+#include <mpivars.h>
+#include <hypar.h>
+
+/*! Computes the finite-difference approximation to the second derivative on a non-uniform grid
+    (\b Note: not divided by the square of the grid spacing, i.e., multiplied by 1/#HyPar::dxinv^2
+    at each point):
+    \f{equation}{
+      \left(\partial^2 f\right)_i = \sum_{k=0}^{w-1} c_{i,k} f_{i+s_i+k},
+    \f}
+    where the coefficients \f$c_{i,k}\f$ are precomputed by NonUniformGridInitialize() (#NonUniformGrid::coeffs),
+    and the centered stencil of width \f$w\f$ (with \f$s = -w/2\f$) is that of the uniform-grid scheme
+    that this function replaces (SecondDerivativeSecondOrderCentral() or SecondDerivativeFourthOrderCentral()).
+
+    \b Notes:
+    + The second derivative is computed at the grid points or the cell centers.
+    + Though the array D2f includes ghost points, the second derivative is \b not computed at these
+      locations. Thus, array elements corresponding to the ghost points contain undefined values.
+    + \a D2f and \a f are 1D arrays containing the function and its computed derivatives on a multi-
+      dimensional grid. The derivative along the specified dimension \b dir is computed by looping
+      through all grid lines along \b dir.
+*/
+int SecondDerivativeNonUniform(
+                                double  *D2f, /*!< Array to hold the computed second derivative (with ghost points)
+                                                   (same size and layout as f) */
+                                double  *f,   /*!< Array containing the grid point function values whose first
+                                                   derivative is to be computed (with ghost points) */
+                                int     dir,  /*!< The spatial dimension along which the derivative is computed */
+                                void    *s,   /*!< Solver object of type #HyPar */
+                                void    *m    /*!< MPI object of type #MPIVariables */
+                              )
+{
+  HyPar           *solver = (HyPar*) s;
+  NonUniformGrid  *nu     = (NonUniformGrid*) solver->nonuniform;
+  int             i, k, v;
+
+  int ghosts = solver->ghosts;
+  int ndims  = solver->ndims;
+  int nvars  = solver->nvars;
+  int *dim   = solver->dim_local;
+  int *stride= solver->stride_with_ghosts;
+
+  if ((!D2f) || (!f)) {
+    fprintf(stderr, "Error in SecondDerivativeNonUniform(): input arrays not allocated.\n");
+    return(1);
+  }
+  if ((!nu) || (!nu->coeffs)) {
+    fprintf(stderr, "Error in SecondDerivativeNonUniform(): coefficients not computed.\n");
+    return(1);
+  }
+
+  int    width = nu->width;
+  double *coeff = nu->coeffs + nu->offset[dir]*width;
+
+  /* create index and bounds for the outer loop, i.e., to loop over all 1D lines along
+     dimension "dir"                                                                    */
+  int indexC[ndims], index_outer[ndims], bounds_outer[ndims];
+  _ArrayCopy1D_(dim,bounds_outer,ndims); bounds_outer[dir] =  1;
+
+  int done = 0; _ArraySetValue_(index_outer,ndims,0);
+  while (!done) {
+    _ArrayCopy1D_(index_outer,indexC,ndims);
+    for (i = 0; i < dim[dir]; i++) {
+      int qC, q0;
+      double *c = coeff + i*width;
+      indexC[dir] = i; _ArrayIndex1D_(ndims,dim,indexC,ghosts,qC);
+      q0 = qC - (width/2)*stride[dir];
+      for (v=0; v<nvars; v++) D2f[qC*nvars+v] = 0;
+      for (k=0; k<width; k++) {
+        for (v=0; v<nvars; v++) D2f[qC*nvars+v] += c[k] * f[(q0+k*stride[dir])*nvars+v];
+      }
+    }
+    _ArrayIncrementIndex_(ndims,bounds_outer,index_outer,done);
+  }
+
+  return(0);
+}
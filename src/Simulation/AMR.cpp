@@ -0,0 +1,720 @@
+/*! @file AMR.cpp
+    @author Debojyoti Ghosh
+    @brief Block-structured adaptive mesh refinement: time integration of the patches
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <basic.h>
+#include <arrayfunctions.h>
+#include <common_cpp.h>
+#include <mpivars_cpp.h>
+#include <timeintegration_cpp.h>
+#include <simulation.h>
+#include <amr.h>
+
+/*! Apply the physical boundary conditions */
+extern "C" int ApplyBoundaryConditions(void*,void*,double*,double*,double);
+int OutputSolution(void*,int,double); /*!< Write solutions to file */
+
+/*! Create a flux register with a given number of faces: the faces are not on this rank
+    (#FluxRegister::index is -1) until they are set by the caller. */
+int FluxRegisterCreate( FluxRegister  *reg,     /*!< Flux register */
+                        int           nfaces,   /*!< Number of faces */
+                        int           nvars     /*!< Number of vector components of the flux */
+                      )
+{
+  int n = std::max(nfaces,1);
+  reg->nfaces = nfaces;
+  reg->nvars  = nvars;
+  reg->dir    = (int*)    calloc (n,sizeof(int));
+  reg->side   = (int*)    calloc (n,sizeof(int));
+  reg->index  = (int*)    calloc (n,sizeof(int));
+  reg->cell   = (long*)   calloc (n,sizeof(long));
+  reg->weight = (double*) calloc (n,sizeof(double));
+  reg->stage  = (double*) calloc (n*nvars,sizeof(double));
+  reg->step   = (double*) calloc (n*nvars,sizeof(double));
+  for (int k = 0; k < nfaces; k++) reg->index[k] = -1;
+  return(0);
+}
+
+/*! Delete a flux register (the structure itself is not freed) */
+int FluxRegisterCleanup(FluxRegister *reg /*!< Flux register */)
+{
+  free(reg->dir);
+  free(reg->side);
+  free(reg->index);
+  free(reg->cell);
+  free(reg->weight);
+  free(reg->stage);
+  free(reg->step);
+  return(0);
+}
+
+/*! Delete the data of an AMR patch (the structure itself is not freed) */
+int AMRPatchCleanup(AMRPatch *patch /*!< AMR patch */)
+{
+  free(patch->lo);
+  free(patch->hi);
+  free(patch->cf);
+  if (patch->gindex) free(patch->gindex);
+  if (patch->u_old)  free(patch->u_old);
+  if (patch->u_new)  free(patch->u_new);
+  return(0);
+}
+
+/*! Read the AMR inputs from \b amr.inp (see amr.h) on rank 0, and broadcast them to all
+    the ranks. \a found is set to 1 if the file exists, and to 0 otherwise. */
+static int AMRReadInputs( AMRObject     *amr,   /*!< AMR object */
+                          int           *found, /*!< Does amr.inp exist? */
+                          MPIVariables  *mpi    /*!< MPI object of the simulation */
+                        )
+{
+  int status = 0;
+
+  amr->regrid_iter    = 10;
+  amr->tag_threshold  = 0.05;
+  amr->tag_var        = 0;
+  amr->buffer         = 2;
+  amr->efficiency     = 0.7;
+  *found = 0;
+
+  if (!mpi->rank) {
+    char filename[_MAX_STRING_SIZE_] = "amr.inp";
+    FILE *in = fopen(filename,"r");
+    if (in) {
+      char word[_MAX_STRING_SIZE_];
+      int  ferr;
+      *found = 1;
+      printf("Reading adaptive mesh refinement inputs from %s.\n", filename);
+      ferr = fscanf(in,"%s",word);
+      if ((ferr != 1) || strcmp(word,"begin")) {
+        fprintf(stderr,"Error: Illegal format in file \"%s\".\n",filename);
+        status = 1;
+      }
+      while (!status) {
+        ferr = fscanf(in,"%s",word);
+        if (ferr != 1) {
+          fprintf(stderr,"Error: Illegal format in file \"%s\" (missing \"end\").\n",filename);
+          status = 1;
+        } else if (!strcmp(word,"end")) {
+          break;
+        } else if (!strcmp(word,"regrid_iter")) {
+          if (fscanf(in,"%d",&amr->regrid_iter) != 1) status = 1;
+        } else if (!strcmp(word,"tag_threshold")) {
+          if (fscanf(in,"%lf",&amr->tag_threshold) != 1) status = 1;
+        } else if (!strcmp(word,"tag_var")) {
+          if (fscanf(in,"%d",&amr->tag_var) != 1) status = 1;
+        } else if (!strcmp(word,"buffer")) {
+          if (fscanf(in,"%d",&amr->buffer) != 1) status = 1;
+        } else if (!strcmp(word,"efficiency")) {
+          if (fscanf(in,"%lf",&amr->efficiency) != 1) status = 1;
+        } else {
+          fprintf(stderr,"Warning: keyword \"%s\" in file \"%s\" not recognized or extraneous. Ignoring.\n",
+                  word, filename);
+        }
+        if (status && strcmp(word,"end")) {
+          fprintf(stderr,"Error: missing value of \"%s\" in file \"%s\".\n",word,filename);
+        }
+      }
+      fclose(in);
+    }
+  }
+
+  MPIBroadcast_integer(&status,1,0,&mpi->world);
+  if (status) return(1);
+  MPIBroadcast_integer(found,1,0,&mpi->world);
+  MPIBroadcast_integer(&amr->regrid_iter,1,0,&mpi->world);
+  MPIBroadcast_double (&amr->tag_threshold,1,0,&mpi->world);
+  MPIBroadcast_integer(&amr->tag_var,1,0,&mpi->world);
+  MPIBroadcast_integer(&amr->buffer,1,0,&mpi->world);
+  MPIBroadcast_double (&amr->efficiency,1,0,&mpi->world);
+  return(0);
+}
+
+/*!
+  Initialize the block-structured adaptive mesh refinement (see amr.h), if \b amr.inp exists:
+  read the inputs, check that the simulation is supported, compute the global grid of the
+  simulation, and create the initial patches (see AMRRegrid()). This function must be called
+  after the time integration object of the simulation has been initialized (TimeInitialize()).
+  If \b amr.inp does not exist, the AMR object is NULL, and all the other AMR functions do nothing.
+*/
+int AMRInitialize(void  *s,     /*!< Array of simulation objects of type #SimulationObject */
+                  int   nsims,  /*!< Number of simulation objects */
+                  void  *ts,    /*!< Time integration object of type #TimeIntegration */
+                  void  **a     /*!< The AMR object of type #AMRObject (NULL if there is no AMR) */
+                 )
+{
+  SimulationObject  *sim    = (SimulationObject*) s;
+  HyPar             *solver = &(sim[0].solver);
+  MPIVariables      *mpi    = &(sim[0].mpi);
+  int               ndims   = solver->ndims;
+
+  *a = NULL;
+
+  AMRObject *amr = (AMRObject*) calloc (1,sizeof(AMRObject));
+  int found = 0;
+  if (AMRReadInputs(amr,&found,mpi)) {
+    free(amr);
+    return(1);
+  }
+  if (!found) {
+    free(amr);
+    return(0);
+  }
+
+  /* supported simulations */
+  const char *unsupported = NULL;
+  if (nsims > 1) {
+    unsupported = "more than one simulation domain";
+  } else if (strcmp(solver->time_scheme,_RK_) && strcmp(solver->time_scheme,_FORWARD_EULER_)) {
+    unsupported = "time integration methods other than explicit Runge-Kutta and forward Euler";
+  } else if (!strcmp(solver->nonuniform_grid,"yes")) {
+    unsupported = "non-uniform grids";
+  } else if (solver->flag_ib) {
+    unsupported = "immersed bodies";
+  } else if (solver->local_dt_cfl > 0) {
+    unsupported = "local time stepping";
+  } else if (solver->PhysicsInput) {
+    unsupported = "physics-specific input data";
+#if defined(HAVE_CUDA)
+  } else if (solver->use_gpu) {
+    unsupported = "GPUs";
+#endif
+  }
+  if (unsupported) {
+    if (!mpi->rank) {
+      fprintf(stderr,"Error in AMRInitialize(): adaptive mesh refinement is not available with %s.\n",
+              unsupported);
+    }
+    free(amr);
+    return(1);
+  }
+  if (    (amr->regrid_iter < 1)
+      ||  (amr->tag_var < 0) || (amr->tag_var >= solver->nvars)
+      ||  (amr->buffer < 0)
+      ||  (amr->efficiency <= 0) || (amr->efficiency > 1) ) {
+    if (!mpi->rank) {
+      fprintf(stderr,"Error in AMRInitialize(): invalid inputs (regrid_iter must be positive, tag_var must be\n");
+      fprintf(stderr,"  a solution component, buffer must be non-negative, and efficiency must be in (0,1]).\n");
+    }
+    free(amr);
+    return(1);
+  }
+
+  amr->sim        = sim;
+  amr->ts         = ts;
+  amr->npatches   = 0;
+  amr->patches    = NULL;
+  amr->ts_patches = NULL;
+
+  /* global grid and inverse grid spacing of the simulation: the local arrays are summed
+     along the grid lines of ranks */
+  amr->xg     = (double**) calloc (ndims,sizeof(double*));
+  amr->dxinvg = (double**) calloc (ndims,sizeof(double*));
+  int offset = 0;
+  for (int d = 0; d < ndims; d++) {
+    int     n   = solver->dim_global[d];
+    double  *xl = (double*) calloc (2*n,sizeof(double));
+    double  *xg = (double*) calloc (2*n,sizeof(double));
+    for (int i = 0; i < solver->dim_local[d]; i++) {
+      xl[  mpi->is[d]+i] = solver->x    [offset+solver->ghosts+i];
+      xl[n+mpi->is[d]+i] = solver->dxinv[offset+solver->ghosts+i];
+    }
+#ifndef serial
+    MPI_Allreduce(xl,xg,2*n,MPI_DOUBLE,MPI_SUM,mpi->comm[d]);
+#else
+    _ArrayCopy1D_(xl,xg,2*n);
+#endif
+    amr->xg[d]     = (double*) calloc (n,sizeof(double));
+    amr->dxinvg[d] = (double*) calloc (n,sizeof(double));
+    _ArrayCopy1D_(xg    ,amr->xg[d]    ,n);
+    _ArrayCopy1D_((xg+n),amr->dxinvg[d],n);
+    free(xl);
+    free(xg);
+    offset += solver->dim_local[d] + 2*solver->ghosts;
+  }
+
+  /* global solution array of the regridding on rank 0 */
+  amr->ug_old = NULL;
+  if (!mpi->rank) {
+    amr->ug_old = (double*) calloc (solver->npoints_global*solver->nvars,sizeof(double));
+  }
+
+  /* flux register of the simulation (its faces are set by AMRRegrid()) */
+  FluxRegister *reg = (FluxRegister*) calloc (1,sizeof(FluxRegister));
+  FluxRegisterCreate(reg,0,solver->nvars);
+  solver->flux_register = reg;
+
+  /* initial patches */
+  MPIGatherArraynD( ndims,
+                    mpi,
+                    amr->ug_old,
+                    solver->u,
+                    solver->dim_global,
+                    solver->dim_local,
+                    solver->ghosts,
+                    solver->nvars );
+  int ierr = AMRRegrid(amr);
+  if (ierr) {
+    AMRCleanup(amr);
+    return(ierr);
+  }
+
+  *a = amr;
+  return(0);
+}
+
+/*! Index, in a block of the simulation grid that starts at the global index \a lo and has
+    \a size cells along a dimension, of a cell of the simulation grid: the cell is wrapped around
+    into the block along a periodic dimension, and clamped to the domain otherwise. */
+static inline int AMRCellIndex(int c, int n, int periodic, int lo, int size)
+{
+  if (periodic) {
+    while (c < lo)      c += n;
+    while (c >= lo+size) c -= n;
+  } else {
+    c = std::min(std::max(c,0),n-1);
+  }
+  return(c-lo);
+}
+
+/*! Interpolate a block of the solution of the simulation grid onto a point of the refined grid
+    with global index \a flo + \a index (see AMRProlong()). */
+static void AMRProlongPoint(const HyPar   *solver,  /*!< Solver object of the simulation */
+                            const double  *ub,      /*!< Block of the simulation solution (without ghost points) */
+                            const int     *blo,     /*!< First global index of the block along each dimension */
+                            const int     *bdim,    /*!< Size of the block along each dimension */
+                            const int     *flo,     /*!< Global index of the origin on the refined grid */
+                            const int     *index,   /*!< Index of the point from the origin */
+                            double        *uf       /*!< Interpolated solution at the point */
+                           )
+{
+  int ndims = solver->ndims;
+  int nvars = solver->nvars;
+  int *N    = solver->dim_global;
+
+  /* the cell of the point, and the offsets of its neighbors along each dimension, in the block */
+  int dm[ndims], dp[ndims], p = 0, stride = 1;
+  double xi[ndims];
+  for (int d = 0; d < ndims; d++) {
+    int f  = flo[d] + index[d];
+    int cc = (f >= 0 ? f/_AMR_RATIO_ : -((-f+_AMR_RATIO_-1)/_AMR_RATIO_));
+    int c  = AMRCellIndex(cc,N[d],solver->isPeriodic[d],blo[d],bdim[d]);
+    xi[d]  = ((f-_AMR_RATIO_*cc) ? 0.25 : -0.25);
+    dm[d]  = stride * (AMRCellIndex(blo[d]+c-1,N[d],solver->isPeriodic[d],blo[d],bdim[d]) - c);
+    dp[d]  = stride * (AMRCellIndex(blo[d]+c+1,N[d],solver->isPeriodic[d],blo[d],bdim[d]) - c);
+    p      += stride * c;
+    stride *= bdim[d];
+  }
+
+  for (int v = 0; v < nvars; v++) {
+    double uc = ub[nvars*p+v], val = uc;
+    for (int d = 0; d < ndims; d++) {
+      double dl = uc - ub[nvars*(p+dm[d])+v];
+      double dr = ub[nvars*(p+dp[d])+v] - uc;
+      double slope = 0;
+      if (dl*dr > 0) {
+        slope = std::min(std::min(2.0*fabs(dl),2.0*fabs(dr)),0.5*fabs(dl+dr));
+        if (dl < 0) slope = -slope;
+      }
+      val += xi[d] * slope;
+    }
+    uf[v] = val;
+  }
+}
+
+/*!
+  Interpolate a block of the solution of the simulation grid (without ghost points) onto a box
+  of the refined grid: the box spans the global indices [\a flo, \a fhi) of the refined grid along
+  each dimension, which may extend beyond the domain (e.g., the ghost points of a patch). The
+  interpolation is piecewise linear in each cell of the simulation grid, with the slopes limited
+  by the monotonized central limiter along each dimension: it is conservative (the average over
+  the refined cells of a cell is its value), and does not create new extrema. Outside the domain,
+  the cells of the simulation grid are wrapped around along periodic dimensions, and clamped to
+  the boundary otherwise. The block spans the global indices [\a blo, \a blo+\a bdim) of the
+  simulation grid; it must contain the (wrapped or clamped) cells of the box and their neighbors,
+  e.g., the global solution (on rank 0).
+*/
+int AMRProlong( void    *a,   /*!< AMR object of type #AMRObject */
+                double  *ub,  /*!< Block of the solution of the simulation grid (without ghost points) */
+                int     *blo, /*!< First global index of the block along each dimension */
+                int     *bdim,/*!< Size of the block along each dimension */
+                int     *flo, /*!< First global index of the box on the refined grid along each dimension */
+                int     *fhi, /*!< Last global index of the box on the refined grid plus one along each dimension */
+                double  *uf   /*!< Interpolated solution on the box (without ghost points) */
+              )
+{
+  AMRObject         *amr    = (AMRObject*) a;
+  SimulationObject  *sim    = (SimulationObject*) amr->sim;
+  HyPar             *solver = &(sim[0].solver);
+  int               ndims   = solver->ndims;
+  int               nvars   = solver->nvars;
+
+  int bounds[ndims], index[ndims];
+  for (int d = 0; d < ndims; d++) bounds[d] = fhi[d] - flo[d];
+
+  int done = 0; _ArraySetValue_(index,ndims,0);
+  while (!done) {
+    int pf;
+    _ArrayIndex1D_(ndims,bounds,index,0,pf);
+    AMRProlongPoint(solver,ub,blo,bdim,flo,index,(uf+nvars*pf));
+    _ArrayIncrementIndex_(ndims,bounds,index,done);
+  }
+
+  return(0);
+}
+
+/*!
+  Apply the boundary conditions to the solution of an AMR patch (#HyPar::ApplyBoundaryConditions
+  of the patches): the physical boundary conditions are applied (ApplyBoundaryConditions(); the
+  boundary zones at the coarse-fine interfaces are disabled), and the ghost points at the coarse-fine
+  interfaces are interpolated linearly in time between the values interpolated from the simulation
+  solution at the beginning and at the end of its time step (#AMRPatch::u_old, #AMRPatch::u_new).
+*/
+int AMRPatchBoundaryConditions( void    *s,     /*!< Solver object of type #HyPar of the patch */
+                                void    *m,     /*!< MPI object of type #MPIVariables of the patch */
+                                double  *x,     /*!< Solution of the patch */
+                                double  *xref,  /*!< Reference solution vector, if needed */
+                                double  waqt    /*!< Current simulation time */
+                              )
+{
+  HyPar     *solver = (HyPar*)    s;
+  AMRPatch  *patch  = (AMRPatch*) solver->amr_patch;
+  int       nvars   = solver->nvars;
+
+  int ierr = ApplyBoundaryConditions(s,m,x,xref,waqt);
+  if (ierr) return(ierr);
+
+  double theta = (patch->dt > 0 ? (waqt - patch->t_old) / patch->dt : 0.0);
+  theta = std::min(std::max(theta,0.0),1.0);
+  for (int k = 0; k < patch->npoints; k++) {
+    for (int v = 0; v < nvars; v++) {
+      x[nvars*patch->gindex[k]+v] =   (1.0-theta) * patch->u_old[nvars*k+v]
+                                    +      theta  * patch->u_new[nvars*k+v];
+    }
+  }
+  return(0);
+}
+
+/*! Interpolate the simulation solution onto the ghost points at the coarse-fine interfaces of a
+    patch on this rank (see AMRProlong()): the block of the simulation grid that covers these ghost
+    points and the neighbors of their cells is fetched from the ranks that own it (see
+    MPIGetArrayBlocknD()). This is a collective call. */
+static int AMRFillCoarseFine( AMRObject         *amr,   /*!< AMR object */
+                              SimulationObject  *patch, /*!< Patch */
+                              double            *ucf    /*!< Values at the ghost points at the coarse-fine interfaces */
+                            )
+{
+  SimulationObject  *sim      = (SimulationObject*) amr->sim;
+  HyPar             *solver   = &(sim[0].solver);
+  HyPar             *solver_p = &(patch->solver);
+  AMRPatch          *box      = (AMRPatch*) solver_p->amr_patch;
+  int               ndims     = solver->ndims;
+  int               nvars     = solver->nvars;
+  int               ghosts    = solver_p->ghosts;
+  int               *N        = solver->dim_global;
+
+  /* block of the simulation grid around the ghost points on this rank */
+  int blo[ndims], bdim[ndims], bounds[ndims], index[ndims], flo[ndims];
+  int clo[ndims], chi[ndims];
+  for (int d = 0; d < ndims; d++) {
+    bounds[d] = solver_p->dim_local[d] + 2*ghosts;
+    flo[d] = _AMR_RATIO_*box->lo[d] + patch->mpi.is[d] - ghosts;
+    clo[d] = N[d]; chi[d] = -N[d];
+  }
+  for (int k = 0; k < box->npoints; k++) {
+    _ArrayIndexnD_(ndims,box->gindex[k],bounds,index,0);
+    for (int d = 0; d < ndims; d++) {
+      int f = flo[d] + index[d];
+      int c = (f >= 0 ? f/_AMR_RATIO_ : -((-f+_AMR_RATIO_-1)/_AMR_RATIO_));
+      if (!solver->isPeriodic[d]) c = std::min(std::max(c,0),N[d]-1);
+      clo[d] = std::min(clo[d],c);
+      chi[d] = std::max(chi[d],c);
+    }
+  }
+  for (int d = 0; d < ndims; d++) {
+    if (!box->npoints) {
+      blo[d] = bdim[d] = 0;
+    } else if (solver->isPeriodic[d]) {
+      blo[d]  = clo[d] - 1;
+      bdim[d] = chi[d] - clo[d] + 3;
+    } else {
+      blo[d]  = std::max(clo[d]-1,0);
+      bdim[d] = std::min(chi[d]+2,N[d]) - blo[d];
+    }
+  }
+  long size = nvars;
+  for (int d = 0; d < ndims; d++) size *= bdim[d];
+  double *ub = (double*) calloc (std::max(size,(long)1),sizeof(double));
+  MPIGetArrayBlocknD( ndims,
+                      nvars,
+                      N,
+                      solver->dim_local,
+                      solver->ghosts,
+                      solver->isPeriodic,
+                      &(sim[0].mpi),
+                      solver->u,
+                      blo,
+                      bdim,
+                      ub );
+
+  for (int k = 0; k < box->npoints; k++) {
+    _ArrayIndexnD_(ndims,box->gindex[k],bounds,index,0);
+    AMRProlongPoint(solver,ub,blo,bdim,flo,index,(ucf+nvars*k));
+  }
+  free(ub);
+  return(0);
+}
+
+/*!
+  Pre-time-step function of the adaptive mesh refinement (see amr.h), called before each time step
+  of the simulation (after TimePreStep()): every #AMRObject::regrid_iter time steps, the simulation
+  solution is gathered on rank 0 and the patches are rebuilt (AMRRegrid()); the flux registers are
+  reset, and the ghost points of the patches at the coarse-fine interfaces are interpolated from the
+  simulation solution at the beginning of the time step (AMRFillCoarseFine()).
+*/
+int AMRPreStep(void *a /*!< AMR object of type #AMRObject (may be NULL) */)
+{
+  if (!a) return(0);
+  AMRObject         *amr    = (AMRObject*) a;
+  SimulationObject  *sim    = (SimulationObject*) amr->sim;
+  TimeIntegration   *TS     = (TimeIntegration*) amr->ts;
+  HyPar             *solver = &(sim[0].solver);
+  int               ierr;
+
+  if ((TS->iter%amr->regrid_iter == 0) && (TS->iter != TS->restart_iter)) {
+    MPIGatherArraynD( solver->ndims,
+                      &(sim[0].mpi),
+                      amr->ug_old,
+                      solver->u,
+                      solver->dim_global,
+                      solver->dim_local,
+                      solver->ghosts,
+                      solver->nvars );
+    ierr = AMRRegrid(amr);
+    if (ierr) return(ierr);
+  }
+
+  FluxRegister *reg = (FluxRegister*) solver->flux_register;
+  _ArraySetValue_(reg->step,reg->nfaces*reg->nvars,0.0);
+
+  SimulationObject *patches = (SimulationObject*) amr->patches;
+  for (int p = 0; p < amr->npatches; p++) {
+    AMRPatch *box = (AMRPatch*) patches[p].solver.amr_patch;
+    box->t_old = TS->waqt;
+    box->dt    = TS->dt;
+    FluxRegister *reg_p = (FluxRegister*) patches[p].solver.flux_register;
+    _ArraySetValue_(reg_p->step,reg_p->nfaces*reg_p->nvars,0.0);
+    AMRFillCoarseFine(amr,&patches[p],box->u_old);
+  }
+
+  return(0);
+}
+
+/*!
+  Advance the patches of the adaptive mesh refinement (see amr.h), called after each time step of
+  the simulation (after TimeStep(), and before TimePostStep()):
+  + the ghost points at the coarse-fine interfaces are interpolated from the simulation solution at
+    the end of the time step (AMRFillCoarseFine());
+  + the patches are advanced by #_AMR_RATIO_ time steps of a fraction 1/#_AMR_RATIO_ of the time step
+    of the simulation (the ghost points at the coarse-fine interfaces are interpolated in time, see
+    AMRPatchBoundaryConditions());
+  + the simulation solution on the cells covered by each patch is replaced by the average of the patch
+    solution over them, and the cells adjacent to the patches are corrected with the difference
+    between the time integrals of the hyperbolic fluxes computed on the patches and on the simulation
+    grid at the coarse-fine interfaces, accumulated in the flux registers (#FluxRegister), so that
+    the solution is conserved.
+
+  Each rank restricts onto, and refluxes, the cells of its local domain: it fetches the part of each
+  patch that covers them (MPIGetArrayBlocknD()), and the flux registers are summed over the ranks.
+*/
+int AMRStep(void *a /*!< AMR object of type #AMRObject (may be NULL) */)
+{
+  if (!a) return(0);
+  AMRObject         *amr      = (AMRObject*) a;
+  if (!amr->npatches) return(0);
+  SimulationObject  *sim      = (SimulationObject*) amr->sim;
+  SimulationObject  *patches  = (SimulationObject*) amr->patches;
+  TimeIntegration   *TSf      = (TimeIntegration*) amr->ts_patches;
+  HyPar             *solver   = &(sim[0].solver);
+  MPIVariables      *mpi      = &(sim[0].mpi);
+  int               ndims     = solver->ndims;
+  int               nvars     = solver->nvars;
+  int               ghosts    = solver->ghosts;
+  int               *N        = solver->dim_global;
+  int               *dim      = solver->dim_local;
+  int               np        = amr->npatches;
+
+  MPIProfilerBegin("AMR");
+
+  /* ghost points of the patches at the coarse-fine interfaces */
+  for (int p = 0; p < np; p++) {
+    AMRPatch *box = (AMRPatch*) patches[p].solver.amr_patch;
+    AMRFillCoarseFine(amr,&patches[p],box->u_new);
+  }
+
+  /* advance the patches */
+  AMRPatch *box0  = (AMRPatch*) patches[0].solver.amr_patch;
+  double   dt_f   = box0->dt / ((double) _AMR_RATIO_);
+  for (int k = 0; k < _AMR_RATIO_; k++) {
+    TSf->waqt = box0->t_old + k*dt_f;
+    TSf->dt   = dt_f;
+    TSf->iter = 0;
+    TimePreStep (TSf);
+    TimeStep    (TSf);
+    TimePostStep(TSf);
+  }
+
+  /* sum the flux registers over the ranks */
+  FluxRegister *reg = (FluxRegister*) solver->flux_register;
+  MPISum_double(reg->step,reg->step,reg->nfaces*nvars,&mpi->world);
+  for (int p = 0; p < np; p++) {
+    FluxRegister *reg_p = (FluxRegister*) patches[p].solver.flux_register;
+    MPISum_double(reg_p->step,reg_p->step,reg_p->nfaces*nvars,&(patches[p].mpi.world));
+  }
+
+  /* restriction of the patch solutions onto the cells of the local domain */
+  double nchildren = 1;
+  for (int d = 0; d < ndims; d++) nchildren *= (double) _AMR_RATIO_;
+  for (int p = 0; p < np; p++) {
+    HyPar     *solver_p = &(patches[p].solver);
+    AMRPatch  *box      = (AMRPatch*) solver_p->amr_patch;
+
+    /* cells of the patch on this rank, and the block of the patch that covers them */
+    int clo[ndims], bounds[ndims], flo[ndims], fdim[ndims], empty = 0;
+    for (int d = 0; d < ndims; d++) {
+      clo[d]    = std::max(box->lo[d],mpi->is[d]);
+      bounds[d] = std::max(std::min(box->hi[d],mpi->ie[d])-clo[d],0);
+      if (!bounds[d]) empty = 1;
+    }
+    for (int d = 0; d < ndims; d++) {
+      flo[d]  = (empty ? 0 : _AMR_RATIO_*(clo[d]-box->lo[d]));
+      fdim[d] = (empty ? 0 : _AMR_RATIO_*bounds[d]);
+    }
+    long size = nvars;
+    for (int d = 0; d < ndims; d++) size *= fdim[d];
+    double *ub = (double*) calloc (std::max(size,(long)1),sizeof(double));
+    MPIGetArrayBlocknD( ndims,
+                        nvars,
+                        solver_p->dim_global,
+                        solver_p->dim_local,
+                        solver_p->ghosts,
+                        solver_p->isPeriodic,
+                        &(patches[p].mpi),
+                        solver_p->u,
+                        flo,
+                        fdim,
+                        ub );
+
+    if (!empty) {
+      int index[ndims], c[ndims], f[ndims], children[ndims], ichild[ndims];
+      _ArraySetValue_(children,ndims,_AMR_RATIO_);
+      int done = 0; _ArraySetValue_(index,ndims,0);
+      while (!done) {
+        int pc;
+        for (int d = 0; d < ndims; d++) c[d] = clo[d] - mpi->is[d] + index[d];
+        _ArrayIndex1D_(ndims,dim,c,ghosts,pc);
+        _ArraySetValue_((solver->u+nvars*pc),nvars,0.0);
+        int done_c = 0; _ArraySetValue_(ichild,ndims,0);
+        while (!done_c) {
+          int pf;
+          for (int d = 0; d < ndims; d++) f[d] = _AMR_RATIO_*index[d] + ichild[d];
+          _ArrayIndex1D_(ndims,fdim,f,0,pf);
+          _ArrayAXPY_((ub+nvars*pf),(1.0/nchildren),(solver->u+nvars*pc),nvars);
+          _ArrayIncrementIndex_(ndims,children,ichild,done_c);
+        }
+        _ArrayIncrementIndex_(ndims,bounds,index,done);
+      }
+    }
+    free(ub);
+  }
+
+  /* refluxing of the cells of the local domain adjacent to the patches, and correction of the
+     boundary flux integral of the simulation (on rank 0; it is summed over the ranks) */
+  for (int p = -1; p < np; p++) {
+    FluxRegister *r = (FluxRegister*) (p < 0 ? reg : patches[p].solver.flux_register);
+    for (int k = 0; k < r->nfaces; k++) {
+      int d = r->dir[k];
+      if (r->cell[k] < 0) {
+        /* physical boundary face: boundary flux integral of the simulation */
+        if (!mpi->rank) {
+          _ArrayAXPY_((r->step+nvars*k),r->weight[k],(solver->StepBoundaryIntegral+(2*d+r->side[k])*nvars),nvars);
+        }
+        continue;
+      }
+      int c[ndims], local = 1;
+      _ArrayIndexnD_(ndims,((int)r->cell[k]),N,c,0);
+      for (int t = 0; t < ndims; t++) {
+        if ((c[t] < mpi->is[t]) || (c[t] >= mpi->ie[t])) local = 0;
+      }
+      if (!local) continue;
+      double a_k = r->weight[k] * amr->dxinvg[d][c[d]];
+      for (int t = 0; t < ndims; t++) c[t] -= mpi->is[t];
+      int pc; _ArrayIndex1D_(ndims,dim,c,ghosts,pc);
+      _ArrayAXPY_((r->step+nvars*k),a_k,(solver->u+nvars*pc),nvars);
+    }
+  }
+
+  MPIExchangeBoundariesnD(ndims,nvars,dim,ghosts,mpi,solver->u);
+
+  MPIProfilerEnd("AMR",0);
+  return(0);
+}
+
+/*! Write the solutions of the patches to files (see OutputSolution()): the solution of patch
+    p is written to \b op_amr_<p> with the same index as the solution file of the simulation;
+    therefore, this function must be called before OutputSolution() for the simulation. */
+int AMROutputSolution(void    *a,     /*!< AMR object of type #AMRObject (may be NULL) */
+                      double  a_time  /*!< Current simulation time */
+                     )
+{
+  if (!a) return(0);
+  AMRObject         *amr      = (AMRObject*) a;
+  SimulationObject  *sim      = (SimulationObject*) amr->sim;
+  SimulationObject  *patches  = (SimulationObject*) amr->patches;
+
+  for (int p = 0; p < amr->npatches; p++) {
+    if (sim[0].solver.filename_index && patches[p].solver.filename_index) {
+      strcpy(patches[p].solver.filename_index,sim[0].solver.filename_index);
+    }
+    int ierr = OutputSolution(&patches[p],1,a_time);
+    if (ierr) return(ierr);
+  }
+  return(0);
+}
+
+/*! Delete the patches, their time integration object, and the AMR object. */
+int AMRCleanup(void *a /*!< AMR object of type #AMRObject (may be NULL) */)
+{
+  if (!a) return(0);
+  AMRObject         *amr    = (AMRObject*) a;
+  SimulationObject  *sim    = (SimulationObject*) amr->sim;
+  HyPar             *solver = &(sim[0].solver);
+
+  if (amr->npatches) {
+    TimeCleanup(amr->ts_patches);
+    Cleanup(amr->patches,amr->npatches);
+    free(amr->patches);
+  }
+  if (amr->ts_patches) free(amr->ts_patches);
+
+  if (solver->flux_register) {
+    FluxRegisterCleanup((FluxRegister*)solver->flux_register);
+    free(solver->flux_register);
+    solver->flux_register = NULL;
+  }
+
+  for (int d = 0; d < solver->ndims; d++) {
+    free(amr->xg[d]);
+    free(amr->dxinvg[d]);
+  }
+  free(amr->xg);
+  free(amr->dxinvg);
+  if (amr->ug_old) free(amr->ug_old);
+  free(amr);
+  return(0);
+}
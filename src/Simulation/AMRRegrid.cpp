@@ -0,0 +1,798 @@
+/*! @file AMRRegrid.cpp
+    @author Debojyoti Ghosh
+    @brief Block-structured adaptive mesh refinement: tagging, clustering, and creation of the patches
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+#include <vector>
+#include <algorithm>
+#include <basic.h>
+#include <arrayfunctions.h>
+#include <common_cpp.h>
+#include <mpivars_cpp.h>
+#include <timeintegration_cpp.h>
+#include <simulation.h>
+#include <amr.h>
+
+/*! Compute the inverse of the grid spacing, including its ghost values */
+extern "C" int ComputeGridSpacing(void*,void*);
+
+/*! A box of the simulation grid: the first global index along each dimension,
+    followed by the last global index plus one along each dimension */
+typedef std::vector<int> AMRBox;
+
+/*! Tag the cells of the simulation grid for refinement (see amr.h): the normalized difference
+    of the solution component #AMRObject::tag_var along any dimension is larger than
+    #AMRObject::tag_threshold; the tagged region is then grown by #AMRObject::buffer cells along
+    each dimension. Called on rank 0 only. */
+static void AMRTag( AMRObject       *amr,   /*!< AMR object */
+                    const HyPar     *solver,/*!< Solver object of the simulation */
+                    std::vector<char> &tags /*!< Tags of the cells of the simulation grid (without ghosts) */
+                  )
+{
+  int     ndims = solver->ndims;
+  int     nvars = solver->nvars;
+  int     *N    = solver->dim_global;
+  double  *ug   = amr->ug_old;
+  int     v     = amr->tag_var;
+  long    npts  = solver->npoints_global;
+
+  tags.assign(npts,0);
+  int index[ndims], neighbor[ndims];
+
+  int done = 0; _ArraySetValue_(index,ndims,0);
+  while (!done) {
+    int p; _ArrayIndex1D_(ndims,N,index,0,p);
+    for (int d = 0; d < ndims; d++) {
+      int pm, pp;
+      _ArrayCopy1D_(index,neighbor,ndims);
+      neighbor[d] = index[d]-1;
+      if (neighbor[d] < 0) neighbor[d] = (solver->isPeriodic[d] ? N[d]-1 : 0);
+      _ArrayIndex1D_(ndims,N,neighbor,0,pm);
+      neighbor[d] = index[d]+1;
+      if (neighbor[d] >= N[d]) neighbor[d] = (solver->isPeriodic[d] ? 0 : N[d]-1);
+      _ArrayIndex1D_(ndims,N,neighbor,0,pp);
+      double um = ug[nvars*pm+v], uc = ug[nvars*p+v], up = ug[nvars*pp+v];
+      double sensor = fabs(up-um) / (fabs(up) + 2.0*fabs(uc) + fabs(um) + _MACHINE_ZERO_);
+      if (sensor > amr->tag_threshold) {
+        tags[p] = 1;
+        break;
+      }
+    }
+    _ArrayIncrementIndex_(ndims,N,index,done);
+  }
+
+  /* grow the tagged region by the buffer, one dimension after the other */
+  for (int d = 0; d < ndims; d++) {
+    std::vector<char> grown(tags);
+    done = 0; _ArraySetValue_(index,ndims,0);
+    while (!done) {
+      int p; _ArrayIndex1D_(ndims,N,index,0,p);
+      if (tags[p]) {
+        _ArrayCopy1D_(index,neighbor,ndims);
+        for (int b = -amr->buffer; b <= amr->buffer; b++) {
+          int i = index[d] + b;
+          if (solver->isPeriodic[d]) i = ((i%N[d])+N[d])%N[d];
+          else if ((i < 0) || (i >= N[d])) continue;
+          neighbor[d] = i;
+          int q; _ArrayIndex1D_(ndims,N,neighbor,0,q);
+          grown[q] = 1;
+        }
+      }
+      _ArrayIncrementIndex_(ndims,N,index,done);
+    }
+    tags.swap(grown);
+  }
+}
+
+/*! Cover the tagged cells inside a box with boxes (Berger-Rigoutsos): the box is shrunk to
+    the bounding box of its tagged cells, and accepted if the fraction of tagged cells is at
+    least #AMRObject::efficiency; otherwise, it is split at the hole (a plane without tagged
+    cells) nearest to its center, or if there is none, at the middle of its longest dimension,
+    and the two halves are clustered recursively. Called on rank 0 only. */
+static void AMRCluster( const AMRObject         *amr,     /*!< AMR object */
+                        const HyPar             *solver,  /*!< Solver object of the simulation */
+                        const std::vector<char> &tags,    /*!< Tags of the cells of the simulation grid */
+                        const int               *minsize, /*!< Minimum size of a box along each dimension */
+                        AMRBox                  box,      /*!< Box to cluster */
+                        std::vector<AMRBox>     &boxes    /*!< List of boxes to which the clusters are added */
+                      )
+{
+  int ndims = solver->ndims;
+  int *N    = solver->dim_global;
+
+  /* signatures (number of tagged cells on each plane) of the box along each dimension */
+  std::vector< std::vector<long> > sig(ndims);
+  for (int d = 0; d < ndims; d++) sig[d].assign(box[ndims+d]-box[d],0);
+  int bounds[ndims], index[ndims], cell[ndims];
+  for (int d = 0; d < ndims; d++) bounds[d] = box[ndims+d] - box[d];
+  long ntagged = 0;
+  int done = 0; _ArraySetValue_(index,ndims,0);
+  while (!done) {
+    int p;
+    for (int d = 0; d < ndims; d++) cell[d] = box[d] + index[d];
+    _ArrayIndex1D_(ndims,N,cell,0,p);
+    if (tags[p]) {
+      ntagged++;
+      for (int d = 0; d < ndims; d++) sig[d][index[d]]++;
+    }
+    _ArrayIncrementIndex_(ndims,bounds,index,done);
+  }
+  if (!ntagged) return;
+
+  /* bounding box of the tagged cells */
+  AMRBox bbox(box);
+  for (int d = 0; d < ndims; d++) {
+    int lo = 0, hi = bounds[d];
+    while (!sig[d][lo]) lo++;
+    while (!sig[d][hi-1]) hi--;
+    bbox[d]       = box[d] + lo;
+    bbox[ndims+d] = box[d] + hi;
+  }
+  double volume = 1;
+  for (int d = 0; d < ndims; d++) volume *= (double) (bbox[ndims+d]-bbox[d]);
+  if (((double) ntagged) / volume >= amr->efficiency) {
+    boxes.push_back(bbox);
+    return;
+  }
+
+  /* hole nearest to the center of the bounding box */
+  int dsplit = -1, isplit = -1;
+  double dist_min = -1;
+  for (int d = 0; d < ndims; d++) {
+    double center = 0.5 * (double) (bbox[d]+bbox[ndims+d]);
+    for (int i = bbox[d]+1; i < bbox[ndims+d]-1; i++) {
+      if (!sig[d][i-box[d]]) {
+        double dist = fabs(((double) i) + 0.5 - center);
+        if ((dsplit < 0) || (dist < dist_min)) {
+          dsplit = d;
+          isplit = i;
+          dist_min = dist;
+        }
+      }
+    }
+  }
+  /* or the middle of the longest dimension */
+  if (dsplit < 0) {
+    int lmax = 0;
+    for (int d = 0; d < ndims; d++) {
+      int l = bbox[ndims+d] - bbox[d];
+      if ((l >= 2*minsize[d]) && (l > lmax)) {
+        dsplit = d;
+        lmax = l;
+      }
+    }
+    if (dsplit < 0) {
+      boxes.push_back(bbox);
+      return;
+    }
+    isplit = (bbox[dsplit] + bbox[ndims+dsplit]) / 2;
+  }
+
+  AMRBox left(bbox), right(bbox);
+  left[ndims+dsplit] = isplit;
+  right[dsplit]      = isplit;
+  AMRCluster(amr,solver,tags,minsize,left,boxes);
+  AMRCluster(amr,solver,tags,minsize,right,boxes);
+}
+
+/*! Compute the boxes of the patches from the tagged cells (see AMRTag(), AMRCluster()): the
+    boxes are grown to their minimum size (so that the refined grid has at least #HyPar::ghosts
+    points on each rank), a box that reaches a periodic boundary is extended to span the periodic
+    dimension, and boxes that overlap or are less than 2 cells apart are merged (so that the
+    cells adjacent to a patch, which are refluxed, are not covered by another patch). Called on
+    rank 0 only. */
+static void AMRBoxes( AMRObject           *amr,   /*!< AMR object */
+                      const HyPar         *solver,/*!< Solver object of the simulation */
+                      const MPIVariables  *mpi,   /*!< MPI object of the simulation */
+                      std::vector<AMRBox> &boxes  /*!< Boxes of the patches */
+                    )
+{
+  int ndims = solver->ndims;
+  int *N    = solver->dim_global;
+
+  std::vector<char> tags;
+  AMRTag(amr,solver,tags);
+
+  int minsize[ndims];
+  for (int d = 0; d < ndims; d++) {
+    minsize[d] = std::max(1,(mpi->iproc[d]*solver->ghosts+_AMR_RATIO_-1)/_AMR_RATIO_);
+  }
+
+  AMRBox domain(2*ndims);
+  for (int d = 0; d < ndims; d++) {
+    domain[d]       = 0;
+    domain[ndims+d] = N[d];
+  }
+  boxes.clear();
+  AMRCluster(amr,solver,tags,minsize,domain,boxes);
+
+  for (size_t b = 0; b < boxes.size(); b++) {
+    for (int d = 0; d < ndims; d++) {
+      int &lo = boxes[b][d], &hi = boxes[b][ndims+d];
+      if (hi-lo < minsize[d]) {
+        lo -= (minsize[d]-(hi-lo))/2;
+        hi  = lo + minsize[d];
+        if (lo < 0)     { hi -= lo; lo = 0; }
+        if (hi > N[d])  { lo -= (hi-N[d]); hi = N[d]; }
+      }
+      if (solver->isPeriodic[d] && ((lo == 0) || (hi == N[d]))) {
+        lo = 0;
+        hi = N[d];
+      }
+    }
+  }
+
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (size_t a = 0; (a < boxes.size()) && (!merged); a++) {
+      for (size_t b = a+1; (b < boxes.size()) && (!merged); b++) {
+        bool overlap = true;
+        for (int d = 0; d < ndims; d++) {
+          if (    (boxes[a][ndims+d]+1 <= boxes[b][d]-1)
+              ||  (boxes[b][ndims+d]+1 <= boxes[a][d]-1) ) overlap = false;
+        }
+        if (overlap) {
+          for (int d = 0; d < ndims; d++) {
+            boxes[a][d]       = std::min(boxes[a][d],boxes[b][d]);
+            boxes[a][ndims+d] = std::max(boxes[a][ndims+d],boxes[b][ndims+d]);
+          }
+          boxes.erase(boxes.begin()+b);
+          merged = true;
+        }
+      }
+    }
+  }
+}
+
+/*! Set the solver parameters (stuff that is usually read in from solver.inp) of a patch: the
+    global grid size is the refined size of its box, and all other parameters are the same as
+    the simulation, except that the time step is divided by the refinement factor, and the
+    screen output, the residual file, the conservation check, and the features that are not
+    supported by the adaptive mesh refinement (see AMRInitialize()) are turned off. */
+static void AMRPatchSetParameters(SimulationObject        *dst, /*!< Patch */
+                                  const SimulationObject  *src, /*!< Simulation object */
+                                  const int               *dim  /*!< Global grid size of the patch */
+                                 )
+{
+  dst->solver.my_idx = 0;
+  dst->solver.nsims = 1;
+
+  dst->mpi.rank = src->mpi.rank;
+  dst->mpi.nproc = src->mpi.nproc;
+
+  dst->solver.ndims = src->solver.ndims;
+  dst->solver.nvars = src->solver.nvars;
+  dst->solver.ghosts = src->solver.ghosts;
+
+  dst->solver.dim_global    = (int*) calloc (dst->solver.ndims,sizeof(int));
+  dst->solver.dim_global_ex = (int*) calloc (dst->solver.ndims,sizeof(int));
+  dst->mpi.iproc            = (int*) calloc (dst->solver.ndims,sizeof(int));
+  for (int d = 0; d < dst->solver.ndims; d++) {
+    dst->solver.dim_global[d] = dst->solver.dim_global_ex[d] = dim[d];
+    dst->mpi.iproc[d] = src->mpi.iproc[d];
+  }
+
+  dst->solver.n_iter       = src->solver.n_iter;
+  dst->solver.restart_iter = 0;
+
+  strcpy(dst->solver.time_scheme, src->solver.time_scheme);
+  strcpy(dst->solver.time_scheme_type, src->solver.time_scheme_type);
+  strcpy(dst->solver.spatial_scheme_hyp, src->solver.spatial_scheme_hyp);
+  strcpy(dst->solver.SplitHyperbolicFlux, src->solver.SplitHyperbolicFlux);
+  strcpy(dst->solver.interp_type, src->solver.interp_type);
+  strcpy(dst->solver.eigen_cache_type, src->solver.eigen_cache_type);
+  strcpy(dst->solver.spatial_type_par, src->solver.spatial_type_par);
+  strcpy(dst->solver.spatial_scheme_par, src->solver.spatial_scheme_par);
+
+  dst->solver.dt = src->solver.dt / ((double) _AMR_RATIO_);
+
+  strcpy(dst->solver.ConservationCheck, "no");
+
+  dst->solver.screen_op_iter = INT_MAX;
+  dst->solver.file_op_iter = src->solver.file_op_iter;
+  dst->solver.write_residual = 0;
+
+  strcpy(dst->solver.op_file_format, src->solver.op_file_format);
+  strcpy(dst->solver.ip_file_type, src->solver.ip_file_type);
+
+  strcpy(dst->solver.input_mode, src->solver.input_mode);
+  strcpy(dst->solver.output_mode, src->solver.output_mode);
+  dst->mpi.N_IORanks = src->mpi.N_IORanks;
+
+  strcpy(dst->solver.op_overwrite, src->solver.op_overwrite);
+  strcpy(dst->solver.plot_solution, "no");
+  strcpy(dst->solver.profile, src->solver.profile);
+  strcpy(dst->solver.mixed_precision, "no");
+  strcpy(dst->solver.nonuniform_grid, "no");
+  strcpy(dst->solver.model, src->solver.model);
+  strcpy(dst->solver.ib_filename, src->solver.ib_filename);
+
+  dst->solver.flag_ib = 0;
+
+  dst->solver.local_dt_cfl    = 0;
+  dst->solver.residual_drop   = 0;
+  dst->solver.grid_sequencing = 0;
+  dst->solver.gs_level        = 0;
+
+#if defined(HAVE_CUDA)
+  dst->solver.use_gpu       = 0;
+  dst->solver.gpu_device_no = src->solver.gpu_device_no;
+#endif
+
+#ifndef serial
+  MPI_Comm_dup(MPI_COMM_WORLD, &(dst->mpi.world));
+#endif
+}
+
+/*! Compute the grid of a patch, including its ghost points, from the global grid of the
+    simulation: each cell of the simulation grid is split into #_AMR_RATIO_ cells along each
+    dimension, and the grid is extrapolated linearly outside the domain. */
+static int AMRPatchGrid(AMRObject         *amr,   /*!< AMR object */
+                        SimulationObject  *patch  /*!< Patch */
+                       )
+{
+  SimulationObject  *sim    = (SimulationObject*) amr->sim;
+  HyPar             *solver = &(patch->solver);
+  AMRPatch          *box    = (AMRPatch*) solver->amr_patch;
+  int               ndims   = solver->ndims;
+  int               ghosts  = solver->ghosts;
+
+  int offset = 0;
+  for (int d = 0; d < ndims; d++) {
+    int     N   = sim[0].solver.dim_global[d];
+    double  *xg = amr->xg[d];
+    double  h0  = 1.0 / amr->dxinvg[d][0];
+    double  hN  = 1.0 / amr->dxinvg[d][N-1];
+    for (int i = -ghosts; i < solver->dim_local[d]+ghosts; i++) {
+      int f = _AMR_RATIO_*box->lo[d] + patch->mpi.is[d] + i;
+      double x;
+      if (f < 0) {
+        x = xg[0] - 0.25*h0 + ((double) f) * 0.5*h0;
+      } else if (f >= _AMR_RATIO_*N) {
+        x = xg[N-1] + 0.25*hN + ((double) (f-_AMR_RATIO_*N+1)) * 0.5*hN;
+      } else {
+        int c = f / _AMR_RATIO_;
+        double h = 1.0 / amr->dxinvg[d][c];
+        x = xg[c] + ((f-_AMR_RATIO_*c) ? 0.25 : -0.25) * h;
+      }
+      solver->x[offset+ghosts+i] = x;
+    }
+    offset += solver->dim_local[d] + 2*ghosts;
+  }
+
+  return ComputeGridSpacing(solver,&(patch->mpi));
+}
+
+/*! Compute the initial solution of a patch: the simulation solution is interpolated onto its
+    box (see AMRProlong()), and it is replaced by the solution of the previous patches where
+    they overlap. The transfer is done on rank 0. */
+static int AMRPatchInitialSolution( AMRObject                   *amr,     /*!< AMR object */
+                                    SimulationObject            *patch,   /*!< Patch */
+                                    SimulationObject            *old,     /*!< Previous patches */
+                                    const std::vector<double*>  &uold     /*!< Global solutions of the previous patches (rank 0) */
+                                  )
+{
+  SimulationObject  *sim    = (SimulationObject*) amr->sim;
+  HyPar             *solver = &(patch->solver);
+  AMRPatch          *box    = (AMRPatch*) solver->amr_patch;
+  int               ndims   = solver->ndims;
+  int               nvars   = solver->nvars;
+  int               ghosts  = solver->ghosts;
+
+  double *ug = NULL;
+  if (!patch->mpi.rank) {
+    int blo[ndims], flo[ndims], fhi[ndims], bounds[ndims], index[ndims];
+    long size = nvars;
+    for (int d = 0; d < ndims; d++) {
+      flo[d] = _AMR_RATIO_*box->lo[d] - ghosts;
+      fhi[d] = _AMR_RATIO_*box->hi[d] + ghosts;
+      size *= (fhi[d]-flo[d]);
+      bounds[d] = fhi[d]-flo[d];
+    }
+    ug = (double*) calloc (size,sizeof(double));
+    _ArraySetValue_(blo,ndims,0);
+    AMRProlong(amr,amr->ug_old,blo,sim[0].solver.dim_global,flo,fhi,ug);
+
+    for (size_t q = 0; q < uold.size(); q++) {
+      AMRPatch *box_q = (AMRPatch*) old[q].solver.amr_patch;
+      int done = 0; _ArraySetValue_(index,ndims,0);
+      while (!done) {
+        int f[ndims], inside = 1;
+        for (int d = 0; d < ndims; d++) {
+          f[d] = flo[d] + index[d] - _AMR_RATIO_*box_q->lo[d];
+          if ((f[d] < 0) || (f[d] >= old[q].solver.dim_global[d])) inside = 0;
+          if ((index[d] < ghosts) || (index[d] >= bounds[d]-ghosts)) inside = 0;
+        }
+        if (inside) {
+          int p, pq;
+          _ArrayIndex1D_(ndims,bounds,index,0,p);
+          _ArrayIndex1D_(ndims,old[q].solver.dim_global,f,0,pq);
+          _ArrayCopy1D_((uold[q]+nvars*pq),(ug+nvars*p),nvars);
+        }
+        _ArrayIncrementIndex_(ndims,bounds,index,done);
+      }
+    }
+  }
+
+  MPIPartitionArraynDwGhosts( ndims,
+                              &(patch->mpi),
+                              ug,
+                              solver->u,
+                              solver->dim_global,
+                              solver->dim_local,
+                              ghosts,
+                              nvars );
+  if (ug) free(ug);
+
+  MPIExchangeBoundariesnD(ndims,nvars,solver->dim_local,ghosts,&(patch->mpi),solver->u);
+  return(0);
+}
+
+/*! List the ghost points of a patch on this rank at its coarse-fine interfaces
+    (#AMRPatch::gindex), and allocate their interpolated values. */
+static int AMRPatchCoarseFine(SimulationObject *patch /*!< Patch */)
+{
+  HyPar     *solver = &(patch->solver);
+  AMRPatch  *box    = (AMRPatch*) solver->amr_patch;
+  int       ndims   = solver->ndims;
+  int       ghosts  = solver->ghosts;
+  int       *is     = patch->mpi.is;
+
+  int bounds[ndims], index[ndims];
+  for (int d = 0; d < ndims; d++) bounds[d] = solver->dim_local[d] + 2*ghosts;
+
+  std::vector<int> gindex;
+  int done = 0; _ArraySetValue_(index,ndims,0);
+  while (!done) {
+    int cf = 0;
+    for (int d = 0; d < ndims; d++) {
+      int G = is[d] + index[d] - ghosts;
+      if ((G < 0) && box->cf[2*d]) cf = 1;
+      if ((G >= solver->dim_global[d]) && box->cf[2*d+1]) cf = 1;
+    }
+    if (cf) {
+      int p; _ArrayIndex1D_(ndims,bounds,index,0,p);
+      gindex.push_back(p);
+    }
+    _ArrayIncrementIndex_(ndims,bounds,index,done);
+  }
+
+  box->npoints = gindex.size();
+  int n = std::max(box->npoints,1);
+  box->gindex = (int*)    calloc (n,sizeof(int));
+  box->u_old  = (double*) calloc (n*solver->nvars,sizeof(double));
+  box->u_new  = (double*) calloc (n*solver->nvars,sizeof(double));
+  for (int k = 0; k < box->npoints; k++) box->gindex[k] = gindex[k];
+  return(0);
+}
+
+/*! Create the flux registers of the simulation and of the patches (see #FluxRegister): for each
+    coarse-fine interface of each patch, the simulation register has the faces of the simulation
+    grid on it, and the patch register has the faces of the refined grid on it; the correction of
+    a cell of the simulation grid adjacent to the patch is the difference between the average of
+    the time integrals of the fluxes of the patch at its face and that of the simulation. The
+    faces of the patches on the (non-periodic) physical boundaries are registered too, so that
+    the boundary flux integral of the simulation (#HyPar::StepBoundaryIntegral) is corrected
+    the same way. */
+static int AMRFluxRegisters(AMRObject *amr /*!< AMR object */)
+{
+  SimulationObject  *sim      = (SimulationObject*) amr->sim;
+  SimulationObject  *patches  = (SimulationObject*) amr->patches;
+  HyPar             *solver   = &(sim[0].solver);
+  int               ndims     = solver->ndims;
+  int               nvars     = solver->nvars;
+  int               *N        = solver->dim_global;
+
+  /* number of children of a face of the simulation grid */
+  double nchildren = 1;
+  for (int d = 1; d < ndims; d++) nchildren *= (double) _AMR_RATIO_;
+
+  /* register of the simulation */
+  int nfaces = 0;
+  for (int p = 0; p < amr->npatches; p++) {
+    AMRPatch *box = (AMRPatch*) patches[p].solver.amr_patch;
+    for (int d = 0; d < ndims; d++) {
+      int n = 1;
+      for (int t = 0; t < ndims; t++) if (t != d) n *= (box->hi[t]-box->lo[t]);
+      for (int s = 0; s < 2; s++) if (box->cf[2*d+s] || (!solver->isPeriodic[d])) nfaces += n;
+    }
+  }
+  FluxRegister *reg = (FluxRegister*) solver->flux_register;
+  FluxRegisterCleanup(reg);
+  FluxRegisterCreate(reg,nfaces,nvars);
+
+  int k = 0;
+  for (int p = 0; p < amr->npatches; p++) {
+    AMRPatch *box = (AMRPatch*) patches[p].solver.amr_patch;
+    for (int d = 0; d < ndims; d++) {
+      for (int s = 0; s < 2; s++) {
+        if ((!box->cf[2*d+s]) && solver->isPeriodic[d]) continue;
+        int bounds[ndims], index[ndims], cell[ndims], local[ndims], dim_interface[ndims];
+        for (int t = 0; t < ndims; t++) bounds[t] = (t == d ? 1 : box->hi[t]-box->lo[t]);
+        _ArrayCopy1D_(solver->dim_local,dim_interface,ndims); dim_interface[d]++;
+        int face = (s ? box->hi[d] : box->lo[d]);
+        int done = 0; _ArraySetValue_(index,ndims,0);
+        while (!done) {
+          int owner = 1;
+          for (int t = 0; t < ndims; t++) {
+            cell[t]  = (t == d ? (s ? box->hi[d] : box->lo[d]-1) : box->lo[t]+index[t]);
+            local[t] = (t == d ? face : cell[t]) - sim[0].mpi.is[t];
+            if ((local[t] < 0) || (local[t] >= solver->dim_local[t])) owner = 0;
+          }
+          /* the last face of the domain is owned by the last rank */
+          if ((face == N[d]) && (sim[0].mpi.ie[d] == N[d])) {
+            owner = 1;
+            for (int t = 0; t < ndims; t++) {
+              if ((t != d) && ((local[t] < 0) || (local[t] >= solver->dim_local[t]))) owner = 0;
+            }
+          }
+          long c = -1;
+          if (box->cf[2*d+s]) { _ArrayIndex1D_(ndims,N,cell,0,c); }
+          reg->dir[k]    = d;
+          reg->side[k]   = s;
+          reg->cell[k]   = c;
+          reg->weight[k] = (s ? -1.0 : 1.0);
+          if (owner) { _ArrayIndex1D_(ndims,dim_interface,local,0,reg->index[k]); }
+          k++;
+          _ArrayIncrementIndex_(ndims,bounds,index,done);
+        }
+      }
+    }
+  }
+
+  /* registers of the patches */
+  for (int p = 0; p < amr->npatches; p++) {
+    HyPar         *solver_p = &(patches[p].solver);
+    MPIVariables  *mpi_p    = &(patches[p].mpi);
+    AMRPatch      *box      = (AMRPatch*) solver_p->amr_patch;
+    int           *Np       = solver_p->dim_global;
+
+    nfaces = 0;
+    for (int d = 0; d < ndims; d++) {
+      int n = 1;
+      for (int t = 0; t < ndims; t++) if (t != d) n *= Np[t];
+      for (int s = 0; s < 2; s++) if (box->cf[2*d+s] || (!solver->isPeriodic[d])) nfaces += n;
+    }
+    FluxRegister *reg_p = (FluxRegister*) calloc (1,sizeof(FluxRegister));
+    FluxRegisterCreate(reg_p,nfaces,nvars);
+
+    k = 0;
+    for (int d = 0; d < ndims; d++) {
+      for (int s = 0; s < 2; s++) {
+        if ((!box->cf[2*d+s]) && solver->isPeriodic[d]) continue;
+        int bounds[ndims], index[ndims], cell[ndims], local[ndims], dim_interface[ndims];
+        for (int t = 0; t < ndims; t++) bounds[t] = (t == d ? 1 : Np[t]);
+        _ArrayCopy1D_(solver_p->dim_local,dim_interface,ndims); dim_interface[d]++;
+        int on_this_rank = (s ? (mpi_p->ie[d] == Np[d]) : (mpi_p->is[d] == 0));
+        int done = 0; _ArraySetValue_(index,ndims,0);
+        while (!done) {
+          int owner = on_this_rank;
+          for (int t = 0; t < ndims; t++) {
+            if (t == d) {
+              cell[t]  = (s ? box->hi[d] : box->lo[d]-1);
+              local[t] = (s ? solver_p->dim_local[d] : 0);
+            } else {
+              cell[t]  = box->lo[t] + index[t]/_AMR_RATIO_;
+              local[t] = index[t] - mpi_p->is[t];
+              if ((local[t] < 0) || (local[t] >= solver_p->dim_local[t])) owner = 0;
+            }
+          }
+          long c = -1;
+          if (box->cf[2*d+s]) { _ArrayIndex1D_(ndims,N,cell,0,c); }
+          reg_p->dir[k]    = d;
+          reg_p->side[k]   = s;
+          reg_p->cell[k]   = c;
+          reg_p->weight[k] = (s ? 1.0 : -1.0) / nchildren;
+          if (owner) { _ArrayIndex1D_(ndims,dim_interface,local,0,reg_p->index[k]); }
+          k++;
+          _ArrayIncrementIndex_(ndims,bounds,index,done);
+        }
+      }
+    }
+    solver_p->flux_register = reg_p;
+  }
+
+  return(0);
+}
+
+/*! Free the new patches and the gathered solutions of the previous patches when AMRRegrid() fails
+    before the new patches replace the previous ones (which are then kept). The new patches are
+    cleaned up by Cleanup() if their initialization is complete; otherwise, their boxes and the array
+    of simulation objects are freed. */
+static int AMRRegridAbort(int                   ierr,     /*!< Error code to return */
+                          SimulationObject      *patches, /*!< New patches (may be NULL) */
+                          int                   npatches, /*!< Number of new patches */
+                          int                   complete, /*!< Is the initialization of the new patches complete? */
+                          std::vector<double*>  &uold     /*!< Gathered solutions of the previous patches */
+                         )
+{
+  for (size_t q = 0; q < uold.size(); q++) if (uold[q]) free(uold[q]);
+  if (patches) {
+    if (complete) {
+      Cleanup(patches,npatches);
+    } else {
+      for (int p = 0; p < npatches; p++) {
+        if (patches[p].solver.amr_patch) {
+          AMRPatchCleanup((AMRPatch*)patches[p].solver.amr_patch);
+          free(patches[p].solver.amr_patch);
+        }
+      }
+    }
+    free(patches);
+  }
+  MPIProfilerEnd("AMRRegrid",0);
+  return(ierr);
+}
+
+/*!
+  Rebuild the patches of the adaptive mesh refinement (see amr.h) from the simulation solution
+  at the beginning of the time step (#AMRObject::ug_old): the cells of the simulation grid are
+  tagged, the tagged cells are covered by boxes (see AMRBoxes()), and a patch is created for each
+  box as a simulation object (like the coarse levels of the grid sequencing, see GridSequencing()):
+  + its parameters are those of the simulation (see AMRPatchSetParameters()), its grid refines
+    its box (see AMRPatchGrid()), and it has the boundary conditions of the simulation on the
+    physical boundaries (the boundary zones on the coarse-fine interfaces are disabled, see
+    AMRPatchBoundaryConditions());
+  + its initial solution is interpolated from the simulation solution, or copied from the
+    previous patches where they overlap (see AMRPatchInitialSolution());
+  + its solution is written to \b op_amr_<p>.
+
+  The flux registers are rebuilt (see AMRFluxRegisters()), and the patches are integrated in
+  time by one time integration object. The tagging and clustering are done on rank 0.
+*/
+int AMRRegrid(void *a /*!< AMR object of type #AMRObject */)
+{
+  AMRObject         *amr    = (AMRObject*) a;
+  SimulationObject  *sim    = (SimulationObject*) amr->sim;
+  HyPar             *solver = &(sim[0].solver);
+  MPIVariables      *mpi    = &(sim[0].mpi);
+  int               ndims   = solver->ndims;
+  int               nvars   = solver->nvars;
+  int               *N      = solver->dim_global;
+  int               ierr;
+
+  MPIProfilerBegin("AMRRegrid");
+
+  /* boxes of the new patches */
+  std::vector<AMRBox> boxes;
+  if (!mpi->rank) AMRBoxes(amr,solver,mpi,boxes);
+  int npatches = boxes.size();
+  MPIBroadcast_integer(&npatches,1,0,&mpi->world);
+  std::vector<int> box_data(2*ndims*npatches);
+  if (!mpi->rank) {
+    for (int p = 0; p < npatches; p++) {
+      for (int i = 0; i < 2*ndims; i++) box_data[2*ndims*p+i] = boxes[p][i];
+    }
+  }
+  if (npatches) MPIBroadcast_integer(box_data.data(),2*ndims*npatches,0,&mpi->world);
+
+  if (!mpi->rank) {
+    double ncells = 0;
+    for (int p = 0; p < npatches; p++) {
+      double n = 1;
+      for (int d = 0; d < ndims; d++) n *= (double) (box_data[2*ndims*p+ndims+d]-box_data[2*ndims*p+d]);
+      ncells += n;
+    }
+    printf("AMR: %d patch(es) covering %.2f%% of the domain.\n",
+           npatches, 100.0*ncells/((double)solver->npoints_global));
+  }
+
+  /* gather the solutions of the previous patches */
+  SimulationObject *old = (SimulationObject*) amr->patches;
+  std::vector<double*> uold(amr->npatches,(double*)NULL);
+  for (int q = 0; q < amr->npatches; q++) {
+    if (!mpi->rank) uold[q] = (double*) calloc (old[q].solver.npoints_global*nvars,sizeof(double));
+    MPIGatherArraynD( ndims,
+                      &(old[q].mpi),
+                      uold[q],
+                      old[q].solver.u,
+                      old[q].solver.dim_global,
+                      old[q].solver.dim_local,
+                      old[q].solver.ghosts,
+                      nvars );
+  }
+
+  /* create the new patches */
+  SimulationObject *patches = NULL;
+  if (npatches) {
+    patches = (SimulationObject*) calloc (npatches,sizeof(SimulationObject));
+    for (int p = 0; p < npatches; p++) {
+      int dim[ndims];
+      for (int d = 0; d < ndims; d++) {
+        dim[d] = _AMR_RATIO_ * (box_data[2*ndims*p+ndims+d] - box_data[2*ndims*p+d]);
+      }
+      AMRPatchSetParameters(&patches[p],&sim[0],dim);
+    }
+    ierr = Initialize(patches,npatches);
+    if (ierr) return(AMRRegridAbort(ierr,patches,npatches,0,uold));
+
+    for (int p = 0; p < npatches; p++) {
+      AMRPatch *box = (AMRPatch*) calloc (1,sizeof(AMRPatch));
+      box->lo = (int*) calloc (ndims,sizeof(int));
+      box->hi = (int*) calloc (ndims,sizeof(int));
+      box->cf = (int*) calloc (2*ndims,sizeof(int));
+      for (int d = 0; d < ndims; d++) {
+        box->lo[d] = box_data[2*ndims*p+d];
+        box->hi[d] = box_data[2*ndims*p+ndims+d];
+        box->cf[2*d+0] = (box->lo[d] > 0);
+        box->cf[2*d+1] = (box->hi[d] < N[d]);
+      }
+      patches[p].solver.amr_patch = box;
+      ierr = AMRPatchGrid(amr,&patches[p]);
+      if (ierr) return(AMRRegridAbort(ierr,patches,npatches,0,uold));
+    }
+
+    ierr = InitializeBoundaries(patches,npatches);
+    if (ierr) return(AMRRegridAbort(ierr,patches,npatches,0,uold));
+    for (int p = 0; p < npatches; p++) {
+      /* no periodic images across the coarse-fine interfaces */
+      AMRPatch *box = (AMRPatch*) patches[p].solver.amr_patch;
+      for (int d = 0; d < ndims; d++) {
+        if (box->cf[2*d] || box->cf[2*d+1]) {
+          patches[p].solver.isPeriodic[d] = 0;
+          patches[p].mpi.bcperiodic[d] = 0;
+        }
+      }
+    }
+    ierr = InitializeImmersedBoundaries(patches,npatches);
+    if (ierr) return(AMRRegridAbort(ierr,patches,npatches,0,uold));
+
+    for (int p = 0; p < npatches; p++) {
+      ierr = AMRPatchInitialSolution(amr,&patches[p],old,uold);
+      if (ierr) return(AMRRegridAbort(ierr,patches,npatches,0,uold));
+    }
+
+    ierr = InitializeSolvers(patches,npatches);
+    if (ierr) return(AMRRegridAbort(ierr,patches,npatches,0,uold));
+    for (int p = 0; p < npatches; p++) {
+      char index[_MAX_STRING_SIZE_];
+      GetStringFromInteger(p,index,(int)log10(npatches)+1);
+      strcpy(patches[p].solver.op_fname_root,"op_amr_");
+      strcat(patches[p].solver.op_fname_root,index);
+      patches[p].solver.ApplyBoundaryConditions = AMRPatchBoundaryConditions;
+    }
+    ierr = InitializePhysics(patches,npatches);
+    if (ierr) return(AMRRegridAbort(ierr,patches,npatches,0,uold));
+    for (int p = 0; p < npatches; p++) {
+      ierr = InitializePhysicsData(&patches[p],p,npatches,patches[p].solver.dim_global);
+      if (ierr) return(AMRRegridAbort(ierr,patches,npatches,1,uold));
+      ierr = AMRPatchCoarseFine(&patches[p]);
+      if (ierr) return(AMRRegridAbort(ierr,patches,npatches,1,uold));
+    }
+  }
+
+  /* delete the previous patches */
+  for (int q = 0; q < amr->npatches; q++) if (uold[q]) free(uold[q]);
+  if (amr->npatches) {
+    TimeCleanup(amr->ts_patches);
+    Cleanup(amr->patches,amr->npatches);
+    free(amr->patches);
+  }
+  amr->npatches = npatches;
+  amr->patches  = patches;
+
+  ierr = AMRFluxRegisters(amr);
+  if (ierr) {
+    MPIProfilerEnd("AMRRegrid",0);
+    return(ierr);
+  }
+
+  /* time integration of the patches */
+  if (npatches) {
+    if (!amr->ts_patches) amr->ts_patches = calloc (1,sizeof(TimeIntegration));
+    ierr = TimeInitialize(patches,npatches,mpi->rank,mpi->nproc,amr->ts_patches);
+    if (ierr) {
+      MPIProfilerEnd("AMRRegrid",0);
+      return(ierr);
+    }
+  }
+
+  MPIProfilerEnd("AMRRegrid",0);
+  return(0);
+}
@@ -6,12 +6,17 @@
 #include <stdlib.h>
 #include <string.h>
 #include <basic.h>
+#include <arrayfunctions.h>
 #include <bandedmatrix.h>
 #include <tridiagLU.h>
 #include <boundaryconditions.h>
 #include <immersedboundaries.h>
 #include <timeintegration.h>
 #include <interpolation.h>
+#include <secondderivative.h>
+#include <rhstasks.h>
+#include <insitu.h>
+#include <amr.h>
 #include <mpivars.h>
 #include <simulation_object.h>
 
@@ -153,7 +158,31 @@ int Cleanup(  void  *s,   /*!< Array of simulation objects of type #SimulationOb
       IERR CompactSchemeCleanup(solver->compact); CHECKERR(ierr);
     }
     if (solver->compact)  free(solver->compact);
+    if (solver->nonuniform) {
+      IERR NonUniformGridCleanup(solver->nonuniform); CHECKERR(ierr);
+      free(solver->nonuniform);
+    }
     if (solver->lusolver) free(solver->lusolver);
+    if (solver->eigen_cache) {
+      IERR EigenCacheCleanup(solver->eigen_cache); CHECKERR(ierr);
+      free(solver->eigen_cache);
+    }
+    if (solver->rhs_tasks) {
+      IERR RHSTasksCleanup(solver->rhs_tasks,solver->ndims); CHECKERR(ierr);
+      free(solver->rhs_tasks);
+    }
+    if (solver->insitu) {
+      IERR InSituCleanup(solver->insitu); CHECKERR(ierr);
+      free(solver->insitu);
+    }
+    if (solver->flux_register) {
+      IERR FluxRegisterCleanup(solver->flux_register); CHECKERR(ierr);
+      free(solver->flux_register);
+    }
+    if (solver->amr_patch) {
+      IERR AMRPatchCleanup(solver->amr_patch); CHECKERR(ierr);
+      free(solver->amr_patch);
+    }
 
     /* Free the communicators created */
     IERR MPIFreeCommunicators(solver->ndims,mpi); CHECKERR(ierr);
@@ -163,7 +192,7 @@ int Cleanup(  void  *s,   /*!< Array of simulation objects of type #SimulationOb
     free(solver->dim_global_ex);
     free(solver->dim_local);
     free(solver->index);
-    free(solver->u);
+    ArrayFree(solver->u);
 #ifdef with_petsc
     if (solver->u0)     free(solver->u0);
     if (solver->uref)   free(solver->uref);
@@ -216,18 +245,18 @@ int Cleanup(  void  *s,   /*!< Array of simulation objects of type #SimulationOb
       gpuFree(solver->gpu_u);
     } else {
 #endif
-      free(solver->hyp);
-      free(solver->par);
-      free(solver->source);
-      free(solver->uC);
-      free(solver->fluxC);
-      free(solver->Deriv1);
-      free(solver->Deriv2);
-      free(solver->fluxI);
-      free(solver->uL);
-      free(solver->uR);
-      free(solver->fL);
-      free(solver->fR);
+      ArrayFree(solver->hyp);
+      ArrayFree(solver->par);
+      ArrayFree(solver->source);
+      ArrayFree(solver->uC);
+      ArrayFree(solver->fluxC);
+      ArrayFree(solver->Deriv1);
+      ArrayFree(solver->Deriv2);
+      ArrayFree(solver->fluxI);
+      ArrayFree(solver->uL);
+      ArrayFree(solver->uR);
+      ArrayFree(solver->fL);
+      ArrayFree(solver->fR);
       free(solver->StageBoundaryIntegral);
       free(solver->StepBoundaryIntegral);
 #if defined(HAVE_CUDA)
@@ -0,0 +1,431 @@
+/*! @file GridSequencing.cpp
+    @author Debojyoti Ghosh
+    @brief Grid sequencing for the steady-state mode
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <basic.h>
+#include <arrayfunctions.h>
+#include <mathfunctions_cpp.h>
+#include <mpivars_cpp.h>
+#include <timeintegration_cpp.h>
+#include <simulation.h>
+
+/*! Compute the inverse of the grid spacing, including its ghost values */
+extern "C" int ComputeGridSpacing(void*,void*);
+
+/*! Set the solver parameters (stuff that is usually read in from solver.inp) of a
+    coarse simulation object of the grid sequencing: the global grid size is specified,
+    and all other parameters are the same as the source (fine) simulation object,
+    except that the time step is scaled with the grid spacing, and the conservation
+    check, the residual file and the grid sequencing itself are turned off. */
+static void GridSequencingSetParameters(SimulationObject        *dst,   /*!< Coarse simulation object */
+                                        const SimulationObject  *src,   /*!< Fine simulation object */
+                                        const int               *dim,   /*!< Global grid size of the coarse object */
+                                        int                     level   /*!< Coarsening level */
+                                       )
+{
+  dst->solver.my_idx = src->solver.my_idx;
+  dst->solver.nsims = src->solver.nsims;
+
+  dst->mpi.rank = src->mpi.rank;
+  dst->mpi.nproc = src->mpi.nproc;
+
+  dst->solver.ndims = src->solver.ndims;
+  dst->solver.nvars = src->solver.nvars;
+  dst->solver.ghosts = src->solver.ghosts;
+
+  dst->solver.dim_global    = (int*) calloc (dst->solver.ndims,sizeof(int));
+  dst->solver.dim_global_ex = (int*) calloc (dst->solver.ndims,sizeof(int));
+  dst->mpi.iproc            = (int*) calloc (dst->solver.ndims,sizeof(int));
+  for (int d = 0; d < dst->solver.ndims; d++) {
+    dst->solver.dim_global[d] = dst->solver.dim_global_ex[d] = dim[d];
+    dst->mpi.iproc[d] = src->mpi.iproc[d];
+  }
+
+  dst->solver.n_iter       = src->solver.n_iter;
+  dst->solver.restart_iter = 0;
+
+  strcpy(dst->solver.time_scheme, src->solver.time_scheme);
+  strcpy(dst->solver.time_scheme_type, src->solver.time_scheme_type);
+  strcpy(dst->solver.spatial_scheme_hyp, src->solver.spatial_scheme_hyp);
+  strcpy(dst->solver.SplitHyperbolicFlux, src->solver.SplitHyperbolicFlux);
+  strcpy(dst->solver.interp_type, src->solver.interp_type);
+  strcpy(dst->solver.eigen_cache_type, src->solver.eigen_cache_type);
+  strcpy(dst->solver.spatial_type_par, src->solver.spatial_type_par);
+  strcpy(dst->solver.spatial_scheme_par, src->solver.spatial_scheme_par);
+
+  dst->solver.dt = src->solver.dt * (double) (1 << level);
+
+  strcpy(dst->solver.ConservationCheck, "no");
+
+  dst->solver.screen_op_iter = src->solver.screen_op_iter;
+  dst->solver.file_op_iter = src->solver.file_op_iter;
+  dst->solver.write_residual = 0;
+
+  strcpy(dst->solver.op_file_format, src->solver.op_file_format);
+  strcpy(dst->solver.ip_file_type, src->solver.ip_file_type);
+
+  strcpy(dst->solver.input_mode, src->solver.input_mode);
+  strcpy(dst->solver.output_mode, src->solver.output_mode);
+  dst->mpi.N_IORanks = src->mpi.N_IORanks;
+
+  strcpy(dst->solver.op_overwrite, src->solver.op_overwrite);
+  strcpy(dst->solver.plot_solution, src->solver.plot_solution);
+  strcpy(dst->solver.profile, src->solver.profile);
+  strcpy(dst->solver.mixed_precision, src->solver.mixed_precision);
+  strcpy(dst->solver.nonuniform_grid, src->solver.nonuniform_grid);
+  strcpy(dst->solver.model, src->solver.model);
+  strcpy(dst->solver.ib_filename, src->solver.ib_filename);
+
+  dst->solver.flag_ib = src->solver.flag_ib;
+
+  dst->solver.local_dt_cfl    = src->solver.local_dt_cfl;
+  dst->solver.residual_drop   = src->solver.residual_drop;
+  dst->solver.grid_sequencing = 0;
+  dst->solver.gs_level        = level;
+
+#if defined(HAVE_CUDA)
+  dst->solver.use_gpu       = src->solver.use_gpu;
+  dst->solver.gpu_device_no = src->solver.gpu_device_no;
+#endif
+
+#ifndef serial
+  MPI_Comm_dup(MPI_COMM_WORLD, &(dst->mpi.world));
+#endif
+}
+
+/*! Compute the grid of a coarse simulation object by averaging the points of the grid of
+    a finer simulation object in blocks of 2^l points along each dimension (where 2^l is
+    the ratio of their grid sizes), and then its grid spacing. Along each dimension, the
+    fine grid is summed over the ranks along that dimension (like the global grid of the
+    adaptive mesh refinement, see AMRInitialize()), and each rank coarsens its local part. */
+static int GridSequencingCoarsenGrid( SimulationObject        *dst, /*!< Coarse simulation object */
+                                      const SimulationObject  *src  /*!< Fine simulation object */
+                                    )
+{
+  int ndims = src->solver.ndims;
+  int offset_src = 0, offset_dst = 0;
+
+  for (int d = 0; d < ndims; d++) {
+
+    int n_src = src->solver.dim_global[d];
+    int n_dst = dst->solver.dim_global[d];
+    int stride = n_src / n_dst;
+
+    double *xl_src = (double*) calloc (n_src, sizeof(double));
+    double *xg_src = (double*) calloc (n_src, sizeof(double));
+    for (int i = 0; i < src->solver.dim_local[d]; i++) {
+      xl_src[src->mpi.is[d]+i] = src->solver.x[offset_src+src->solver.ghosts+i];
+    }
+#ifndef serial
+    MPI_Allreduce(xl_src,xg_src,n_src,MPI_DOUBLE,MPI_SUM,src->mpi.comm[d]);
+#else
+    _ArrayCopy1D_(xl_src,xg_src,n_src);
+#endif
+    for (int i = 0; i < dst->solver.dim_local[d]; i++) {
+      int ig = dst->mpi.is[d] + i;
+      double xsum = 0;
+      for (int j = 0; j < stride; j++) xsum += xg_src[ig*stride+j];
+      dst->solver.x[offset_dst+dst->solver.ghosts+i] = xsum / ((double) stride);
+    }
+    free(xl_src);
+    free(xg_src);
+
+    /* exchange MPI-boundary values of x between processors */
+    MPIExchangeBoundaries1D(  (void*) &(dst->mpi),
+                              &(dst->solver.x[offset_dst]),
+                              dst->solver.dim_local[d],
+                              dst->solver.ghosts,
+                              d,
+                              ndims );
+
+    /* fill in ghost values of x at physical boundaries by extrapolation */
+    double *X      = &(dst->solver.x[offset_dst]);
+    int    *dim    = dst->solver.dim_local;
+    int    ghosts  = dst->solver.ghosts;
+    if (dst->mpi.ip[d] == 0) {
+      for (int i = 0; i < ghosts; i++) {
+        int delta = ghosts - i;
+        X[i] = X[ghosts] + ((double) delta) * (X[ghosts]-X[ghosts+1]);
+      }
+    }
+    if (dst->mpi.ip[d] == dst->mpi.iproc[d]-1) {
+      for (int i = dim[d]+ghosts; i < dim[d]+2*ghosts; i++) {
+        int delta = i - (dim[d]+ghosts-1);
+        X[i] =  X[dim[d]+ghosts-1]
+                + ((double) delta) * (X[dim[d]+ghosts-1]-X[dim[d]+ghosts-2]);
+      }
+    }
+
+    offset_src += (src->solver.dim_local[d] + 2*src->solver.ghosts);
+    offset_dst += (dst->solver.dim_local[d] + 2*dst->solver.ghosts);
+  }
+
+  return ComputeGridSpacing(&(dst->solver),&(dst->mpi));
+}
+
+/*! Interpolate the solution of a simulation object onto another simulation object of the
+    grid sequencing (coarsening or refining it by a factor of 2^l along each dimension), with
+    the same operators as InterpolateGlobalnDVar(), on each rank: the block of the source
+    solution that the interpolation to the local domain of the destination needs (see
+    InterpolateLocalSourceBlock()) is fetched from the ranks that own it (see
+    MPIGetArrayBlocknD()), extrapolated outside the domain along the non-periodic dimensions
+    (see InterpolateLocalExtrapolate()), and interpolated to the local domain (see
+    InterpolateLocalnDVar()). */
+static int GridSequencingInterpolate( SimulationObject        *dst, /*!< Destination simulation object */
+                                      const SimulationObject  *src  /*!< Source simulation object */
+                                    )
+{
+  int ndims     = src->solver.ndims;
+  int nvars     = src->solver.nvars;
+  int ghosts    = src->solver.ghosts;
+  int *periodic = src->solver.isPeriodic;
+  int retval, retval_global;
+
+  /* block of the source solution needed on this rank */
+  int is_src[ndims], dim_src[ndims];
+  retval = InterpolateLocalSourceBlock( ndims,
+                                        dst->solver.dim_global,
+                                        src->solver.dim_global,
+                                        dst->mpi.is,
+                                        dst->mpi.ie,
+                                        periodic,
+                                        is_src,
+                                        dim_src );
+  MPIMax_integer(&retval_global,&retval,1,(void*)&(dst->mpi.world));
+  if (retval_global) {
+    if (retval) fprintf(stderr,"Error in GridSequencingInterpolate(): InterpolateLocalSourceBlock() returned with error!\n");
+    return retval_global;
+  }
+
+  long size = (long) nvars;
+  for (int d = 0; d < ndims; d++) size *= (long) dim_src[d];
+  double *u_src = (double*) calloc (size, sizeof(double));
+  MPIGetArrayBlocknD( ndims,
+                      nvars,
+                      src->solver.dim_global,
+                      src->solver.dim_local,
+                      ghosts,
+                      periodic,
+                      (void*) &(src->mpi),
+                      src->solver.u,
+                      is_src,
+                      dim_src,
+                      u_src );
+  InterpolateLocalExtrapolate(ndims, nvars, src->solver.dim_global, periodic, is_src, dim_src, u_src);
+
+  /* interpolate it to the local domain */
+  retval = InterpolateLocalnDVar( dst->solver.dim_local,
+                                  dst->mpi.is,
+                                  dst->solver.dim_global,
+                                  dst->solver.u,
+                                  dim_src,
+                                  is_src,
+                                  src->solver.dim_global,
+                                  u_src,
+                                  nvars,
+                                  ghosts,
+                                  ndims );
+  free(u_src);
+  MPIMax_integer(&retval_global,&retval,1,(void*)&(dst->mpi.world));
+  if (retval_global) {
+    if (retval) fprintf(stderr,"Error in GridSequencingInterpolate(): InterpolateLocalnDVar() returned with error!\n");
+    return retval_global;
+  }
+
+  MPIExchangeBoundariesnD(  ndims,
+                            nvars,
+                            dst->solver.dim_local,
+                            ghosts,
+                            (void*) &(dst->mpi),
+                            dst->solver.u );
+  return 0;
+}
+
+/*! Iterate the simulation objects of a coarse level of the grid sequencing in time until
+    the norm of the change in the solution drops by #HyPar::residual_drop (or for
+    #HyPar::n_iter time steps). No solution files are written. */
+static int GridSequencingSolve( SimulationObject  *sim,   /*!< Array of coarse simulation objects */
+                                int               nsims,  /*!< Number of simulation objects */
+                                int               rank,   /*!< MPI rank of this process */
+                                int               nproc   /*!< Number of MPI processes */
+                              )
+{
+  TimeIntegration TS;
+  int ierr = TimeInitialize(sim, nsims, rank, nproc, &TS);
+  if (ierr) return ierr;
+
+  for (TS.iter = TS.restart_iter; TS.iter < TS.n_iter; TS.iter++) {
+    ierr = TimePreStep (&TS);
+    if (!ierr) ierr = TimeStep    (&TS);
+    if (!ierr) ierr = TimePostStep(&TS);
+    if (ierr) {
+      fprintf(stderr,"Error in GridSequencingSolve(): time integration failed at iteration %d of level %d on rank %d.\n",
+              TS.iter+1, sim[0].solver.gs_level, rank);
+      TimeCleanup(&TS);
+      return ierr;
+    }
+    TimePrintStep(&TS);
+    if (TS.converged) break;
+  }
+
+  if (!rank) {
+    printf("Grid sequencing: level %d (grid size", sim[0].solver.gs_level);
+    for (int d = 0; d < sim[0].solver.ndims; d++) printf(" %d", sim[0].solver.dim_global[d]);
+    printf(") %s after %d iterations, norm=%1.4E.\n",
+           (TS.converged ? "converged" : "stopped"),
+           (TS.converged ? TS.norm_iter : TS.n_iter), TS.norm);
+  }
+
+  TimeCleanup(&TS);
+  return 0;
+}
+
+/*! Free the simulation objects of the grid sequencing when GridSequencing() fails: the
+    objects of the finest completed level are cleaned up by Cleanup(); the objects of the
+    level being set up are cleaned up by Cleanup() if their initialization is complete,
+    and otherwise only the array of simulation objects is freed (like AMRRegridAbort()). */
+static int GridSequencingAbort( int               ierr,     /*!< Error code to return */
+                                int               *lmax,    /*!< Maximum coarsening levels */
+                                SimulationObject  *coarse,  /*!< Simulation objects of the level being set up (may be NULL) */
+                                int               complete, /*!< Is the initialization of the level being set up complete? */
+                                SimulationObject  *fine,    /*!< Simulation objects of the finest completed level (may be NULL) */
+                                int               nsims     /*!< Number of simulation objects */
+                              )
+{
+  if (coarse) {
+    if (complete) Cleanup(coarse, nsims);
+    free(coarse);
+  }
+  if (fine) {
+    Cleanup(fine, nsims);
+    free(fine);
+  }
+  free(lmax);
+  return ierr;
+}
+
+/*! Grid sequencing for the steady-state mode: before the time integration on the simulation
+    grid, the solution is converged on a sequence of coarser grids, each coarsened from the
+    next finer one by a factor of 2 along each dimension, and the converged coarse solution
+    is interpolated to the next finer grid as its initial solution. The number of coarse
+    levels is #HyPar::grid_sequencing, reduced if a grid dimension cannot be halved any further
+    (it must be even, and the coarse grid must have at least #HyPar::ghosts points on each
+    MPI rank along that dimension).
+
+    The coarse simulation objects are created with the same inputs as the simulation
+    objects (solver.inp, boundary.inp, physics.inp, etc), and their grids are coarsened
+    from the simulation grid. Their initial solution is the solution coarsened from the
+    simulation grid. Each level is iterated until the norm of the change in the solution
+    drops by #HyPar::residual_drop, or for #HyPar::n_iter time steps.
+
+    The grid and the solution are transferred between the levels by each rank for its local
+    domain (see GridSequencingCoarsenGrid() and GridSequencingInterpolate()); no rank holds
+    a global array.
+*/
+int GridSequencing( void  *s,     /*!< Array of simulation objects of type #SimulationObject */
+                    int   nsims,  /*!< Number of simulation objects */
+                    int   rank,   /*!< MPI rank of this process */
+                    int   nproc   /*!< Number of MPI processes */
+                  )
+{
+  SimulationObject *sim = (SimulationObject*) s;
+  int ndims = sim[0].solver.ndims;
+  int ierr;
+
+  /* maximum coarsening level along each dimension of each simulation */
+  int *lmax = (int*) calloc (nsims*ndims, sizeof(int));
+  int nlevels = sim[0].solver.grid_sequencing;
+  for (int ns = 0; ns < nsims; ns++) {
+    int lmax_sim = 0;
+    for (int d = 0; d < ndims; d++) {
+      int n = sim[ns].solver.dim_global[d], l = 0;
+      while (     (l < sim[0].solver.grid_sequencing)
+              &&  (n%2 == 0)
+              &&  (n/2 >= sim[ns].mpi.iproc[d]*sim[ns].solver.ghosts) ) {
+        n /= 2;
+        l++;
+      }
+      lmax[ns*ndims+d] = l;
+      lmax_sim = std::max(lmax_sim, l);
+    }
+    nlevels = std::min(nlevels, lmax_sim);
+  }
+  if (nlevels < sim[0].solver.grid_sequencing) {
+    if (!rank) {
+      fprintf(stderr,"Warning in GridSequencing(): the grid can be coarsened only %d times; ", nlevels);
+      fprintf(stderr,"the number of grid sequencing levels is reduced to %d.\n", nlevels);
+    }
+  }
+  if (nlevels == 0) {
+    free(lmax);
+    return 0;
+  }
+
+  SimulationObject *fine = NULL;
+  for (int level = nlevels; level > 0; level--) {
+
+    if (!rank) printf("Grid sequencing: setting up level %d.\n", level);
+    SimulationObject *coarse = (SimulationObject*) calloc (nsims, sizeof(SimulationObject));
+
+    for (int ns = 0; ns < nsims; ns++) {
+      int dim[ndims];
+      for (int d = 0; d < ndims; d++) {
+        dim[d] = sim[ns].solver.dim_global[d] >> std::min(level, lmax[ns*ndims+d]);
+      }
+      GridSequencingSetParameters(&coarse[ns], &sim[ns], dim, level);
+    }
+
+    ierr = Initialize(coarse, nsims);
+    if (ierr) return GridSequencingAbort(ierr, lmax, coarse, 0, fine, nsims);
+    for (int ns = 0; ns < nsims; ns++) {
+      ierr = GridSequencingCoarsenGrid(&coarse[ns], &sim[ns]);
+      if (ierr) return GridSequencingAbort(ierr, lmax, coarse, 0, fine, nsims);
+    }
+    ierr = InitializeBoundaries(coarse, nsims);
+    if (ierr) return GridSequencingAbort(ierr, lmax, coarse, 0, fine, nsims);
+    ierr = InitializeImmersedBoundaries(coarse, nsims);
+    if (ierr) return GridSequencingAbort(ierr, lmax, coarse, 0, fine, nsims);
+
+    /* initial solution: the simulation solution on the coarsest level, and the solution
+       of the previous (coarser) level otherwise */
+    for (int ns = 0; ns < nsims; ns++) {
+      ierr = GridSequencingInterpolate(&coarse[ns], (fine ? &fine[ns] : &sim[ns]));
+      if (ierr) return GridSequencingAbort(ierr, lmax, coarse, 0, fine, nsims);
+    }
+
+    ierr = InitializeSolvers(coarse, nsims);
+    if (ierr) return GridSequencingAbort(ierr, lmax, coarse, 0, fine, nsims);
+    ierr = InitializePhysics(coarse, nsims);
+    if (ierr) return GridSequencingAbort(ierr, lmax, coarse, 0, fine, nsims);
+    for (int ns = 0; ns < nsims; ns++) {
+      ierr = InitializePhysicsData(&coarse[ns], ns, nsims, sim[ns].solver.dim_global);
+      if (ierr) return GridSequencingAbort(ierr, lmax, coarse, 1, fine, nsims);
+    }
+
+    if (fine) {
+      Cleanup(fine, nsims);
+      free(fine);
+    }
+    fine = coarse;
+
+    ierr = GridSequencingSolve(fine, nsims, rank, nproc);
+    if (ierr) return GridSequencingAbort(ierr, lmax, NULL, 0, fine, nsims);
+  }
+
+  /* initial solution on the simulation grid */
+  for (int ns = 0; ns < nsims; ns++) {
+    ierr = GridSequencingInterpolate(&sim[ns], &fine[ns]);
+    if (ierr) return GridSequencingAbort(ierr, lmax, NULL, 0, fine, nsims);
+  }
+  Cleanup(fine, nsims);
+  free(fine);
+  free(lmax);
+
+  if (!rank) printf("Grid sequencing: done.\n");
+  return 0;
+}
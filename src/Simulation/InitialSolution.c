@@ -15,11 +15,92 @@
 #include <arrayfunctions.h>
 #endif
 #include <io.h>
+#include <mathfunctions.h>
 #include <mpivars.h>
 #include <simulation_object.h>
 
 int VolumeIntegral(double*,double*,void*,void*);
 
+/*! Compute the inverse of the grid spacing (#HyPar::dxinv) from the grid (#HyPar::x),
+    including its ghost values.
+
+    On a non-uniform grid (#HyPar::nonuniform_grid), the grid spacing is the metric
+    \f$dx/d\xi\f$ of the mapping from the uniform grid of the indices \f$\xi\f$, computed with
+    the widest central finite-difference stencil that the ghost points allow (6th order with 3
+    ghost points; the stencils are shifted inside the domain at the physical boundaries, where the
+    ghost values of the grid are extrapolated). The uniform-grid reconstructions and first
+    derivatives, multiplied by #HyPar::dxinv, then retain their order of accuracy on a smoothly
+    stretched grid; the second-order approximation \f$(x_{i+1}-x_{i-1})/2\f$ of the metric would
+    limit them to second order.*/
+int ComputeGridSpacing( void  *s, /*!< Solver object of type #HyPar */
+                        void  *m  /*!< MPI object of type #MPIVariables */
+                      )
+{
+  HyPar         *solver = (HyPar*) s;
+  MPIVariables  *mpi    = (MPIVariables*) m;
+  int           ghosts  = solver->ghosts;
+  int           *dim    = solver->dim_local;
+  int           d, i, j, offset, ierr;
+
+  offset = 0;
+  for (d = 0; d < solver->ndims; d++) {
+    for (i = 0; i < dim[d]; i++) {
+      solver->dxinv[i+offset+ghosts]
+        = 2.0 / (solver->x[i+1+offset+ghosts]-solver->x[i-1+offset+ghosts]);
+    }
+    if (!strcmp(solver->nonuniform_grid,"yes")) {
+      /* range of the points (with ghosts) that can be used by the stencils */
+      int lo    = (mpi->ip[d] == 0                ? ghosts        : 0              );
+      int hi    = (mpi->ip[d] == mpi->iproc[d]-1  ? ghosts+dim[d] : dim[d]+2*ghosts);
+      int width = min(2*ghosts+1,hi-lo);
+      if (width >= 3) {
+        double xi[width], weights[2*width];
+        for (j = 0; j < width; j++) xi[j] = (double) j;
+        for (i = 0; i < dim[d]; i++) {
+          int start = i + ghosts - width/2;
+          if (start < lo)       start = lo;
+          if (start > hi-width) start = hi-width;
+          FornbergWeights((double)(i+ghosts-start),xi,width,1,weights);
+          double dxdxi = 0;
+          for (j = 0; j < width; j++) dxdxi += weights[width+j] * solver->x[start+j+offset];
+          solver->dxinv[i+offset+ghosts] = 1.0 / dxdxi;
+        }
+      }
+    }
+    offset += (dim[d] + 2*ghosts);
+  }
+
+  /* exchange MPI-boundary values of dxinv between processors */
+  offset = 0;
+  for (d = 0; d < solver->ndims; d++) {
+    ierr = MPIExchangeBoundaries1D( mpi,
+                                    &(solver->dxinv[offset]),
+                                    dim[d],
+                                    ghosts,
+                                    d,
+                                    solver->ndims ); CHECKERR(ierr);
+    if (ierr) return ierr;
+    offset += (dim[d] + 2*ghosts);
+  }
+
+  /* fill in ghost values of dxinv at physical boundaries by extrapolation */
+  offset = 0;
+  for (d = 0; d < solver->ndims; d++) {
+    double *dxinv = &(solver->dxinv[offset]);
+    if (mpi->ip[d] == 0) {
+      /* fill left boundary along this dimension */
+      for (i = 0; i < ghosts; i++) dxinv[i] = dxinv[ghosts];
+    }
+    if (mpi->ip[d] == mpi->iproc[d]-1) {
+      /* fill right boundary along this dimension */
+      for (i = dim[d]+ghosts; i < dim[d]+2*ghosts; i++) dxinv[i] = dxinv[dim[d]+ghosts-1];
+    }
+    offset  += (dim[d] + 2*ghosts);
+  }
+
+  return(0);
+}
+
 /*! Read in initial solution from file, and compute grid spacing
     and volume integral of the initial solution */
 int InitialSolution ( void  *s,   /*!< Array of simulation objects of type #SimulationObject */
@@ -27,12 +108,10 @@ int InitialSolution ( void  *s,   /*!< Array of simulation objects of type #Simu
                     )
 {
   SimulationObject* simobj = (SimulationObject*) s;
-  int n, flag, d, i, offset, ierr;
+  int n, flag, d, ierr;
 
   for (n = 0; n < nsims; n++) {
 
-    int ghosts = simobj[n].solver.ghosts;
-
     char fname_root[_MAX_STRING_SIZE_] = "initial";
     if (nsims > 1) {
       char index[_MAX_STRING_SIZE_];
@@ -72,46 +151,11 @@ int InitialSolution ( void  *s,   /*!< Array of simulation objects of type #Simu
                               simobj[n].solver.u  );
 
     /* calculate dxinv */
-    offset = 0;
-    for (d = 0; d < simobj[n].solver.ndims; d++) {
-      for (i = 0; i < simobj[n].solver.dim_local[d]; i++) {
-        simobj[n].solver.dxinv[i+offset+ghosts]
-          = 2.0 / (simobj[n].solver.x[i+1+offset+ghosts]-simobj[n].solver.x[i-1+offset+ghosts]);
-      }
-      offset += (simobj[n].solver.dim_local[d] + 2*ghosts);
-    }
-
-    /* exchange MPI-boundary values of dxinv between processors */
-    offset = 0;
-    for (d = 0; d < simobj[n].solver.ndims; d++) {
-      ierr = MPIExchangeBoundaries1D( &(simobj[n].mpi),
-                                      &(simobj[n].solver.dxinv[offset]),
-                                      simobj[n].solver.dim_local[d],
-                                      ghosts,
-                                      d,
-                                      simobj[n].solver.ndims ); CHECKERR(ierr);
-      if (ierr) {
-        fprintf(stderr, "Error in InitialSolution() on rank %d.\n",
-                simobj[n].mpi.rank);
-        return ierr;
-      }
-      offset += (simobj[n].solver.dim_local[d] + 2*ghosts);
-    }
-
-    /* fill in ghost values of dxinv at physical boundaries by extrapolation */
-    offset = 0;
-    for (d = 0; d < simobj[n].solver.ndims; d++) {
-      double *dxinv = &(simobj[n].solver.dxinv[offset]);
-      int    *dim = simobj[n].solver.dim_local;
-      if (simobj[n].mpi.ip[d] == 0) {
-        /* fill left boundary along this dimension */
-        for (i = 0; i < ghosts; i++) dxinv[i] = dxinv[ghosts];
-      }
-      if (simobj[n].mpi.ip[d] == simobj[n].mpi.iproc[d]-1) {
-        /* fill right boundary along this dimension */
-        for (i = dim[d]+ghosts; i < dim[d]+2*ghosts; i++) dxinv[i] = dxinv[dim[d]+ghosts-1];
-      }
-      offset  += (dim[d] + 2*ghosts);
+    ierr = ComputeGridSpacing(&(simobj[n].solver),&(simobj[n].mpi));
+    if (ierr) {
+      fprintf(stderr, "Error in InitialSolution() on rank %d.\n",
+              simobj[n].mpi.rank);
+      return ierr;
     }
 
     /* calculate volume integral of the initial solution */
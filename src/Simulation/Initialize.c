@@ -157,7 +157,8 @@ int Initialize( void *s,    /*!< Array of simulation objects of type #Simulation
       size *= (simobj[n].solver.dim_local[i]+2*simobj[n].solver.ghosts);
     }
     simobj[n].solver.ndof_cells_wghosts = simobj[n].solver.nvars*size;
-    simobj[n].solver.u = (double*) calloc (simobj[n].solver.nvars*size,sizeof(double));
+    simobj[n].solver.u = ArrayAllocateGrid(simobj[n].solver.nvars*size,simobj[n].solver.ndims,simobj[n].solver.dim_local,
+                                           simobj[n].solver.ghosts,simobj[n].solver.nvars,0,"u");
 #if defined(HAVE_CUDA)
     if (simobj[n].solver.use_gpu) {
       gpuMalloc((void**)&simobj[n].solver.gpu_u, simobj[n].solver.nvars*size*sizeof(double));
@@ -175,10 +176,6 @@ int Initialize( void *s,    /*!< Array of simulation objects of type #Simulation
 #ifdef with_librom
     simobj[n].solver.u_rom_predicted = (double*) calloc (simobj[n].solver.nvars*size,sizeof(double));
 #endif
-    simobj[n].solver.hyp     = (double*) calloc (simobj[n].solver.nvars*size,sizeof(double));
-    simobj[n].solver.par     = (double*) calloc (simobj[n].solver.nvars*size,sizeof(double));
-    simobj[n].solver.source  = (double*) calloc (simobj[n].solver.nvars*size,sizeof(double));
-    simobj[n].solver.iblank  = (double*) calloc (size              ,sizeof(double));
 
 #if defined(HAVE_CUDA)
     if (simobj[n].solver.use_gpu) {
@@ -190,9 +187,19 @@ int Initialize( void *s,    /*!< Array of simulation objects of type #Simulation
       gpuMemset(simobj[n].solver.source, 0, simobj[n].solver.nvars*size*sizeof(double));
     } else {
 #endif
-      simobj[n].solver.hyp     = (double*) calloc (simobj[n].solver.nvars*size,sizeof(double));
-      simobj[n].solver.par     = (double*) calloc (simobj[n].solver.nvars*size,sizeof(double));
-      simobj[n].solver.source  = (double*) calloc (simobj[n].solver.nvars*size,sizeof(double));
+      /* the explicit right-hand-side is assembled in place (FusedRHSFunction()); the separate
+         hyperbolic term is needed only by the PETSc time integrators */
+      simobj[n].solver.hyp     = NULL;
+#ifdef with_petsc
+      if (simobj[n].solver.use_petscTS) {
+        simobj[n].solver.hyp   = ArrayAllocateGrid(simobj[n].solver.nvars*size,simobj[n].solver.ndims,simobj[n].solver.dim_local,
+                                                   simobj[n].solver.ghosts,simobj[n].solver.nvars,0,"hyp");
+      }
+#endif
+      simobj[n].solver.par     = ArrayAllocateGrid(simobj[n].solver.nvars*size,simobj[n].solver.ndims,simobj[n].solver.dim_local,
+                                                   simobj[n].solver.ghosts,simobj[n].solver.nvars,0,"par");
+      simobj[n].solver.source  = ArrayAllocateGrid(simobj[n].solver.nvars*size,simobj[n].solver.ndims,simobj[n].solver.dim_local,
+                                                   simobj[n].solver.ghosts,simobj[n].solver.nvars,0,"source");
 #if defined(HAVE_CUDA)
     }
 #endif
@@ -239,10 +246,14 @@ int Initialize( void *s,    /*!< Array of simulation objects of type #Simulation
       gpuMemset(simobj[n].solver.Deriv2, 0, simobj[n].solver.nvars*size*sizeof(double));
     } else {
 #endif
-      simobj[n].solver.uC     = (double*) calloc (simobj[n].solver.nvars*size,sizeof(double));
-      simobj[n].solver.fluxC  = (double*) calloc (simobj[n].solver.nvars*size,sizeof(double));
-      simobj[n].solver.Deriv1 = (double*) calloc (simobj[n].solver.nvars*size,sizeof(double));
-      simobj[n].solver.Deriv2 = (double*) calloc (simobj[n].solver.nvars*size,sizeof(double));
+      simobj[n].solver.uC     = ArrayAllocateGrid(simobj[n].solver.nvars*size,simobj[n].solver.ndims,simobj[n].solver.dim_local,
+                                                  simobj[n].solver.ghosts,simobj[n].solver.nvars,0,"uC");
+      simobj[n].solver.fluxC  = ArrayAllocateGrid(simobj[n].solver.nvars*size,simobj[n].solver.ndims,simobj[n].solver.dim_local,
+                                                  simobj[n].solver.ghosts,simobj[n].solver.nvars,0,"fluxC");
+      simobj[n].solver.Deriv1 = ArrayAllocateGrid(simobj[n].solver.nvars*size,simobj[n].solver.ndims,simobj[n].solver.dim_local,
+                                                  simobj[n].solver.ghosts,simobj[n].solver.nvars,0,"Deriv1");
+      simobj[n].solver.Deriv2 = ArrayAllocateGrid(simobj[n].solver.nvars*size,simobj[n].solver.ndims,simobj[n].solver.dim_local,
+                                                  simobj[n].solver.ghosts,simobj[n].solver.nvars,0,"Deriv2");
 #if defined(HAVE_CUDA)
     }
 #endif
@@ -251,6 +262,10 @@ int Initialize( void *s,    /*!< Array of simulation objects of type #Simulation
     size = 1;  for (i=0; i<simobj[n].solver.ndims; i++) size *= (simobj[n].solver.dim_local[i]+1);
     size *= simobj[n].solver.nvars;
     simobj[n].solver.ndof_nodes = size;
+    /* these arrays hold the interfaces along one dimension at a time; they are placed for
+       the layout of the interfaces along the first dimension */
+    int bounds_inter[simobj[n].solver.ndims];
+    _ArrayCopy1D_(simobj[n].solver.dim_local,bounds_inter,simobj[n].solver.ndims); bounds_inter[0] += 1;
 #if defined(HAVE_CUDA)
     if (simobj[n].solver.use_gpu) {
       gpuMalloc((void**)&simobj[n].solver.fluxI, size*sizeof(double));
@@ -265,11 +280,11 @@ int Initialize( void *s,    /*!< Array of simulation objects of type #Simulation
       gpuMemset(simobj[n].solver.fR, 0, size*sizeof(double));
     } else {
 #endif
-      simobj[n].solver.fluxI = (double*) calloc (size,sizeof(double));
-      simobj[n].solver.uL    = (double*) calloc (size,sizeof(double));
-      simobj[n].solver.uR    = (double*) calloc (size,sizeof(double));
-      simobj[n].solver.fL    = (double*) calloc (size,sizeof(double));
-      simobj[n].solver.fR    = (double*) calloc (size,sizeof(double));
+      simobj[n].solver.fluxI = ArrayAllocateGrid(size,simobj[n].solver.ndims,bounds_inter,0,simobj[n].solver.nvars,0,"fluxI");
+      simobj[n].solver.uL    = ArrayAllocateGrid(size,simobj[n].solver.ndims,bounds_inter,0,simobj[n].solver.nvars,0,"uL");
+      simobj[n].solver.uR    = ArrayAllocateGrid(size,simobj[n].solver.ndims,bounds_inter,0,simobj[n].solver.nvars,0,"uR");
+      simobj[n].solver.fL    = ArrayAllocateGrid(size,simobj[n].solver.ndims,bounds_inter,0,simobj[n].solver.nvars,0,"fL");
+      simobj[n].solver.fR    = ArrayAllocateGrid(size,simobj[n].solver.ndims,bounds_inter,0,simobj[n].solver.nvars,0,"fR");
 #if defined(HAVE_CUDA)
     }
 #endif
@@ -305,6 +320,10 @@ int Initialize( void *s,    /*!< Array of simulation objects of type #Simulation
     simobj[n].solver.TotalBoundaryIntegral = (double*) calloc (simobj[n].solver.nvars,sizeof(double));
     simobj[n].solver.ConservationError     = (double*) calloc (simobj[n].solver.nvars,sizeof(double));
     for (i=0; i<simobj[n].solver.nvars; i++) simobj[n].solver.ConservationError[i] = -1;
+
+    /* no adaptive mesh refinement (see AMRInitialize()) */
+    simobj[n].solver.flux_register = NULL;
+    simobj[n].solver.amr_patch     = NULL;
 #if defined(HAVE_CUDA)
     if (simobj[n].solver.use_gpu) {
       int total_offset = 0;
@@ -16,6 +16,7 @@
 #include <boundaryconditions.h>
 #include <mpivars.h>
 #include <simulation_object.h>
+#include <amr.h>
 
 static int CalculateLocalExtent(void*,void*);
 
@@ -353,6 +354,20 @@ int InitializeBoundaries( void  *s,   /*!< Array of simulation objects of type #
 #endif
     }
 
+    /* pre-compute the index lists of the ghost points of each boundary condition,
+       and group the zones that can be applied in one sweep */
+#if defined(HAVE_CUDA)
+    if (!solver->use_gpu) {
+#endif
+      for (nb = 0; nb < solver->nBoundaryZones; nb++) {
+        IERR BCIndexLists(&boundary[nb],mpi,solver->ndims,solver->dim_local,solver->ghosts);
+        CHECKERR(ierr);
+      }
+      IERR BCGroupZones(boundary,solver->nBoundaryZones); CHECKERR(ierr);
+#if defined(HAVE_CUDA)
+    }
+#endif
+
   }
 
   return 0;
@@ -393,6 +408,11 @@ int CalculateLocalExtent(
         if ((ie-is) <= 0) boundary[n].on_this_proc = 0;
         offset += solver->dim_local[d] + 2*solver->ghosts;
       }
+    } else if (     solver->amr_patch
+                &&  (((AMRPatch*)solver->amr_patch)->cf[2*dim+(boundary[n].face == 1 ? 0 : 1)]) ) {
+      /* the face is a coarse-fine interface of an adaptive mesh refinement patch (see
+         AMRPatchBoundaryConditions()) */
+      boundary[n].on_this_proc = 0;
     } else {
       /* other boundary conditions */
       if (boundary[n].face == 1) {
@@ -5,6 +5,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <arrayfunctions.h>
 #include <mathfunctions.h>
 #include <immersedboundaries.h>
@@ -12,7 +13,152 @@
 #include <mpivars.h>
 #include <simulation_object.h>
 
-/*! Initialize the immersed boundaries, if present.
+/*! Set the blanking array (#HyPar::iblank) at the ghost points: at ghost points
+    corresponding to the physical boundary, extrapolate from the interior, and at interior
+    (MPI) boundaries, exchange it across MPI ranks. */
+static void IBFillGhostIBlank(HyPar        *solver, /*!< Solver object of type #HyPar */
+                              MPIVariables *mpi     /*!< MPI object of type #MPIVariables */
+                             )
+{
+  int ndims = solver->ndims, ghosts = solver->ghosts, d,
+      *dim_local = solver->dim_local;
+
+  /* At ghost points corresponding to the physical boundary, extrapolate from the interior
+     (this should also work for bodies that are adjacent to physical boundaries). */
+  int indexb[ndims], indexi[ndims], bounds[ndims], offset[ndims];
+  for (d = 0; d < ndims; d++) {
+    /* left boundary */
+    if (!mpi->ip[d]) {
+      _ArrayCopy1D_(dim_local,bounds,ndims); bounds[d] = ghosts;
+      _ArraySetValue_(offset,ndims,0); offset[d] = -ghosts;
+      int done = 0; _ArraySetValue_(indexb,ndims,0);
+      while (!done) {
+        _ArrayCopy1D_(indexb,indexi,ndims); indexi[d] = ghosts-1-indexb[d];
+        int p1; _ArrayIndex1DWO_(ndims,dim_local,indexb,offset,ghosts,p1);
+        int p2; _ArrayIndex1D_  (ndims,dim_local,indexi,ghosts,p2);
+        solver->iblank[p1] = solver->iblank[p2];
+        _ArrayIncrementIndex_(ndims,bounds,indexb,done);
+      }
+    }
+    /* right boundary */
+    if (mpi->ip[d] == mpi->iproc[d]-1) {
+      _ArrayCopy1D_(dim_local,bounds,ndims); bounds[d] = ghosts;
+      _ArraySetValue_(offset,ndims,0); offset[d] = dim_local[d];
+      int done = 0; _ArraySetValue_(indexb,ndims,0);
+      while (!done) {
+        _ArrayCopy1D_(indexb,indexi,ndims); indexi[d] = dim_local[d]-1-indexb[d];
+        int p1; _ArrayIndex1DWO_(ndims,dim_local,indexb,offset,ghosts,p1);
+        int p2; _ArrayIndex1D_  (ndims,dim_local,indexi,ghosts,p2);
+        solver->iblank[p1] = solver->iblank[p2];
+        _ArrayIncrementIndex_(ndims,bounds,indexb,done);
+      }
+    }
+  }
+  MPIExchangeBoundariesnD(ndims,1,dim_local,ghosts,mpi,solver->iblank);
+}
+
+/*! Initialize the immersed boundary for a 2D simulation with a 2D immersed body (#Body2D):
+    + Read in the immersed body (closed curves) from file (IBReadBody2D()).
+    + Identify blanked-out grid points of the local grid (IBIdentifyBody2D()).
+    + Identify and make a list of immersed boundary points on each rank.
+    + For each immersed boundary point, find the "nearest" segment, and compute the
+      bilinear interpolation coefficients.
+
+    All the steps work on the local grid, so that the setup cost is that of a 2D
+    simulation. Surface data output is not available for 2D bodies.
+*/
+static int InitializeImmersedBoundary2D(HyPar        *solver, /*!< Solver object of type #HyPar */
+                                        MPIVariables *mpi,    /*!< MPI object of type #MPIVariables */
+                                        int          n,       /*!< Domain index */
+                                        int          nsims    /*!< Number of simulation objects */
+                                       )
+{
+  ImmersedBoundary *ib   = NULL;
+  Body2D           *body = NULL;
+
+  int stat, count;
+
+  /* Read in immersed body from file */
+  IBReadBody2D(&body,solver->ib_filename,mpi,&stat);
+  if (stat) {
+    if (!mpi->rank) {
+      fprintf(stderr,"Error in InitializeImmersedBoundaries(): Unable to ");
+      fprintf(stderr,"read immersed body from file %s.\n",solver->ib_filename);
+    }
+    solver->flag_ib = 0;
+    solver->ib = NULL;
+    return(1);
+  }
+  IBComputeBoundingBox2D(body);
+
+  /* allocate immersed boundary object and set it up */
+  ib = (ImmersedBoundary*) calloc (1, sizeof(ImmersedBoundary));
+  ib->ndims     = _IB_NDIMS_2D_;
+  ib->tolerance = 1e-12;
+  ib->delta     = 1e-6;
+  ib->itr_max   = 500;
+  ib->body2d    = body;
+  strcpy(ib->mode,_IB_2D_);
+  solver->ib    = ib;
+
+  int *dim_local = solver->dim_local,
+      ghosts     = solver->ghosts;
+
+  /* identify grid points inside the immersed body */
+  int count_inside_body = 0;
+  count = IBIdentifyBody2D(ib,dim_local,ghosts,solver->x,solver->iblank);
+  MPISum_integer(&count_inside_body,&count,1,&mpi->world);
+  IBFillGhostIBlank(solver,mpi);
+
+  /* identify and create a list of immersed boundary points on each rank */
+  int count_boundary_points = 0;
+  count = IBIdentifyBoundary(ib,mpi,dim_local,ghosts,solver->iblank);
+  MPISum_integer(&count_boundary_points,&count,1,&mpi->world);
+
+  /* find the nearest segment for each immersed boundary point */
+  double ld, xmin, xmax, ymin, ymax;
+  _GetCoordinate_(0,0             ,dim_local,ghosts,solver->x,xmin);
+  _GetCoordinate_(0,dim_local[0]-1,dim_local,ghosts,solver->x,xmax);
+  _GetCoordinate_(1,0             ,dim_local,ghosts,solver->x,ymin);
+  _GetCoordinate_(1,dim_local[1]-1,dim_local,ghosts,solver->x,ymax);
+  ld = max(xmax-xmin,ymax-ymin);
+  count = IBNearestSegmentNormal(ib,mpi,solver->x,ld,dim_local,ghosts);
+  if (count) {
+    fprintf(stderr, "Error in InitializeImmersedBoundaries():\n");
+    fprintf(stderr, "  IBNearestSegmentNormal() returned with error code %d on rank %d.\n",
+            count, mpi->rank);
+    return(count);
+  }
+
+  /* For the immersed boundary points, find the interior points for extrapolation,
+     and compute their interpolation coefficients */
+  count = IBInterpCoeffs2D(ib,mpi,solver->x,dim_local,ghosts,solver->iblank);
+  if (count) {
+    fprintf(stderr, "Error in InitializeImmersedBoundaries():\n");
+    fprintf(stderr, "  IBInterpCoeffs2D() returned with error code %d on rank %d.\n",
+            count, mpi->rank);
+    return(count);
+  }
+
+  /* Done */
+  if (!mpi->rank) {
+    double percentage;
+    printf("Immersed body read from %s:\n",solver->ib_filename);
+    if (nsims > 1) printf("For domain %d,\n", n);
+    printf("    Number of segments: %d\n    Bounding box: [%3.1f,%3.1lf] X [%3.1f,%3.1lf]\n",
+           body->nsegments,body->xmin,body->xmax,body->ymin,body->ymax);
+    percentage = ((double)count_inside_body)/((double)solver->npoints_global)*100.0;
+    printf("    Number of grid points inside immersed body: %d (%4.1f%%).\n",count_inside_body,percentage);
+    percentage = ((double)count_boundary_points)/((double)solver->npoints_global)*100.0;
+    printf("    Number of immersed boundary points        : %d (%4.1f%%).\n",count_boundary_points,percentage);
+    printf("    Immersed body simulation mode             : %s.\n", ib->mode);
+  }
+
+  return(0);
+}
+
+/*! Initialize the immersed boundaries, if present. For 2D simulations, see
+    InitializeImmersedBoundary2D(); for 3D simulations:
     + Read in immersed body from STL file.
     + Allocate and set up #ImmersedBoundary object.
     + Identify blanked-out grid points based on immersed body geometry.
@@ -36,11 +182,16 @@ int InitializeImmersedBoundaries( void  *s,   /*!< Array of simulation objects o
 
     int stat, d, ndims = solver->ndims;
 
-    if ((!solver->flag_ib) || (ndims != _IB_NDIMS_)) {
+    if ((!solver->flag_ib) || ((ndims != _IB_NDIMS_) && (ndims != _IB_NDIMS_2D_))) {
       solver->ib = NULL;
       continue;
     }
 
+    if (ndims == _IB_NDIMS_2D_) {
+      IERR InitializeImmersedBoundary2D(solver,mpi,n,nsims); CHECKERR(ierr);
+      continue;
+    }
+
     /* Read in immersed body from file */
     IBReadBodySTL(&body,solver->ib_filename,mpi,&stat);
     if (stat) {
@@ -56,6 +207,7 @@ int InitializeImmersedBoundaries( void  *s,   /*!< Array of simulation objects o
 
     /* allocate immersed boundary object and set it up */
     ib = (ImmersedBoundary*) calloc (1, sizeof(ImmersedBoundary));
+    ib->ndims     = _IB_NDIMS_;
     ib->tolerance = 1e-12;
     ib->delta     = 1e-6;
     ib->itr_max   = 500;
@@ -91,40 +243,7 @@ int InitializeImmersedBoundaries( void  *s,   /*!< Array of simulation objects o
     MPISum_integer(&count_inside_body,&count,1,&mpi->world);
     free(Xg);
 
-    /* At ghost points corresponding to the physical boundary, extrapolate from the interior
-       (this should also work for bodies that are adjacent to physical boundaries). At interior
-       (MPI) boundaries, exchange iblank across MPI ranks.
-    */
-    int indexb[ndims], indexi[ndims], bounds[ndims], offset[ndims];
-    for (d = 0; d < ndims; d++) {
-      /* left boundary */
-      if (!mpi->ip[d]) {
-        _ArrayCopy1D_(dim_local,bounds,ndims); bounds[d] = ghosts;
-        _ArraySetValue_(offset,ndims,0); offset[d] = -ghosts;
-        int done = 0; _ArraySetValue_(indexb,ndims,0);
-        while (!done) {
-          _ArrayCopy1D_(indexb,indexi,ndims); indexi[d] = ghosts-1-indexb[d];
-          int p1; _ArrayIndex1DWO_(ndims,dim_local,indexb,offset,ghosts,p1);
-          int p2; _ArrayIndex1D_  (ndims,dim_local,indexi,ghosts,p2);
-          solver->iblank[p1] = solver->iblank[p2];
-          _ArrayIncrementIndex_(ndims,bounds,indexb,done);
-        }
-      }
-      /* right boundary */
-      if (mpi->ip[d] == mpi->iproc[d]-1) {
-        _ArrayCopy1D_(dim_local,bounds,ndims); bounds[d] = ghosts;
-        _ArraySetValue_(offset,ndims,0); offset[d] = dim_local[d];
-        int done = 0; _ArraySetValue_(indexb,ndims,0);
-        while (!done) {
-          _ArrayCopy1D_(indexb,indexi,ndims); indexi[d] = dim_local[d]-1-indexb[d];
-          int p1; _ArrayIndex1DWO_(ndims,dim_local,indexb,offset,ghosts,p1);
-          int p2; _ArrayIndex1D_  (ndims,dim_local,indexi,ghosts,p2);
-          solver->iblank[p1] = solver->iblank[p2];
-          _ArrayIncrementIndex_(ndims,bounds,indexb,done);
-        }
-      }
-    }
-    MPIExchangeBoundariesnD(ndims,1,dim_local,ghosts,mpi,solver->iblank);
+    IBFillGhostIBlank(solver,mpi);
 
     /* identify and create a list of immersed boundary points on each rank */
     int count_boundary_points = 0;
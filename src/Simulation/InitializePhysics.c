@@ -57,6 +57,7 @@ int InitializePhysics(  void  *s,   /*!< Array of simulation objects of type #Si
     /* Initialize physics-specific functions to NULL */
     solver->ComputeCFL            = NULL;
     solver->ComputeDiffNumber     = NULL;
+    solver->ComputeLocalCFL       = NULL;
     solver->FFunction             = NULL;
     solver->dFFunction            = NULL;
     solver->FdFFunction           = NULL;
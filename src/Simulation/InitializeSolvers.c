@@ -13,6 +13,9 @@
 #include <firstderivative.h>
 #include <secondderivative.h>
 #include <mpivars.h>
+#include <rhskernels.h>
+#include <rhstasks.h>
+#include <insitu.h>
 #include <simulation_object.h>
 
 #ifdef with_python
@@ -26,11 +29,20 @@ int  HyperbolicFunction          (double*,double*,void*,void*,double,int,
                                   int(*)(double*,double*,int,void*,double),
                                   int(*)(double*,double*,double*,double*,double*,
                                          double*,int,void*,double));
+int  HyperbolicFunctionAccumulate(double*,double,double*,void*,void*,double,int,
+                                  int(*)(double*,double*,int,void*,double),
+                                  int(*)(double*,double*,double*,double*,double*,
+                                         double*,int,void*,double));
 int  ParabolicFunctionNC1Stage   (double*,double*,void*,void*,double);
 int  ParabolicFunctionNC2Stage   (double*,double*,void*,void*,double);
 int  ParabolicFunctionNC1_5Stage (double*,double*,void*,void*,double);
 int  ParabolicFunctionCons1Stage (double*,double*,void*,void*,double);
+int  ParabolicFunctionNC1StageAccumulate   (double*,double,double*,void*,void*,double);
+int  ParabolicFunctionNC2StageAccumulate   (double*,double,double*,void*,void*,double);
+int  ParabolicFunctionNC1_5StageAccumulate (double*,double,double*,void*,void*,double);
+int  ParabolicFunctionCons1StageAccumulate (double*,double,double*,void*,void*,double);
 int  SourceFunction              (double*,double*,void*,void*,double);
+int  SourceFunctionAccumulate    (double*,double,double*,void*,void*,double);
 int  VolumeIntegral              (double*,double*,void*,void*);
 int  BoundaryIntegral            (void*,void*);
 int  CalculateConservationError  (void*,void*);
@@ -73,20 +85,26 @@ int InitializeSolvers(  void  *s,   /*!< Array of simulation objects of type #Si
     solver->SourceFunction = SourceFunction;
 #if defined(HAVE_CUDA)
     if (solver->use_gpu) {
-      solver->HyperbolicFunction = gpuHyperbolicFunction;
+      solver->HyperbolicFunction            = gpuHyperbolicFunction;
+      solver->HyperbolicFunctionAccumulate  = NULL;
+      solver->SourceFunctionAccumulate      = NULL;
     } else {
 #endif
-      solver->HyperbolicFunction = HyperbolicFunction;
+      solver->HyperbolicFunction            = HyperbolicFunction;
+      solver->HyperbolicFunctionAccumulate  = HyperbolicFunctionAccumulate;
+      solver->SourceFunctionAccumulate      = SourceFunctionAccumulate;
 #if defined(HAVE_CUDA)
     }
 #endif
+    solver->HyperbolicFluxDifference    = NULL;
     solver->VolumeIntegralFunction      = VolumeIntegral;
     solver->BoundaryIntegralFunction    = BoundaryIntegral;
     solver->CalculateConservationError  = CalculateConservationError;
     solver->NonlinearInterp             = NonLinearInterpolation;
 
     /* choose the type of parabolic discretization */
-    solver->ParabolicFunction         = NULL;
+    solver->ParabolicFunction           = NULL;
+    solver->ParabolicFunctionAccumulate = NULL;
     solver->SecondDerivativePar       = NULL;
     solver->FirstDerivativePar        = NULL;
     solver->InterpolateInterfacesPar  = NULL;
@@ -114,6 +132,7 @@ int InitializeSolvers(  void  *s,   /*!< Array of simulation objects of type #Si
       if (!strcmp(solver->spatial_type_par,_NC_1STAGE_)) {
 
         solver->ParabolicFunction = ParabolicFunctionNC1Stage;
+        solver->ParabolicFunctionAccumulate = ParabolicFunctionNC1StageAccumulate;
         if (!strcmp(solver->spatial_scheme_par,_SECOND_ORDER_CENTRAL_)) {
           solver->SecondDerivativePar      = SecondDerivativeSecondOrderCentral;
         } else if (!strcmp(solver->spatial_scheme_par,_FOURTH_ORDER_CENTRAL_)) {
@@ -128,6 +147,7 @@ int InitializeSolvers(  void  *s,   /*!< Array of simulation objects of type #Si
       } else if (!strcmp(solver->spatial_type_par,_NC_2STAGE_)) {
 
         solver->ParabolicFunction = ParabolicFunctionNC2Stage;
+        solver->ParabolicFunctionAccumulate = ParabolicFunctionNC2StageAccumulate;
         if (!strcmp(solver->spatial_scheme_par,_SECOND_ORDER_CENTRAL_)) {
           solver->FirstDerivativePar       = FirstDerivativeFirstOrder;
           /* why first order? see ParabolicFunctionNC2Stage.c. 2nd order central
@@ -149,6 +169,7 @@ int InitializeSolvers(  void  *s,   /*!< Array of simulation objects of type #Si
       } else if (!strcmp(solver->spatial_type_par,_NC_1_5STAGE_)) {
 
         solver->ParabolicFunction = ParabolicFunctionNC1_5Stage;
+        solver->ParabolicFunctionAccumulate = ParabolicFunctionNC1_5StageAccumulate;
         if (!strcmp(solver->spatial_scheme_par,_SECOND_ORDER_CENTRAL_)) {
           solver->FirstDerivativePar       = FirstDerivativeSecondOrderCentral;
           solver->SecondDerivativePar      = SecondDerivativeSecondOrderCentral;
@@ -165,6 +186,7 @@ int InitializeSolvers(  void  *s,   /*!< Array of simulation objects of type #Si
       } else if (!strcmp(solver->spatial_type_par,_CONS_1STAGE_)) {
 
         solver->ParabolicFunction = ParabolicFunctionCons1Stage;
+        solver->ParabolicFunctionAccumulate = ParabolicFunctionCons1StageAccumulate;
         if (!strcmp(solver->spatial_scheme_par,_SECOND_ORDER_CENTRAL_)) {
           solver->InterpolateInterfacesPar = Interp2PrimSecondOrder;
         } else {
@@ -190,7 +212,12 @@ int InitializeSolvers(  void  *s,   /*!< Array of simulation objects of type #Si
     /* Spatial interpolation for hyperbolic term */
     solver->interp                = NULL;
     solver->compact               = NULL;
+    solver->nonuniform            = NULL;
     solver->lusolver              = NULL;
+    solver->eigen_cache           = NULL;
+    solver->rhs_tasks             = NULL;
+    solver->insitu                = NULL;
+    solver->local_dt              = NULL;
     solver->SetInterpLimiterVar   = NULL;
     solver->flag_nonlinearinterp  = 1;
     if (strcmp(solver->interp_type,_CHARACTERISTIC_) && strcmp(solver->interp_type,_COMPONENTS_)) {
@@ -351,10 +378,41 @@ int InitializeSolvers(  void  *s,   /*!< Array of simulation objects of type #Si
         return(1);
       }
 
+      /* Coefficients of the second derivative on a non-uniform grid */
+      if (!strcmp(solver->nonuniform_grid,"yes")) {
+        solver->nonuniform = (NonUniformGrid*) calloc (1,sizeof(NonUniformGrid));
+        IERR NonUniformGridInitialize(solver,mpi); CHECKERR(ierr);
+        if (solver->SecondDerivativePar) solver->SecondDerivativePar = SecondDerivativeNonUniform;
+      }
+
+      /* Interface eigensystem cache for characteristic-based reconstruction and upwinding */
+      if (strcmp(solver->eigen_cache_type,_EIGEN_CACHE_NONE_)) {
+        if ((solver->nvars > 1) && (!strcmp(solver->interp_type,_CHARACTERISTIC_))) {
+          solver->eigen_cache = (EigenCache*) calloc (1,sizeof(EigenCache));
+          IERR EigenCacheInitialize(solver,mpi,solver->eigen_cache_type); CHECKERR(ierr);
+        } else if (!mpi->rank) {
+          fprintf(stderr,"Warning (domain %d): eigen_cache is %s but the interpolation is not characteristic-based; ",
+                  ns, solver->eigen_cache_type);
+          fprintf(stderr,"ignoring it.\n");
+        }
+      }
+
+      /* compile-time specialized kernels for this (ndims,nvars), if available */
+      IERR RHSKernelsInitialize(solver,mpi); CHECKERR(ierr);
+
+      /* concurrent evaluation of the dimensions of the hyperbolic term with threads */
+      IERR RHSTasksInitialize(solver,mpi); CHECKERR(ierr);
+
 #if defined(HAVE_CUDA)
     }
 #endif
 
+    /* in-situ reduced outputs (probes, slices, averages, spectra), not on the coarse grids
+       of the grid sequencing or on the patches of the adaptive mesh refinement */
+    if ((!solver->gs_level) && (!solver->amr_patch)) {
+      IERR InSituInitialize(solver,mpi); CHECKERR(ierr);
+    }
+
     /* Time integration */
     solver->time_integrator = NULL;
 #ifdef with_petsc
@@ -32,6 +32,8 @@ int OutputSolution( void*   s,      /*!< Array of simulation objects of type #Si
   int ns;
   _DECLARE_IERR_;
 
+  MPIProfilerScope profiler_scope("Output");
+
   for (ns = 0; ns < nsims; ns++) {
 
     HyPar*        solver = &(simobj[ns].solver);
@@ -74,6 +76,7 @@ int OutputSolution( void*   s,      /*!< Array of simulation objects of type #Si
                         solver,
                         mpi,
                         aux_fname_root ); CHECKERR(ierr);
+      profiler_scope.addBytes((double)solver->npoints_local*solver->nvars*sizeof(double));
 
       aux_fname_root[2]++;
     }
@@ -111,6 +114,7 @@ int OutputSolution( void*   s,      /*!< Array of simulation objects of type #Si
                  solver,
                  mpi,
                  fname_root );
+    profiler_scope.addBytes((double)solver->npoints_local*solver->nvars*sizeof(double));
 
     if (!strcmp(solver->plot_solution, "yes")) {
       PlotArray(   solver->ndims,
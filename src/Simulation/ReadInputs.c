@@ -39,6 +39,7 @@
     hyp_space_scheme   | char[]       | #HyPar::spatial_scheme_hyp    | 1
     hyp_flux_split     | char[]       | #HyPar::SplitHyperbolicFlux   | no
     hyp_interp_type    | char[]       | #HyPar::interp_type           | characteristic
+    eigen_cache        | char[]       | #HyPar::eigen_cache_type      | none
     par_space_type     | char[]       | #HyPar::spatial_type_par      | nonconservative-1stage
     par_space_scheme   | char[]       | #HyPar::spatial_scheme_par    | 2
     dt                 | double       | #HyPar::dt                    | 0.0
@@ -51,6 +52,12 @@
     output_mode        | char[]       | #HyPar::output_mode           | serial
     op_overwrite       | char[]       | #HyPar::op_overwrite          | no
     plot_solution      | char[]       | #HyPar::plot_solution         | no
+    profile            | char[]       | #HyPar::profile               | no
+    mixed_precision    | char[]       | #HyPar::mixed_precision       | no
+    nonuniform_grid    | char[]       | #HyPar::nonuniform_grid       | no
+    local_dt_cfl       | double       | #HyPar::local_dt_cfl          | 0 (global time step)
+    residual_drop      | double       | #HyPar::residual_drop         | 0 (run n_iter iterations)
+    grid_sequencing    | int          | #HyPar::grid_sequencing       | 0 (none)
     model              | char[]       | #HyPar::model                 | must be specified
     immersed_body      | char[]       | #HyPar::ib_filename           | "none"
     size_exact         | int[ndims]   | #HyPar::dim_global_ex         | #HyPar::dim_global
@@ -88,7 +95,34 @@
         out and the code will not check for conservation.
       - "immersed_body" need not be specified if there are no immersed bodies present.
          \b NOTE: However, if it is specified, and a file of that filename does not
-         exist, it will result in an error.
+         exist, it will result in an error. For 3D simulations, it is an STL file (see
+         IBReadBodySTL()); for 2D simulations, it is a file of closed curves (see
+         IBReadBody2D()).
+    + "local_dt_cfl", "residual_drop", and "grid_sequencing" specify the steady-state mode
+      for problems where only the steady solution is of interest (usually with "op_overwrite"
+      set to "yes"); they can be used independently of each other:
+      - with "local_dt_cfl", each grid point is advanced with its own pseudo-time step
+        corresponding to the given CFL number (the time step "dt" must still be positive; the
+        simulation time is then a pseudo-time), if the physical model provides the local CFL
+        numbers (#HyPar::ComputeLocalCFL).
+      - with "residual_drop", the time integration stops before "n_iter" iterations when the
+        norm of the change in the solution over a time step, computed every "screen_op_iter"
+        iterations, has dropped by the given factor (for example, 1e-8) from its first value.
+      - with "grid_sequencing", the solution is first converged on the given number of coarse
+        grids, each coarsened by a factor of 2 from the next finer one, and interpolated from
+        each grid to the next finer one (see GridSequencing()).
+    + "mixed_precision" set to "yes" stores the nonlinear weights of the WENO-type schemes
+      (see WENOSetPrecision()) and the stage right-hand-sides of the explicit Runge-Kutta
+      methods (see TimeRK()) in single precision, which halves the memory (and the memory
+      traffic) of these arrays; all arithmetic, and the solution and its update, remain in
+      double precision. At the start of the time integration, the right-hand-side computed
+      this way is compared with the one computed in double precision (see
+      TimeMixedPrecisionCheck()). It is not available on GPUs.
+    + "nonuniform_grid" set to "yes" computes the grid spacing as a high-order approximation to the
+      metric of the grid in the initial solution file (see ComputeGridSpacing()), and the coefficients
+      of the second derivative from the grid (see NonUniformGridInitialize()), so that the spatial
+      discretization retains its order of accuracy on a smoothly stretched grid, for example, with
+      points clustered in a boundary layer. It is not available on GPUs.
 */
 int ReadInputs( void  *s,     /*!< Array of simulation objects of type #SimulationObject
                                    of size nsims */
@@ -105,6 +139,9 @@ int ReadInputs( void  *s,     /*!< Array of simulation objects of type #Simulati
     return(1);
   }
 
+  /* the simulation grid is the finest level of the grid sequencing (see GridSequencing()) */
+  for (n = 0; n < nsims; n++) sim[n].solver.gs_level = 0;
+
   if (!rank) {
 
     /* set some default values for optional inputs */
@@ -124,6 +161,9 @@ int ReadInputs( void  *s,     /*!< Array of simulation objects of type #Simulati
       sim[n].solver.file_op_iter    = 1000;
       sim[n].solver.write_residual  = 0;
       sim[n].solver.flag_ib         = 0;
+      sim[n].solver.local_dt_cfl    = 0.0;
+      sim[n].solver.residual_drop   = 0.0;
+      sim[n].solver.grid_sequencing = 0;
 #if defined(HAVE_CUDA)
       sim[n].solver.use_gpu         = 0;
       sim[n].solver.gpu_device_no   = -1;
@@ -134,12 +174,16 @@ int ReadInputs( void  *s,     /*!< Array of simulation objects of type #Simulati
       strcpy(sim[n].solver.spatial_type_par   ,_NC_1STAGE_     );
       strcpy(sim[n].solver.spatial_scheme_par ,"2"             );
       strcpy(sim[n].solver.interp_type        ,"characteristic");
+      strcpy(sim[n].solver.eigen_cache_type   ,"none"          );
       strcpy(sim[n].solver.ip_file_type       ,"ascii"         );
       strcpy(sim[n].solver.input_mode         ,"serial"        );
       strcpy(sim[n].solver.output_mode        ,"serial"        );
       strcpy(sim[n].solver.op_file_format     ,"text"          );
       strcpy(sim[n].solver.op_overwrite       ,"no"            );
       strcpy(sim[n].solver.plot_solution      ,"no"            );
+      strcpy(sim[n].solver.profile            ,"no"            );
+      strcpy(sim[n].solver.mixed_precision    ,"no"            );
+      strcpy(sim[n].solver.nonuniform_grid    ,"no"            );
       strcpy(sim[n].solver.model              ,"none"          );
       strcpy(sim[n].solver.ConservationCheck  ,"no"            );
       strcpy(sim[n].solver.SplitHyperbolicFlux,"no"            );
@@ -299,6 +343,13 @@ int ReadInputs( void  *s,     /*!< Array of simulation objects of type #Simulati
           int n;
           for (n = 1; n < nsims; n++) strcpy(sim[n].solver.interp_type, sim[0].solver.interp_type);
 
+        }  else if (!strcmp(word, "eigen_cache")) {
+
+          ferr = fscanf(in,"%s",sim[0].solver.eigen_cache_type);
+
+          int n;
+          for (n = 1; n < nsims; n++) strcpy(sim[n].solver.eigen_cache_type, sim[0].solver.eigen_cache_type);
+
         }  else if (!strcmp(word, "par_space_type")) {
 
           ferr = fscanf(in,"%s",sim[0].solver.spatial_type_par);
@@ -391,6 +442,48 @@ int ReadInputs( void  *s,     /*!< Array of simulation objects of type #Simulati
           int n;
           for (n = 1; n < nsims; n++) strcpy(sim[n].solver.plot_solution, sim[0].solver.plot_solution);
 
+        } else if   (!strcmp(word, "profile")) {
+
+          ferr = fscanf(in,"%s",sim[0].solver.profile);
+
+          int n;
+          for (n = 1; n < nsims; n++) strcpy(sim[n].solver.profile, sim[0].solver.profile);
+
+        } else if   (!strcmp(word, "mixed_precision")) {
+
+          ferr = fscanf(in,"%s",sim[0].solver.mixed_precision);
+
+          int n;
+          for (n = 1; n < nsims; n++) strcpy(sim[n].solver.mixed_precision, sim[0].solver.mixed_precision);
+
+        } else if   (!strcmp(word, "nonuniform_grid")) {
+
+          ferr = fscanf(in,"%s",sim[0].solver.nonuniform_grid);
+
+          int n;
+          for (n = 1; n < nsims; n++) strcpy(sim[n].solver.nonuniform_grid, sim[0].solver.nonuniform_grid);
+
+        }  else if (!strcmp(word, "local_dt_cfl")) {
+
+          ferr = fscanf(in,"%lf",&(sim[0].solver.local_dt_cfl));
+
+          int n;
+          for (n = 1; n < nsims; n++) sim[n].solver.local_dt_cfl = sim[0].solver.local_dt_cfl;
+
+        }  else if (!strcmp(word, "residual_drop")) {
+
+          ferr = fscanf(in,"%lf",&(sim[0].solver.residual_drop));
+
+          int n;
+          for (n = 1; n < nsims; n++) sim[n].solver.residual_drop = sim[0].solver.residual_drop;
+
+        }  else if (!strcmp(word, "grid_sequencing")) {
+
+          ferr = fscanf(in,"%d",&(sim[0].solver.grid_sequencing));
+
+          int n;
+          for (n = 1; n < nsims; n++) sim[n].solver.grid_sequencing = sim[0].solver.grid_sequencing;
+
         }  else if (!strcmp(word, "model")) {
 
           ferr = fscanf(in,"%s",sim[0].solver.model);
@@ -447,8 +540,25 @@ int ReadInputs( void  *s,     /*!< Array of simulation objects of type #Simulati
 
       if (sim[n].solver.screen_op_iter <= 0)  sim[n].solver.screen_op_iter = 1;
       if (sim[n].solver.file_op_iter <= 0)    sim[n].solver.file_op_iter   = sim[n].solver.n_iter;
+      if (sim[n].solver.grid_sequencing < 0)  sim[n].solver.grid_sequencing = 0;
+
+      if ((sim[n].solver.local_dt_cfl > 0) && (sim[n].solver.dt <= 0)) {
+        fprintf(stderr,"Error in ReadInputs(): \"local_dt_cfl\" requires a positive time step \"dt\".\n");
+        return(1);
+      }
+
+#if defined(HAVE_CUDA)
+      if (sim[n].solver.use_gpu && (!strcmp(sim[n].solver.mixed_precision,"yes"))) {
+        fprintf(stderr,"Error in ReadInputs(): \"mixed_precision\" is not yet implemented on GPUs.\n");
+        return(1);
+      }
+      if (sim[n].solver.use_gpu && (!strcmp(sim[n].solver.nonuniform_grid,"yes"))) {
+        fprintf(stderr,"Error in ReadInputs(): \"nonuniform_grid\" is not yet implemented on GPUs.\n");
+        return(1);
+      }
+#endif
 
-      if ((sim[n].solver.ndims != 3) && (strcmp(sim[n].solver.ib_filename,"none"))) {
+      if ((sim[n].solver.ndims != 3) && (sim[n].solver.ndims != 2) && (strcmp(sim[n].solver.ib_filename,"none"))) {
         printf("Warning: immersed boundaries not implemented for ndims = %d. ",sim[n].solver.ndims);
         printf("Ignoring input for \"immersed_body\" (%s).\n",sim[n].solver.ib_filename);
         strcpy(sim[n].solver.ib_filename,"none");
@@ -484,6 +594,7 @@ int ReadInputs( void  *s,     /*!< Array of simulation objects of type #Simulati
     MPIBroadcast_integer(&(sim[n].solver.screen_op_iter),1                  ,0,&(sim[n].mpi.world));
     MPIBroadcast_integer(&(sim[n].solver.file_op_iter)  ,1                  ,0,&(sim[n].mpi.world));
     MPIBroadcast_integer(&(sim[n].solver.flag_ib)       ,1                  ,0,&(sim[n].mpi.world));
+    MPIBroadcast_integer(&(sim[n].solver.grid_sequencing),1                 ,0,&(sim[n].mpi.world));
 #if defined(HAVE_CUDA)
     MPIBroadcast_integer(&(sim[n].solver.use_gpu)       ,1                  ,0,&(sim[n].mpi.world));
     MPIBroadcast_integer(&(sim[n].solver.gpu_device_no) ,1                  ,0,&(sim[n].mpi.world));
@@ -492,6 +603,7 @@ int ReadInputs( void  *s,     /*!< Array of simulation objects of type #Simulati
     MPIBroadcast_character(sim[n].solver.time_scheme_type   ,_MAX_STRING_SIZE_,0,&(sim[n].mpi.world));
     MPIBroadcast_character(sim[n].solver.spatial_scheme_hyp ,_MAX_STRING_SIZE_,0,&(sim[n].mpi.world));
     MPIBroadcast_character(sim[n].solver.interp_type        ,_MAX_STRING_SIZE_,0,&(sim[n].mpi.world));
+    MPIBroadcast_character(sim[n].solver.eigen_cache_type   ,_MAX_STRING_SIZE_,0,&(sim[n].mpi.world));
     MPIBroadcast_character(sim[n].solver.spatial_type_par   ,_MAX_STRING_SIZE_,0,&(sim[n].mpi.world));
     MPIBroadcast_character(sim[n].solver.spatial_scheme_par ,_MAX_STRING_SIZE_,0,&(sim[n].mpi.world));
     MPIBroadcast_character(sim[n].solver.ConservationCheck  ,_MAX_STRING_SIZE_,0,&(sim[n].mpi.world));
@@ -502,10 +614,15 @@ int ReadInputs( void  *s,     /*!< Array of simulation objects of type #Simulati
     MPIBroadcast_character(sim[n].solver.output_mode        ,_MAX_STRING_SIZE_,0,&(sim[n].mpi.world));
     MPIBroadcast_character(sim[n].solver.op_overwrite       ,_MAX_STRING_SIZE_,0,&(sim[n].mpi.world));
     MPIBroadcast_character(sim[n].solver.plot_solution      ,_MAX_STRING_SIZE_,0,&(sim[n].mpi.world));
+    MPIBroadcast_character(sim[n].solver.profile            ,_MAX_STRING_SIZE_,0,&(sim[n].mpi.world));
+    MPIBroadcast_character(sim[n].solver.mixed_precision    ,_MAX_STRING_SIZE_,0,&(sim[n].mpi.world));
+    MPIBroadcast_character(sim[n].solver.nonuniform_grid    ,_MAX_STRING_SIZE_,0,&(sim[n].mpi.world));
     MPIBroadcast_character(sim[n].solver.model              ,_MAX_STRING_SIZE_,0,&(sim[n].mpi.world));
     MPIBroadcast_character(sim[n].solver.ib_filename        ,_MAX_STRING_SIZE_,0,&(sim[n].mpi.world));
 
     MPIBroadcast_double(&(sim[n].solver.dt),1,0,&(sim[n].mpi.world));
+    MPIBroadcast_double(&(sim[n].solver.local_dt_cfl),1,0,&(sim[n].mpi.world));
+    MPIBroadcast_double(&(sim[n].solver.residual_drop),1,0,&(sim[n].mpi.world));
   }
 #endif
 
@@ -7,11 +7,14 @@
 #include <math.h>
 #include <string.h>
 #include <vector>
+#include <algorithm>
+#include <arrayfunctions.h>
 #include <common_cpp.h>
 #include <io_cpp.h>
 #include <timeintegration_cpp.h>
 #include <mpivars_cpp.h>
 #include <simulation_object.h>
+#include <amr.h>
 
 #ifdef with_librom
 #include <librom_interface.h>
@@ -22,6 +25,7 @@ extern "C" int ComputeRHSOperators(void*,void*,double);
 #endif
 extern "C" int CalculateError(void*,void*); /*!< Calculate the error in the final solution */
 int OutputSolution(void*,int,double);   /*!< Write solutions to file */
+int GridSequencing(void*,int,int,int);  /*!< Converge the solution on a sequence of coarser grids */
 extern "C" void ResetFilenameIndex(char*, int); /*!< Reset filename index */
 #ifdef with_librom
 extern "C" int CalculateROMDiff(void*,void*); /*!< Calculate the diff of PDE and ROM solutions */
@@ -52,6 +56,9 @@ int Solve(  void  *s,     /*!< Array of simulation objects of type #SimulationOb
     }
   }
 
+  /* enable the region profiler, if requested */
+  MPIProfilerEnable(!strcmp(sim[0].solver.profile,"yes"));
+
   /* write out iblank to file for visualization */
   for (int ns = 0; ns < nsims; ns++) {
     if (sim[ns].solver.flag_ib) {
@@ -87,13 +94,30 @@ int Solve(  void  *s,     /*!< Array of simulation objects of type #SimulationOb
 #ifdef with_librom
   if ((rom_mode == _ROM_MODE_TRAIN_) || (rom_mode == _ROM_MODE_NONE_)) {
 #endif
+    /* steady-state mode: converge the solution on a sequence of coarser grids first */
+    if ((sim[0].solver.grid_sequencing > 0) && (sim[0].solver.restart_iter == 0)) {
+      MPIProfilerBegin("GridSequencing");
+      int ierr = GridSequencing(sim, nsims, rank, nproc);
+      MPIProfilerEnd("GridSequencing",0);
+      if (ierr) return ierr;
+    }
+
     /* Define and initialize the time-integration object */
     TimeIntegration TS;
     if (!rank) printf("Setting up time integration.\n");
-    TimeInitialize(sim, nsims, rank, nproc, &TS);
+    if (TimeInitialize(sim, nsims, rank, nproc, &TS)) return 1;
     double ti_runtime = 0.0;
 
+    /* block-structured adaptive mesh refinement, if requested (amr.inp) */
+    void *amr = NULL;
+    if (AMRInitialize(sim, nsims, &TS, &amr)) return 1;
+
+    /* report the sizes and the NUMA placement of the solver arrays */
+    if (!rank) ArrayAllocationReport();
+
     if (!rank) printf("Solving in time (from %d to %d iterations)\n",TS.restart_iter,TS.n_iter);
+    int ierr_solve = 0; /* errors of the AMR functions end the time integration */
+    MPIProfilerBegin("Solve");
     for (TS.iter = TS.restart_iter; TS.iter < TS.n_iter; TS.iter++) {
 
       /* Write initial solution to file if this is the first iteration */
@@ -105,6 +129,11 @@ int Solve(  void  *s,     /*!< Array of simulation objects of type #SimulationOb
                                           TS.waqt );
           }
         }
+        if (AMROutputSolution(amr, TS.waqt)) {
+          if (!rank) fprintf(stderr,"Error in Solve(): AMROutputSolution() returned with an error.\n");
+          ierr_solve = 1;
+          break;
+        }
         OutputSolution(sim, nsims, TS.waqt);
 #ifdef with_librom
         op_times_arr.push_back(TS.waqt);
@@ -118,7 +147,15 @@ int Solve(  void  *s,     /*!< Array of simulation objects of type #SimulationOb
 #endif
 
       /* Call pre-step function */
+      MPIProfilerBegin("TimePreStep");
       TimePreStep (&TS);
+      int ierr_amr = AMRPreStep(amr);
+      MPIProfilerEnd("TimePreStep",0);
+      if (ierr_amr) {
+        if (!rank) fprintf(stderr,"Error in Solve(): AMRPreStep() returned with an error.\n");
+        ierr_solve = 1;
+        break;
+      }
 #ifdef compute_rhs_operators
       /* compute and write (to file) matrix operators representing the right-hand side */
 //      if (((TS.iter+1)%solver->file_op_iter == 0) || (!TS.iter))
@@ -126,15 +163,36 @@ int Solve(  void  *s,     /*!< Array of simulation objects of type #SimulationOb
 #endif
 
       /* Step in time */
+      MPIProfilerBegin("TimeStep");
       TimeStep (&TS);
+      ierr_amr = AMRStep(amr);
+      MPIProfilerEnd("TimeStep",0);
+      if (ierr_amr) {
+        if (!rank) fprintf(stderr,"Error in Solve(): AMRStep() returned with an error.\n");
+        ierr_solve = 1;
+        break;
+      }
 
       /* Call post-step function */
+      MPIProfilerBegin("TimePostStep");
       TimePostStep (&TS);
+      MPIProfilerEnd("TimePostStep",0);
 
       ti_runtime += TS.iter_wctime;
 
       /* Print information to screen */
+      MPIProfilerBegin("TimePrintStep");
       TimePrintStep(&TS);
+      MPIProfilerEnd("TimePrintStep",0);
+
+      /* steady-state mode: stop when the norm of the change in the solution has dropped */
+      if (TS.converged) {
+        if (!rank) {
+          printf("Converged at iteration %d: norm of the change in the solution dropped ", TS.norm_iter);
+          printf("from %1.4E to %1.4E.\n", TS.norm_initial, TS.norm);
+        }
+        break;
+      }
 
       /* Write intermediate solution to file */
       if (      ((TS.iter+1)%sim[0].solver.file_op_iter == 0)
@@ -146,6 +204,11 @@ int Solve(  void  *s,     /*!< Array of simulation objects of type #SimulationOb
                                           TS.waqt );
           }
         }
+        if (AMROutputSolution(amr, TS.waqt)) {
+          if (!rank) fprintf(stderr,"Error in Solve(): AMROutputSolution() returned with an error.\n");
+          ierr_solve = 1;
+          break;
+        }
         OutputSolution(sim, nsims, TS.waqt);
 #ifdef with_librom
         op_times_arr.push_back(TS.waqt);
@@ -153,9 +216,14 @@ int Solve(  void  *s,     /*!< Array of simulation objects of type #SimulationOb
       }
 
     }
+    MPIProfilerEnd("Solve",0);
 
     double t_final = TS.waqt;
     TimeCleanup(&TS);
+    if (ierr_solve) {
+      AMRCleanup(amr);
+      return 1;
+    }
 
     if (!rank) {
       printf( "Completed time integration (Final time: %f), total wctime: %f (seconds).\n",
@@ -177,7 +245,13 @@ int Solve(  void  *s,     /*!< Array of simulation objects of type #SimulationOb
                                       t_final );
       }
     }
+    int ierr_amr = AMROutputSolution(amr, t_final);
     OutputSolution(sim, nsims, t_final);
+    AMRCleanup(amr);
+    if (ierr_amr) {
+      if (!rank) fprintf(stderr,"Error in Solve(): AMROutputSolution() returned with an error.\n");
+      return 1;
+    }
 
 #ifdef with_librom
     op_times_arr.push_back(TS.waqt);
@@ -194,25 +268,33 @@ int Solve(  void  *s,     /*!< Array of simulation objects of type #SimulationOb
                         rom_interface.trainWallclockTime() );
 
       double total_rom_predict_time = 0;
-      for (int iter = 0; iter < op_times_arr.size(); iter++) {
+      int batch_size = rom_interface.predictBatchSize();
+      for (int iter0 = 0; iter0 < op_times_arr.size(); iter0 += batch_size) {
+
+        std::vector<double> times( op_times_arr.begin()+iter0,
+                                   op_times_arr.begin()+std::min(iter0+batch_size,(int)op_times_arr.size()) );
+        rom_interface.predict(sim, times);
+        if (!rank) printf(  "libROM: Predicted solution at times %1.4e to %1.4e using ROM, wallclock time: %f.\n",
+                            times.front(), times.back(), rom_interface.predictWallclockTime() );
+        total_rom_predict_time += rom_interface.predictWallclockTime();
 
-        double waqt = op_times_arr[iter];
+        for (int k = 0; k < times.size(); k++) {
 
-        rom_interface.predict(sim, waqt);
-        if (!rank) printf(  "libROM: Predicted solution at time %1.4e using ROM, wallclock time: %f.\n",
-                            waqt, rom_interface.predictWallclockTime() );
-        total_rom_predict_time += rom_interface.predictWallclockTime();
+          int iter = iter0 + k;
+          double waqt = times[k];
+          rom_interface.copyPredictionToHyPar(sim, k);
 
-        /* calculate diff between ROM and PDE solutions */
-        if (iter == (op_times_arr.size()-1)) {
-          if (!rank) printf("libROM:   Calculating diff between PDE and ROM solutions.\n");
-          for (int ns = 0; ns < nsims; ns++) {
-            CalculateROMDiff(  &(sim[ns].solver),
-                               &(sim[ns].mpi) );
+          /* calculate diff between ROM and PDE solutions */
+          if (iter == (op_times_arr.size()-1)) {
+            if (!rank) printf("libROM:   Calculating diff between PDE and ROM solutions.\n");
+            for (int ns = 0; ns < nsims; ns++) {
+              CalculateROMDiff(  &(sim[ns].solver),
+                                 &(sim[ns].mpi) );
+            }
           }
+          /* write the ROM solution to file */
+          OutputROMSolution(sim, nsims,waqt);
         }
-        /* write the ROM solution to file */
-        OutputROMSolution(sim, nsims,waqt);
 
       }
 
@@ -268,24 +350,31 @@ int Solve(  void  *s,     /*!< Array of simulation objects of type #SimulationOb
     }
 
     double total_rom_predict_time = 0;
-    for (int iter = 0; iter < op_times_arr.size(); iter++) {
+    int batch_size = rom_interface.predictBatchSize();
+    for (int iter0 = 0; iter0 < op_times_arr.size(); iter0 += batch_size) {
+
+      std::vector<double> times( op_times_arr.begin()+iter0,
+                                 op_times_arr.begin()+std::min(iter0+batch_size,(int)op_times_arr.size()) );
+      rom_interface.predict(sim, times);
+      if (!rank) printf(  "libROM: Predicted solution at times %1.4e to %1.4e using ROM, wallclock time: %f.\n",
+                          times.front(), times.back(), rom_interface.predictWallclockTime() );
+      total_rom_predict_time += rom_interface.predictWallclockTime();
 
-      double waqt = op_times_arr[iter];
+      for (int k = 0; k < times.size(); k++) {
 
-      rom_interface.predict(sim, waqt);
-      if (!rank) printf(  "libROM: Predicted solution at time %1.4e using ROM, wallclock time: %f.\n",
-                          waqt, rom_interface.predictWallclockTime() );
-      total_rom_predict_time += rom_interface.predictWallclockTime();
+        double waqt = times[k];
+        rom_interface.copyPredictionToHyPar(sim, k);
 
-      /* write the solution to file */
-      for (int ns = 0; ns < nsims; ns++) {
-        if (sim[ns].solver.PhysicsOutput) {
-          sim[ns].solver.PhysicsOutput( &(sim[ns].solver),
-                                        &(sim[ns].mpi),
-                                        waqt );
+        /* write the solution to file */
+        for (int ns = 0; ns < nsims; ns++) {
+          if (sim[ns].solver.PhysicsOutput) {
+            sim[ns].solver.PhysicsOutput( &(sim[ns].solver),
+                                          &(sim[ns].mpi),
+                                          waqt );
+          }
         }
+        OutputSolution(sim, nsims, waqt);
       }
-      OutputSolution(sim, nsims, waqt);
 
     }
 
@@ -303,5 +392,9 @@ int Solve(  void  *s,     /*!< Array of simulation objects of type #SimulationOb
   }
 #endif
 
+  /* report the profiled regions */
+  MPIProfilerReport(&(sim[0].mpi.world),"profile.json");
+  MPIProfilerEnable(0);
+
   return 0;
 }
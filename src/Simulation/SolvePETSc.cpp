@@ -12,8 +12,11 @@
 #include <stdlib.h>
 #include <math.h>
 #include <string.h>
+#include <vector>
+#include <algorithm>
 #include <basic.h>
 #include <io_cpp.h>
+#include <mpivars_cpp.h>
 #include <petscinterface.h>
 #include <simulation_object.h>
 
@@ -69,6 +72,9 @@ int SolvePETSc( void* s, /*!< Array of simulation objects of type #SimulationObj
 
   PetscFunctionBegin;
 
+  /* enable the region profiler, if requested */
+  MPIProfilerEnable(!strcmp(sim[0].solver.profile,"yes"));
+
   /* Register custom time-integration methods, if specified */
   PetscRegisterTIMethods(rank);
   if(!rank) printf("Setting up PETSc time integration... \n");
@@ -93,6 +99,11 @@ int SolvePETSc( void* s, /*!< Array of simulation objects of type #SimulationObj
   context.flag_is_linear = 0;
   context.globalDOF.clear();
   context.points.clear();
+  context.adi_blocks.clear();
+  context.adi_work.clear();
+  context.adi_lu = NULL;
+  context.precon_assembly_count = 0;
+  context.precon_assembly_wctime = 0.0;
   context.ti_runtime = 0.0;
   context.waqt = 0.0;
   context.dt = sim[0].solver.dt;
@@ -248,18 +259,16 @@ int SolvePETSc( void* s, /*!< Array of simulation objects of type #SimulationObj
           }
           /* Set up preconditioner matrix */
           flag_mat_b = 1;
-          MatCreateAIJ( MPI_COMM_WORLD,
-                        context.ndofs,
-                        context.ndofs,
-                        PETSC_DETERMINE,
-                        PETSC_DETERMINE,
-                        (sim[0].solver.ndims*2+1)*sim[0].solver.nvars, NULL,
-                        2*sim[0].solver.ndims*sim[0].solver.nvars, NULL,
-                        &B );
-          MatSetBlockSize(B,sim[0].solver.nvars);
+          PetscCreatePreconMat(&B,&context);
           /* Set the IJacobian function for TS */
           TSSetIJacobian(ts,A,B,PetscIJacobianIMEX,&context);
 
+        } else if (context.precon_matrix_type == "adi") {
+
+          /* Matrix-free Jacobian and line-implicit (ADI) preconditioner */
+          flag_mat_a = 1;
+          if (PetscPreconADICreate(ts,&A,1,&context)) PetscFunctionReturn(1);
+
         } else if (context.precon_matrix_type == "fd") {
 
           flag_mat_a = 1;
@@ -515,18 +524,16 @@ int SolvePETSc( void* s, /*!< Array of simulation objects of type #SimulationObj
           }
           /* Set up preconditioner matrix */
           flag_mat_b = 1;
-          MatCreateAIJ( MPI_COMM_WORLD,
-                        context.ndofs,
-                        context.ndofs,
-                        PETSC_DETERMINE,
-                        PETSC_DETERMINE,
-                        (sim[0].solver.ndims*2+1)*sim[0].solver.nvars, NULL,
-                        2*sim[0].solver.ndims*sim[0].solver.nvars, NULL,
-                        &B );
-          MatSetBlockSize(B,sim[0].solver.nvars);
+          PetscCreatePreconMat(&B,&context);
           /* Set the IJacobian function for TS */
           TSSetIJacobian(ts,A,B,PetscIJacobian,&context);
 
+        } else if (context.precon_matrix_type == "adi") {
+
+          /* Matrix-free Jacobian and line-implicit (ADI) preconditioner */
+          flag_mat_a = 1;
+          if (PetscPreconADICreate(ts,&A,0,&context)) PetscFunctionReturn(1);
+
         } else if (context.precon_matrix_type == "fd") {
 
           flag_mat_a = 1;
@@ -648,11 +655,22 @@ int SolvePETSc( void* s, /*!< Array of simulation objects of type #SimulationObj
 
     if (!rank) printf("** Starting PETSc time integration **\n");
     context.ti_runtime = 0.0;
+    MPIProfilerBegin("Solve");
     TSSolve(ts,Y);
+    MPIProfilerEnd("Solve",0);
     if (!rank) {
       printf("** Completed PETSc time integration (Final time: %f), total wctime: %f (seconds) **\n",
               context.waqt, context.ti_runtime );
     }
+    if ((!rank) && context.precon_assembly_count) {
+      PetscInt snes_iterations = 0;
+      TSGetSNESIterations(ts,&snes_iterations);
+      printf("PETSc:    preconditioning matrix assembled %d times, wctime: %f (seconds) ",
+              context.precon_assembly_count, context.precon_assembly_wctime );
+      printf("(%e per assembly, %e per nonlinear iteration).\n",
+              context.precon_assembly_wctime/context.precon_assembly_count,
+              context.precon_assembly_wctime/((double)(snes_iterations > 0 ? snes_iterations : 1)) );
+    }
 
     /* Get the number of time steps */
     for (int ns = 0; ns < nsims; ns++) {
@@ -736,25 +754,33 @@ int SolvePETSc( void* s, /*!< Array of simulation objects of type #SimulationObj
                         ((libROMInterface*)context.rom_interface)->trainWallclockTime() );
 
       double total_rom_predict_time = 0;
-      for (int iter = 0; iter < context.op_times_arr.size(); iter++) {
+      int batch_size = ((libROMInterface*)context.rom_interface)->predictBatchSize();
+      for (int iter0 = 0; iter0 < context.op_times_arr.size(); iter0 += batch_size) {
+
+        std::vector<double> times( context.op_times_arr.begin()+iter0,
+                                   context.op_times_arr.begin()+std::min(iter0+batch_size,(int)context.op_times_arr.size()) );
+        ((libROMInterface*)context.rom_interface)->predict(sim, times);
+        if (!rank) printf(  "libROM: Predicted solution at times %1.4e to %1.4e using ROM, wallclock time: %f.\n",
+                            times.front(), times.back(), ((libROMInterface*)context.rom_interface)->predictWallclockTime() );
+        total_rom_predict_time += ((libROMInterface*)context.rom_interface)->predictWallclockTime();
 
-        double waqt = context.op_times_arr[iter];
+        for (int k = 0; k < times.size(); k++) {
 
-        ((libROMInterface*)context.rom_interface)->predict(sim, waqt);
-        if (!rank) printf(  "libROM: Predicted solution at time %1.4e using ROM, wallclock time: %f.\n",
-                            waqt, ((libROMInterface*)context.rom_interface)->predictWallclockTime() );
-        total_rom_predict_time += ((libROMInterface*)context.rom_interface)->predictWallclockTime();
+          int iter = iter0 + k;
+          double waqt = times[k];
+          ((libROMInterface*)context.rom_interface)->copyPredictionToHyPar(sim, k);
 
-        /* calculate diff between ROM and PDE solutions */
-        if (iter == (context.op_times_arr.size()-1)) {
-          if (!rank) printf("libROM:   Calculating diff between PDE and ROM solutions.\n");
-          for (int ns = 0; ns < nsims; ns++) {
-            CalculateROMDiff(  &(sim[ns].solver),
-                               &(sim[ns].mpi) );
+          /* calculate diff between ROM and PDE solutions */
+          if (iter == (context.op_times_arr.size()-1)) {
+            if (!rank) printf("libROM:   Calculating diff between PDE and ROM solutions.\n");
+            for (int ns = 0; ns < nsims; ns++) {
+              CalculateROMDiff(  &(sim[ns].solver),
+                                 &(sim[ns].mpi) );
+            }
           }
+          /* write the ROM solution to file */
+          OutputROMSolution(sim, nsims, waqt);
         }
-        /* write the ROM solution to file */
-        OutputROMSolution(sim, nsims, waqt);
 
       }
 
@@ -810,24 +836,31 @@ int SolvePETSc( void* s, /*!< Array of simulation objects of type #SimulationObj
     }
 
     double total_rom_predict_time = 0;
-    for (int iter = 0; iter < context.op_times_arr.size(); iter++) {
+    int batch_size = ((libROMInterface*)context.rom_interface)->predictBatchSize();
+    for (int iter0 = 0; iter0 < context.op_times_arr.size(); iter0 += batch_size) {
+
+      std::vector<double> times( context.op_times_arr.begin()+iter0,
+                                 context.op_times_arr.begin()+std::min(iter0+batch_size,(int)context.op_times_arr.size()) );
+      ((libROMInterface*)context.rom_interface)->predict(sim, times);
+      if (!rank) printf(  "libROM: Predicted solution at times %1.4e to %1.4e using ROM, wallclock time: %f.\n",
+                          times.front(), times.back(), ((libROMInterface*)context.rom_interface)->predictWallclockTime() );
+      total_rom_predict_time += ((libROMInterface*)context.rom_interface)->predictWallclockTime();
 
-      double waqt = context.op_times_arr[iter];
+      for (int k = 0; k < times.size(); k++) {
 
-      ((libROMInterface*)context.rom_interface)->predict(sim, waqt);
-      if (!rank) printf(  "libROM: Predicted solution at time %1.4e using ROM, wallclock time: %f.\n",
-                          waqt, ((libROMInterface*)context.rom_interface)->predictWallclockTime() );
-      total_rom_predict_time += ((libROMInterface*)context.rom_interface)->predictWallclockTime();
+        double waqt = times[k];
+        ((libROMInterface*)context.rom_interface)->copyPredictionToHyPar(sim, k);
 
-      /* write the solution to file */
-      for (int ns = 0; ns < nsims; ns++) {
-        if (sim[ns].solver.PhysicsOutput) {
-          sim[ns].solver.PhysicsOutput( &(sim[ns].solver),
-                                        &(sim[ns].mpi),
-                                        waqt );
+        /* write the solution to file */
+        for (int ns = 0; ns < nsims; ns++) {
+          if (sim[ns].solver.PhysicsOutput) {
+            sim[ns].solver.PhysicsOutput( &(sim[ns].solver),
+                                          &(sim[ns].mpi),
+                                          waqt );
+          }
         }
+        OutputSolution(sim, nsims, waqt);
       }
-      OutputSolution(sim, nsims, waqt);
 
     }
 
@@ -847,6 +880,10 @@ int SolvePETSc( void* s, /*!< Array of simulation objects of type #SimulationObj
   delete ((libROMInterface*)context.rom_interface);
 #endif
 
+  /* report the profiled regions */
+  MPIProfilerReport(&(sim[0].mpi.world),"profile.json");
+  MPIProfilerEnable(0);
+
   PetscFunctionReturn(0);
 }
 
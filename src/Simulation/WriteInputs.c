@@ -84,6 +84,7 @@ int WriteInputs ( void  *s,     /*!< Array of simulation objects of type #Simula
     printf("  Spatial discretization scheme (hyperbolic) : %s\n"     ,sim[0].solver.spatial_scheme_hyp  );
     printf("  Split hyperbolic flux term?                : %s\n"     ,sim[0].solver.SplitHyperbolicFlux );
     printf("  Interpolation type for hyperbolic term     : %s\n"     ,sim[0].solver.interp_type         );
+    printf("  Interface eigensystem cache                : %s\n"     ,sim[0].solver.eigen_cache_type    );
     printf("  Spatial discretization type   (parabolic ) : %s\n"     ,sim[0].solver.spatial_type_par    );
     printf("  Spatial discretization scheme (parabolic ) : %s\n"     ,sim[0].solver.spatial_scheme_par  );
     printf("  Time Step                                  : %E\n"     ,sim[0].solver.dt                  );
@@ -99,6 +100,15 @@ int WriteInputs ( void  *s,     /*!< Array of simulation objects of type #Simula
     else                                        printf("\n");
     printf("  Solution file format                       : %s\n"     ,sim[0].solver.op_file_format      );
     printf("  Overwrite solution file                    : %s\n"     ,sim[0].solver.op_overwrite        );
+    printf("  Profile solver regions                     : %s\n"     ,sim[0].solver.profile             );
+    printf("  Mixed-precision storage                    : %s\n"     ,sim[0].solver.mixed_precision     );
+    printf("  Non-uniform grid metrics                   : %s\n"     ,sim[0].solver.nonuniform_grid     );
+    if (sim[0].solver.local_dt_cfl > 0)
+      printf("  Local time step CFL number                 : %E\n"     ,sim[0].solver.local_dt_cfl        );
+    if (sim[0].solver.residual_drop > 0)
+      printf("  Residual drop for convergence              : %E\n"     ,sim[0].solver.residual_drop       );
+    if (sim[0].solver.grid_sequencing > 0)
+      printf("  Grid sequencing levels                     : %d\n"     ,sim[0].solver.grid_sequencing     );
 #if defined(HAVE_CUDA)
     printf("  Use GPU                                    : %s\n"     ,(sim[0].solver.use_gpu == 1)? "yes" : "no");
     printf("  GPU device no                              : %d\n"     ,(sim[0].solver.gpu_device_no));
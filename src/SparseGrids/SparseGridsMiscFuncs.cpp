@@ -334,6 +334,7 @@ int SparseGridsSimulation::InitializeSolversBarebones( SimulationObject *sim /*!
   MPIVariables *mpi      = &(sim->mpi);
 
   solver->ParabolicFunction         = NULL;
+  solver->ParabolicFunctionAccumulate = NULL;
   solver->SecondDerivativePar       = NULL;
   solver->FirstDerivativePar        = NULL;
   solver->InterpolateInterfacesPar  = NULL;
@@ -41,6 +41,7 @@ int SparseGridsSimulation::SetSolverParameters( SimulationObject&       a_dst_si
   strcpy(a_dst_sim.solver.spatial_scheme_hyp, a_src_sim.solver.spatial_scheme_hyp);
   strcpy(a_dst_sim.solver.SplitHyperbolicFlux, a_src_sim.solver.SplitHyperbolicFlux);
   strcpy(a_dst_sim.solver.interp_type, a_src_sim.solver.interp_type);
+  strcpy(a_dst_sim.solver.eigen_cache_type, a_src_sim.solver.eigen_cache_type);
   strcpy(a_dst_sim.solver.spatial_type_par, a_src_sim.solver.spatial_type_par);
   strcpy(a_dst_sim.solver.spatial_scheme_par, a_src_sim.solver.spatial_scheme_par);
 
@@ -60,6 +61,8 @@ int SparseGridsSimulation::SetSolverParameters( SimulationObject&       a_dst_si
 
   strcpy(a_dst_sim.solver.op_overwrite, a_src_sim.solver.op_overwrite);
   strcpy(a_dst_sim.solver.plot_solution, a_src_sim.solver.plot_solution);
+  strcpy(a_dst_sim.solver.mixed_precision, a_src_sim.solver.mixed_precision);
+  strcpy(a_dst_sim.solver.nonuniform_grid, a_src_sim.solver.nonuniform_grid);
   strcpy(a_dst_sim.solver.model, a_src_sim.solver.model);
   strcpy(a_dst_sim.solver.ib_filename, a_src_sim.solver.ib_filename);
 
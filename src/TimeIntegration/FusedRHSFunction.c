@@ -0,0 +1,69 @@
+/*! @file FusedRHSFunction.c
+    @author Debojyoti Ghosh
+    @brief Assemble the right-hand-side of the ODE in place
+*/
+
+#include <basic.h>
+#include <arrayfunctions.h>
+#include <mpivars.h>
+#include <hypar.h>
+
+/*! Compute the right-hand-side of the ODE
+    \f{equation}{
+      {\bf F}\left({\bf u}\right) = - {\bf F}_{\rm hyperbolic}\left({\bf u}\right)
+                                    + {\bf F}_{\rm parabolic} \left({\bf u}\right)
+                                    + {\bf F}_{\rm source}    \left({\bf u}\right)
+    \f}
+    in place: each term is added to \a rhs with its scaling factor by #HyPar::HyperbolicFunctionAccumulate,
+    #HyPar::ParabolicFunctionAccumulate and #HyPar::SourceFunctionAccumulate, instead of being computed
+    in the separate arrays #HyPar::hyp, #HyPar::par and #HyPar::source, which are then combined. Terms
+    that are zero for this simulation are skipped. If the parabolic term cannot be accumulated
+    (#HyPar::ParabolicFunctionAccumulate is NULL), it is computed in #HyPar::par and added to \a rhs.
+
+    The sum of the hyperbolic and parabolic terms is multiplied by the blanking array of immersed
+    bodies once, instead of each term separately (HyperbolicFunction(), ParabolicFunction()); since
+    the blanking array is 0 or 1, the result is the same. The source term is not blanked (as in the
+    separate evaluation of the terms).
+
+    The boundary conditions must have been applied to \a u and its ghost points exchanged.
+*/
+int FusedRHSFunction(
+                      double  *rhs,   /*!< Array to hold the computed right-hand-side */
+                      double  *u,     /*!< Solution array (with ghost points filled) */
+                      void    *s,     /*!< Solver object of type #HyPar */
+                      void    *m,     /*!< MPI object of type #MPIVariables */
+                      double  t,      /*!< Current simulation time */
+                      int     LimFlag /*!< Flag to indicate if the nonlinear coefficients for solution-dependent
+                                           interpolation methods should be recomputed (see HyperbolicFunction()) */
+                    )
+{
+  HyPar         *solver = (HyPar*)        s;
+  MPIVariables  *mpi    = (MPIVariables*) m;
+  _DECLARE_IERR_;
+
+  int size  = solver->npoints_local_wghosts;
+  int nvars = solver->nvars;
+
+  _ArraySetValue_(rhs,size*nvars,0.0);
+
+  IERR solver->HyperbolicFunctionAccumulate(rhs,-1.0,u,solver,mpi,t,LimFlag,
+                                            solver->FFunction,solver->Upwind);
+  CHECKERR(ierr);
+
+  MPIProfilerBegin("ParabolicFunction");
+  if (solver->ParabolicFunctionAccumulate) {
+    IERR solver->ParabolicFunctionAccumulate(rhs,1.0,u,solver,mpi,t); CHECKERR(ierr);
+  } else if (solver->ParabolicFunction) {
+    IERR solver->ParabolicFunction(solver->par,u,solver,mpi,t); CHECKERR(ierr);
+    _ArrayAXPY_(solver->par,1.0,rhs,size*nvars);
+  }
+  MPIProfilerEnd("ParabolicFunction",0);
+
+  if (solver->flag_ib) _ArrayBlockMultiply_(rhs,solver->iblank,size,nvars);
+
+  MPIProfilerBegin("SourceFunction");
+  IERR solver->SourceFunctionAccumulate(rhs,1.0,u,solver,mpi,t); CHECKERR(ierr);
+  MPIProfilerEnd("SourceFunction",0);
+
+  return(0);
+}
@@ -6,9 +6,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <arrayfunctions.h>
 #if defined(HAVE_CUDA)
 #include <arrayfunctions_gpu.h>
 #endif
+#include <mpivars.h>
 #include <simulation_object.h>
 #include <timeintegration.h>
 
@@ -21,6 +23,9 @@ int TimeCleanup(void *ts /*!< Object of type #TimeIntegration*/)
   SimulationObject* sim = (SimulationObject*) TS->simulation;
   int ns, nsims = TS->nsims;
 
+  /* complete the reductions of the diagnostics still in flight */
+  MPIDiagnosticsEnd();
+
   /* close files opened for writing */
   if (!TS->rank) if (sim[0].solver.write_residual) fclose((FILE*)TS->ResidualFile);
 
@@ -36,8 +41,13 @@ int TimeCleanup(void *ts /*!< Object of type #TimeIntegration*/)
     if (!strcmp(sim[0].solver.time_scheme,_RK_)) {
       int i;
       ExplicitRKParameters  *params = (ExplicitRKParameters*)  sim[0].solver.msti;
-      for (i=0; i<params->nstages; i++) free(TS->U[i]);            free(TS->U);
-      for (i=0; i<params->nstages; i++) free(TS->Udot[i]);         free(TS->Udot);
+      for (i=0; i<params->nstages; i++) ArrayFree(TS->U[i]);        free(TS->U);
+      if (TS->Udot) {
+        for (i=0; i<params->nstages; i++) ArrayFree(TS->Udot[i]);     free(TS->Udot);
+      }
+      if (TS->Udot_single) {
+        for (i=0; i<params->nstages; i++) ArrayFree(TS->Udot_single[i]); free(TS->Udot_single);
+      }
       for (i=0; i<params->nstages; i++) free(TS->BoundaryFlux[i]); free(TS->BoundaryFlux);
     } else if (!strcmp(sim[0].solver.time_scheme,_FORWARD_EULER_)) {
       int nstages = 1, i;
@@ -45,8 +55,8 @@ int TimeCleanup(void *ts /*!< Object of type #TimeIntegration*/)
     } else if (!strcmp(sim[0].solver.time_scheme,_GLM_GEE_)) {
       int i;
       GLMGEEParameters  *params = (GLMGEEParameters*)  sim[0].solver.msti;
-      for (i=0; i<2*params->r-1  ; i++) free(TS->U[i]);            free(TS->U);
-      for (i=0; i<params->nstages; i++) free(TS->Udot[i]);         free(TS->Udot);
+      for (i=0; i<2*params->r-1  ; i++) ArrayFree(TS->U[i]);        free(TS->U);
+      for (i=0; i<params->nstages; i++) ArrayFree(TS->Udot[i]);     free(TS->Udot);
       for (i=0; i<params->nstages; i++) free(TS->BoundaryFlux[i]); free(TS->BoundaryFlux);
     }
 #if defined(HAVE_CUDA)
@@ -58,9 +68,11 @@ int TimeCleanup(void *ts /*!< Object of type #TimeIntegration*/)
   free(TS->u_sizes);
   free(TS->bf_offsets);
   free(TS->bf_sizes);
-  free(TS->u  );
-  free(TS->rhs);
+  ArrayFree(TS->u  );
+  ArrayFree(TS->rhs);
   for (ns = 0; ns < nsims; ns++) {
+    if (sim[ns].solver.local_dt) free(sim[ns].solver.local_dt);
+    sim[ns].solver.local_dt = NULL;
     sim[ns].solver.time_integrator = NULL;
   }
   return(0);
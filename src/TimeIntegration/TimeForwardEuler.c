@@ -7,6 +7,7 @@
 #include <arrayfunctions.h>
 #include <simulation_object.h>
 #include <timeintegration.h>
+#include <amr.h>
 
 /*!
   Advance the ODE given by
@@ -55,6 +56,10 @@ int TimeForwardEuler(
                         TS->dt,
                         solver->StepBoundaryIntegral,
                         TS->bf_sizes[ns] );
+
+    /* time integral of the fluxes at the coarse-fine interfaces of the adaptive mesh refinement */
+    FluxRegister *reg = (FluxRegister*) solver->flux_register;
+    if (reg) _ArrayAXPY_(reg->stage,TS->dt,reg->step,reg->nfaces*reg->nvars);
   }
 
   return(0);
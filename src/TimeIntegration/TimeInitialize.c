@@ -12,6 +12,7 @@
 #else
 #include <arrayfunctions.h>
 #endif
+#include <mpivars.h>
 #include <simulation_object.h>
 #include <timeintegration.h>
 
@@ -24,6 +25,8 @@ int TimeRHSFunctionExplicit(double*,double*,void*,void*,double);
   + It allocates solution, right-hand-side, and stage solution arrays needed
     by specific time integration methods.
   + It calls the method-specific initialization functions.
+  + With #HyPar::mixed_precision, it checks the accuracy of the mixed-precision
+    storage (see TimeMixedPrecisionCheck()).
 */
 int TimeInitialize( void  *s,     /*!< Array of simulation objects of type #SimulationObject */
                     int   nsims,  /*!< number of simulation objects */
@@ -52,6 +55,9 @@ int TimeInitialize( void  *s,     /*!< Array of simulation objects of type #Simu
   TS->waqt          = (double) TS->restart_iter * TS->dt;
   TS->max_cfl       = 0.0;
   TS->norm          = 0.0;
+  TS->norm_initial  = -1.0;
+  TS->norm_iter     = 0;
+  TS->converged     = 0;
   TS->TimeIntegrate = sim[0].solver.TimeIntegrate;
   TS->iter_wctime_total = 0.0;
 
@@ -65,14 +71,20 @@ int TimeInitialize( void  *s,     /*!< Array of simulation objects of type #Simu
     TS->u_size_total += TS->u_sizes[ns];
   }
 
-  TS->u   = (double*) calloc (TS->u_size_total,sizeof(double));
-  TS->rhs = (double*) calloc (TS->u_size_total,sizeof(double));
+  /* the solution-sized arrays hold the solutions of all the simulations one after the
+     other; they are placed for the grid of the first one (see ArrayAllocateGrid()) */
+  int ndims = sim[0].solver.ndims, *dim = sim[0].solver.dim_local;
+  int ghosts = sim[0].solver.ghosts, nvars = sim[0].solver.nvars;
+
+  TS->u   = ArrayAllocateGrid(TS->u_size_total,ndims,dim,ghosts,nvars,0,"TS u");
+  TS->rhs = ArrayAllocateGrid(TS->u_size_total,ndims,dim,ghosts,nvars,0,"TS rhs");
   _ArraySetValue_(TS->u  ,TS->u_size_total,0.0);
   _ArraySetValue_(TS->rhs,TS->u_size_total,0.0);
 
   /* initialize arrays to NULL, then allocate as necessary */
   TS->U             = NULL;
   TS->Udot          = NULL;
+  TS->Udot_single   = NULL;
   TS->BoundaryFlux  = NULL;
 
   TS->bf_offsets = (int*) calloc (nsims, sizeof(int));
@@ -117,10 +129,20 @@ int TimeInitialize( void  *s,     /*!< Array of simulation objects of type #Simu
       ExplicitRKParameters  *params = (ExplicitRKParameters*)  sim[0].solver.msti;
       int nstages = params->nstages;
       TS->U     = (double**) calloc (nstages,sizeof(double*));
-      TS->Udot  = (double**) calloc (nstages,sizeof(double*));
       for (i = 0; i < nstages; i++) {
-        TS->U[i]    = (double*) calloc (TS->u_size_total,sizeof(double));
-        TS->Udot[i] = (double*) calloc (TS->u_size_total,sizeof(double));
+        TS->U[i]    = ArrayAllocateGrid(TS->u_size_total,ndims,dim,ghosts,nvars,0,"TS U");
+      }
+      if (!strcmp(sim[0].solver.mixed_precision,"yes")) {
+        /* stage right-hand-sides in single precision (see TimeRK()) */
+        TS->Udot_single = (float**) calloc (nstages,sizeof(float*));
+        for (i = 0; i < nstages; i++) {
+          TS->Udot_single[i] = ArrayAllocateGridSingle(TS->u_size_total,ndims,dim,ghosts,nvars,0,"TS Udot (single)");
+        }
+      } else {
+        TS->Udot  = (double**) calloc (nstages,sizeof(double*));
+        for (i = 0; i < nstages; i++) {
+          TS->Udot[i] = ArrayAllocateGrid(TS->u_size_total,ndims,dim,ghosts,nvars,0,"TS Udot");
+        }
       }
 
       TS->BoundaryFlux = (double**) calloc (nstages,sizeof(double*));
@@ -144,8 +166,8 @@ int TimeInitialize( void  *s,     /*!< Array of simulation objects of type #Simu
       int r       = params->r;
       TS->U     = (double**) calloc (2*r-1  ,sizeof(double*));
       TS->Udot  = (double**) calloc (nstages,sizeof(double*));
-      for (i=0; i<2*r-1; i++)   TS->U[i]    = (double*) calloc (TS->u_size_total,sizeof(double));
-      for (i=0; i<nstages; i++) TS->Udot[i] = (double*) calloc (TS->u_size_total,sizeof(double));
+      for (i=0; i<2*r-1; i++)   TS->U[i]    = ArrayAllocateGrid(TS->u_size_total,ndims,dim,ghosts,nvars,0,"TS U");
+      for (i=0; i<nstages; i++) TS->Udot[i] = ArrayAllocateGrid(TS->u_size_total,ndims,dim,ghosts,nvars,0,"TS Udot");
 
       TS->BoundaryFlux = (double**) calloc (nstages,sizeof(double*));
       for (i=0; i<nstages; i++) {
@@ -174,6 +196,26 @@ int TimeInitialize( void  *s,     /*!< Array of simulation objects of type #Simu
   /* set right-hand side function pointer */
   TS->RHSFunction = TimeRHSFunctionExplicit;
 
+  /* local time stepping: ratio of the local time step to the time step at each grid point */
+  for (ns = 0; ns < nsims; ns++) {
+    HyPar *solver = &(sim[ns].solver);
+    solver->local_dt = NULL;
+    if (solver->local_dt_cfl > 0) {
+      if (!solver->ComputeLocalCFL) {
+        if (!rank) fprintf(stderr,"Error in TimeInitialize(): local time stepping is not available for the physical model %s.\n",
+                           solver->model);
+        return(1);
+      }
+#if defined(HAVE_CUDA)
+      if (solver->use_gpu) {
+        if (!rank) fprintf(stderr,"Error in TimeInitialize(): local time stepping is not yet implemented on GPUs.\n");
+        return(1);
+      }
+#endif
+      solver->local_dt = (double*) calloc (solver->npoints_local_wghosts,sizeof(double));
+    }
+  }
+
   /* open files for writing */
   if (!rank) {
     if (sim[0].solver.write_residual) TS->ResidualFile = (void*) fopen("residual.out","w");
@@ -184,6 +226,12 @@ int TimeInitialize( void  *s,     /*!< Array of simulation objects of type #Simu
     sim[ns].solver.time_integrator = TS;
   }
 
+  /* check the accuracy of the mixed-precision storage */
+  if (TimeMixedPrecisionCheck(TS)) return(1);
+
+  /* aggregate the reductions of the per-step diagnostics (CFL, norm, integrals) */
+  MPIDiagnosticsBegin(&(sim[0].mpi.world));
+
   return 0;
 }
 
@@ -0,0 +1,133 @@
+/*! @file TimeMixedPrecisionCheck.c
+    @brief Check the accuracy of the mixed-precision storage
+    @author Debojyoti Ghosh
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <basic.h>
+#include <arrayfunctions.h>
+#include <interpolation.h>
+#include <mpivars.h>
+#include <simulation_object.h>
+#include <timeintegration.h>
+
+/*! Relative difference between the right-hand-sides computed with the mixed-precision storage
+    and in double precision above which a warning is printed */
+#define _MIXED_PRECISION_TOLERANCE_ 1e-5
+
+/*!
+  Check the accuracy of the mixed-precision storage (#HyPar::mixed_precision): the right-hand-side
+  of the initial solution is computed with the WENO weights saved in double precision, and with the
+  WENO weights saved in single precision and the result rounded to single precision (as stored by
+  TimeRK()). The relative difference between the two (in the max norm, relative to the max norm
+  of the right-hand-side computed in double precision) is printed for each simulation domain, and a
+  warning is printed if it is larger than #_MIXED_PRECISION_TOLERANCE_ (for example, if the
+  right-hand-side is dominated by the cancellation of large terms).
+
+  The right-hand-sides are computed on a copy of the solution, without local time stepping, and
+  the function counts of the solver are not changed. If a right-hand-side cannot be computed on
+  any rank, the state of the solver is restored and all the ranks return an error.
+*/
+int TimeMixedPrecisionCheck(void *ts /*!< Object of type #TimeIntegration */)
+{
+  TimeIntegration   *TS   = (TimeIntegration*) ts;
+  SimulationObject  *sim  = (SimulationObject*) TS->simulation;
+  int               ns;
+
+  if (strcmp(sim[0].solver.mixed_precision,"yes")) return(0);
+#if defined(HAVE_CUDA)
+  if (sim[0].solver.use_gpu) return(0);
+#endif
+
+  for (ns = 0; ns < TS->nsims; ns++) {
+
+    HyPar         *solver = &(sim[ns].solver);
+    MPIVariables  *mpi    = &(sim[ns].mpi);
+    long          j, size = (long) solver->npoints_local_wghosts * solver->nvars;
+
+    WENOParameters *weno = NULL;
+    if (    (!strcmp(solver->spatial_scheme_hyp,_FIFTH_ORDER_WENO_  ))
+         || (!strcmp(solver->spatial_scheme_hyp,_FIFTH_ORDER_CRWENO_))
+         || (!strcmp(solver->spatial_scheme_hyp,_FIFTH_ORDER_HCWENO_)) ) {
+      weno = (WENOParameters*) solver->interp;
+    }
+
+    double *u       = (double*) calloc (size,sizeof(double));
+    double *rhs_dp  = (double*) calloc (size,sizeof(double));
+    double *rhs_mp  = (double*) calloc (size,sizeof(double));
+
+    int     counts[3] = { solver->count_hyp, solver->count_par, solver->count_sou };
+    double  *local_dt = solver->local_dt;
+    int     ierr = 0, ierr_global = 0;
+    solver->local_dt = NULL;
+
+    /* double precision */
+    if (weno) ierr = WENOSetPrecision(weno,solver,0);
+    if (!ierr) {
+      _ArrayCopy1D_(solver->u,u,size);
+      ierr = TS->RHSFunction(rhs_dp,u,solver,mpi,TS->waqt);
+    }
+    /* the ranks must agree on whether to go on, since the right-hand-side
+       involves communications */
+    MPIMax_integer(&ierr_global,&ierr,1,&mpi->world); ierr = ierr_global;
+
+    /* mixed precision (the weights are saved in single precision again even if
+       the double precision evaluation failed) */
+    if (weno && WENOSetPrecision(weno,solver,1) && (!ierr)) ierr = 1;
+    if (!ierr) {
+      _ArrayCopy1D_(solver->u,u,size);
+      ierr = TS->RHSFunction(rhs_mp,u,solver,mpi,TS->waqt);
+    }
+    if (TS->Udot_single) {
+      for (j = 0; j < size; j++) rhs_mp[j] = (double) ((float) rhs_mp[j]);
+    }
+
+    solver->local_dt  = local_dt;
+    solver->count_hyp = counts[0];
+    solver->count_par = counts[1];
+    solver->count_sou = counts[2];
+
+    /* all the ranks return if the right-hand-side could not be computed on any one */
+    ierr_global = 0;
+    MPIMax_integer(&ierr_global,&ierr,1,&mpi->world);
+    if (ierr_global) {
+      if (!mpi->rank) {
+        fprintf(stderr,"Error in TimeMixedPrecisionCheck(): the right-hand-side could not be computed.\n");
+      }
+      free(u);
+      free(rhs_dp);
+      free(rhs_mp);
+      return(ierr_global);
+    }
+
+    /* max norms of the right-hand-side and of the difference */
+    double norm, diff, global;
+    norm = ArrayMaxnD(solver->nvars,solver->ndims,solver->dim_local,
+                      solver->ghosts,solver->index,rhs_dp);
+    global = 0; MPIMax_double(&global,&norm,1,&mpi->world); norm = global;
+    _ArrayAXPY_(rhs_dp,-1.0,rhs_mp,size);
+    diff = ArrayMaxnD(solver->nvars,solver->ndims,solver->dim_local,
+                      solver->ghosts,solver->index,rhs_mp);
+    global = 0; MPIMax_double(&global,&diff,1,&mpi->world); diff = global;
+
+    double rel_diff = (norm > 0 ? diff / norm : diff);
+    if (!mpi->rank) {
+      if (TS->nsims > 1) printf("Domain %d: ",ns);
+      printf("Mixed-precision storage: relative difference in the right-hand-side (max norm) = %1.6E.\n",
+             rel_diff);
+      if (rel_diff > _MIXED_PRECISION_TOLERANCE_) {
+        fprintf(stderr,"Warning in TimeMixedPrecisionCheck(): the relative difference between the right-hand-sides\n");
+        fprintf(stderr,"  computed with the mixed-precision storage and in double precision (%1.6E) is larger\n",rel_diff);
+        fprintf(stderr,"  than %1.1E; consider setting \"mixed_precision\" to \"no\".\n",_MIXED_PRECISION_TOLERANCE_);
+      }
+    }
+
+    free(u);
+    free(rhs_dp);
+    free(rhs_mp);
+  }
+
+  return(0);
+}
@@ -15,6 +15,46 @@
 #include <mpivars.h>
 #include <simulation_object.h>
 #include <timeintegration.h>
+#include <interpolation.h>
+#include <insitu.h>
+
+/*! Compute the norm of the change in the solution from its reduced sum of squares, write
+    it to the residual file, and check if it has dropped by #HyPar::residual_drop from its
+    first value (called when the reduction posted in TimePostStep() completes). The time step
+    and the simulation time of the norm are reduced with it, since the reduction may complete
+    at a later time step. */
+static int TimePostStepNorm(double  *global,  /*!< Global sum of squares, time step, and simulation time */
+                            int     n,        /*!< Number of values (3) */
+                            void    *ts       /*!< Object of type #TimeIntegration */
+                           )
+{
+  TimeIntegration* TS = (TimeIntegration*) ts;
+  SimulationObject* sim = (SimulationObject*) TS->simulation;
+  TS->norm      = sqrt(global[0]/TS->norm_npoints);
+  TS->norm_iter = (int) global[1];
+
+  /* residual-driven termination of the steady-state mode */
+  if (TS->norm_initial < 0) TS->norm_initial = TS->norm;
+  if (    (sim[0].solver.residual_drop > 0)
+      &&  (TS->norm <= sim[0].solver.residual_drop * TS->norm_initial) ) TS->converged = 1;
+
+  /* write to file */
+  if (TS->ResidualFile) {
+    fprintf((FILE*)TS->ResidualFile,"%10d\t%E\t%E\n",TS->norm_iter,global[2],TS->norm);
+  }
+  return(0);
+}
+
+/*! Compute the conservation error once the volume and boundary integrals posted in
+    TimePostStep() are reduced. */
+static int TimePostStepConservationError( double  *dummy, /*!< Unused */
+                                          int     n,      /*!< Unused (0) */
+                                          void    *s      /*!< Object of type #SimulationObject */
+                                        )
+{
+  SimulationObject* sim = (SimulationObject*) s;
+  return(sim->solver.CalculateConservationError(&(sim->solver),&(sim->mpi)));
+}
 
 /*!
   Post-time-step function: this function is called at the end of
@@ -24,6 +64,15 @@
     transient solution to file.
   + It will also call any physics-specific post-time-step function,
     if defined.
+  + It computes the in-situ reduced outputs (see insitu.h), if any.
+
+  The reductions over all ranks of the diagnostic quantities of this step (norm, conservation
+  integrals, physics-specific quantities, fraction of interfaces flagged by the hybrid WENO scheme
+  (see WENOHybridPostStep()), and the CFL and diffusion numbers posted in TimePreStep())
+  are packed into one nonblocking reduction started at the end of this function; it is completed
+  when the results are printed (TimePrintStep()), or else when the next one is started. With
+  residual-driven termination (#HyPar::residual_drop), it is completed at the end of this function
+  at the steps where the norm is computed, so that #TimeIntegration::converged refers to this step.
 */
 int TimePostStep(void *ts /*!< Object of type #TimeIntegration */)
 {
@@ -41,33 +90,37 @@ int TimePostStep(void *ts /*!< Object of type #TimeIntegration */)
       TS->norm = -1;
     } else {
 #endif
-      /* Calculate norm for this time step */
-      double sum = 0.0;
+      /* Calculate norm for this time step (the time step and the simulation time are
+         added by rank 0 only, so that they are the same after the sum over the ranks) */
+      double local[3] = { 0.0,
+                          (TS->rank ? 0.0 : (double) (TS->iter+1)),
+                          (TS->rank ? 0.0 : TS->waqt) };
       double npts = 0;
       for (ns = 0; ns < nsims; ns++) {
         _ArrayAXPY_(sim[ns].solver.u,-1.0,(TS->u+TS->u_offsets[ns]),TS->u_sizes[ns]);
-        sum += ArraySumSquarenD( sim[ns].solver.nvars,
-                                 sim[ns].solver.ndims,
-                                 sim[ns].solver.dim_local,
-                                 sim[ns].solver.ghosts,
-                                 sim[ns].solver.index,
-                                 (TS->u+TS->u_offsets[ns]) );
+        local[0] += ArraySumSquarenD( sim[ns].solver.nvars,
+                                      sim[ns].solver.ndims,
+                                      sim[ns].solver.dim_local,
+                                      sim[ns].solver.ghosts,
+                                      sim[ns].solver.index,
+                                      (TS->u+TS->u_offsets[ns]) );
         npts += (double)sim[ns].solver.npoints_global;
       }
 
-      double global_sum = 0;
-      MPISum_double(  &global_sum,
-                      &sum,1,
-                      &(sim[0].mpi.world) );
-
-      TS->norm = sqrt(global_sum/npts);
+      TS->norm_npoints = npts;
+      MPIDiagnosticsPost( NULL,
+                          local,3,
+                          _MPI_DIAG_SUM_,
+                          &(sim[0].mpi.world),
+                          TimePostStepNorm,
+                          TS );
 #if defined(HAVE_CUDA)
     }
 #endif
 
-    /* write to file */
-    if (TS->ResidualFile) {
-      fprintf((FILE*)TS->ResidualFile,"%10d\t%E\t%E\n",TS->iter+1,TS->waqt,TS->norm);
+    /* fraction of the interfaces flagged by the smoothness sensor of the hybrid WENO scheme */
+    for (ns = 0; ns < nsims; ns++) {
+      IERR WENOHybridPostStep(&(sim[ns].solver),&(sim[ns].mpi)); CHECKERR(ierr);
     }
 
   }
@@ -87,20 +140,34 @@ int TimePostStep(void *ts /*!< Object of type #TimeIntegration */)
         /* calculate surface integral of the flux at this time step */
         IERR sim[ns].solver.BoundaryIntegralFunction( &(sim[ns].solver),
                                                       &(sim[ns].mpi)); CHECKERR(ierr);
-        /* calculate the conservation error at this time step       */
-        IERR sim[ns].solver.CalculateConservationError( &(sim[ns].solver),
-                                                        &(sim[ns].mpi)); CHECKERR(ierr);
+        /* calculate the conservation error at this time step, once the integrals are reduced */
+        IERR MPIDiagnosticsPost( NULL,NULL,0,
+                                 _MPI_DIAG_SUM_,
+                                 &(sim[ns].mpi.world),
+                                 TimePostStepConservationError,
+                                 &sim[ns] ); CHECKERR(ierr);
       }
 
       if (sim[ns].solver.PostStep) {
         sim[ns].solver.PostStep(sim[ns].solver.u,&(sim[ns].solver),&(sim[ns].mpi),TS->waqt,TS->iter);
       }
 
+      /* in-situ reduced outputs */
+      IERR InSituCompute(&(sim[ns].solver),&(sim[ns].mpi),TS->waqt,TS->iter); CHECKERR(ierr);
+
     }
 #if defined(HAVE_CUDA)
   }
 #endif
 
+  /* start the aggregated reduction of the diagnostics of this step */
+  MPIDiagnosticsStart();
+
+  /* residual-driven termination: the norm of this step is checked at this step, so that
+     the time integration stops at the step whose norm has dropped */
+  if (    (sim[0].solver.residual_drop > 0)
+      &&  ((TS->iter+1)%sim[0].solver.screen_op_iter == 0) ) MPIDiagnosticsComplete();
+
   gettimeofday(&TS->iter_end_time,NULL);
   long long walltime;
   walltime = (  (TS->iter_end_time.tv_sec * 1000000 + TS->iter_end_time.tv_usec)
@@ -108,16 +175,5 @@ int TimePostStep(void *ts /*!< Object of type #TimeIntegration */)
   TS->iter_wctime = (double) walltime / 1000000.0;
   TS->iter_wctime_total += TS->iter_wctime;
 
-  double global_total = 0, global_wctime = 0, global_mpi_total = 0, global_mpi_wctime = 0;
-
-  MPIMax_double(&global_wctime, &TS->iter_wctime, 1, &(sim[0].mpi.world));
-  MPIMax_double(&global_total, &TS->iter_wctime_total, 1, &(sim[0].mpi.world));
-
-#if defined(HAVE_CUDA)
-  MPIMax_double(&global_mpi_wctime, &sim[0].mpi.wctime, 1, &(sim[0].mpi.world));
-  MPIMax_double(&global_mpi_total, &sim[0].mpi.wctime_total, 1, &(sim[0].mpi.world));
-#endif
-
   return(0);
 }
-
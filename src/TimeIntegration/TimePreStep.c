@@ -16,7 +16,12 @@
 /*!
   Pre-time-step function: This function is called before each time
   step. Some notable things this does are:
-  + Computes CFL and diffusion numbers.
+  + Computes CFL and diffusion numbers (their reduction over all ranks is
+    deferred, see MPIDiagnosticsPost()).
+  + Computes the local time steps at each grid point for local time stepping
+    (#HyPar::local_dt_cfl): the ratio of the time step of a grid point to
+    #TimeIntegration::dt is the ratio of #HyPar::local_dt_cfl to its CFL number
+    for #TimeIntegration::dt.
   + Call the physics-specific pre-time-step function, if defined.
 */
 int TimePreStep(void *ts /*!< Object of type #TimeIntegration */ )
@@ -90,24 +95,36 @@ int TimePreStep(void *ts /*!< Object of type #TimeIntegration */ )
       }
 #endif
 
-      /* compute max CFL and diffusion number over the domain */
+      /* compute max CFL and diffusion number over the domain (the reductions are
+         aggregated with the other diagnostics of this step, see MPIDiagnosticsPost()) */
       if (solver->ComputeCFL) {
         double local_max_cfl  = -1.0;
         local_max_cfl  = solver->ComputeCFL (solver,mpi,TS->dt,TS->waqt);
-        MPIMax_double(&TS->max_cfl ,&local_max_cfl ,1,&mpi->world);
+        MPIDiagnosticsPost(&TS->max_cfl,&local_max_cfl,1,_MPI_DIAG_MAX_,&mpi->world,NULL,NULL);
       } else {
         TS->max_cfl = -1;
       }
       if (solver->ComputeDiffNumber) {
         double local_max_diff = -1.0;
         local_max_diff = solver->ComputeDiffNumber (solver,mpi,TS->dt,TS->waqt);
-        MPIMax_double(&TS->max_diff,&local_max_diff,1,&mpi->world);
+        MPIDiagnosticsPost(&TS->max_diff,&local_max_diff,1,_MPI_DIAG_MAX_,&mpi->world,NULL,NULL);
       } else {
         TS->max_diff = -1;
       }
 
     }
 
+    /* local time steps (the solution is frozen over the stages of the time step) */
+    if (solver->local_dt) {
+      int p;
+      _ArraySetValue_(solver->local_dt,solver->npoints_local_wghosts,0.0);
+      solver->ComputeLocalCFL(solver,mpi,TS->dt,TS->waqt,solver->local_dt);
+      for (p = 0; p < solver->npoints_local_wghosts; p++) {
+        double cfl = solver->local_dt[p];
+        solver->local_dt[p] = (cfl > _MACHINE_ZERO_ ? solver->local_dt_cfl / cfl : 0.0);
+      }
+    }
+
     /* set the step boundary flux integral value to zero */
 #if defined(HAVE_CUDA)
     if (solver->use_gpu) {
@@ -6,12 +6,15 @@
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+#include <mpivars.h>
 #include <simulation_object.h>
 #include <timeintegration.h>
+#include <interpolation.h>
 
 /*!
   Print information to screen (also calls any physics-specific
-  printing function, if defined).
+  printing function, if defined). The reduction of the diagnostic
+  quantities of this step is completed first (see MPIDiagnosticsComplete()).
 */
 int TimePrintStep(void *ts /*!< Object of type #TimeIntegration */)
 {
@@ -19,6 +22,9 @@ int TimePrintStep(void *ts /*!< Object of type #TimeIntegration */)
   SimulationObject* sim = (SimulationObject*) TS->simulation;
   int ns, nsims = TS->nsims;
 
+  /* the diagnostics to print are reduced over all ranks */
+  if ((TS->iter+1)%sim[0].solver.screen_op_iter == 0) MPIDiagnosticsComplete();
+
   if ((!TS->rank) && ((TS->iter+1)%sim[0].solver.screen_op_iter == 0)) {
     if (nsims > 1) {
       printf("--\n");
@@ -26,12 +32,18 @@ int TimePrintStep(void *ts /*!< Object of type #TimeIntegration */)
       if (TS->max_cfl >= 0) printf("  CFL=%1.3E\n", TS->max_cfl);
       if (TS->norm >= 0) printf("  norm=%1.4E\n", TS->norm);
       printf("  wctime=%1.1E (s)\n",TS->iter_wctime);
+      for (ns = 0; ns < nsims; ns++) {
+        double weno_fraction = WENOHybridFraction(&(sim[ns].solver));
+        if (weno_fraction >= 0) printf("  WENO (domain %d)=%1.2f%%\n", ns, 100*weno_fraction);
+      }
     } else {
       printf("iter=%7d  ",TS->iter+1 );
       printf("t=%1.3E  ",TS->waqt );
       if (TS->max_cfl >= 0) printf("CFL=%1.3E  ",TS->max_cfl );
       if (TS->norm >= 0) printf("norm=%1.4E  ",TS->norm );
       printf("wctime: %1.1E (s)  ",TS->iter_wctime);
+      double weno_fraction = WENOHybridFraction(&(sim[0].solver));
+      if (weno_fraction >= 0) printf("WENO=%1.2f%%  ",100*weno_fraction);
     }
 
     /* calculate and print conservation error */
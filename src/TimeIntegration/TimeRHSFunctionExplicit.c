@@ -14,6 +14,8 @@
 
 #include <time.h>
 
+int FusedRHSFunction(double*,double*,void*,void*,double,int);
+
 /*!
   This function computes the right-hand-side of the ODE given by
   \f{equation}{
@@ -26,6 +28,12 @@
                                   + {\bf F}_{\rm source}    \left({\bf u}\right),
   \f}
   given the solution \f${\bf u}\f$ and the current simulation time.
+  On CPUs, the terms are added to \a rhs in place by FusedRHSFunction(), without the
+  separate arrays #HyPar::hyp, #HyPar::par and #HyPar::source.
+
+  With local time stepping (#HyPar::local_dt_cfl), the right-hand-side at each grid point
+  is multiplied by the ratio of its local time step to the time step (#HyPar::local_dt), so
+  that any explicit time integration method advances each grid point with its own time step.
 */
 int TimeRHSFunctionExplicit(
                               double  *rhs, /*!< Array to hold the computed right-hand-side */
@@ -37,10 +45,7 @@ int TimeRHSFunctionExplicit(
 {
   HyPar           *solver = (HyPar*)        s;
   MPIVariables    *mpi    = (MPIVariables*) m;
-  int             d;
-
-  int size = 1;
-  for (d=0; d<solver->ndims; d++) size *= (solver->dim_local[d]+2*solver->ghosts);
+  _DECLARE_IERR_;
 
   /* apply boundary conditions and exchange data over MPI interfaces */
   solver->ApplyBoundaryConditions(solver,mpi,u,NULL,t);
@@ -67,6 +72,11 @@ int TimeRHSFunctionExplicit(
   }
 #endif
 
+#if defined(HAVE_CUDA)
+  if (solver->use_gpu) {
+    int d, size = 1;
+    for (d=0; d<solver->ndims; d++) size *= (solver->dim_local[d]+2*solver->ghosts);
+
     solver->HyperbolicFunction( solver->hyp,
                                 u,
                                 solver,
@@ -78,18 +88,22 @@ int TimeRHSFunctionExplicit(
     solver->ParabolicFunction(solver->par,u,solver,mpi,t);
     solver->SourceFunction(solver->source,u,solver,mpi,t);
 
-#if defined(HAVE_CUDA)
-  if (solver->use_gpu) {
     gpuArraySetValue(rhs, size*solver->nvars, 0.0);
     gpuArrayAXPY(solver->hyp,    -1.0, rhs, size*solver->nvars);
     gpuArrayAXPY(solver->par,     1.0, rhs, size*solver->nvars);
     gpuArrayAXPY(solver->source,  1.0, rhs, size*solver->nvars);
   } else {
 #endif
-    _ArraySetValue_(rhs,size*solver->nvars,0.0);
-    _ArrayAXPY_(solver->hyp   ,-1.0,rhs,size*solver->nvars);
-    _ArrayAXPY_(solver->par   , 1.0,rhs,size*solver->nvars);
-    _ArrayAXPY_(solver->source, 1.0,rhs,size*solver->nvars);
+    /* the terms are added to rhs in place */
+    IERR FusedRHSFunction(rhs,u,solver,mpi,t,1); CHECKERR(ierr);
+
+    /* local time stepping */
+    if (solver->local_dt) {
+      int p, v, nvars = solver->nvars;
+      for (p = 0; p < solver->npoints_local_wghosts; p++) {
+        for (v = 0; v < nvars; v++) rhs[nvars*p+v] *= solver->local_dt[p];
+      }
+    }
 #if defined(HAVE_CUDA)
   }
 #endif
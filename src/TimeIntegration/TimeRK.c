@@ -11,6 +11,7 @@
 #endif
 #include <simulation_object.h>
 #include <timeintegration.h>
+#include <amr.h>
 #include <time.h>
 #include <math.h>
 
@@ -31,6 +32,10 @@
   (#ExplicitRKParameters::b).
 
   Note: In the code #TimeIntegration::Udot is equivalent to \f${\bf F}\left({\bf u}\right)\f$.
+
+  If #HyPar::mixed_precision is "yes", the stage right-hand-sides are computed in
+  #TimeIntegration::rhs and stored in single precision (#TimeIntegration::Udot_single); the stage
+  values and the solution are computed (and updated) in double precision.
 */
 int TimeRK(void *ts /*!< Object of type #TimeIntegration */)
 {
@@ -134,10 +139,17 @@ int TimeRK(void *ts /*!< Object of type #TimeIntegration */)
       }
 
       for (i = 0; i < stage; i++) {
-        _ArrayAXPY_(  TS->Udot[i],
-                      (TS->dt * params->A[stage*params->nstages+i]),
-                      TS->U[stage],
-                      TS->u_size_total );
+        if (TS->Udot_single) {
+          _ArrayAXPY_(  TS->Udot_single[i],
+                        (TS->dt * params->A[stage*params->nstages+i]),
+                        TS->U[stage],
+                        TS->u_size_total );
+        } else {
+          _ArrayAXPY_(  TS->Udot[i],
+                        (TS->dt * params->A[stage*params->nstages+i]),
+                        TS->U[stage],
+                        TS->u_size_total );
+        }
       }
 
       for (ns = 0; ns < nsims; ns++) {
@@ -162,13 +174,21 @@ int TimeRK(void *ts /*!< Object of type #TimeIntegration */)
       }
 
       for (ns = 0; ns < nsims; ns++) {
-        TS->RHSFunction( (TS->Udot[stage] + TS->u_offsets[ns]),
+        TS->RHSFunction( ((TS->Udot_single ? TS->rhs : TS->Udot[stage]) + TS->u_offsets[ns]),
                          (TS->U[stage] + TS->u_offsets[ns]),
                          &(sim[ns].solver),
                          &(sim[ns].mpi),
                          stagetime);
       }
 
+      if (TS->Udot_single) {
+        /* store the stage right-hand-side in single precision */
+        float *Udot = TS->Udot_single[stage];
+        long  j;
+#pragma omp parallel for schedule(static) default(shared) private(j)
+        for (j = 0; j < TS->u_size_total; j++) Udot[j] = (float) TS->rhs[j];
+      }
+
       _ArraySetValue_(TS->BoundaryFlux[stage], TS->bf_size_total, 0.0);
       for (ns = 0; ns < nsims; ns++) {
         _ArrayCopy1D_(  sim[ns].solver.StageBoundaryIntegral,
@@ -176,16 +196,29 @@ int TimeRK(void *ts /*!< Object of type #TimeIntegration */)
                         TS->bf_sizes[ns] );
       }
 
+      /* time integral of the fluxes at the coarse-fine interfaces of the adaptive mesh refinement */
+      for (ns = 0; ns < nsims; ns++) {
+        FluxRegister *reg = (FluxRegister*) sim[ns].solver.flux_register;
+        if (reg) _ArrayAXPY_(reg->stage,(TS->dt*params->b[stage]),reg->step,reg->nfaces*reg->nvars);
+      }
+
     }
 
     /* Step completion */
     for (stage = 0; stage < params->nstages; stage++) {
 
       for (ns = 0; ns < nsims; ns++) {
-        _ArrayAXPY_(  (TS->Udot[stage] + TS->u_offsets[ns]),
-                      (TS->dt * params->b[stage]),
-                      (sim[ns].solver.u),
-                      (TS->u_sizes[ns]) );
+        if (TS->Udot_single) {
+          _ArrayAXPY_(  (TS->Udot_single[stage] + TS->u_offsets[ns]),
+                        (TS->dt * params->b[stage]),
+                        (sim[ns].solver.u),
+                        (TS->u_sizes[ns]) );
+        } else {
+          _ArrayAXPY_(  (TS->Udot[stage] + TS->u_offsets[ns]),
+                        (TS->dt * params->b[stage]),
+                        (sim[ns].solver.u),
+                        (TS->u_sizes[ns]) );
+        }
         _ArrayAXPY_(  (TS->BoundaryFlux[stage] + TS->bf_offsets[ns]),
                       (TS->dt * params->b[stage]),
                       (sim[ns].solver.StepBoundaryIntegral),
@@ -150,6 +150,9 @@
 #include <stdlib.h>
 #include <sys/time.h>
 #include <string>
+#ifdef with_omp
+#include <omp.h>
+#endif
 
 #ifdef with_petsc
 #include <petscinterface.h>
@@ -196,13 +199,28 @@ int main(int argc, char **argv)
 #else
   MPI_Comm world;
   int rank, nproc;
+#ifdef with_omp
+  /* only the main thread makes MPI calls */
+  int mpi_thread_support;
+  MPI_Init_thread(&argc,&argv,MPI_THREAD_FUNNELED,&mpi_thread_support);
+#else
   MPI_Init(&argc,&argv);
+#endif
   MPI_Comm_dup(MPI_COMM_WORLD, &world);
   MPI_Comm_rank(MPI_COMM_WORLD,&rank );
   MPI_Comm_size(MPI_COMM_WORLD,&nproc);
   if (!rank) printf("HyPar - Parallel (MPI) version with %d processes\n",nproc);
 #endif
 
+#ifdef with_omp
+  /* start the pool of OpenMP threads once: it is reused by all threaded kernels, and by
+     the concurrent dimension tasks of the hyperbolic term (which need nested parallelism) */
+  omp_set_max_active_levels(2);
+#pragma omp parallel
+  { }
+  if (!rank) printf("Using %d OpenMP thread(s) per process.\n",omp_get_max_threads());
+#endif
+
 #ifdef with_petsc
   PetscInitialize(&argc,&argv,(char*)0,help);
   if (!rank) printf("Compiled with PETSc time integration.\n");